@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "benchmark/benchmark.h"
+
+using namespace utest::v1;
+
+/* Per-target baselines (median, in Benchmark::unit()). 0 leaves the
+ * regression gate open; record a value to make CI fail on regressions. */
+#ifndef BASELINE_MEMCPY_1K
+#define BASELINE_MEMCPY_1K 0
+#endif
+#ifndef BASELINE_CRITICAL_SECTION
+#define BASELINE_CRITICAL_SECTION 0
+#endif
+#ifndef BASELINE_CALLBACK_DISPATCH
+#define BASELINE_CALLBACK_DISPATCH 0
+#endif
+#ifndef BASELINE_TICKER_READ
+#define BASELINE_TICKER_READ 0
+#endif
+
+#define BASELINE_TOLERANCE_PERCENT 25
+
+static char src_buffer[1024];
+static char dst_buffer[1024];
+
+static void do_memcpy()
+{
+    memcpy(dst_buffer, src_buffer, sizeof(dst_buffer));
+}
+
+static void do_critical_section()
+{
+    core_util_critical_section_enter();
+    core_util_critical_section_exit();
+}
+
+static volatile int dispatch_sink;
+
+static void dispatch_target()
+{
+    dispatch_sink++;
+}
+
+static Callback<void()> dispatch_cb(dispatch_target);
+
+static void do_callback_dispatch()
+{
+    dispatch_cb();
+}
+
+static void do_ticker_read()
+{
+    ticker_read_us(get_us_ticker_data());
+}
+
+static void run_benchmark(const char *name, Callback<void()> func, uint32_t baseline)
+{
+    Benchmark bench(name);
+    bench.run(func);
+    bench.report();
+    TEST_ASSERT_TRUE_MESSAGE(bench.within(baseline, BASELINE_TOLERANCE_PERCENT),
+                             "median exceeded recorded baseline");
+}
+
+void test_memcpy_1k()
+{
+    run_benchmark("memcpy_1k", callback(do_memcpy), BASELINE_MEMCPY_1K);
+}
+
+void test_critical_section()
+{
+    run_benchmark("critical_section", callback(do_critical_section), BASELINE_CRITICAL_SECTION);
+}
+
+void test_callback_dispatch()
+{
+    run_benchmark("callback_dispatch", callback(do_callback_dispatch), BASELINE_CALLBACK_DISPATCH);
+}
+
+void test_ticker_read()
+{
+    run_benchmark("ticker_read_us", callback(do_ticker_read), BASELINE_TICKER_READ);
+}
+
+Case cases[] = {
+    Case("Benchmark: memcpy 1KB", test_memcpy_1k),
+    Case("Benchmark: critical section enter/exit", test_critical_section),
+    Case("Benchmark: callback dispatch", test_callback_dispatch),
+    Case("Benchmark: us ticker read", test_ticker_read),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -0,0 +1,214 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+#include "mbed_events.h"
+#include "benchmark/benchmark.h"
+
+using namespace utest::v1;
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+#define THREAD_STACK_SIZE 768
+
+/* Per-target baselines (median, in Benchmark::unit()). 0 leaves the
+ * regression gate open; record a value to make CI fail on regressions. */
+#ifndef BASELINE_THREAD_SWITCH
+#define BASELINE_THREAD_SWITCH 0
+#endif
+#ifndef BASELINE_QUEUE_PUT_GET
+#define BASELINE_QUEUE_PUT_GET 0
+#endif
+#ifndef BASELINE_MUTEX_LOCK_UNLOCK
+#define BASELINE_MUTEX_LOCK_UNLOCK 0
+#endif
+#ifndef BASELINE_ISR_TO_THREAD
+#define BASELINE_ISR_TO_THREAD 0
+#endif
+#ifndef BASELINE_EVENTQUEUE_DISPATCH
+#define BASELINE_EVENTQUEUE_DISPATCH 0
+#endif
+
+#define BASELINE_TOLERANCE_PERCENT 25
+
+static void gate(Benchmark &bench, uint32_t baseline)
+{
+    bench.report();
+    TEST_ASSERT_TRUE_MESSAGE(bench.within(baseline, BASELINE_TOLERANCE_PERCENT),
+                             "median exceeded recorded baseline");
+}
+
+/* ---- context switch: semaphore ping-pong with a partner thread ---- */
+
+static Semaphore ping(0);
+static Semaphore pong(0);
+static volatile bool partner_running;
+
+static void partner_main()
+{
+    while (true) {
+        ping.wait();
+        if (!partner_running) {
+            break;
+        }
+        pong.release();
+    }
+}
+
+static void do_thread_switch()
+{
+    ping.release();
+    pong.wait();
+}
+
+static void benchmark_thread_switch(const char *name, osPriority partner_priority)
+{
+    Thread partner(partner_priority, THREAD_STACK_SIZE);
+    partner_running = true;
+    partner.start(callback(partner_main));
+
+    Benchmark bench(name);
+    bench.run(callback(do_thread_switch));
+    gate(bench, BASELINE_THREAD_SWITCH);
+
+    partner_running = false;
+    ping.release();
+    partner.join();
+}
+
+void test_thread_switch_higher_priority()
+{
+    /* The partner preempts on release: release - switch - wait - switch back */
+    benchmark_thread_switch("thread_switch_high", osPriorityHigh);
+}
+
+void test_thread_switch_lower_priority()
+{
+    /* The switch happens when pong.wait() blocks */
+    benchmark_thread_switch("thread_switch_low", osPriorityLow);
+}
+
+/* ---- message queue put/get round trip ---- */
+
+static Queue<uint32_t, 4> msg_queue;
+static uint32_t msg_value;
+
+static void do_queue_put_get()
+{
+    msg_queue.put(&msg_value);
+    msg_queue.get();
+}
+
+void test_queue_put_get()
+{
+    Benchmark bench("queue_put_get");
+    bench.run(callback(do_queue_put_get));
+    gate(bench, BASELINE_QUEUE_PUT_GET);
+}
+
+/* ---- uncontended mutex acquire/release ---- */
+
+static Mutex benchmark_mutex;
+
+static void do_mutex_lock_unlock()
+{
+    benchmark_mutex.lock();
+    benchmark_mutex.unlock();
+}
+
+void test_mutex_lock_unlock()
+{
+    Benchmark bench("mutex_lock_unlock");
+    bench.run(callback(do_mutex_lock_unlock));
+    gate(bench, BASELINE_MUTEX_LOCK_UNLOCK);
+}
+
+/* ---- ISR-to-thread wakeup latency, manually sampled ---- */
+
+static Semaphore isr_sem(0);
+static volatile uint32_t isr_stamp;
+
+static void isr_fire()
+{
+    isr_stamp = Benchmark::read_timer();
+    isr_sem.release();
+}
+
+void test_isr_to_thread()
+{
+    Timeout timeout;
+    Benchmark bench("isr_to_thread_wakeup", 32);
+
+    for (int i = 0; i < 32; i++) {
+        timeout.attach_us(isr_fire, 200);
+        isr_sem.wait();
+        bench.add_sample(Benchmark::read_timer() - isr_stamp);
+    }
+    bench.complete();
+    gate(bench, BASELINE_ISR_TO_THREAD);
+}
+
+/* ---- EventQueue post-to-dispatch, manually sampled ---- */
+
+static volatile uint32_t post_stamp;
+static volatile uint32_t dispatch_delta;
+
+static void event_handler()
+{
+    dispatch_delta = Benchmark::read_timer() - post_stamp;
+}
+
+void test_eventqueue_dispatch()
+{
+    EventQueue queue(8 * EVENTS_EVENT_SIZE);
+    Benchmark bench("eventqueue_post_dispatch", 32);
+
+    for (int i = 0; i < 32; i++) {
+        post_stamp = Benchmark::read_timer();
+        queue.call(event_handler);
+        queue.dispatch(0);
+        bench.add_sample(dispatch_delta);
+    }
+    bench.complete();
+    gate(bench, BASELINE_EVENTQUEUE_DISPATCH);
+}
+
+Case cases[] = {
+    Case("Benchmark: thread switch, higher priority partner", test_thread_switch_higher_priority),
+    Case("Benchmark: thread switch, lower priority partner", test_thread_switch_lower_priority),
+    Case("Benchmark: queue put/get round trip", test_queue_put_get),
+    Case("Benchmark: mutex acquire/release", test_mutex_lock_unlock),
+    Case("Benchmark: ISR to thread wakeup", test_isr_to_thread),
+    Case("Benchmark: EventQueue post to dispatch", test_eventqueue_dispatch),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -0,0 +1,309 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Crypto benchmark, the in-tree counterpart of mbed TLS's benchmark
+ * program. Each case runs one primitive in a timed loop against the us
+ * ticker and reports throughput - KB/s and cycles/byte for the bulk
+ * primitives, ops/s for the public-key ones - so the effect of a config
+ * change (MBEDTLS_AES_ROM_TABLES, MBEDTLS_ECP_WINDOW_SIZE, hardware
+ * acceleration...) on a given target shows up in the test log before
+ * release. Crypto return codes are asserted, so a broken primitive fails
+ * the suite rather than producing a fast nonsense number.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/sha256.h"
+#include "mbedtls/aes.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/ecdh.h"
+
+#include <string.h>
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#define mbedtls_printf     printf
+#endif
+
+/* Time each primitive for about this long */
+#define BENCH_US        1000000
+/* Buffer processed per iteration of the bulk primitives */
+#define BENCH_BUF_SIZE  1024
+
+static unsigned char bench_buf[BENCH_BUF_SIZE];
+
+/* Deterministic filler; benchmarks need no real entropy */
+static unsigned long bench_rng_state;
+static int bench_rng(void *p, unsigned char *out, size_t len)
+{
+    (void) p;
+    for (size_t i = 0; i < len; i++) {
+        bench_rng_state = bench_rng_state * 1103515245 + 12345;
+        out[i] = (unsigned char)(bench_rng_state >> 16);
+    }
+    return 0;
+}
+
+/* Report a bulk primitive: ops are BENCH_BUF_SIZE bytes each */
+static void report_bulk(const char *name, uint32_t ops, uint32_t us)
+{
+    uint64_t bytes = (uint64_t) ops * BENCH_BUF_SIZE;
+    uint32_t kb_s = (uint32_t)(bytes * 1000000 / us / 1024);
+    uint32_t cpb_x10 = (uint32_t)((uint64_t) SystemCoreClock / 100000 * us / bytes);
+
+    mbedtls_printf("[bench] %s: %lu KB/s, %lu.%lu cycles/byte "
+                   "(%lu ops of %u bytes in %lu us at %lu Hz)\n",
+                   name, (unsigned long) kb_s,
+                   (unsigned long)(cpb_x10 / 10), (unsigned long)(cpb_x10 % 10),
+                   (unsigned long) ops, BENCH_BUF_SIZE, (unsigned long) us,
+                   (unsigned long) SystemCoreClock);
+}
+
+/* Report a public-key primitive */
+static void report_ops(const char *name, uint32_t ops, uint32_t us)
+{
+    uint32_t ops_s_x10 = (uint32_t)((uint64_t) ops * 10000000 / us);
+
+    mbedtls_printf("[bench] %s: %lu.%lu ops/s (%lu ops in %lu us)\n",
+                   name, (unsigned long)(ops_s_x10 / 10),
+                   (unsigned long)(ops_s_x10 % 10),
+                   (unsigned long) ops, (unsigned long) us);
+}
+
+#if defined(MBEDTLS_SHA256_C)
+void bench_sha256()
+{
+    unsigned char output[32];
+    uint32_t ops = 0;
+    Timer t;
+
+    t.start();
+    do {
+        mbedtls_sha256(bench_buf, sizeof(bench_buf), output, 0);
+        ops++;
+    } while (t.read_us() < BENCH_US);
+
+    report_bulk("SHA-256", ops, t.read_us());
+}
+#endif
+
+#if defined(MBEDTLS_AES_C) && defined(MBEDTLS_CIPHER_MODE_CBC)
+static void bench_aes_cbc(const char *name, unsigned keybits)
+{
+    mbedtls_aes_context aes;
+    unsigned char key[32];
+    unsigned char iv[16];
+    uint32_t ops = 0;
+    int ret = 0;
+    Timer t;
+
+    memset(key, 0x2A, sizeof(key));
+    memset(iv, 0, sizeof(iv));
+
+    mbedtls_aes_init(&aes);
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_setkey_enc(&aes, key, keybits));
+
+    t.start();
+    do {
+        ret |= mbedtls_aes_crypt_cbc(&aes, MBEDTLS_AES_ENCRYPT,
+                                     sizeof(bench_buf), iv,
+                                     bench_buf, bench_buf);
+        ops++;
+    } while (t.read_us() < BENCH_US);
+    TEST_ASSERT_EQUAL(0, ret);
+
+    report_bulk(name, ops, t.read_us());
+
+    mbedtls_aes_free(&aes);
+}
+
+void bench_aes_cbc_128()
+{
+    bench_aes_cbc("AES-CBC-128", 128);
+}
+
+void bench_aes_cbc_256()
+{
+    bench_aes_cbc("AES-CBC-256", 256);
+}
+#endif
+
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+void bench_aes_gcm_128()
+{
+    mbedtls_gcm_context gcm;
+    unsigned char key[16];
+    unsigned char iv[12];
+    unsigned char tag[16];
+    uint32_t ops = 0;
+    int ret = 0;
+    Timer t;
+
+    memset(key, 0x2A, sizeof(key));
+    memset(iv, 0, sizeof(iv));
+
+    mbedtls_gcm_init(&gcm);
+    TEST_ASSERT_EQUAL(0, mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES,
+                                            key, 128));
+
+    t.start();
+    do {
+        ret |= mbedtls_gcm_crypt_and_tag(&gcm, MBEDTLS_GCM_ENCRYPT,
+                                         sizeof(bench_buf), iv, sizeof(iv),
+                                         NULL, 0, bench_buf, bench_buf,
+                                         sizeof(tag), tag);
+        ops++;
+    } while (t.read_us() < BENCH_US);
+    TEST_ASSERT_EQUAL(0, ret);
+
+    report_bulk("AES-GCM-128", ops, t.read_us());
+
+    mbedtls_gcm_free(&gcm);
+}
+#endif
+
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+void bench_ecdsa_p256()
+{
+    mbedtls_ecdsa_context ecdsa;
+    unsigned char hash[32];
+    unsigned char sig[MBEDTLS_ECDSA_MAX_LEN];
+    size_t sig_len = 0;
+    uint32_t ops;
+    Timer t;
+
+    memset(hash, 0x5C, sizeof(hash));
+
+    mbedtls_ecdsa_init(&ecdsa);
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_genkey(&ecdsa, MBEDTLS_ECP_DP_SECP256R1,
+                                              bench_rng, NULL));
+
+    ops = 0;
+    t.start();
+    do {
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_write_signature(&ecdsa,
+                MBEDTLS_MD_SHA256, hash, sizeof(hash), sig, &sig_len,
+                bench_rng, NULL));
+        ops++;
+    } while (t.read_us() < BENCH_US);
+
+    report_ops("ECDSA-sign-P256", ops, t.read_us());
+
+    ops = 0;
+    t.reset();
+    do {
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_read_signature(&ecdsa,
+                hash, sizeof(hash), sig, sig_len));
+        ops++;
+    } while (t.read_us() < BENCH_US);
+
+    report_ops("ECDSA-verify-P256", ops, t.read_us());
+
+    mbedtls_ecdsa_free(&ecdsa);
+}
+#endif
+
+#if defined(MBEDTLS_ECDH_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+void bench_ecdhe_p256()
+{
+    mbedtls_ecdh_context ecdh;
+    mbedtls_mpi peer_d;
+    mbedtls_ecp_point peer_Q;
+    uint32_t ops = 0;
+    Timer t;
+
+    mbedtls_ecdh_init(&ecdh);
+    mbedtls_mpi_init(&peer_d);
+    mbedtls_ecp_point_init(&peer_Q);
+
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&ecdh.grp,
+                                                MBEDTLS_ECP_DP_SECP256R1));
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_gen_keypair(&ecdh.grp, &peer_d, &peer_Q,
+                                                 bench_rng, NULL));
+
+    /* One op is our per-handshake cost: generate an ephemeral keypair and
+     * derive the shared secret from the peer's public key */
+    t.start();
+    do {
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdh_gen_public(&ecdh.grp, &ecdh.d,
+                &ecdh.Q, bench_rng, NULL));
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdh_compute_shared(&ecdh.grp, &ecdh.z,
+                &peer_Q, &ecdh.d, bench_rng, NULL));
+        ops++;
+    } while (t.read_us() < BENCH_US);
+
+    report_ops("ECDHE-P256", ops, t.read_us());
+
+    mbedtls_mpi_free(&peer_d);
+    mbedtls_ecp_point_free(&peer_Q);
+    mbedtls_ecdh_free(&ecdh);
+}
+#endif
+
+utest::v1::status_t case_setup(const Case *const source,
+                               const size_t index_of_case)
+{
+    bench_rng_state = 0x12345678;
+    bench_rng(NULL, bench_buf, sizeof(bench_buf));
+    return greentea_case_setup_handler(source, index_of_case);
+}
+
+Case cases[] = {
+#if defined(MBEDTLS_SHA256_C)
+    Case("SHA-256 benchmark", case_setup, bench_sha256),
+#endif
+#if defined(MBEDTLS_AES_C) && defined(MBEDTLS_CIPHER_MODE_CBC)
+    Case("AES-CBC-128 benchmark", case_setup, bench_aes_cbc_128),
+    Case("AES-CBC-256 benchmark", case_setup, bench_aes_cbc_256),
+#endif
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+    Case("AES-GCM-128 benchmark", case_setup, bench_aes_gcm_128),
+#endif
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+    Case("ECDSA P-256 benchmark", case_setup, bench_ecdsa_p256),
+#endif
+#if defined(MBEDTLS_ECDH_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+    Case("ECDHE P-256 benchmark", case_setup, bench_ecdhe_p256),
+#endif
+};
+
+utest::v1::status_t test_setup(const size_t num_cases)
+{
+    GREENTEA_SETUP(240, "default_auto");
+    return verbose_test_setup_handler(num_cases);
+}
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
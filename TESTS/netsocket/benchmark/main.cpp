@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2013-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+ #ifndef MBED_CONF_APP_CONNECT_STATEMENT
+     #error [NOT_SUPPORTED] No network configuration found for this target.
+ #endif
+
+#ifndef MBED_EXTENDED_TESTS
+    #error [NOT_SUPPORTED] Benchmarks are not supported by default
+#endif
+
+#include "mbed.h"
+#include MBED_CONF_APP_HEADER_FILE
+#include "TCPSocket.h"
+#include "UDPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+
+// Bytes streamed per direction for the bulk transfer measurement
+#ifndef MBED_CFG_BENCHMARK_BULK_SIZE
+#define MBED_CFG_BENCHMARK_BULK_SIZE 0x20000
+#endif
+
+// Chunk size used when streaming the bulk transfer
+#ifndef MBED_CFG_BENCHMARK_BUFFER_SIZE
+#define MBED_CFG_BENCHMARK_BUFFER_SIZE 1024
+#endif
+
+// Number of round-trips sampled for the latency percentiles
+#ifndef MBED_CFG_BENCHMARK_RTT_SAMPLES
+#define MBED_CFG_BENCHMARK_RTT_SAMPLES 200
+#endif
+
+// Payload of each round-trip message
+#ifndef MBED_CFG_BENCHMARK_RTT_SIZE
+#define MBED_CFG_BENCHMARK_RTT_SIZE 32
+#endif
+
+// Number of connect/close cycles for the connection-setup rate
+#ifndef MBED_CFG_BENCHMARK_CONNECTIONS
+#define MBED_CFG_BENCHMARK_CONNECTIONS 32
+#endif
+
+// Per-operation timeout, generous so a lost datagram doesn't stall a run
+#ifndef MBED_CFG_BENCHMARK_TIMEOUT
+#define MBED_CFG_BENCHMARK_TIMEOUT 5000
+#endif
+
+
+namespace {
+    NetworkInterface *net;
+    uint8_t buffer[MBED_CFG_BENCHMARK_BUFFER_SIZE];
+    int32_t samples[MBED_CFG_BENCHMARK_RTT_SAMPLES];
+}
+
+void prep_buffer(uint8_t *buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = (rand() % 10) + '0';
+    }
+}
+
+// Sorts the sample array in place so percentiles can be read by index
+static void sort_samples(int32_t *samples, int count) {
+    for (int i = 1; i < count; i++) {
+        int32_t v = samples[i];
+        int j = i;
+        while (j > 0 && samples[j-1] > v) {
+            samples[j] = samples[j-1];
+            j--;
+        }
+        samples[j] = v;
+    }
+}
+
+static int32_t percentile(int32_t *sorted, int count, int p) {
+    int i = (count * p) / 100;
+    if (i >= count) {
+        i = count - 1;
+    }
+    return sorted[i];
+}
+
+static void report_percentiles(const char *name, int32_t *samples, int count) {
+    sort_samples(samples, count);
+    printf("MBED: %s rtt us min/p50/p90/p99/max: "
+           "%ld/%ld/%ld/%ld/%ld\r\n", name,
+           samples[0],
+           percentile(samples, count, 50),
+           percentile(samples, count, 90),
+           percentile(samples, count, 99),
+           samples[count-1]);
+    greentea_send_kv(name, percentile(samples, count, 50));
+}
+
+void test_tcp_bulk_transfer() {
+    TCPSocket sock;
+    SocketAddress tcp_addr(MBED_CONF_APP_ECHO_SERVER_ADDR, MBED_CONF_APP_ECHO_SERVER_PORT);
+
+    nsapi_error_t err = sock.open(net);
+    TEST_ASSERT_EQUAL(0, err);
+    err = sock.connect(tcp_addr);
+    TEST_ASSERT_EQUAL(0, err);
+    sock.set_timeout(MBED_CFG_BENCHMARK_TIMEOUT);
+
+    // recv connection prefix message
+    sock.recv(buffer, sizeof(MBED_CONF_APP_TCP_ECHO_PREFIX));
+
+    prep_buffer(buffer, sizeof(buffer));
+
+    Timer timer;
+    timer.start();
+
+    // Stream the payload out while draining the echo, so both
+    // directions are measured together
+    size_t tx_count = 0;
+    size_t rx_count = 0;
+
+    sock.set_blocking(false);
+
+    while (tx_count < MBED_CFG_BENCHMARK_BULK_SIZE ||
+           rx_count < MBED_CFG_BENCHMARK_BULK_SIZE) {
+        if (tx_count < MBED_CFG_BENCHMARK_BULK_SIZE) {
+            size_t chunk = MBED_CFG_BENCHMARK_BULK_SIZE - tx_count;
+            if (chunk > sizeof(buffer)) {
+                chunk = sizeof(buffer);
+            }
+
+            nsapi_size_or_error_t td = sock.send(buffer, chunk);
+            TEST_ASSERT(td > 0 || td == NSAPI_ERROR_WOULD_BLOCK);
+            if (td > 0) {
+                tx_count += td;
+            }
+        }
+
+        while (rx_count < MBED_CFG_BENCHMARK_BULK_SIZE) {
+            nsapi_size_or_error_t rd = sock.recv(buffer, sizeof(buffer));
+            TEST_ASSERT(rd > 0 || rd == NSAPI_ERROR_WOULD_BLOCK);
+            if (rd > 0) {
+                rx_count += rd;
+            } else {
+                break;
+            }
+        }
+    }
+
+    timer.stop();
+
+    err = sock.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    float seconds = timer.read_us() / 1000000.0f;
+    printf("MBED: tcp bulk %d bytes each way in %fs\r\n",
+           MBED_CFG_BENCHMARK_BULK_SIZE, seconds);
+    printf("MBED: tcp bulk throughput: %.3fkb/s\r\n",
+           8*2*MBED_CFG_BENCHMARK_BULK_SIZE / (1000*seconds));
+    greentea_send_kv("tcp_bulk_kbps",
+            (int)(8*2*MBED_CFG_BENCHMARK_BULK_SIZE / (1000*seconds)));
+}
+
+void test_tcp_small_rtt() {
+    TCPSocket sock;
+    SocketAddress tcp_addr(MBED_CONF_APP_ECHO_SERVER_ADDR, MBED_CONF_APP_ECHO_SERVER_PORT);
+
+    nsapi_error_t err = sock.open(net);
+    TEST_ASSERT_EQUAL(0, err);
+    err = sock.connect(tcp_addr);
+    TEST_ASSERT_EQUAL(0, err);
+    sock.set_timeout(MBED_CFG_BENCHMARK_TIMEOUT);
+
+    // recv connection prefix message
+    sock.recv(buffer, sizeof(MBED_CONF_APP_TCP_ECHO_PREFIX));
+
+    prep_buffer(buffer, MBED_CFG_BENCHMARK_RTT_SIZE);
+
+    Timer timer;
+    timer.start();
+
+    for (int i = 0; i < MBED_CFG_BENCHMARK_RTT_SAMPLES; i++) {
+        int32_t start = timer.read_us();
+
+        nsapi_size_or_error_t td = sock.send(buffer, MBED_CFG_BENCHMARK_RTT_SIZE);
+        TEST_ASSERT_EQUAL(MBED_CFG_BENCHMARK_RTT_SIZE, td);
+
+        size_t rx_count = 0;
+        while (rx_count < MBED_CFG_BENCHMARK_RTT_SIZE) {
+            nsapi_size_or_error_t rd = sock.recv(buffer, sizeof(buffer));
+            TEST_ASSERT(rd > 0);
+            rx_count += rd;
+        }
+
+        samples[i] = timer.read_us() - start;
+    }
+
+    err = sock.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    report_percentiles("tcp_rtt_us", samples, MBED_CFG_BENCHMARK_RTT_SAMPLES);
+}
+
+void test_udp_small_rtt() {
+    UDPSocket sock;
+    SocketAddress udp_addr(MBED_CONF_APP_ECHO_SERVER_ADDR, MBED_CONF_APP_ECHO_SERVER_PORT);
+
+    nsapi_error_t err = sock.open(net);
+    TEST_ASSERT_EQUAL(0, err);
+    sock.set_timeout(MBED_CFG_BENCHMARK_TIMEOUT);
+
+    prep_buffer(buffer, MBED_CFG_BENCHMARK_RTT_SIZE);
+
+    Timer timer;
+    timer.start();
+
+    int lost = 0;
+    for (int i = 0; i < MBED_CFG_BENCHMARK_RTT_SAMPLES; i++) {
+        int32_t start = timer.read_us();
+
+        nsapi_size_or_error_t td = sock.sendto(udp_addr, buffer, MBED_CFG_BENCHMARK_RTT_SIZE);
+        TEST_ASSERT_EQUAL(MBED_CFG_BENCHMARK_RTT_SIZE, td);
+
+        SocketAddress peer;
+        nsapi_size_or_error_t rd = sock.recvfrom(&peer, buffer, sizeof(buffer));
+        if (rd < 0) {
+            // a lost datagram drops the sample, not the run
+            samples[i] = samples[i > 0 ? i-1 : 0];
+            lost++;
+            continue;
+        }
+
+        samples[i] = timer.read_us() - start;
+    }
+
+    err = sock.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    printf("MBED: udp lost %d of %d datagrams\r\n",
+           lost, MBED_CFG_BENCHMARK_RTT_SAMPLES);
+    TEST_ASSERT(lost < MBED_CFG_BENCHMARK_RTT_SAMPLES / 10);
+
+    report_percentiles("udp_rtt_us", samples, MBED_CFG_BENCHMARK_RTT_SAMPLES);
+}
+
+void test_tcp_connection_rate() {
+    SocketAddress tcp_addr(MBED_CONF_APP_ECHO_SERVER_ADDR, MBED_CONF_APP_ECHO_SERVER_PORT);
+
+    Timer timer;
+    timer.start();
+
+    for (int i = 0; i < MBED_CFG_BENCHMARK_CONNECTIONS; i++) {
+        TCPSocket sock;
+        nsapi_error_t err = sock.open(net);
+        TEST_ASSERT_EQUAL(0, err);
+        sock.set_timeout(MBED_CFG_BENCHMARK_TIMEOUT);
+
+        err = sock.connect(tcp_addr);
+        TEST_ASSERT_EQUAL(0, err);
+
+        // recv connection prefix message
+        sock.recv(buffer, sizeof(MBED_CONF_APP_TCP_ECHO_PREFIX));
+
+        err = sock.close();
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    timer.stop();
+
+    float seconds = timer.read_us() / 1000000.0f;
+    printf("MBED: %d connections in %fs\r\n",
+           MBED_CFG_BENCHMARK_CONNECTIONS, seconds);
+    printf("MBED: connection setup rate: %.3f/s\r\n",
+           MBED_CFG_BENCHMARK_CONNECTIONS / seconds);
+    greentea_send_kv("tcp_conn_us",
+            (int)(1000000.0f * seconds / MBED_CFG_BENCHMARK_CONNECTIONS));
+}
+
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(480, "tcp_echo");
+
+    net = MBED_CONF_APP_OBJECT_CONSTRUCTION;
+    int err = MBED_CONF_APP_CONNECT_STATEMENT;
+    TEST_ASSERT_EQUAL(0, err);
+
+    printf("MBED: client IP address is '%s'\n", net->get_ip_address());
+
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("TCP bulk transfer throughput", test_tcp_bulk_transfer),
+    Case("TCP small-message round-trip", test_tcp_small_rtt),
+    Case("UDP small-message round-trip", test_udp_small_rtt),
+    Case("TCP connection setup rate", test_tcp_connection_rate),
+};
+
+Specification specification(test_setup, cases);
+
+int main() {
+    return !Harness::run(specification);
+}
@@ -23,6 +23,7 @@
 #include "hal/analogin_api.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
+#include "drivers/Ticker.h"
 
 namespace mbed {
 /** \addtogroup drivers */
@@ -57,7 +58,8 @@ public:
      *
      * @param pin AnalogIn pin to connect to
      */
-    AnalogIn(PinName pin) {
+    AnalogIn(PinName pin) : _stream_ticker(NULL), _stream_len(0),
+                            _stream_pos(0), _stream_active(0) {
         lock();
         analogin_init(&_adc, pin);
         unlock();
@@ -86,6 +88,42 @@ public:
         return ret;
     }
 
+    /** Start continuous timer-paced capture into ping-pong buffers
+     *
+     *  Conversions are paced from the ticker interrupt straight into the
+     *  active buffer without taking the mutex, and the buffer-complete
+     *  callback is invoked from interrupt context with the filled buffer
+     *  while capture continues into the other one. The pin must not be
+     *  read through read()/read_u16() while a stream is active.
+     *
+     * @param buf_a     First capture buffer
+     * @param buf_b     Second capture buffer
+     * @param length    Number of samples each buffer holds
+     * @param period_us Sampling period in microseconds
+     * @param func      Function called with (buffer, length) each time a buffer fills
+     */
+    void start_stream(unsigned short *buf_a, unsigned short *buf_b, size_t length,
+                      int period_us, Callback<void(unsigned short *, size_t)> func) {
+        lock();
+        stop_stream_nolock();
+        _stream_buf[0] = buf_a;
+        _stream_buf[1] = buf_b;
+        _stream_len = length;
+        _stream_pos = 0;
+        _stream_active = 0;
+        _stream_cb = func;
+        _stream_ticker = new Ticker;
+        _stream_ticker->attach_us(callback(this, &AnalogIn::stream_sample_irq), period_us);
+        unlock();
+    }
+
+    /** Stop a continuous capture started with start_stream() */
+    void stop_stream() {
+        lock();
+        stop_stream_nolock();
+        unlock();
+    }
+
     /** An operator shorthand for read()
      *
      * The float() operator can be used as a shorthand for read() to simplify common code sequences
@@ -105,7 +143,7 @@ public:
     }
 
     virtual ~AnalogIn() {
-        // Do nothing
+        stop_stream();
     }
 
 protected:
@@ -118,8 +156,40 @@ protected:
         _mutex->unlock();
     }
 
+    /** Ticker handler for the streaming capture path
+     *  Converts one sample into the active buffer and flips buffers when full.
+     */
+    void stream_sample_irq() {
+        // No lock - the pin is owned by the stream while it is active
+        _stream_buf[_stream_active][_stream_pos++] = analogin_read_u16(&_adc);
+        if (_stream_pos == _stream_len) {
+            unsigned short *filled = _stream_buf[_stream_active];
+            _stream_active ^= 1;
+            _stream_pos = 0;
+            if (_stream_cb) {
+                _stream_cb(filled, _stream_len);
+            }
+        }
+    }
+
+    /** Stop streaming with the mutex already held */
+    void stop_stream_nolock() {
+        if (_stream_ticker) {
+            _stream_ticker->detach();
+            delete _stream_ticker;
+            _stream_ticker = NULL;
+            _stream_cb = NULL;
+        }
+    }
+
     analogin_t _adc;
     static SingletonPtr<PlatformMutex> _mutex;
+    Ticker *_stream_ticker;
+    unsigned short *_stream_buf[2];
+    size_t _stream_len;
+    size_t _stream_pos;
+    int _stream_active;
+    Callback<void(unsigned short *, size_t)> _stream_cb;
 };
 
 } // namespace mbed
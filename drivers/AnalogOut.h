@@ -23,6 +23,13 @@
 #include "hal/analogout_api.h"
 #include "platform/PlatformMutex.h"
 
+#if DEVICE_ANALOGOUT_ASYNCH
+#include "platform/CThunk.h"
+#include "hal/dma_api.h"
+#include "platform/FunctionPointer.h"
+#include "platform/mbed_sleep.h"
+#endif
+
 namespace mbed {
 /** \addtogroup drivers */
 
@@ -57,7 +64,11 @@ public:
      *
      * @param pin AnalogOut pin to connect to
      */
-    AnalogOut(PinName pin) {
+    AnalogOut(PinName pin)
+#if DEVICE_ANALOGOUT_ASYNCH
+        : _irq(this), _usage(DMA_USAGE_NEVER)
+#endif
+    {
         analogout_init(&_dac, pin);
     }
 
@@ -128,12 +139,93 @@ public:
         return read();
     }
 
+#if DEVICE_ANALOGOUT_ASYNCH
+
+    /** Start continuous playback of a circular sample buffer
+     *
+     *  The buffer is streamed to the DAC by timer-paced DMA: when the last
+     *  sample has been converted the transfer wraps to the first one without
+     *  CPU involvement. The callback fires from interrupt context with
+     *  DAC_EVENT_HALF_COMPLETE and DAC_EVENT_COMPLETE on every lap, so each
+     *  half of the buffer can be refilled while the other half is playing.
+     *  The buffer must stay valid until stop_waveform() is called.
+     *
+     *  @param samples            Circular buffer of normalised 16-bit samples
+     *                            (0x0000 = 0v, 0xFFFF = 3.3v)
+     *  @param length             Number of samples in the buffer
+     *  @param samples_per_second DAC conversion rate
+     *  @param callback           The event callback function
+     *  @param event              The logical OR of events to report
+     *  @return Zero if playback started, or -1 on invalid arguments or if
+     *          the DAC is already streaming
+     */
+    int start_waveform(const uint16_t *samples, int length, int samples_per_second,
+                       const event_callback_t &callback,
+                       int event = DAC_EVENT_HALF_COMPLETE | DAC_EVENT_COMPLETE) {
+        if ((samples == NULL) || (length <= 0) || (samples_per_second <= 0)) {
+            return -1;
+        }
+        lock();
+        if (analogout_active(&_dac)) {
+            unlock();
+            return -1;
+        }
+        _callback = callback;
+        _irq.callback(&AnalogOut::irq_handler_asynch);
+        sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_DAC);
+        analogout_stream(&_dac, samples, length, samples_per_second,
+                         _irq.entry(), event | DAC_EVENT_ERROR, _usage);
+        unlock();
+        return 0;
+    }
+
+    /** Stop waveform playback and the pacing timer
+     */
+    void stop_waveform() {
+        lock();
+        if (analogout_active(&_dac)) {
+            analogout_stream_abort(&_dac);
+            sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_DAC);
+        }
+        unlock();
+    }
+
+    /** Configure DMA usage suggestion for waveform playback
+     *
+     *  @param usage The usage DMA hint for peripheral
+     *  @return Zero if the usage was set, -1 if a stream is being played
+     */
+    int set_dma_usage(DMAUsage usage) {
+        if (analogout_active(&_dac)) {
+            return -1;
+        }
+        _usage = usage;
+        return 0;
+    }
+
+#endif
+
     virtual ~AnalogOut() {
         // Do nothing
     }
 
 protected:
 
+#if DEVICE_ANALOGOUT_ASYNCH
+    /** DAC stream IRQ handler: forwards half/complete refill events
+     */
+    void irq_handler_asynch(void) {
+        int event = analogout_irq_handler_asynch(&_dac);
+        if (event & DAC_EVENT_ERROR) {
+            // the HAL stopped the stream on error
+            sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_DAC);
+        }
+        if (_callback && (event & DAC_EVENT_ALL)) {
+            _callback.call(event & DAC_EVENT_ALL);
+        }
+    }
+#endif
+
     virtual void lock() {
         _mutex.lock();
     }
@@ -144,6 +236,12 @@ protected:
 
     dac_t _dac;
     PlatformMutex _mutex;
+
+#if DEVICE_ANALOGOUT_ASYNCH
+    CThunk<AnalogOut> _irq;
+    event_callback_t _callback;
+    DMAUsage _usage;
+#endif
 };
 
 } // namespace mbed
@@ -0,0 +1,127 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/AnalogStreamProcessor.h"
+
+#if DEVICE_ANALOGIN
+
+#include <string.h>
+#include <math.h>
+
+/* The CMSIS-DSP kernels need the core selected through an ARM_MATH_CMx
+ * macro; without one the scalar fallbacks below implement the same
+ * arithmetic on the same coefficient and state layout. */
+#if defined(ARM_MATH_CM0) || defined(ARM_MATH_CM0PLUS) || defined(ARM_MATH_CM3) || \
+    defined(ARM_MATH_CM4) || defined(ARM_MATH_CM7) || \
+    defined(ARM_MATH_ARMV8MBL) || defined(ARM_MATH_ARMV8MML)
+#include "arm_math.h"
+#define ANALOG_STREAM_CMSIS_DSP 1
+#else
+#define ANALOG_STREAM_CMSIS_DSP 0
+#endif
+
+namespace mbed {
+
+AnalogStreamProcessor::AnalogStreamProcessor(events::EventQueue *queue, float *work, size_t work_size) :
+    _queue(queue), _work(work), _work_size(work_size), _decimation(1),
+    _coeffs(NULL), _state(NULL), _stages(0), _cb(NULL)
+{
+}
+
+void AnalogStreamProcessor::set_decimation(unsigned factor)
+{
+    _decimation = factor ? factor : 1;
+}
+
+void AnalogStreamProcessor::set_biquads(const float *coeffs, unsigned stages, float *state)
+{
+    if (state && stages) {
+        memset(state, 0, 4 * stages * sizeof(float));
+    }
+    _coeffs = coeffs;
+    _state = state;
+    _stages = stages;
+}
+
+void AnalogStreamProcessor::attach(Callback<void(const float *, size_t, float)> func)
+{
+    _cb = func;
+}
+
+bool AnalogStreamProcessor::push(unsigned short *buffer, size_t length)
+{
+    return _queue->call(callback(this, &AnalogStreamProcessor::process), buffer, length) != 0;
+}
+
+void AnalogStreamProcessor::process(unsigned short *buffer, size_t length)
+{
+    size_t count = length / _decimation;
+    if (count > _work_size) {
+        count = _work_size;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    // Decimate and normalise the raw conversions to [0.0, 1.0] floats
+    for (size_t i = 0; i < count; i++) {
+        _work[i] = buffer[i * _decimation] * (1.0f / 65535.0f);
+    }
+
+    if (_stages) {
+#if ANALOG_STREAM_CMSIS_DSP
+        arm_biquad_casd_df1_inst_f32 inst;
+        inst.numStages = _stages;
+        inst.pState = _state;
+        inst.pCoeffs = (float32_t *)_coeffs;
+        arm_biquad_cascade_df1_f32(&inst, _work, _work, count);
+#else
+        // Direct-form I cascade, one stage at a time over the whole
+        // buffer; state layout {x1, x2, y1, y2} matches CMSIS-DSP
+        for (unsigned stage = 0; stage < _stages; stage++) {
+            const float *c = &_coeffs[5 * stage];
+            float *s = &_state[4 * stage];
+            for (size_t i = 0; i < count; i++) {
+                float x = _work[i];
+                float y = c[0] * x + c[1] * s[0] + c[2] * s[1] + c[3] * s[2] + c[4] * s[3];
+                s[1] = s[0];
+                s[0] = x;
+                s[3] = s[2];
+                s[2] = y;
+                _work[i] = y;
+            }
+        }
+#endif
+    }
+
+    float rms;
+#if ANALOG_STREAM_CMSIS_DSP
+    arm_rms_f32(_work, count, &rms);
+#else
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        sum += _work[i] * _work[i];
+    }
+    rms = sqrtf(sum / count);
+#endif
+
+    if (_cb) {
+        _cb(_work, count, rms);
+    }
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,140 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGSTREAMPROCESSOR_H
+#define MBED_ANALOGSTREAMPROCESSOR_H
+
+#include "platform/platform.h"
+
+#if defined (DEVICE_ANALOGIN) || defined(DOXYGEN_ONLY)
+
+#include "events/EventQueue.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Deferred processing stage for AnalogIn streaming capture
+ *
+ *  Consumes the ping-pong buffers produced by AnalogIn::start_stream() and
+ *  runs an optional decimate / biquad-filter / RMS pipeline over them as a
+ *  job on an EventQueue, so the heavy arithmetic happens on the queue's
+ *  dispatch context rather than in the capture interrupt. On cores built
+ *  with CMSIS-DSP enabled (one of the ARM_MATH_CMx macros defined) the
+ *  filter and RMS steps run the arm_biquad_cascade_df1_f32 / arm_rms_f32
+ *  kernels; otherwise a portable scalar implementation with the same
+ *  coefficient and state layout is used.
+ *
+ *  The buffer handed to push() must stay untouched until the result
+ *  callback has run; with AnalogIn's ping-pong capture this holds as long
+ *  as the queue drains each buffer within one buffer-fill period.
+ *
+ *  Example:
+ *  @code
+ *  // 50 kS/s vibration capture, decimate by 4, band-pass, RMS
+ *  AnalogIn sensor(A0);
+ *  EventQueue queue;
+ *  float work[256];
+ *  AnalogStreamProcessor dsp(&queue, work, 256);
+ *
+ *  float coeffs[5] = { b0, b1, b2, a1, a2 };
+ *  float state[4];
+ *  dsp.set_decimation(4);
+ *  dsp.set_biquads(coeffs, 1, state);
+ *  dsp.attach(features_ready);
+ *  sensor.start_stream(buf_a, buf_b, 1024, 20, callback(&dsp, &AnalogStreamProcessor::push));
+ *  queue.dispatch_forever();
+ *  @endcode
+ *
+ *  @note Synchronization level: Interrupt safe (push() only; configuration
+ *        must not race with a job in flight)
+ *  @ingroup drivers
+ */
+class AnalogStreamProcessor : private NonCopyable<AnalogStreamProcessor> {
+public:
+    /** Create a processing stage on an event queue
+     *
+     * @param queue     Queue the processing jobs are dispatched on
+     * @param work      Work buffer the decimated float samples are
+     *                  processed in; results are delivered out of it
+     * @param work_size Number of floats the work buffer holds; output is
+     *                  clipped to this many samples per capture buffer
+     */
+    AnalogStreamProcessor(events::EventQueue *queue, float *work, size_t work_size);
+
+    /** Set the decimation factor applied before filtering
+     *
+     *  Every factor-th sample of the capture buffer is kept; a factor of 1
+     *  (the default) keeps them all.
+     *
+     * @param factor Decimation factor, at least 1
+     */
+    void set_decimation(unsigned factor);
+
+    /** Configure a direct-form I biquad cascade run over each buffer
+     *
+     *  Coefficients follow the CMSIS-DSP df1 convention: five per stage
+     *  {b0, b1, b2, a1, a2} with the feedback signs pre-negated, so
+     *  y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] + a1*y[n-1] + a2*y[n-2].
+     *  Filter state carries across buffers, as a streaming filter must.
+     *
+     * @param coeffs Coefficient array, 5 floats per stage
+     * @param stages Number of second-order stages, 0 disables filtering
+     * @param state  State array, 4 floats per stage, zeroed here
+     */
+    void set_biquads(const float *coeffs, unsigned stages, float *state);
+
+    /** Attach the function called with each processed buffer
+     *
+     *  Runs on the queue's dispatch context with the processed samples in
+     *  the work buffer, their count, and their root-mean-square value.
+     *
+     * @param func Function called as func(samples, count, rms)
+     */
+    void attach(Callback<void(const float *, size_t, float)> func);
+
+    /** Hand a filled capture buffer over for processing
+     *
+     *  Interrupt safe; pass this method as the buffer-complete callback of
+     *  AnalogIn::start_stream(). The buffer is processed later from the
+     *  event queue.
+     *
+     * @param buffer Filled capture buffer
+     * @param length Number of samples in the buffer
+     *
+     * @returns true if the job was queued, false if the queue rejected it
+     *          (the buffer's samples are dropped)
+     */
+    bool push(unsigned short *buffer, size_t length);
+
+private:
+    void process(unsigned short *buffer, size_t length);
+
+    events::EventQueue *_queue;
+    float *_work;
+    size_t _work_size;
+    unsigned _decimation;
+    const float *_coeffs;
+    float *_state;
+    unsigned _stages;
+    Callback<void(const float *, size_t, float)> _cb;
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
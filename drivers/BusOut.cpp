@@ -29,6 +29,7 @@ BusOut::BusOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinNa
             _nc_mask |= (1 << i);
         }
     }
+    setup_port(pins);
 }
 
 BusOut::BusOut(PinName pins[16]) {
@@ -40,6 +41,41 @@ BusOut::BusOut(PinName pins[16]) {
             _nc_mask |= (1 << i);
         }
     }
+    setup_port(pins);
+}
+
+void BusOut::setup_port(const PinName *pins) {
+#if DEVICE_PORTOUT
+    _port_backed = false;
+    PortName bus_port = (PortName)0;
+    int port_mask = 0;
+    bool first = true;
+    for (int i=0; i<16; i++) {
+        if (pins[i] == NC) {
+            continue;
+        }
+        PortName pin_port;
+        int pin_n;
+        if (port_decode_pin(pins[i], &pin_port, &pin_n) != 0) {
+            return;
+        }
+        if (first) {
+            bus_port = pin_port;
+            first = false;
+        } else if (pin_port != bus_port) {
+            return;
+        }
+        _port_pin_n[i] = (char)pin_n;
+        port_mask |= 1 << pin_n;
+    }
+    if (first) {
+        return;
+    }
+    port_init(&_port, bus_port, port_mask, PIN_OUTPUT);
+    _port_backed = true;
+#else
+    (void)pins;
+#endif
 }
 
 BusOut::~BusOut() {
@@ -53,6 +89,19 @@ BusOut::~BusOut() {
 
 void BusOut::write(int value) {
     lock();
+#if DEVICE_PORTOUT
+    if (_port_backed) {
+        int port_value = 0;
+        for (int i=0; i<16; i++) {
+            if (_pin[i] != 0 && ((value >> i) & 1)) {
+                port_value |= 1 << _port_pin_n[i];
+            }
+        }
+        port_write(&_port, port_value);
+        unlock();
+        return;
+    }
+#endif
     for (int i=0; i<16; i++) {
         if (_pin[i] != 0) {
             _pin[i]->write((value >> i) & 1);
@@ -64,6 +113,18 @@ void BusOut::write(int value) {
 int BusOut::read() {
     lock();
     int v = 0;
+#if DEVICE_PORTOUT
+    if (_port_backed) {
+        int port_value = port_read(&_port);
+        for (int i=0; i<16; i++) {
+            if (_pin[i] != 0 && ((port_value >> _port_pin_n[i]) & 1)) {
+                v |= 1 << i;
+            }
+        }
+        unlock();
+        return v;
+    }
+#endif
     for (int i=0; i<16; i++) {
         if (_pin[i] != 0) {
             v |= _pin[i]->read() << i;
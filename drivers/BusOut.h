@@ -17,6 +17,7 @@
 #define MBED_BUSOUT_H
 
 #include "drivers/DigitalOut.h"
+#include "hal/port_api.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
 
@@ -24,6 +25,11 @@ namespace mbed {
 /** \addtogroup drivers */
 
 /** A digital output bus, used for setting the state of a collection of pins
+ *
+ * When every connected pin decodes to the same GPIO port (see
+ * port_decode_pin()), the bus is written and read through the port HAL,
+ * so all bits change in a single masked store instead of one write per
+ * pin. Otherwise the pins are driven individually.
  * @ingroup drivers
  */
 class BusOut : private NonCopyable<BusOut> {
@@ -111,8 +117,18 @@ public:
 protected:
     virtual void lock();
     virtual void unlock();
+
+    /* Set up the single-port write path when all pins share a port */
+    void setup_port(const PinName *pins);
+
     DigitalOut* _pin[16];
 
+#if DEVICE_PORTOUT
+    port_t _port;
+    char _port_pin_n[16]; /* Port bit position of each bus bit */
+    bool _port_backed;    /* All pins share a port, use _port */
+#endif
+
     /* Mask of bus's NC pins
      * If bit[n] is set to 1 - pin is connected
      * if bit[n] is cleared - pin is not connected (NC)
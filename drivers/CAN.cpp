@@ -22,23 +22,31 @@
 
 namespace mbed {
 
-CAN::CAN(PinName rd, PinName td) : _can(), _irq() {
+CAN::CAN(PinName rd, PinName td) : _can(), _irq(), _rx_buffered(false) {
     // No lock needed in constructor
 
     for (size_t i = 0; i < sizeof _irq / sizeof _irq[0]; i++) {
         _irq[i] = NULL;
     }
+    for (size_t i = 0; i < sizeof _rx_rings / sizeof _rx_rings[0]; i++) {
+        _rx_rings[i].bound = false;
+        _rx_rings[i].handle = 0;
+    }
 
     can_init(&_can, rd, td);
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
 }
 
-CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq() {
+CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq(), _rx_buffered(false) {
     // No lock needed in constructor
 
     for (size_t i = 0; i < sizeof _irq / sizeof _irq[0]; i++) {
         _irq[i] = NULL;
     }
+    for (size_t i = 0; i < sizeof _rx_rings / sizeof _rx_rings[0]; i++) {
+        _rx_rings[i].bound = false;
+        _rx_rings[i].handle = 0;
+    }
 
     can_init_freq(&_can, rd, td, hz);
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
@@ -116,19 +124,85 @@ int CAN::filter(unsigned int id, unsigned int mask, CANFormat format, int handle
     return ret;
 }
 
+int CAN::filter_buffered(unsigned int id, unsigned int mask, CANFormat format, int handle) {
+    lock();
+    rx_ring_t *slot = NULL;
+    for (size_t i = 0; i < sizeof _rx_rings / sizeof _rx_rings[0]; i++) {
+        if (!_rx_rings[i].bound) {
+            slot = &_rx_rings[i];
+            break;
+        }
+    }
+    if (!slot) {
+        unlock();
+        return 0;
+    }
+
+    int new_handle = can_filter(&_can, id, mask, format, handle);
+    if (new_handle != 0) {
+        slot->handle = new_handle;
+        slot->ring.reset();
+        slot->bound = true;
+        if (!_rx_buffered) {
+            _rx_buffered = true;
+            unlock();
+            // attach() takes the lock itself
+            attach(callback(this, &CAN::rx_ring_irq), RxIrq);
+            return new_handle;
+        }
+    }
+    unlock();
+    return new_handle;
+}
+
+int CAN::read_burst(CANMessage *msgs, int count, int handle) {
+    rx_ring_t *slot = NULL;
+    for (size_t i = 0; i < sizeof _rx_rings / sizeof _rx_rings[0]; i++) {
+        if (_rx_rings[i].bound && _rx_rings[i].handle == handle) {
+            slot = &_rx_rings[i];
+            break;
+        }
+    }
+    if (!slot) {
+        return 0;
+    }
+
+    int read = 0;
+    while (read < count && slot->ring.pop(msgs[read])) {
+        read++;
+    }
+    return read;
+}
+
+void CAN::rx_ring_irq() {
+    // Move every pending frame off the peripheral into its filter's ring;
+    // the application drains the rings in batches with read_burst()
+    for (size_t i = 0; i < sizeof _rx_rings / sizeof _rx_rings[0]; i++) {
+        if (!_rx_rings[i].bound) {
+            continue;
+        }
+        CANMessage msg;
+        while (can_read(&_can, &msg, _rx_rings[i].handle)) {
+            if (!_rx_rings[i].ring.push(msg)) {
+                break; // ring full - frame dropped, as it would have been at the mailbox
+            }
+        }
+    }
+}
+
 void CAN::attach(Callback<void()> func, IrqType type) {
     lock();
     if (func) {
         // lock deep sleep only the first time
         if (!_irq[(CanIrqType)type]) {
-            sleep_manager_lock_deep_sleep();
+            sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_CAN);
         }
         _irq[(CanIrqType)type] = func;
         can_irq_set(&_can, (CanIrqType)type, 1);
     } else {
         // unlock deep sleep only the first time
         if (_irq[(CanIrqType)type]) {
-            sleep_manager_unlock_deep_sleep();
+            sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_CAN);
         }
         _irq[(CanIrqType)type] = NULL;
         can_irq_set(&_can, (CanIrqType)type, 0);
@@ -24,6 +24,15 @@
 #include "platform/Callback.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
+#include "platform/LockFreeCircularBuffer.h"
+
+#ifndef MBED_CONF_DRIVERS_CAN_RX_RING_SIZE
+#define MBED_CONF_DRIVERS_CAN_RX_RING_SIZE   16
+#endif
+
+#ifndef MBED_CONF_DRIVERS_CAN_RX_RING_COUNT
+#define MBED_CONF_DRIVERS_CAN_RX_RING_COUNT  4
+#endif
 
 namespace mbed {
 /** \addtogroup drivers */
@@ -207,6 +216,40 @@ public:
      */
     int filter(unsigned int id, unsigned int mask, CANFormat format = CANAny, int handle = 0);
 
+    /** Install a filter and bind it to a buffered receive ring
+     *
+     *  Installs the filter as filter() does and additionally binds its
+     *  handle to an internal lock-free ring. An internal RxIrq handler
+     *  then drains matching frames into the ring as they arrive, so
+     *  frames are no longer lost while the application is dispatching;
+     *  the application empties the ring in batches with read_burst().
+     *  Takes over the RxIrq attachment while any binding exists.
+     *
+     *  @param id the id to filter on
+     *  @param mask the mask applied to the id
+     *  @param format format to filter on (Default CANAny)
+     *  @param handle message filter handle (Optional)
+     *
+     *  @returns
+     *    0 if the filter change failed/unsupported or no ring is free,
+     *    new filter handle if successful
+     */
+    int filter_buffered(unsigned int id, unsigned int mask, CANFormat format = CANAny, int handle = 0);
+
+    /** Read multiple buffered CANMessages in one call
+     *
+     *  Pops up to count messages from the ring bound to the given filter
+     *  handle by filter_buffered().
+     *
+     *  @param msgs array the messages are read in to
+     *  @param count capacity of the array
+     *  @param handle message filter handle returned by filter_buffered()
+     *
+     *  @returns number of messages read, 0 if none buffered or the handle
+     *           has no bound ring
+     */
+    int read_burst(CANMessage *msgs, int count, int handle);
+
     /**  Detects read errors - Used to detect read overflow errors.
      *
      *  @returns number of read errors
@@ -286,9 +329,24 @@ public:
 protected:
     virtual void lock();
     virtual void unlock();
+
+    /** RxIrq handler for buffered receive mode
+     *  Drains the peripheral into the rings bound by filter_buffered().
+     */
+    void rx_ring_irq();
+
+    /** One buffered receive ring bound to a filter handle */
+    struct rx_ring_t {
+        bool bound;
+        int handle;
+        LockFreeCircularBuffer<CANMessage, MBED_CONF_DRIVERS_CAN_RX_RING_SIZE> ring;
+    };
+
     can_t               _can;
     Callback<void()>    _irq[IrqCnt];
     PlatformMutex       _mutex;
+    rx_ring_t           _rx_rings[MBED_CONF_DRIVERS_CAN_RX_RING_COUNT];
+    bool                _rx_buffered;
 };
 
 } // namespace mbed
@@ -0,0 +1,207 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/CRC.h"
+#include "platform/mbed_assert.h"
+
+namespace mbed {
+
+CRC::CRC(crc_polynomial_t polynomial) : _state(0), _hardware(false)
+{
+    _config.polynomial = (uint32_t)polynomial;
+    switch (polynomial) {
+        case POLY_32BIT_ANSI:
+            _config.width = 32;
+            _config.initial_xor = 0xFFFFFFFF;
+            _config.final_xor = 0xFFFFFFFF;
+            _config.reflect_in = true;
+            _config.reflect_out = true;
+            break;
+        case POLY_16BIT_CCITT:
+            _config.width = 16;
+            _config.initial_xor = 0xFFFF;
+            _config.final_xor = 0;
+            _config.reflect_in = false;
+            _config.reflect_out = false;
+            break;
+        case POLY_16BIT_IBM:
+            _config.width = 16;
+            _config.initial_xor = 0;
+            _config.final_xor = 0;
+            _config.reflect_in = true;
+            _config.reflect_out = true;
+            break;
+        case POLY_8BIT_CCITT:
+            _config.width = 8;
+            _config.initial_xor = 0;
+            _config.final_xor = 0;
+            _config.reflect_in = false;
+            _config.reflect_out = false;
+            break;
+        case POLY_7BIT_SD:
+        default:
+            _config.width = 7;
+            _config.initial_xor = 0;
+            _config.final_xor = 0;
+            _config.reflect_in = false;
+            _config.reflect_out = false;
+            break;
+    }
+    build_table();
+}
+
+CRC::CRC(uint32_t polynomial, uint8_t width, uint32_t initial_xor,
+         uint32_t final_xor, bool reflect_in, bool reflect_out)
+    : _state(0), _hardware(false)
+{
+    MBED_ASSERT(width > 0 && width <= 32);
+    _config.polynomial = polynomial;
+    _config.width = width;
+    _config.initial_xor = initial_xor;
+    _config.final_xor = final_xor;
+    _config.reflect_in = reflect_in;
+    _config.reflect_out = reflect_out;
+    build_table();
+}
+
+int32_t CRC::compute(const void *buffer, size_t size, uint32_t *crc)
+{
+    int32_t status = compute_partial_start();
+    if (status == 0) {
+        status = compute_partial(buffer, size);
+    }
+    if (status == 0) {
+        status = compute_partial_stop(crc);
+    }
+    return status;
+}
+
+int32_t CRC::compute_partial_start(void)
+{
+#if DEVICE_CRC
+    if (hal_crc_is_supported(&_config)) {
+        _hardware = true;
+        hal_crc_compute_partial_start(&_config);
+        return 0;
+    }
+#endif
+    _hardware = false;
+    if (_config.reflect_in) {
+        _state = reflect(_config.initial_xor, _config.width);
+    } else {
+        _state = _config.initial_xor << (32 - _config.width);
+    }
+    return 0;
+}
+
+int32_t CRC::compute_partial(const void *buffer, size_t size)
+{
+    if (buffer == NULL && size != 0) {
+        return -1;
+    }
+
+#if DEVICE_CRC
+    if (_hardware) {
+        hal_crc_compute_partial((const uint8_t *)buffer, size);
+        return 0;
+    }
+#endif
+
+    const uint8_t *data = (const uint8_t *)buffer;
+    uint32_t crc = _state;
+    if (_config.reflect_in) {
+        // shift register runs reflected in the low bits, input LSB first
+        for (size_t i = 0; i < size; i++) {
+            crc ^= data[i];
+            crc = (crc >> 4) ^ _table[crc & 0xF];
+            crc = (crc >> 4) ^ _table[crc & 0xF];
+        }
+    } else {
+        // shift register aligned to the top of the word, input MSB first
+        for (size_t i = 0; i < size; i++) {
+            crc ^= (uint32_t)data[i] << 24;
+            crc = (crc << 4) ^ _table[crc >> 28];
+            crc = (crc << 4) ^ _table[crc >> 28];
+        }
+    }
+    _state = crc;
+    return 0;
+}
+
+int32_t CRC::compute_partial_stop(uint32_t *crc)
+{
+    if (crc == NULL) {
+        return -1;
+    }
+
+#if DEVICE_CRC
+    if (_hardware) {
+        _hardware = false;
+        *crc = hal_crc_get_result();
+        return 0;
+    }
+#endif
+
+    uint32_t result;
+    if (_config.reflect_in) {
+        result = _config.reflect_out ? _state : reflect(_state, _config.width);
+    } else {
+        result = _state >> (32 - _config.width);
+        if (_config.reflect_out) {
+            result = reflect(result, _config.width);
+        }
+    }
+    result ^= _config.final_xor;
+    if (_config.width < 32) {
+        result &= (1UL << _config.width) - 1;
+    }
+    *crc = result;
+    return 0;
+}
+
+uint32_t CRC::reflect(uint32_t value, uint8_t bits)
+{
+    uint32_t reflected = 0;
+    for (uint8_t i = 0; i < bits; i++) {
+        reflected = (reflected << 1) | (value & 1);
+        value >>= 1;
+    }
+    return reflected;
+}
+
+void CRC::build_table(void)
+{
+    if (_config.reflect_in) {
+        uint32_t poly = reflect(_config.polynomial, _config.width);
+        for (uint32_t nibble = 0; nibble < 16; nibble++) {
+            uint32_t entry = nibble;
+            for (int bit = 0; bit < 4; bit++) {
+                entry = (entry >> 1) ^ ((entry & 1) ? poly : 0);
+            }
+            _table[nibble] = entry;
+        }
+    } else {
+        uint32_t poly = _config.polynomial << (32 - _config.width);
+        for (uint32_t nibble = 0; nibble < 16; nibble++) {
+            uint32_t entry = nibble << 28;
+            for (int bit = 0; bit < 4; bit++) {
+                entry = (entry << 1) ^ ((entry & 0x80000000UL) ? poly : 0);
+            }
+            _table[nibble] = entry;
+        }
+    }
+}
+
+} // namespace mbed
@@ -0,0 +1,117 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CRC_H
+#define MBED_CRC_H
+
+#include "hal/crc_api.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** CRC calculation, on the hardware CRC unit when the target has one
+ * that supports the configured polynomial, in software otherwise.
+ *
+ * The software path runs off a 16-entry table built once at
+ * construction, which checksums a byte in two lookups instead of eight
+ * shift-and-conditional-xor steps. Input can be fed incrementally, so
+ * scattered buffers - a frame header and its payload, say - are
+ * checksummed without being copied together first.
+ *
+ * @note Synchronization level: Not protected. A partial computation
+ *       owns the hardware unit until it is stopped.
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * CRC crc(POLY_32BIT_ANSI);
+ *
+ * uint32_t checksum;
+ * crc.compute(buffer, length, &checksum);
+ * @endcode
+ * @ingroup drivers
+ */
+class CRC : private NonCopyable<CRC> {
+public:
+    /** Create a CRC object computing one of the common checksums
+     *
+     * The standard parameter set of the polynomial is used: CRC-32
+     * (reflected, initial and final XOR of all ones) for
+     * POLY_32BIT_ANSI, CCITT-FALSE for POLY_16BIT_CCITT, ARC for
+     * POLY_16BIT_IBM, and plain zero-initialized non-reflected
+     * computations for the 7 and 8 bit polynomials.
+     *
+     *  @param polynomial The generator polynomial
+     */
+    CRC(crc_polynomial_t polynomial);
+
+    /** Create a CRC object from a full parameter set
+     *
+     *  @param polynomial  Generator polynomial, normal form, without the
+     *                     implicit top bit
+     *  @param width       Width of the CRC in bits, up to 32
+     *  @param initial_xor Initial value of the shift register
+     *  @param final_xor   Value XORed into the final remainder
+     *  @param reflect_in  Feed input bytes least significant bit first
+     *  @param reflect_out Reflect the final remainder
+     */
+    CRC(uint32_t polynomial, uint8_t width, uint32_t initial_xor,
+        uint32_t final_xor, bool reflect_in, bool reflect_out);
+
+    /** Compute the CRC of a single buffer
+     *
+     *  @param buffer Input bytes
+     *  @param size   Number of bytes
+     *  @param crc    Receives the result, in the low bits
+     *  @return       0 on success, -1 on invalid arguments
+     */
+    int32_t compute(const void *buffer, size_t size, uint32_t *crc);
+
+    /** Begin an incremental computation
+     *
+     *  @return 0 on success
+     */
+    int32_t compute_partial_start(void);
+
+    /** Feed a block of data into the running computation
+     *
+     *  @param buffer Input bytes
+     *  @param size   Number of bytes
+     *  @return       0 on success, -1 on invalid arguments
+     */
+    int32_t compute_partial(const void *buffer, size_t size);
+
+    /** Finish the computation and read back the result
+     *
+     *  @param crc Receives the result, in the low bits
+     *  @return    0 on success, -1 on invalid arguments
+     */
+    int32_t compute_partial_stop(uint32_t *crc);
+
+private:
+    static uint32_t reflect(uint32_t value, uint8_t bits);
+    void build_table(void);
+
+    crc_mbed_config_t _config;
+    uint32_t _table[16];   /**< Nibble lookup table of the software path */
+    uint32_t _state;
+    bool _hardware;        /**< Current partial computation runs on the CRC unit */
+};
+
+} // namespace mbed
+
+#endif
@@ -45,6 +45,14 @@ int Ethernet::read(char *data, int size) {
     return ethernet_read(data, size);
 }
 
+int Ethernet::receive_zerocopy(ethernet_frame_t *frames, int count) {
+    return ethernet_receive_zerocopy(frames, count);
+}
+
+void Ethernet::release(ethernet_frame_t *frame) {
+    ethernet_release_frame(frame);
+}
+
 void Ethernet::address(char *mac) {
     return ethernet_address(mac);
 }
@@ -21,6 +21,8 @@
 
 #if defined (DEVICE_ETHERNET) || defined(DOXYGEN_ONLY)
 
+#include "hal/ethernet_api.h"
+
 namespace mbed {
 /** \addtogroup drivers */
 
@@ -125,6 +127,37 @@ public:
      */
     int read(char *data, int size);
 
+    /** Harvest received ethernet packets without copying them.
+     *
+     *  On targets whose MAC receives into a DMA descriptor ring, fills
+     *  one ethernet_frame_t per completed descriptor, up to 'count',
+     *  lending the descriptor buffers to the caller. Lent buffers stay
+     *  out of the ring until returned with release(), and must be
+     *  returned in the order they were lent. One call harvests every
+     *  frame that has completed since the last, so a capture loop makes
+     *  one call per burst rather than one receive()/read() pair per
+     *  packet.
+     *
+     *  @param frames An array of 'count' frame descriptors to fill.
+     *  @param count  Capacity of the frames array.
+     *
+     *  @returns
+     *    The number of frames lent (0 if none have arrived),
+     *    or -1 if this target does not support zero-copy receive.
+     *
+     *  @note Do not mix with receive()/read(); a chain holds either
+     *  copied or lent frames, not both.
+     */
+    int receive_zerocopy(ethernet_frame_t *frames, int count);
+
+    /** Return a frame lent by receive_zerocopy() to the DMA ring.
+     *
+     *  The frame's buffer must no longer be accessed after release.
+     *
+     *  @param frame The frame to return.
+     */
+    void release(ethernet_frame_t *frame);
+
     /** Gives the ethernet address of the mbed.
      *
      *  @param mac Must be a pointer to a 6 byte char array to copy the ethernet address in.
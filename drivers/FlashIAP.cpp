@@ -41,6 +41,7 @@ static inline bool is_aligned(uint32_t number, uint32_t alignment)
 }
 
 FlashIAP::FlashIAP()
+    : _op(FLASH_OP_NONE), _op_buffer(NULL), _op_addr(0), _op_size(0)
 {
 
 }
@@ -143,6 +144,123 @@ int FlashIAP::erase(uint32_t addr, uint32_t size)
     return ret;
 }
 
+int FlashIAP::start_program(const void *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    uint32_t page_size = get_page_size();
+    uint32_t current_sector_size = flash_get_sector_size(&_flash, addr);
+    // same alignment requirements as the blocking program
+    if (!is_aligned(addr, page_size) ||
+        !is_aligned(size, page_size) ||
+        (size < page_size) ||
+        (((addr % current_sector_size) + size) > current_sector_size)) {
+        return -1;
+    }
+
+    int ret = 0;
+    _mutex->lock();
+    if (_op != FLASH_OP_NONE) {
+        ret = -1;
+    } else {
+        _op = FLASH_OP_PROGRAM;
+        _op_buffer = (const uint8_t *) buffer;
+        _op_addr = addr;
+        _op_size = size;
+        _op_callback = callback;
+    }
+    _mutex->unlock();
+    return ret;
+}
+
+int FlashIAP::start_erase(uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    if (!is_aligned_to_sector(addr, size)) {
+        return -1;
+    }
+
+    int ret = 0;
+    _mutex->lock();
+    if (_op != FLASH_OP_NONE) {
+        ret = -1;
+    } else {
+        _op = FLASH_OP_ERASE;
+        _op_buffer = NULL;
+        _op_addr = addr;
+        _op_size = size;
+        _op_callback = callback;
+    }
+    _mutex->unlock();
+    return ret;
+}
+
+bool FlashIAP::process()
+{
+    int32_t status = 0;
+    bool done = false;
+
+    _mutex->lock();
+    switch (_op) {
+        case FLASH_OP_NONE:
+            _mutex->unlock();
+            return false;
+
+        case FLASH_OP_PROGRAM: {
+            // one page per call, the mutex is released in between so
+            // other flash users are stalled for a single page at most
+            uint32_t page_size = flash_get_page_size(&_flash);
+            if (flash_program_page(&_flash, _op_addr, _op_buffer, page_size)) {
+                status = -1;
+                done = true;
+            } else {
+                _op_buffer += page_size;
+                _op_addr += page_size;
+                _op_size -= page_size;
+                done = (_op_size == 0);
+            }
+            break;
+        }
+
+        case FLASH_OP_ERASE: {
+            // one sector per call, this is the long pole (~tens of ms)
+            // the interface was introduced to keep off the calling thread
+            if (flash_erase_sector(&_flash, _op_addr)) {
+                status = -1;
+                done = true;
+            } else {
+                uint32_t current_sector_size = flash_get_sector_size(&_flash, _op_addr);
+                if (!is_aligned_to_sector(_op_addr, _op_size)) {
+                    status = -1;
+                    done = true;
+                } else {
+                    _op_addr += current_sector_size;
+                    _op_size -= current_sector_size;
+                    done = (_op_size == 0);
+                }
+            }
+            break;
+        }
+    }
+
+    Callback<void(int)> callback;
+    if (done) {
+        callback = _op_callback;
+        _op = FLASH_OP_NONE;
+        _op_buffer = NULL;
+        _op_callback = Callback<void(int)>();
+    }
+    _mutex->unlock();
+
+    // invoked outside the mutex so the callback may start another operation
+    if (done && callback) {
+        callback(status);
+    }
+    return !done;
+}
+
+bool FlashIAP::is_processing() const
+{
+    return (_op != FLASH_OP_NONE);
+}
+
 uint32_t FlashIAP::get_page_size() const
 {
     return flash_get_page_size(&_flash);
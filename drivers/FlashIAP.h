@@ -25,6 +25,7 @@
 #if defined (DEVICE_FLASH) || defined(DOXYGEN_ONLY)
 
 #include "flash_api.h"
+#include "platform/Callback.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
@@ -88,6 +89,63 @@ public:
      */
     int erase(uint32_t addr, uint32_t size);
 
+    /** Start programming data to pages without blocking
+     *
+     *  Performs the same operation as program, but split into one page
+     *  per call to process. The flash is only claimed while a page is
+     *  being programmed, so other threads keep running between pages.
+     *
+     *  The alignment requirements of program apply. Only one background
+     *  operation may be in flight per object at a time. The buffer must
+     *  stay valid until the callback is invoked.
+     *
+     *  @param buffer   Buffer of data to be written
+     *  @param addr     Address of a page to begin writing to, must be a multiple of program and sector sizes
+     *  @param size     Size to write in bytes, must be a multiple of program and sector sizes
+     *  @param callback Function invoked with the result when the
+     *                  operation completes or fails, 0 on success,
+     *                  negative error code on failure
+     *  @return         0 if the operation was started, negative error code on failure
+     */
+    int start_program(const void *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback);
+
+    /** Start erasing sectors without blocking
+     *
+     *  Performs the same operation as erase, but split into one sector
+     *  per call to process. The flash is only claimed while a sector is
+     *  being erased, so other threads keep running between sectors.
+     *
+     *  The alignment requirements of erase apply. Only one background
+     *  operation may be in flight per object at a time.
+     *
+     *  @param addr     Address of a sector to begin erasing, must be a multiple of the sector size
+     *  @param size     Size to erase in bytes, must be a multiple of the sector size
+     *  @param callback Function invoked with the result when the
+     *                  operation completes or fails, 0 on success,
+     *                  negative error code on failure
+     *  @return         0 if the operation was started, negative error code on failure
+     */
+    int start_erase(uint32_t addr, uint32_t size, Callback<void(int)> callback);
+
+    /** Advance a background operation by one page or sector
+     *
+     *  Should be called repeatedly from a low priority context, for
+     *  example an event queue, until it returns false. Each call blocks
+     *  for at most one page program or one sector erase. The completion
+     *  callback is invoked from the last call.
+     *
+     *  @return     true if an operation is still in progress and
+     *              process must be called again, false otherwise
+     */
+    bool process();
+
+    /** Check if a background operation is in progress
+     *
+     *  @return     true if an operation started with start_program or
+     *              start_erase has not completed yet
+     */
+    bool is_processing() const;
+
     /** Get the sector size at the defined address
      *
      *  Sector size might differ at address ranges. 
@@ -127,7 +185,18 @@ private:
      */
     bool is_aligned_to_sector(uint32_t addr, uint32_t size);
 
+    enum flash_op {
+        FLASH_OP_NONE,
+        FLASH_OP_PROGRAM,
+        FLASH_OP_ERASE
+    };
+
     flash_t _flash;
+    flash_op _op;
+    const uint8_t *_op_buffer;
+    uint32_t _op_addr;
+    uint32_t _op_size;
+    Callback<void(int)> _op_callback;
     static SingletonPtr<PlatformMutex> _mutex;
 };
 
@@ -26,9 +26,15 @@ namespace mbed {
 I2C *I2C::_owner = NULL;
 SingletonPtr<PlatformMutex> I2C::_mutex;
 
+#if DEVICE_I2C_ASYNCH && TRANSACTION_QUEUE_SIZE_I2C
+TransactionQueue<I2C, TRANSACTION_QUEUE_SIZE_I2C, i2c_transaction_t> I2C::_transaction_queue;
+#endif
+
 I2C::I2C(PinName sda, PinName scl) :
 #if DEVICE_I2C_ASYNCH
                                      _irq(this), _usage(DMA_USAGE_NEVER),
+                                     _xfer_ops(NULL), _xfer_count(0),
+                                     _xfer_index(0), _xfer_event(0),
 #endif
                                       _i2c(), _hz(100000) {
     // No lock needed in the constructor
@@ -130,10 +136,25 @@ int I2C::transfer(int address, const char *tx_buffer, int tx_length, char *rx_bu
 {
     lock();
     if (i2c_active(&_i2c)) {
+#if TRANSACTION_QUEUE_SIZE_I2C
+        i2c_transaction_t t;
+        t.op.address = address;
+        t.op.tx_buffer = tx_buffer;
+        t.op.tx_length = tx_length;
+        t.op.rx_buffer = rx_buffer;
+        t.op.rx_length = rx_length;
+        t.op.repeated = repeated;
+        t.event = event;
+        t.callback = callback;
+        int ret = _transaction_queue.add(this, t);
+        unlock();
+        return ret;
+#else
         unlock();
         return -1; // transaction ongoing
+#endif
     }
-    sleep_manager_lock_deep_sleep();
+    sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_I2C);
     aquire();
 
     _callback = callback;
@@ -144,22 +165,95 @@ int I2C::transfer(int address, const char *tx_buffer, int tx_length, char *rx_bu
     return 0;
 }
 
+int I2C::transfer(const i2c_transaction_op_t *ops, int count, const event_callback_t& callback, int event)
+{
+    if (count <= 0) {
+        return -1;
+    }
+    lock();
+    if (i2c_active(&_i2c)) {
+        unlock();
+        return -1; // transaction ongoing
+    }
+    sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_I2C);
+    aquire();
+
+    _callback = callback;
+    _xfer_ops = ops;
+    _xfer_count = count;
+    _xfer_index = 0;
+    // Completion must always interrupt so the next operation can be chained
+    _xfer_event = event | I2C_EVENT_TRANSFER_COMPLETE;
+    _irq.callback(&I2C::irq_handler_asynch);
+    start_transaction_op();
+    unlock();
+    return 0;
+}
+
+void I2C::start_transaction_op(void)
+{
+    const i2c_transaction_op_t *op = &_xfer_ops[_xfer_index++];
+    int stop = (op->repeated) ? 0 : 1;
+    i2c_transfer_asynch(&_i2c, (void *)op->tx_buffer, op->tx_length, (void *)op->rx_buffer, op->rx_length, op->address, stop, _irq.entry(), _xfer_event, _usage);
+}
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+
+void I2C::start_transaction(i2c_transaction_t *data)
+{
+    // Runs from the completion interrupt of the previous transaction,
+    // so no mutex - the bus ownership check mirrors aquire()
+    sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_I2C);
+    if (_owner != this) {
+        i2c_frequency(&_i2c, _hz);
+        _owner = this;
+    }
+    _callback = data->callback;
+    int stop = (data->op.repeated) ? 0 : 1;
+    _irq.callback(&I2C::irq_handler_asynch);
+    i2c_transfer_asynch(&_i2c, (void *)data->op.tx_buffer, data->op.tx_length, (void *)data->op.rx_buffer, data->op.rx_length, data->op.address, stop, _irq.entry(), data->event, _usage);
+}
+
+bool I2C::transfer_active()
+{
+    return i2c_active(&_i2c);
+}
+
+#endif
+
 void I2C::abort_transfer(void)
 {
     lock();
+    _xfer_ops = NULL;
     i2c_abort_asynch(&_i2c);
-    sleep_manager_unlock_deep_sleep();
+    sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_I2C);
+#if TRANSACTION_QUEUE_SIZE_I2C
+    _transaction_queue.dispatch_next();
+#endif
     unlock();
 }
 
 void I2C::irq_handler_asynch(void)
 {
     int event = i2c_irq_handler_asynch(&_i2c);
+    if (_xfer_ops && event) {
+        if ((event == I2C_EVENT_TRANSFER_COMPLETE) && (_xfer_index < _xfer_count)) {
+            // Chain the next operation straight from interrupt context
+            start_transaction_op();
+            return;
+        }
+        // Final operation finished or an error occured - report once
+        _xfer_ops = NULL;
+    }
     if (_callback && event) {
         _callback.call(event);
     }
     if (event) {
-        sleep_manager_unlock_deep_sleep();
+        sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_I2C);
+#if TRANSACTION_QUEUE_SIZE_I2C
+        // Peripheral is free - start the next queued transaction
+        _transaction_queue.dispatch_next();
+#endif
     }
 
 }
@@ -29,11 +29,37 @@
 #include "platform/CThunk.h"
 #include "hal/dma_api.h"
 #include "platform/FunctionPointer.h"
+#include "platform/TransactionQueue.h"
 #endif
 
 namespace mbed {
 /** \addtogroup drivers */
 
+#if DEVICE_I2C_ASYNCH || defined(DOXYGEN_ONLY)
+/** One operation of a multi-message I2C transaction
+ * @ingroup drivers
+ */
+typedef struct {
+    int address;           /**< 8/10 bit I2C slave address for this operation */
+    const char *tx_buffer; /**< TX buffer with data to be transfered, NULL if nothing to write */
+    int tx_length;         /**< Length of TX buffer in bytes */
+    char *rx_buffer;       /**< RX buffer for received data, NULL if nothing to read */
+    int rx_length;         /**< Length of RX buffer in bytes */
+    bool repeated;         /**< Repeated start, true - do not send stop at end */
+} i2c_transaction_op_t;
+
+/** A queued asynchronous I2C transaction. I2C transfers carry a slave
+ * address and repeated-start flag on top of the buffer pair, so the
+ * transaction queue stores this instead of the generic transaction_t.
+ * @ingroup drivers
+ */
+typedef struct {
+    i2c_transaction_op_t op;   /**< The operation to run */
+    uint32_t event;            /**< Event mask for the transaction */
+    event_callback_t callback; /**< User's callback */
+} i2c_transaction_t;
+#endif
+
 /** An I2C Master, used for communicating with I2C slave devices
  *
  * @note Synchronization level: Thread safe
@@ -169,18 +195,66 @@ public:
      * @param event     The logical OR of events to modify
      * @param callback  The event callback function
      * @param repeated Repeated start, true - do not send stop at end
-     * @return Zero if the transfer has started, or -1 if I2C peripheral is busy
+     * @return Zero if the transfer has started or been queued, or -1 if
+     *         the I2C peripheral is busy and no transaction queue is
+     *         available (TRANSACTION_QUEUE_SIZE_I2C is 0) or the queue
+     *         is full
      */
     int transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t& callback, int event = I2C_EVENT_TRANSFER_COMPLETE, bool repeated = false);
 
+    /** Start a non-blocking multi-message I2C transaction.
+     *
+     * The operation list is executed in order entirely from interrupt
+     * context: each stage is started from the completion interrupt of the
+     * previous one, so register-pointer-write-then-read sequences and
+     * multi-device polling rounds do not block a thread between messages.
+     * The callback is invoked once, after the final operation or on the
+     * first error. The list must stay valid until the callback fires.
+     *
+     * This function locks the deep sleep until any event has occured
+     *
+     * @param ops       Array of operations to execute in order
+     * @param count     Number of operations in the array
+     * @param callback  The event callback function, called after the last operation
+     * @param event     The logical OR of events to modify
+     * @return Zero if the transaction has started, or -1 if I2C peripheral is busy
+     */
+    int transfer(const i2c_transaction_op_t *ops, int count, const event_callback_t& callback, int event = I2C_EVENT_TRANSFER_COMPLETE);
+
     /** Abort the on-going I2C transfer
      */
     void abort_transfer();
 protected:
     void irq_handler_asynch(void);
+
+    /** Start the next operation of a multi-message transaction */
+    void start_transaction_op(void);
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+
+    /** Start a queued transaction
+     *
+     *  @param data Transaction data
+     */
+    void start_transaction(i2c_transaction_t *data);
+
+    /** Check whether the peripheral is mid-transfer
+     *
+     *  @returns true if an asynchronous transfer is in progress
+     */
+    bool transfer_active();
+
+    friend class TransactionQueue<I2C, TRANSACTION_QUEUE_SIZE_I2C, i2c_transaction_t>;
+    static TransactionQueue<I2C, TRANSACTION_QUEUE_SIZE_I2C, i2c_transaction_t> _transaction_queue;
+#endif
+
     event_callback_t _callback;
     CThunk<I2C> _irq;
     DMAUsage _usage;
+    const i2c_transaction_op_t *_xfer_ops;
+    int _xfer_count;
+    int _xfer_index;
+    int _xfer_event;
 #endif
 
 protected:
@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 #include "drivers/I2CSlave.h"
+#include "platform/mbed_critical.h"
 
 #if DEVICE_I2CSLAVE
 
 namespace mbed {
 
-I2CSlave::I2CSlave(PinName sda, PinName scl) : _i2c() {
+I2CSlave::I2CSlave(PinName sda, PinName scl) : _i2c(), _engine_ticker(NULL),
+                                               _rx_buf(NULL), _rx_len(0),
+                                               _tx_buf(NULL), _tx_len(0) {
     i2c_init(&_i2c, sda, scl);
     i2c_frequency(&_i2c, 100000);
     i2c_slave_mode(&_i2c, 1);
@@ -58,6 +61,66 @@ void I2CSlave::stop(void) {
     i2c_stop(&_i2c);
 }
 
+void I2CSlave::post_receive(char *data, int length, Callback<void(int)> func) {
+    core_util_critical_section_enter();
+    _rx_buf = data;
+    _rx_len = length;
+    _rx_cb = func;
+    core_util_critical_section_exit();
+}
+
+void I2CSlave::post_transmit(const char *data, int length, Callback<void(int)> func) {
+    core_util_critical_section_enter();
+    _tx_buf = data;
+    _tx_len = length;
+    _tx_cb = func;
+    core_util_critical_section_exit();
+}
+
+void I2CSlave::start_engine(int poll_us) {
+    stop_engine();
+    _engine_ticker = new Ticker;
+    _engine_ticker->attach_us(callback(this, &I2CSlave::service), poll_us);
+}
+
+void I2CSlave::stop_engine(void) {
+    if (_engine_ticker) {
+        _engine_ticker->detach();
+        delete _engine_ticker;
+        _engine_ticker = NULL;
+    }
+}
+
+void I2CSlave::service(void) {
+    switch (i2c_slave_receive(&_i2c)) {
+        case ReadAddressed:
+            if (_tx_buf) {
+                int written = i2c_slave_write(&_i2c, _tx_buf, _tx_len);
+                Callback<void(int)> func = _tx_cb;
+                _tx_buf = NULL;
+                _tx_cb = NULL;
+                if (func) {
+                    func(written);
+                }
+            }
+            break;
+        case WriteAddressed:
+        case WriteGeneral:
+            if (_rx_buf) {
+                int read = i2c_slave_read(&_i2c, _rx_buf, _rx_len);
+                Callback<void(int)> func = _rx_cb;
+                _rx_buf = NULL;
+                _rx_cb = NULL;
+                if (func) {
+                    func(read);
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
 }
 
 #endif
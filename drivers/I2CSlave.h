@@ -21,6 +21,12 @@
 #if defined (DEVICE_I2CSLAVE) || defined(DOXYGEN_ONLY)
 
 #include "hal/i2c_api.h"
+#include "platform/Callback.h"
+#include "drivers/Ticker.h"
+
+#ifndef MBED_CONF_DRIVERS_I2CSLAVE_ENGINE_POLL_US
+#define MBED_CONF_DRIVERS_I2CSLAVE_ENGINE_POLL_US  100
+#endif
 
 namespace mbed {
 /** \addtogroup drivers */
@@ -147,8 +153,61 @@ public:
      */
     void stop(void);
 
+    /** Pre-post a buffer for the next master write to this slave
+     *
+     *  The engine completes the buffer from service() when the master
+     *  addresses us for a write, and reports the byte count through the
+     *  callback. One receive buffer may be outstanding at a time.
+     *
+     *  @param data pointer to the byte array to read data in to
+     *  @param length maximum number of bytes to read
+     *  @param func function called from the engine with the number of bytes read
+     */
+    void post_receive(char *data, int length, Callback<void(int)> func);
+
+    /** Pre-post a buffer for the next master read from this slave
+     *
+     *  The engine transmits the buffer from service() when the master
+     *  addresses us for a read, and reports the byte count through the
+     *  callback. One transmit buffer may be outstanding at a time.
+     *
+     *  @param data pointer to the byte array to be transmitted
+     *  @param length the number of bytes to transmit
+     *  @param func function called from the engine with the number of bytes written
+     */
+    void post_transmit(const char *data, int length, Callback<void(int)> func);
+
+    /** Start the buffered slave engine
+     *
+     *  Services pre-posted buffers from a ticker interrupt at the given
+     *  period instead of requiring a thread to spin on receive(). Targets
+     *  whose I2C slave peripheral raises address-match interrupts can
+     *  leave the engine stopped and call service() from that IRQ for a
+     *  fully interrupt-driven path.
+     *
+     *  @param poll_us engine service period in microseconds
+     */
+    void start_engine(int poll_us = MBED_CONF_DRIVERS_I2CSLAVE_ENGINE_POLL_US);
+
+    /** Stop the buffered slave engine */
+    void stop_engine(void);
+
+    /** Run one pass of the buffered slave engine
+     *
+     *  Checks whether the master has addressed us and completes the
+     *  matching pre-posted buffer. Safe to call from interrupt context.
+     */
+    void service(void);
+
 protected:
     i2c_t _i2c;
+    Ticker *_engine_ticker;
+    char *_rx_buf;
+    int _rx_len;
+    Callback<void(int)> _rx_cb;
+    const char *_tx_buf;
+    int _tx_len;
+    Callback<void(int)> _tx_cb;
 };
 
 } // namespace mbed
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "drivers/InterruptIn.h"
+#include "hal/us_ticker_api.h"
 
 #if DEVICE_INTERRUPTIN
 
@@ -22,7 +23,13 @@ namespace mbed {
 InterruptIn::InterruptIn(PinName pin) : gpio(),
                                         gpio_irq(),
                                         _rise(NULL),
-                                        _fall(NULL) {
+                                        _fall(NULL),
+                                        _capture_fifo(NULL),
+                                        _capture_size(0),
+                                        _capture_next(0),
+                                        _capture_count(0),
+                                        _capture_dropped(0),
+                                        _capture_ts(0) {
     // No lock needed in the constructor
 
     gpio_irq_init(&gpio_irq, pin, (&InterruptIn::_irq_handler), (uint32_t)this);
@@ -32,6 +39,7 @@ InterruptIn::InterruptIn(PinName pin) : gpio(),
 InterruptIn::~InterruptIn() {
     // No lock needed in the destructor
     gpio_irq_free(&gpio_irq);
+    delete[] _capture_fifo;
 }
 
 int InterruptIn::read() {
@@ -69,8 +77,58 @@ void InterruptIn::fall(Callback<void()> func) {
     core_util_critical_section_exit();
 }
 
+void InterruptIn::capture(uint32_t fifo_entries) {
+    core_util_critical_section_enter();
+    delete[] _capture_fifo;
+    _capture_fifo = NULL;
+    _capture_size = 0;
+    _capture_next = 0;
+    _capture_count = 0;
+    _capture_dropped = 0;
+    if (fifo_entries > 0) {
+        _capture_fifo = new edge_t[fifo_entries];
+        _capture_size = fifo_entries;
+    }
+    core_util_critical_section_exit();
+}
+
+bool InterruptIn::read_edge(edge_t *edge) {
+    bool pending = false;
+    core_util_critical_section_enter();
+    if (_capture_count > 0) {
+        uint32_t oldest = (_capture_next + _capture_size - _capture_count) % _capture_size;
+        *edge = _capture_fifo[oldest];
+        _capture_count--;
+        pending = true;
+    }
+    core_util_critical_section_exit();
+    return pending;
+}
+
+us_timestamp_t InterruptIn::capture_time() const {
+    return _capture_ts;
+}
+
+uint32_t InterruptIn::capture_overruns() const {
+    return _capture_dropped;
+}
+
 void InterruptIn::_irq_handler(uint32_t id, gpio_irq_event event) {
     InterruptIn *handler = (InterruptIn*)id;
+    if (handler->_capture_fifo && event != IRQ_NONE) {
+        // Take the time before any dispatch work so the timestamp does
+        // not pick up the jitter of the callback path
+        handler->_capture_ts = ticker_read_us(get_us_ticker_data());
+        if (handler->_capture_count < handler->_capture_size) {
+            edge_t *slot = &handler->_capture_fifo[handler->_capture_next];
+            slot->timestamp = handler->_capture_ts;
+            slot->rising = (event == IRQ_RISE);
+            handler->_capture_next = (handler->_capture_next + 1) % handler->_capture_size;
+            handler->_capture_count++;
+        } else {
+            handler->_capture_dropped++;
+        }
+    }
     switch (event) {
         case IRQ_RISE: 
             if (handler->_rise) {
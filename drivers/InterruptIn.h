@@ -22,6 +22,7 @@
 
 #include "hal/gpio_api.h"
 #include "hal/gpio_irq_api.h"
+#include "hal/ticker_api.h"
 #include "platform/Callback.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_toolchain.h"
@@ -135,6 +136,50 @@ public:
      */
     void mode(PinMode pull);
 
+    /** One timestamped edge recorded in capture mode */
+    struct edge_t {
+        us_timestamp_t timestamp; /**< Time of the edge in microseconds */
+        bool rising;              /**< true for a rising edge, false for a falling edge */
+    };
+
+    /** Enable or disable timestamped edge capture
+     *
+     *  In capture mode the time is read from the microsecond ticker as
+     *  the very first action of the common GPIO interrupt handler, ahead
+     *  of callback dispatch, so the timestamp carries none of the
+     *  dispatch jitter a ticker read inside the callback would. Each
+     *  edge is pushed into a FIFO together with its direction, and the
+     *  same timestamp is available to the rise/fall callback through
+     *  capture_time().
+     *
+     *  @param fifo_entries Depth of the edge FIFO, or 0 to disable
+     *                      capture and release it
+     */
+    void capture(uint32_t fifo_entries);
+
+    /** Pop the oldest captured edge from the FIFO
+     *
+     *  @param edge Receives the timestamp and direction
+     *  @return     true if an edge was pending, false if the FIFO is empty
+     */
+    bool read_edge(edge_t *edge);
+
+    /** Timestamp of the edge being dispatched
+     *
+     *  Meaningful inside a rise/fall callback while capture mode is
+     *  enabled: the time read at interrupt entry for the edge that
+     *  triggered the callback.
+     *
+     *  @return The timestamp in microseconds
+     */
+    us_timestamp_t capture_time() const;
+
+    /** Get the number of edges dropped because the FIFO was full
+     *
+     *  @return Dropped edge count since capture was enabled
+     */
+    uint32_t capture_overruns() const;
+
     /** Enable IRQ. This method depends on hw implementation, might enable one
      *  port interrupts. For further information, check gpio_irq_enable().
      */
@@ -153,6 +198,13 @@ protected:
 
     Callback<void()> _rise;
     Callback<void()> _fall;
+
+    edge_t *_capture_fifo;
+    uint32_t _capture_size;
+    uint32_t _capture_next;  /* Next FIFO slot to write */
+    volatile uint32_t _capture_count;
+    volatile uint32_t _capture_dropped;
+    us_timestamp_t _capture_ts;
 };
 
 } // namespace mbed
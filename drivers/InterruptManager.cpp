@@ -20,12 +20,23 @@
 #include "platform/mbed_critical.h"
 #include <string.h>
 
-#define CHAIN_INITIAL_SIZE    4
-
 namespace mbed {
 
 typedef void (*pvoidf)(void);
 
+/* A handler list is a singly-linked snapshot the dispatch stub walks with
+ * interrupts enabled. Nodes are only ever attached or detached with a
+ * single pointer store, so a walk that races a mutation sees either the
+ * old or the new list, never a half-built one. */
+class InterruptHandlerNode {
+public:
+    InterruptHandlerNode(Callback<void()> &func, InterruptHandlerNode *n): cb(func), next(n) {
+        // No work to do
+    }
+    Callback<void()> cb;
+    InterruptHandlerNode * volatile next;
+};
+
 InterruptManager* InterruptManager::_instance = (InterruptManager*)NULL;
 
 InterruptManager* InterruptManager::get() {
@@ -51,7 +62,9 @@ InterruptManager* InterruptManager::get() {
 
 InterruptManager::InterruptManager() {
     // No mutex needed in constructor
-    memset(_chains, 0, NVIC_NUM_VECTORS * sizeof(CallChain*));
+    for (int i = 0; i < NVIC_NUM_VECTORS; i++) {
+        _handlers[i] = NULL;
+    }
 }
 
 void InterruptManager::destroy() {
@@ -65,35 +78,48 @@ void InterruptManager::destroy() {
 }
 
 InterruptManager::~InterruptManager() {
-    for(int i = 0; i < NVIC_NUM_VECTORS; i++)
-        if (NULL != _chains[i])
-            delete _chains[i];
+    for(int i = 0; i < NVIC_NUM_VECTORS; i++) {
+        InterruptHandlerNode *node = _handlers[i];
+        while (node != NULL) {
+            InterruptHandlerNode *temp = node->next;
+            delete node;
+            node = temp;
+        }
+    }
 }
 
-bool InterruptManager::must_replace_vector(IRQn_Type irq) {
+pFunctionPointer_t InterruptManager::add_common(Callback<void()> func, IRQn_Type irq, bool front) {
     lock();
-
-    int ret = false;
     int irq_pos = get_irq_index(irq);
-    if (NULL == _chains[irq_pos]) {
-        _chains[irq_pos] = new CallChain(CHAIN_INITIAL_SIZE);
-        _chains[irq_pos]->add((pvoidf)NVIC_GetVector(irq));
-        ret = true;
+
+    bool change = false;
+    if (NULL == _handlers[irq_pos]) {
+        // First attach - keep the original vector running as part of the list
+        Callback<void()> previous((pvoidf)NVIC_GetVector(irq));
+        _handlers[irq_pos] = new InterruptHandlerNode(previous, NULL);
+        change = true;
     }
-    unlock();
-    return ret;
-}
 
-pFunctionPointer_t InterruptManager::add_common(void (*function)(void), IRQn_Type irq, bool front) {
-    lock();
-    int irq_pos = get_irq_index(irq);
-    bool change = must_replace_vector(irq);
+    InterruptHandlerNode *node;
+    if (front) {
+        node = new InterruptHandlerNode(func, _handlers[irq_pos]);
+        // Publish: the node is fully built before this store makes it visible
+        __DMB();
+        _handlers[irq_pos] = node;
+    } else {
+        node = new InterruptHandlerNode(func, NULL);
+        InterruptHandlerNode *last = _handlers[irq_pos];
+        while (last->next != NULL) {
+            last = last->next;
+        }
+        __DMB();
+        last->next = node;
+    }
 
-    pFunctionPointer_t pf = front ? _chains[irq_pos]->add_front(function) : _chains[irq_pos]->add(function);
     if (change)
         NVIC_SetVector(irq, (uint32_t)&InterruptManager::static_irq_helper);
     unlock();
-    return pf;
+    return &node->cb;
 }
 
 bool InterruptManager::remove_handler(pFunctionPointer_t handler, IRQn_Type irq) {
@@ -101,10 +127,23 @@ bool InterruptManager::remove_handler(pFunctionPointer_t handler, IRQn_Type irq)
     bool ret = false;
 
     lock();
-    if (_chains[irq_pos] != NULL) {
-        if (_chains[irq_pos]->remove(handler)) {
-            ret = true;
+    InterruptHandlerNode *prev = NULL;
+    InterruptHandlerNode *node = _handlers[irq_pos];
+    while (node != NULL && handler != &node->cb) {
+        prev = node;
+        node = node->next;
+    }
+    if (node != NULL) {
+        // Unlink with a single store; a dispatch standing on the node still
+        // follows its intact next pointer, and by the time thread context
+        // runs again every such dispatch has returned, so the node can go
+        if (NULL == prev) {
+            _handlers[irq_pos] = node->next;
+        } else {
+            prev->next = node->next;
         }
+        delete node;
+        ret = true;
     }
     unlock();
 
@@ -112,7 +151,11 @@ bool InterruptManager::remove_handler(pFunctionPointer_t handler, IRQn_Type irq)
 }
 
 void InterruptManager::irq_helper() {
-    _chains[__get_IPSR()]->call();
+    InterruptHandlerNode *node = _handlers[__get_IPSR()];
+    while (node != NULL) {
+        node->cb.call();
+        node = node->next;
+    }
 }
 
 int InterruptManager::get_irq_index(IRQn_Type irq) {
@@ -25,9 +25,16 @@
 namespace mbed {
 /** \addtogroup drivers */
 
+class InterruptHandlerNode;
+
 /** Use this singleton if you need to chain interrupt handlers.
  *
- * @note Synchronization level: Thread safe
+ * Handler lists are published to the dispatch stub with single pointer
+ * stores, so adding and removing handlers never masks interrupts and the
+ * interrupt can keep firing while its list is being changed.
+ *
+ * @note Synchronization level: Thread safe. Handlers must be added and
+ *       removed from thread context, not from an interrupt handler.
  *
  * Example (for LPC1768):
  * @code
@@ -141,25 +148,16 @@ private:
 
     template<typename T>
     pFunctionPointer_t add_common(T *tptr, void (T::*mptr)(void), IRQn_Type irq, bool front=false) {
-        _mutex.lock();
-        int irq_pos = get_irq_index(irq);
-        bool change = must_replace_vector(irq);
-
-        pFunctionPointer_t pf = front ? _chains[irq_pos]->add_front(tptr, mptr) : _chains[irq_pos]->add(tptr, mptr);
-        if (change)
-            NVIC_SetVector(irq, (uint32_t)&InterruptManager::static_irq_helper);
-        _mutex.unlock();
-        return pf;
+        // Underlying call is thread safe
+        return add_common(callback(tptr, mptr), irq, front);
     }
 
-    pFunctionPointer_t add_common(void (*function)(void), IRQn_Type irq, bool front=false);
-    bool must_replace_vector(IRQn_Type irq);
+    pFunctionPointer_t add_common(Callback<void()> func, IRQn_Type irq, bool front=false);
     int get_irq_index(IRQn_Type irq);
     void irq_helper();
-    void add_helper(void (*function)(void), IRQn_Type irq, bool front=false);
     static void static_irq_helper();
 
-    CallChain* _chains[NVIC_NUM_VECTORS];
+    InterruptHandlerNode * volatile _handlers[NVIC_NUM_VECTORS];
     static InterruptManager* _instance;
     PlatformMutex _mutex;
 };
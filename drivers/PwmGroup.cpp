@@ -0,0 +1,54 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/PwmGroup.h"
+
+#if DEVICE_PWMOUT
+
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+
+namespace mbed {
+
+PwmGroup::PwmGroup(PwmOut **channels, int count) : _count(count) {
+    MBED_ASSERT(count > 0 && count <= MAX_CHANNELS);
+    core_util_critical_section_enter();
+    for (int i = 0; i < count; i++) {
+        _channels[i] = channels[i];
+        _pwms[i] = &channels[i]->_pwm;
+        _staged[i] = 0;
+        // The group exists to drive the channels, keep the timer clocked
+        channels[i]->lock_deep_sleep();
+    }
+    core_util_critical_section_exit();
+}
+
+void PwmGroup::period_us(int us) {
+    core_util_critical_section_enter();
+    for (int i = 0; i < _count; i++) {
+        pwmout_period_us(_pwms[i], us);
+    }
+    core_util_critical_section_exit();
+}
+
+void PwmGroup::commit() {
+    core_util_critical_section_enter();
+    pwmout_apply_group(_pwms, _staged, _count);
+    core_util_critical_section_exit();
+}
+
+} // namespace mbed
+
+#endif
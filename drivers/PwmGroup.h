@@ -0,0 +1,110 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PWMGROUP_H
+#define MBED_PWMGROUP_H
+
+#include "platform/platform.h"
+
+#if defined (DEVICE_PWMOUT) || defined(DOXYGEN_ONLY)
+#include "drivers/PwmOut.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** A group of PWM channels whose duty cycles are updated together
+ *
+ * Duty updates are staged as integer pulse widths - a plain store, with
+ * no locking and no float conversion - and applied with commit(), which
+ * hands the whole set to the HAL in one call. On targets with buffered
+ * compare registers every channel then switches on the same period
+ * boundary; elsewhere the channels are written back to back with
+ * interrupts disabled. Either way a commit is a single short sequence,
+ * suitable for a fast control loop interrupt.
+ *
+ * @note Synchronization level: Interrupt safe. stage_us() is lock free;
+ *       concurrent commits from different contexts are not supported.
+ *
+ * Example:
+ * @code
+ * // Three-phase bridge updated from a control loop.
+ *
+ * #include "mbed.h"
+ *
+ * PwmOut u(PWM_U), v(PWM_V), w(PWM_W);
+ * PwmOut *phases[] = { &u, &v, &w };
+ * PwmGroup bridge(phases, 3);
+ *
+ * void control_loop() {
+ *     bridge.stage_us(0, duty_u);
+ *     bridge.stage_us(1, duty_v);
+ *     bridge.stage_us(2, duty_w);
+ *     bridge.commit();
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class PwmGroup : private NonCopyable<PwmGroup> {
+public:
+    /** Create a group from existing PwmOut channels
+     *
+     *  The channels must outlive the group.
+     *
+     *  @param channels The channels, in the order used by stage_us()
+     *  @param count    Number of channels, up to 8
+     */
+    PwmGroup(PwmOut **channels, int count);
+
+    /** Set the PWM period of every channel in the group
+     *
+     *  @param us The period in microseconds
+     */
+    void period_us(int us);
+
+    /** Stage a new pulse width for one channel
+     *
+     *  Nothing reaches the hardware until commit(); staging is a single
+     *  store and may be freely mixed with an in-progress commit from the
+     *  same context.
+     *
+     *  @param channel        Index of the channel within the group
+     *  @param pulsewidth_us  The new pulse width in microseconds
+     */
+    void stage_us(int channel, int pulsewidth_us) {
+        _staged[channel] = pulsewidth_us;
+    }
+
+    /** Apply every staged pulse width
+     *
+     *  Runs with interrupts disabled for the duration of the hardware
+     *  update.
+     */
+    void commit();
+
+private:
+    static const int MAX_CHANNELS = 8;
+
+    PwmOut *_channels[MAX_CHANNELS];
+    pwmout_t *_pwms[MAX_CHANNELS];
+    int _staged[MAX_CHANNELS];
+    int _count;
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -188,7 +188,7 @@ protected:
     /** Lock deep sleep only if it is not yet locked */
     void lock_deep_sleep() {
         if (_deep_sleep_locked == false) {
-            sleep_manager_lock_deep_sleep();
+            sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_PWM);
             _deep_sleep_locked = true;
         }
     }
@@ -196,13 +196,15 @@ protected:
     /** Unlock deep sleep in case it is locked */
     void unlock_deep_sleep() {
         if (_deep_sleep_locked == true) {
-            sleep_manager_unlock_deep_sleep();
+            sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_PWM);
             _deep_sleep_locked = false;
         }
     }
 
     pwmout_t _pwm;
     bool _deep_sleep_locked;
+
+    friend class PwmGroup;
 };
 
 } // namespace mbed
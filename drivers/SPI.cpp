@@ -15,6 +15,7 @@
  */
 #include "drivers/SPI.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
 
 #if DEVICE_SPI_ASYNCH
 #include "platform/mbed_sleep.h"
@@ -25,7 +26,7 @@
 namespace mbed {
 
 #if DEVICE_SPI_ASYNCH && TRANSACTION_QUEUE_SIZE_SPI
-CircularBuffer<Transaction<SPI>, TRANSACTION_QUEUE_SIZE_SPI> SPI::_transaction_buffer;
+TransactionQueue<SPI, TRANSACTION_QUEUE_SIZE_SPI> SPI::_transaction_queue;
 #endif
 
 SPI::SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel) :
@@ -53,6 +54,8 @@ void SPI::format(int bits, int mode) {
     // updated which is done by acquire.
     if (_owner == this) {
         spi_format(&_spi, _bits, _mode, 0);
+        _cached_bits = _bits;
+        _cached_mode = _mode;
     } else {
         _acquire();
     }
@@ -67,6 +70,7 @@ void SPI::frequency(int hz) {
     // updated which is done by acquire.
     if (_owner == this) {
         spi_frequency(&_spi, _hz);
+        _cached_hz = _hz;
     } else {
         _acquire();
     }
@@ -75,23 +79,47 @@ void SPI::frequency(int hz) {
 
 SPI* SPI::_owner = NULL;
 SingletonPtr<PlatformMutex> SPI::_mutex;
+int SPI::_cached_module = -1;
+int SPI::_cached_bits = -1;
+int SPI::_cached_mode = -1;
+int SPI::_cached_hz = -1;
+
+// Only some targets implement spi_get_module() in their HAL. The rest get
+// this stub, which reports the module as unknown so the settings cache
+// never hits and every owner change reprograms the peripheral - the
+// behaviour before the cache existed.
+#define SPI_MODULE_UNKNOWN 0xFF
+
+extern "C" MBED_WEAK uint8_t spi_get_module(spi_t *obj)
+{
+    (void)obj;
+    return SPI_MODULE_UNKNOWN;
+}
 
 // ignore the fact there are multiple physical spis, and always update if it wasnt us last
 void SPI::aquire() {
     lock();
-     if (_owner != this) {
-        spi_format(&_spi, _bits, _mode, 0);
-        spi_frequency(&_spi, _hz);
-        _owner = this;
-    }
+    _acquire();
     unlock();
 }
 
 // Note: Private function with no locking
 void SPI::_acquire() {
      if (_owner != this) {
-        spi_format(&_spi, _bits, _mode, 0);
-        spi_frequency(&_spi, _hz);
+        // Owner changed, but only reprogram the parts of the configuration
+        // that differ from what the peripheral already holds.
+        int module = spi_get_module(&_spi);
+        bool cached = (module != SPI_MODULE_UNKNOWN) && (module == _cached_module);
+        if (!cached || (_bits != _cached_bits) || (_mode != _cached_mode)) {
+            spi_format(&_spi, _bits, _mode, 0);
+        }
+        if (!cached || (_hz != _cached_hz)) {
+            spi_frequency(&_spi, _hz);
+        }
+        _cached_module = module;
+        _cached_bits = _bits;
+        _cached_mode = _mode;
+        _cached_hz = _hz;
         _owner = this;
     }
 }
@@ -137,10 +165,48 @@ int SPI::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_
     return 0;
 }
 
+int SPI::transfer_gather(const spi_gather_t *segments, int count, unsigned char bit_width, const event_callback_t& callback, int event)
+{
+    if (count <= 0) {
+        return -1;
+    }
+    if (count == 1) {
+        return transfer(segments[0].tx_buffer, segments[0].tx_length, segments[0].rx_buffer, segments[0].rx_length, bit_width, callback, event);
+    }
+#if TRANSACTION_QUEUE_SIZE_SPI
+    core_util_critical_section_enter();
+    for (int i = 0; i < count; i++) {
+        bool last = (i == count - 1);
+        /* Intermediate segments complete into a driver-internal handler so
+         * the queue chains them without a user callback round-trip. */
+        int ret = transfer(segments[i].tx_buffer, segments[i].tx_length,
+                           segments[i].rx_buffer, segments[i].rx_length,
+                           bit_width,
+                           last ? callback : event_callback_t(mbed::callback(this, &SPI::gather_segment_irq)),
+                           last ? event : (int)SPI_EVENT_COMPLETE);
+        if (ret != 0) {
+            core_util_critical_section_exit();
+            return -1;
+        }
+    }
+    core_util_critical_section_exit();
+    return 0;
+#else
+    return -1; // without a transaction queue only a single segment can be in flight
+#endif
+}
+
+void SPI::gather_segment_irq(int event)
+{
+    // Nothing to do - the segment's data already landed in the caller's
+    // buffers, and irq_handler_asynch() dequeues the next segment.
+    (void)event;
+}
+
 void SPI::abort_transfer()
 {
     spi_abort_asynch(&_spi);
-    sleep_manager_unlock_deep_sleep();
+    sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_SPI);
 #if TRANSACTION_QUEUE_SIZE_SPI
     dequeue_transaction();
 #endif
@@ -150,7 +216,7 @@ void SPI::abort_transfer()
 void SPI::clear_transfer_buffer()
 {
 #if TRANSACTION_QUEUE_SIZE_SPI
-    _transaction_buffer.reset();
+    _transaction_queue.clear();
 #endif
 }
 
@@ -181,18 +247,7 @@ int SPI::queue_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, i
     t.event = event;
     t.callback = callback;
     t.width = bit_width;
-    Transaction<SPI> transaction(this, t);
-    if (_transaction_buffer.full()) {
-        return -1; // the buffer is full
-    } else {
-        core_util_critical_section_enter();
-        _transaction_buffer.push(transaction);
-        if (!spi_active(&_spi)) {
-            dequeue_transaction();
-        }
-        core_util_critical_section_exit();
-        return 0;
-    }
+    return _transaction_queue.add(this, t);
 #else
     return -1;
 #endif
@@ -200,7 +255,7 @@ int SPI::queue_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, i
 
 void SPI::start_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length, unsigned char bit_width, const event_callback_t& callback, int event)
 {
-    sleep_manager_lock_deep_sleep();
+    sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_SPI);
     _acquire();
     _callback = callback;
     _irq.callback(&SPI::irq_handler_asynch);
@@ -214,14 +269,14 @@ void SPI::start_transaction(transaction_t *data)
     start_transfer(data->tx_buffer, data->tx_length, data->rx_buffer, data->rx_length, data->width, data->callback, data->event);
 }
 
+bool SPI::transfer_active()
+{
+    return spi_active(&_spi);
+}
+
 void SPI::dequeue_transaction()
 {
-    Transaction<SPI> t;
-    if (_transaction_buffer.pop(t)) {
-        SPI* obj = t.get_object();
-        transaction_t* data = t.get_transaction();
-        obj->start_transaction(data);
-    }
+    _transaction_queue.dispatch_next();
 }
 
 #endif
@@ -230,7 +285,7 @@ void SPI::irq_handler_asynch(void)
 {
     int event = spi_irq_handler_asynch(&_spi);
     if (_callback && (event & SPI_EVENT_ALL)) {
-        sleep_manager_unlock_deep_sleep();
+        sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_SPI);
         _callback.call(event & SPI_EVENT_ALL);
     }
 #if TRANSACTION_QUEUE_SIZE_SPI
@@ -28,14 +28,25 @@
 #if DEVICE_SPI_ASYNCH
 #include "platform/CThunk.h"
 #include "hal/dma_api.h"
-#include "platform/CircularBuffer.h"
 #include "platform/FunctionPointer.h"
-#include "platform/Transaction.h"
+#include "platform/TransactionQueue.h"
 #endif
 
 namespace mbed {
 /** \addtogroup drivers */
 
+#if DEVICE_SPI_ASYNCH || defined(DOXYGEN_ONLY)
+/** A single segment of a scatter-gather SPI transfer
+ * @ingroup drivers
+ */
+typedef struct {
+    const void *tx_buffer; /**< Tx buffer, NULL to send the default fill value */
+    int tx_length;         /**< Length of Tx buffer in bytes, may be zero */
+    void *rx_buffer;       /**< Rx buffer, NULL to discard received data */
+    int rx_length;         /**< Length of Rx buffer in bytes, may be zero */
+} spi_gather_t;
+#endif
+
 /** A SPI Master, used for communicating with SPI slave devices
  *
  * The default format is set to 8-bits, mode 0, and a clock frequency of 1MHz
@@ -177,6 +188,27 @@ public:
         return 0;
     }
 
+    /** Start a non-blocking scatter-gather transfer over a list of buffer segments.
+     *
+     * The segments are clocked out back-to-back through the transaction queue
+     * without any intermediate copies into a staging buffer; the user callback
+     * is invoked once, after the final segment. Transfer errors on intermediate
+     * segments are reported with the final segment's events.
+     *
+     * This function locks the deep sleep until any event has occured
+     *
+     * @param segments  Array of segments to transfer, walked in order
+     * @param count     Number of segments in the array
+     * @param callback  The event callback function, called after the last segment
+     * @param event     The logical OR of events to modify. Look at spi hal header file for SPI events.
+     * @return Zero if all segments were started or queued, or -1 if the queue
+     *         cannot hold the segment list
+     */
+    template<typename Type>
+    int transfer(const spi_gather_t *segments, int count, const event_callback_t& callback, int event = SPI_EVENT_COMPLETE) {
+        return transfer_gather(segments, count, sizeof(Type)*8, callback, event);
+    }
+
     /** Abort the on-going SPI transfer, and continue with transfer's in the queue if any.
      */
     void abort_transfer();
@@ -232,6 +264,24 @@ protected:
     */
     int queue_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length, unsigned char bit_width, const event_callback_t& callback, int event);
 
+    /** Common scatter-gather transfer method
+     *
+     * @param segments  Array of segments to transfer, walked in order
+     * @param count     Number of segments in the array
+     * @param bit_width The buffers element width
+     * @param callback  The event callback function, called after the last segment
+     * @param event     The logical OR of events to modify
+     * @return Zero if all segments were started or queued, or -1 if the queue
+     *         cannot hold the segment list
+    */
+    int transfer_gather(const spi_gather_t *segments, int count, unsigned char bit_width, const event_callback_t& callback, int event);
+
+    /** Completion handler for intermediate scatter-gather segments
+     *
+     * @param event The event reported for the segment
+    */
+    void gather_segment_irq(int event);
+
     /** Configures a callback, spi peripheral and initiate a new transfer
      *
      * @param tx_buffer The TX buffer with data to be transfered. If NULL is passed,
@@ -254,11 +304,19 @@ protected:
     */
     void start_transaction(transaction_t *data);
 
+    /** Check whether the peripheral is mid-transfer
+     *
+     *  @returns true if an asynchronous transfer is in progress
+    */
+    bool transfer_active();
+
     /** Dequeue a transaction
      *
     */
     void dequeue_transaction();
-    static CircularBuffer<Transaction<SPI>, TRANSACTION_QUEUE_SIZE_SPI> _transaction_buffer;
+
+    friend class TransactionQueue<SPI, TRANSACTION_QUEUE_SIZE_SPI>;
+    static TransactionQueue<SPI, TRANSACTION_QUEUE_SIZE_SPI> _transaction_queue;
 #endif
 
 #endif
@@ -279,6 +337,14 @@ protected:
     void aquire(void);
     static SPI *_owner;
     static SingletonPtr<PlatformMutex> _mutex;
+    /* Configuration last programmed into a SPI peripheral, keyed by module
+     * so the cache never short-circuits a peripheral that was not yet
+     * programmed. Lets devices sharing one configuration alternate on a bus
+     * without paying for reconfiguration. */
+    static int _cached_module;
+    static int _cached_bits;
+    static int _cached_mode;
+    static int _cached_hz;
     int _bits;
     int _mode;
     int _hz;
@@ -15,6 +15,11 @@
  */
 #include "drivers/SPISlave.h"
 
+#if DEVICE_SPI_ASYNCH
+#include "platform/mbed_critical.h"
+#include "platform/mbed_sleep.h"
+#endif
+
 #if DEVICE_SPISLAVE
 
 namespace mbed {
@@ -24,6 +29,15 @@ SPISlave::SPISlave(PinName mosi, PinName miso, PinName sclk, PinName ssel) :
     _bits(8),
     _mode(0),
     _hz(1000000)
+#if DEVICE_SPI_ASYNCH
+    ,
+    _irq(this),
+    _event(SPI_EVENT_COMPLETE),
+    _usage(DMA_USAGE_NEVER),
+    _frame_head(0),
+    _frame_count(0),
+    _frame_active(false)
+#endif
  {
     spi_init(&_spi, mosi, miso, sclk, ssel);
     spi_format(&_spi, _bits, _mode, 1);
@@ -53,6 +67,98 @@ void SPISlave::reply(int value) {
     spi_slave_write(&_spi, value);
 }
 
+#if DEVICE_SPI_ASYNCH
+
+void SPISlave::frame_callback(const event_callback_t &callback, int event)
+{
+    core_util_critical_section_enter();
+    _callback = callback;
+    _event = event;
+    core_util_critical_section_exit();
+}
+
+int SPISlave::post_frame(const void *tx_buffer, void *rx_buffer, int length)
+{
+    if (length <= 0) {
+        return -1;
+    }
+    core_util_critical_section_enter();
+    if (_frame_count == SPI_SLAVE_FRAME_QUEUE_SIZE) {
+        core_util_critical_section_exit();
+        return -1;
+    }
+    int slot = (_frame_head + _frame_count) % SPI_SLAVE_FRAME_QUEUE_SIZE;
+    _frames[slot].tx_buffer = tx_buffer;
+    _frames[slot].rx_buffer = rx_buffer;
+    _frames[slot].length = length;
+    _frame_count++;
+    if (!_frame_active) {
+        sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_SPI);
+        arm_next_frame();
+    }
+    core_util_critical_section_exit();
+    return 0;
+}
+
+void SPISlave::arm_next_frame(void)
+{
+    spi_slave_frame_t *frame = &_frames[_frame_head];
+    _frame_active = true;
+    _irq.callback(&SPISlave::irq_handler_asynch);
+    /* The asynch HAL engine only posts the buffers to the FIFO/DMA and
+     * enables the completion interrupt - with the peripheral initialised
+     * as a slave it is the external master's clock that shifts the frame. */
+    spi_master_transfer(&_spi, frame->tx_buffer, frame->length,
+                        frame->rx_buffer, frame->length,
+                        (_bits > 8) ? 16 : 8, _irq.entry(),
+                        _event | SPI_EVENT_INTERNAL_TRANSFER_COMPLETE, _usage);
+}
+
+void SPISlave::irq_handler_asynch(void)
+{
+    int event = spi_irq_handler_asynch(&_spi);
+    if (event & (SPI_EVENT_ALL | SPI_EVENT_INTERNAL_TRANSFER_COMPLETE)) {
+        // Retire the completed frame and arm the next pre-posted one before
+        // notifying, so the peripheral is ready again when the master keeps
+        // clocking.
+        _frame_head = (_frame_head + 1) % SPI_SLAVE_FRAME_QUEUE_SIZE;
+        _frame_count--;
+        if (_frame_count > 0) {
+            arm_next_frame();
+        } else {
+            _frame_active = false;
+            sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_SPI);
+        }
+        if (_callback && (event & SPI_EVENT_ALL)) {
+            _callback.call(event & SPI_EVENT_ALL);
+        }
+    }
+}
+
+void SPISlave::abort_frames()
+{
+    core_util_critical_section_enter();
+    if (_frame_active) {
+        spi_abort_asynch(&_spi);
+        _frame_active = false;
+        sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_SPI);
+    }
+    _frame_head = 0;
+    _frame_count = 0;
+    core_util_critical_section_exit();
+}
+
+int SPISlave::set_dma_usage(DMAUsage usage)
+{
+    if (spi_active(&_spi)) {
+        return -1;
+    }
+    _usage = usage;
+    return 0;
+}
+
+#endif
+
 } // namespace mbed
 
 #endif
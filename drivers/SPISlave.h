@@ -23,6 +23,19 @@
 
 #include "hal/spi_api.h"
 
+#if DEVICE_SPI_ASYNCH
+#include "platform/CThunk.h"
+#include "hal/dma_api.h"
+#include "platform/FunctionPointer.h"
+#endif
+
+#if DEVICE_SPI_ASYNCH
+/** Number of frame buffers that can be pre-posted to a SPISlave */
+#ifndef SPI_SLAVE_FRAME_QUEUE_SIZE
+#define SPI_SLAVE_FRAME_QUEUE_SIZE 4
+#endif
+#endif
+
 namespace mbed {
 /** \addtogroup drivers */
 
@@ -112,12 +125,83 @@ public:
      */
     void reply(int value);
 
+#if DEVICE_SPI_ASYNCH
+
+    /** Attach a callback invoked from interrupt context each time a
+     *  pre-posted frame completes.
+     *
+     *  @param callback The event callback function
+     *  @param event    The logical OR of events to report. Look at spi hal header file for SPI events.
+     */
+    void frame_callback(const event_callback_t &callback, int event = SPI_EVENT_COMPLETE);
+
+    /** Pre-post an RX/TX frame buffer pair for interrupt/DMA driven slave
+     *  operation.
+     *
+     *  The frame is armed immediately if the peripheral is idle, otherwise
+     *  it is queued and armed from the completion interrupt of the frame
+     *  before it, so back-to-back frames from the master are caught without
+     *  any polling. Both buffers must stay valid until the frame callback
+     *  reports the frame complete.
+     *
+     *  @param tx_buffer The data shifted out to the master, or NULL to send
+     *                   the default fill value
+     *  @param rx_buffer The buffer receiving the master's data, or NULL to
+     *                   discard it
+     *  @param length    The frame length in buffer words
+     *  @return Zero if the frame was posted, or -1 if all frame slots are in use
+     */
+    int post_frame(const void *tx_buffer, void *rx_buffer, int length);
+
+    /** Abort the frame in flight and drop all pre-posted frames.
+     */
+    void abort_frames();
+
+    /** Configure DMA usage suggestion for frame transfers
+     *
+     *  @param usage The usage DMA hint for peripheral
+     *  @return Zero if the usage was set, -1 if a frame is in flight
+     */
+    int set_dma_usage(DMAUsage usage);
+
+protected:
+    /** SPI IRQ handler: retires the completed frame and arms the next one
+     */
+    void irq_handler_asynch(void);
+
+    /** Arm the frame at the head of the queue
+     *
+     *  Called with interrupts disabled or from the completion interrupt,
+     *  with at least one pre-posted frame waiting.
+     */
+    void arm_next_frame(void);
+
+#endif
+
 protected:
     spi_t _spi;
 
     int _bits;
     int _mode;
     int _hz;
+
+#if DEVICE_SPI_ASYNCH
+    /** A pre-posted frame slot, consumed in post order */
+    struct spi_slave_frame_t {
+        const void *tx_buffer;
+        void *rx_buffer;
+        int length;
+    };
+
+    CThunk<SPISlave> _irq;
+    event_callback_t _callback;
+    int _event;
+    DMAUsage _usage;
+    spi_slave_frame_t _frames[SPI_SLAVE_FRAME_QUEUE_SIZE];
+    int _frame_head;
+    int _frame_count;
+    bool _frame_active;
+#endif
 };
 
 } // namespace mbed
@@ -28,7 +28,8 @@ SerialBase::SerialBase(PinName tx, PinName rx, int baud) :
                                                  _rx_usage(DMA_USAGE_NEVER), _tx_callback(NULL),
                                                  _rx_callback(NULL),
 #endif
-                                                _serial(), _baud(baud) {
+                                                _serial(), _rx_burst_buf(NULL),
+                                                _rx_burst_size(0), _baud(baud) {
     // No lock needed in the constructor
 
     for (size_t i = 0; i < sizeof _irq / sizeof _irq[0]; i++) {
@@ -75,14 +76,14 @@ void SerialBase::attach(Callback<void()> func, IrqType type) {
     if (func) {
         // lock deep sleep only the first time
         if (!_irq[type]) {
-            sleep_manager_lock_deep_sleep();
+            sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_SERIAL);
         } 
         _irq[type] = func;
         serial_irq_set(&_serial, (SerialIrq)type, 1);
     } else {
         // unlock deep sleep only the first time
         if (_irq[type]) {
-            sleep_manager_unlock_deep_sleep();
+            sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_SERIAL);
         } 
         _irq[type] = NULL;
         serial_irq_set(&_serial, (SerialIrq)type, 0);
@@ -91,6 +92,36 @@ void SerialBase::attach(Callback<void()> func, IrqType type) {
     unlock();
 }
 
+void SerialBase::attach_rx_burst(uint8_t *buffer, size_t size, Callback<void(size_t)> func) {
+    lock();
+    core_util_critical_section_enter();
+    if (func) {
+        _rx_burst_buf = buffer;
+        _rx_burst_size = size;
+        _rx_burst_cb = func;
+        // Reuse the RxIrq enable/deep-sleep accounting; _irq_handler
+        // diverts to the burst path while a burst handler is attached
+        attach(callback(this, &SerialBase::rx_burst_irq), RxIrq);
+    } else {
+        attach(NULL, RxIrq);
+        _rx_burst_cb = NULL;
+        _rx_burst_buf = NULL;
+        _rx_burst_size = 0;
+    }
+    core_util_critical_section_exit();
+    unlock();
+}
+
+void SerialBase::rx_burst_irq(void) {
+    size_t count = 0;
+    while (serial_readable(&_serial) && count < _rx_burst_size) {
+        _rx_burst_buf[count++] = (uint8_t)serial_getc(&_serial);
+    }
+    if (count && _rx_burst_cb) {
+        _rx_burst_cb(count);
+    }
+}
+
 void SerialBase::_irq_handler(uint32_t id, SerialIrq irq_type) {
     SerialBase *handler = (SerialBase*)id;
     if (handler->_irq[irq_type]) {
@@ -170,10 +201,32 @@ void SerialBase::set_flow_control(Flow type, PinName flow1, PinName flow2) {
 
 #if DEVICE_SERIAL_ASYNCH
 
+#if TRANSACTION_QUEUE_SIZE_SERIAL
+TransactionQueue<SerialBase, TRANSACTION_QUEUE_SIZE_SERIAL> SerialBase::_tx_transaction_queue;
+
+int SerialBase::queue_write(const void *buffer, int length, unsigned char width, const event_callback_t& callback, int event)
+{
+    transaction_t t;
+
+    t.tx_buffer = (void *)buffer;
+    t.tx_length = length;
+    t.rx_buffer = NULL;
+    t.rx_length = 0;
+    t.event = event;
+    t.callback = callback;
+    t.width = width;
+    return _tx_transaction_queue.add(this, t);
+}
+#endif
+
 int SerialBase::write(const uint8_t *buffer, int length, const event_callback_t& callback, int event)
 {
     if (serial_tx_active(&_serial)) {
+#if TRANSACTION_QUEUE_SIZE_SERIAL
+        return queue_write(buffer, length, 8, callback, event);
+#else
         return -1; // transaction ongoing
+#endif
     }
     start_write((void *)buffer, length, 8, callback, event);
     return 0;
@@ -182,7 +235,11 @@ int SerialBase::write(const uint8_t *buffer, int length, const event_callback_t&
 int SerialBase::write(const uint16_t *buffer, int length, const event_callback_t& callback, int event)
 {
     if (serial_tx_active(&_serial)) {
+#if TRANSACTION_QUEUE_SIZE_SERIAL
+        return queue_write(buffer, length, 16, callback, event);
+#else
         return -1; // transaction ongoing
+#endif
     }
     start_write((void *)buffer, length, 16, callback, event);
     return 0;
@@ -193,7 +250,7 @@ void SerialBase::start_write(const void *buffer, int buffer_size, char buffer_wi
     _tx_callback = callback;
 
     _thunk_irq.callback(&SerialBase::interrupt_handler_asynch);
-    sleep_manager_lock_deep_sleep();
+    sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_SERIAL);
     serial_tx_asynch(&_serial, buffer, buffer_size, buffer_width, _thunk_irq.entry(), event, _tx_usage);
 }
 
@@ -201,17 +258,20 @@ void SerialBase::abort_write(void)
 {
     // rx might still be active
     if (_rx_callback) {
-        sleep_manager_unlock_deep_sleep();
+        sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_SERIAL);
     }
     _tx_callback = NULL;
     serial_tx_abort_asynch(&_serial);
+#if TRANSACTION_QUEUE_SIZE_SERIAL
+    _tx_transaction_queue.dispatch_next();
+#endif
 }
 
 void SerialBase::abort_read(void)
 {
     // tx might still be active
     if (_tx_callback) {
-        sleep_manager_unlock_deep_sleep();
+        sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_SERIAL);
     }
     _rx_callback = NULL;
     serial_rx_abort_asynch(&_serial);
@@ -259,7 +319,7 @@ void SerialBase::start_read(void *buffer, int buffer_size, char buffer_width, co
 {
     _rx_callback = callback;
     _thunk_irq.callback(&SerialBase::interrupt_handler_asynch);
-    sleep_manager_lock_deep_sleep();
+    sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_SERIAL);
     serial_rx_asynch(&_serial, buffer, buffer_size, buffer_width, _thunk_irq.entry(), event, char_match, _rx_usage);
 }
 
@@ -281,12 +341,32 @@ void SerialBase::interrupt_handler_asynch(void)
     }
     // unlock if tx or rx events are generated
     if (unlock_deepsleep) {
-        sleep_manager_unlock_deep_sleep();
+        sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_SERIAL);
+    }
+#if TRANSACTION_QUEUE_SIZE_SERIAL
+    if (tx_event) {
+        // Transmitter is free - start the next queued write
+        _tx_transaction_queue.dispatch_next();
     }
+#endif
+}
+
+#if TRANSACTION_QUEUE_SIZE_SERIAL
+
+void SerialBase::start_transaction(transaction_t *data)
+{
+    start_write(data->tx_buffer, data->tx_length, data->width, data->callback, data->event);
+}
+
+bool SerialBase::transfer_active()
+{
+    return serial_tx_active(&_serial);
 }
 
 #endif
 
+#endif
+
 } // namespace mbed
 
 #endif
@@ -28,6 +28,7 @@
 #if DEVICE_SERIAL_ASYNCH
 #include "CThunk.h"
 #include "dma_api.h"
+#include "platform/TransactionQueue.h"
 #endif
 
 namespace mbed {
@@ -135,6 +136,21 @@ public:
         attach(callback(obj, method), type);
     }
 
+    /** Attach a burst receive handler draining the RX FIFO per interrupt
+     *
+     *  Instead of one RxIrq callback per character, the interrupt handler
+     *  drains every character the peripheral FIFO holds into the given
+     *  buffer and reports the byte count, so deep-FIFO parts take one
+     *  interrupt per burst rather than one per byte. Replaces any plain
+     *  RxIrq handler while attached; detach by passing a null callback.
+     *
+     *  @param buffer Buffer the FIFO is drained into, valid while attached
+     *  @param size   Capacity of the buffer in bytes
+     *  @param func   Function called from interrupt context with the number
+     *                of bytes placed in the buffer, or 0 to detach
+     */
+    void attach_rx_burst(uint8_t *buffer, size_t size, Callback<void(size_t)> func);
+
     /** Generate a break condition on the serial line
      */
     void send_break();
@@ -168,11 +184,16 @@ public:
     /** Begin asynchronous write using 8bit buffer. The completition invokes registered TX event callback
      *
      *  This function locks the deep sleep until any event has occured
-     * 
+     *
+     *  If the peripheral is mid-transfer and TRANSACTION_QUEUE_SIZE_SERIAL
+     *  is non-zero, the write is queued and started from the completion
+     *  interrupt of the transfer ahead of it.
+     *
      *  @param buffer   The buffer where received data will be stored
      *  @param length   The buffer length in bytes
      *  @param callback The event callback function
      *  @param event    The logical OR of TX events
+     *  @return Zero if the write has started or been queued, -1 otherwise
      */
     int write(const uint8_t *buffer, int length, const event_callback_t& callback, int event = SERIAL_EVENT_TX_COMPLETE);
 
@@ -237,6 +258,35 @@ protected:
     void start_read(void *buffer, int buffer_size, char buffer_width, const event_callback_t& callback, int event, unsigned char char_match);
     void start_write(const void *buffer, int buffer_size, char buffer_width, const event_callback_t& callback, int event);
     void interrupt_handler_asynch(void);
+
+#if TRANSACTION_QUEUE_SIZE_SERIAL
+
+    /** Queue a write for when the peripheral frees up
+     *
+     *  @param buffer   The buffer to transmit
+     *  @param length   The buffer length in bytes
+     *  @param width    The buffer element width (8 or 16)
+     *  @param callback The event callback function
+     *  @param event    The logical OR of TX events
+     *  @return Zero if the write was queued, -1 if the queue is full
+     */
+    int queue_write(const void *buffer, int length, unsigned char width, const event_callback_t& callback, int event);
+
+    /** Start a queued write transaction
+     *
+     *  @param data Transaction data
+     */
+    void start_transaction(transaction_t *data);
+
+    /** Check whether the peripheral is mid-transmission
+     *
+     *  @returns true if an asynchronous write is in progress
+     */
+    bool transfer_active();
+
+    friend class TransactionQueue<SerialBase, TRANSACTION_QUEUE_SIZE_SERIAL>;
+    static TransactionQueue<SerialBase, TRANSACTION_QUEUE_SIZE_SERIAL> _tx_transaction_queue;
+#endif
 #endif
 
 protected:
@@ -246,6 +296,11 @@ protected:
     int _base_getc();
     int _base_putc(int c);
 
+    /** RxIrq handler for the burst receive path
+     *  Drains the RX FIFO into the attached burst buffer and reports the count.
+     */
+    void rx_burst_irq(void);
+
 #if DEVICE_SERIAL_ASYNCH
     CThunk<SerialBase> _thunk_irq;
     DMAUsage _tx_usage;
@@ -256,6 +311,9 @@ protected:
 
     serial_t         _serial;
     Callback<void()> _irq[IrqCnt];
+    Callback<void(size_t)> _rx_burst_cb;
+    uint8_t          *_rx_burst_buf;
+    size_t           _rx_burst_size;
     int              _baud;
 
 };
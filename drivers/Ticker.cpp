@@ -27,7 +27,7 @@ void Ticker::detach() {
     remove();
     // unlocked only if we were attached (we locked it) and this is not low power ticker
     if(_function && _lock_deepsleep) {
-        sleep_manager_unlock_deep_sleep();
+        sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_TICKER);
     }
 
     _function = 0;
@@ -117,7 +117,7 @@ public:
         core_util_critical_section_enter();
         // lock only for the initial callback setup and this is not low power ticker
         if(!_function && _lock_deepsleep) {
-            sleep_manager_lock_deep_sleep();
+            sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_TICKER);
         }
         _function = func;
         setup(t);
@@ -0,0 +1,154 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/TimeoutPool.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+
+#include <new>
+
+namespace mbed {
+
+TimeoutPool::PooledTimeout::PooledTimeout(const ticker_data_t *data, TimeoutPool *pool) :
+    TimerEvent(data), _function(), _pool(pool), _owner(0), _gen(0), _next_free(0),
+    _active(false) {
+}
+
+void TimeoutPool::PooledTimeout::handler() {
+    core_util_critical_section_enter();
+    Callback<void()> function = _function;
+    /* recycle before dispatching, the callback may want a slot for the
+     * next retransmit */
+    _pool->release(this);
+    core_util_critical_section_exit();
+
+    if (function) {
+        function();
+    }
+}
+
+TimeoutPool::TimeoutPool(uint32_t count) :
+    _ticker(get_us_ticker_data()), _slots(NULL), _storage(NULL), _count(count),
+    _free_count(0), _free_head(0) {
+    MBED_ASSERT(count > 0 && count <= 0xFFFF);
+    _storage = new uint64_t[(count * sizeof(PooledTimeout) + 7) / 8];
+    _slots = reinterpret_cast<PooledTimeout *>(_storage);
+    for (uint32_t i = 0; i < count; i++) {
+        new (&_slots[i]) PooledTimeout(_ticker, this);
+        _slots[i]._next_free = i + 1;
+    }
+    _free_head = 0;
+    _free_count = count;
+}
+
+TimeoutPool::TimeoutPool(uint32_t count, const ticker_data_t *data) :
+    _ticker(data), _slots(NULL), _storage(NULL), _count(count), _free_count(0),
+    _free_head(0) {
+    MBED_ASSERT(count > 0 && count <= 0xFFFF);
+    _storage = new uint64_t[(count * sizeof(PooledTimeout) + 7) / 8];
+    _slots = reinterpret_cast<PooledTimeout *>(_storage);
+    for (uint32_t i = 0; i < count; i++) {
+        new (&_slots[i]) PooledTimeout(_ticker, this);
+        _slots[i]._next_free = i + 1;
+    }
+    _free_head = 0;
+    _free_count = count;
+}
+
+TimeoutPool::~TimeoutPool() {
+    core_util_critical_section_enter();
+    for (uint32_t i = 0; i < _count; i++) {
+        /* ~TimerEvent removes the event from the ticker queue */
+        _slots[i].~PooledTimeout();
+    }
+    core_util_critical_section_exit();
+    delete[] _storage;
+}
+
+TimeoutPool::timeout_id_t TimeoutPool::attach_us(Callback<void()> func, us_timestamp_t t, uint32_t owner) {
+    core_util_critical_section_enter();
+    if (_free_count == 0) {
+        core_util_critical_section_exit();
+        return 0;
+    }
+    PooledTimeout *slot = &_slots[_free_head];
+    _free_head = slot->_next_free;
+    _free_count--;
+
+    slot->_function = func;
+    slot->_owner = owner;
+    slot->_active = true;
+    timeout_id_t id = make_id(slot);
+
+    slot->schedule(ticker_read_us(_ticker) + t);
+    core_util_critical_section_exit();
+    return id;
+}
+
+bool TimeoutPool::detach(timeout_id_t id) {
+    uint32_t index = (id & 0xFFFF) - 1;
+    uint16_t gen = id >> 16;
+    if (id == 0 || index >= _count) {
+        return false;
+    }
+
+    core_util_critical_section_enter();
+    PooledTimeout *slot = &_slots[index];
+    if (!slot->_active || slot->_gen != gen) {
+        /* already fired, already cancelled, or the slot was reused */
+        core_util_critical_section_exit();
+        return false;
+    }
+    slot->cancel();
+    release(slot);
+    core_util_critical_section_exit();
+    return true;
+}
+
+uint32_t TimeoutPool::detach_owner(uint32_t owner) {
+    uint32_t cancelled = 0;
+
+    core_util_critical_section_enter();
+    for (uint32_t i = 0; i < _count; i++) {
+        PooledTimeout *slot = &_slots[i];
+        if (slot->_active && slot->_owner == owner) {
+            slot->cancel();
+            release(slot);
+            cancelled++;
+        }
+    }
+    core_util_critical_section_exit();
+    return cancelled;
+}
+
+uint32_t TimeoutPool::available() const {
+    return _free_count;
+}
+
+void TimeoutPool::release(PooledTimeout *slot) {
+    slot->_active = false;
+    slot->_gen++;
+    slot->_function = Callback<void()>();
+    slot->_next_free = _free_head;
+    _free_head = slot - _slots;
+    _free_count++;
+}
+
+TimeoutPool::timeout_id_t TimeoutPool::make_id(const PooledTimeout *slot) const {
+    return (((uint32_t)(slot - _slots) + 1) & 0xFFFF) | ((uint32_t)slot->_gen << 16);
+}
+
+} // namespace mbed
+
@@ -0,0 +1,162 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TIMEOUTPOOL_H
+#define MBED_TIMEOUTPOOL_H
+
+#include "drivers/TimerEvent.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** A pool of one-shot timeouts for layers that schedule and cancel many
+ * short-lived timers, such as protocol retransmit logic.
+ *
+ * All slots are allocated once at construction; scheduling takes a slot
+ * from a free list and cancelling or firing returns it, so the per-timer
+ * cost is a constant on top of the ticker queue operation. Each timeout
+ * carries an owner tag, and every timeout of one owner can be cancelled
+ * in a single call when, for example, a connection is torn down.
+ *
+ * Handles are generation checked: cancelling a timeout that has already
+ * fired, or whose slot has been reused, is detected and refused.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * // Retransmit with a per-connection timeout budget.
+ *
+ * #include "mbed.h"
+ *
+ * TimeoutPool pool(16);
+ *
+ * void on_retransmit();
+ *
+ * TimeoutPool::timeout_id_t id = pool.attach_us(on_retransmit, 200000, conn_id);
+ * ...
+ * pool.detach(id);            // ack arrived in time
+ * ...
+ * pool.detach_owner(conn_id); // connection closed, drop all its timers
+ * @endcode
+ * @ingroup drivers
+ */
+class TimeoutPool : private NonCopyable<TimeoutPool> {
+public:
+    /** Handle of a scheduled timeout; 0 is never a valid handle */
+    typedef uint32_t timeout_id_t;
+
+    /** Create a pool of one-shot timeouts on the microsecond ticker
+     *
+     *  @param count Number of slots to preallocate, at most 65535
+     */
+    TimeoutPool(uint32_t count);
+
+    /** Create a pool of one-shot timeouts on the given ticker
+     *
+     *  @param count Number of slots to preallocate, at most 65535
+     *  @param data  The ticker backing the timeouts, for instance
+     *               get_lp_ticker_data()
+     */
+    TimeoutPool(uint32_t count, const ticker_data_t *data);
+
+    /** Cancel every pending timeout and release the pool
+     */
+    ~TimeoutPool();
+
+    /** Schedule a function to be called once, a number of microseconds
+     * from now
+     *
+     *  The slot is returned to the pool before the function runs, so the
+     *  callback is free to schedule a new timeout from the same pool.
+     *
+     *  @param func  The function to call
+     *  @param t     The delay before the call, in microseconds
+     *  @param owner Tag grouping this timeout for detach_owner(), 0 by
+     *               default
+     *  @return      Handle of the scheduled timeout, or 0 if the pool is
+     *               exhausted
+     */
+    timeout_id_t attach_us(Callback<void()> func, us_timestamp_t t, uint32_t owner = 0);
+
+    /** Cancel a pending timeout
+     *
+     *  @param id Handle returned by attach_us()
+     *  @return   true if the timeout was pending and has been cancelled,
+     *            false if it already fired, was already cancelled, or the
+     *            handle is stale
+     */
+    bool detach(timeout_id_t id);
+
+    /** Cancel every pending timeout carrying the given owner tag
+     *
+     *  @param owner Tag the timeouts were scheduled with
+     *  @return      The number of timeouts cancelled
+     */
+    uint32_t detach_owner(uint32_t owner);
+
+    /** Get the number of free slots
+     *
+     *  @return Slots currently available to attach_us()
+     */
+    uint32_t available() const;
+
+private:
+    /** One slot of the pool - a TimerEvent plus the callback it fires */
+    class PooledTimeout : public TimerEvent {
+    public:
+        PooledTimeout(const ticker_data_t *data, TimeoutPool *pool);
+
+        /* Expose the protected TimerEvent scheduling to the pool */
+        void schedule(us_timestamp_t timestamp) {
+            insert_absolute(timestamp);
+        }
+
+        void cancel() {
+            remove();
+        }
+
+    protected:
+        virtual void handler();
+
+    public:
+        Callback<void()> _function;
+        TimeoutPool *_pool;
+        uint32_t _owner;
+        uint16_t _gen;       /**< Bumped on release, stale handles miss */
+        uint16_t _next_free; /**< Free list link, index into _slots */
+        bool _active;
+    };
+
+    friend class PooledTimeout;
+
+    /* Return a slot to the free list; interrupts must be masked */
+    void release(PooledTimeout *slot);
+
+    timeout_id_t make_id(const PooledTimeout *slot) const;
+
+    const ticker_data_t *_ticker;
+    PooledTimeout *_slots;
+    uint64_t *_storage;       /**< Raw backing memory of _slots */
+    uint32_t _count;
+    uint32_t _free_count;
+    uint16_t _free_head;      /**< First free slot, or _count when full */
+};
+
+} // namespace mbed
+
+#endif
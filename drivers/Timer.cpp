@@ -36,7 +36,7 @@ Timer::~Timer() {
     core_util_critical_section_enter();
     if (_running) {
         if(_lock_deepsleep) {
-            sleep_manager_unlock_deep_sleep();
+            sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_TIMER);
         }
     }
     _running = 0;
@@ -47,7 +47,7 @@ void Timer::start() {
     core_util_critical_section_enter();
     if (!_running) {
         if(_lock_deepsleep) {
-            sleep_manager_lock_deep_sleep();
+            sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_TIMER);
         }
         _start = ticker_read_us(_ticker_data);
         _running = 1;
@@ -60,7 +60,7 @@ void Timer::stop() {
     _time += slicetime();
     if (_running) {
         if(_lock_deepsleep) {
-            sleep_manager_unlock_deep_sleep();
+            sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_TIMER);
         }
     }
     _running = 0;
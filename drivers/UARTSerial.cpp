@@ -34,6 +34,9 @@ UARTSerial::UARTSerial(PinName tx, PinName rx, int baud) :
         _tx_irq_enabled(false),
         _dcd_irq(NULL)
 {
+#if DEVICE_SERIAL_ASYNCH
+    _rx_dma_enabled = false;
+#endif
     /* Attatch IRQ routines to the serial device. */
     SerialBase::attach(callback(this, &UARTSerial::rx_irq), RxIrq);
 }
@@ -53,6 +56,64 @@ void UARTSerial::set_baud(int baud)
     SerialBase::baud(baud);
 }
 
+#if DEVICE_SERIAL_ASYNCH
+int UARTSerial::set_rx_dma(bool enable)
+{
+    api_lock();
+    core_util_critical_section_enter();
+
+    if (enable && !_rx_dma_enabled) {
+        /* Hand reception over to the asynchronous HAL; rx_irq() must no
+         * longer drain the peripheral behind the transfer's back. */
+        SerialBase::attach(NULL, RxIrq);
+        SerialBase::set_dma_usage_rx(DMA_USAGE_ALWAYS);
+        _rx_dma_enabled = true;
+        start_rx_dma();
+    } else if (!enable && _rx_dma_enabled) {
+        SerialBase::abort_read();
+        SerialBase::set_dma_usage_rx(DMA_USAGE_NEVER);
+        _rx_dma_enabled = false;
+        SerialBase::attach(callback(this, &UARTSerial::rx_irq), RxIrq);
+    }
+
+    core_util_critical_section_exit();
+    api_unlock();
+
+    return 0;
+}
+
+void UARTSerial::start_rx_dma(void)
+{
+    SerialBase::read(_dma_rxchunk, sizeof _dma_rxchunk,
+                     callback(this, &UARTSerial::rx_dma_irq),
+                     SERIAL_EVENT_RX_COMPLETE);
+}
+
+void UARTSerial::rx_dma_irq(int event)
+{
+    bool was_empty = _rxbuf.empty();
+
+    if (event & SERIAL_EVENT_RX_COMPLETE) {
+        for (size_t i = 0; i < sizeof _dma_rxchunk; i++) {
+            if (!_rxbuf.full()) {
+                _rxbuf.push(_dma_rxchunk[i]);
+            } else {
+                /* Drop - can we report in some way? */
+            }
+        }
+    }
+
+    if (_rx_dma_enabled) {
+        start_rx_dma();
+    }
+
+    /* Report the File handler that data is ready to be read from the buffer. */
+    if (was_empty && !_rxbuf.empty()) {
+        wake();
+    }
+}
+#endif
+
 void UARTSerial::set_data_carrier_detect(PinName dcd_pin, bool active_high)
 {
      delete _dcd_irq;
@@ -153,6 +214,78 @@ ssize_t UARTSerial::write(const void* buffer, size_t length)
     return data_written;
 }
 
+ssize_t UARTSerial::writev(const iovec_t *iov, int iovcnt)
+{
+    size_t data_written = 0;
+
+    api_lock();
+
+    while (_txbuf.full()) {
+        if (!_blocking) {
+            api_unlock();
+            return -EAGAIN;
+        }
+        api_unlock();
+        wait_ms(1); // XXX todo - proper wait, WFE for non-rtos ?
+        api_lock();
+    }
+
+    for (int i = 0; i < iovcnt && !_txbuf.full(); i++) {
+        const char *buf_ptr = static_cast<const char *>(iov[i].base);
+        size_t piece_written = 0;
+        while (piece_written < iov[i].len && !_txbuf.full()) {
+            _txbuf.push(*buf_ptr++);
+            piece_written++;
+        }
+        data_written += piece_written;
+    }
+
+    core_util_critical_section_enter();
+    if (!_tx_irq_enabled) {
+        UARTSerial::tx_irq();                // only write to hardware in one place
+        if (!_txbuf.empty()) {
+            SerialBase::attach(callback(this, &UARTSerial::tx_irq), TxIrq);
+            _tx_irq_enabled = true;
+        }
+    }
+    core_util_critical_section_exit();
+
+    api_unlock();
+
+    return data_written;
+}
+
+ssize_t UARTSerial::readv(const iovec_t *iov, int iovcnt)
+{
+    size_t data_read = 0;
+
+    api_lock();
+
+    while (_rxbuf.empty()) {
+        if (!_blocking) {
+            api_unlock();
+            return -EAGAIN;
+        }
+        api_unlock();
+        wait_ms(1);  // XXX todo - proper wait, WFE for non-rtos ?
+        api_lock();
+    }
+
+    for (int i = 0; i < iovcnt && !_rxbuf.empty(); i++) {
+        char *ptr = static_cast<char *>(iov[i].base);
+        size_t piece_read = 0;
+        while (piece_read < iov[i].len && !_rxbuf.empty()) {
+            _rxbuf.pop(*ptr++);
+            piece_read++;
+        }
+        data_read += piece_read;
+    }
+
+    api_unlock();
+
+    return data_read;
+}
+
 ssize_t UARTSerial::read(void* buffer, size_t length)
 {
     size_t data_read = 0;
@@ -181,6 +314,32 @@ ssize_t UARTSerial::read(void* buffer, size_t length)
     return data_read;
 }
 
+ssize_t UARTSerial::read_borrow(const void **buffer)
+{
+    api_lock();
+
+    const char *data;
+    uint32_t len = _rxbuf.peek_contiguous(&data);
+
+    api_unlock();
+
+    if (len == 0) {
+        return -EAGAIN;
+    }
+
+    *buffer = data;
+    return len;
+}
+
+void UARTSerial::read_release(size_t size)
+{
+    api_lock();
+
+    _rxbuf.pop_n(size);
+
+    api_unlock();
+}
+
 bool UARTSerial::hup() const
 {
     return _dcd_irq && _dcd_irq->read() != 0;
@@ -188,6 +347,7 @@ bool UARTSerial::hup() const
 
 void UARTSerial::wake()
 {
+    poll_notify();
     if (_sigio_cb) {
         _sigio_cb();
     }
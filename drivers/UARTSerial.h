@@ -37,6 +37,10 @@
 #define MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE  256
 #endif
 
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_DMA_RXCHUNK_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_DMA_RXCHUNK_SIZE  32
+#endif
+
 namespace mbed {
 
 class UARTSerial : private SerialBase, public FileHandle, private NonCopyable<UARTSerial> {
@@ -84,6 +88,49 @@ public:
      */
     virtual ssize_t read(void* buffer, size_t length);
 
+    /** Write the contents of multiple buffers to a file
+     *
+     *  All pieces are staged into the TX buffer under a single lock with
+     *  one transmit kick, so multi-part records cost no more than a
+     *  single pre-concatenated write().
+     *
+     *  @param iov      Array of buffer pieces to write from
+     *  @param iovcnt   The number of pieces in the array
+     *  @return         The total number of bytes written, negative error on failure
+     */
+    virtual ssize_t writev(const iovec_t *iov, int iovcnt);
+
+    /** Read the contents of a file into multiple buffers
+     *
+     *  The pieces are filled in order from the RX buffer under a single
+     *  lock; semantics otherwise follow read().
+     *
+     *  @param iov      Array of buffer pieces to read in to
+     *  @param iovcnt   The number of pieces in the array
+     *  @return         The total number of bytes read, negative error on failure
+     */
+    virtual ssize_t readv(const iovec_t *iov, int iovcnt);
+
+    /** Borrow a contiguous run of received data without copying it
+     *
+     *  Exposes the RX ring buffer's read region directly. The region is
+     *  not overwritten by reception (the RX interrupt drops data when the
+     *  ring is full), so it stays valid until read_release(). Reads must
+     *  not be issued while a borrow is outstanding.
+     *
+     *  @param buffer   Filled with a pointer to the received data
+     *  @return         The number of bytes borrowed, -EAGAIN if no data
+     *                  is pending
+     */
+    virtual ssize_t read_borrow(const void **buffer);
+
+    /** Return data borrowed with read_borrow() and consume it
+     *
+     *  @param size     The number of bytes to consume, at most the size
+     *                  of the outstanding borrow
+     */
+    virtual void read_release(size_t size);
+
     /** Close a file
      *
      *  @return         0 on success, negative error code on failure
@@ -164,6 +211,26 @@ public:
      */
     void set_baud(int baud);
 
+#if DEVICE_SERIAL_ASYNCH || defined(DOXYGEN_ONLY)
+    /** Enable or disable DMA-driven block reception
+     *
+     *  In block mode the receive buffer is filled by the asynchronous
+     *  serial HAL in chunks of MBED_CONF_DRIVERS_UART_SERIAL_DMA_RXCHUNK_SIZE
+     *  bytes instead of taking an interrupt per character, so sustained
+     *  high-baud streams cost a fraction of the CPU time. Data still
+     *  arrives through read() as usual. Note that a partially filled
+     *  chunk is only pushed once the HAL completes the transfer, so
+     *  per-byte latency is bounded by the chunk size; size the chunk
+     *  for the expected burst length.
+     *
+     *  @param enable  true to switch to block reception, false to return
+     *                 to per-character interrupts
+     *  @return        0 on success, negative error code if the underlying
+     *                 serial device cannot provide asynchronous transfers
+     */
+    int set_rx_dma(bool enable);
+#endif
+
 private:
 
     void wait_ms(uint32_t millisec);
@@ -209,6 +276,19 @@ private:
     void tx_irq(void);
     void rx_irq(void);
 
+#if DEVICE_SERIAL_ASYNCH
+    /** Restart the asynchronous chunk reception */
+    void start_rx_dma(void);
+
+    /** Completion handler for a received chunk
+     *  Moves the chunk into the Circular Buffer and rearms the transfer.
+     */
+    void rx_dma_irq(int event);
+
+    bool _rx_dma_enabled;
+    uint8_t _dma_rxchunk[MBED_CONF_DRIVERS_UART_SERIAL_DMA_RXCHUNK_SIZE];
+#endif
+
     void wake(void);
 
     void dcd_irq(void);
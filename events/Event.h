@@ -57,6 +57,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -120,6 +121,17 @@ public:
         }
     }
 
+    /** Configure the coalescing window of an event
+     *
+     *  @param slack    Millisecond window the event's deadline may be
+     *                  delayed to align with another pending wakeup
+     */
+    void slack(int slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -189,6 +201,7 @@ private:
 
         int delay;
         int period;
+        int slack;
 
         int (*post)(struct event *);
         void (*dtor)(struct event *);
@@ -208,6 +221,7 @@ private:
         new (p) C(*(F*)(e + 1));
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -471,6 +485,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -534,6 +549,17 @@ public:
         }
     }
 
+    /** Configure the coalescing window of an event
+     *
+     *  @param slack    Millisecond window the event's deadline may be
+     *                  delayed to align with another pending wakeup
+     */
+    void slack(int slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -607,6 +633,7 @@ private:
 
         int delay;
         int period;
+        int slack;
 
         int (*post)(struct event *, A0 a0);
         void (*dtor)(struct event *);
@@ -626,6 +653,7 @@ private:
         new (p) C(*(F*)(e + 1), a0);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -889,6 +917,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -952,6 +981,17 @@ public:
         }
     }
 
+    /** Configure the coalescing window of an event
+     *
+     *  @param slack    Millisecond window the event's deadline may be
+     *                  delayed to align with another pending wakeup
+     */
+    void slack(int slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -1025,6 +1065,7 @@ private:
 
         int delay;
         int period;
+        int slack;
 
         int (*post)(struct event *, A0 a0, A1 a1);
         void (*dtor)(struct event *);
@@ -1044,6 +1085,7 @@ private:
         new (p) C(*(F*)(e + 1), a0, a1);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -1307,6 +1349,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -1370,6 +1413,17 @@ public:
         }
     }
 
+    /** Configure the coalescing window of an event
+     *
+     *  @param slack    Millisecond window the event's deadline may be
+     *                  delayed to align with another pending wakeup
+     */
+    void slack(int slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -1443,6 +1497,7 @@ private:
 
         int delay;
         int period;
+        int slack;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2);
         void (*dtor)(struct event *);
@@ -1462,6 +1517,7 @@ private:
         new (p) C(*(F*)(e + 1), a0, a1, a2);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -1725,6 +1781,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -1788,6 +1845,17 @@ public:
         }
     }
 
+    /** Configure the coalescing window of an event
+     *
+     *  @param slack    Millisecond window the event's deadline may be
+     *                  delayed to align with another pending wakeup
+     */
+    void slack(int slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -1861,6 +1929,7 @@ private:
 
         int delay;
         int period;
+        int slack;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2, A3 a3);
         void (*dtor)(struct event *);
@@ -1880,6 +1949,7 @@ private:
         new (p) C(*(F*)(e + 1), a0, a1, a2, a3);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -2143,6 +2213,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -2206,6 +2277,17 @@ public:
         }
     }
 
+    /** Configure the coalescing window of an event
+     *
+     *  @param slack    Millisecond window the event's deadline may be
+     *                  delayed to align with another pending wakeup
+     */
+    void slack(int slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -2279,6 +2361,7 @@ private:
 
         int delay;
         int period;
+        int slack;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4);
         void (*dtor)(struct event *);
@@ -2298,6 +2381,7 @@ private:
         new (p) C(*(F*)(e + 1), a0, a1, a2, a3, a4);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
+        equeue_event_slack(p, e->slack);
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -3620,6 +3704,155 @@ Event<void(A0, A1, A2, A3, A4)> EventQueue::event(mbed::Callback<R(B0, B1, B2, B
     return Event<void(A0, A1, A2, A3, A4)>(this, cb, c0, c1, c2, c3, c4);
 }
 
+/** UserAllocatedEvent
+ *
+ *  Representation of an event with all of its storage embedded in the
+ *  object itself. Unlike Event, neither construction nor posting touches
+ *  the event queue's allocator, so posting completes in constant time and
+ *  cannot fail - useful for hot interrupt paths and for callables too
+ *  large for the queue's memory pool.
+ *
+ *  The callable is constructed once and reused across posts, so bind any
+ *  arguments up front, for example with mbed::callback or a context
+ *  object. The event must not be posted again while still pending and the
+ *  object must outlive any pending post.
+ * @ingroup events
+ */
+template <typename F>
+class UserAllocatedEvent {
+public:
+    /** Create a statically-bound event
+     *
+     *  Constructs an event bound to the specified event queue. The
+     *  callable is copied into storage owned by this object and acts as
+     *  the target for the event once posted.
+     *
+     *  @param q                Event queue to dispatch on
+     *  @param f                Function to execute when the event is dispatched
+     */
+    UserAllocatedEvent(EventQueue *q, F f) :
+            _equeue(&q->_equeue), _delay(0), _period(-1), _slack(0) {
+        struct equeue_event *e = (struct equeue_event *)_storage.data;
+        e->id = 0;
+        e->target = 0;
+        e->period = -1;
+        e->slack = 0;
+        e->dtor = 0;
+        e->prio = EQUEUE_PRIO_NORMAL;
+        e->affinity = EQUEUE_AFFINITY_ANY;
+        new (e + 1) F(f);
+    }
+
+    /** Destructor for events
+     *
+     *  Cancels any pending post before releasing the embedded callable.
+     */
+    ~UserAllocatedEvent() {
+        cancel();
+        ((F*)((struct equeue_event *)_storage.data + 1))->~F();
+    }
+
+    /** Configure the delay of an event
+     *
+     *  @param delay    Millisecond delay before dispatching the event
+     */
+    void delay(int delay) {
+        _delay = delay;
+    }
+
+    /** Configure the period of an event
+     *
+     *  @param period   Millisecond period for repeatedly dispatching an event
+     */
+    void period(int period) {
+        _period = period;
+    }
+
+    /** Configure the coalescing window of an event
+     *
+     *  @param slack    Millisecond window the event's deadline may be
+     *                  delayed to align with another pending wakeup
+     */
+    void slack(int slack) {
+        _slack = slack;
+    }
+
+    /** Posts the event onto the underlying event queue
+     *
+     *  The embedded storage is linked directly into the queue, so the post
+     *  cannot fail and performs no allocation. The event must not already
+     *  be pending.
+     *
+     *  The post function is irq safe and can act as a mechanism for moving
+     *  events out of irq contexts.
+     */
+    void post() const {
+        struct equeue_event *e = (struct equeue_event *)_storage.data;
+        MBED_ASSERT(e->id == 0);
+        equeue_event_delay(e + 1, _delay);
+        equeue_event_period(e + 1, _period);
+        equeue_event_slack(e + 1, _slack);
+        equeue_post_user_allocated(_equeue, &UserAllocatedEvent::event_call, e);
+    }
+
+    /** Posts the event onto the underlying event queue
+     */
+    void call() const {
+        post();
+    }
+
+    /** Posts the event onto the underlying event queue
+     */
+    void operator()() const {
+        return call();
+    }
+
+    /** Static thunk for passing as C-style function
+     *
+     *  @param func     Event to call passed as a void pointer
+     */
+    static void thunk(void *func) {
+        return static_cast<UserAllocatedEvent*>(func)->call();
+    }
+
+    /** Cancels a pending post
+     *
+     *  Attempts to cancel a pending post. It is safe to call cancel after
+     *  the event has already been dispatched.
+     *
+     *  The cancel function is irq safe.
+     *
+     *  If called while the event queue's dispatch loop is active, the
+     *  cancel function does not garuntee that the event will not execute
+     *  after it returns, as the event may have already begun executing.
+     */
+    void cancel() const {
+        equeue_cancel_user_allocated(_equeue,
+                (struct equeue_event *)_storage.data);
+    }
+
+private:
+    // storage is bound to a single queue, copying would alias the
+    // embedded event header
+    UserAllocatedEvent(const UserAllocatedEvent &);
+    UserAllocatedEvent &operator=(const UserAllocatedEvent &);
+
+    static void event_call(void *p) {
+        (*(F*)p)();
+    }
+
+    equeue_t *_equeue;
+    int _delay;
+    int _period;
+    int _slack;
+
+    mutable union storage {
+        unsigned char data[sizeof(struct equeue_event) + sizeof(F)];
+        // force worst-case alignment for the embedded event and callable
+        long long align;
+    } _storage;
+};
+
 }
 
 #endif
@@ -35,6 +35,10 @@ void EventQueue::dispatch(int ms) {
     return equeue_dispatch(&_equeue, ms);
 }
 
+void EventQueue::dispatch_worker() {
+    return equeue_dispatch_worker(&_equeue);
+}
+
 void EventQueue::break_dispatch() {
     return equeue_break(&_equeue);
 }
@@ -43,6 +47,14 @@ unsigned EventQueue::tick() {
     return equeue_tick();
 }
 
+void EventQueue::fetch_stats(struct equeue_stats *stats) {
+    return equeue_fetch_stats(&_equeue, stats);
+}
+
+void EventQueue::reset_stats() {
+    return equeue_reset_stats(&_equeue);
+}
+
 void EventQueue::cancel(int id) {
     return equeue_cancel(&_equeue, id);
 }
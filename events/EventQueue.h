@@ -20,6 +20,7 @@
 #include "equeue/equeue.h"
 #include "platform/Callback.h"
 #include "platform/NonCopyable.h"
+#include "platform/mbed_assert.h"
 #include <cstddef>
 #include <new>
 
@@ -91,6 +92,22 @@ public:
      */
     void dispatch_forever() { dispatch(); }
 
+    /** Dispatch events as a helper thread
+     *
+     *  Executes events alongside another thread's dispatch call until
+     *  break_dispatch is called on this queue. While at least one helper
+     *  is running, ready events are executed by whichever thread is idle
+     *  first, so one slow event no longer stalls unrelated ones. Events
+     *  that must serialize against each other can be pinned to the
+     *  dispatching thread with equeue_event_affinity.
+     *
+     *  Each break_dispatch call terminates a single loop, either a
+     *  dispatch loop or a helper loop.
+     *
+     *  @see EventQueue::dispatch
+     */
+    void dispatch_worker();
+
     /** Break out of a running event loop
      *
      *  Forces the specified event queue's dispatch loop to terminate. Pending
@@ -108,6 +125,31 @@ public:
      */
     unsigned tick();
 
+    /** Read the queue's dispatch statistics
+     *
+     *  Copies a snapshot of the dispatch statistics recorded by the
+     *  underlying event queue: the number of events executed, the worst
+     *  queue-to-dispatch latency, the longest handler runtime, and the
+     *  high-water mark of the queue's memory pool. The counters stay
+     *  cheap enough to remain enabled in production builds; see
+     *  EQUEUE_ENABLE_STATS for compiling them out.
+     *
+     *  The fetch_stats function is irq safe.
+     *
+     *  @param stats    Structure filled with the current counters
+     */
+    void fetch_stats(struct equeue_stats *stats);
+
+    /** Reset the queue's dispatch statistics
+     *
+     *  Clears the dispatch count and the latency and runtime maximums.
+     *  The memory pool high-water mark persists as it reflects the
+     *  buffer's lifetime usage.
+     *
+     *  The reset_stats function is irq safe.
+     */
+    void reset_stats();
+
     /** Cancel an in-flight event
      *
      *  Attempts to cancel an event referenced by the unique id returned from
@@ -184,6 +226,53 @@ public:
         return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
     }
 
+    /** Calls an event on the queue with an explicit priority lane
+     *
+     *  Expired events are dispatched lane by lane, so at equal deadlines
+     *  an event in a lower-numbered lane always runs first, and a burst
+     *  of low-priority events can no longer delay a high-priority one.
+     *  Lane 0 (EQUEUE_PRIO_HIGH) additionally preempts iteration of
+     *  lower lanes between events of an in-progress dispatch batch.
+     *
+     *  @param prio     Priority lane, 0 to EQUEUE_PRIO_LANES-1, lower runs first
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_prio(int prio, F f) {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        equeue_event_prio(e, prio);
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
+    /** Calls an event on the queue through the lock-free post path
+     *
+     *  The specified function and argument are staged into a bounded
+     *  lock-free ring with a single compare-and-swap, without touching
+     *  the queue's locks or allocator, so posting from a hot interrupt
+     *  handler completes in a handful of cycles and never contends with
+     *  the dispatch thread. The event is executed ahead of the timed
+     *  queue on the next dispatch pass.
+     *
+     *  Events posted this way cannot be delayed, made periodic, or
+     *  cancelled.
+     *
+     *  @param func     Function to execute in the context of the dispatch loop
+     *  @param data     Argument to pass to the function
+     *  @return         0 on success, -1 if the ring is full
+     */
+    int call_irq(void (*func)(void *), void *data) {
+        return equeue_call_irq(&_equeue, func, data);
+    }
+
     /** Calls an event on the queue
      *  @see                    EventQueue::call
      *  @param f                Function to execute in the context of the dispatch loop
@@ -2280,6 +2369,8 @@ public:
 protected:
     template <typename F>
     friend class Event;
+    template <typename F>
+    friend class UserAllocatedEvent;
     struct equeue _equeue;
     mbed::Callback<void(int)> _update;
 
@@ -2728,6 +2819,36 @@ protected:
     };
 };
 
+/** StaticEventQueue
+ *
+ *  EventQueue whose event buffer is a member of the object itself instead
+ *  of a heap allocation made at construction. Declared static or global,
+ *  the buffer lands in .bss where its exact cost shows up in the linker
+ *  map, allowing events to be used in builds that forbid heap allocation.
+ *  The requested size is validated against the minimum event size at
+ *  compile time.
+ *
+ *  @param Bytes    Size of the event buffer in bytes
+ *                  (default to EVENTS_QUEUE_SIZE)
+ * @ingroup events
+ */
+template <size_t Bytes = EVENTS_QUEUE_SIZE>
+class StaticEventQueue : public EventQueue {
+public:
+    /** Create a StaticEventQueue
+     *
+     *  Create an event queue backed by the embedded buffer.
+     */
+    StaticEventQueue() : EventQueue(sizeof(_buffer), (unsigned char *)_buffer) {
+        MBED_STATIC_ASSERT(Bytes >= EVENTS_EVENT_SIZE,
+                "StaticEventQueue must be large enough for at least one event");
+    }
+
+private:
+    // sized in uint64_t for worst-case alignment of event storage
+    uint64_t _buffer[(Bytes + sizeof(uint64_t)-1) / sizeof(uint64_t)];
+};
+
 }
 
 #endif
@@ -71,14 +71,44 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer) {
     q->slab.data = buffer;
 
     q->queue = 0;
+#ifdef EQUEUE_USE_TIMER_WHEEL
+    for (unsigned i = 0; i < EQUEUE_WHEEL_SLOTS; i++) {
+        q->wheel[i] = 0;
+        q->wheel_tail[i] = &q->wheel[i];
+    }
+#endif
     q->tick = equeue_tick();
     q->generation = 0;
     q->breaks = 0;
+    q->hipri_posted = 0;
+
+#if EQUEUE_IRQPOST_SLOTS
+    for (unsigned i = 0; i < EQUEUE_IRQPOST_SLOTS; i++) {
+        q->irqposts[i].ready = 0;
+    }
+    q->irqpost_head = 0;
+    q->irqpost_tail = 0;
+#endif
 
     q->background.active = false;
     q->background.update = 0;
     q->background.timer = 0;
 
+    q->chain.parent = 0;
+    q->chain.children = 0;
+    q->chain.sibling = 0;
+
+    q->ready = 0;
+    q->ready_tail = &q->ready;
+    q->workers = 0;
+
+#if EQUEUE_ENABLE_STATS
+    q->stats.dispatched = 0;
+    q->stats.max_latency = 0;
+    q->stats.max_runtime = 0;
+    q->stats.slab_highwater = 0;
+#endif
+
     // initialize platform resources
     int err;
     err = equeue_sema_create(&q->eventsema);
@@ -86,6 +116,11 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer) {
         return err;
     }
 
+    err = equeue_sema_create(&q->workersema);
+    if (err < 0) {
+        return err;
+    }
+
     err = equeue_mutex_create(&q->queuelock);
     if (err < 0) {
         return err;
@@ -100,7 +135,22 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer) {
 }
 
 void equeue_destroy(equeue_t *q) {
+    // detach from any chained queues
+    equeue_chain(q, 0);
+    while (q->chain.children) {
+        equeue_chain(q->chain.children, 0);
+    }
+
     // call destructors on pending events
+#ifdef EQUEUE_USE_TIMER_WHEEL
+    for (unsigned i = 0; i < EQUEUE_WHEEL_SLOTS; i++) {
+        for (struct equeue_event *e = q->wheel[i]; e; e = e->next) {
+            if (e->dtor) {
+                e->dtor(e + 1);
+            }
+        }
+    }
+#else
     for (struct equeue_event *es = q->queue; es; es = es->next) {
         for (struct equeue_event *e = q->queue; e; e = e->sibling) {
             if (e->dtor) {
@@ -108,6 +158,7 @@ void equeue_destroy(equeue_t *q) {
             }
         }
     }
+#endif
 
     // notify background timer
     if (q->background.update) {
@@ -117,6 +168,7 @@ void equeue_destroy(equeue_t *q) {
     // clean up platform resources + memory
     equeue_mutex_destroy(&q->memlock);
     equeue_mutex_destroy(&q->queuelock);
+    equeue_sema_destroy(&q->workersema);
     equeue_sema_destroy(&q->eventsema);
     free(q->allocated);
 }
@@ -154,6 +206,12 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size) {
         e->size = size;
         e->id = 1;
 
+#if EQUEUE_ENABLE_STATS
+        // chunks are recycled but never returned to the slab, so the
+        // total carved out is also the buffer's high-water mark
+        q->stats.slab_highwater += size;
+#endif
+
         equeue_mutex_unlock(&q->memlock);
         return e;
     }
@@ -191,7 +249,10 @@ void *equeue_alloc(equeue_t *q, size_t size) {
 
     e->target = 0;
     e->period = -1;
+    e->slack = 0;
     e->dtor = 0;
+    e->prio = EQUEUE_PRIO_NORMAL;
+    e->affinity = EQUEUE_AFFINITY_ANY;
 
     return e + 1;
 }
@@ -208,6 +269,182 @@ void equeue_dealloc(equeue_t *q, void *p) {
 
 
 // equeue scheduling functions
+#ifdef EQUEUE_USE_TIMER_WHEEL
+// unlink an event from its wheel bucket, fixing up the bucket tail
+static void equeue_wheel_unlink(equeue_t *q, struct equeue_event *e) {
+    unsigned slot = e->target % EQUEUE_WHEEL_SLOTS;
+    *e->ref = e->next;
+    if (e->next) {
+        e->next->ref = e->ref;
+    } else {
+        q->wheel_tail[slot] = e->ref;
+    }
+}
+
+// find the relative time until the earliest pending event,
+// -1 if the wheel is empty, must be called with queuelock held
+static int equeue_wheel_next(equeue_t *q, unsigned tick) {
+    int next = -1;
+    for (unsigned i = 0; i < EQUEUE_WHEEL_SLOTS; i++) {
+        for (struct equeue_event *e = q->wheel[i]; e; e = e->next) {
+            int diff = equeue_clampdiff(e->target, tick);
+            if (next < 0 || diff < next) {
+                next = diff;
+            }
+        }
+    }
+    return next;
+}
+
+// align a slack-tolerant deadline with an already-pending wakeup up to
+// slack ms later, letting periodic events share timer interrupts
+static void equeue_coalesce(equeue_t *q, struct equeue_event *e) {
+    int best = -1;
+    for (unsigned i = 0; i < EQUEUE_WHEEL_SLOTS; i++) {
+        for (struct equeue_event *c = q->wheel[i]; c; c = c->next) {
+            int diff = equeue_tickdiff(c->target, e->target);
+            if (diff >= 0 && diff <= e->slack &&
+                (best < 0 || diff < best)) {
+                best = diff;
+            }
+        }
+    }
+
+    if (best > 0) {
+        e->target += best;
+    }
+}
+
+static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick) {
+    // setup event and hash local id with buffer offset for unique id
+    int id = (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
+    e->target = tick + equeue_clampdiff(e->target, tick);
+    e->generation = q->generation;
+
+    equeue_mutex_lock(&q->queuelock);
+
+    if (e->slack > 0) {
+        equeue_coalesce(q, e);
+    }
+
+    // append to the bucket the event's deadline hashes to, keeping
+    // insertion order within the bucket
+    unsigned slot = e->target % EQUEUE_WHEEL_SLOTS;
+    e->next = 0;
+    e->sibling = 0;
+    *q->wheel_tail[slot] = e;
+    e->ref = q->wheel_tail[slot];
+    q->wheel_tail[slot] = &e->next;
+
+    // notify background timer
+    if (q->background.update && q->background.active) {
+        q->background.update(q->background.timer,
+                equeue_wheel_next(q, tick));
+    }
+
+    equeue_mutex_unlock(&q->queuelock);
+
+    return id;
+}
+
+static struct equeue_event *equeue_unqueue(equeue_t *q, int id) {
+    // decode event from unique id and check that the local id matches
+    struct equeue_event *e = (struct equeue_event *)
+            &q->buffer[id & ((1 << q->npw2)-1)];
+
+    equeue_mutex_lock(&q->queuelock);
+    if (e->id != id >> q->npw2) {
+        equeue_mutex_unlock(&q->queuelock);
+        return 0;
+    }
+
+    // clear the event and check if already in-flight
+    e->cb = 0;
+    e->period = -1;
+
+    int diff = equeue_tickdiff(e->target, q->tick);
+    if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
+        equeue_mutex_unlock(&q->queuelock);
+        return 0;
+    }
+
+    // disentangle from the wheel
+    equeue_wheel_unlink(q, e);
+
+    equeue_incid(q, e);
+    equeue_mutex_unlock(&q->queuelock);
+
+    return e;
+}
+
+static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target) {
+    equeue_mutex_lock(&q->queuelock);
+
+    // mark a new generation
+    q->generation += 1;
+    if (equeue_tickdiff(q->tick, target) <= 0) {
+        q->tick = target;
+    }
+
+    // sweep every bucket for expired events, stable-sorting them by
+    // deadline so dispatch order matches the sorted-list backend
+    struct equeue_event *head = 0;
+    for (unsigned i = 0; i < EQUEUE_WHEEL_SLOTS; i++) {
+        struct equeue_event *e = q->wheel[i];
+        while (e) {
+            struct equeue_event *next = e->next;
+            if (equeue_tickdiff(e->target, target) <= 0) {
+                equeue_wheel_unlink(q, e);
+
+                struct equeue_event **p = &head;
+                while (*p && equeue_tickdiff((*p)->target, e->target) <= 0) {
+                    p = &(*p)->next;
+                }
+                e->next = *p;
+                *p = e;
+            }
+            e = next;
+        }
+    }
+
+    equeue_mutex_unlock(&q->queuelock);
+
+    return head;
+}
+#else
+// unlink an event from the sorted queue, fixing up siblings and refs
+static void equeue_queue_unlink(struct equeue_event *e) {
+    if (e->sibling) {
+        e->sibling->next = e->next;
+        if (e->sibling->next) {
+            e->sibling->next->ref = &e->sibling->next;
+        }
+
+        *e->ref = e->sibling;
+        e->sibling->ref = e->ref;
+    } else {
+        *e->ref = e->next;
+        if (e->next) {
+            e->next->ref = e->ref;
+        }
+    }
+}
+
+// align a slack-tolerant deadline with an already-pending wakeup up to
+// slack ms later, letting periodic events share timer interrupts
+static void equeue_coalesce(equeue_t *q, struct equeue_event *e) {
+    for (struct equeue_event *c = q->queue; c; c = c->next) {
+        int diff = equeue_tickdiff(c->target, e->target);
+        if (diff >= 0) {
+            // sorted, so the first non-earlier deadline is the closest
+            if (diff <= e->slack) {
+                e->target = c->target;
+            }
+            return;
+        }
+    }
+}
+
 static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick) {
     // setup event and hash local id with buffer offset for unique id
     int id = (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
@@ -216,6 +453,10 @@ static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick) {
 
     equeue_mutex_lock(&q->queuelock);
 
+    if (e->slack > 0) {
+        equeue_coalesce(q, e);
+    }
+
     // find the event slot
     struct equeue_event **p = &q->queue;
     while (*p && equeue_tickdiff((*p)->target, e->target) < 0) {
@@ -277,20 +518,7 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id) {
     }
 
     // disentangle from queue
-    if (e->sibling) {
-        e->sibling->next = e->next;
-        if (e->sibling->next) {
-            e->sibling->next->ref = &e->sibling->next;
-        }
-
-        *e->ref = e->sibling;
-        e->sibling->ref = e->ref;
-    } else {
-        *e->ref = e->next;
-        if (e->next) {
-            e->next->ref = e->ref;
-        }
-    }
+    equeue_queue_unlink(e);
 
     equeue_incid(q, e);
     equeue_mutex_unlock(&q->queuelock);
@@ -341,6 +569,108 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target) {
 
     return head;
 }
+#endif
+
+// find the relative time until the earliest pending event,
+// -1 if nothing is pending, must be called with queuelock held
+static int equeue_next_diff(equeue_t *q, unsigned tick) {
+#ifdef EQUEUE_USE_TIMER_WHEEL
+    return equeue_wheel_next(q, tick);
+#else
+    if (q->queue) {
+        return equeue_clampdiff(q->queue->target, tick);
+    }
+    return -1;
+#endif
+}
+
+// find the next deadline across this queue and any chained queues
+static int equeue_chain_diff(equeue_t *q, unsigned tick) {
+    equeue_mutex_lock(&q->queuelock);
+    int diff = equeue_next_diff(q, tick);
+    equeue_mutex_unlock(&q->queuelock);
+
+    for (equeue_t *c = q->chain.children; c; c = c->chain.sibling) {
+        int cdiff = equeue_chain_diff(c, tick);
+        if (cdiff >= 0 && (diff < 0 || cdiff < diff)) {
+            diff = cdiff;
+        }
+    }
+    return diff;
+}
+
+// wake whichever dispatch loop is responsible for this queue,
+// reprogramming the root's wakeup timer if one is active
+static void equeue_signal(equeue_t *q) {
+    equeue_t *root = q;
+    while (root->chain.parent) {
+        root = root->chain.parent;
+    }
+
+    if (root != q && root->background.update && root->background.active) {
+        int next = equeue_chain_diff(root, equeue_tick());
+        equeue_mutex_lock(&root->queuelock);
+        if (root->background.update && next >= 0) {
+            root->background.update(root->background.timer, next);
+        }
+        equeue_mutex_unlock(&root->queuelock);
+    }
+
+    equeue_sema_signal(&root->eventsema);
+}
+
+// stable-partition a batch of expired events into priority lanes,
+// keeping deadline order within each lane
+static struct equeue_event *equeue_prio_sort(struct equeue_event *head) {
+    struct equeue_event *lanes[EQUEUE_PRIO_LANES];
+    struct equeue_event **tails[EQUEUE_PRIO_LANES];
+    for (unsigned i = 0; i < EQUEUE_PRIO_LANES; i++) {
+        lanes[i] = 0;
+        tails[i] = &lanes[i];
+    }
+
+    while (head) {
+        struct equeue_event *e = head;
+        head = head->next;
+        unsigned lane = (e->prio < EQUEUE_PRIO_LANES)
+                ? e->prio : EQUEUE_PRIO_LANES-1;
+        e->next = 0;
+        *tails[lane] = e;
+        tails[lane] = &e->next;
+    }
+
+    struct equeue_event *sorted = 0;
+    struct equeue_event **tail = &sorted;
+    for (unsigned i = 0; i < EQUEUE_PRIO_LANES; i++) {
+        if (lanes[i]) {
+            *tail = lanes[i];
+            tail = tails[i];
+        }
+    }
+    return sorted;
+}
+
+// merge two batches already ordered by (lane, deadline)
+static struct equeue_event *equeue_prio_merge(
+        struct equeue_event *a, struct equeue_event *b) {
+    struct equeue_event *head = 0;
+    struct equeue_event **tail = &head;
+    while (a && b) {
+        if (a->prio < b->prio ||
+            (a->prio == b->prio &&
+             equeue_tickdiff(a->target, b->target) <= 0)) {
+            *tail = a;
+            tail = &a->next;
+            a = a->next;
+        } else {
+            *tail = b;
+            tail = &b->next;
+            b = b->next;
+        }
+    }
+    *tail = a ? a : b;
+    return head;
+}
 
 int equeue_post(equeue_t *q, void (*cb)(void*), void *p) {
     struct equeue_event *e = (struct equeue_event*)p - 1;
@@ -349,7 +679,11 @@ int equeue_post(equeue_t *q, void (*cb)(void*), void *p) {
     e->target = tick + e->target;
 
     int id = equeue_enqueue(q, e, tick);
-    equeue_sema_signal(&q->eventsema);
+    if (e->prio == EQUEUE_PRIO_HIGH) {
+        // let an in-progress dispatch batch pick the event up between events
+        q->hipri_posted = 1;
+    }
+    equeue_signal(q);
     return id;
 }
 
@@ -364,11 +698,223 @@ void equeue_cancel(equeue_t *q, int id) {
     }
 }
 
+void equeue_fetch_stats(equeue_t *q, struct equeue_stats *stats) {
+#if EQUEUE_ENABLE_STATS
+    equeue_mutex_lock(&q->queuelock);
+    *stats = q->stats;
+    equeue_mutex_unlock(&q->queuelock);
+#else
+    memset(stats, 0, sizeof(struct equeue_stats));
+#endif
+}
+
+void equeue_reset_stats(equeue_t *q) {
+#if EQUEUE_ENABLE_STATS
+    equeue_mutex_lock(&q->queuelock);
+    q->stats.dispatched = 0;
+    q->stats.max_latency = 0;
+    q->stats.max_runtime = 0;
+    equeue_mutex_unlock(&q->queuelock);
+#endif
+}
+
+void equeue_post_user_allocated(equeue_t *q, void (*cb)(void*), void *p) {
+    struct equeue_event *e = (struct equeue_event*)p;
+    unsigned tick = equeue_tick();
+    e->size = 0;
+    e->id = 1;
+    e->cb = cb;
+    e->target = tick + e->target;
+
+    equeue_enqueue(q, e, tick);
+    equeue_signal(q);
+}
+
+void equeue_cancel_user_allocated(equeue_t *q, void *p) {
+    struct equeue_event *e = (struct equeue_event*)p;
+
+    equeue_mutex_lock(&q->queuelock);
+    if (!e->id) {
+        // already dispatched or never posted
+        equeue_mutex_unlock(&q->queuelock);
+        return;
+    }
+
+    // clear the event and check if already in-flight
+    e->cb = 0;
+    e->period = -1;
+
+    int diff = equeue_tickdiff(e->target, q->tick);
+    if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
+        equeue_mutex_unlock(&q->queuelock);
+        return;
+    }
+
+#ifdef EQUEUE_USE_TIMER_WHEEL
+    equeue_wheel_unlink(q, e);
+#else
+    equeue_queue_unlink(e);
+#endif
+    e->id = 0;
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+#if EQUEUE_IRQPOST_SLOTS
+int equeue_call_irq(equeue_t *q, void (*cb)(void *), void *data) {
+    // reserve a slot with a single compare-and-swap
+    uint32_t tail;
+    do {
+        tail = q->irqpost_tail;
+        if (tail - q->irqpost_head >= EQUEUE_IRQPOST_SLOTS) {
+            return -1;
+        }
+    } while (!equeue_atomic_cas_u32(&q->irqpost_tail, &tail, tail + 1));
+
+    struct equeue_irqpost *p = &q->irqposts[tail % EQUEUE_IRQPOST_SLOTS];
+    p->cb = cb;
+    p->data = data;
+    // publish after the payload is in place
+    p->ready = 1;
+
+    equeue_signal(q);
+    return 0;
+}
+
+// drain staged immediate posts, called from the dispatch loop only
+static void equeue_irqpost_drain(equeue_t *q) {
+    while (1) {
+        struct equeue_irqpost *p =
+                &q->irqposts[q->irqpost_head % EQUEUE_IRQPOST_SLOTS];
+        if (!p->ready) {
+            return;
+        }
+        void (*cb)(void *) = p->cb;
+        void *data = p->data;
+        p->ready = 0;
+        q->irqpost_head += 1;
+        cb(data);
+    }
+}
+#endif
+
+// execute a single expired event and retire it
+static void equeue_execute(equeue_t *q, struct equeue_event *e) {
+    // actually dispatch the callbacks
+    void (*cb)(void *) = e->cb;
+    if (cb) {
+#if EQUEUE_ENABLE_STATS
+        unsigned latency = (unsigned)equeue_clampdiff(
+                equeue_tick(), e->target);
+        if (latency > q->stats.max_latency) {
+            q->stats.max_latency = latency;
+        }
+        uint32_t start = equeue_cycles();
+#endif
+        cb(e + 1);
+#if EQUEUE_ENABLE_STATS
+        uint32_t runtime = equeue_cycles() - start;
+        if (runtime > q->stats.max_runtime) {
+            q->stats.max_runtime = runtime;
+        }
+        q->stats.dispatched += 1;
+#endif
+    }
+
+    // reenqueue periodic events or deallocate
+    if (e->period >= 0) {
+        e->target += e->period;
+        equeue_enqueue(q, e, equeue_tick());
+    } else if (e->size) {
+        equeue_incid(q, e);
+        equeue_dealloc(q, e+1);
+    } else {
+        // user-allocated storage is just marked idle, never freed
+        e->id = 0;
+    }
+}
+
+// move stealable events from a batch onto the shared ready list,
+// returning the events that must stay on the dispatch thread
+static struct equeue_event *equeue_share(equeue_t *q, struct equeue_event *es) {
+    struct equeue_event *serial = 0;
+    struct equeue_event **serial_tail = &serial;
+    int shared = 0;
+
+    equeue_mutex_lock(&q->queuelock);
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+        e->next = 0;
+
+        if (e->affinity == EQUEUE_AFFINITY_DISPATCHER) {
+            *serial_tail = e;
+            serial_tail = &e->next;
+        } else {
+            *q->ready_tail = e;
+            q->ready_tail = &e->next;
+            shared++;
+        }
+    }
+    equeue_mutex_unlock(&q->queuelock);
+
+    while (shared--) {
+        equeue_sema_signal(&q->workersema);
+    }
+    return serial;
+}
+
+// execute one event from the shared ready list
+static int equeue_steal(equeue_t *q) {
+    equeue_mutex_lock(&q->queuelock);
+    struct equeue_event *e = q->ready;
+    if (e) {
+        q->ready = e->next;
+        if (!q->ready) {
+            q->ready_tail = &q->ready;
+        }
+    }
+    equeue_mutex_unlock(&q->queuelock);
+
+    if (!e) {
+        return 0;
+    }
+
+    equeue_execute(q, e);
+    return 1;
+}
+
+void equeue_dispatch_worker(equeue_t *q) {
+    equeue_mutex_lock(&q->queuelock);
+    q->workers += 1;
+    equeue_mutex_unlock(&q->queuelock);
+
+    while (1) {
+        // drain the shared ready list
+        while (equeue_steal(q)) {
+        }
+
+        equeue_sema_wait(&q->workersema, -1);
+
+        // check if we were notified to break out of the worker loop
+        if (q->breaks) {
+            equeue_mutex_lock(&q->queuelock);
+            if (q->breaks > 0) {
+                q->breaks--;
+                q->workers -= 1;
+                equeue_mutex_unlock(&q->queuelock);
+                return;
+            }
+            equeue_mutex_unlock(&q->queuelock);
+        }
+    }
+}
+
 void equeue_break(equeue_t *q) {
     equeue_mutex_lock(&q->queuelock);
     q->breaks++;
     equeue_mutex_unlock(&q->queuelock);
     equeue_sema_signal(&q->eventsema);
+    equeue_sema_signal(&q->workersema);
 }
 
 void equeue_dispatch(equeue_t *q, int ms) {
@@ -377,28 +923,45 @@ void equeue_dispatch(equeue_t *q, int ms) {
     q->background.active = false;
 
     while (1) {
-        // collect all the available events and next deadline
-        struct equeue_event *es = equeue_dequeue(q, tick);
+#if EQUEUE_IRQPOST_SLOTS
+        // run events staged by the lock-free immediate post path first
+        equeue_irqpost_drain(q);
+#endif
+
+        // dispatch expired events from any chained queues
+        for (equeue_t *c = q->chain.children; c; c = c->chain.sibling) {
+            equeue_dispatch(c, 0);
+        }
+
+        // collect all the available events and next deadline,
+        // ordered by priority lane then deadline
+        struct equeue_event *es = equeue_prio_sort(equeue_dequeue(q, tick));
+
+        // offload stealable events to any worker threads
+        if (q->workers) {
+            es = equeue_share(q, es);
+        }
 
         // dispatch events
         while (es) {
+            // a high-priority post preempts iteration of lower lanes
+            if (q->hipri_posted) {
+                q->hipri_posted = 0;
+                es = equeue_prio_merge(es,
+                        equeue_prio_sort(equeue_dequeue(q, equeue_tick())));
+                if (q->workers) {
+                    es = equeue_share(q, es);
+                }
+            }
+
             struct equeue_event *e = es;
             es = e->next;
 
-            // actually dispatch the callbacks
-            void (*cb)(void *) = e->cb;
-            if (cb) {
-                cb(e + 1);
-            }
+            equeue_execute(q, e);
+        }
 
-            // reenqueue periodic events or deallocate
-            if (e->period >= 0) {
-                e->target += e->period;
-                equeue_enqueue(q, e, equeue_tick());
-            } else {
-                equeue_incid(q, e);
-                equeue_dealloc(q, e+1);
-            }
+        // help the workers drain the shared ready list before sleeping
+        while (q->ready && equeue_steal(q)) {
         }
 
         int deadline = -1;
@@ -410,10 +973,10 @@ void equeue_dispatch(equeue_t *q, int ms) {
             if (deadline <= 0) {
                 // update background timer if necessary
                 if (q->background.update) {
+                    int next = equeue_chain_diff(q, tick);
                     equeue_mutex_lock(&q->queuelock);
-                    if (q->background.update && q->queue) {
-                        q->background.update(q->background.timer,
-                                equeue_clampdiff(q->queue->target, tick));
+                    if (q->background.update && next >= 0) {
+                        q->background.update(q->background.timer, next);
                     }
                     q->background.active = true;
                     equeue_mutex_unlock(&q->queuelock);
@@ -422,15 +985,11 @@ void equeue_dispatch(equeue_t *q, int ms) {
             }
         }
 
-        // find closest deadline
-        equeue_mutex_lock(&q->queuelock);
-        if (q->queue) {
-            int diff = equeue_clampdiff(q->queue->target, tick);
-            if ((unsigned)diff < (unsigned)deadline) {
-                deadline = diff;
-            }
+        // find closest deadline across this queue and any chained queues
+        int diff = equeue_chain_diff(q, tick);
+        if (diff >= 0 && (unsigned)diff < (unsigned)deadline) {
+            deadline = diff;
         }
-        equeue_mutex_unlock(&q->queuelock);
 
         // wait for events
         equeue_sema_wait(&q->eventsema, deadline);
@@ -468,6 +1027,23 @@ void equeue_event_dtor(void *p, void (*dtor)(void *)) {
     e->dtor = dtor;
 }
 
+void equeue_event_prio(void *p, int prio) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    e->prio = (prio < 0) ? 0 :
+            (prio >= EQUEUE_PRIO_LANES) ? EQUEUE_PRIO_LANES-1 : prio;
+}
+
+void equeue_event_affinity(void *p, int affinity) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    e->affinity = (affinity == EQUEUE_AFFINITY_DISPATCHER)
+            ? EQUEUE_AFFINITY_DISPATCHER : EQUEUE_AFFINITY_ANY;
+}
+
+void equeue_event_slack(void *p, int ms) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    e->slack = ms;
+}
+
 
 // simple callbacks 
 struct ecallback {
@@ -520,6 +1096,7 @@ int equeue_call_every(equeue_t *q, int ms, void (*cb)(void*), void *data) {
 // backgrounding
 void equeue_background(equeue_t *q,
         void (*update)(void *timer, int ms), void *timer) {
+    int next = equeue_chain_diff(q, equeue_tick());
     equeue_mutex_lock(&q->queuelock);
     if (q->background.update) {
         q->background.update(q->background.timer, -1);
@@ -528,47 +1105,40 @@ void equeue_background(equeue_t *q,
     q->background.update = update;
     q->background.timer = timer;
 
-    if (q->background.update && q->queue) {
-        q->background.update(q->background.timer,
-                equeue_clampdiff(q->queue->target, equeue_tick()));
+    if (q->background.update && next >= 0) {
+        q->background.update(q->background.timer, next);
     }
     q->background.active = true;
     equeue_mutex_unlock(&q->queuelock);
 }
 
-struct equeue_chain_context {
-    equeue_t *q;
-    equeue_t *target;
-    int id;
-};
-
-static void equeue_chain_dispatch(void *p) {
-    equeue_dispatch((equeue_t *)p, 0);
-}
-
-static void equeue_chain_update(void *p, int ms) {
-    struct equeue_chain_context *c = (struct equeue_chain_context *)p;
-    equeue_cancel(c->target, c->id);
-
-    if (ms >= 0) {
-        c->id = equeue_call_in(c->target, ms, equeue_chain_dispatch, c->q);
-    } else {
-        equeue_dealloc(c->target, c);
+void equeue_chain(equeue_t *q, equeue_t *target) {
+    // unlink from the old parent
+    equeue_t *parent = q->chain.parent;
+    if (parent) {
+        equeue_mutex_lock(&parent->queuelock);
+        for (equeue_t **p = &parent->chain.children; *p;
+                p = &(*p)->chain.sibling) {
+            if (*p == q) {
+                *p = q->chain.sibling;
+                break;
+            }
+        }
+        equeue_mutex_unlock(&parent->queuelock);
+        q->chain.parent = 0;
+        q->chain.sibling = 0;
     }
-}
 
-void equeue_chain(equeue_t *q, equeue_t *target) {
     if (!target) {
-        equeue_background(q, 0, 0);
         return;
     }
 
-    struct equeue_chain_context *c = equeue_alloc(q,
-            sizeof(struct equeue_chain_context));
-
-    c->q = q;
-    c->target = target;
-    c->id = 0;
+    equeue_mutex_lock(&target->queuelock);
+    q->chain.parent = target;
+    q->chain.sibling = target->chain.children;
+    target->chain.children = q;
+    equeue_mutex_unlock(&target->queuelock);
 
-    equeue_background(q, equeue_chain_update, c);
+    // wake the chain's dispatch loop so it picks up our deadlines
+    equeue_signal(q);
 }
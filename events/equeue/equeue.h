@@ -36,11 +36,45 @@ extern "C" {
 // This size is guaranteed to fit events created by event_call
 #define EQUEUE_EVENT_SIZE (sizeof(struct equeue_event) + 2*sizeof(void*))
 
+// Timer-wheel backend
+//
+// When EQUEUE_USE_TIMER_WHEEL is defined, pending events are kept in a
+// timer wheel of EQUEUE_WHEEL_SLOTS unsorted buckets instead of a sorted
+// linked list. Posting and cancelling become O(1) regardless of how many
+// events are pending, at the cost of an O(pending) scan when the
+// dispatch loop looks for its next deadline. This trades in favour of
+// queues with hundreds of pending events where sorted insertion on every
+// post dominates.
+#ifdef EQUEUE_USE_TIMER_WHEEL
+#ifndef EQUEUE_WHEEL_SLOTS
+#define EQUEUE_WHEEL_SLOTS 32
+#endif
+#endif
+
+// Number of priority lanes honored by equeue_dispatch. Lane 0 is the
+// highest priority; events default to EQUEUE_PRIO_NORMAL.
+#ifndef EQUEUE_PRIO_LANES
+#define EQUEUE_PRIO_LANES 4
+#endif
+
+#define EQUEUE_PRIO_HIGH   0
+#define EQUEUE_PRIO_NORMAL 1
+#define EQUEUE_PRIO_LOW    (EQUEUE_PRIO_LANES-1)
+
+// Affinity of an event when worker threads assist the dispatch loop.
+// EQUEUE_AFFINITY_ANY events may run on any worker thread,
+// EQUEUE_AFFINITY_DISPATCHER events only run on the thread calling
+// equeue_dispatch, serializing them against each other.
+#define EQUEUE_AFFINITY_ANY        0
+#define EQUEUE_AFFINITY_DISPATCHER 1
+
 // Internal event structure
 struct equeue_event {
     unsigned size;
     uint8_t id;
     uint8_t generation;
+    uint8_t prio;
+    uint8_t affinity;
 
     struct equeue_event *next;
     struct equeue_event *sibling;
@@ -48,18 +82,58 @@ struct equeue_event {
 
     unsigned target;
     int period;
+    int slack;
     void (*dtor)(void *);
 
     void (*cb)(void *);
     // data follows
 };
 
+// Number of slots in the lock-free immediate post ring used by
+// equeue_call_irq. Define to 0 to compile the ring out entirely.
+#ifndef EQUEUE_IRQPOST_SLOTS
+#define EQUEUE_IRQPOST_SLOTS 16
+#endif
+
+#if EQUEUE_IRQPOST_SLOTS
+// One staged immediate post
+struct equeue_irqpost {
+    void (*cb)(void *);
+    void *data;
+    volatile uint32_t ready;
+};
+#endif
+
+// Dispatch statistics
+//
+// When EQUEUE_ENABLE_STATS is nonzero (the default), the dispatch loop
+// records per-event queue-to-dispatch latency, handler runtime, and the
+// slab allocator's high-water mark. The bookkeeping costs two reads of
+// the platform cycle counter and a couple of compares per event, cheap
+// enough to leave enabled in production builds. Define
+// EQUEUE_ENABLE_STATS to 0 to compile the bookkeeping out entirely.
+#ifndef EQUEUE_ENABLE_STATS
+#define EQUEUE_ENABLE_STATS 1
+#endif
+
+struct equeue_stats {
+    unsigned dispatched;    // events executed since the last reset
+    unsigned max_latency;   // worst queue-to-dispatch latency in milliseconds
+    unsigned max_runtime;   // longest handler runtime in equeue_cycles units
+    size_t slab_highwater;  // most bytes ever carved from the event slab
+};
+
 // Event queue structure
 typedef struct equeue {
     struct equeue_event *queue;
+#ifdef EQUEUE_USE_TIMER_WHEEL
+    struct equeue_event *wheel[EQUEUE_WHEEL_SLOTS];
+    struct equeue_event **wheel_tail[EQUEUE_WHEEL_SLOTS];
+#endif
     unsigned tick;
     unsigned breaks;
     uint8_t generation;
+    volatile uint8_t hipri_posted;
 
     unsigned char *buffer;
     unsigned npw2;
@@ -77,6 +151,27 @@ typedef struct equeue {
         void *timer;
     } background;
 
+    struct equeue_chain {
+        struct equeue *parent;
+        struct equeue *children;
+        struct equeue *sibling;
+    } chain;
+
+    struct equeue_event *ready;
+    struct equeue_event **ready_tail;
+    volatile uint32_t workers;
+    equeue_sema_t workersema;
+
+#if EQUEUE_IRQPOST_SLOTS
+    struct equeue_irqpost irqposts[EQUEUE_IRQPOST_SLOTS];
+    volatile uint32_t irqpost_head;
+    volatile uint32_t irqpost_tail;
+#endif
+
+#if EQUEUE_ENABLE_STATS
+    struct equeue_stats stats;
+#endif
+
     equeue_sema_t eventsema;
     equeue_mutex_t queuelock;
     equeue_mutex_t memlock;
@@ -110,8 +205,26 @@ void equeue_dispatch(equeue_t *queue, int ms);
 //
 // Forces the specified event queue's dispatch loop to terminate. Pending
 // events may finish executing, but no new events will be executed.
+//
+// Each call to equeue_break terminates a single loop, either a dispatch
+// loop or a worker loop. To stop a queue dispatched by one equeue_dispatch
+// and N equeue_dispatch_worker threads, call equeue_break N+1 times.
 void equeue_break(equeue_t *queue);
 
+// Assist a running dispatch loop from another thread
+//
+// Executes events alongside equeue_dispatch until equeue_break is called
+// on this queue. While at least one worker is running, the dispatch loop
+// shares each batch of expired events: events with EQUEUE_AFFINITY_ANY
+// (the default) are executed by whichever thread is idle first, scaling
+// dispatch throughput so one slow event no longer stalls unrelated ones.
+// Events marked EQUEUE_AFFINITY_DISPATCHER stay on the dispatching
+// thread and remain serialized against each other.
+//
+// Timing bookkeeping stays with equeue_dispatch; equeue_dispatch_worker
+// only ever sleeps waiting for events to be shared with it.
+void equeue_dispatch_worker(equeue_t *queue);
+
 // Simple event calls
 //
 // The specified callback will be executed in the context of the event queue's
@@ -131,6 +244,19 @@ int equeue_call(equeue_t *queue, void (*cb)(void *), void *data);
 int equeue_call_in(equeue_t *queue, int ms, void (*cb)(void *), void *data);
 int equeue_call_every(equeue_t *queue, int ms, void (*cb)(void *), void *data);
 
+// Lock-free immediate event call
+//
+// Posts an immediate event without touching the queue's mutexes or the
+// allocator: the callback and argument are staged with a single atomic
+// compare-and-swap into a bounded ring of EQUEUE_IRQPOST_SLOTS entries
+// which the dispatch loop drains ahead of the timed queue. Posting
+// completes in a handful of cycles and never blocks dispatch, making it
+// suitable for hot interrupt handlers sharing a queue with threads.
+//
+// Events posted this way cannot be delayed, made periodic, or cancelled.
+// Returns 0 on success or -1 if the ring is full.
+int equeue_call_irq(equeue_t *queue, void (*cb)(void *), void *data);
+
 // Allocate memory for events
 //
 // The equeue_alloc function allocates an event that can be manually dispatched
@@ -156,9 +282,26 @@ void equeue_dealloc(equeue_t *queue, void *event);
 // equeue_event_delay  - Millisecond delay before dispatching an event
 // equeue_event_period - Millisecond period for repeating dispatching an event
 // equeue_event_dtor   - Destructor to run when the event is deallocated
+// equeue_event_prio   - Priority lane for the event, 0 (EQUEUE_PRIO_HIGH)
+//                       runs first; expired events are dispatched lane by
+//                       lane, and an immediate high-priority post preempts
+//                       iteration of lower lanes between events
+// equeue_event_affinity - Which threads may execute the event when worker
+//                       threads assist dispatch, EQUEUE_AFFINITY_ANY or
+//                       EQUEUE_AFFINITY_DISPATCHER
+// equeue_event_slack  - Millisecond coalescing window for the event's
+//                       deadline. On every post or periodic reschedule the
+//                       deadline is aligned with an already-pending wakeup
+//                       up to slack ms later if one exists, letting
+//                       periodic events with interleaving periods share
+//                       timer interrupts instead of each waking the
+//                       processor separately
 void equeue_event_delay(void *event, int ms);
 void equeue_event_period(void *event, int ms);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
+void equeue_event_prio(void *event, int prio);
+void equeue_event_affinity(void *event, int affinity);
+void equeue_event_slack(void *event, int ms);
 
 // Post an event onto the event queue
 //
@@ -187,6 +330,42 @@ int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 // the event may have already begun executing.
 void equeue_cancel(equeue_t *queue, int id);
 
+// Post a user-allocated event onto the event queue
+//
+// The event storage is owned by the caller and must begin with a
+// struct equeue_event header followed by the callback's argument. The
+// header's target/period fields may be configured with equeue_event_delay
+// and equeue_event_period before posting, passing a pointer to the memory
+// just past the header. Because no allocation takes place, posting cannot
+// fail and completes in constant time.
+//
+// The storage must remain valid until the event has been dispatched or
+// cancelled, and must not be reposted while still pending.
+//
+// The equeue_post_user_allocated function is irq safe.
+void equeue_post_user_allocated(equeue_t *queue, void (*cb)(void *), void *event);
+
+// Cancel an in-flight user-allocated event
+//
+// Attempts to cancel an event posted with equeue_post_user_allocated. It is
+// safe to call after the event has already been dispatched. As with
+// equeue_cancel, an event that has begun executing cannot be recalled.
+//
+// The equeue_cancel_user_allocated function is irq safe.
+void equeue_cancel_user_allocated(equeue_t *queue, void *event);
+
+// Read or reset the queue's dispatch statistics
+//
+// equeue_fetch_stats copies a snapshot of the counters into the provided
+// structure, or zeros it when EQUEUE_ENABLE_STATS is 0. equeue_reset_stats
+// clears the dispatch count and the latency and runtime maximums; the slab
+// high-water mark reflects the buffer's lifetime usage and persists across
+// resets.
+//
+// Both functions are irq safe.
+void equeue_fetch_stats(equeue_t *queue, struct equeue_stats *stats);
+void equeue_reset_stats(equeue_t *queue);
+
 // Background an event queue onto a single-shot timer
 //
 // The provided update function will be called to indicate when the queue
@@ -207,8 +386,17 @@ void equeue_background(equeue_t *queue,
 // target queue will also dispatch events from this queue. The queues
 // use their own buffers and events must be managed independently.
 //
+// Chained queues share a single wakeup: the target's dispatch loop merges
+// the next-deadline computation across the whole chain, sleeping until the
+// earliest deadline of any chained queue instead of bouncing timer events
+// between queues. Posting to a chained queue wakes the root dispatch loop
+// directly and reprograms the root's background timer if one is active.
+//
 // Passing a null queue as the target will unchain the existing queue.
 //
+// Queues must not be chained or unchained while the target is actively
+// dispatching.
+//
 // The equeue_chain function allows multiple equeues to be composed, sharing
 // the context of a dispatch loop while still being managed independently.
 void equeue_chain(equeue_t *queue, equeue_t *target);
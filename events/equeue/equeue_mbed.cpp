@@ -69,6 +69,21 @@ unsigned equeue_tick() {
 }
 
 
+// Cycle counter operations
+uint32_t equeue_cycles(void) {
+#if defined(DWT) && defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+#else
+    return us_ticker_read();
+#endif
+}
+
+
 // Mutex operations
 int equeue_mutex_create(equeue_mutex_t *m) { return 0; }
 void equeue_mutex_destroy(equeue_mutex_t *m) { }
@@ -155,4 +170,11 @@ bool equeue_sema_wait(equeue_sema_t *s, int ms) {
 
 #endif
 
+
+// Atomics
+bool equeue_atomic_cas_u32(volatile uint32_t *ptr,
+        uint32_t *expected, uint32_t desired) {
+    return core_util_atomic_cas_u32((uint32_t *)ptr, expected, desired);
+}
+
 #endif
@@ -26,6 +26,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stdint.h>
 
 // Currently supported platforms
 //
@@ -143,6 +144,26 @@ void equeue_sema_signal(equeue_sema_t *sema);
 bool equeue_sema_wait(equeue_sema_t *sema, int ms);
 
 
+// Platform cycle counter
+//
+// Return a free-running high-resolution counter for profiling handler
+// runtime. The unit is platform specific (processor cycles where a cycle
+// counter such as the Cortex-M DWT is available, microseconds otherwise)
+// and the counter is expected to wrap. Used by the optional dispatch
+// statistics; must be cheap enough to read around every handler.
+uint32_t equeue_cycles(void);
+
+
+// Platform atomic compare-and-swap
+//
+// Atomically compares *ptr with *expected and, if they match, stores
+// desired in *ptr and returns true. Otherwise loads the current value
+// into *expected and returns false. Used by the lock-free immediate
+// post path; must be safe in interrupt contexts.
+bool equeue_atomic_cas_u32(volatile uint32_t *ptr,
+        uint32_t *expected, uint32_t desired);
+
+
 #ifdef __cplusplus
 }
 #endif
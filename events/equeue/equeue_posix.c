@@ -32,6 +32,14 @@ unsigned equeue_tick(void) {
 }
 
 
+// Cycle counter operations
+uint32_t equeue_cycles(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec*1000000 + ts.tv_nsec/1000);
+}
+
+
 // Mutex operations
 int equeue_mutex_create(equeue_mutex_t *m) {
     return pthread_mutex_init(m, 0);
@@ -103,4 +111,16 @@ bool equeue_sema_wait(equeue_sema_t *s, int ms) {
     return signal;
 }
 
+
+// Atomics
+bool equeue_atomic_cas_u32(volatile uint32_t *ptr,
+        uint32_t *expected, uint32_t desired) {
+    uint32_t current = __sync_val_compare_and_swap(ptr, *expected, desired);
+    if (current == *expected) {
+        return true;
+    }
+    *expected = current;
+    return false;
+}
+
 #endif
@@ -0,0 +1,285 @@
+/*
+ * Benchmark harness for the events library
+ *
+ * Measures the performance characteristics the profiler cannot: how the
+ * sorted insert scales with the number of pending events, what the slab
+ * allocator does as it runs out, and how posting throughput behaves when
+ * several threads contend on one queue through the posix port. Results
+ * are emitted as CSV on stdout (scenario,param,metric,value) so runs can
+ * be diffed or plotted before burning on-target cycles.
+ *
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "equeue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <time.h>
+
+
+// Timing utils
+static uint64_t bench_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_row(const char *scenario, int param,
+        const char *metric, uint64_t value) {
+    printf("%s,%d,%s,%"PRIu64"\n", scenario, param, metric, value);
+    fflush(stdout);
+}
+
+// Various test functions
+static void no_func(void *eh) {
+    (void)eh;
+}
+
+static void count_func(void *c) {
+    __sync_fetch_and_add((long *)c, 1);
+}
+
+
+// Sorted-insert scaling
+//
+// Posts delayed events into a queue that already holds `pending` events
+// with delays spread over the same range, so each post lands somewhere
+// in the middle of the sorted structure. The cost per post is what grows
+// linearly with the sorted linked list and is what a timer-wheel build
+// should flatten.
+#define INSERT_ITERATIONS 2000
+
+static void bench_insert_scaling(int pending) {
+    struct equeue q;
+    equeue_create(&q, (pending+2)*EQUEUE_EVENT_SIZE);
+
+    srand(42);
+    for (int i = 0; i < pending; i++) {
+        equeue_call_in(&q, rand() % 1000, no_func, 0);
+    }
+
+    uint64_t accum = 0;
+    for (int i = 0; i < INSERT_ITERATIONS; i++) {
+        void *e = equeue_alloc(&q, 0);
+        equeue_event_delay(e, rand() % 1000);
+
+        uint64_t start = bench_ns();
+        int id = equeue_post(&q, no_func, e);
+        accum += bench_ns() - start;
+
+        equeue_cancel(&q, id);
+    }
+    bench_row("insert_scaling", pending, "post_delayed_ns",
+            accum / INSERT_ITERATIONS);
+
+    accum = 0;
+    for (int i = 0; i < INSERT_ITERATIONS; i++) {
+        void *e = equeue_alloc(&q, 0);
+
+        uint64_t start = bench_ns();
+        int id = equeue_post(&q, no_func, e);
+        accum += bench_ns() - start;
+
+        equeue_cancel(&q, id);
+    }
+    bench_row("insert_scaling", pending, "post_now_ns",
+            accum / INSERT_ITERATIONS);
+
+    equeue_destroy(&q);
+}
+
+// Slab exhaustion
+//
+// Allocates events until the slab refuses, recording how the alloc cost
+// changes between a fresh slab, a nearly full one, and the failure path,
+// and how a fully recycled slab compares against the initial carve-up.
+static void bench_slab_exhaustion(int count) {
+    struct equeue q;
+    equeue_create(&q, count*EQUEUE_EVENT_SIZE);
+
+    void **es = malloc(count * sizeof(void *));
+    uint64_t fresh = 0, full = 0;
+    int n = 0;
+
+    while (true) {
+        uint64_t start = bench_ns();
+        void *e = equeue_alloc(&q, 2*sizeof(void *));
+        uint64_t t = bench_ns() - start;
+
+        if (!e) {
+            break;
+        }
+        if (n < count/4) {
+            fresh += t;
+        } else if (n >= 3*(count/4)) {
+            full += t;
+        }
+        es[n++] = e;
+    }
+    bench_row("slab_exhaustion", count, "capacity", n);
+    bench_row("slab_exhaustion", count, "alloc_fresh_ns", fresh / (count/4));
+    bench_row("slab_exhaustion", count, "alloc_full_ns",
+            full / (n - 3*(count/4)));
+
+    uint64_t fail = 0;
+    for (int i = 0; i < INSERT_ITERATIONS; i++) {
+        uint64_t start = bench_ns();
+        void *e = equeue_alloc(&q, 2*sizeof(void *));
+        fail += bench_ns() - start;
+        if (e) {
+            equeue_dealloc(&q, e);
+        }
+    }
+    bench_row("slab_exhaustion", count, "alloc_fail_ns",
+            fail / INSERT_ITERATIONS);
+
+    // recycle the whole slab through the freelist and carve it up again
+    for (int i = 0; i < n; i++) {
+        equeue_dealloc(&q, es[i]);
+    }
+
+    uint64_t reused = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t start = bench_ns();
+        es[i] = equeue_alloc(&q, 2*sizeof(void *));
+        reused += bench_ns() - start;
+    }
+    bench_row("slab_exhaustion", count, "alloc_reused_ns", reused / n);
+
+    free(es);
+    equeue_destroy(&q);
+}
+
+// Post/dispatch contention
+//
+// A fixed number of events is split across `nposters` threads posting as
+// fast as the slab allows while one dispatch loop (optionally assisted
+// by worker threads) drains the queue. Throughput is end-to-end: from
+// the first post until the last event has been dispatched. Retries count
+// the posts that failed because the dispatcher fell behind the slab.
+#define CONTENTION_EVENTS 200000
+
+struct bench_poster {
+    struct equeue *q;
+    long count;
+    long retries;
+    volatile long *dispatched;
+};
+
+static void *bench_poster_thread(void *p) {
+    struct bench_poster *poster = (struct bench_poster *)p;
+
+    for (long i = 0; i < poster->count; i++) {
+        while (!equeue_call(poster->q, count_func,
+                (void *)poster->dispatched)) {
+            poster->retries++;
+            sched_yield();
+        }
+    }
+
+    return 0;
+}
+
+static void *bench_dispatch_thread(void *p) {
+    equeue_dispatch((struct equeue *)p, -1);
+    return 0;
+}
+
+static void *bench_worker_thread(void *p) {
+    equeue_dispatch_worker((struct equeue *)p);
+    return 0;
+}
+
+static void bench_contention(const char *scenario,
+        int param, int nposters, int nworkers) {
+    struct equeue q;
+    equeue_create(&q, 1024*EQUEUE_EVENT_SIZE);
+
+    volatile long dispatched = 0;
+    struct bench_poster posters[16];
+    pthread_t poster_threads[16];
+    pthread_t worker_threads[16];
+    pthread_t dispatcher;
+
+    uint64_t start = bench_ns();
+
+    pthread_create(&dispatcher, 0, bench_dispatch_thread, &q);
+    for (int i = 0; i < nworkers; i++) {
+        pthread_create(&worker_threads[i], 0, bench_worker_thread, &q);
+    }
+
+    for (int i = 0; i < nposters; i++) {
+        posters[i].q = &q;
+        posters[i].count = CONTENTION_EVENTS / nposters;
+        posters[i].retries = 0;
+        posters[i].dispatched = &dispatched;
+        pthread_create(&poster_threads[i], 0, bench_poster_thread,
+                &posters[i]);
+    }
+
+    long total = nposters * (CONTENTION_EVENTS / nposters);
+    long retries = 0;
+    for (int i = 0; i < nposters; i++) {
+        pthread_join(poster_threads[i], 0);
+        retries += posters[i].retries;
+    }
+    while (dispatched < total) {
+        sched_yield();
+    }
+
+    uint64_t elapsed = bench_ns() - start;
+
+    for (int i = 0; i < nworkers+1; i++) {
+        equeue_break(&q);
+    }
+    pthread_join(dispatcher, 0);
+    for (int i = 0; i < nworkers; i++) {
+        pthread_join(worker_threads[i], 0);
+    }
+
+    bench_row(scenario, param, "throughput_eps",
+            total*1000000000ull / elapsed);
+    bench_row(scenario, param, "post_retries", retries);
+
+    equeue_destroy(&q);
+}
+
+
+// Entry point
+int main(void) {
+    printf("scenario,param,metric,value\n");
+
+    int pendings[] = {10, 30, 100, 300, 1000, 3000, 10000};
+    for (unsigned i = 0; i < sizeof(pendings)/sizeof(pendings[0]); i++) {
+        bench_insert_scaling(pendings[i]);
+    }
+
+    bench_slab_exhaustion(1000);
+
+    int nposters[] = {1, 2, 4, 8};
+    for (unsigned i = 0; i < sizeof(nposters)/sizeof(nposters[0]); i++) {
+        bench_contention("contention", nposters[i], nposters[i], 0);
+    }
+
+    int nworkers[] = {0, 1, 3};
+    for (unsigned i = 0; i < sizeof(nworkers)/sizeof(nworkers[0]); i++) {
+        bench_contention("worker_scaling", nworkers[i], 2, nworkers[i]);
+    }
+
+    return 0;
+}
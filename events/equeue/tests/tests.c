@@ -73,6 +73,17 @@ void indirect_func(void *p) {
     (*i->touched)++;
 }
 
+struct order {
+    int *count;
+    int *log;
+    int value;
+};
+
+void order_func(void *p) {
+    struct order *order = (struct order *)p;
+    order->log[(*order->count)++] = order->value;
+}
+
 struct timing {
     unsigned tick;
     unsigned delay;
@@ -196,6 +207,151 @@ void simple_post_test(void) {
     equeue_destroy(&q);
 }
 
+void simple_call_irq_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // staged posts run in fifo order, ahead of the timed queue
+    int count = 0;
+    int log[5];
+    struct order orders[5];
+    for (int i = 0; i < 4; i++) {
+        orders[i] = (struct order){&count, log, i};
+        err = equeue_call_irq(&q, order_func, &orders[i]);
+        test_assert(!err);
+    }
+
+    orders[4] = (struct order){&count, log, 4};
+    int id = equeue_call(&q, order_func, &orders[4]);
+    test_assert(id);
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == 5);
+    for (int i = 0; i < 4; i++) {
+        test_assert(log[i] == i);
+    }
+    test_assert(log[4] == 4);
+
+    equeue_destroy(&q);
+}
+
+void call_irq_overflow_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    for (int i = 0; i < EQUEUE_IRQPOST_SLOTS; i++) {
+        err = equeue_call_irq(&q, simple_func, &touched);
+        test_assert(!err);
+    }
+
+    // the ring is bounded, a full ring reports failure instead of blocking
+    err = equeue_call_irq(&q, simple_func, &touched);
+    test_assert(err == -1);
+
+    equeue_dispatch(&q, 0);
+    test_assert(touched == EQUEUE_IRQPOST_SLOTS);
+
+    // slots are reusable once the dispatch loop has drained them
+    err = equeue_call_irq(&q, simple_func, &touched);
+    test_assert(!err);
+
+    equeue_dispatch(&q, 0);
+    test_assert(touched == EQUEUE_IRQPOST_SLOTS+1);
+
+    equeue_destroy(&q);
+}
+
+// Priority lane tests
+void prio_order_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // expired events run lane by lane, fifo within a lane, regardless of
+    // posting order
+    int prios[6] = {
+        EQUEUE_PRIO_LOW, EQUEUE_PRIO_HIGH, EQUEUE_PRIO_NORMAL,
+        EQUEUE_PRIO_HIGH, EQUEUE_PRIO_LOW, EQUEUE_PRIO_NORMAL,
+    };
+    int count = 0;
+    int log[6];
+
+    for (int i = 0; i < 6; i++) {
+        struct order *o = equeue_alloc(&q, sizeof(struct order));
+        test_assert(o);
+        *o = (struct order){&count, log, i};
+        equeue_event_prio(o, prios[i]);
+        int id = equeue_post(&q, order_func, o);
+        test_assert(id);
+    }
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == 6);
+    int expected[6] = {1, 3, 2, 5, 0, 4};
+    for (int i = 0; i < 6; i++) {
+        test_assert(log[i] == expected[i]);
+    }
+
+    equeue_destroy(&q);
+}
+
+struct hipri {
+    equeue_t *q;
+    struct order order;
+    struct order high;
+};
+
+void hipri_func(void *p) {
+    struct hipri *hipri = (struct hipri *)p;
+    order_func(&hipri->order);
+
+    struct order *o = equeue_alloc(hipri->q, sizeof(struct order));
+    test_assert(o);
+    *o = hipri->high;
+    equeue_event_prio(o, EQUEUE_PRIO_HIGH);
+    int id = equeue_post(hipri->q, order_func, o);
+    test_assert(id);
+}
+
+void prio_preempt_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // a high-priority post from inside an event preempts iteration of the
+    // already-collected lower lanes
+    int count = 0;
+    int log[4];
+
+    struct hipri *hipri = equeue_alloc(&q, sizeof(struct hipri));
+    test_assert(hipri);
+    hipri->q = &q;
+    hipri->order = (struct order){&count, log, 0};
+    hipri->high = (struct order){&count, log, 9};
+    int id = equeue_post(&q, hipri_func, hipri);
+    test_assert(id);
+
+    for (int i = 1; i < 3; i++) {
+        struct order *o = equeue_alloc(&q, sizeof(struct order));
+        test_assert(o);
+        *o = (struct order){&count, log, i};
+        id = equeue_post(&q, order_func, o);
+        test_assert(id);
+    }
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == 4);
+    int expected[4] = {0, 9, 1, 2};
+    for (int i = 0; i < 4; i++) {
+        test_assert(log[i] == expected[i]);
+    }
+
+    equeue_destroy(&q);
+}
+
 // Misc tests
 void destructor_test(void) {
     equeue_t q;
@@ -595,6 +751,258 @@ void unchain_test(void) {
     equeue_destroy(&q2);
 }
 
+void chain_background_test(void) {
+    equeue_t q1;
+    int err = equeue_create(&q1, 2048);
+    test_assert(!err);
+
+    equeue_t q2;
+    err = equeue_create(&q2, 2048);
+    test_assert(!err);
+
+    equeue_chain(&q2, &q1);
+
+    // the root's background timer reflects the earliest deadline across
+    // the whole chain, even when it lives in a chained queue
+    int id = equeue_call_in(&q2, 20, pass_func, 0);
+    test_assert(id);
+
+    unsigned ms;
+    equeue_background(&q1, background_func, &ms);
+    test_assert(ms == 20);
+
+    // posting to a chained queue reprograms the root's timer directly
+    id = equeue_call_in(&q2, 10, pass_func, 0);
+    test_assert(id);
+    test_assert(ms == 10);
+
+    id = equeue_call_in(&q1, 5, pass_func, 0);
+    test_assert(id);
+    test_assert(ms == 5);
+
+    equeue_destroy(&q1);
+    test_assert(ms == -1);
+    equeue_destroy(&q2);
+}
+
+void chain_wakeup_test(void) {
+    equeue_t q1;
+    int err = equeue_create(&q1, 2048);
+    test_assert(!err);
+
+    equeue_t q2;
+    err = equeue_create(&q2, 2048);
+    test_assert(!err);
+
+    equeue_chain(&q2, &q1);
+
+    // an indefinite dispatch of the root only ever wakes on a signal, so
+    // this checks that posting to a chained queue wakes the root's loop
+    // instead of waiting on a bounced timer event
+    pthread_t thread;
+    err = pthread_create(&thread, 0, multithread_thread, &q1);
+    test_assert(!err);
+
+    usleep(10000);
+    int touched = 0;
+    equeue_call(&q2, simple_func, &touched);
+    usleep(50000);
+    test_assert(touched == 1);
+
+    equeue_break(&q1);
+    err = pthread_join(thread, 0);
+    test_assert(!err);
+
+    equeue_destroy(&q1);
+    equeue_destroy(&q2);
+}
+
+// Deadline coalescing tests
+void slack_coalesce_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int id = equeue_call_in(&q, 20, pass_func, 0);
+    test_assert(id);
+
+    unsigned ms;
+    equeue_background(&q, background_func, &ms);
+    test_assert(ms == 20);
+
+    // a slack-tolerant deadline aligns with the pending wakeup instead of
+    // programming an earlier one
+    void *e = equeue_alloc(&q, 0);
+    test_assert(e);
+    equeue_event_delay(e, 12);
+    equeue_event_slack(e, 10);
+    id = equeue_post(&q, pass_func, e);
+    test_assert(id);
+    test_assert(ms == 20);
+
+    // a deadline with no pending wakeup within its slack stays put
+    e = equeue_alloc(&q, 0);
+    test_assert(e);
+    equeue_event_delay(e, 5);
+    equeue_event_slack(e, 3);
+    id = equeue_post(&q, pass_func, e);
+    test_assert(id);
+    test_assert(ms == 5);
+
+    equeue_dispatch(&q, 30);
+
+    equeue_destroy(&q);
+    test_assert(ms == -1);
+}
+
+struct stamp {
+    unsigned *out;
+};
+
+void stamp_func(void *p) {
+    struct stamp *stamp = (struct stamp *)p;
+    *stamp->out = equeue_tick();
+}
+
+void slack_together_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    unsigned ta = 0;
+    unsigned tb = 0;
+    unsigned base = equeue_tick();
+
+    struct stamp *a = equeue_alloc(&q, sizeof(struct stamp));
+    test_assert(a);
+    a->out = &ta;
+    equeue_event_delay(a, 20);
+    int id = equeue_post(&q, stamp_func, a);
+    test_assert(id);
+
+    struct stamp *b = equeue_alloc(&q, sizeof(struct stamp));
+    test_assert(b);
+    b->out = &tb;
+    equeue_event_delay(b, 12);
+    equeue_event_slack(b, 10);
+    id = equeue_post(&q, stamp_func, b);
+    test_assert(id);
+
+    equeue_dispatch(&q, 30);
+    test_assert(ta && tb);
+
+    // the slack event was deferred past its natural deadline to share the
+    // anchor's wakeup
+    unsigned da = ta - base;
+    unsigned db = tb - base;
+    test_assert(db > 15 && db < 25);
+    test_assert((int)(db - da) <= 3 && (int)(da - db) <= 3);
+
+    equeue_destroy(&q);
+}
+
+// Worker thread tests
+static void *worker_thread(void *p) {
+    equeue_dispatch_worker((equeue_t *)p);
+    return 0;
+}
+
+struct rendezvous {
+    volatile int a;
+    volatile int b;
+};
+
+void rendezvous_a_func(void *p) {
+    struct rendezvous *r = (struct rendezvous *)p;
+    r->a = 1;
+    for (int i = 0; !r->b && i < 1000; i++) {
+        usleep(1000);
+    }
+    test_assert(r->b);
+}
+
+void rendezvous_b_func(void *p) {
+    struct rendezvous *r = (struct rendezvous *)p;
+    r->b = 1;
+    for (int i = 0; !r->a && i < 1000; i++) {
+        usleep(1000);
+    }
+    test_assert(r->a);
+}
+
+void worker_steal_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    pthread_t thread;
+    err = pthread_create(&thread, 0, worker_thread, &q);
+    test_assert(!err);
+    for (int i = 0; !q.workers && i < 1000; i++) {
+        usleep(1000);
+    }
+    test_assert(q.workers == 1);
+
+    // the two events rendezvous with each other, which can only complete
+    // if the worker runs one while the dispatch thread runs the other
+    struct rendezvous r = {0, 0};
+    int id1 = equeue_call(&q, rendezvous_a_func, &r);
+    int id2 = equeue_call(&q, rendezvous_b_func, &r);
+    test_assert(id1 && id2);
+
+    equeue_dispatch(&q, 10);
+    test_assert(r.a && r.b);
+
+    equeue_break(&q);
+    err = pthread_join(thread, 0);
+    test_assert(!err);
+
+    equeue_destroy(&q);
+}
+
+void tid_func(void *p) {
+    pthread_t *slot = *(pthread_t **)p;
+    *slot = pthread_self();
+    usleep(5000);
+}
+
+void worker_affinity_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    pthread_t thread;
+    err = pthread_create(&thread, 0, worker_thread, &q);
+    test_assert(!err);
+    for (int i = 0; !q.workers && i < 1000; i++) {
+        usleep(1000);
+    }
+    test_assert(q.workers == 1);
+
+    // dispatcher-affinity events must stay on the dispatching thread even
+    // with an idle worker eager to steal them
+    pthread_t tids[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_t **e = equeue_alloc(&q, sizeof(pthread_t *));
+        test_assert(e);
+        *e = &tids[i];
+        equeue_event_affinity(e, EQUEUE_AFFINITY_DISPATCHER);
+        int id = equeue_post(&q, tid_func, e);
+        test_assert(id);
+    }
+
+    equeue_dispatch(&q, 30);
+    for (int i = 0; i < 4; i++) {
+        test_assert(pthread_equal(tids[i], pthread_self()));
+    }
+
+    equeue_break(&q);
+    err = pthread_join(thread, 0);
+    test_assert(!err);
+
+    equeue_destroy(&q);
+}
+
 // Barrage tests
 void simple_barrage_test(int N) {
     equeue_t q;
@@ -695,6 +1103,10 @@ int main() {
     test_run(simple_call_in_test);
     test_run(simple_call_every_test);
     test_run(simple_post_test);
+    test_run(simple_call_irq_test);
+    test_run(call_irq_overflow_test);
+    test_run(prio_order_test);
+    test_run(prio_preempt_test);
     test_run(destructor_test);
     test_run(allocation_failure_test);
     test_run(cancel_test, 20);
@@ -708,7 +1120,13 @@ int main() {
     test_run(background_test);
     test_run(chain_test);
     test_run(unchain_test);
+    test_run(chain_background_test);
+    test_run(chain_wakeup_test);
+    test_run(slack_coalesce_test);
+    test_run(slack_together_test);
     test_run(multithread_test);
+    test_run(worker_steal_test);
+    test_run(worker_affinity_test);
     test_run(simple_barrage_test, 20);
     test_run(fragmenting_barrage_test, 20);
     test_run(multithreaded_barrage_test, 20);
@@ -16,6 +16,7 @@
 
 #include "events/mbed_shared_queues.h"
 #include "mbed.h"
+#include <new>
 
 using namespace events;
 
@@ -43,6 +44,23 @@ EventQueue *do_shared_event_queue_with_thread()
         if (status != osOK) {
             return NULL;
         }
+
+#if MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS > 1
+        /* Extra worker threads steal ready events from the dispatch
+         * thread; events that must serialize can be pinned to it with
+         * equeue_event_affinity. Thread is NonCopyable, so the workers
+         * are placement-constructed into static buffers. */
+        static uint64_t worker_stacks[MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS - 1]
+                                     [StackSize / sizeof(uint64_t)];
+        static uint64_t worker_mem[MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS - 1]
+                                  [(sizeof(Thread) + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+        for (unsigned i = 0; i < MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS - 1; i++) {
+            Thread *worker = new (worker_mem[i])
+                    Thread(Priority, StackSize, (unsigned char *) worker_stacks[i]);
+            status = worker->start(callback(&queue, &EventQueue::dispatch_worker));
+            MBED_ASSERT(status == osOK);
+        }
+#endif
     }
 
     return &queue;
@@ -30,6 +30,14 @@
 #include "mbed_error.h"
 #endif
 
+/**
+ * Number of concurrent connections for which link telemetry counters are
+ * maintained. Refer to BLE::getLinkTelemetry.
+ */
+#ifndef BLE_LINK_TELEMETRY_MAX_CONNECTIONS
+#define BLE_LINK_TELEMETRY_MAX_CONNECTIONS 4
+#endif
+
 /* Forward declaration for the implementation class */
 class BLEInstanceBase;
 
@@ -1532,6 +1540,160 @@ public:
      */
     void onEventsToProcess(const OnEventsToProcessCallback_t& callback);
 
+    /**
+     * Link-health counters accumulated by the radio scheduler for a single
+     * connection. All counters are monotonic and start from zero when the
+     * connection is first reported by the port.
+     */
+    struct LinkTelemetry_t {
+        Gap::Handle_t connHandle;     /**< The connection the counters refer to. */
+        uint32_t      scheduledEvents; /**< Connection events scheduled by the link layer. */
+        uint32_t      completedEvents; /**< Connection events in which the radio actually ran. */
+        uint32_t      crcErrors;       /**< Packets received with a failing CRC. */
+        uint32_t      emptyPdus;       /**< Empty PDUs exchanged solely to maintain the anchor point. */
+        uint32_t      packets;         /**< Non-empty data packets carried over the air. */
+
+        /**
+         * Average number of non-empty packets carried per completed connection
+         * event, expressed in hundredths: a return value of 250 reads as 2.5
+         * packets per event. Returns 0 if no connection event has completed.
+         */
+        uint32_t averagePacketsPerEventX100(void) const {
+            if (completedEvents == 0) {
+                return 0;
+            }
+            return (packets * 100) / completedEvents;
+        }
+    };
+
+    /**
+     * Take a snapshot of the link telemetry counters of a connection.
+     *
+     * The counters are written from radio (interrupt) context and read here
+     * without masking interrupts: every counter is a single aligned 32-bit
+     * word, so each field is read tear-free and a snapshot is cheap enough to
+     * take from a reporting loop. Fields of the snapshot may be skewed by at
+     * most one connection event relative to each other.
+     *
+     * @param[in]  connHandle The connection to report on.
+     * @param[out] telemetry  Receives a copy of the counters.
+     *
+     * @return BLE_ERROR_NONE if the snapshot was taken, BLE_ERROR_INVALID_PARAM
+     *     if @p telemetry is NULL or BLE_ERROR_INVALID_STATE if the port has
+     *     not reported any connection event for @p connHandle.
+     */
+    ble_error_t getLinkTelemetry(Gap::Handle_t connHandle, LinkTelemetry_t *telemetry) const {
+        if (telemetry == NULL) {
+            return BLE_ERROR_INVALID_PARAM;
+        }
+        const LinkTelemetrySlot_t *slot = findLinkTelemetrySlot(connHandle);
+        if (slot == NULL) {
+            return BLE_ERROR_INVALID_STATE;
+        }
+        telemetry->connHandle      = slot->connHandle;
+        telemetry->scheduledEvents = slot->scheduledEvents;
+        telemetry->completedEvents = slot->completedEvents;
+        telemetry->crcErrors       = slot->crcErrors;
+        telemetry->emptyPdus       = slot->emptyPdus;
+        telemetry->packets         = slot->packets;
+        return BLE_ERROR_NONE;
+    }
+
+    /**
+     * Release the telemetry counters held for a connection, typically from a
+     * disconnection handler, so that the slot can be reused for a later
+     * connection. Counters of a disconnected link remain readable until this
+     * is called.
+     */
+    void resetLinkTelemetry(Gap::Handle_t connHandle) {
+        for (unsigned i = 0; i < BLE_LINK_TELEMETRY_MAX_CONNECTIONS; ++i) {
+            if (linkTelemetry[i].inUse && (linkTelemetry[i].connHandle == connHandle)) {
+                linkTelemetry[i].inUse = false;
+                return;
+            }
+        }
+    }
+
+    /**
+     * Report that the link layer has scheduled a connection event. This
+     * function is meant to be called from the port of BLE_API; it shouldn't be
+     * called by end users.
+     */
+    void processConnectionEventScheduled(Gap::Handle_t connHandle) {
+        LinkTelemetrySlot_t *slot = fetchLinkTelemetrySlot(connHandle);
+        if (slot == NULL) {
+            return;
+        }
+        slot->scheduledEvents = slot->scheduledEvents + 1;
+    }
+
+    /**
+     * Report the outcome of a connection event in which the radio ran. This
+     * function is meant to be called from the port of BLE_API; it shouldn't be
+     * called by end users.
+     *
+     * @param[in] connHandle The connection the event belonged to.
+     * @param[in] packets    Non-empty data packets carried during the event.
+     * @param[in] crcErrors  Packets received with a failing CRC during the event.
+     * @param[in] emptyPdus  Empty PDUs exchanged during the event.
+     */
+    void processConnectionEventComplete(Gap::Handle_t connHandle, uint16_t packets, uint16_t crcErrors, uint16_t emptyPdus) {
+        LinkTelemetrySlot_t *slot = fetchLinkTelemetrySlot(connHandle);
+        if (slot == NULL) {
+            return;
+        }
+        slot->completedEvents = slot->completedEvents + 1;
+        slot->packets         = slot->packets + packets;
+        slot->crcErrors       = slot->crcErrors + crcErrors;
+        slot->emptyPdus       = slot->emptyPdus + emptyPdus;
+    }
+
+private:
+    /*
+     * Counters are single-writer (the radio scheduler of the port); the
+     * volatile qualifier is what makes the unlocked reads in
+     * getLinkTelemetry() well defined.
+     */
+    struct LinkTelemetrySlot_t {
+        Gap::Handle_t     connHandle;
+        bool              inUse;
+        volatile uint32_t scheduledEvents;
+        volatile uint32_t completedEvents;
+        volatile uint32_t crcErrors;
+        volatile uint32_t emptyPdus;
+        volatile uint32_t packets;
+    };
+
+    const LinkTelemetrySlot_t *findLinkTelemetrySlot(Gap::Handle_t connHandle) const {
+        for (unsigned i = 0; i < BLE_LINK_TELEMETRY_MAX_CONNECTIONS; ++i) {
+            if (linkTelemetry[i].inUse && (linkTelemetry[i].connHandle == connHandle)) {
+                return &linkTelemetry[i];
+            }
+        }
+        return NULL;
+    }
+
+    LinkTelemetrySlot_t *fetchLinkTelemetrySlot(Gap::Handle_t connHandle) {
+        for (unsigned i = 0; i < BLE_LINK_TELEMETRY_MAX_CONNECTIONS; ++i) {
+            if (linkTelemetry[i].inUse && (linkTelemetry[i].connHandle == connHandle)) {
+                return &linkTelemetry[i];
+            }
+        }
+        for (unsigned i = 0; i < BLE_LINK_TELEMETRY_MAX_CONNECTIONS; ++i) {
+            if (!linkTelemetry[i].inUse) {
+                linkTelemetry[i].connHandle      = connHandle;
+                linkTelemetry[i].scheduledEvents = 0;
+                linkTelemetry[i].completedEvents = 0;
+                linkTelemetry[i].crcErrors       = 0;
+                linkTelemetry[i].emptyPdus       = 0;
+                linkTelemetry[i].packets         = 0;
+                linkTelemetry[i].inUse           = true;
+                return &linkTelemetry[i];
+            }
+        }
+        return NULL;
+    }
+
 private:
 
     friend class BLEInstanceBase;
@@ -1560,6 +1722,7 @@ private:
     InstanceID_t     instanceID;
     BLEInstanceBase *transport; /* The device-specific backend */
     OnEventsToProcessCallback_t whenEventsToProcess;
+    LinkTelemetrySlot_t linkTelemetry[BLE_LINK_TELEMETRY_MAX_CONNECTIONS];
 };
 
 typedef BLE BLEDevice; /**< @deprecated This type alias is retained for the
@@ -26,6 +26,15 @@
 #include "CallChainOfFunctionPointersWithContext.h"
 #include "FunctionPointerWithContext.h"
 #include "deprecate.h"
+#include "us_ticker_api.h"
+#include <new>
+
+/** Number of distinct advertisers tracked by the duplicate-report filter
+ *  (see GapScanningParams::setDuplicateFilterWindow). Each entry costs 12
+ *  bytes and is only allocated once filtering is enabled. */
+#ifndef BLE_GAP_SCAN_DUPLICATE_CACHE_SIZE
+#define BLE_GAP_SCAN_DUPLICATE_CACHE_SIZE 16
+#endif
 
 /* Forward declarations for classes that will only be used for pointers or references in the following. */
 class GapAdvertisingParams;
@@ -212,6 +221,36 @@ public:
      */
     typedef FunctionPointerWithContext<const AdvertisementCallbackParams_t *> AdvertisementReportCallback_t;
 
+    /**
+     * Compact, self-contained copy of a scanned advertising packet, used for
+     * batched report delivery. Unlike AdvertisementCallbackParams_t, the
+     * advertising data is stored inline so that a report remains valid after
+     * the stack's receive buffer has been reused while a batch fills up.
+     */
+    struct AdvertisementSummary_t {
+        BLEProtocol::AddressBytes_t              peerAddr;           /**< The peer's BLE address. */
+        int8_t                                   rssi;               /**< The advertisement packet RSSI value. */
+        bool                                     isScanResponse;     /**< Whether this packet is the response to a scan request. */
+        GapAdvertisingParams::AdvertisingType_t  type;               /**< The type of advertisement. */
+        uint8_t                                  advertisingDataLen; /**< Length of the advertisement data. */
+        uint8_t                                  advertisingData[GAP_ADVERTISING_DATA_MAX_PAYLOAD]; /**< The advertisement packet's data. */
+    };
+
+    /**
+     * Batch of scanned advertising packets delivered in a single callback.
+     * Refer to Gap::startBatchedScan().
+     */
+    struct AdvertisementBatchCallbackParams_t {
+        const AdvertisementSummary_t *reports; /**< Array of collected reports. */
+        uint8_t                       count;   /**< Number of valid entries in @p reports. */
+    };
+
+    /**
+     * Type for the handlers of batched advertisement callback events. Refer
+     * to Gap::startBatchedScan().
+     */
+    typedef FunctionPointerWithContext<const AdvertisementBatchCallbackParams_t *> AdvertisementBatchCallback_t;
+
     /**
      * Encapsulates the parameters of a connection. This information is passed
      * to the registered handler of connection events. Refer to Gap::onConnection().
@@ -335,6 +374,36 @@ public:
      */
     typedef FunctionPointerWithContext<bool> RadioNotificationEventCallback_t;
 
+    /**
+     * Parameters of a connection event window. Refer to
+     * Gap::onConnectionEventWindow().
+     */
+    struct ConnectionEventWindowCallbackParams_t {
+        /**
+         * The ID of the connection the event belongs to.
+         */
+        Handle_t handle;
+        /**
+         * True when the controller is about to open the connection event,
+         * false when the connection event has closed and the radio is idle
+         * until the next anchor point.
+         */
+        bool     start;
+        /**
+         * Timestamp (in microseconds, on the controller's timebase) of the
+         * connection event's anchor point. Successive anchor points are one
+         * connection interval apart; applications can use this to phase-lock
+         * work to the radio's idle windows.
+         */
+        uint32_t anchorUsecs;
+    };
+
+    /**
+     * Type for the handlers of connection event window callback events.
+     * Refer to Gap::onConnectionEventWindow().
+     */
+    typedef FunctionPointerWithContext<const ConnectionEventWindowCallbackParams_t *> ConnectionEventWindowCallback_t;
+
     /**
      * Type for the handlers of shutdown callback events. Refer to
      * Gap::onShutdown().
@@ -1387,6 +1456,90 @@ public:
         return err;
     }
 
+    /**
+     * Start scanning with batched report delivery. Reports are collected
+     * in-stack and the callback is invoked once per @p reportsPerBatch
+     * reports rather than per report, cutting the number of host wakeups
+     * in report-dense environments. Combine with
+     * GapScanningParams::setDuplicateFilterWindow() to also drop repeated
+     * reports before they occupy a batch slot.
+     *
+     * A partial batch is delivered when the scan times out; it can also be
+     * forced out at any time with flushScanReports().
+     *
+     * @param[in] reportsPerBatch
+     *              Number of reports to collect before invoking the callback.
+     * @param[in] callback
+     *              The application-specific callback to be invoked per batch.
+     *
+     * @return BLE_ERROR_NONE if the device successfully started the scan
+     *         procedure.
+     */
+    ble_error_t startBatchedScan(uint8_t reportsPerBatch, void (*callback)(const AdvertisementBatchCallbackParams_t *params)) {
+        if ((reportsPerBatch == 0) || !callback) {
+            return BLE_ERROR_INVALID_PARAM;
+        }
+
+        ble_error_t err = setupBatchBuffer(reportsPerBatch);
+        if (err == BLE_ERROR_NONE) {
+            if ((err = startRadioScan(_scanningParams)) == BLE_ERROR_NONE) {
+                scanningActive = true;
+                onAdvertisementBatch.attach(callback);
+            }
+        }
+
+        return err;
+    }
+
+    /**
+     * Same as Gap::startBatchedScan(), but allows the possibility to add an
+     * object reference and member function as handler for batched
+     * advertisement event callbacks.
+     *
+     * @param[in] reportsPerBatch
+     *              Number of reports to collect before invoking the callback.
+     * @param[in] object
+     *              Pointer to the object of a class defining the member callback
+     *              function (@p callbackMember).
+     * @param[in] callbackMember
+     *              The member callback (within the context of an object) to be
+     *              invoked.
+     *
+     * @return BLE_ERROR_NONE if the device successfully started the scan
+     *         procedure.
+     */
+    template<typename T>
+    ble_error_t startBatchedScan(uint8_t reportsPerBatch, T *object, void (T::*callbackMember)(const AdvertisementBatchCallbackParams_t *params)) {
+        if ((reportsPerBatch == 0) || !object || !callbackMember) {
+            return BLE_ERROR_INVALID_PARAM;
+        }
+
+        ble_error_t err = setupBatchBuffer(reportsPerBatch);
+        if (err == BLE_ERROR_NONE) {
+            if ((err = startRadioScan(_scanningParams)) == BLE_ERROR_NONE) {
+                scanningActive = true;
+                onAdvertisementBatch.attach(object, callbackMember);
+            }
+        }
+
+        return err;
+    }
+
+    /**
+     * Deliver any partially filled batch of advertisement reports to the
+     * registered batch callback. This is useful before stopScan(), or when
+     * the application wants reports no later than some deadline of its own.
+     */
+    void flushScanReports(void) {
+        if (_batchReports && (_batchCount > 0)) {
+            AdvertisementBatchCallbackParams_t params;
+            params.reports = _batchReports;
+            params.count   = _batchCount;
+            _batchCount    = 0;
+            onAdvertisementBatch.call(&params);
+        }
+    }
+
     /**
      * Initialize radio-notification events to be generated from the stack.
      * This API doesn't need to be called directly.
@@ -1619,6 +1772,49 @@ public:
         radioNotificationCallback.attach(tptr, mptr);
     }
 
+    /**
+     * Set the application callback for connection event windows.
+     *
+     * Where radio notification (refer to Gap::onRadioNotification()) signals
+     * raw radio activity, this callback describes individual connection
+     * events: it is invoked with start set to true just before the
+     * controller opens a connection event, and with start set to false once
+     * the event has closed, together with the connection handle and the
+     * controller's timestamp of the event's anchor point. The window between
+     * an end notification and the next anchor point is guaranteed radio-idle
+     * time for that connection; applications can schedule bus transactions
+     * or sensor sampling inside it to avoid contention, and batch outgoing
+     * data just before the next anchor to cut latency and power.
+     *
+     * @param[in] callback
+     *              The application handler to be invoked at the start and end
+     *              of each connection event.
+     *
+     * @note This capability depends on the underlying stack exposing
+     *       connection event timing; ports which do not support it never
+     *       invoke the callback.
+     */
+    void onConnectionEventWindow(const ConnectionEventWindowCallback_t& callback) {
+        connectionEventWindowCallback = callback;
+    }
+
+    /**
+     * Same as Gap::onConnectionEventWindow(), but allows the possibility to
+     * register an object reference and member function as handler for
+     * connection event window events.
+     *
+     * @param[in] tptr
+     *              Pointer to the object of a class defining the member callback
+     *              function (@p mptr).
+     * @param[in] mptr
+     *              The member callback (within the context of an object) to be
+     *              invoked at the start and end of each connection event.
+     */
+    template <typename T>
+    void onConnectionEventWindow(T *tptr, void (T::*mptr)(const ConnectionEventWindowCallbackParams_t *)) {
+        connectionEventWindowCallback.attach(tptr, mptr);
+    }
+
     /**
      * Setup a callback to be invoked to notify the user application that the
      * Gap instance is about to shutdown (possibly as a result of a call
@@ -1708,8 +1904,20 @@ public:
         timeoutCallbackChain.clear();
         connectionCallChain.clear();
         disconnectionCallChain.clear();
-        radioNotificationCallback = NULL;
-        onAdvertisementReport     = NULL;
+        radioNotificationCallback     = NULL;
+        connectionEventWindowCallback = NULL;
+        onAdvertisementReport         = NULL;
+        onAdvertisementBatch          = NULL;
+
+        /* Release scan batching and duplicate-filter state */
+        delete[] _batchReports;
+        _batchReports        = NULL;
+        _batchSize           = 0;
+        _batchCount          = 0;
+        delete[] _duplicateCache;
+        _duplicateCache      = NULL;
+        _duplicateCacheCount = 0;
+        _duplicateCacheNext  = 0;
 
         return BLE_ERROR_NONE;
     }
@@ -1726,9 +1934,17 @@ protected:
         connectionCount(0),
         state(),
         scanningActive(false),
+        _batchReports(NULL),
+        _batchSize(0),
+        _batchCount(0),
+        _duplicateCache(NULL),
+        _duplicateCacheCount(0),
+        _duplicateCacheNext(0),
         timeoutCallbackChain(),
         radioNotificationCallback(),
+        connectionEventWindowCallback(),
         onAdvertisementReport(),
+        onAdvertisementBatch(),
         connectionCallChain(),
         disconnectionCallChain() {
         _advPayload.clear();
@@ -1818,6 +2034,28 @@ public:
                                     GapAdvertisingParams::AdvertisingType_t  type,
                                     uint8_t                                  advertisingDataLen,
                                     const uint8_t                           *advertisingData) {
+        if (_scanningParams.getDuplicateFilterWindow() &&
+            isDuplicateReport(peerAddr, advertisingDataLen, advertisingData)) {
+            return;
+        }
+
+        if (_batchReports) {
+            AdvertisementSummary_t &report = _batchReports[_batchCount];
+            memcpy(report.peerAddr, peerAddr, ADDR_LEN);
+            report.rssi               = rssi;
+            report.isScanResponse     = isScanResponse;
+            report.type               = type;
+            if (advertisingDataLen > GAP_ADVERTISING_DATA_MAX_PAYLOAD) {
+                advertisingDataLen = GAP_ADVERTISING_DATA_MAX_PAYLOAD;
+            }
+            report.advertisingDataLen = advertisingDataLen;
+            memcpy(report.advertisingData, advertisingData, advertisingDataLen);
+            if (++_batchCount == _batchSize) {
+                flushScanReports();
+            }
+            return;
+        }
+
         AdvertisementCallbackParams_t params;
         memcpy(params.peerAddr, peerAddr, ADDR_LEN);
         params.rssi               = rssi;
@@ -1828,6 +2066,32 @@ public:
         onAdvertisementReport.call(&params);
     }
 
+    /**
+     * Helper function that notifies the registered handler of the start or
+     * end of a connection event. This function is meant to be called from
+     * the BLE stack specific implementation when the controller reports
+     * connection event timing.
+     *
+     * @param[in] handle
+     *              The ID of the connection that generated the event.
+     * @param[in] start
+     *              True at the start of the connection event, false at its
+     *              end.
+     * @param[in] anchorUsecs
+     *              Controller timestamp (in microseconds) of the connection
+     *              event's anchor point.
+     */
+    void processConnectionEventWindow(Handle_t handle, bool start, uint32_t anchorUsecs) {
+        if (connectionEventWindowCallback) {
+            ConnectionEventWindowCallbackParams_t params = {
+                handle,
+                start,
+                anchorUsecs
+            };
+            connectionEventWindowCallback(&params);
+        }
+    }
+
     /**
      * Helper function that notifies all registered handlers of an occurrence
      * of a timeout event. This function is meant to be called from the
@@ -1841,11 +2105,97 @@ public:
             /* Update gap state if the source is an advertising timeout */
             state.advertising = 0;
         }
+        if (source == TIMEOUT_SRC_SCAN) {
+            /* Deliver any reports still sitting in a partial batch */
+            flushScanReports();
+        }
         if (timeoutCallbackChain) {
             timeoutCallbackChain(source);
         }
     }
 
+private:
+    /**
+     * Entry of the duplicate-report filter cache.
+     */
+    struct DuplicateCacheEntry_t {
+        BLEProtocol::AddressBytes_t peerAddr;    /**< Address of the advertiser. */
+        uint16_t                    dataHash;    /**< Hash of the advertising payload. */
+        uint32_t                    timestampMs; /**< Time the report was last delivered. */
+    };
+
+    /**
+     * Hash an advertising payload for duplicate detection.
+     */
+    static uint16_t advDataHash(const uint8_t *data, uint8_t len) {
+        uint16_t hash = len;
+        for (uint8_t i = 0; i < len; i++) {
+            hash = (uint16_t)(hash * 31 + data[i]);
+        }
+        return hash;
+    }
+
+    /**
+     * Check a report against the duplicate cache, recording it as delivered
+     * when it is new or when its filter window has expired.
+     */
+    bool isDuplicateReport(const BLEProtocol::AddressBytes_t peerAddr,
+                           uint8_t                           advertisingDataLen,
+                           const uint8_t                    *advertisingData) {
+        if (!_duplicateCache) {
+            _duplicateCache = new (std::nothrow) DuplicateCacheEntry_t[BLE_GAP_SCAN_DUPLICATE_CACHE_SIZE];
+            if (!_duplicateCache) {
+                /* Degrade to unfiltered delivery rather than fail the scan */
+                return false;
+            }
+            _duplicateCacheCount = 0;
+            _duplicateCacheNext  = 0;
+        }
+
+        uint32_t now  = us_ticker_read() / 1000;
+        uint16_t hash = advDataHash(advertisingData, advertisingDataLen);
+
+        for (uint8_t i = 0; i < _duplicateCacheCount; i++) {
+            DuplicateCacheEntry_t &entry = _duplicateCache[i];
+            if ((entry.dataHash == hash) && (memcmp(entry.peerAddr, peerAddr, ADDR_LEN) == 0)) {
+                if ((uint32_t)(now - entry.timestampMs) < _scanningParams.getDuplicateFilterWindow()) {
+                    return true;
+                }
+                entry.timestampMs = now;
+                return false;
+            }
+        }
+
+        /* New advertiser or payload: once the cache is full, replace the
+         * oldest entry */
+        DuplicateCacheEntry_t &entry = _duplicateCache[_duplicateCacheNext];
+        _duplicateCacheNext = (uint8_t)((_duplicateCacheNext + 1) % BLE_GAP_SCAN_DUPLICATE_CACHE_SIZE);
+        if (_duplicateCacheCount < BLE_GAP_SCAN_DUPLICATE_CACHE_SIZE) {
+            _duplicateCacheCount++;
+        }
+        memcpy(entry.peerAddr, peerAddr, ADDR_LEN);
+        entry.dataHash    = hash;
+        entry.timestampMs = now;
+        return false;
+    }
+
+    /**
+     * Size (or resize) the batch buffer used by startBatchedScan().
+     */
+    ble_error_t setupBatchBuffer(uint8_t reportsPerBatch) {
+        if (_batchSize != reportsPerBatch) {
+            delete[] _batchReports;
+            _batchCount   = 0;
+            _batchSize    = 0;
+            _batchReports = new (std::nothrow) AdvertisementSummary_t[reportsPerBatch];
+            if (!_batchReports) {
+                return BLE_ERROR_NO_MEM;
+            }
+            _batchSize = reportsPerBatch;
+        }
+        return BLE_ERROR_NONE;
+    }
+
 protected:
     /**
      * Currently set advertising parameters.
@@ -1877,6 +2227,30 @@ protected:
      * from a peer if possible.
      */
     bool                             scanningActive;
+    /**
+     * Batch buffer for startBatchedScan(); NULL while batching is disabled.
+     */
+    AdvertisementSummary_t          *_batchReports;
+    /**
+     * Capacity of _batchReports in reports.
+     */
+    uint8_t                          _batchSize;
+    /**
+     * Number of reports currently collected in _batchReports.
+     */
+    uint8_t                          _batchCount;
+    /**
+     * Duplicate-report filter cache; NULL until filtering is first used.
+     */
+    DuplicateCacheEntry_t           *_duplicateCache;
+    /**
+     * Number of valid entries in _duplicateCache.
+     */
+    uint8_t                          _duplicateCacheCount;
+    /**
+     * Next slot of _duplicateCache to replace.
+     */
+    uint8_t                          _duplicateCacheNext;
 
 protected:
     /**
@@ -1888,11 +2262,20 @@ protected:
      * The registered callback handler for radio notification events.
      */
     RadioNotificationEventCallback_t  radioNotificationCallback;
+    /**
+     * The registered callback handler for connection event window events.
+     */
+    ConnectionEventWindowCallback_t   connectionEventWindowCallback;
     /**
      * The registered callback handler for scanned advertisement packet
      * notifications.
      */
     AdvertisementReportCallback_t     onAdvertisementReport;
+    /**
+     * The registered callback handler for batched advertisement packet
+     * notifications.
+     */
+    AdvertisementBatchCallback_t      onAdvertisementBatch;
     /**
      * Callchain containing all registered callback handlers for connection
      * events.
@@ -208,6 +208,22 @@ public:
         /* empty */
     }
 
+    /**
+     * Construct advertising data from a readily formatted payload, such as one
+     * produced by GapAdvertisingDataBuilder. The payload is copied as-is; no
+     * per-field processing takes place. Payloads longer than
+     * GAP_ADVERTISING_DATA_MAX_PAYLOAD are truncated.
+     *
+     * @param[in] payload     The formatted advertising payload to copy.
+     * @param[in] payloadLen  The length of @p payload in bytes.
+     */
+    GapAdvertisingData(const uint8_t *payload, uint8_t payloadLen) : _payload(), _payloadLen(payloadLen), _appearance(GENERIC_TAG) {
+        if (_payloadLen > GAP_ADVERTISING_DATA_MAX_PAYLOAD) {
+            _payloadLen = GAP_ADVERTISING_DATA_MAX_PAYLOAD;
+        }
+        memcpy(_payload, payload, _payloadLen);
+    }
+
     /**
      * Adds advertising data based on the specified AD type (see GapAdvertisingData::DataType_t).
      * If the supplied AD type is already present in the advertising
@@ -564,4 +580,179 @@ private:
     uint16_t _appearance;
 };
 
+/**
+ * @brief Advertising payload builder whose layout is computed and validated at
+ *        compile time.
+ *
+ * Up to four AD fields are described by <type, payload length> pairs of
+ * template parameters. The position of every field in the 31-byte payload is
+ * an enumerator computed from those parameters, and a payload which would
+ * exceed GAP_ADVERTISING_DATA_MAX_PAYLOAD fails to compile instead of failing
+ * silently at run time.
+ *
+ * The constructor writes the length and type bytes of every field once; after
+ * that, refreshing a field is a fixed-offset copy through setField(), which
+ * makes the builder suitable for high-frequency advertising updates. The
+ * length of each field is fixed by the template parameters - fields never
+ * move.
+ *
+ * @par EXAMPLE
+ *
+ * @code
+ *
+ * typedef GapAdvertisingDataBuilder<
+ *     GapAdvertisingData::FLAGS,                      1,
+ *     GapAdvertisingData::MANUFACTURER_SPECIFIC_DATA, 4
+ * > SensorPayload_t;
+ *
+ * SensorPayload_t payload;
+ * const uint8_t flags = GapAdvertisingData::LE_GENERAL_DISCOVERABLE;
+ * payload.setField<0>(&flags);
+ *
+ * // at 100 Hz: patch the sensor bytes and hand the payload to the stack
+ * payload.setField<1>(sensorValue);
+ * ble.gap().setAdvertisingPayload(payload.toAdvertisingData());
+ *
+ * @endcode
+ */
+template <uint8_t Type1, uint8_t Len1,
+          uint8_t Type2 = 0, uint8_t Len2 = 0,
+          uint8_t Type3 = 0, uint8_t Len3 = 0,
+          uint8_t Type4 = 0, uint8_t Len4 = 0>
+class GapAdvertisingDataBuilder
+{
+public:
+    /**
+     * Layout of the payload, computed at compile time. A field with a type
+     * parameter of 0 is absent and occupies no space.
+     */
+    enum {
+        SIZE_1 = 2 + Len1,
+        SIZE_2 = (Type2 != 0) ? (2 + Len2) : 0,
+        SIZE_3 = (Type3 != 0) ? (2 + Len3) : 0,
+        SIZE_4 = (Type4 != 0) ? (2 + Len4) : 0,
+
+        OFFSET_1 = 0,
+        OFFSET_2 = OFFSET_1 + SIZE_1,
+        OFFSET_3 = OFFSET_2 + SIZE_2,
+        OFFSET_4 = OFFSET_3 + SIZE_3,
+
+        PAYLOAD_LEN = OFFSET_4 + SIZE_4,
+
+        FIELD_COUNT = 1 + ((Type2 != 0) ? 1 : 0)
+                        + ((Type3 != 0) ? 1 : 0)
+                        + ((Type4 != 0) ? 1 : 0)
+    };
+
+private:
+    /* The payload must fit in an advertising frame. */
+    typedef char PayloadSizeCheck_t[(PAYLOAD_LEN <= GAP_ADVERTISING_DATA_MAX_PAYLOAD) ? 1 : -1];
+    /* Fields must be declared contiguously; a gap in the parameter list is a mistake. */
+    typedef char FieldOrderCheck_t[((Type2 != 0) || ((Type3 == 0) && (Type4 == 0))) &&
+                                   ((Type3 != 0) || (Type4 == 0)) ? 1 : -1];
+
+public:
+    /**
+     * Format the length and type byte of every declared field. The payload
+     * bytes of the fields are zero until written through setField().
+     */
+    GapAdvertisingDataBuilder(void) {
+        memset(_payload, 0, sizeof(_payload));
+        writeFieldHeader(OFFSET_1, Type1, Len1);
+        if (Type2 != 0) {
+            writeFieldHeader(OFFSET_2, Type2, Len2);
+        }
+        if (Type3 != 0) {
+            writeFieldHeader(OFFSET_3, Type3, Len3);
+        }
+        if (Type4 != 0) {
+            writeFieldHeader(OFFSET_4, Type4, Len4);
+        }
+    }
+
+    /**
+     * Replace the payload bytes of a field. @p Index is the zero-based
+     * position of the field in the template parameter list; indices beyond the
+     * declared fields fail to compile. The copy length is the declared length
+     * of the field, and its destination offset is a compile-time constant.
+     *
+     * @param[in] data A buffer holding at least the declared length of the field.
+     */
+    template <unsigned Index>
+    void setField(const uint8_t *data) {
+        typedef char FieldIndexCheck_t[(Index < (unsigned)FIELD_COUNT) ? 1 : -1];
+        (void)sizeof(FieldIndexCheck_t);
+        memcpy(&_payload[fieldOffset(Index) + 2], data, fieldLength(Index));
+    }
+
+    /**
+     * Direct access to the payload bytes of a field, for callers which prefer
+     * writing in place over copying.
+     *
+     * @return A pointer to the first payload byte of the field.
+     */
+    template <unsigned Index>
+    uint8_t *getField(void) {
+        typedef char FieldIndexCheck_t[(Index < (unsigned)FIELD_COUNT) ? 1 : -1];
+        (void)sizeof(FieldIndexCheck_t);
+        return &_payload[fieldOffset(Index) + 2];
+    }
+
+    /**
+     * Access the formatted payload.
+     *
+     * @return A pointer to the formatted payload.
+     */
+    const uint8_t *getPayload(void) const {
+        return _payload;
+    }
+
+    /**
+     * Get the payload length.
+     *
+     * @return The payload length in bytes; a compile-time constant.
+     */
+    uint8_t getPayloadLen(void) const {
+        return PAYLOAD_LEN;
+    }
+
+    /**
+     * Produce a GapAdvertisingData carrying the formatted payload, suitable
+     * for Gap::setAdvertisingPayload(). This is a single copy of the payload;
+     * no per-field assembly takes place.
+     */
+    GapAdvertisingData toAdvertisingData(void) const {
+        return GapAdvertisingData(_payload, PAYLOAD_LEN);
+    }
+
+private:
+    static unsigned fieldOffset(unsigned index) {
+        switch (index) {
+            case 0:  return OFFSET_1;
+            case 1:  return OFFSET_2;
+            case 2:  return OFFSET_3;
+            default: return OFFSET_4;
+        }
+    }
+
+    static unsigned fieldLength(unsigned index) {
+        switch (index) {
+            case 0:  return Len1;
+            case 1:  return Len2;
+            case 2:  return Len3;
+            default: return Len4;
+        }
+    }
+
+    void writeFieldHeader(unsigned offset, uint8_t type, uint8_t len) {
+        _payload[offset]     = len + 1;
+        _payload[offset + 1] = type;
+    }
+
+    /**
+     * The formatted payload; headers are written once at construction.
+     */
+    uint8_t _payload[PAYLOAD_LEN];
+};
+
 #endif /* ifndef __GAP_ADVERTISING_DATA_H__ */
@@ -100,6 +100,21 @@ public:
      */
     void setActiveScanning(bool activeScanning);
 
+    /**
+     * Set the duplicate-report filter window.
+     *
+     * While the window is non-zero, advertisement reports carrying the same
+     * peer address and payload as a report already delivered within the last
+     * @p windowInMS milliseconds are dropped before they reach the
+     * application callback. This keeps repetitive beacons from waking the
+     * host path on every advertising event in crowded environments.
+     *
+     * @param[in] windowInMS
+     *              New filter window in milliseconds; 0 (the default)
+     *              disables duplicate filtering.
+     */
+    void setDuplicateFilterWindow(uint16_t windowInMS);
+
 public:
     /**
      * Get the scan interval.
@@ -137,11 +152,22 @@ public:
         return _activeScanning;
     }
 
+    /**
+     * Get the duplicate-report filter window.
+     *
+     * @return The filter window in milliseconds; 0 if duplicate filtering is
+     *         disabled.
+     */
+    uint16_t getDuplicateFilterWindow(void) const {
+        return _duplicateFilterWindow;
+    }
+
 private:
     uint16_t _interval; /**< Scan interval in units of 625us (between 2.5ms and 10.24s). */
     uint16_t _window;   /**< Scan window in units of 625us (between 2.5ms and 10.24s). */
     uint16_t _timeout;  /**< Scan timeout between 0x0001 and 0xFFFF in seconds; 0x0000 disables timeout. */
     bool     _activeScanning; /**< Obtain the peer device's advertising data and (if possible) scanResponse. */
+    uint16_t _duplicateFilterWindow; /**< Duplicate-report filter window in milliseconds; 0 disables filtering. */
 
 private:
     /* Disallow copy constructor. */
@@ -24,6 +24,37 @@
 #include "GattCallbackParamTypes.h"
 #include "CallChainOfFunctionPointersWithContext.h"
 
+/**
+ * Number of per-connection update queues available for queued characteristic
+ * updates. Refer to GattServer::writeQueued().
+ */
+#ifndef BLE_GATT_SERVER_NUM_UPDATE_QUEUES
+#define BLE_GATT_SERVER_NUM_UPDATE_QUEUES 4
+#endif
+
+/**
+ * Size (in bytes) of each per-connection update queue. Each queued update
+ * costs four bytes of bookkeeping in addition to its value.
+ */
+#ifndef BLE_GATT_SERVER_UPDATE_QUEUE_SIZE
+#define BLE_GATT_SERVER_UPDATE_QUEUE_SIZE 256
+#endif
+
+/**
+ * Largest value (in bytes) which may be passed to GattServer::writeQueued().
+ */
+#ifndef BLE_GATT_SERVER_MAX_QUEUED_UPDATE_SIZE
+#define BLE_GATT_SERVER_MAX_QUEUED_UPDATE_SIZE 64
+#endif
+
+/**
+ * Number of characteristics which can be registered as write streams at the
+ * same time. Refer to GattServer::registerWriteStream().
+ */
+#ifndef BLE_GATT_SERVER_MAX_WRITE_STREAMS
+#define BLE_GATT_SERVER_MAX_WRITE_STREAMS 1
+#endif
+
 class GattServer {
 public:
     /**
@@ -73,6 +104,30 @@ public:
      */
     typedef FunctionPointerWithContext<GattAttribute::Handle_t> EventCallback_t;
 
+    /**
+     * Type for the registered callback invoked when a connection's update
+     * queue becomes empty. Refer to GattServer::onUpdateQueueDrained().
+     */
+    typedef FunctionPointerWithContext<Gap::Handle_t> UpdateQueueDrainedCallback_t;
+
+    /**
+     * Parameters passed to a write stream's commit callback once a streamed
+     * value has been fully reassembled. Refer to
+     * GattServer::registerWriteStream().
+     */
+    struct WriteStreamCommitParams_t {
+        Gap::Handle_t            connHandle; /**< The handle of the connection that streamed the value. */
+        GattAttribute::Handle_t  attrHandle; /**< Attribute handle the stream is registered on. */
+        const uint8_t           *data;       /**< The reassembled value. */
+        uint32_t                 len;        /**< Length (in bytes) of the reassembled value. */
+    };
+
+    /**
+     * Type for a write stream's commit callback. Refer to
+     * GattServer::registerWriteStream().
+     */
+    typedef FunctionPointerWithContext<const WriteStreamCommitParams_t *> WriteStreamCommitCallback_t;
+
 protected:
     /**
      * Construct a GattServer instance.
@@ -85,8 +140,14 @@ protected:
         dataReadCallChain(),
         updatesEnabledCallback(NULL),
         updatesDisabledCallback(NULL),
-        confirmationReceivedCallback(NULL) {
-        /* empty */
+        confirmationReceivedCallback(NULL),
+        updateQueueDrainedCallback(NULL) {
+        for (unsigned index = 0; index < BLE_GATT_SERVER_NUM_UPDATE_QUEUES; index++) {
+            updateQueues[index].inUse = false;
+        }
+        for (unsigned index = 0; index < BLE_GATT_SERVER_MAX_WRITE_STREAMS; index++) {
+            writeStreams[index].inUse = false;
+        }
     }
 
     /*
@@ -281,6 +342,184 @@ public:
      * APIs with non-virtual implementations.
      */
 public:
+    /**
+     * Queue an update to the value of a characteristic for a given connection.
+     *
+     * Unlike GattServer::write(), which hands a single notification to the
+     * stack and fails with BLE_STACK_BUSY once the controller's transmit
+     * queue fills, this API copies the value into a per-connection ring
+     * buffer and sends queued values opportunistically: immediately while
+     * the controller accepts them, and again from the DATA_SENT event as
+     * the controller frees transmit buffers. Several queued values can
+     * thereby be packed into each connection event without an
+     * application-level retry loop.
+     *
+     * @param[in] connectionHandle
+     *              Connection handle.
+     * @param[in] attributeHandle
+     *              Handle for the value attribute of the characteristic.
+     * @param[in] value
+     *              A pointer to a buffer holding the new value.
+     * @param[in] size
+     *              Size of the new value (in bytes). Must not exceed
+     *              BLE_GATT_SERVER_MAX_QUEUED_UPDATE_SIZE.
+     *
+     * @return BLE_ERROR_NONE if the update was queued (or sent outright),
+     *         BLE_ERROR_PARAM_OUT_OF_RANGE if the value is too large to be
+     *         queued, BLE_ERROR_NO_MEM if no update queue is available for
+     *         this connection, or BLE_ERROR_BUFFER_OVERFLOW if the
+     *         connection's queue is full.
+     *
+     * @note Updates that the stack rejects with an error other than
+     *       BLE_STACK_BUSY, BLE_ERROR_BUFFER_OVERFLOW or BLE_ERROR_NO_MEM
+     *       (for instance because the peer disabled notifications) are
+     *       dropped from the queue silently.
+     */
+    ble_error_t writeQueued(Gap::Handle_t connectionHandle, GattAttribute::Handle_t attributeHandle, const uint8_t *value, uint16_t size) {
+        if ((value == NULL) || (size == 0) || (size > BLE_GATT_SERVER_MAX_QUEUED_UPDATE_SIZE)) {
+            return BLE_ERROR_PARAM_OUT_OF_RANGE;
+        }
+
+        UpdateQueue_t *queue = fetchUpdateQueue(connectionHandle);
+        if (queue == NULL) {
+            return BLE_ERROR_NO_MEM;
+        }
+
+        uint16_t needed = UPDATE_QUEUE_ENTRY_OVERHEAD + size;
+        if ((BLE_GATT_SERVER_UPDATE_QUEUE_SIZE - queue->length) < needed) {
+            /* Try to make room by sending what the controller will accept. */
+            drainUpdateQueue(queue);
+            if ((BLE_GATT_SERVER_UPDATE_QUEUE_SIZE - queue->length) < needed) {
+                return BLE_ERROR_BUFFER_OVERFLOW;
+            }
+        }
+
+        pushUpdateQueueByte(queue, (uint8_t)(attributeHandle & 0xFF));
+        pushUpdateQueueByte(queue, (uint8_t)(attributeHandle >> 8));
+        pushUpdateQueueByte(queue, (uint8_t)(size & 0xFF));
+        pushUpdateQueueByte(queue, (uint8_t)(size >> 8));
+        for (uint16_t index = 0; index < size; index++) {
+            pushUpdateQueueByte(queue, value[index]);
+        }
+
+        drainUpdateQueue(queue);
+        return BLE_ERROR_NONE;
+    }
+
+    /**
+     * Set up a callback to be invoked when a connection's update queue
+     * transitions from non-empty to empty; i.e., when every value queued
+     * through writeQueued() has been handed to the stack. The connection
+     * handle of the drained queue is passed to the callback. Applications
+     * producing data faster than the link can carry it may use this as a
+     * flow-control signal.
+     *
+     * @param[in] callback
+     *              Event handler being registered.
+     */
+    void onUpdateQueueDrained(UpdateQueueDrainedCallback_t callback) {
+        updateQueueDrainedCallback = callback;
+    }
+
+    /**
+     * Register a characteristic's value attribute as a write stream, turning
+     * it into a sink for long values such as firmware images.
+     *
+     * Incoming prepared-write fragments (ATT Prepare Write Request) for the
+     * attribute are reassembled at their offsets into the supplied buffer
+     * instead of being forwarded to the data written callchain, and the
+     * commit callback is invoked once with the whole value when the peer
+     * issues Execute Write. Write commands (write-without-response) to the
+     * attribute are appended in arrival order, letting a peer pipeline
+     * fragments without a round trip per write; in that mode, call
+     * commitWriteStream() when the transfer is known to be complete (for
+     * instance from a control-point characteristic).
+     *
+     * @param[in] attributeHandle
+     *              Handle of the value attribute to stream into.
+     * @param[in] buffer
+     *              Reassembly buffer; owned by the caller and must stay valid
+     *              until the stream is unregistered.
+     * @param[in] size
+     *              Size of the reassembly buffer (in bytes).
+     * @param[in] commitCallback
+     *              Invoked with the reassembled value upon commit.
+     *
+     * @return BLE_ERROR_NONE if the stream was registered,
+     *         BLE_ERROR_INVALID_PARAM for a NULL or empty buffer, or
+     *         BLE_ERROR_NO_MEM if BLE_GATT_SERVER_MAX_WRITE_STREAMS streams
+     *         are already registered.
+     *
+     * @note A transfer that would overflow the buffer is discarded; the
+     *       commit callback is not invoked for it.
+     */
+    ble_error_t registerWriteStream(GattAttribute::Handle_t attributeHandle, uint8_t *buffer, uint32_t size, const WriteStreamCommitCallback_t& commitCallback) {
+        if ((buffer == NULL) || (size == 0)) {
+            return BLE_ERROR_INVALID_PARAM;
+        }
+
+        unregisterWriteStream(attributeHandle);
+        for (unsigned index = 0; index < BLE_GATT_SERVER_MAX_WRITE_STREAMS; index++) {
+            WriteStream_t *stream = &writeStreams[index];
+            if (!stream->inUse) {
+                stream->attrHandle = attributeHandle;
+                stream->buffer     = buffer;
+                stream->capacity   = size;
+                stream->length     = 0;
+                stream->overflowed = false;
+                stream->onCommit   = commitCallback;
+                stream->inUse      = true;
+                return BLE_ERROR_NONE;
+            }
+        }
+        return BLE_ERROR_NO_MEM;
+    }
+
+    /**
+     * Unregister a write stream previously set up with registerWriteStream().
+     * Any partially reassembled value is discarded.
+     *
+     * @param[in] attributeHandle
+     *              Handle the stream was registered on.
+     */
+    void unregisterWriteStream(GattAttribute::Handle_t attributeHandle) {
+        for (unsigned index = 0; index < BLE_GATT_SERVER_MAX_WRITE_STREAMS; index++) {
+            if (writeStreams[index].inUse && writeStreams[index].attrHandle == attributeHandle) {
+                writeStreams[index].inUse = false;
+            }
+        }
+    }
+
+    /**
+     * Deliver the value accumulated by a write stream to its commit callback
+     * and reset the stream. Intended for write-without-response transfers,
+     * which have no Execute Write to mark the end of the value.
+     *
+     * @param[in] connectionHandle
+     *              The connection the value was streamed over; forwarded to
+     *              the commit callback.
+     * @param[in] attributeHandle
+     *              Handle the stream is registered on.
+     *
+     * @return BLE_ERROR_NONE if the value was committed,
+     *         BLE_ERROR_INVALID_PARAM if no stream is registered on the
+     *         attribute, or BLE_ERROR_INVALID_STATE if the stream is empty
+     *         or the transfer overflowed the buffer.
+     */
+    ble_error_t commitWriteStream(Gap::Handle_t connectionHandle, GattAttribute::Handle_t attributeHandle) {
+        WriteStream_t *stream = fetchWriteStream(attributeHandle);
+        if (stream == NULL) {
+            return BLE_ERROR_INVALID_PARAM;
+        }
+        if (stream->overflowed || stream->length == 0) {
+            stream->length     = 0;
+            stream->overflowed = false;
+            return BLE_ERROR_INVALID_STATE;
+        }
+        commitStream(stream, connectionHandle);
+        return BLE_ERROR_NONE;
+    }
+
     /**
      * Add a callback for the GATT event DATA_SENT (which is triggered when
      * updates are sent out by GATT in the form of notifications).
@@ -543,6 +782,10 @@ protected:
      *              handlers.
      */
     void handleDataWrittenEvent(const GattWriteCallbackParams *params) {
+        if (handleWriteStreamEvent(params)) {
+            /* the fragment was consumed by a write stream */
+            return;
+        }
         dataWrittenCallChain.call(params);
     }
 
@@ -599,8 +842,17 @@ protected:
      *
      * @param[in] count
      *              Number of packets sent.
+     *
+     * @note The controller freeing transmit buffers is the cue to continue
+     *       sending values queued through writeQueued(); the update queues
+     *       are drained before user callbacks run.
      */
     void handleDataSentEvent(unsigned count) {
+        for (unsigned index = 0; index < BLE_GATT_SERVER_NUM_UPDATE_QUEUES; index++) {
+            if (updateQueues[index].inUse) {
+                drainUpdateQueue(&updateQueues[index]);
+            }
+        }
         dataSentCallChain.call(count);
     }
 
@@ -632,6 +884,13 @@ public:
         updatesEnabledCallback       = NULL;
         updatesDisabledCallback      = NULL;
         confirmationReceivedCallback = NULL;
+        updateQueueDrainedCallback   = NULL;
+        for (unsigned index = 0; index < BLE_GATT_SERVER_NUM_UPDATE_QUEUES; index++) {
+            updateQueues[index].inUse = false;
+        }
+        for (unsigned index = 0; index < BLE_GATT_SERVER_MAX_WRITE_STREAMS; index++) {
+            writeStreams[index].inUse = false;
+        }
 
         return BLE_ERROR_NONE;
     }
@@ -647,6 +906,198 @@ protected:
     uint8_t characteristicCount;
 
 private:
+    /**
+     * A per-connection ring buffer of updates queued through writeQueued().
+     * Each entry is laid out as [attribute handle (2 bytes, little-endian) |
+     * value size (2 bytes, little-endian) | value bytes] and entries wrap
+     * around the end of the buffer.
+     */
+    struct UpdateQueue_t {
+        Gap::Handle_t connectionHandle; /**< The connection this queue is bound to; valid only while inUse. */
+        bool          inUse;            /**< Whether this queue is bound to a connection. */
+        uint16_t      head;             /**< Index of the first byte of the oldest entry. */
+        uint16_t      length;           /**< Number of buffered bytes. */
+        uint8_t       buffer[BLE_GATT_SERVER_UPDATE_QUEUE_SIZE];
+    };
+
+    /**
+     * Number of bytes of bookkeeping preceding each queued value: the
+     * attribute handle and the value size.
+     */
+    static const uint16_t UPDATE_QUEUE_ENTRY_OVERHEAD = 4;
+
+    /**
+     * Return the update queue bound to the given connection, binding a free
+     * queue to it if this is the connection's first queued update; NULL if
+     * all queues are taken by other connections.
+     */
+    UpdateQueue_t *fetchUpdateQueue(Gap::Handle_t connectionHandle) {
+        UpdateQueue_t *freeQueue = NULL;
+        for (unsigned index = 0; index < BLE_GATT_SERVER_NUM_UPDATE_QUEUES; index++) {
+            if (updateQueues[index].inUse) {
+                if (updateQueues[index].connectionHandle == connectionHandle) {
+                    return &updateQueues[index];
+                }
+            } else if (freeQueue == NULL) {
+                freeQueue = &updateQueues[index];
+            }
+        }
+        if (freeQueue != NULL) {
+            freeQueue->connectionHandle = connectionHandle;
+            freeQueue->inUse            = true;
+            freeQueue->head             = 0;
+            freeQueue->length           = 0;
+        }
+        return freeQueue;
+    }
+
+    void pushUpdateQueueByte(UpdateQueue_t *queue, uint8_t byte) {
+        queue->buffer[(queue->head + queue->length) % BLE_GATT_SERVER_UPDATE_QUEUE_SIZE] = byte;
+        queue->length++;
+    }
+
+    uint8_t peekUpdateQueueByte(const UpdateQueue_t *queue, uint16_t offset) const {
+        return queue->buffer[(queue->head + offset) % BLE_GATT_SERVER_UPDATE_QUEUE_SIZE];
+    }
+
+    void popUpdateQueueBytes(UpdateQueue_t *queue, uint16_t count) {
+        queue->head    = (queue->head + count) % BLE_GATT_SERVER_UPDATE_QUEUE_SIZE;
+        queue->length -= count;
+    }
+
+    /**
+     * Hand queued updates to the stack until the queue empties or the stack
+     * reports that the controller's transmit queue is full. Remaining
+     * entries are retried upon the next DATA_SENT event. The queue is
+     * released (and the drained callback invoked) once emptied.
+     */
+    void drainUpdateQueue(UpdateQueue_t *queue) {
+        uint8_t scratch[BLE_GATT_SERVER_MAX_QUEUED_UPDATE_SIZE];
+
+        while (queue->length) {
+            GattAttribute::Handle_t attributeHandle = peekUpdateQueueByte(queue, 0) | (peekUpdateQueueByte(queue, 1) << 8);
+            uint16_t                size            = peekUpdateQueueByte(queue, 2) | (peekUpdateQueueByte(queue, 3) << 8);
+            for (uint16_t index = 0; index < size; index++) {
+                scratch[index] = peekUpdateQueueByte(queue, UPDATE_QUEUE_ENTRY_OVERHEAD + index);
+            }
+
+            ble_error_t error = write(queue->connectionHandle, attributeHandle, scratch, size);
+            if ((error == BLE_STACK_BUSY) || (error == BLE_ERROR_BUFFER_OVERFLOW) || (error == BLE_ERROR_NO_MEM)) {
+                /* No room in the controller; retry from the next DATA_SENT event. */
+                return;
+            }
+            /* Sent, or failed for a reason retrying cannot cure; either way
+             * the entry leaves the queue. */
+            popUpdateQueueBytes(queue, UPDATE_QUEUE_ENTRY_OVERHEAD + size);
+        }
+
+        Gap::Handle_t connectionHandle = queue->connectionHandle;
+        queue->inUse = false;
+        if (updateQueueDrainedCallback) {
+            updateQueueDrainedCallback(connectionHandle);
+        }
+    }
+
+    /**
+     * State of a characteristic registered as a write stream. Refer to
+     * GattServer::registerWriteStream().
+     */
+    struct WriteStream_t {
+        GattAttribute::Handle_t     attrHandle; /**< Attribute the stream is registered on; valid only while inUse. */
+        uint8_t                    *buffer;     /**< Caller-owned reassembly buffer. */
+        uint32_t                    capacity;   /**< Size of the reassembly buffer. */
+        uint32_t                    length;     /**< High-water mark of the bytes received so far. */
+        bool                        inUse;      /**< Whether this slot holds a registered stream. */
+        bool                        overflowed; /**< Set when a fragment did not fit; the transfer is discarded. */
+        WriteStreamCommitCallback_t onCommit;   /**< Invoked with the reassembled value upon commit. */
+    };
+
+    WriteStream_t *fetchWriteStream(GattAttribute::Handle_t attributeHandle) {
+        for (unsigned index = 0; index < BLE_GATT_SERVER_MAX_WRITE_STREAMS; index++) {
+            if (writeStreams[index].inUse && writeStreams[index].attrHandle == attributeHandle) {
+                return &writeStreams[index];
+            }
+        }
+        return NULL;
+    }
+
+    void commitStream(WriteStream_t *stream, Gap::Handle_t connectionHandle) {
+        WriteStreamCommitParams_t params = {
+            connectionHandle,
+            stream->attrHandle,
+            stream->buffer,
+            stream->length
+        };
+        stream->length     = 0;
+        stream->overflowed = false;
+        if (stream->onCommit) {
+            stream->onCommit(&params);
+        }
+    }
+
+    /**
+     * Route a data written event into the write streams. Returns true when
+     * the event was consumed and must not reach the data written callchain.
+     */
+    bool handleWriteStreamEvent(const GattWriteCallbackParams *params) {
+        switch (params->writeOp) {
+            case GattWriteCallbackParams::OP_PREP_WRITE_REQ: {
+                WriteStream_t *stream = fetchWriteStream(params->handle);
+                if (stream == NULL) {
+                    return false;
+                }
+                if ((uint32_t)params->offset + params->len > stream->capacity) {
+                    stream->overflowed = true;
+                } else if (!stream->overflowed) {
+                    memcpy(stream->buffer + params->offset, params->data, params->len);
+                    if ((uint32_t)params->offset + params->len > stream->length) {
+                        stream->length = params->offset + params->len;
+                    }
+                }
+                return true;
+            }
+
+            case GattWriteCallbackParams::OP_WRITE_CMD:
+            case GattWriteCallbackParams::OP_SIGN_WRITE_CMD: {
+                WriteStream_t *stream = fetchWriteStream(params->handle);
+                if (stream == NULL) {
+                    return false;
+                }
+                if (stream->length + params->len > stream->capacity) {
+                    stream->overflowed = true;
+                } else if (!stream->overflowed) {
+                    memcpy(stream->buffer + stream->length, params->data, params->len);
+                    stream->length += params->len;
+                }
+                return true;
+            }
+
+            /* Execute Write applies to every prepared write queued on the
+             * connection; commit (or cancel) all streams with pending data. */
+            case GattWriteCallbackParams::OP_EXEC_WRITE_REQ_NOW:
+            case GattWriteCallbackParams::OP_EXEC_WRITE_REQ_CANCEL: {
+                bool consumed = false;
+                for (unsigned index = 0; index < BLE_GATT_SERVER_MAX_WRITE_STREAMS; index++) {
+                    WriteStream_t *stream = &writeStreams[index];
+                    if (!stream->inUse || (stream->length == 0 && !stream->overflowed)) {
+                        continue;
+                    }
+                    if (params->writeOp == GattWriteCallbackParams::OP_EXEC_WRITE_REQ_NOW && !stream->overflowed) {
+                        commitStream(stream, params->connHandle);
+                    } else {
+                        stream->length     = 0;
+                        stream->overflowed = false;
+                    }
+                    consumed = true;
+                }
+                return consumed;
+            }
+
+            default:
+                return false;
+        }
+    }
+
     /**
      * Callchain containing all registered callback handlers for data sent
      * events.
@@ -679,6 +1130,20 @@ private:
      * The registered callback handler for confirmation received events.
      */
     EventCallback_t                   confirmationReceivedCallback;
+    /**
+     * The registered callback handler for update queue drained events.
+     */
+    UpdateQueueDrainedCallback_t      updateQueueDrainedCallback;
+    /**
+     * The per-connection queues of updates awaiting transmission. Refer to
+     * GattServer::writeQueued().
+     */
+    UpdateQueue_t                     updateQueues[BLE_GATT_SERVER_NUM_UPDATE_QUEUES];
+    /**
+     * The registered write streams. Refer to
+     * GattServer::registerWriteStream().
+     */
+    WriteStream_t                     writeStreams[BLE_GATT_SERVER_MAX_WRITE_STREAMS];
 
 private:
     /* Disallow copy and assignment. */
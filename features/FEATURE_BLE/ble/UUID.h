@@ -23,6 +23,13 @@
 
 #include "blecommon.h"
 
+/**
+ * Capacity of the UUID interning registry. Refer to UUID::intern().
+ */
+#ifndef BLE_UUID_INTERN_TABLE_SIZE
+#define BLE_UUID_INTERN_TABLE_SIZE 16
+#endif
+
 /**
  * A trivial converter for single hexadecimal character to an unsigned integer.
  *
@@ -86,6 +93,16 @@ public:
      */
     static const unsigned MAX_UUID_STRING_LENGTH = LENGTH_OF_LONG_UUID * 2 + 4;
 
+    /**
+     * Type for a handle to an interned UUID. Refer to UUID::intern().
+     */
+    typedef uint8_t InternedHandle_t;
+
+    /**
+     * Handle value returned by intern() when the registry is full.
+     */
+    static const InternedHandle_t INVALID_INTERNED_HANDLE = 0xFF;
+
 public:
 
     /**
@@ -101,7 +118,7 @@ public:
      *          upto four of them. The UUID is stored internally as a 16 byte
      *          array, LSB (little endian), which is opposite from the string.
      */
-    UUID(const char* stringUUID) : type(UUID_TYPE_LONG), baseUUID(), shortUUID(0) {
+    UUID(const char* stringUUID) : type(UUID_TYPE_LONG), baseUUID(), shortUUID(0), hash(0) {
         bool nibble = false;
         uint8_t byte = 0;
         size_t baseIndex = 0;
@@ -153,7 +170,7 @@ public:
      * @note   The UUID is a unique 128-bit (16 byte) ID used to identify
      *         different service or characteristics on the BLE device.
      */
-    UUID(const LongUUIDBytes_t longUUID, ByteOrder_t order = UUID::MSB) : type(UUID_TYPE_LONG), baseUUID(), shortUUID(0) {
+    UUID(const LongUUIDBytes_t longUUID, ByteOrder_t order = UUID::MSB) : type(UUID_TYPE_LONG), baseUUID(), shortUUID(0), hash(0) {
         setupLong(longUUID, order);
     }
 
@@ -186,7 +203,7 @@ public:
      *
      * @note We do not yet support 32-bit shortened UUIDs.
      */
-    UUID(ShortUUIDBytes_t _shortUUID) : type(UUID_TYPE_SHORT), baseUUID(), shortUUID(_shortUUID) {
+    UUID(ShortUUIDBytes_t _shortUUID) : type(UUID_TYPE_SHORT), baseUUID(), shortUUID(_shortUUID), hash(_shortUUID) {
         /* Empty */
     }
 
@@ -199,6 +216,7 @@ public:
     UUID(const UUID &source) {
         type      = source.type;
         shortUUID = source.shortUUID;
+        hash      = source.hash;
         memcpy(baseUUID, source.baseUUID, LENGTH_OF_LONG_UUID);
     }
 
@@ -208,7 +226,7 @@ public:
      * @note The type of the resulting UUID instance is UUID_TYPE_SHORT and the
      *       value BLE_UUID_UNKNOWN.
      */
-    UUID(void) : type(UUID_TYPE_SHORT), shortUUID(BLE_UUID_UNKNOWN) {
+    UUID(void) : type(UUID_TYPE_SHORT), shortUUID(BLE_UUID_UNKNOWN), hash(BLE_UUID_UNKNOWN) {
         /* empty */
     }
 
@@ -233,6 +251,15 @@ public:
             std::copy(longUUID, longUUID + LENGTH_OF_LONG_UUID, baseUUID);
         }
         shortUUID = (uint16_t)((baseUUID[13] << 8) | (baseUUID[12]));
+
+        /* FNV-1a over the internal representation; computed once here so
+         * that comparisons and table lookups do not have to walk the 16
+         * bytes. */
+        uint32_t h = 0x811C9DC5UL;
+        for (unsigned index = 0; index < LENGTH_OF_LONG_UUID; index++) {
+            h = (h ^ baseUUID[index]) * 0x01000193UL;
+        }
+        hash = h;
     }
 
 public:
@@ -279,6 +306,20 @@ public:
         return ((type == UUID_TYPE_SHORT) ? sizeof(ShortUUIDBytes_t) : LENGTH_OF_LONG_UUID);
     }
 
+    /**
+     * Get the hash of the UUID value.
+     *
+     * The hash is precomputed when the UUID is set up, making it suitable as
+     * a cheap key for table lookups and as a fail-fast check before a full
+     * comparison in discovery-heavy paths. Equal UUIDs always have equal
+     * hashes; the converse does not hold.
+     *
+     * @return A 32-bit hash of the UUID value.
+     */
+    uint32_t getHash(void) const {
+        return hash;
+    }
+
     /**
      * Overload == operator to enable UUID comparisons.
      *
@@ -286,19 +327,20 @@ public:
      *              The other UUID in the comparison.
      *
      * @return true if this == @p other, false otherwise.
+     *
+     * @note The precomputed hashes are compared first; the 16-byte values
+     *       are only walked when the hashes collide.
      */
     bool operator== (const UUID &other) const {
-        if ((this->type == UUID_TYPE_SHORT) && (other.type == UUID_TYPE_SHORT) &&
-            (this->shortUUID == other.shortUUID)) {
-            return true;
+        if ((this->type != other.type) || (this->hash != other.hash)) {
+            return false;
         }
 
-        if ((this->type == UUID_TYPE_LONG) && (other.type == UUID_TYPE_LONG) &&
-            (memcmp(this->baseUUID, other.baseUUID, LENGTH_OF_LONG_UUID) == 0)) {
-            return true;
+        if (this->type == UUID_TYPE_SHORT) {
+            return this->shortUUID == other.shortUUID;
         }
 
-        return false;
+        return memcmp(this->baseUUID, other.baseUUID, LENGTH_OF_LONG_UUID) == 0;
     }
 
     /**
@@ -313,6 +355,47 @@ public:
         return !(*this == other);
     }
 
+public:
+    /**
+     * Intern a UUID in the process-wide registry and return a small handle
+     * for it.
+     *
+     * Interning allows components that route the same (typically 128-bit,
+     * vendor-specific) UUIDs repeatedly - such as discovery against many
+     * peers - to carry a one-byte handle instead of copying 16-byte values,
+     * and to compare UUIDs by comparing handles. Interning the same UUID
+     * value twice yields the same handle.
+     *
+     * @param[in] uuid
+     *              The UUID to intern.
+     *
+     * @return A handle for the interned UUID, or INVALID_INTERNED_HANDLE if
+     *         the registry already holds BLE_UUID_INTERN_TABLE_SIZE distinct
+     *         UUIDs.
+     *
+     * @note Interned UUIDs are never evicted; reserve the registry for
+     *       long-lived UUIDs such as those of the services and
+     *       characteristics the application operates on.
+     */
+    static InternedHandle_t intern(const UUID &uuid);
+
+    /**
+     * Fetch an interned UUID by its handle.
+     *
+     * @param[in] handle
+     *              A handle previously returned by intern().
+     *
+     * @return A pointer to the interned UUID, valid for the lifetime of the
+     *         program, or NULL if the handle is invalid.
+     */
+    static const UUID *getInterned(InternedHandle_t handle);
+
+private:
+    /* Holds the interned UUIDs; defined after the class because it contains
+     * UUID instances. */
+    struct InternRegistry_t;
+    static InternRegistry_t &internRegistry();
+
 private:
     /**
      * The UUID type. Refer to UUID_Type_t.
@@ -326,6 +409,43 @@ private:
      * The short UUID value.
      */
     ShortUUIDBytes_t shortUUID;
+    /**
+     * Hash of the UUID value, precomputed at setup. Refer to getHash().
+     */
+    uint32_t         hash;
 };
 
+struct UUID::InternRegistry_t {
+    InternRegistry_t() : count(0) { }
+    UUID uuids[BLE_UUID_INTERN_TABLE_SIZE];
+    unsigned count;
+};
+
+inline UUID::InternRegistry_t &UUID::internRegistry() {
+    static InternRegistry_t registry;
+    return registry;
+}
+
+inline UUID::InternedHandle_t UUID::intern(const UUID &uuid) {
+    InternRegistry_t &registry = internRegistry();
+    for (unsigned index = 0; index < registry.count; index++) {
+        if (registry.uuids[index] == uuid) {
+            return (InternedHandle_t)index;
+        }
+    }
+    if (registry.count == BLE_UUID_INTERN_TABLE_SIZE) {
+        return INVALID_INTERNED_HANDLE;
+    }
+    registry.uuids[registry.count] = uuid;
+    return (InternedHandle_t)registry.count++;
+}
+
+inline const UUID *UUID::getInterned(InternedHandle_t handle) {
+    InternRegistry_t &registry = internRegistry();
+    if (handle >= registry.count) {
+        return NULL;
+    }
+    return &registry.uuids[handle];
+}
+
 #endif // ifndef __UUID_H__
@@ -20,9 +20,33 @@
 #include <algorithm>
 #include "ble/GattClient.h"
 #include "ble/pal/PalGattClient.h"
+#include "ble/BLEProtocol.h"
+#include "ble/DiscoveredCharacteristic.h"
 
 // IMPORTANT: private header. Not part of the public interface.
 
+/**
+ * Number of peers for which the result of a complete service discovery can be
+ * cached. Refer to GenericGattClient::setDiscoveryCachePeer.
+ */
+#ifndef BLE_GATT_CLIENT_DISCOVERY_CACHE_ENTRIES
+#define BLE_GATT_CLIENT_DISCOVERY_CACHE_ENTRIES 2
+#endif
+
+/**
+ * Number of services which can be cached per peer.
+ */
+#ifndef BLE_GATT_CLIENT_DISCOVERY_CACHE_SERVICES
+#define BLE_GATT_CLIENT_DISCOVERY_CACHE_SERVICES 8
+#endif
+
+/**
+ * Number of characteristics which can be cached per peer.
+ */
+#ifndef BLE_GATT_CLIENT_DISCOVERY_CACHE_CHARACTERISTICS
+#define BLE_GATT_CLIENT_DISCOVERY_CACHE_CHARACTERISTICS 24
+#endif
+
 namespace ble {
 namespace generic {
 
@@ -129,6 +153,102 @@ public:
 	 */
     virtual ble_error_t reset(void);
 
+    /**
+     * Associate a connection with the identity of the peer at the other end,
+     * enabling the discovery cache for that connection.
+     *
+     * The first complete, unfiltered service discovery run over the
+     * connection is recorded in a cache entry keyed by the peer address.
+     * Subsequent calls to launchServiceDiscovery for a connection bound to
+     * the same peer - typically after a reconnection - are replayed from the
+     * cache without any ATT traffic or allocation: the registered callbacks
+     * are invoked synchronously with the cached attribute table, and the
+     * procedure terminates before launchServiceDiscovery returns.
+     *
+     * Call this right after the connection is established, with the peer's
+     * identity address for bonded peers.
+     *
+     * @param connection_handle Connection to bind.
+     * @param peer_address The (identity) address of the peer, used as the
+     *        cache key.
+     *
+     * @return BLE_ERROR_NONE if the connection was bound to a cache entry or
+     *         BLE_ERROR_NO_MEM if every entry is bound to another live
+     *         connection.
+     *
+     * @note The cache holds the attribute table in RAM only; it does not
+     *       track changes made by the peer to its GATT database. Register a
+     *       handler for the Service Changed characteristic and call
+     *       invalidateDiscoveryCache from it.
+     */
+    ble_error_t setDiscoveryCachePeer(
+        Gap::Handle_t connection_handle,
+        const BLEProtocol::AddressBytes_t peer_address
+    );
+
+    /**
+     * Drop the cached discovery results, if any, associated with a peer. The
+     * next service discovery over a connection bound to this peer goes out
+     * over the air and re-records the cache entry.
+     *
+     * @param peer_address The address the entry was recorded under.
+     */
+    void invalidateDiscoveryCache(const BLEProtocol::AddressBytes_t peer_address);
+
+    /**
+     * Indicate whether a service discovery launched over the given connection
+     * would be served from the discovery cache.
+     */
+    bool isDiscoveryCached(Gap::Handle_t connection_handle) const;
+
+private:
+    struct cached_service_t {
+        UUID uuid;
+        uint16_t begin;
+        uint16_t end;
+    };
+
+    struct cached_characteristic_t {
+        UUID uuid;
+        DiscoveredCharacteristic::Properties_t properties;
+        uint16_t decl_handle;
+        uint16_t value_handle;
+        uint16_t last_handle;
+        uint8_t service_index;
+    };
+
+    /*
+     * A cache entry outlives the connection it was recorded over; it remains
+     * keyed by the peer address until evicted or invalidated.
+     */
+    struct discovery_cache_entry_t {
+        BLEProtocol::AddressBytes_t peer_address;
+        Gap::Handle_t connection_handle;
+        bool in_use;    /* the entry is keyed to a peer */
+        bool bound;     /* connection_handle refers to a live connection */
+        bool valid;     /* services/characteristics are replayable */
+        bool recording;
+        uint8_t service_count;
+        uint8_t characteristic_count;
+        cached_service_t services[BLE_GATT_CLIENT_DISCOVERY_CACHE_SERVICES];
+        cached_characteristic_t characteristics[BLE_GATT_CLIENT_DISCOVERY_CACHE_CHARACTERISTICS];
+    };
+
+    discovery_cache_entry_t* cache_entry_for_connection(Gap::Handle_t connection);
+    const discovery_cache_entry_t* cache_entry_for_connection(Gap::Handle_t connection) const;
+    discovery_cache_entry_t* cache_entry_for_peer(const BLEProtocol::AddressBytes_t peer_address);
+    void cache_record_service(Gap::Handle_t connection, const UUID& uuid, uint16_t begin, uint16_t end);
+    void cache_record_characteristic(Gap::Handle_t connection, const DiscoveredCharacteristic& characteristic);
+    void cache_discovery_complete(Gap::Handle_t connection, bool success);
+    void replay_discovery_cache(
+        const discovery_cache_entry_t& entry,
+        Gap::Handle_t connection_handle,
+        ServiceDiscovery::ServiceCallback_t service_callback,
+        ServiceDiscovery::CharacteristicCallback_t characteristic_callback,
+        const UUID& matching_service_uuid,
+        const UUID& matching_characteristic_uuid
+    );
+
 private:
     procedure_control_block_t* get_control_block(Gap::Handle_t connection);
     const procedure_control_block_t* get_control_block(Gap::Handle_t connection) const;
@@ -146,6 +266,7 @@ private:
     pal::GattClient* const _pal_client;
     ServiceDiscovery::TerminationCallback_t _termination_callback;
     mutable procedure_control_block_t* control_blocks;
+    discovery_cache_entry_t _discovery_cache[BLE_GATT_CLIENT_DISCOVERY_CACHE_ENTRIES];
 };
 
 }
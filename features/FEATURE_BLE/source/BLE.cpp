@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <string.h>
+
 #include "ble/BLE.h"
 #include "ble/BLEInstanceBase.h"
 
@@ -143,6 +145,8 @@ BLE::BLE(InstanceID_t instanceIDIn) : instanceID(instanceIDIn), transport(),
 {
     static BLEInstanceBase *transportInstances[NUM_INSTANCES];
 
+    memset(linkTelemetry, 0, sizeof(linkTelemetry));
+
     if (instanceID < NUM_INSTANCES) {
         if (!transportInstances[instanceID]) {
             transportInstances[instanceID] = instanceConstructors[instanceID](); /* Call the stack's initializer for the transport object. */
@@ -21,7 +21,8 @@ GapScanningParams::GapScanningParams(uint16_t interval, uint16_t window, uint16_
     _interval(MSEC_TO_SCAN_DURATION_UNITS(interval)),
     _window(MSEC_TO_SCAN_DURATION_UNITS(window)),
     _timeout(timeout),
-    _activeScanning(activeScanning) {
+    _activeScanning(activeScanning),
+    _duplicateFilterWindow(0) {
     /* stay within limits */
     if (_interval < SCAN_INTERVAL_MIN) {
         _interval = SCAN_INTERVAL_MIN;
@@ -73,3 +74,9 @@ GapScanningParams::setActiveScanning(bool activeScanning)
 {
     _activeScanning = activeScanning;
 }
+
+void
+GapScanningParams::setDuplicateFilterWindow(uint16_t windowInMS)
+{
+    _duplicateFilterWindow = windowInMS;
+}
@@ -96,7 +96,8 @@ struct discovery_control_block_t : public procedure_control_block_t {
 		matching_service_uuid(matching_service_uuid),
 		matching_characteristic_uuid(matching_characteristic_uuid),
 		services_discovered(NULL),
-		done(false) {
+		done(false),
+		error(false) {
 	}
 
 	virtual ~discovery_control_block_t() {
@@ -108,6 +109,7 @@ struct discovery_control_block_t : public procedure_control_block_t {
 	}
 
 	virtual void handle_timeout_error(GenericGattClient* client) {
+		error = true;
 		terminate(client);
 	}
 
@@ -135,12 +137,13 @@ struct discovery_control_block_t : public procedure_control_block_t {
 				);
 			    break;
 			case AttributeOpcode::ERROR_RESPONSE: {
-				const AttErrorResponse& error = static_cast<const AttErrorResponse&>(message);
-				if (error.error_code != AttErrorResponse::ATTRIBUTE_NOT_FOUND) {
+				const AttErrorResponse& error_response = static_cast<const AttErrorResponse&>(message);
+				if (error_response.error_code != AttErrorResponse::ATTRIBUTE_NOT_FOUND) {
+					error = true;
 					terminate(client);
 				}
 
-				switch (error.request_opcode) {
+				switch (error_response.request_opcode) {
 					case AttributeOpcode::READ_BY_GROUP_TYPE_REQUEST:
 					case AttributeOpcode::FIND_BY_TYPE_VALUE_REQUEST:
 						start_characteristic_discovery(client);
@@ -182,6 +185,7 @@ struct discovery_control_block_t : public procedure_control_block_t {
 				);
 
 				if (discovered_service == NULL) {
+					error = true;
 					terminate(client);
 					return;
 				}
@@ -198,6 +202,7 @@ struct discovery_control_block_t : public procedure_control_block_t {
 			);
 
 			if (err) {
+				error = true;
 				terminate(client);
 			}
 		}
@@ -214,6 +219,13 @@ struct discovery_control_block_t : public procedure_control_block_t {
 			return;
 		}
 
+		client->cache_record_service(
+			connection_handle,
+			services_discovered->uuid,
+			services_discovered->begin,
+			services_discovered->end
+		);
+
 		if (service_callback) {
 			DiscoveredService discovered_service;
 			discovered_service.setup(
@@ -238,6 +250,7 @@ struct discovery_control_block_t : public procedure_control_block_t {
 		for (size_t i = 0; i < response.size(); ++i) {
 			if (last_characteristic.is_valid() == false) {
 				last_characteristic.set_last_handle(response[i].handle - 1);
+				client->cache_record_characteristic(connection_handle, last_characteristic);
 				if (matching_characteristic_uuid == UUID()
 				|| last_characteristic.getUUID() == matching_characteristic_uuid) {
 					characteristic_callback(&last_characteristic);
@@ -262,6 +275,7 @@ struct discovery_control_block_t : public procedure_control_block_t {
 			);
 
 			if (err) {
+				error = true;
 				terminate(client);
 			}
 		}
@@ -269,9 +283,10 @@ struct discovery_control_block_t : public procedure_control_block_t {
 
 	void handle_all_characteristics_discovered(GenericGattClient* client) {
 		if (last_characteristic.is_valid() == false) {
+			last_characteristic.set_last_handle(services_discovered->end);
+			client->cache_record_characteristic(connection_handle, last_characteristic);
 			if (matching_characteristic_uuid == UUID()
 				|| matching_characteristic_uuid == last_characteristic.getUUID()) {
-				last_characteristic.set_last_handle(services_discovered->end);
 				characteristic_callback(&last_characteristic);
 			}
 		}
@@ -291,7 +306,9 @@ struct discovery_control_block_t : public procedure_control_block_t {
 		// unknown error, terminate the procedure immediately
 		client->remove_control_block(this);
 		Gap::Handle_t handle = connection_handle;
+		bool success = !error && !done;
 		delete this;
+		client->cache_discovery_complete(handle, success);
 		client->on_termination(handle);
 	}
 
@@ -406,6 +423,31 @@ struct discovery_control_block_t : public procedure_control_block_t {
 	service_t* services_discovered;
 	characteristic_t last_characteristic;
 	bool done;
+	bool error;
+};
+
+/*
+ * A DiscoveredCharacteristic rebuilt from the discovery cache; used to replay
+ * a cached discovery through the characteristic callback.
+ */
+struct cached_characteristic_view_t : DiscoveredCharacteristic {
+	cached_characteristic_view_t(
+		GattClient* client,
+		Gap::Handle_t connection_handle,
+		const UUID& cached_uuid,
+		DiscoveredCharacteristic::Properties_t cached_properties,
+		uint16_t decl_handle,
+		uint16_t value_handle,
+		uint16_t last_handle
+	) : DiscoveredCharacteristic() {
+		gattc = client;
+		uuid = cached_uuid;
+		props = cached_properties;
+		declHandle = decl_handle;
+		valueHandle = value_handle;
+		lastHandle = last_handle;
+		connHandle = connection_handle;
+	}
 };
 
 
@@ -893,6 +935,12 @@ GenericGattClient::GenericGattClient(pal::GattClient* pal_client) :
 	_pal_client(pal_client),
 	_termination_callback(),
 	 control_blocks(NULL) {
+	for (size_t i = 0; i < BLE_GATT_CLIENT_DISCOVERY_CACHE_ENTRIES; ++i) {
+		_discovery_cache[i].in_use = false;
+		_discovery_cache[i].bound = false;
+		_discovery_cache[i].valid = false;
+		_discovery_cache[i].recording = false;
+	}
 	_pal_client->when_server_message_received(
 		mbed::callback(this, &GenericGattClient::on_server_message_received)
 	);
@@ -919,6 +967,33 @@ ble_error_t GenericGattClient::launchServiceDiscovery(
 		return BLE_ERROR_NONE;
 	}
 
+	// serve the discovery from the cache when the peer's attribute table is
+	// known; no request leaves the device and nothing is allocated
+	discovery_cache_entry_t* cache_entry = cache_entry_for_connection(connection_handle);
+	if (cache_entry && cache_entry->valid) {
+		replay_discovery_cache(
+			*cache_entry,
+			connection_handle,
+			service_callback,
+			characteristic_callback,
+			matching_service_uuid,
+			matching_characteristic_uuid
+		);
+		on_termination(connection_handle);
+		return BLE_ERROR_NONE;
+	}
+
+	// record complete, unfiltered discoveries into the bound cache entry
+	if (cache_entry &&
+		characteristic_callback &&
+		matching_service_uuid == UUID() &&
+		matching_characteristic_uuid == UUID()) {
+		cache_entry->recording = true;
+		cache_entry->valid = false;
+		cache_entry->service_count = 0;
+		cache_entry->characteristic_count = 0;
+	}
+
 	discovery_control_block_t* discovery_pcb = new(std::nothrow) discovery_control_block_t(
 		connection_handle,
 		service_callback,
@@ -928,6 +1003,7 @@ ble_error_t GenericGattClient::launchServiceDiscovery(
 	);
 
 	if (discovery_pcb == NULL) {
+		cache_discovery_complete(connection_handle, false);
 		return BLE_ERROR_NO_MEM;
 	}
 
@@ -953,6 +1029,7 @@ ble_error_t GenericGattClient::launchServiceDiscovery(
 	if (err) {
 		remove_control_block(discovery_pcb);
 		delete discovery_pcb;
+		cache_discovery_complete(connection_handle, false);
 	}
 
 	return err;
@@ -1189,6 +1266,190 @@ ble_error_t GenericGattClient::reset(void) {
 	return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+ble_error_t GenericGattClient::setDiscoveryCachePeer(
+	Gap::Handle_t connection_handle,
+	const BLEProtocol::AddressBytes_t peer_address
+) {
+	// a connection refers to at most one cache entry; unbind stale bindings
+	// left by a previous connection with the same handle
+	for (size_t i = 0; i < BLE_GATT_CLIENT_DISCOVERY_CACHE_ENTRIES; ++i) {
+		if (_discovery_cache[i].in_use &&
+			_discovery_cache[i].bound &&
+			_discovery_cache[i].connection_handle == connection_handle) {
+			_discovery_cache[i].bound = false;
+			_discovery_cache[i].recording = false;
+		}
+	}
+
+	discovery_cache_entry_t* entry = cache_entry_for_peer(peer_address);
+	if (entry == NULL) {
+		// allocate a free entry, or failing that evict one which is not
+		// bound to a live connection
+		for (size_t i = 0; (entry == NULL) && (i < BLE_GATT_CLIENT_DISCOVERY_CACHE_ENTRIES); ++i) {
+			if (!_discovery_cache[i].in_use) {
+				entry = &_discovery_cache[i];
+			}
+		}
+		for (size_t i = 0; (entry == NULL) && (i < BLE_GATT_CLIENT_DISCOVERY_CACHE_ENTRIES); ++i) {
+			if (!_discovery_cache[i].bound) {
+				entry = &_discovery_cache[i];
+			}
+		}
+		if (entry == NULL) {
+			return BLE_ERROR_NO_MEM;
+		}
+
+		memcpy(entry->peer_address, peer_address, sizeof(BLEProtocol::AddressBytes_t));
+		entry->in_use = true;
+		entry->valid = false;
+		entry->recording = false;
+		entry->service_count = 0;
+		entry->characteristic_count = 0;
+	}
+
+	entry->connection_handle = connection_handle;
+	entry->bound = true;
+	return BLE_ERROR_NONE;
+}
+
+void GenericGattClient::invalidateDiscoveryCache(const BLEProtocol::AddressBytes_t peer_address) {
+	discovery_cache_entry_t* entry = cache_entry_for_peer(peer_address);
+	if (entry) {
+		entry->valid = false;
+		entry->recording = false;
+	}
+}
+
+bool GenericGattClient::isDiscoveryCached(Gap::Handle_t connection_handle) const {
+	const discovery_cache_entry_t* entry = cache_entry_for_connection(connection_handle);
+	return entry && entry->valid;
+}
+
+GenericGattClient::discovery_cache_entry_t* GenericGattClient::cache_entry_for_connection(Gap::Handle_t connection) {
+	for (size_t i = 0; i < BLE_GATT_CLIENT_DISCOVERY_CACHE_ENTRIES; ++i) {
+		if (_discovery_cache[i].in_use &&
+			_discovery_cache[i].bound &&
+			_discovery_cache[i].connection_handle == connection) {
+			return &_discovery_cache[i];
+		}
+	}
+	return NULL;
+}
+
+const GenericGattClient::discovery_cache_entry_t* GenericGattClient::cache_entry_for_connection(Gap::Handle_t connection) const {
+	return const_cast<GenericGattClient*>(this)->cache_entry_for_connection(connection);
+}
+
+GenericGattClient::discovery_cache_entry_t* GenericGattClient::cache_entry_for_peer(const BLEProtocol::AddressBytes_t peer_address) {
+	for (size_t i = 0; i < BLE_GATT_CLIENT_DISCOVERY_CACHE_ENTRIES; ++i) {
+		if (_discovery_cache[i].in_use &&
+			memcmp(_discovery_cache[i].peer_address, peer_address, sizeof(BLEProtocol::AddressBytes_t)) == 0) {
+			return &_discovery_cache[i];
+		}
+	}
+	return NULL;
+}
+
+void GenericGattClient::cache_record_service(
+	Gap::Handle_t connection, const UUID& uuid, uint16_t begin, uint16_t end
+) {
+	discovery_cache_entry_t* entry = cache_entry_for_connection(connection);
+	if (entry == NULL || !entry->recording) {
+		return;
+	}
+
+	if (entry->service_count == BLE_GATT_CLIENT_DISCOVERY_CACHE_SERVICES) {
+		// the peer's attribute table does not fit; abandon the recording
+		entry->recording = false;
+		return;
+	}
+
+	cached_service_t& service = entry->services[entry->service_count++];
+	service.uuid = uuid;
+	service.begin = begin;
+	service.end = end;
+}
+
+void GenericGattClient::cache_record_characteristic(
+	Gap::Handle_t connection, const DiscoveredCharacteristic& characteristic
+) {
+	discovery_cache_entry_t* entry = cache_entry_for_connection(connection);
+	if (entry == NULL || !entry->recording || entry->service_count == 0) {
+		return;
+	}
+
+	if (entry->characteristic_count == BLE_GATT_CLIENT_DISCOVERY_CACHE_CHARACTERISTICS) {
+		entry->recording = false;
+		return;
+	}
+
+	cached_characteristic_t& cached = entry->characteristics[entry->characteristic_count++];
+	cached.uuid = characteristic.getUUID();
+	cached.properties = characteristic.getProperties();
+	cached.decl_handle = characteristic.getDeclHandle();
+	cached.value_handle = characteristic.getValueHandle();
+	cached.last_handle = characteristic.getLastHandle();
+	cached.service_index = entry->service_count - 1;
+}
+
+void GenericGattClient::cache_discovery_complete(Gap::Handle_t connection, bool success) {
+	discovery_cache_entry_t* entry = cache_entry_for_connection(connection);
+	if (entry == NULL || !entry->recording) {
+		return;
+	}
+
+	entry->recording = false;
+	entry->valid = success;
+}
+
+void GenericGattClient::replay_discovery_cache(
+	const discovery_cache_entry_t& entry,
+	Gap::Handle_t connection_handle,
+	ServiceDiscovery::ServiceCallback_t service_callback,
+	ServiceDiscovery::CharacteristicCallback_t characteristic_callback,
+	const UUID& matching_service_uuid,
+	const UUID& matching_characteristic_uuid
+) {
+	for (uint8_t s = 0; s < entry.service_count; ++s) {
+		const cached_service_t& service = entry.services[s];
+
+		if (matching_service_uuid != UUID() && !(service.uuid == matching_service_uuid)) {
+			continue;
+		}
+
+		if (service_callback) {
+			DiscoveredService discovered_service;
+			discovered_service.setup(service.uuid, service.begin, service.end);
+			service_callback(&discovered_service);
+		}
+
+		if (!characteristic_callback) {
+			continue;
+		}
+
+		for (uint8_t c = 0; c < entry.characteristic_count; ++c) {
+			const cached_characteristic_t& cached = entry.characteristics[c];
+			if (cached.service_index != s) {
+				continue;
+			}
+			if (matching_characteristic_uuid != UUID() && !(cached.uuid == matching_characteristic_uuid)) {
+				continue;
+			}
+
+			cached_characteristic_view_t characteristic(
+				this,
+				connection_handle,
+				cached.uuid,
+				cached.properties,
+				cached.decl_handle,
+				cached.value_handle,
+				cached.last_handle
+			);
+			characteristic_callback(&characteristic);
+		}
+	}
+}
+
 void GenericGattClient::on_termination(Gap::Handle_t connection_handle) {
 	if (_termination_callback) {
 		_termination_callback(connection_handle);
@@ -24,7 +24,9 @@
  *
  * **not safe to use for security or cryptographic operations.**
  *
- * Base implementation is a pseudo-RNG, but may also use a system RNG.
+ * Base implementation is a pseudo-RNG, seeded once from a hardware or
+ * system randomness source. Every draw is then served from the PRNG, so
+ * the random source is never touched in per-packet timer math.
  * Replay of sequence by reseeding is not possible.
  *
  * Base pseudo-RNG is the xoroshiro128+ generator by Marsaglia, Blackman and
@@ -38,23 +40,21 @@
  * do try to keep the operations narrow.
  */
 
-/* On some platforms, read from a system RNG, rather than use our own */
-/* RANDLIB_PRNG disables this and forces use of the PRNG (useful for test only?) */
+/* On some platforms, seed from a system RNG, rather than the platform seed */
+/* RANDLIB_PRNG disables this and forces use of the platform seed (useful for test only?) */
 #ifndef RANDLIB_PRNG
 #ifdef __linux
 #define RANDOM_DEVICE "/dev/urandom"
 #endif
 #endif // RANDLIB_PRNG
 
-/* RAM usage - 16 bytes of state (or a FILE * pointer and underlying FILE, which
- * will include a buffer) */
 #ifdef RANDOM_DEVICE
 #include <stdio.h>
-static FILE *random_file;
-#else
-static uint64_t state[2];
 #endif
 
+/* RAM usage - 16 bytes of state */
+static uint64_t state[2];
+
 #ifdef RANDLIB_PRNG
 void randLIB_reset(void)
 {
@@ -63,7 +63,6 @@ void randLIB_reset(void)
 }
 #endif
 
-#ifndef RANDOM_DEVICE
 static inline uint64_t rol(uint64_t n, int bits)
 {
     return (n << bits) | (n >> (64 - bits));
@@ -80,13 +79,25 @@ static uint64_t splitmix64(uint64_t *seed)
     z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
     return z ^ (z >> 31);
 }
-#endif // RANDOM_DEVICE
 
 void randLIB_seed_random(void)
 {
 #ifdef RANDOM_DEVICE
-    if (!random_file) {
-        random_file = fopen(RANDOM_DEVICE, "rb");
+    /* Read the system RNG once to seed our own generator, rather than
+     * for every draw. Exclusive-OR as below, to not lose any entropy
+     * from earlier seeding. */
+    FILE *random_file = fopen(RANDOM_DEVICE, "rb");
+    if (random_file) {
+        uint64_t seed[2];
+        if (fread(seed, sizeof seed[0], 2, random_file) == 2) {
+            state[0] ^= seed[0];
+            state[1] ^= seed[1];
+        }
+        fclose(random_file);
+    }
+
+    if (state[0] == state[1]) {
+        randLIB_add_seed(state[0]);
     }
 #else
     arm_random_module_init();
@@ -114,14 +125,12 @@ void randLIB_seed_random(void)
 
 void randLIB_add_seed(uint64_t seed)
 {
-#ifndef RANDOM_DEVICE
     state[0] ^= splitmix64(&seed);
     state[1] ^= splitmix64(&seed);
     /* This is absolutely necessary, but I challenge you to add it to line coverage */
     if (state[1] == 0 && state[0] == 0) {
         state[0] = 1;
     }
-#endif
 }
 
 uint8_t randLIB_get_8bit(void)
@@ -145,16 +154,6 @@ uint32_t randLIB_get_32bit(void)
 
 uint64_t randLIB_get_64bit(void)
 {
-#ifdef RANDOM_DEVICE
-    if (!random_file) {
-        return 0;
-    }
-    uint64_t result;
-    if (fread(&result, sizeof result, 1, random_file) != 1) {
-        result = 0;
-    }
-    return result;
-#else
     const uint64_t s0 = state[0];
     uint64_t s1 = state[1];
     const uint64_t result = s0 + s1;
@@ -164,7 +163,6 @@ uint64_t randLIB_get_64bit(void)
     state[1] = rol(s1, 36);
 
     return result;
-#endif
 }
 
 void *randLIB_get_n_bytes_random(void *ptr, uint8_t count)
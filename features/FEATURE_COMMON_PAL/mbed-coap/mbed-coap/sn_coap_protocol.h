@@ -144,6 +144,22 @@ extern int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time
  */
 extern int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t block_size);
 
+/**
+ * \fn int8_t sn_coap_protocol_set_blockwise_nstart(uint8_t nstart)
+ *
+ * \brief If block transfer is enabled, this function changes the number of block
+ *  requests kept in flight while receiving a blockwise (Block2) response. Value 1
+ *  requests the blocks one at a time; a larger window pipelines the block requests
+ *  so that the per-block round trip time is paid only once per window. Received
+ *  blocks are reassembled in block number order, so reordering caused by the
+ *  pipelining is tolerated.
+ *
+ * \param uint8_t nstart number of simultaneous block requests, 1 - 8
+ * \return  0 = success
+ *          -1 = failure
+ */
+extern int8_t sn_coap_protocol_set_blockwise_nstart(struct coap_s *handle, uint8_t nstart);
+
 /**
  * \fn int8_t sn_coap_protocol_set_duplicate_buffer_size(uint8_t message_count)
  *
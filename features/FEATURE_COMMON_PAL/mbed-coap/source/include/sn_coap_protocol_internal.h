@@ -97,6 +97,13 @@ struct sn_coap_hdr_;
 /* Maximum time in seconds of messages to be stored for duplication detection */
 #define SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED    60 /* RESPONSE_TIMEOUT * RESPONSE_RANDOM_FACTOR * (2 ^ MAX_RETRANSMIT - 1) + the expected maximum round trip time */
 
+/* Number of hash buckets in the duplication info store. Must be a power of two. */
+/* Buckets are selected by source address and port, so each peer's messages land */
+/* in one bucket and a bursting peer cannot flush other peers' duplication info  */
+#ifndef SN_COAP_DUPLICATION_HASH_BUCKETS
+#define SN_COAP_DUPLICATION_HASH_BUCKETS            8
+#endif
+
 /* * For Message blockwising * */
 
 /* Init value for the maximum payload size to be sent and received at one blockwise message                         */
@@ -131,6 +138,23 @@ struct sn_coap_hdr_;
 #define SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE UINT16_MAX
 #endif
 
+/* Init value for the number of block (Block2) requests kept in flight when receiving     */
+/* a blockwise response. 1 keeps the classic request-by-request behaviour; a larger       */
+/* window pipelines the block requests and hides the per-block round trip time            */
+
+#ifdef YOTTA_CFG_COAP_BLOCKWISE_NSTART
+#define SN_COAP_BLOCKWISE_NSTART YOTTA_CFG_COAP_BLOCKWISE_NSTART
+#elif defined MBED_CONF_MBED_CLIENT_SN_COAP_BLOCKWISE_NSTART
+#define SN_COAP_BLOCKWISE_NSTART MBED_CONF_MBED_CLIENT_SN_COAP_BLOCKWISE_NSTART
+#endif
+
+#ifndef SN_COAP_BLOCKWISE_NSTART
+#define SN_COAP_BLOCKWISE_NSTART                    1  /**< Number of simultaneous outgoing block requests */
+#endif
+
+/* Maximum allowed pipelining window application can set with API */
+#define SN_COAP_MAX_ALLOWED_BLOCKWISE_NSTART        8
+
 /* * For Option handling * */
 #define COAP_OPTION_MAX_AGE_DEFAULT                 60 /**< Default value of Max-Age if option not present */
 #define COAP_OPTION_URI_PORT_NONE                   (-1) /**< Internal value to represent no Uri-Port option */
@@ -165,10 +189,12 @@ typedef struct coap_duplication_info_ {
     struct coap_s       *coap;  /* CoAP library handle */
     sn_nsdl_addr_s      *address;
     void                *param;
-    ns_list_link_t      link;
+    ns_list_link_t      link;      /* Age-ordered list, oldest first */
+    ns_list_link_t      hash_link; /* Hash bucket, selected by source address and port */
 } coap_duplication_info_s;
 
 typedef NS_LIST_HEAD(coap_duplication_info_s, link) coap_duplication_info_list_t;
+typedef NS_LIST_HEAD(coap_duplication_info_s, hash_link) coap_duplication_hash_list_t;
 
 /* Structure which is stored to Linked list for blockwise messages sending purposes */
 typedef struct coap_blockwise_msg_ {
@@ -190,6 +216,7 @@ typedef struct coap_blockwise_payload_ {
     uint8_t             *addr_ptr;
     uint16_t            port;
     uint32_t            block_number;
+    bool                last_block; /* The block was received without the more bit */
 
     uint16_t            payload_len;
     uint8_t             *payload_ptr;
@@ -213,7 +240,8 @@ struct coap_s {
     #endif
 
     #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
-        coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list */
+        coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list, in age order */
+        coap_duplication_hash_list_t  duplication_hash_tbl[SN_COAP_DUPLICATION_HASH_BUCKETS]; /* Hashed index over the same messages for O(1) duplicate lookup */
         uint16_t                      count_duplication_msgs;
     #endif
 
@@ -229,6 +257,7 @@ struct coap_s {
     uint8_t sn_coap_resending_count;
     uint8_t sn_coap_resending_intervall;
     uint8_t sn_coap_duplication_buffer_size;
+    uint8_t sn_coap_blockwise_nstart;
 };
 
 #ifdef __cplusplus
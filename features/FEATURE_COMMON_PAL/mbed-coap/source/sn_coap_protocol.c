@@ -49,14 +49,15 @@
 
 static void                  sn_coap_protocol_send_rst(struct coap_s *handle, uint16_t msg_id, sn_nsdl_addr_s *addr_ptr, void *param);
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT/* If Message duplication detection is not used at all, this part of code will not be compiled */
+static uint_fast8_t          sn_coap_protocol_duplication_info_hash(const uint8_t *addr_ptr, uint8_t addr_len, uint16_t port);
 static void                  sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id, void *param);
 static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(struct coap_s *handle, sn_nsdl_addr_s *scr_addr_ptr, uint16_t msg_id);
-static void                  sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *scr_addr_ptr, uint16_t port, uint16_t msg_id);
+static void                  sn_coap_protocol_duplication_info_free(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr);
 static void                  sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle);
 #endif
 #if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is not used at all, this part of code will not be compiled */
 static void                  sn_coap_protocol_linked_list_blockwise_msg_remove(struct coap_s *handle, coap_blockwise_msg_s *removed_msg_ptr);
-static void                  sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t stored_payload_len, uint8_t *stored_payload_ptr, uint32_t block_number);
+static void                  sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t stored_payload_len, uint8_t *stored_payload_ptr, uint32_t block_number, bool last_block);
 static uint8_t              *sn_coap_protocol_linked_list_blockwise_payload_search(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t *payload_length);
 static bool                  sn_coap_protocol_linked_list_blockwise_payload_compare_block_number(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint32_t block_number);
 static void                  sn_coap_protocol_linked_list_blockwise_payload_remove(struct coap_s *handle, coap_blockwise_payload_s *removed_payload_ptr);
@@ -64,6 +65,9 @@ static void                  sn_coap_protocol_linked_list_blockwise_payload_remo
 static uint32_t              sn_coap_protocol_linked_list_blockwise_payloads_get_len(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr);
 static void                  sn_coap_protocol_linked_list_blockwise_remove_old_data(struct coap_s *handle);
 static sn_coap_hdr_s        *sn_coap_handle_blockwise_message(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param);
+static int8_t                sn_coap_protocol_send_block2_request(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint32_t block_number, uint8_t block_temp, void *param);
+static bool                  sn_coap_protocol_blockwise_transfer_complete(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr);
+static sn_coap_hdr_s        *sn_coap_protocol_blockwise_assemble(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr);
 static int8_t                sn_coap_convert_block_size(uint16_t block_size);
 static sn_coap_hdr_s        *sn_coap_protocol_copy_header(struct coap_s *handle, sn_coap_hdr_s *source_header_ptr);
 #endif
@@ -96,21 +100,7 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     ns_list_foreach_safe(coap_duplication_info_s, tmp, &handle->linked_list_duplication_msgs) {
         if (tmp->coap == handle) {
-            if (tmp->address) {
-                if (tmp->address->addr_ptr) {
-                    handle->sn_coap_protocol_free(tmp->address->addr_ptr);
-                    tmp->address->addr_ptr = 0;
-                }
-                handle->sn_coap_protocol_free(tmp->address);
-                tmp->address = 0;
-            }
-            if (tmp->packet_ptr) {
-                handle->sn_coap_protocol_free(tmp->packet_ptr);
-                tmp->packet_ptr = 0;
-            }
-            ns_list_remove(&handle->linked_list_duplication_msgs, tmp);
-            handle->count_duplication_msgs--;
-            handle->sn_coap_protocol_free(tmp);
+            sn_coap_protocol_duplication_info_free(handle, tmp);
             tmp = 0;
         }
     }
@@ -197,8 +187,11 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 #endif /* ENABLE_RESENDINGS */
 
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
-    /* * * * Create Linked list for storing Duplication info * * * */
+    /* * * * Create Linked list and hashed index for storing Duplication info * * * */
     ns_list_init(&handle->linked_list_duplication_msgs);
+    for (uint_fast8_t i = 0; i < SN_COAP_DUPLICATION_HASH_BUCKETS; i++) {
+        ns_list_init(&handle->duplication_hash_tbl[i]);
+    }
     handle->sn_coap_duplication_buffer_size = SN_COAP_DUPLICATION_MAX_MSGS_COUNT;
 #endif
 
@@ -207,6 +200,7 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
     ns_list_init(&handle->linked_list_blockwise_sent_msgs);
     ns_list_init(&handle->linked_list_blockwise_received_payloads);
     handle->sn_coap_block_data_size = SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE;
+    handle->sn_coap_blockwise_nstart = SN_COAP_BLOCKWISE_NSTART;
 
 #endif /* ENABLE_RESENDINGS */
 
@@ -247,6 +241,22 @@ int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t block_siz
 
 }
 
+int8_t sn_coap_protocol_set_blockwise_nstart(struct coap_s *handle, uint8_t nstart)
+{
+    (void) handle;
+    (void) nstart;
+#if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    if (handle == NULL) {
+        return -1;
+    }
+    if (nstart >= 1 && nstart <= SN_COAP_MAX_ALLOWED_BLOCKWISE_NSTART) {
+        handle->sn_coap_blockwise_nstart = nstart;
+        return 0;
+    }
+#endif
+    return -1;
+}
+
 int8_t sn_coap_protocol_set_duplicate_buffer_size(struct coap_s *handle, uint8_t message_count)
 {
     (void) handle;
@@ -637,14 +647,8 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
 
             /* Check if there is no room to store message for duplication detection purposes */
             if (stored_duplication_msgs_count >= handle->sn_coap_duplication_buffer_size) {
-                /* Get oldest stored duplication message */
-                coap_duplication_info_s *stored_duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs);
-
                 /* Remove oldest stored duplication message for getting room for new duplication message */
-                sn_coap_protocol_linked_list_duplication_info_remove(handle,
-                                                                     stored_duplication_info_ptr->address->addr_ptr,
-                                                                     stored_duplication_info_ptr->address->port,
-                                                                     stored_duplication_info_ptr->msg_id);
+                sn_coap_protocol_duplication_info_free(handle, ns_list_get_first(&handle->linked_list_duplication_msgs));
             }
 
             /* Store Duplication info to Linked list */
@@ -1019,10 +1023,39 @@ static void sn_coap_protocol_send_rst(struct coap_s *handle, uint16_t msg_id, sn
 }
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
 
+/**************************************************************************//**
+ * \fn static uint_fast8_t sn_coap_protocol_duplication_info_hash(const uint8_t *addr_ptr, uint8_t addr_len, uint16_t port)
+ *
+ * \brief Selects a duplication store hash bucket by source address and port
+ *
+ * Hashing by peer keeps all of one peer's messages in a single bucket, so a
+ * bursting peer churns only its own partition of the store.
+ *
+ * \param *addr_ptr is pointer to source address
+ * \param addr_len is length of source address
+ * \param port is source port
+ *
+ * \return hash bucket index
+ *****************************************************************************/
+
+static uint_fast8_t sn_coap_protocol_duplication_info_hash(const uint8_t *addr_ptr, uint8_t addr_len, uint16_t port)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+
+    for (uint_fast8_t i = 0; i < addr_len; i++) {
+        hash = (hash ^ addr_ptr[i]) * 16777619u;
+    }
+    hash = (hash ^ (port & 0xff)) * 16777619u;
+    hash = (hash ^ (port >> 8)) * 16777619u;
+
+    return (hash ^ (hash >> 16)) & (SN_COAP_DUPLICATION_HASH_BUCKETS - 1);
+}
+
 /**************************************************************************//**
  * \fn static void sn_coap_protocol_linked_list_duplication_info_store(sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
  *
- * \brief Stores Duplication info to Linked list
+ * \brief Stores Duplication info to the duplication store
  *
  * \param msg_id is Message ID to be stored
  * \param *addr_ptr is pointer to Address information to be stored
@@ -1032,6 +1065,20 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
         uint16_t msg_id, void *param)
 {
     coap_duplication_info_s *stored_duplication_info_ptr = NULL;
+    uint_fast8_t bucket = sn_coap_protocol_duplication_info_hash(addr_ptr->addr_ptr, addr_ptr->addr_len, addr_ptr->port);
+
+    /* * * * Enforce the per-peer partition bound * * * */
+
+    /* A single peer (bucket) may hold at most half of the whole store, so a
+     * message burst from one peer cannot flush the other peers' entries */
+    uint_fast8_t bucket_cap = handle->sn_coap_duplication_buffer_size / 2;
+    if (bucket_cap == 0) {
+        bucket_cap = 1;
+    }
+    if (ns_list_count(&handle->duplication_hash_tbl[bucket]) >= bucket_cap) {
+        /* Remove oldest entry of this bucket for getting room for the new one */
+        sn_coap_protocol_duplication_info_free(handle, ns_list_get_first(&handle->duplication_hash_tbl[bucket]));
+    }
 
     /* * * * Allocating memory for stored Duplication info * * * */
 
@@ -1075,16 +1122,20 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
     stored_duplication_info_ptr->coap = handle;
 
     stored_duplication_info_ptr->param = param;
-    /* * * * Storing Duplication info to Linked list * * * */
+    /* * * * Storing Duplication info to age-ordered list and hashed index * * * */
 
     ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
+    ns_list_add_to_end(&handle->duplication_hash_tbl[bucket], stored_duplication_info_ptr);
     ++handle->count_duplication_msgs;
 }
 
 /**************************************************************************//**
  * \fn static int8_t sn_coap_protocol_linked_list_duplication_info_search(sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
  *
- * \brief Searches stored message from Linked list (Address and Message ID as key)
+ * \brief Searches stored message from the duplication store (Address and Message ID as key)
+ *
+ * Only the peer's hash bucket is scanned, and the per-peer bound keeps the
+ * bucket length constant, so the lookup cost does not grow with the store.
  *
  * \param *addr_ptr is pointer to Address key to be searched
  * \param msg_id is Message ID key to be searched
@@ -1095,8 +1146,10 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
 static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_search(struct coap_s *handle,
         sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
 {
-    /* Loop all nodes in Linked list for searching Message ID */
-    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+    uint_fast8_t bucket = sn_coap_protocol_duplication_info_hash(addr_ptr->addr_ptr, addr_ptr->addr_len, addr_ptr->port);
+
+    /* Loop the peer's hash bucket for searching Message ID */
+    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->duplication_hash_tbl[bucket]) {
         /* If message's Message ID is same than is searched */
         if (stored_duplication_info_ptr->msg_id == msg_id) {
             /* If message's Source address is same than is searched */
@@ -1113,74 +1166,50 @@ static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_se
 }
 
 /**************************************************************************//**
- * \fn static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *addr_ptr, uint16_t port, uint16_t msg_id)
- *
- * \brief Removes stored Duplication info from Linked list
- *
- * \param *addr_ptr is pointer to Address key to be removed
+ * \fn static void sn_coap_protocol_duplication_info_free(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr)
  *
- * \param port is Port key to be removed
+ * \brief Removes stored Duplication info from the duplication store and frees it
  *
- * \param msg_id is Message ID key to be removed
+ * \param *removed_duplication_info_ptr is pointer to Duplication info to be removed
  *****************************************************************************/
 
-static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *addr_ptr, uint16_t port, uint16_t msg_id)
+static void sn_coap_protocol_duplication_info_free(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr)
 {
-    /* Loop all stored duplication messages in Linked list */
-    ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        /* If message's Address is same than is searched */
-        if (handle == removed_duplication_info_ptr->coap && 0 == memcmp(addr_ptr,
-                                                                        removed_duplication_info_ptr->address->addr_ptr,
-                                                                        removed_duplication_info_ptr->address->addr_len)) {
-            /* If message's Address prt is same than is searched */
-            if (removed_duplication_info_ptr->address->port == port) {
-                /* If Message ID is same than is searched */
-                if (removed_duplication_info_ptr->msg_id == msg_id) {
-                    /* * * * Correct Duplication info found, remove it from Linked list * * * */
-                    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-                    --handle->count_duplication_msgs;
-
-                    /* Free memory of stored Duplication info */
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
-                    removed_duplication_info_ptr->address->addr_ptr = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
-                    removed_duplication_info_ptr->address = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
-                    removed_duplication_info_ptr->packet_ptr = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr);
-                    removed_duplication_info_ptr = 0;
-                    return;
-                }
-            }
-        }
-    }
+    uint_fast8_t bucket = sn_coap_protocol_duplication_info_hash(removed_duplication_info_ptr->address->addr_ptr,
+                                                                 removed_duplication_info_ptr->address->addr_len,
+                                                                 removed_duplication_info_ptr->address->port);
+
+    /* * * * Remove from age-ordered list and hashed index * * * */
+    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
+    ns_list_remove(&handle->duplication_hash_tbl[bucket], removed_duplication_info_ptr);
+    --handle->count_duplication_msgs;
+
+    /* Free memory of stored Duplication info */
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
+    removed_duplication_info_ptr->address->addr_ptr = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
+    removed_duplication_info_ptr->address = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
+    removed_duplication_info_ptr->packet_ptr = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr);
+    removed_duplication_info_ptr = 0;
 }
 
 /**************************************************************************//**
  * \fn static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle)
  *
- * \brief Removes old stored Duplication detection infos from Linked list
+ * \brief Removes old stored Duplication detection infos from the duplication store
  *****************************************************************************/
 
 static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle)
 {
-    /* Loop all stored duplication messages in Linked list */
-    ns_list_foreach_safe(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        if ((handle->system_time - removed_duplication_info_ptr->timestamp)  > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
-            /* * * * Old Duplication info found, remove it from Linked list * * * */
-            ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-            --handle->count_duplication_msgs;
-
-            /* Free memory of stored Duplication info */
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
-            removed_duplication_info_ptr->address->addr_ptr = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
-            removed_duplication_info_ptr->address = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
-            removed_duplication_info_ptr->packet_ptr = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr);
-            removed_duplication_info_ptr = 0;
-        }
+    coap_duplication_info_s *removed_duplication_info_ptr;
+
+    /* The age-ordered list has its oldest entry first, so the scan can stop
+     * at the first entry that is still valid */
+    while ((removed_duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs)) != NULL &&
+            (handle->system_time - removed_duplication_info_ptr->timestamp) > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
+        sn_coap_protocol_duplication_info_free(handle, removed_duplication_info_ptr);
     }
 }
 
@@ -1227,7 +1256,8 @@ static void sn_coap_protocol_linked_list_blockwise_msg_remove(struct coap_s *han
 static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr,
         uint16_t stored_payload_len,
         uint8_t *stored_payload_ptr,
-        uint32_t block_number)
+        uint32_t block_number,
+        bool last_block)
 {
     if (!addr_ptr || !stored_payload_len || !stored_payload_ptr) {
         return;
@@ -1281,9 +1311,34 @@ static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *
     stored_blockwise_payload_ptr->coap = handle;
 
     stored_blockwise_payload_ptr->block_number = block_number;
+    stored_blockwise_payload_ptr->last_block = last_block;
 
     /* * * * Storing Payload to Linked list  * * * */
 
+    /* Keep payloads of one peer ordered by block number so that out-of-order   */
+    /* arrivals - possible when several block requests are in flight - are      */
+    /* reassembled correctly, and drop blocks which are already stored          */
+    ns_list_foreach(coap_blockwise_payload_s, stored_payload_info_ptr, &handle->linked_list_blockwise_received_payloads) {
+        /* If payload's Source address and port are not the same, skip */
+        if ((0 != memcmp(addr_ptr->addr_ptr, stored_payload_info_ptr->addr_ptr, addr_ptr->addr_len)) ||
+                (stored_payload_info_ptr->port != addr_ptr->port)) {
+            continue;
+        }
+
+        if (stored_payload_info_ptr->block_number == block_number) {
+            /* Duplicated block */
+            handle->sn_coap_protocol_free(stored_blockwise_payload_ptr->addr_ptr);
+            handle->sn_coap_protocol_free(stored_blockwise_payload_ptr->payload_ptr);
+            handle->sn_coap_protocol_free(stored_blockwise_payload_ptr);
+            return;
+        }
+
+        if (stored_payload_info_ptr->block_number > block_number) {
+            ns_list_add_before(&handle->linked_list_blockwise_received_payloads, stored_payload_info_ptr, stored_blockwise_payload_ptr);
+            return;
+        }
+    }
+
     ns_list_add_to_end(&handle->linked_list_blockwise_received_payloads, stored_blockwise_payload_ptr);
 }
 
@@ -1574,6 +1629,185 @@ void sn_coap_protocol_block_remove(struct coap_s *handle, sn_nsdl_addr_s *source
         }
     }
 }
+/**************************************************************************//**
+ * \fn static int8_t sn_coap_protocol_send_block2_request(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint32_t block_number, uint8_t block_temp, void *param)
+ *
+ * \brief Builds, stores and sends a request for one block of a blockwise
+ *        (Block2) response
+ *
+ * \param *src_addr_ptr pointer to destination address information struct
+ * \param block_number number of the block to request
+ * \param block_temp block size exponent part of the Block2 option
+ *
+ * \return 0 if the request was sent, -1 on failure
+ *****************************************************************************/
+
+static int8_t sn_coap_protocol_send_block2_request(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint32_t block_number, uint8_t block_temp, void *param)
+{
+    sn_coap_hdr_s *src_coap_blockwise_ack_msg_ptr;
+    uint16_t dst_packed_data_needed_mem;
+    uint8_t *dst_ack_packet_data_ptr;
+    coap_blockwise_msg_s *stored_blockwise_msg_ptr;
+
+    src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
+    if (src_coap_blockwise_ack_msg_ptr == NULL) {
+        tr_error("sn_coap_protocol_send_block2_request - failed to allocate message!");
+        return -1;
+    }
+
+    if (sn_coap_parser_alloc_options(handle, src_coap_blockwise_ack_msg_ptr) == NULL) {
+        tr_error("sn_coap_protocol_send_block2_request - failed to allocate options!");
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+        src_coap_blockwise_ack_msg_ptr = 0;
+        return -1;
+    }
+
+    src_coap_blockwise_ack_msg_ptr->msg_id = message_id++;
+    if (message_id == 0) {
+        message_id = 1;
+    }
+
+    src_coap_blockwise_ack_msg_ptr->options_list_ptr->block2 = (block_number << 4) | block_temp;
+
+    /* Then get needed memory count for Packet data */
+    dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
+
+    /* Then allocate memory for Packet data */
+    dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
+
+    if (dst_ack_packet_data_ptr == NULL) {
+        tr_error("sn_coap_protocol_send_block2_request - failed to allocate packet!");
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
+        src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+        src_coap_blockwise_ack_msg_ptr = 0;
+        return -1;
+    }
+    memset(dst_ack_packet_data_ptr, 0, dst_packed_data_needed_mem);
+
+    /* * * Then build block request to Packed data * * */
+    if ((sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size)) < 0) {
+        tr_error("sn_coap_protocol_send_block2_request - builder failed!");
+        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+        dst_ack_packet_data_ptr = 0;
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
+        src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+        src_coap_blockwise_ack_msg_ptr = 0;
+        return -1;
+    }
+
+    /* * * Save to linked list * * */
+    stored_blockwise_msg_ptr = handle->sn_coap_protocol_malloc(sizeof(coap_blockwise_msg_s));
+    if (!stored_blockwise_msg_ptr) {
+        tr_error("sn_coap_protocol_send_block2_request - failed to allocate blockwise message!");
+        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+        dst_ack_packet_data_ptr = 0;
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
+        src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+        src_coap_blockwise_ack_msg_ptr = 0;
+        return -1;
+    }
+    memset(stored_blockwise_msg_ptr, 0, sizeof(coap_blockwise_msg_s));
+
+    stored_blockwise_msg_ptr->timestamp = handle->system_time;
+
+    stored_blockwise_msg_ptr->coap_msg_ptr = src_coap_blockwise_ack_msg_ptr;
+    stored_blockwise_msg_ptr->coap = handle;
+    ns_list_add_to_end(&handle->linked_list_blockwise_sent_msgs, stored_blockwise_msg_ptr);
+
+    handle->sn_coap_tx_callback(dst_ack_packet_data_ptr,
+                                dst_packed_data_needed_mem, src_addr_ptr, param);
+
+#if ENABLE_RESENDINGS
+    uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
+    sn_coap_protocol_linked_list_send_msg_store(handle, src_addr_ptr,
+            dst_packed_data_needed_mem,
+            dst_ack_packet_data_ptr,
+            resend_time, param);
+#endif
+    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+    dst_ack_packet_data_ptr = 0;
+
+    return 0;
+}
+
+/**************************************************************************//**
+ * \fn static bool sn_coap_protocol_blockwise_transfer_complete(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr)
+ *
+ * \brief Checks whether the stored payloads of a peer form a contiguous block
+ *        sequence ending in the final block of the transfer
+ *
+ * \param *src_addr_ptr pointer to source address information struct
+ *
+ * \return true when every block of the transfer has been received
+ *****************************************************************************/
+
+static bool sn_coap_protocol_blockwise_transfer_complete(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr)
+{
+    uint32_t next_block_number = 0;
+
+    ns_list_foreach(coap_blockwise_payload_s, stored_payload_info_ptr, &handle->linked_list_blockwise_received_payloads) {
+        if ((0 == memcmp(src_addr_ptr->addr_ptr, stored_payload_info_ptr->addr_ptr, src_addr_ptr->addr_len)) &&
+                (stored_payload_info_ptr->port == src_addr_ptr->port)) {
+            /* The list is kept in block number order; a gap means a block is still missing */
+            if (stored_payload_info_ptr->block_number != next_block_number) {
+                return false;
+            }
+            next_block_number++;
+            if (stored_payload_info_ptr->last_block) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**************************************************************************//**
+ * \fn static sn_coap_hdr_s *sn_coap_protocol_blockwise_assemble(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr)
+ *
+ * \brief Gathers the stored blockwise payloads of a peer into one whole
+ *        payload and attaches it to the received message
+ *
+ * \param *src_addr_ptr pointer to source address information struct
+ * \param *received_coap_msg_ptr pointer to parsed CoAP message structure
+ *
+ * \return the received message carrying the whole payload or NULL on failure
+ *****************************************************************************/
+
+static sn_coap_hdr_s *sn_coap_protocol_blockwise_assemble(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr)
+{
+    uint32_t whole_payload_len      = sn_coap_protocol_linked_list_blockwise_payloads_get_len(handle, src_addr_ptr);
+    uint8_t *temp_whole_payload_ptr = NULL;
+
+    temp_whole_payload_ptr = handle->sn_coap_protocol_malloc(whole_payload_len);
+    if (temp_whole_payload_ptr == NULL || whole_payload_len > UINT16_MAX) {
+        tr_error("sn_coap_protocol_blockwise_assemble - failed to allocate whole payload!");
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
+        handle->sn_coap_protocol_free(temp_whole_payload_ptr);
+        return 0;
+    }
+
+    // In block message case, payload_ptr freeing must be done in application level
+    received_coap_msg_ptr->payload_ptr = temp_whole_payload_ptr;
+    received_coap_msg_ptr->payload_len = whole_payload_len;
+
+    /* Copy stored Blockwise payloads - kept in block number order - to returned whole Blockwise payload pointer */
+    ns_list_foreach_safe(coap_blockwise_payload_s, stored_payload_info_ptr, &handle->linked_list_blockwise_received_payloads) {
+        if ((0 == memcmp(src_addr_ptr->addr_ptr, stored_payload_info_ptr->addr_ptr, src_addr_ptr->addr_len)) &&
+                (stored_payload_info_ptr->port == src_addr_ptr->port)) {
+            memcpy(temp_whole_payload_ptr, stored_payload_info_ptr->payload_ptr, stored_payload_info_ptr->payload_len);
+            temp_whole_payload_ptr += stored_payload_info_ptr->payload_len;
+            sn_coap_protocol_linked_list_blockwise_payload_remove(handle, stored_payload_info_ptr);
+        }
+    }
+    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED;
+
+    return received_coap_msg_ptr;
+}
+
 /**************************************************************************//**
  * \fn static int8_t sn_coap_handle_blockwise_message(void)
  *
@@ -1710,7 +1944,8 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                                                                  src_addr_ptr,
                                                                  received_coap_msg_ptr->payload_len,
                                                                  received_coap_msg_ptr->payload_ptr,
-                                                                 block_number);
+                                                                 block_number,
+                                                                 !(received_coap_msg_ptr->options_list_ptr->block1 & 0x08));
 
             /* If not last block (more value is set) */
             /* Block option length can be 1-3 bytes. First 4-20 bits are for block number. Last 4 bits are ALWAYS more bit + block size. */
@@ -1835,12 +2070,14 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
             uint32_t block_number = 0;
 
             /* Store blockwise payload to Linked list */
-            //todo: add block number to stored values - just to make sure all packets are in order
+            /* The block number keys the payload into its place in the list; with a  */
+            /* pipelining window the blocks may arrive out of order                  */
             sn_coap_protocol_linked_list_blockwise_payload_store(handle,
                                                                  src_addr_ptr,
                                                                  received_coap_msg_ptr->payload_len,
                                                                  received_coap_msg_ptr->payload_ptr,
-                                                                 received_coap_msg_ptr->options_list_ptr->block1 >> 4);
+                                                                 received_coap_msg_ptr->options_list_ptr->block2 >> 4,
+                                                                 !(received_coap_msg_ptr->options_list_ptr->block2 & 0x08));
 
             /* If not last block (more value is set) */
             if (received_coap_msg_ptr->options_list_ptr->block2 & 0x08) {
@@ -1861,12 +2098,6 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     return 0;
                 }
 
-                src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
-                if (src_coap_blockwise_ack_msg_ptr == NULL) {
-                    tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate message!");
-                    return 0;
-                }
-
                 ns_list_remove(&handle->linked_list_blockwise_sent_msgs, previous_blockwise_msg_ptr);
                 if( previous_blockwise_msg_ptr->coap_msg_ptr ){
                     if(previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr){
@@ -1879,129 +2110,91 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 handle->sn_coap_protocol_free(previous_blockwise_msg_ptr);
                 previous_blockwise_msg_ptr = 0;
 
-                /* * * Then build CoAP Acknowledgement message * * */
-
-                if (sn_coap_parser_alloc_options(handle, src_coap_blockwise_ack_msg_ptr) == NULL) {
-                    tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate options!");
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                    src_coap_blockwise_ack_msg_ptr = 0;
-                    sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                    return NULL;
-                }
-
-                src_coap_blockwise_ack_msg_ptr->msg_id = message_id++;
-                if (message_id == 0) {
-                    message_id = 1;
+                /* With a pipelining window the final block may have arrived before   */
+                /* this one; if this block completed the transfer, gather the whole   */
+                /* payload instead of requesting further blocks                       */
+                if (sn_coap_protocol_blockwise_transfer_complete(handle, src_addr_ptr)) {
+                    return sn_coap_protocol_blockwise_assemble(handle, src_addr_ptr, received_coap_msg_ptr);
                 }
 
-                /* Update block option */
+                /* Resolve block parameters of the received block */
                 block_temp = received_coap_msg_ptr->options_list_ptr->block2 & 0x07;
-
                 block_number = received_coap_msg_ptr->options_list_ptr->block2 >> 4;
-                block_number ++;
-
-                src_coap_blockwise_ack_msg_ptr->options_list_ptr->block2 = (block_number << 4) | block_temp;
 
-                /* Then get needed memory count for Packet data */
-                dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr ,handle->sn_coap_block_data_size);
+                /* Count block requests still in flight and resolve the number of the   */
+                /* next block to ask for; with a window of one this is simply the block */
+                /* following the received one                                           */
+                uint8_t requests_in_flight = 0;
+                uint32_t next_block_number = block_number + 1;
+                uint32_t last_block_number = 0xFFFFFFFF;
 
-                /* Then allocate memory for Packet data */
-                dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
-
-                if (dst_ack_packet_data_ptr == NULL) {
-                    tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate packet!");
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                    src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                    src_coap_blockwise_ack_msg_ptr = 0;
-                    sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                    return NULL;
+                ns_list_foreach(coap_blockwise_msg_s, msg, &handle->linked_list_blockwise_sent_msgs) {
+                    if (msg->coap_msg_ptr && msg->coap_msg_ptr->options_list_ptr &&
+                            msg->coap_msg_ptr->options_list_ptr->block2 != COAP_OPTION_BLOCK_NONE) {
+                        requests_in_flight++;
+                        if ((uint32_t)(msg->coap_msg_ptr->options_list_ptr->block2 >> 4) >= next_block_number) {
+                            next_block_number = (msg->coap_msg_ptr->options_list_ptr->block2 >> 4) + 1;
+                        }
+                    }
                 }
-                memset(dst_ack_packet_data_ptr, 0, dst_packed_data_needed_mem);
 
-                /* * * Then build Acknowledgement message to Packed data * * */
-                if ((sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size)) < 0) {
-                    tr_error("sn_coap_handle_blockwise_message - (send block2) builder failed!");
-                    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
-                    dst_ack_packet_data_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                    src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                    src_coap_blockwise_ack_msg_ptr = 0;
-                    sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                    return NULL;
+                /* When the response carries the resource size, do not request past the last block */
+                if (received_coap_msg_ptr->options_list_ptr->use_size2 &&
+                        received_coap_msg_ptr->options_list_ptr->size2 > 0) {
+                    last_block_number = (received_coap_msg_ptr->options_list_ptr->size2 - 1) / (1u << (block_temp + 4));
                 }
 
-                /* * * Save to linked list * * */
-                coap_blockwise_msg_s *stored_blockwise_msg_ptr;
-
-                stored_blockwise_msg_ptr = handle->sn_coap_protocol_malloc(sizeof(coap_blockwise_msg_s));
-                if (!stored_blockwise_msg_ptr) {
-                    tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate blockwise message!");
-                    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
-                    dst_ack_packet_data_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                    src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                    src_coap_blockwise_ack_msg_ptr = 0;
-                    sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                    return 0;
+                /* Top the number of in-flight block requests up to the configured window */
+                while (requests_in_flight < handle->sn_coap_blockwise_nstart &&
+                        next_block_number <= last_block_number) {
+                    if (sn_coap_protocol_send_block2_request(handle, src_addr_ptr, next_block_number, block_temp, param) != 0) {
+                        if (requests_in_flight == 0) {
+                            /* Nothing in flight - the transfer cannot proceed */
+                            sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
+                            return NULL;
+                        }
+                        /* Responses to the requests already in flight keep the transfer going */
+                        break;
+                    }
+                    next_block_number++;
+                    requests_in_flight++;
                 }
-                memset(stored_blockwise_msg_ptr, 0, sizeof(coap_blockwise_msg_s));
-
-                stored_blockwise_msg_ptr->timestamp = handle->system_time;
-
-                stored_blockwise_msg_ptr->coap_msg_ptr = src_coap_blockwise_ack_msg_ptr;
-                stored_blockwise_msg_ptr->coap = handle;
-                ns_list_add_to_end(&handle->linked_list_blockwise_sent_msgs, stored_blockwise_msg_ptr);
-
-                /* * * Then release memory of CoAP Acknowledgement message * * */
-                handle->sn_coap_tx_callback(dst_ack_packet_data_ptr,
-                                            dst_packed_data_needed_mem, src_addr_ptr, param);
-
-#if ENABLE_RESENDINGS
-                uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
-                sn_coap_protocol_linked_list_send_msg_store(handle, src_addr_ptr,
-                        dst_packed_data_needed_mem,
-                        dst_ack_packet_data_ptr,
-                        resend_time, param);
-#endif
-                handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
-                dst_ack_packet_data_ptr = 0;
             }
 
             //Last block received
             else {
-                /* * * This is the last block when whole Blockwise payload from received * * */
-                /* * * blockwise messages is gathered and returned to User               * * */
-
-                /* Store last Blockwise payload to Linked list */
-                uint16_t payload_len            = 0;
-                uint8_t *payload_ptr            = sn_coap_protocol_linked_list_blockwise_payload_search(handle, src_addr_ptr, &payload_len);
-                uint16_t whole_payload_len      = sn_coap_protocol_linked_list_blockwise_payloads_get_len(handle, src_addr_ptr);
-                uint8_t *temp_whole_payload_ptr = NULL;
+                /* Remove the block request this response matches; it is no longer in flight */
+                coap_blockwise_msg_s *previous_blockwise_msg_ptr = NULL;
 
-                temp_whole_payload_ptr = handle->sn_coap_protocol_malloc(whole_payload_len);
-                if (!temp_whole_payload_ptr) {
-                    tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate whole payload!");
-                    return 0;
+                ns_list_foreach(coap_blockwise_msg_s, msg, &handle->linked_list_blockwise_sent_msgs) {
+                    if (msg->coap_msg_ptr && received_coap_msg_ptr->msg_id == msg->coap_msg_ptr->msg_id) {
+                        previous_blockwise_msg_ptr = msg;
+                        break;
+                    }
                 }
 
-                received_coap_msg_ptr->payload_ptr = temp_whole_payload_ptr;
-                received_coap_msg_ptr->payload_len = whole_payload_len;
-
-                /* Copy stored Blockwise payloads to returned whole Blockwise payload pointer */
-                while (payload_ptr != NULL) {
-                    memcpy(temp_whole_payload_ptr, payload_ptr, payload_len);
-
-                    temp_whole_payload_ptr += payload_len;
-
-                    sn_coap_protocol_linked_list_blockwise_payload_remove_oldest(handle);
-                    payload_ptr = sn_coap_protocol_linked_list_blockwise_payload_search(handle, src_addr_ptr, &payload_len);
+                if (previous_blockwise_msg_ptr && previous_blockwise_msg_ptr->coap_msg_ptr &&
+                        !(previous_blockwise_msg_ptr->coap_msg_ptr->options_list_ptr &&
+                          previous_blockwise_msg_ptr->coap_msg_ptr->options_list_ptr->observe != COAP_OBSERVE_NONE)) {
+                    ns_list_remove(&handle->linked_list_blockwise_sent_msgs, previous_blockwise_msg_ptr);
+                    if (previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr) {
+                        handle->sn_coap_protocol_free(previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr);
+                        previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr = 0;
+                    }
+                    sn_coap_parser_release_allocated_coap_msg_mem(handle, previous_blockwise_msg_ptr->coap_msg_ptr);
+                    previous_blockwise_msg_ptr->coap_msg_ptr = 0;
+                    handle->sn_coap_protocol_free(previous_blockwise_msg_ptr);
+                    previous_blockwise_msg_ptr = 0;
                 }
-                received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED;
 
-                //todo: remove previous msg from list
+                /* * * This is the last block when whole Blockwise payload from received * * */
+                /* * * blockwise messages is gathered and returned to User               * * */
+                if (sn_coap_protocol_blockwise_transfer_complete(handle, src_addr_ptr)) {
+                    received_coap_msg_ptr = sn_coap_protocol_blockwise_assemble(handle, src_addr_ptr, received_coap_msg_ptr);
+                } else {
+                    /* An earlier block is still in flight; the transfer finishes when it lands */
+                    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
+                }
             }
 
         }
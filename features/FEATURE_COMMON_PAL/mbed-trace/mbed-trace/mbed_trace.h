@@ -328,6 +328,45 @@ void mbed_vtracef(uint8_t dlevel, const char* grp, const char *fmt, va_list ap);
  *  Get last trace from buffer
  */
 const char* mbed_trace_last(void);
+/**
+ * Activate or deactivate deferred trace mode.
+ * In deferred mode the trace line is not formatted at the call site.
+ * mbed_tracef() only records the format string pointer and the argument
+ * values to a ring buffer, which makes a trace call cheap enough to keep
+ * tracing enabled inside packet processing paths. The lines are formatted
+ * and printed later, when mbed_trace_deferred_drain() is called from idle
+ * time. Activation allocates the ring buffer (see
+ * MBED_TRACE_DEFERRED_QUEUE_SIZE); deactivation drains it and releases the
+ * memory.
+ *
+ * Because only pointers are recorded, the format string and the trace group
+ * must be string literals (or otherwise outlive the drain), and any %s
+ * argument must stay valid until the drain. For the same reason the
+ * temporary-buffer helpers (mbed_trace_array, mbed_trace_ipv6, ...) must not
+ * be used in deferred traces; calls whose format cannot be recorded
+ * (helpers, too many arguments, %n) are formatted at the call site as in
+ * normal mode. When the ring buffer is full, new traces are dropped and the
+ * drop count is reported by the next drain. tr_cmdline() output is never
+ * deferred.
+ * @param active true to activate deferred mode, false to deactivate
+ * @return 0 when success, -1 when the feature is compiled out
+ *         (MBED_TRACE_DEFERRED_QUEUE_SIZE is 0) or allocation fails
+ */
+int8_t mbed_trace_deferred_mode_set(bool active);
+/**
+ * Format and print the traces recorded in deferred mode.
+ * Call from idle time, e.g. from the main loop. Each recorded trace goes
+ * through the normal print path (prefix, group tag, color, print function).
+ * Safe to call when deferred mode is not active.
+ */
+void mbed_trace_deferred_drain(void);
+/**
+ * Get the number of traces dropped because the deferred mode ring buffer
+ * was full. The counter is cleared when the drops are reported by
+ * mbed_trace_deferred_drain().
+ * @return dropped trace count
+ */
+uint32_t mbed_trace_deferred_dropped_get(void);
 #if MBED_CONF_MBED_TRACE_FEA_IPV6 == 1
 /**
  * mbed_tracef helping function for convert ipv6
@@ -401,6 +440,9 @@ char* mbed_trace_array(const uint8_t* buf, uint16_t len);
 #undef mbed_tracef
 #undef mbed_vtracef
 #undef mbed_trace_last
+#undef mbed_trace_deferred_mode_set
+#undef mbed_trace_deferred_drain
+#undef mbed_trace_deferred_dropped_get
 #undef mbed_trace_ipv6
 #undef mbed_trace_ipv6_prefix
 #undef mbed_trace_array
@@ -424,6 +466,9 @@ char* mbed_trace_array(const uint8_t* buf, uint16_t len);
 #define mbed_trace_include_filters_set(...)         ((void) 0)
 #define mbed_trace_include_filters_get(...)         ((const char *) 0)
 #define mbed_trace_last(...)                        ((const char *) 0)
+#define mbed_trace_deferred_mode_set(...)           ((int8_t) -1)
+#define mbed_trace_deferred_drain(...)              ((void) 0)
+#define mbed_trace_deferred_dropped_get(...)        ((uint32_t) 0)
 #define mbed_tracef(...)                            ((void) 0)
 #define mbed_vtracef(...)                           ((void) 0)
 /**
@@ -85,6 +85,19 @@
 #define DEFAULT_TRACE_FILTER_LENGTH       24
 #endif
 
+/** default number of traces the deferred mode ring buffer can hold.
+    Rounded up to a power of two. Setting this to 0 leaves the deferred
+    mode out of the build */
+#ifndef MBED_TRACE_DEFERRED_QUEUE_SIZE
+#define MBED_TRACE_DEFERRED_QUEUE_SIZE    32
+#endif
+
+/** max number of arguments recorded for one deferred trace. Traces with
+    more arguments are formatted at the call site as in normal mode */
+#ifndef MBED_TRACE_DEFERRED_MAX_ARGS
+#define MBED_TRACE_DEFERRED_MAX_ARGS      4
+#endif
+
 /** default trace configuration bitmask */
 #ifdef MBED_TRACE_CONFIG
 #define DEFAULT_TRACE_CONFIG              MBED_TRACE_CONFIG
@@ -97,6 +110,37 @@ static void mbed_trace_realloc( char **buffer, int *length_ptr, int new_length);
 static void mbed_trace_default_print(const char *str);
 static void mbed_trace_reset_tmp(void);
 
+#if MBED_TRACE_DEFERRED_QUEUE_SIZE
+/** recorded argument classes, used to replay the argument at drain time */
+enum trace_deferred_arg_type {
+    TRACE_DEFERRED_ARG_SIGNED,   /**< d, i with any length modifier */
+    TRACE_DEFERRED_ARG_UNSIGNED, /**< o, u, x, X with any length modifier */
+    TRACE_DEFERRED_ARG_CHAR,     /**< c */
+    TRACE_DEFERRED_ARG_DOUBLE,   /**< f, F, e, E, g, G, a, A */
+    TRACE_DEFERRED_ARG_STRING,   /**< s */
+    TRACE_DEFERRED_ARG_POINTER   /**< p */
+};
+
+/** one trace recorded in deferred mode: pointers and raw argument values,
+    no formatting done yet */
+typedef struct trace_deferred_event_s {
+    /** format string, must outlive the drain */
+    const char *fmt;
+    /** trace group, must outlive the drain */
+    const char *grp;
+    /** debug level */
+    uint8_t dlevel;
+    /** number of recorded arguments */
+    uint8_t argc;
+    /** argument classes */
+    uint8_t arg_type[MBED_TRACE_DEFERRED_MAX_ARGS];
+    /** argument values, doubles stored bitwise */
+    uint64_t arg[MBED_TRACE_DEFERRED_MAX_ARGS];
+} trace_deferred_event_t;
+
+static bool mbed_trace_deferred_record(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+#endif /* MBED_TRACE_DEFERRED_QUEUE_SIZE */
+
 typedef struct trace_s {
     /** trace configuration bits */
     uint8_t trace_config;
@@ -131,6 +175,24 @@ typedef struct trace_s {
     void (*mutex_release_f)(void);
     /** number of times the mutex has been locked */
     int mutex_lock_count;
+#if MBED_TRACE_DEFERRED_QUEUE_SIZE
+    /** deferred mode ring buffer, allocated when the mode is activated */
+    trace_deferred_event_t *deferred_queue;
+    /** ring buffer size in events, power of two */
+    uint32_t deferred_queue_size;
+    /** free running write index, owned by the trace calls */
+    volatile uint32_t deferred_head;
+    /** free running read index, owned by the drain */
+    volatile uint32_t deferred_tail;
+    /** traces dropped because the ring buffer was full */
+    uint32_t deferred_dropped;
+    /** line buffer for the drain, so the normal print path keeps its own */
+    char *deferred_line;
+    /** deferred mode active */
+    bool deferred_active;
+    /** drain in progress, drained traces must not be re-recorded */
+    bool deferred_draining;
+#endif
 } trace_t;
 
 static trace_t m_trace = {
@@ -148,7 +210,17 @@ static trace_t m_trace = {
     .cmd_printf = 0,
     .mutex_wait_f = 0,
     .mutex_release_f = 0,
-    .mutex_lock_count = 0
+    .mutex_lock_count = 0,
+#if MBED_TRACE_DEFERRED_QUEUE_SIZE
+    .deferred_queue = 0,
+    .deferred_queue_size = 0,
+    .deferred_head = 0,
+    .deferred_tail = 0,
+    .deferred_dropped = 0,
+    .deferred_line = 0,
+    .deferred_active = false,
+    .deferred_draining = false
+#endif
 };
 
 int mbed_trace_init(void)
@@ -208,6 +280,18 @@ void mbed_trace_free(void)
     m_trace.mutex_wait_f = 0;
     m_trace.mutex_release_f = 0;
     m_trace.mutex_lock_count = 0;
+#if MBED_TRACE_DEFERRED_QUEUE_SIZE
+    MBED_TRACE_MEM_FREE(m_trace.deferred_queue);
+    MBED_TRACE_MEM_FREE(m_trace.deferred_line);
+    m_trace.deferred_queue = 0;
+    m_trace.deferred_queue_size = 0;
+    m_trace.deferred_head = 0;
+    m_trace.deferred_tail = 0;
+    m_trace.deferred_dropped = 0;
+    m_trace.deferred_line = 0;
+    m_trace.deferred_active = false;
+    m_trace.deferred_draining = false;
+#endif
 }
 static void mbed_trace_realloc( char **buffer, int *length_ptr, int new_length)
 {
@@ -330,6 +414,21 @@ void mbed_vtracef(uint8_t dlevel, const char* grp, const char *fmt, va_list ap)
         goto end;
     }
     if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
+#if MBED_TRACE_DEFERRED_QUEUE_SIZE
+        if (m_trace.deferred_active && !m_trace.deferred_draining && dlevel != TRACE_LEVEL_CMD) {
+            va_list ap2;
+            bool recorded;
+            va_copy(ap2, ap);
+            recorded = mbed_trace_deferred_record(dlevel, grp, fmt, ap2);
+            va_end(ap2);
+            if (recorded) {
+                //return tmp data pointer back to the beginning
+                mbed_trace_reset_tmp();
+                goto end;
+            }
+            //format cannot be replayed at drain time, format here as in normal mode
+        }
+#endif
         bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
         bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
         bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
@@ -493,6 +592,295 @@ end:
         } while (--count > 0);
     }
 }
+#if MBED_TRACE_DEFERRED_QUEUE_SIZE
+/** record one trace to the deferred mode ring buffer.
+    Returns false when the format cannot be replayed at drain time, in which
+    case no slot is consumed and the caller formats the trace as in normal
+    mode. The trace mutex serializes the callers, so only this function
+    moves the head index and only the drain moves the tail index. */
+static bool mbed_trace_deferred_record(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    trace_deferred_event_t ev;
+    const char *c = fmt;
+    ev.fmt = fmt;
+    ev.grp = grp;
+    ev.dlevel = dlevel;
+    ev.argc = 0;
+    while ((c = strchr(c, '%')) != NULL) {
+        char length0 = 0, length1 = 0;
+        c++;
+        if (*c == '%') {
+            c++;
+            continue;
+        }
+        //flags, field width and precision
+        while (*c && strchr("-+ #0.123456789", *c)) {
+            c++;
+        }
+        if (*c == '*') {
+            //width/precision from an argument, not recorded
+            return false;
+        }
+        //length modifier
+        if (*c == 'h' || *c == 'l') {
+            length0 = *c++;
+            if (*c == length0) {
+                length1 = *c++;
+            }
+        } else if (*c == 'z' || *c == 'j' || *c == 't') {
+            length0 = *c++;
+        } else if (*c == 'L') {
+            //long double not recorded
+            return false;
+        }
+        if (ev.argc >= MBED_TRACE_DEFERRED_MAX_ARGS) {
+            return false;
+        }
+        switch (*c) {
+            case 'd':
+            case 'i': {
+                int64_t val;
+                if (length0 == 'l' && length1 == 'l') {
+                    val = (int64_t)va_arg(ap, long long);
+                } else if (length0 == 'l' || length0 == 'z' || length0 == 't') {
+                    val = (int64_t)va_arg(ap, long);
+                } else if (length0 == 'j') {
+                    val = (int64_t)va_arg(ap, int64_t);
+                } else {
+                    //h and hh promote to int
+                    val = (int64_t)va_arg(ap, int);
+                }
+                ev.arg_type[ev.argc] = TRACE_DEFERRED_ARG_SIGNED;
+                ev.arg[ev.argc++] = (uint64_t)val;
+                break;
+            }
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X': {
+                uint64_t val;
+                if (length0 == 'l' && length1 == 'l') {
+                    val = (uint64_t)va_arg(ap, unsigned long long);
+                } else if (length0 == 'l' || length0 == 'z' || length0 == 't') {
+                    val = (uint64_t)va_arg(ap, unsigned long);
+                } else if (length0 == 'j') {
+                    val = (uint64_t)va_arg(ap, uint64_t);
+                } else {
+                    val = (uint64_t)va_arg(ap, unsigned int);
+                }
+                ev.arg_type[ev.argc] = TRACE_DEFERRED_ARG_UNSIGNED;
+                ev.arg[ev.argc++] = val;
+                break;
+            }
+            case 'c':
+                ev.arg_type[ev.argc] = TRACE_DEFERRED_ARG_CHAR;
+                ev.arg[ev.argc++] = (uint64_t)va_arg(ap, int);
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                double val = va_arg(ap, double);
+                ev.arg_type[ev.argc] = TRACE_DEFERRED_ARG_DOUBLE;
+                memcpy(&ev.arg[ev.argc++], &val, sizeof(double));
+                break;
+            }
+            case 's':
+                ev.arg_type[ev.argc] = TRACE_DEFERRED_ARG_STRING;
+                ev.arg[ev.argc++] = (uint64_t)(uintptr_t)va_arg(ap, const char *);
+                break;
+            case 'p':
+                ev.arg_type[ev.argc] = TRACE_DEFERRED_ARG_POINTER;
+                ev.arg[ev.argc++] = (uint64_t)(uintptr_t)va_arg(ap, void *);
+                break;
+            default:
+                //%n and unknown conversions are not recorded
+                return false;
+        }
+        c++;
+    }
+    if (m_trace.deferred_head - m_trace.deferred_tail >= m_trace.deferred_queue_size) {
+        //ring buffer full, drop and count
+        m_trace.deferred_dropped++;
+        return true;
+    }
+    m_trace.deferred_queue[m_trace.deferred_head & (m_trace.deferred_queue_size - 1)] = ev;
+    m_trace.deferred_head++;
+    return true;
+}
+/** replay one recorded trace through snprintf, one conversion at a time.
+    The length modifiers of the integer conversions are rewritten to "ll"
+    so the recorded 64-bit value can be passed back */
+static void mbed_trace_deferred_format(char *out, int out_len, const trace_deferred_event_t *ev)
+{
+    const char *c = ev->fmt;
+    char *ptr = out;
+    int bLeft = out_len;
+    int arg_i = 0;
+    while (*c && bLeft > 1) {
+        char spec[24];
+        int si = 0;
+        int retval = 0;
+        char conv;
+        if (*c != '%') {
+            *ptr++ = *c++;
+            bLeft--;
+            continue;
+        }
+        if (c[1] == '%') {
+            *ptr++ = '%';
+            c += 2;
+            bLeft--;
+            continue;
+        }
+        if (arg_i >= ev->argc) {
+            break;
+        }
+        spec[si++] = *c++;
+        //flags, field width and precision; leave room for "ll", the
+        //conversion character and the terminator
+        while (*c && strchr("-+ #0.123456789", *c) && si < (int)sizeof(spec) - 4) {
+            spec[si++] = *c++;
+        }
+        //drop the recorded length modifier
+        while (*c == 'h' || *c == 'l' || *c == 'z' || *c == 'j' || *c == 't') {
+            c++;
+        }
+        conv = *c++;
+        switch (ev->arg_type[arg_i]) {
+            case TRACE_DEFERRED_ARG_SIGNED:
+                spec[si++] = 'l';
+                spec[si++] = 'l';
+                spec[si++] = conv;
+                spec[si] = 0;
+                retval = snprintf(ptr, bLeft, spec, (long long)(int64_t)ev->arg[arg_i]);
+                break;
+            case TRACE_DEFERRED_ARG_UNSIGNED:
+                spec[si++] = 'l';
+                spec[si++] = 'l';
+                spec[si++] = conv;
+                spec[si] = 0;
+                retval = snprintf(ptr, bLeft, spec, (unsigned long long)ev->arg[arg_i]);
+                break;
+            case TRACE_DEFERRED_ARG_CHAR:
+                spec[si++] = conv;
+                spec[si] = 0;
+                retval = snprintf(ptr, bLeft, spec, (int)ev->arg[arg_i]);
+                break;
+            case TRACE_DEFERRED_ARG_DOUBLE: {
+                double val;
+                memcpy(&val, &ev->arg[arg_i], sizeof(double));
+                spec[si++] = conv;
+                spec[si] = 0;
+                retval = snprintf(ptr, bLeft, spec, val);
+                break;
+            }
+            case TRACE_DEFERRED_ARG_STRING: {
+                const char *str = (const char *)(uintptr_t)ev->arg[arg_i];
+                spec[si++] = conv;
+                spec[si] = 0;
+                retval = snprintf(ptr, bLeft, spec, str ? str : "<null>");
+                break;
+            }
+            case TRACE_DEFERRED_ARG_POINTER:
+                spec[si++] = conv;
+                spec[si] = 0;
+                retval = snprintf(ptr, bLeft, spec, (void *)(uintptr_t)ev->arg[arg_i]);
+                break;
+            default:
+                break;
+        }
+        arg_i++;
+        if (retval >= bLeft) {
+            ptr += bLeft - 1;
+            bLeft = 1;
+        } else if (retval > 0) {
+            ptr += retval;
+            bLeft -= retval;
+        }
+    }
+    *ptr = 0;
+}
+#endif /* MBED_TRACE_DEFERRED_QUEUE_SIZE */
+int8_t mbed_trace_deferred_mode_set(bool active)
+{
+#if MBED_TRACE_DEFERRED_QUEUE_SIZE
+    if (active) {
+        if (m_trace.deferred_queue == NULL) {
+            //round the configured size up to a power of two for index masking
+            uint32_t size = 1;
+            while (size < MBED_TRACE_DEFERRED_QUEUE_SIZE) {
+                size <<= 1;
+            }
+            m_trace.deferred_queue = MBED_TRACE_MEM_ALLOC(size * sizeof(trace_deferred_event_t));
+            m_trace.deferred_line = MBED_TRACE_MEM_ALLOC(m_trace.line_length);
+            if (m_trace.deferred_queue == NULL || m_trace.deferred_line == NULL) {
+                //memory allocation fail
+                MBED_TRACE_MEM_FREE(m_trace.deferred_queue);
+                MBED_TRACE_MEM_FREE(m_trace.deferred_line);
+                m_trace.deferred_queue = 0;
+                m_trace.deferred_line = 0;
+                return -1;
+            }
+            m_trace.deferred_queue_size = size;
+            m_trace.deferred_head = 0;
+            m_trace.deferred_tail = 0;
+            m_trace.deferred_dropped = 0;
+        }
+        m_trace.deferred_active = true;
+    } else {
+        if (m_trace.deferred_active) {
+            m_trace.deferred_active = false;
+            mbed_trace_deferred_drain();
+        }
+        MBED_TRACE_MEM_FREE(m_trace.deferred_queue);
+        MBED_TRACE_MEM_FREE(m_trace.deferred_line);
+        m_trace.deferred_queue = 0;
+        m_trace.deferred_queue_size = 0;
+        m_trace.deferred_line = 0;
+    }
+    return 0;
+#else
+    (void) active;
+    return -1;
+#endif
+}
+void mbed_trace_deferred_drain(void)
+{
+#if MBED_TRACE_DEFERRED_QUEUE_SIZE
+    if (m_trace.deferred_queue == NULL) {
+        return;
+    }
+    m_trace.deferred_draining = true;
+    while (m_trace.deferred_tail != m_trace.deferred_head) {
+        //copy the event out before moving the tail, the slot belongs to the
+        //trace calls after that
+        trace_deferred_event_t ev = m_trace.deferred_queue[m_trace.deferred_tail & (m_trace.deferred_queue_size - 1)];
+        m_trace.deferred_tail++;
+        mbed_trace_deferred_format(m_trace.deferred_line, m_trace.line_length, &ev);
+        //the formatted line goes through the normal print path
+        mbed_tracef(ev.dlevel, ev.grp, "%s", m_trace.deferred_line);
+    }
+    if (m_trace.deferred_dropped > 0) {
+        unsigned long dropped = m_trace.deferred_dropped;
+        m_trace.deferred_dropped = 0;
+        mbed_tracef(TRACE_LEVEL_WARN, "trce", "%lu deferred traces lost", dropped);
+    }
+    m_trace.deferred_draining = false;
+#endif
+}
+uint32_t mbed_trace_deferred_dropped_get(void)
+{
+#if MBED_TRACE_DEFERRED_QUEUE_SIZE
+    return m_trace.deferred_dropped;
+#else
+    return 0;
+#endif
+}
 static void mbed_trace_reset_tmp(void)
 {
     m_trace.tmp_data_ptr = m_trace.tmp_data;
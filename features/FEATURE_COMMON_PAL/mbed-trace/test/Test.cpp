@@ -104,6 +104,46 @@ TEST(trace, Null0Array)
   STRCMP_EQUAL("<null>", buf);
 }
 
+TEST(trace, DeferredMode)
+{
+  mbed_trace_config_set(TRACE_MODE_PLAIN|TRACE_ACTIVE_LEVEL_ALL);
+  CHECK(mbed_trace_deferred_mode_set(true) == 0);
+
+  buf[0] = 0;
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "int %d uint %u str %s", -7, 9u, "abc");
+  // nothing printed until the drain
+  STRCMP_EQUAL("", buf);
+  mbed_trace_deferred_drain();
+  STRCMP_EQUAL("int -7 uint 9 str abc", buf);
+
+  // formats that cannot be recorded are printed at the call site
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "star %*d", 5, 7);
+  STRCMP_EQUAL("star     7", buf);
+
+  CHECK(mbed_trace_deferred_mode_set(false) == 0);
+}
+
+TEST(trace, DeferredOverflow)
+{
+  mbed_trace_config_set(TRACE_MODE_PLAIN|TRACE_ACTIVE_LEVEL_ALL);
+  CHECK(mbed_trace_deferred_mode_set(true) == 0);
+
+  // MBED_TRACE_DEFERRED_QUEUE_SIZE defaults to 32
+  for (int i = 0; i < 40; i++) {
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "msg %d", i);
+  }
+  CHECK(mbed_trace_deferred_dropped_get() == 8);
+  mbed_trace_deferred_drain();
+  // the drops are reported by the drain and the counter is cleared
+  STRCMP_EQUAL("8 deferred traces lost", buf);
+  CHECK(mbed_trace_deferred_dropped_get() == 0);
+
+  // deactivation drains the leftovers
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "leftover %d", 1);
+  CHECK(mbed_trace_deferred_mode_set(false) == 0);
+  STRCMP_EQUAL("leftover 1", buf);
+}
+
 TEST(trace, LongString)
 {
   char longStr[1000] = {0x36};
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2017 ARM Limited, All Rights Reserved
+ */
+
+// Include before mbed.h to properly get UINT*_C()
+#include "ns_types.h"
+
+#include "mbed.h"
+#include "platform/arm_hal_timer.h"
+#include "platform/arm_hal_interrupt.h"
+#include <mbed_assert.h>
+
+#ifdef NS_EVENTLOOP_USE_DEADLINE_TIMER
+
+// Program the wakeups on the low power ticker when there is one, so the
+// core can deep sleep between deadlines. Otherwise the eventloop still
+// runs tickless on the high resolution ticker.
+#if DEVICE_LOWPOWERTIMER
+static LowPowerTimer deadline_elapsed_timer;
+static LowPowerTimeout deadline_timeout;
+#else
+static Timer deadline_elapsed_timer;
+static Timeout deadline_timeout;
+#endif
+
+static EventQueue *deadline_equeue;
+static void (*deadline_callback)(uint32_t);
+// time of the last elapsed-time report, in elapsed_timer time
+static uint32_t deadline_baseline_us;
+// time the armed wakeup is due, in elapsed_timer time
+static uint32_t deadline_due_us;
+static bool deadline_armed;
+
+static void deadline_event(void)
+{
+    uint32_t elapsed_ms;
+    platform_enter_critical();
+    uint32_t now = deadline_elapsed_timer.read_us();
+    elapsed_ms = (now - deadline_baseline_us) / 1000;
+    // keep the sub-millisecond remainder in the baseline
+    deadline_baseline_us += elapsed_ms * 1000;
+    platform_exit_critical();
+    deadline_callback(elapsed_ms);
+}
+
+static void deadline_timeout_handler(void)
+{
+    deadline_armed = false;
+    deadline_equeue->call(deadline_event);
+}
+
+// Called once at boot
+int8_t platform_deadline_timer_register(platform_deadline_timer_cb deadline_timer_cb_handler)
+{
+    deadline_callback = deadline_timer_cb_handler;
+    deadline_equeue = mbed_highprio_event_queue();
+    MBED_ASSERT(deadline_equeue != NULL);
+    deadline_elapsed_timer.start();
+    deadline_baseline_us = deadline_elapsed_timer.read_us();
+    return 0;
+}
+
+// This is called from inside platform_enter_critical - IRQs can't happen
+int8_t platform_deadline_timer_start(uint32_t deadline_ms, uint32_t slack_ms)
+{
+    uint32_t now = deadline_elapsed_timer.read_us();
+    uint32_t due = now + deadline_ms * 1000;
+    if (deadline_armed) {
+        // Wakeup coalescing: keep the armed wakeup when it lands inside
+        // [due, due + slack]. An armed wakeup earlier than that just
+        // causes one spurious wakeup and a reschedule, never a miss.
+        if ((int32_t)(deadline_due_us - (due + slack_ms * 1000)) <= 0) {
+            return 0;
+        }
+        deadline_timeout.detach();
+    }
+    deadline_due_us = due;
+    deadline_armed = true;
+    deadline_timeout.attach_us(deadline_timeout_handler, deadline_ms * 1000);
+    return 0;
+}
+
+// This is called from inside platform_enter_critical - IRQs can't happen
+int8_t platform_deadline_timer_stop(void)
+{
+    deadline_timeout.detach();
+    deadline_armed = false;
+    return 0;
+}
+
+#endif // NS_EVENTLOOP_USE_DEADLINE_TIMER
@@ -11,9 +11,11 @@
 #include "eventOS_scheduler.h"
 
 #include "ns_event_loop.h"
+#include "ns_event_loop_private.h"
 
 #define TRACE_GROUP "evlp"
 
+#if !MBED_CONF_NANOSTACK_HAL_EVENT_LOOP_USE_MBED_EVENTS
 static void event_loop_thread(void *arg);
 
 static uint64_t event_thread_stk[MBED_CONF_NANOSTACK_HAL_EVENT_LOOP_THREAD_STACK_SIZE/8];
@@ -27,6 +29,7 @@ static const osThreadAttr_t event_thread_attr = {
     .cb_size = sizeof event_thread_tcb,
 };
 static osThreadId_t event_thread_id;
+#endif
 static mbed_rtos_storage_mutex_t event_mutex;
 static const osMutexAttr_t event_mutex_attr = {
   .name = "nanostack_event_mutex",
@@ -61,6 +64,13 @@ uint8_t eventOS_scheduler_mutex_is_owner(void)
     return osThreadGetId() == event_mutex_owner_id ? 1 : 0;
 }
 
+void ns_event_loop_mutex_create(void)
+{
+    event_mutex_id = osMutexNew(&event_mutex_attr);
+    MBED_ASSERT(event_mutex_id != NULL);
+}
+
+#if !MBED_CONF_NANOSTACK_HAL_EVENT_LOOP_USE_MBED_EVENTS
 void eventOS_scheduler_signal(void)
 {
     // XXX why does signal set lock if called with irqs disabled?
@@ -87,8 +97,7 @@ static void event_loop_thread(void *arg)
 
 void ns_event_loop_thread_create(void)
 {
-    event_mutex_id = osMutexNew(&event_mutex_attr);
-    MBED_ASSERT(event_mutex_id != NULL);
+    ns_event_loop_mutex_create();
 
     event_thread_id = osThreadNew(event_loop_thread, NULL, &event_thread_attr);
     MBED_ASSERT(event_thread_id != NULL);
@@ -97,3 +106,4 @@ void ns_event_loop_thread_create(void)
 void ns_event_loop_thread_start(void)
 {
 }
+#endif
@@ -13,3 +13,20 @@ void ns_event_loop_thread_start(void);
 }
 #endif
 
+#if MBED_CONF_NANOSTACK_HAL_EVENT_LOOP_USE_MBED_EVENTS
+#ifdef __cplusplus
+namespace events {
+class EventQueue;
+}
+
+/**
+ * Designate the EventQueue the Nanostack event loop dispatches on.
+ *
+ * Only available when nanostack-hal.event-loop-use-mbed-events is set.
+ * Must be called before ns_hal_init(); when not called, the shared
+ * queue from mbed_event_queue() is used.
+ */
+void ns_event_loop_attach(events::EventQueue *queue);
+#endif
+#endif
+
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2017 ARM Limited, All Rights Reserved
+ */
+
+#if MBED_CONF_NANOSTACK_HAL_EVENT_LOOP_USE_MBED_EVENTS
+
+#include <stddef.h>
+#include <mbed_assert.h>
+#include "mbed_critical.h"
+#include "events/EventQueue.h"
+#include "events/mbed_shared_queues.h"
+#include "ns_trace.h"
+
+#include "eventOS_scheduler.h"
+
+#include "ns_event_loop.h"
+#include "ns_event_loop_private.h"
+
+#define TRACE_GROUP "evlp"
+
+using events::EventQueue;
+
+static EventQueue *event_queue;
+static bool dispatch_pending;
+
+// One dispatch job drains the whole tasklet queue, so at most one is
+// ever outstanding on the EventQueue no matter how many signals arrive
+// while it waits its turn
+static void do_dispatch(void)
+{
+    core_util_critical_section_enter();
+    dispatch_pending = false;
+    core_util_critical_section_exit();
+
+    eventOS_scheduler_mutex_wait();
+    eventOS_scheduler_run_until_idle();
+    eventOS_scheduler_mutex_release();
+}
+
+extern "C" void eventOS_scheduler_signal(void)
+{
+    if (!event_queue) {
+        // Pre-init signals need no bookkeeping - the events stay in the
+        // tasklet queue and ns_event_loop_thread_create() primes a
+        // dispatch for them
+        return;
+    }
+
+    core_util_critical_section_enter();
+    bool wake = !dispatch_pending;
+    dispatch_pending = true;
+    core_util_critical_section_exit();
+
+    if (wake) {
+        int id = event_queue->call(do_dispatch);
+        MBED_ASSERT(id != 0);
+        (void)id;
+    }
+}
+
+extern "C" void eventOS_scheduler_idle(void)
+{
+    // Only reachable through eventOS_scheduler_run(), which is the
+    // dedicated thread's loop - this backend dispatches from the
+    // EventQueue instead
+    MBED_ASSERT("eventOS_scheduler_idle should not be called" == NULL);
+}
+
+void ns_event_loop_attach(EventQueue *queue)
+{
+    MBED_ASSERT(event_queue == NULL);
+    event_queue = queue;
+}
+
+extern "C" void ns_event_loop_thread_create(void)
+{
+    ns_event_loop_mutex_create();
+
+    if (!event_queue) {
+        event_queue = mbed::mbed_event_queue();
+    }
+    MBED_ASSERT(event_queue != NULL);
+
+    // Anything queued before the backend existed is still waiting, so
+    // prime one dispatch
+    eventOS_scheduler_signal();
+}
+
+extern "C" void ns_event_loop_thread_start(void)
+{
+}
+
+#endif // MBED_CONF_NANOSTACK_HAL_EVENT_LOOP_USE_MBED_EVENTS
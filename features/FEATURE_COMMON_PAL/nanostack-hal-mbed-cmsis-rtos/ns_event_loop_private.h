@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2016 ARM Limited, All Rights Reserved
+ */
+
+#ifndef NS_EVENT_LOOP_PRIVATE_H_
+#define NS_EVENT_LOOP_PRIVATE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void ns_event_loop_mutex_create(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
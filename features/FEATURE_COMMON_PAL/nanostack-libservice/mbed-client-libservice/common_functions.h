@@ -296,6 +296,22 @@ NS_INLINE void bit_clear(uint8_t *bitset, uint_fast8_t bit);
  */
 bool bitsequal(const uint8_t *a, const uint8_t *b, uint_fast8_t bits);
 
+/*
+ * Measure the common prefix of two bitstrings.
+ *
+ * Compare two bitstrings of specified length and return the number of
+ * leading bits that match. The bit strings are in big-endian (network) bit
+ * order. The comparison runs a word at a time, so it is cheaper than a
+ * bit-by-bit scan on longest-prefix-match lookups.
+ *
+ * \param a pointer to first string
+ * \param b pointer to second string
+ * \param bits maximum number of bits to compare
+ *
+ * \return number of matching leading bits (0 to `bits`)
+ */
+uint_fast8_t common_match_length(const uint8_t *a, const uint8_t *b, uint_fast8_t bits);
+
 /*
  * Copy a bitstring
  *
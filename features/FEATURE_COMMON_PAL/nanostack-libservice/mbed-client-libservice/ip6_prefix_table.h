@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2017 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IP6_PREFIX_TABLE_H
+#define IP6_PREFIX_TABLE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ns_types.h"
+
+/*
+ * Precomputed longest-prefix-match table for IPv6 prefixes.
+ *
+ * Each registered prefix is stored with its bits and mask expanded to
+ * 32-bit words, so a lookup costs at most four masked word compares per
+ * entry instead of a bit-by-bit scan. Intended for small, slowly changing
+ * prefix sets checked per packet, such as on-mesh prefixes on a border
+ * router forwarding path.
+ *
+ * The table is a fixed-size static array; it does not allocate.
+ */
+
+/** Number of entries in the prefix table */
+#ifndef IP6_PREFIX_TABLE_ENTRIES
+#define IP6_PREFIX_TABLE_ENTRIES 8
+#endif
+
+/**
+ * Add a prefix to the table.
+ *
+ * Bits in the `prefix` buffer beyond `prefix_len` bits are ignored and only
+ * the bytes containing the prefix bits are read (thus if `prefix_len` is
+ * zero, `prefix` can be NULL). Adding a prefix already in the table is a
+ * no-op reporting success.
+ *
+ * \param prefix IPv6 prefix.
+ * \param prefix_len length of `prefix` in bits, 0 to 128.
+ * \return 0 on success
+ * \return -1 if `prefix_len` is invalid or the table is full
+ */
+int_fast8_t ip6_prefix_table_add(const uint8_t *prefix, uint_fast8_t prefix_len);
+
+/**
+ * Remove a prefix from the table.
+ *
+ * \param prefix IPv6 prefix.
+ * \param prefix_len length of `prefix` in bits, 0 to 128.
+ * \return true if the prefix was found and removed
+ */
+bool ip6_prefix_table_remove(const uint8_t *prefix, uint_fast8_t prefix_len);
+
+/**
+ * Remove all prefixes from the table.
+ */
+void ip6_prefix_table_clear(void);
+
+/**
+ * Find the longest registered prefix matching an address.
+ *
+ * \param addr IPv6 address. MUST be 16 bytes.
+ * \return length in bits of the longest matching prefix
+ * \return -1 if no prefix matches
+ */
+int_fast16_t ip6_prefix_table_match(const uint8_t addr[__static 16]);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* IP6_PREFIX_TABLE_H */
@@ -35,6 +35,24 @@ extern "C" {
  */
 uint_fast8_t ip6tos(const void *ip6addr, char *p);
 
+/**
+ * Print a list of binary IPv6 addresses to a string.
+ *
+ * Converts `count` consecutive 16-byte addresses in one call, writing
+ * `separator` between each address. Intended for trace paths that print
+ * address lists, avoiding a call and null-termination per address.
+ *
+ * String must contain enough room for the full list, 40 bytes per address.
+ * IPv4 tunneling addresses are not covered.
+ *
+ * \param ip6addrs array of `count` IPv6 addresses, 16 bytes each.
+ * \param count number of addresses to convert.
+ * \param separator character written between addresses.
+ * \param p buffer to write string to.
+ * \return length of generated string excluding the terminating null character
+ */
+uint_fast16_t ip6tos_bulk(const void *ip6addrs, uint_fast8_t count, char separator, char *p);
+
 /**
  * Print binary IPv6 prefix to a string.
  *
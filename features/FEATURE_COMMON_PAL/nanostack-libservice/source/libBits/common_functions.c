@@ -49,6 +49,36 @@ bool bitsequal(const uint8_t *a, const uint8_t *b, uint_fast8_t bits)
     return true;
 }
 
+uint_fast8_t common_match_length(const uint8_t *a, const uint8_t *b, uint_fast8_t bits)
+{
+    uint_fast8_t offset = 0;
+
+    /* Word-at-a-time scan: big-endian reads follow network bit order, so
+     * the first differing bit falls out of a single count-leading-zeros
+     * on the XOR of the words. */
+    while (bits - offset >= 32) {
+        uint32_t diff = common_read_32_bit(a) ^ common_read_32_bit(b);
+        if (diff) {
+            return offset + common_count_leading_zeros_32(diff);
+        }
+        a += 4;
+        b += 4;
+        offset += 32;
+    }
+
+    /* At most 3 bytes and a partial byte remain */
+    while (offset < bits) {
+        uint8_t diff = *a++ ^ *b++;
+        if (diff) {
+            uint_fast8_t match = offset + common_count_leading_zeros_8(diff);
+            return match < bits ? match : bits;
+        }
+        offset += 8;
+    }
+
+    return bits;
+}
+
 uint8_t *bitcopy(uint8_t *restrict dst, const uint8_t *restrict src, uint_fast8_t bits)
 {
     uint_fast8_t bytes = bits / 8;
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2017 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string.h>
+#include "common_functions.h"
+#include "ip6_prefix_table.h"
+
+typedef struct {
+    uint32_t word[4];   /* prefix bits as words, pre-masked */
+    uint32_t mask[4];   /* network mask as words */
+    uint8_t prefix_len;
+    bool in_use;
+} ip6_prefix_entry_t;
+
+static ip6_prefix_entry_t prefix_table[IP6_PREFIX_TABLE_ENTRIES];
+
+/* Expand a prefix into pre-masked words, so matching is masked word
+ * compares with no per-lookup bit arithmetic */
+static void ip6_prefix_entry_set(ip6_prefix_entry_t *entry, const uint8_t *prefix, uint_fast8_t prefix_len)
+{
+    uint8_t padded[16] = {0};
+
+    bitcopy(padded, prefix, prefix_len);
+
+    for (uint_fast8_t w = 0; w < 4; w++) {
+        uint_fast8_t bits = prefix_len > 32 * w ? prefix_len - 32 * w : 0;
+        if (bits >= 32) {
+            entry->mask[w] = UINT32_MAX;
+        } else if (bits > 0) {
+            entry->mask[w] = UINT32_MAX << (32 - bits);
+        } else {
+            entry->mask[w] = 0;
+        }
+        entry->word[w] = common_read_32_bit(padded + 4 * w) & entry->mask[w];
+    }
+    entry->prefix_len = prefix_len;
+    entry->in_use = true;
+}
+
+static ip6_prefix_entry_t *ip6_prefix_entry_find(const uint8_t *prefix, uint_fast8_t prefix_len)
+{
+    uint8_t padded[16] = {0};
+
+    bitcopy(padded, prefix, prefix_len);
+
+    for (uint_fast8_t n = 0; n < IP6_PREFIX_TABLE_ENTRIES; n++) {
+        ip6_prefix_entry_t *entry = &prefix_table[n];
+        if (!entry->in_use || entry->prefix_len != prefix_len) {
+            continue;
+        }
+        uint_fast8_t w;
+        for (w = 0; w < 4; w++) {
+            if ((common_read_32_bit(padded + 4 * w) & entry->mask[w]) != entry->word[w]) {
+                break;
+            }
+        }
+        if (w == 4) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+int_fast8_t ip6_prefix_table_add(const uint8_t *prefix, uint_fast8_t prefix_len)
+{
+    if (prefix_len > 128) {
+        return -1;
+    }
+
+    if (ip6_prefix_entry_find(prefix, prefix_len)) {
+        return 0;
+    }
+
+    for (uint_fast8_t n = 0; n < IP6_PREFIX_TABLE_ENTRIES; n++) {
+        if (!prefix_table[n].in_use) {
+            ip6_prefix_entry_set(&prefix_table[n], prefix, prefix_len);
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+bool ip6_prefix_table_remove(const uint8_t *prefix, uint_fast8_t prefix_len)
+{
+    if (prefix_len > 128) {
+        return false;
+    }
+
+    ip6_prefix_entry_t *entry = ip6_prefix_entry_find(prefix, prefix_len);
+    if (!entry) {
+        return false;
+    }
+    entry->in_use = false;
+    return true;
+}
+
+void ip6_prefix_table_clear(void)
+{
+    for (uint_fast8_t n = 0; n < IP6_PREFIX_TABLE_ENTRIES; n++) {
+        prefix_table[n].in_use = false;
+    }
+}
+
+int_fast16_t ip6_prefix_table_match(const uint8_t addr[__static 16])
+{
+    uint32_t a[4];
+    int_fast16_t best = -1;
+
+    /* Read the address words once; each entry then costs at most four
+     * masked compares */
+    for (uint_fast8_t w = 0; w < 4; w++) {
+        a[w] = common_read_32_bit(addr + 4 * w);
+    }
+
+    for (uint_fast8_t n = 0; n < IP6_PREFIX_TABLE_ENTRIES; n++) {
+        const ip6_prefix_entry_t *entry = &prefix_table[n];
+        if (!entry->in_use || entry->prefix_len <= best) {
+            continue;
+        }
+        uint_fast8_t w;
+        for (w = 0; w < 4 && entry->mask[w]; w++) {
+            if ((a[w] ^ entry->word[w]) & entry->mask[w]) {
+                break;
+            }
+        }
+        if (w == 4 || !entry->mask[w]) {
+            best = entry->prefix_len;
+        }
+    }
+
+    return best;
+}
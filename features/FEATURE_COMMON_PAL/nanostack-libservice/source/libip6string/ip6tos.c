@@ -99,6 +99,24 @@ uint_fast8_t ip6tos(const void *ip6addr, char *p)
     return p - p_orig;
 }
 
+uint_fast16_t ip6tos_bulk(const void *ip6addrs, uint_fast8_t count, char separator, char *p)
+{
+    const uint8_t *addr = ip6addrs;
+    char *p_orig = p;
+
+    for (uint_fast8_t n = 0; n < count; n++) {
+        if (n != 0) {
+            *p++ = separator;
+        }
+        p += ip6tos(addr, p);
+        addr += 16;
+    }
+    *p = '\0';
+
+    // Return length of generated string, excluding the terminating null character
+    return p - p_orig;
+}
+
 uint_fast8_t ip6_prefix_tos(const void *prefix, uint_fast8_t prefix_len, char *p)
 {
     char *wptr = p;
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2017 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "ip6_prefix_table.h"
+#include "common_functions.h"
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(ip6_prefix_table)
+{
+    void setup() {
+        ip6_prefix_table_clear();
+    }
+
+    void teardown() {
+        ip6_prefix_table_clear();
+    }
+};
+
+TEST(ip6_prefix_table, longest_match)
+{
+    const uint8_t prefix_48[] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01 };
+    const uint8_t prefix_64[] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x02 };
+    uint8_t addr[16] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x02, 0,0,0,0,0,0,0,1 };
+
+    CHECK(ip6_prefix_table_match(addr) == -1);
+
+    CHECK(ip6_prefix_table_add(prefix_48, 48) == 0);
+    CHECK(ip6_prefix_table_match(addr) == 48);
+
+    CHECK(ip6_prefix_table_add(prefix_64, 64) == 0);
+    CHECK(ip6_prefix_table_match(addr) == 64);
+
+    // Address off the /64 but on the /48
+    addr[7] = 0x03;
+    CHECK(ip6_prefix_table_match(addr) == 48);
+
+    // Address off both prefixes
+    addr[0] = 0xfd;
+    CHECK(ip6_prefix_table_match(addr) == -1);
+}
+
+TEST(ip6_prefix_table, default_prefix)
+{
+    uint8_t addr[16] = { 0xfe, 0x80, 0,0,0,0,0,0,0,0,0,0,0,0,0,1 };
+
+    CHECK(ip6_prefix_table_add(NULL, 0) == 0);
+    CHECK(ip6_prefix_table_match(addr) == 0);
+}
+
+TEST(ip6_prefix_table, non_byte_aligned_prefix)
+{
+    // fd00::/7 - only the upper 7 bits are significant
+    const uint8_t prefix[] = { 0xfd };
+    uint8_t addr[16] = { 0xfc, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,1 };
+
+    CHECK(ip6_prefix_table_add(prefix, 7) == 0);
+    CHECK(ip6_prefix_table_match(addr) == 7);
+
+    addr[0] = 0x20;
+    CHECK(ip6_prefix_table_match(addr) == -1);
+}
+
+TEST(ip6_prefix_table, add_remove)
+{
+    const uint8_t prefix[] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x02 };
+    uint8_t addr[16] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x02, 0,0,0,0,0,0,0,1 };
+
+    CHECK(ip6_prefix_table_add(prefix, 129) == -1);
+    CHECK(ip6_prefix_table_remove(prefix, 64) == false);
+
+    CHECK(ip6_prefix_table_add(prefix, 64) == 0);
+    // Duplicate add is a no-op
+    CHECK(ip6_prefix_table_add(prefix, 64) == 0);
+
+    CHECK(ip6_prefix_table_remove(prefix, 64) == true);
+    CHECK(ip6_prefix_table_match(addr) == -1);
+    CHECK(ip6_prefix_table_remove(prefix, 64) == false);
+}
+
+TEST(ip6_prefix_table, table_full)
+{
+    uint8_t prefix[8] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0 };
+
+    for (int n = 0; n < IP6_PREFIX_TABLE_ENTRIES; n++) {
+        prefix[7] = n;
+        CHECK(ip6_prefix_table_add(prefix, 64) == 0);
+    }
+    prefix[7] = IP6_PREFIX_TABLE_ENTRIES;
+    CHECK(ip6_prefix_table_add(prefix, 64) == -1);
+
+    // Removing one frees a slot
+    prefix[7] = 0;
+    CHECK(ip6_prefix_table_remove(prefix, 64) == true);
+    prefix[7] = IP6_PREFIX_TABLE_ENTRIES;
+    CHECK(ip6_prefix_table_add(prefix, 64) == 0);
+}
+
+TEST_GROUP(common_match_length)
+{
+    void setup() {
+    }
+
+    void teardown() {
+    }
+};
+
+TEST(common_match_length, match_lengths)
+{
+    uint8_t a[16];
+    uint8_t b[16];
+
+    memset(a, 0xaa, 16);
+    memset(b, 0xaa, 16);
+    CHECK(common_match_length(a, b, 128) == 128);
+    CHECK(common_match_length(a, b, 57) == 57);
+
+    // Differ in the first bit of the last byte
+    b[15] = 0x2a;
+    CHECK(common_match_length(a, b, 128) == 120);
+
+    // Differ mid-word
+    b[15] = 0xaa;
+    b[5] = 0xab;
+    CHECK(common_match_length(a, b, 128) == 47);
+    // Difference beyond the compared length is not seen
+    CHECK(common_match_length(a, b, 40) == 40);
+    CHECK(common_match_length(a, b, 0) == 0);
+}
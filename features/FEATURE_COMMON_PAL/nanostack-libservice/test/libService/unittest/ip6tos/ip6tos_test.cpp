@@ -61,6 +61,30 @@ TEST(ip6tos, ip6_prefix_tos_func)
     CHECK(str_len == 0);
 }
 
+TEST(ip6tos, ip6tos_bulk_func)
+{
+    char list_str[120] = {0};
+    uint_fast16_t str_len;
+
+    const uint8_t addrs[2][16] = {
+        { 0x20, 0x01, 0xd, 0xb8, 0,0,0,0,0,0,0,0,0,0,0,1 },
+        { 0xfe, 0x80, 0,0,0,0,0,0,0,0,0,0,0,0,0,2 },
+    };
+
+    str_len = ip6tos_bulk(addrs, 2, ',', list_str);
+    STRCMP_EQUAL("2001:db8::1,fe80::2", list_str);
+    CHECK(str_len == 19);
+
+    memset(list_str, 0xff, sizeof list_str - 1);
+    str_len = ip6tos_bulk(addrs, 0, ',', list_str);
+    CHECK(str_len == 0);
+    STRCMP_EQUAL("", list_str);
+
+    str_len = ip6tos_bulk(addrs[1], 1, ',', list_str);
+    STRCMP_EQUAL("fe80::2", list_str);
+    CHECK(str_len == 7);
+}
+
 /***********************************************************/
 /* Second test group for the old tests that were once lost */
 
@@ -88,6 +88,42 @@ extern int8_t platform_tick_timer_stop(void);
 
 #endif // NS_EVENTLOOP_USE_TICK_TIMER
 
+#ifdef NS_EVENTLOOP_USE_DEADLINE_TIMER
+/**
+ * \brief This function is API for registering the deadline timer callback used
+ *        for tickless eventloop operation. Also does any necessary
+ *        initialization of the deadline timer. The callback gets the number of
+ *        milliseconds elapsed since it was last called (or since registration
+ *        for the first call).
+ *
+ * \return -1 for failure, success otherwise
+ */
+typedef void (*platform_deadline_timer_cb)(uint32_t elapsed_ms);
+extern int8_t platform_deadline_timer_register(platform_deadline_timer_cb deadline_timer_cb_handler);
+
+/**
+ * \brief This function is API for programming the deadline timer. The callback
+ *        set with platform_deadline_timer_register gets called once, no earlier
+ *        than deadline_ms from now. The platform may deliver the callback up to
+ *        slack_ms late in order to coalesce the wakeup with an already
+ *        programmed deadline. Programming a new deadline replaces the previous
+ *        one.
+ *
+ * \param deadline_ms milliseconds until the callback is due
+ * \param slack_ms how many milliseconds late the callback may be delivered
+ * \return -1 for failure, success otherwise
+ */
+extern int8_t platform_deadline_timer_start(uint32_t deadline_ms, uint32_t slack_ms);
+
+/**
+ * \brief This function is API for cancelling a programmed deadline
+ *
+ * \return -1 for failure, success otherwise
+ */
+extern int8_t platform_deadline_timer_stop(void);
+
+#endif // NS_EVENTLOOP_USE_DEADLINE_TIMER
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,8 @@
 
 /* Use platform-provided low-resolution tick timer for eventloop (requires "platform_tick_timer" API) */
 #undef NS_EVENTLOOP_USE_TICK_TIMER
+/* Run the eventloop tickless from a platform-provided deadline timer (requires "platform_deadline_timer" API) */
+#undef NS_EVENTLOOP_USE_DEADLINE_TIMER
 /* Exclude high resolution timer from build (removes need for "platform_timer" API) */
 #undef NS_EXCLUDE_HIGHRES_TIMER
 
@@ -35,6 +37,14 @@
 #define NS_EVENTLOOP_USE_TICK_TIMER     1
 #endif
 
+#ifdef MBED_CONF_NANOSTACK_EVENTLOOP_USE_DEADLINE_TIMER
+#define NS_EVENTLOOP_USE_DEADLINE_TIMER 1
+#endif
+
+#ifdef MBED_CONF_NANOSTACK_EVENTLOOP_DEADLINE_TIMER_SLACK_MS
+#define NS_EVENTLOOP_DEADLINE_TIMER_SLACK_MS MBED_CONF_NANOSTACK_EVENTLOOP_DEADLINE_TIMER_SLACK_MS
+#endif
+
 #ifdef MBED_CONF_NANOSTACK_EVENTLOOP_EXCLUDE_HIGHRES_TIMER
 #define NS_EXCLUDE_HIGHRES_TIMER        1
 #endif
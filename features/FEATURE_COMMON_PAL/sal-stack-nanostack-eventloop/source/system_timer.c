@@ -45,10 +45,12 @@ static NS_LIST_DEFINE(system_timer_list, sys_timer_struct_s, event.link);
 
 
 static sys_timer_struct_s *sys_timer_dynamically_allocate(void);
+#ifndef NS_EVENTLOOP_USE_DEADLINE_TIMER
 static void timer_sys_interrupt(void);
+#endif
 static void timer_sys_add(sys_timer_struct_s *timer);
 
-#ifndef NS_EVENTLOOP_USE_TICK_TIMER
+#if !defined(NS_EVENTLOOP_USE_TICK_TIMER) && !defined(NS_EVENTLOOP_USE_DEADLINE_TIMER)
 static int8_t platform_tick_timer_start(uint32_t period_ms);
 /* Implement platform tick timer using eventOS timer */
 // platform tick timer callback function
@@ -83,7 +85,55 @@ static int8_t platform_tick_timer_stop(void)
 {
     return eventOS_callback_timer_stop(tick_timer_id);
 }
-#endif // !NS_EVENTLOOP_USE_TICK_TIMER
+#endif // !NS_EVENTLOOP_USE_TICK_TIMER && !NS_EVENTLOOP_USE_DEADLINE_TIMER
+
+#ifdef NS_EVENTLOOP_USE_DEADLINE_TIMER
+/* Tickless operation: instead of waking on a periodic tick, the platform
+ * deadline timer is programmed for the earliest timer on the list and the
+ * tick count is advanced in one step when it fires. Timers whose deadlines
+ * are within the slack of an already programmed wakeup share that wakeup. */
+
+/* How many milliseconds late a timer may fire to share a wakeup with
+ * another timer. One legacy tick period by default. */
+#ifndef NS_EVENTLOOP_DEADLINE_TIMER_SLACK_MS
+#define NS_EVENTLOOP_DEADLINE_TIMER_SLACK_MS    TIMER_SYS_TICK_PERIOD
+#endif
+
+// milliseconds reported by the platform but not yet converted to whole ticks
+static uint32_t deadline_residual_ms;
+
+/* Called internally with lock held */
+static void timer_sys_reschedule(void)
+{
+    sys_timer_struct_s *first = ns_list_get_first(&system_timer_list);
+    if (first == NULL) {
+        // Nothing on the list - no reason to wake up at all
+        platform_deadline_timer_stop();
+    } else if (TICKS_BEFORE_OR_AT(first->launch_time, timer_sys_ticks)) {
+        platform_deadline_timer_start(0, 0);
+    } else {
+        uint32_t ms = (first->launch_time - timer_sys_ticks) * TIMER_SYS_TICK_PERIOD;
+        // Account for the partial tick already elapsed
+        if (ms > deadline_residual_ms) {
+            ms -= deadline_residual_ms;
+        } else {
+            ms = 0;
+        }
+        platform_deadline_timer_start(ms, NS_EVENTLOOP_DEADLINE_TIMER_SLACK_MS);
+    }
+}
+
+static void timer_sys_deadline_interrupt(uint32_t elapsed_ms)
+{
+    platform_enter_critical();
+    elapsed_ms += deadline_residual_ms;
+    deadline_residual_ms = elapsed_ms % TIMER_SYS_TICK_PERIOD;
+    // Advance the tick count in one step; this queues every due timer
+    system_timer_tick_update(elapsed_ms / TIMER_SYS_TICK_PERIOD);
+    timer_sys_reschedule();
+    platform_exit_critical();
+}
+#endif // NS_EVENTLOOP_USE_DEADLINE_TIMER
 
 /*
  * Initializes timers and starts system timer
@@ -94,8 +144,12 @@ void timer_sys_init(void)
         ns_list_add_to_start(&system_timer_free, &startup_sys_timer_pool[i]);
     }
 
+#ifdef NS_EVENTLOOP_USE_DEADLINE_TIMER
+    platform_deadline_timer_register(timer_sys_deadline_interrupt);
+#else
     platform_tick_timer_register(timer_sys_interrupt);
     platform_tick_timer_start(TIMER_SYS_TICK_PERIOD);
+#endif
 }
 
 
@@ -103,7 +157,11 @@ void timer_sys_init(void)
 /*-------------------SYSTEM TIMER FUNCTIONS--------------------------*/
 void timer_sys_disable(void)
 {
+#ifdef NS_EVENTLOOP_USE_DEADLINE_TIMER
+    platform_deadline_timer_stop();
+#else
     platform_tick_timer_stop();
+#endif
 }
 
 /*
@@ -111,14 +169,23 @@ void timer_sys_disable(void)
  */
 int8_t timer_sys_wakeup(void)
 {
+#ifdef NS_EVENTLOOP_USE_DEADLINE_TIMER
+    platform_enter_critical();
+    timer_sys_reschedule();
+    platform_exit_critical();
+    return 0;
+#else
     return platform_tick_timer_start(TIMER_SYS_TICK_PERIOD);
+#endif
 }
 
 
+#ifndef NS_EVENTLOOP_USE_DEADLINE_TIMER
 static void timer_sys_interrupt(void)
 {
     system_timer_tick_update(1);
 }
+#endif
 
 
 
@@ -171,6 +238,10 @@ void timer_sys_event_cancel_critical(struct arm_event_storage *event)
     // If its unqueued it is on my timer list, otherwise it is in event-loop.
     if (event->state == ARM_LIB_EVENT_UNQUEUED) {
         ns_list_remove(&system_timer_list, timer);
+#ifdef NS_EVENTLOOP_USE_DEADLINE_TIMER
+        // The earliest deadline may have gone away
+        timer_sys_reschedule();
+#endif
     }
 }
 
@@ -189,18 +260,29 @@ uint32_t eventOS_event_timer_ticks(void)
 static void timer_sys_add(sys_timer_struct_s *timer)
 {
     uint32_t at = timer->launch_time;
+    bool added = false;
 
     // Find first timer scheduled to run after us, and insert before it.
     // (This means timers scheduled for same time run in order of request)
     ns_list_foreach(sys_timer_struct_s, t, &system_timer_list) {
         if (TICKS_BEFORE(at, t->launch_time)) {
             ns_list_add_before(&system_timer_list, t, timer);
-            return;
+            added = true;
+            break;
         }
     }
 
     // Didn't insert before another timer, so must be last.
-    ns_list_add_to_end(&system_timer_list, timer);
+    if (!added) {
+        ns_list_add_to_end(&system_timer_list, timer);
+    }
+
+#ifdef NS_EVENTLOOP_USE_DEADLINE_TIMER
+    if (ns_list_get_first(&system_timer_list) == timer) {
+        // New earliest deadline - bring the wakeup forward
+        timer_sys_reschedule();
+    }
+#endif
 }
 
 /* Called internally with lock held */
@@ -26,7 +26,14 @@
 static err_t emac_lwip_low_level_output(struct netif *netif, struct pbuf *p)
 {
     emac_interface_t *mac = (emac_interface_t *)netif->state;
-    bool ret = mac->ops.link_out(mac, (emac_stack_mem_t *)p);
+    bool ret;
+
+    if (mac->ops.link_out_chain) {
+        /* MAC scatter-gathers - one DMA descriptor per pbuf, no flatten */
+        ret = mac->ops.link_out_chain(mac, (emac_stack_mem_chain_t *)p);
+    } else {
+        ret = mac->ops.link_out(mac, (emac_stack_mem_t *)p);
+    }
 
     return ret ? ERR_OK : ERR_IF;
 }
@@ -44,6 +51,47 @@ static void emac_lwip_input(void *data, emac_stack_t *buf)
     }
 }
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+static u16_t emac_lwip_checksum_ctrl(emac_interface_t *mac)
+{
+    /* Everything in software unless the driver declares the MAC does it */
+    u16_t ctrl = NETIF_CHECKSUM_ENABLE_ALL;
+
+    if (!mac->ops.get_capabilities) {
+        return ctrl;
+    }
+
+    uint32_t caps = mac->ops.get_capabilities(mac);
+
+    if (caps & EMAC_CAPABILITY_CHECKSUM_GEN_IP) {
+        ctrl &= ~NETIF_CHECKSUM_GEN_IP;
+    }
+    if (caps & EMAC_CAPABILITY_CHECKSUM_GEN_UDP) {
+        ctrl &= ~NETIF_CHECKSUM_GEN_UDP;
+    }
+    if (caps & EMAC_CAPABILITY_CHECKSUM_GEN_TCP) {
+        ctrl &= ~NETIF_CHECKSUM_GEN_TCP;
+    }
+    if (caps & EMAC_CAPABILITY_CHECKSUM_GEN_ICMP) {
+        ctrl &= ~NETIF_CHECKSUM_GEN_ICMP;
+    }
+    if (caps & EMAC_CAPABILITY_CHECKSUM_CHECK_IP) {
+        ctrl &= ~NETIF_CHECKSUM_CHECK_IP;
+    }
+    if (caps & EMAC_CAPABILITY_CHECKSUM_CHECK_UDP) {
+        ctrl &= ~NETIF_CHECKSUM_CHECK_UDP;
+    }
+    if (caps & EMAC_CAPABILITY_CHECKSUM_CHECK_TCP) {
+        ctrl &= ~NETIF_CHECKSUM_CHECK_TCP;
+    }
+    if (caps & EMAC_CAPABILITY_CHECKSUM_CHECK_ICMP) {
+        ctrl &= ~NETIF_CHECKSUM_CHECK_ICMP;
+    }
+
+    return ctrl;
+}
+#endif /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+
 static void emac_lwip_state_change(void *data, bool up)
 {
     struct netif *netif = (struct netif *)data;
@@ -74,6 +122,11 @@ err_t emac_lwip_if_init(struct netif *netif)
     /* Interface capabilities */
     netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET | NETIF_FLAG_IGMP;
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    /* Leave checksums the MAC generates/verifies in hardware to the MAC */
+    NETIF_SET_CHECKSUM_CTRL(netif, emac_lwip_checksum_ctrl(mac));
+#endif
+
     mac->ops.get_ifname(mac, netif->name, 2);
 
 #if LWIP_IPV4
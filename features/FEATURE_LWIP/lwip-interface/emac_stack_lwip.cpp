@@ -18,6 +18,11 @@
 
 #include "emac_stack_mem.h"
 #include "pbuf.h"
+#include "platform/mbed_critical.h"
+
+#ifndef MBED_CONF_LWIP_EMAC_ZEROCOPY_RX_BUFS
+#define MBED_CONF_LWIP_EMAC_ZEROCOPY_RX_BUFS 8
+#endif
 
 emac_stack_mem_t *emac_stack_mem_alloc(emac_stack_t* stack, uint32_t size, uint32_t align)
 {
@@ -42,6 +47,86 @@ emac_stack_mem_t *emac_stack_mem_alloc(emac_stack_t* stack, uint32_t size, uint3
     return (emac_stack_mem_t*)pbuf;
 }
 
+#if MBED_CONF_LWIP_EMAC_ZEROCOPY_RX_BUFS > 0 && LWIP_SUPPORT_CUSTOM_PBUF
+
+// Wrappers for handing driver-owned (DMA-filled) buffers into the stack
+// without copying. The stack reads the payload in place and the custom
+// free function returns the buffer to the driver.
+struct zerocopy_pbuf {
+    struct pbuf_custom custom;
+    struct zerocopy_pbuf *next;
+    emac_stack_mem_free_fn free_cb;
+    void *arg;
+    void *payload;
+};
+
+static struct zerocopy_pbuf zerocopy_pbufs[MBED_CONF_LWIP_EMAC_ZEROCOPY_RX_BUFS];
+static struct zerocopy_pbuf *zerocopy_free_list;
+static bool zerocopy_initialized;
+
+static void zerocopy_pbuf_free(struct pbuf *p)
+{
+    struct zerocopy_pbuf *zcp = (struct zerocopy_pbuf *)p;
+
+    zcp->free_cb(zcp->arg, zcp->payload);
+
+    core_util_critical_section_enter();
+    zcp->next = zerocopy_free_list;
+    zerocopy_free_list = zcp;
+    core_util_critical_section_exit();
+}
+
+emac_stack_mem_t *emac_stack_mem_alloc_ref(emac_stack_t* stack, void *ptr, uint32_t len,
+                                           emac_stack_mem_free_fn free_cb, void *arg)
+{
+    core_util_critical_section_enter();
+
+    if (!zerocopy_initialized) {
+        for (int i = 0; i < MBED_CONF_LWIP_EMAC_ZEROCOPY_RX_BUFS; i++) {
+            zerocopy_pbufs[i].next = zerocopy_free_list;
+            zerocopy_free_list = &zerocopy_pbufs[i];
+        }
+        zerocopy_initialized = true;
+    }
+
+    struct zerocopy_pbuf *zcp = zerocopy_free_list;
+    if (zcp) {
+        zerocopy_free_list = zcp->next;
+    }
+
+    core_util_critical_section_exit();
+
+    if (!zcp) {
+        return NULL;
+    }
+
+    zcp->custom.custom_free_function = zerocopy_pbuf_free;
+    zcp->free_cb = free_cb;
+    zcp->arg = arg;
+    zcp->payload = ptr;
+
+    struct pbuf *pbuf = pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF, &zcp->custom, ptr, len);
+    if (pbuf == NULL) {
+        core_util_critical_section_enter();
+        zcp->next = zerocopy_free_list;
+        zerocopy_free_list = zcp;
+        core_util_critical_section_exit();
+        return NULL;
+    }
+
+    return (emac_stack_mem_t *)pbuf;
+}
+
+#else
+
+emac_stack_mem_t *emac_stack_mem_alloc_ref(emac_stack_t* stack, void *ptr, uint32_t len,
+                                           emac_stack_mem_free_fn free_cb, void *arg)
+{
+    return NULL;
+}
+
+#endif
+
 void emac_stack_mem_free(emac_stack_t* stack, emac_stack_mem_t *mem)
 {
     pbuf_free((struct pbuf*)mem);
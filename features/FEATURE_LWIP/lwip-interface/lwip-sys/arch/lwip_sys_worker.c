@@ -0,0 +1,185 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lwip/opt.h"
+
+#if NO_SYS == 0
+
+#include "lwip/sys.h"
+#include "lwip/mem.h"
+#include "arch/sys_worker.h"
+#include "cmsis_os2.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+// Thread priority and stack for the lwip worker thread. The priority
+// must stay below TCPIP_THREAD_PRIO - the whole point of the worker is
+// that its jobs never delay tcpip mailbox drains.
+#ifndef WORKER_THREAD_PRIO
+#define WORKER_THREAD_PRIO          (osPriorityLow)
+#endif
+
+#ifndef WORKER_THREAD_STACKSIZE
+#define WORKER_THREAD_STACKSIZE     DEFAULT_THREAD_STACKSIZE
+#endif
+
+#define SYS_WORKER_MBOX_SIZE        8
+#define SYS_WORKER_PERIODIC_N       4
+
+typedef struct sys_worker_job {
+    sys_worker_fn fn;       // NULL means "wake up only", used to re-evaluate periodic deadlines
+    void *arg;
+} sys_worker_job_t;
+
+typedef struct sys_worker_periodic {
+    sys_worker_fn fn;
+    void *arg;
+    u32_t interval;
+    u32_t due;
+} sys_worker_periodic_t;
+
+static sys_mbox_t worker_mbox;
+static bool worker_running;
+
+static sys_worker_periodic_t periodic_jobs[SYS_WORKER_PERIODIC_N];
+static sys_mutex_t periodic_mutex;
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_worker_periodic_run
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Runs all periodic jobs whose deadline has passed and returns the
+ *      mailbox fetch timeout until the next deadline (0 = wait forever,
+ *      used when no periodic jobs are registered).
+ *---------------------------------------------------------------------------*/
+static u32_t sys_worker_periodic_run(void) {
+    u32_t now = sys_now();
+    u32_t wait = 0;
+
+    sys_mutex_lock(&periodic_mutex);
+    for (int i = 0; i < SYS_WORKER_PERIODIC_N; i++) {
+        sys_worker_periodic_t *job = &periodic_jobs[i];
+        if (job->fn == NULL) {
+            continue;
+        }
+        if ((s32_t)(now - job->due) >= 0) {
+            // Drop the lock while the job runs so a job may register others
+            sys_mutex_unlock(&periodic_mutex);
+            job->fn(job->arg);
+            sys_mutex_lock(&periodic_mutex);
+            job->due = sys_now() + job->interval;
+        }
+        u32_t remaining = job->due - now;
+        if (wait == 0 || remaining < wait) {
+            wait = remaining ? remaining : 1;
+        }
+    }
+    sys_mutex_unlock(&periodic_mutex);
+
+    return wait;
+}
+
+static void sys_worker_thread(void *arg) {
+    u32_t wait = 0;
+
+    while (true) {
+        sys_worker_job_t *job = NULL;
+        u32_t res = sys_arch_mbox_fetch(&worker_mbox, (void **)&job, wait);
+
+        if (res != SYS_ARCH_TIMEOUT && job != NULL) {
+            if (job->fn != NULL) {
+                job->fn(job->arg);
+            }
+            mem_free(job);
+        }
+
+        wait = sys_worker_periodic_run();
+    }
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_worker_init
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Creates the worker mailbox and thread. Idempotent; called from
+ *      stack bring-up before the tcpip thread is started.
+ *---------------------------------------------------------------------------*/
+void sys_worker_init(void) {
+    if (worker_running) {
+        return;
+    }
+
+    sys_mbox_new(&worker_mbox, SYS_WORKER_MBOX_SIZE);
+    sys_mutex_new(&periodic_mutex);
+    memset(periodic_jobs, 0, sizeof(periodic_jobs));
+
+    sys_thread_new("lwip_worker", sys_worker_thread, NULL,
+                   WORKER_THREAD_STACKSIZE, WORKER_THREAD_PRIO);
+
+    worker_running = true;
+}
+
+err_t sys_worker_post(sys_worker_fn fn, void *arg) {
+    if (!worker_running) {
+        return ERR_IF;
+    }
+
+    sys_worker_job_t *job = (sys_worker_job_t *)mem_malloc(sizeof(*job));
+    if (job == NULL) {
+        return ERR_MEM;
+    }
+
+    job->fn = fn;
+    job->arg = arg;
+
+    if (sys_mbox_trypost(&worker_mbox, job) != ERR_OK) {
+        mem_free(job);
+        return ERR_MEM;
+    }
+
+    return ERR_OK;
+}
+
+err_t sys_worker_post_periodic(sys_worker_fn fn, void *arg, u32_t interval_ms) {
+    if (!worker_running) {
+        return ERR_IF;
+    }
+
+    err_t err = ERR_MEM;
+
+    sys_mutex_lock(&periodic_mutex);
+    for (int i = 0; i < SYS_WORKER_PERIODIC_N; i++) {
+        if (periodic_jobs[i].fn == NULL) {
+            periodic_jobs[i].fn = fn;
+            periodic_jobs[i].arg = arg;
+            periodic_jobs[i].interval = interval_ms;
+            periodic_jobs[i].due = sys_now() + interval_ms;
+            err = ERR_OK;
+            break;
+        }
+    }
+    sys_mutex_unlock(&periodic_mutex);
+
+    if (err == ERR_OK) {
+        // Kick the worker in case it is blocked past the new deadline
+        sys_worker_post(NULL, NULL);
+    }
+
+    return err;
+}
+
+#endif /* NO_SYS == 0 */
@@ -0,0 +1,72 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __ARCH_SYS_WORKER_H__
+#define __ARCH_SYS_WORKER_H__
+
+#include "lwip/opt.h"
+#include "lwip/err.h"
+
+#if NO_SYS == 0
+
+/** Work item executed on the low-priority lwip worker thread */
+typedef void (*sys_worker_fn)(void *arg);
+
+/** Create the worker thread and its job mailbox
+ *
+ * Called once during stack bring-up, before the tcpip thread starts.
+ * Safe to call again; subsequent calls are no-ops.
+ */
+void sys_worker_init(void);
+
+/** Queue a one-shot job on the worker thread
+ *
+ * The worker runs at a lower priority than the tcpip thread, so work
+ * posted here (hash precomputation, housekeeping) does not add latency
+ * to tcpip mailbox drains. Posting never blocks; callers must be
+ * prepared to do the work inline when the post fails.
+ *
+ * @param fn    Function to run on the worker thread
+ * @param arg   Argument passed to fn
+ * @return      ERR_OK on success, ERR_IF if the worker is not running,
+ *              ERR_MEM if the job could not be queued
+ */
+err_t sys_worker_post(sys_worker_fn fn, void *arg);
+
+/** Register a job to run periodically on the worker thread
+ *
+ * Intended for housekeeping that does not need to run on the tcpip
+ * thread - lwip's own protocol timers stay there, as the core is
+ * single-threaded. Intervals are best-effort: a job runs no earlier
+ * than its interval, later if the worker is busy or starved.
+ *
+ * @param fn          Function to run on the worker thread
+ * @param arg         Argument passed to fn
+ * @param interval_ms Interval between runs, in milliseconds
+ * @return            ERR_OK on success, ERR_MEM if the periodic job
+ *                    table is full
+ */
+err_t sys_worker_post_periodic(sys_worker_fn fn, void *arg, u32_t interval_ms);
+
+#else /* NO_SYS */
+
+/* Without an OS there is no worker; callers fall back to inline work */
+#define sys_worker_init()
+#define sys_worker_post(fn, arg)                    (ERR_IF)
+#define sys_worker_post_periodic(fn, arg, interval) (ERR_IF)
+
+#endif /* NO_SYS */
+
+#endif /* __ARCH_SYS_WORKER_H__ */
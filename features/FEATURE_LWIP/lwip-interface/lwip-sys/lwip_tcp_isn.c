@@ -21,11 +21,13 @@
  * relative to the boot time, i.e., that it starts at 0 at system boot, and
  * only ever increases monotonically.
  *
- * For efficiency reasons, a single MD5 input buffer is used, and partially
- * filled in at initialization time.  Specifically, of this 64-byte buffer, the
- * first 36 bytes are used for the four-way TCP tuple data, followed by the
- * 16-byte secret, followed by 12-byte zero padding.  The 64-byte size of the
- * buffer should achieve the best performance for the actual MD5 computation.
+ * For efficiency reasons, the hash input is split into two MD5 blocks.  The
+ * first 64-byte block contains the 16-byte secret followed by zero padding;
+ * since it is fixed after initialization, its MD5 intermediate state is
+ * computed once - on the low-priority lwip worker thread, off the tcpip
+ * thread - and cloned for every new connection.  The second block holds the
+ * 36 bytes of four-way TCP tuple data, so each new connection costs a single
+ * MD5 block computation on the tcpip thread rather than two.
  *
  * Basic usage:
  *
@@ -73,6 +75,7 @@
 #include "lwip/opt.h"
 #include "lwip/ip_addr.h"
 #include "lwip/sys.h"
+#include "arch/sys_worker.h"
 #include <string.h>
 
 /* pull in md5 of ppp? */
@@ -92,9 +95,31 @@
 #include "netif/ppp/polarssl/lwip_md5.c"
 #endif
 
-static u8_t input[64];
+static u8_t input[36];
+static u8_t secret_block[64];
 static u32_t base_time;
 
+/* MD5 state after absorbing secret_block; cloned per connection once ready.
+ * Written only by tcp_isn_precompute, read only by the tcpip thread. */
+static lwip_md5_context base_ctx;
+static volatile u8_t base_ready;
+
+/**
+ * Absorb the secret block into the reusable MD5 base state.
+ *
+ * Runs on the lwip worker thread, so the per-boot hash setup does not
+ * add latency to the tcpip thread.
+ */
+static void
+tcp_isn_precompute(void *arg)
+{
+  LWIP_UNUSED_ARG(arg);
+
+  lwip_md5_starts(&base_ctx);
+  lwip_md5_update(&base_ctx, secret_block, sizeof(secret_block));
+  base_ready = 1;
+}
+
 /**
  * Initialize the TCP ISN module, with the boot time and a secret.
  *
@@ -104,10 +129,17 @@ static u32_t base_time;
 void
 lwip_init_tcp_isn(u32_t boot_time, const u8_t *secret_16_bytes)
 {
-  /* Initialize the input buffer with the secret and trailing zeroes. */
-  memset(input, 0, sizeof(input));
+  /* Initialize the secret block with the secret and trailing zeroes. */
+  memset(secret_block, 0, sizeof(secret_block));
+
+  MEMCPY(&secret_block[0], secret_16_bytes, 16);
 
-  MEMCPY(&input[36], secret_16_bytes, 16);
+  /* Absorb the secret off the tcpip thread; until that completes, the
+   * hook falls back to doing the extra block inline. */
+  base_ready = 0;
+  if (sys_worker_post(tcp_isn_precompute, NULL) != ERR_OK) {
+    tcp_isn_precompute(NULL);
+  }
 
   /* Save the boot time in 4-us units. Overflow is no problem here. */
   base_time = boot_time * 250000;
@@ -175,10 +207,15 @@ lwip_hook_tcp_isn(const void *local_ip_ptr, u16_t local_port,
   input[34] = remote_port >> 8;
   input[35] = remote_port & 0xff;
 
-  /* The secret and padding are already filled in. */
-
-  /* Generate the hash, using MD5. */
-  lwip_md5_starts(&ctx);
+  /* Generate the hash, using MD5. Start from the precomputed state over
+   * the secret block when the worker has produced it; hash the secret
+   * block inline otherwise (boot-time window only). */
+  if (base_ready) {
+    ctx = base_ctx;
+  } else {
+    lwip_md5_starts(&ctx);
+    lwip_md5_update(&ctx, secret_block, sizeof(secret_block));
+  }
   lwip_md5_update(&ctx, input, sizeof(input));
   lwip_md5_finish(&ctx, output);
 
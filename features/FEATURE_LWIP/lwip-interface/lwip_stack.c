@@ -34,9 +34,13 @@
 #include "lwip/mld6.h"
 #include "lwip/dns.h"
 #include "lwip/udp.h"
+#include "lwip/stats.h"
+#include "lwip/memp.h"
+#include "lwip/priv/memp_priv.h"
 #include "netif/lwip_ethernet.h"
 #include "emac_api.h"
 #include "ppp_lwip.h"
+#include "arch/sys_worker.h"
 
 static nsapi_error_t mbed_lwip_err_remap(err_t err);
 
@@ -53,6 +57,8 @@ static struct lwip_socket {
     struct netconn *conn;
     struct netbuf *buf;
     u16_t offset;
+    bool corked;
+    u32_t snd_buf_limit;
 
     void (*cb)(void *);
     void *data;
@@ -259,6 +265,7 @@ const ip_addr_t *mbed_lwip_get_ip_addr(bool any_addr, const struct netif *netif)
     return NULL;
 }
 
+#if LWIP_DNS
 static void add_dns_addr_to_dns_list_index(const u8_t addr_type, const u8_t index)
 {
 #if LWIP_IPV6
@@ -344,6 +351,12 @@ void add_dns_addr(struct netif *lwip_netif)
     }
 #endif
 }
+#else /* LWIP_DNS */
+void add_dns_addr(struct netif *lwip_netif)
+{
+    (void) lwip_netif;
+}
+#endif /* LWIP_DNS */
 
 static sys_sem_t lwip_tcpip_inited;
 static void mbed_lwip_tcpip_init_irq(void *eh)
@@ -493,12 +506,17 @@ static void mbed_lwip_core_init(void)
 	// Seed lwip random
         lwip_seed_random();
 
+        // Start the low-priority worker before anything can post to it
+        sys_worker_init();
+
+#if LWIP_TCP
         // Initialise TCP sequence number
         uint32_t tcp_isn_secret[4];
         for (int i = 0; i < 4; i++) {
             tcp_isn_secret[i] = LWIP_RAND();
         }
         lwip_init_tcp_isn(0, (u8_t *) &tcp_isn_secret);
+#endif
 
         sys_sem_new(&lwip_tcpip_inited, 0);
         sys_sem_new(&lwip_netif_linked, 0);
@@ -818,6 +836,9 @@ static nsapi_error_t mbed_lwip_err_remap(err_t err) {
 /* LWIP network stack implementation */
 static nsapi_error_t mbed_lwip_gethostbyname(nsapi_stack_t *stack, const char *host, nsapi_addr_t *addr, nsapi_version_t version)
 {
+#if !LWIP_DNS
+    return NSAPI_ERROR_UNSUPPORTED;
+#else
     ip_addr_t lwip_addr;
 
 #if LWIP_IPV4 && LWIP_IPV6
@@ -869,10 +890,14 @@ static nsapi_error_t mbed_lwip_gethostbyname(nsapi_stack_t *stack, const char *h
     convert_lwip_addr_to_mbed(addr, &lwip_addr);
 
     return 0;
+#endif
 }
 
 static nsapi_error_t mbed_lwip_add_dns_server(nsapi_stack_t *stack, nsapi_addr_t addr)
 {
+#if !LWIP_DNS
+    return NSAPI_ERROR_UNSUPPORTED;
+#else
     // Shift all dns servers down to give precedence to new server
     for (int i = DNS_MAX_SERVERS-1; i > 0; i--) {
         dns_setserver(i, dns_getserver(i-1));
@@ -885,6 +910,7 @@ static nsapi_error_t mbed_lwip_add_dns_server(nsapi_stack_t *stack, nsapi_addr_t
 
     dns_setserver(0, &ip_addr);
     return 0;
+#endif
 }
 
 static nsapi_error_t mbed_lwip_socket_open(nsapi_stack_t *stack, nsapi_socket_t *handle, nsapi_protocol_t proto)
@@ -894,6 +920,12 @@ static nsapi_error_t mbed_lwip_socket_open(nsapi_stack_t *stack, nsapi_socket_t
         return NSAPI_ERROR_NO_CONNECTION;
     }
 
+#if !LWIP_TCP
+    if (proto == NSAPI_TCP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+#endif
+
     // allocate a socket
     struct lwip_socket *s = mbed_lwip_arena_alloc();
     if (!s) {
@@ -952,10 +984,14 @@ static nsapi_error_t mbed_lwip_socket_bind(nsapi_stack_t *stack, nsapi_socket_t
 
 static nsapi_error_t mbed_lwip_socket_listen(nsapi_stack_t *stack, nsapi_socket_t handle, int backlog)
 {
+#if !LWIP_TCP
+    return NSAPI_ERROR_UNSUPPORTED;
+#else
     struct lwip_socket *s = (struct lwip_socket *)handle;
 
     err_t err = netconn_listen_with_backlog(s->conn, backlog);
     return mbed_lwip_err_remap(err);
+#endif
 }
 
 static nsapi_error_t mbed_lwip_socket_connect(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_addr_t addr, uint16_t port)
@@ -976,6 +1012,9 @@ static nsapi_error_t mbed_lwip_socket_connect(nsapi_stack_t *stack, nsapi_socket
 
 static nsapi_error_t mbed_lwip_socket_accept(nsapi_stack_t *stack, nsapi_socket_t server, nsapi_socket_t *handle, nsapi_addr_t *addr, uint16_t *port)
 {
+#if !LWIP_TCP
+    return NSAPI_ERROR_UNSUPPORTED;
+#else
     struct lwip_socket *s = (struct lwip_socket *)server;
     struct lwip_socket *ns = mbed_lwip_arena_alloc();
     if (!ns) {
@@ -998,14 +1037,48 @@ static nsapi_error_t mbed_lwip_socket_accept(nsapi_stack_t *stack, nsapi_socket_
     netconn_set_nonblocking(ns->conn, true);
 
     return 0;
+#endif
 }
 
+#if LWIP_TCP
+// Cap a TCP write so no more unacknowledged data than the socket's
+// send-buffer limit is queued, approximating a per-socket SO_SNDBUF on
+// top of the compile-time TCP_SND_BUF
+static nsapi_size_t mbed_lwip_snd_buf_room(struct lwip_socket *s, nsapi_size_t size)
+{
+    if (s->snd_buf_limit == 0 || s->conn->type != NETCONN_TCP || !s->conn->pcb.tcp) {
+        return size;
+    }
+
+    u32_t outstanding = TCP_SND_BUF - tcp_sndbuf(s->conn->pcb.tcp);
+    if (outstanding >= s->snd_buf_limit) {
+        return 0;
+    }
+
+    u32_t room = s->snd_buf_limit - outstanding;
+    return (size < room) ? size : room;
+}
+#endif
+
 static nsapi_size_or_error_t mbed_lwip_socket_send(nsapi_stack_t *stack, nsapi_socket_t handle, const void *data, nsapi_size_t size)
 {
     struct lwip_socket *s = (struct lwip_socket *)handle;
     size_t bytes_written = 0;
 
-    err_t err = netconn_write_partly(s->conn, data, size, NETCONN_COPY, &bytes_written);
+#if LWIP_TCP
+    if (size > 0) {
+        size = mbed_lwip_snd_buf_room(s, size);
+        if (size == 0) {
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+    }
+#endif
+
+    // while corked, tell lwip more data is coming so partial segments are
+    // held back and coalesced instead of going out on the wire
+    u8_t flags = NETCONN_COPY | (s->corked ? NETCONN_MORE : 0);
+
+    err_t err = netconn_write_partly(s->conn, data, size, flags, &bytes_written);
     if (err != ERR_OK) {
         return mbed_lwip_err_remap(err);
     }
@@ -1013,6 +1086,45 @@ static nsapi_size_or_error_t mbed_lwip_socket_send(nsapi_stack_t *stack, nsapi_s
     return (nsapi_size_or_error_t)bytes_written;
 }
 
+static nsapi_size_or_error_t mbed_lwip_socket_sendv(nsapi_stack_t *stack, nsapi_socket_t handle, const nsapi_iovec_t *iov, int iovcnt)
+{
+    struct lwip_socket *s = (struct lwip_socket *)handle;
+    nsapi_size_or_error_t total = 0;
+
+    for (int i = 0; i < iovcnt; i++) {
+        size_t bytes_written = 0;
+        nsapi_size_t len = iov[i].len;
+
+#if LWIP_TCP
+        if (len > 0) {
+            len = mbed_lwip_snd_buf_room(s, len);
+            if (len == 0) {
+                return (total > 0) ? total : NSAPI_ERROR_WOULD_BLOCK;
+            }
+        }
+#endif
+
+        // all pieces but the last carry NETCONN_MORE so lwip packs the
+        // whole message into segments without intervening pushes
+        u8_t flags = NETCONN_COPY;
+        if (i < iovcnt - 1 || s->corked) {
+            flags |= NETCONN_MORE;
+        }
+
+        err_t err = netconn_write_partly(s->conn, iov[i].base, len, flags, &bytes_written);
+        if (err != ERR_OK) {
+            return (total > 0) ? total : mbed_lwip_err_remap(err);
+        }
+
+        total += (nsapi_size_or_error_t)bytes_written;
+        if (bytes_written < iov[i].len) {
+            break;
+        }
+    }
+
+    return total;
+}
+
 static nsapi_size_or_error_t mbed_lwip_socket_recv(nsapi_stack_t *stack, nsapi_socket_t handle, void *data, nsapi_size_t size)
 {
     struct lwip_socket *s = (struct lwip_socket *)handle;
@@ -1037,6 +1149,54 @@ static nsapi_size_or_error_t mbed_lwip_socket_recv(nsapi_stack_t *stack, nsapi_s
     return recv;
 }
 
+static nsapi_size_or_error_t mbed_lwip_socket_recv_borrow(nsapi_stack_t *stack, nsapi_socket_t handle, void **data)
+{
+    struct lwip_socket *s = (struct lwip_socket *)handle;
+
+    if (!s->buf) {
+        err_t err = netconn_recv(s->conn, &s->buf);
+        s->offset = 0;
+
+        if (err != ERR_OK) {
+            return mbed_lwip_err_remap(err);
+        }
+    }
+
+    // walk the pbuf chain to the part holding the read offset and lend
+    // out the remainder of that contiguous part
+    void *ptr;
+    u16_t len;
+    u16_t offset = s->offset;
+
+    netbuf_first(s->buf);
+    netbuf_data(s->buf, &ptr, &len);
+    while (offset >= len && netbuf_next(s->buf) >= 0) {
+        offset -= len;
+        netbuf_data(s->buf, &ptr, &len);
+    }
+
+    *data = (char *)ptr + offset;
+    return len - offset;
+}
+
+static nsapi_error_t mbed_lwip_socket_recv_release(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_size_t size)
+{
+    struct lwip_socket *s = (struct lwip_socket *)handle;
+
+    if (!s->buf || s->offset + size > netbuf_len(s->buf)) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    s->offset += size;
+
+    if (s->offset >= netbuf_len(s->buf)) {
+        netbuf_delete(s->buf);
+        s->buf = 0;
+    }
+
+    return 0;
+}
+
 static nsapi_size_or_error_t mbed_lwip_socket_sendto(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_addr_t addr, uint16_t port, const void *data, nsapi_size_t size)
 {
     struct lwip_socket *s = (struct lwip_socket *)handle;
@@ -1112,6 +1272,65 @@ static nsapi_error_t mbed_lwip_setsockopt(nsapi_stack_t *stack, nsapi_socket_t h
             return 0;
 #endif
 
+#if LWIP_TCP
+        case NSAPI_CORK:
+            if (optlen != sizeof(int) || s->conn->type != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            s->corked = (*(int *)optval != 0);
+
+            // uncorking flushes anything lwip was holding back
+            if (!s->corked) {
+                tcp_output(s->conn->pcb.tcp);
+            }
+            return 0;
+
+        case NSAPI_NODELAY:
+            if (optlen != sizeof(int) || s->conn->type != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            if (*(int *)optval) {
+                tcp_nagle_disable(s->conn->pcb.tcp);
+            } else {
+                tcp_nagle_enable(s->conn->pcb.tcp);
+            }
+            return 0;
+
+        case NSAPI_SNDBUF:
+            if (optlen != sizeof(int) || s->conn->type != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            if (*(int *)optval < 0 || (u32_t)*(int *)optval > TCP_SND_BUF) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+            // bounds the unacknowledged data queued on this socket;
+            // 0 restores the compile-time TCP_SND_BUF limit
+            s->snd_buf_limit = *(int *)optval;
+            return 0;
+
+        case NSAPI_RCVBUF:
+            if (optlen != sizeof(int) || s->conn->type != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            if (*(int *)optval <= 0 || (u32_t)*(int *)optval > TCP_WND) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+            // the offered window stops growing past the new maximum as
+            // data is consumed; an already announced window is never
+            // retracted
+            s->conn->pcb.tcp->rcv_wnd_max = *(int *)optval;
+            if (s->conn->pcb.tcp->rcv_wnd > s->conn->pcb.tcp->rcv_wnd_max) {
+                s->conn->pcb.tcp->rcv_wnd = s->conn->pcb.tcp->rcv_wnd_max;
+            }
+            return 0;
+#endif
+
         case NSAPI_REUSEADDR:
             if (optlen != sizeof(int)) {
                 return NSAPI_ERROR_UNSUPPORTED;
@@ -1137,6 +1356,33 @@ static void mbed_lwip_socket_attach(nsapi_stack_t *stack, nsapi_socket_t handle,
     s->data = data;
 }
 
+#if MEMP_STATS
+static nsapi_size_or_error_t mbed_lwip_get_pool_stats(nsapi_stack_t *stack, nsapi_pool_stats_t *stats, unsigned count)
+{
+    /* Counters are read without taking the core lock - lwip updates them
+     * with plain stores, so each field is coherent on its own, which is
+     * all telemetry needs */
+    unsigned n = 0;
+
+    for (unsigned i = 0; i < MEMP_MAX && n < count; i++) {
+        const struct stats_mem *mem = memp_pools[i]->stats;
+
+#if defined(LWIP_DEBUG) || MEMP_OVERFLOW_CHECK || LWIP_STATS_DISPLAY
+        stats[n].name = memp_pools[i]->desc;
+#else
+        stats[n].name = NULL;
+#endif
+        stats[n].avail = mem->avail;
+        stats[n].used = mem->used;
+        stats[n].max = mem->max;
+        stats[n].err = mem->err;
+        n++;
+    }
+
+    return n;
+}
+#endif /* MEMP_STATS */
+
 /* LWIP network stack */
 const nsapi_stack_api_t lwip_stack_api = {
     .gethostbyname      = mbed_lwip_gethostbyname,
@@ -1153,6 +1399,12 @@ const nsapi_stack_api_t lwip_stack_api = {
     .socket_recvfrom    = mbed_lwip_socket_recvfrom,
     .setsockopt         = mbed_lwip_setsockopt,
     .socket_attach      = mbed_lwip_socket_attach,
+    .socket_recv_borrow = mbed_lwip_socket_recv_borrow,
+    .socket_recv_release = mbed_lwip_socket_recv_release,
+    .socket_sendv       = mbed_lwip_socket_sendv,
+#if MEMP_STATS
+    .get_pool_stats     = mbed_lwip_get_pool_stats,
+#endif
 };
 
 nsapi_stack_t lwip_stack = {
@@ -152,6 +152,12 @@
 #define PBUF_POOL_BUFSIZE           MBED_CONF_LWIP_PBUF_POOL_BUFSIZE
 #endif
 
+// Custom pbufs are needed so emac drivers can hand DMA-filled buffers
+// straight into the stack through emac_stack_mem_alloc_ref
+#if MBED_CONF_LWIP_EMAC_ZEROCOPY_RX_BUFS > 0
+#define LWIP_SUPPORT_CUSTOM_PBUF    1
+#endif
+
 #ifdef MBED_CONF_LWIP_MEM_SIZE
 #undef MEM_SIZE
 #define MEM_SIZE                    MBED_CONF_LWIP_MEM_SIZE
@@ -209,14 +215,23 @@
 #define LWIP_TCP                    0
 #endif
 
+#if MBED_CONF_LWIP_DNS_ENABLED
 #define LWIP_DNS                    1
+#else
+#define LWIP_DNS                    0
+#endif
+
 #define LWIP_SOCKET                 0
 
 #define SO_REUSE                    1
 
 // Support Multicast
 #include "stdlib.h"
+#if MBED_CONF_LWIP_IGMP_ENABLED
 #define LWIP_IGMP                   LWIP_IPV4
+#else
+#define LWIP_IGMP                   0
+#endif
 #define LWIP_RAND()                 lwip_get_random()
 
 #define LWIP_COMPAT_SOCKETS         0
@@ -279,8 +294,33 @@
 #define LWIP_DBG_MIN_LEVEL          LWIP_DBG_LEVEL_ALL
 #else
 #define LWIP_NOASSERT               1
+#if MBED_CONF_LWIP_MEMP_STATS
+// Per-pool occupancy, high-water marks and drop counters, surfaced
+// through NetworkStack::get_pool_stats for fleet telemetry. Only the
+// pool counters are wanted - the per-protocol stats stay off.
+#define LWIP_STATS                  1
+#define LWIP_STATS_DISPLAY          1
+#define MEMP_STATS                  1
+#define LINK_STATS                  0
+#define ETHARP_STATS                0
+#define IP_STATS                    0
+#define IPFRAG_STATS                0
+#define ICMP_STATS                  0
+#define IGMP_STATS                  0
+#define UDP_STATS                   0
+#define TCP_STATS                   0
+#define MEM_STATS                   0
+#define SYS_STATS                   0
+#define IP6_STATS                   0
+#define ICMP6_STATS                 0
+#define IP6_FRAG_STATS              0
+#define MLD6_STATS                  0
+#define ND6_STATS                   0
+#define MIB2_STATS                  0
+#else
 #define LWIP_STATS                  0
 #endif
+#endif
 
 #define TRACE_TO_ASCII_HEX_DUMP     0
 
@@ -331,6 +371,11 @@
 // Checksum-on-copy disabled due to https://savannah.nongnu.org/bugs/?50914
 #define LWIP_CHECKSUM_ON_COPY       0
 
+// Checksum generation/checking is decided per netif, so interfaces whose
+// MAC offloads checksums in hardware (EMAC_CAPABILITY_CHECKSUM_*) skip
+// the software summing while other interfaces keep it
+#define LWIP_CHECKSUM_CTRL_PER_NETIF 1
+
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETIF_STATUS_CALLBACK  1
 #define LWIP_NETIF_LINK_CALLBACK    1
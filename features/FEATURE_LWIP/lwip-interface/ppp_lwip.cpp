@@ -257,8 +257,24 @@ static void ppp_input()
     // Infinite loop, but we assume that we can read faster than the
     // serial, so we will fairly rapidly hit -EAGAIN.
     for (;;) {
-        u8_t buffer[16];
-        ssize_t len = my_stream->read(buffer, sizeof buffer);
+        // Fast path: deframe in place on the stream's own RX buffer
+        // segments - no copy between the ring and the HDLC parser
+        const void *borrowed;
+        ssize_t len = my_stream->read_borrow(&borrowed);
+        if (len > 0) {
+            pppos_input(my_ppp_pcb, (u8_t *)borrowed, len);
+            my_stream->read_release(len);
+            continue;
+        } else if (len == -EAGAIN) {
+            break;
+        } else if (len != -ENOSYS) {
+            handle_modem_hangup();
+            return;
+        }
+
+        // Stream cannot lend its buffer - copy out in chunks
+        u8_t buffer[64];
+        len = my_stream->read(buffer, sizeof buffer);
         if (len == -EAGAIN) {
             break;
         } else if (len <= 0) {
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __UVISOR_API_RPC_BATCH_H__
+#define __UVISOR_API_RPC_BATCH_H__
+
+#include "api/inc/rpc.h"
+#include "api/inc/rpc_exports.h"
+#include "api/inc/rpc_gateway.h"
+#include "api/inc/uvisor_exports.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/* Batched RPC
+ *
+ * A synchronous RPC gateway call costs a full round trip through uVisor per
+ * call: the caller blocks until the target box has been scheduled, has
+ * serviced the message and the result has been delivered back. A caller that
+ * issues a burst of small calls to the same box (for example a secure-storage
+ * box servicing twenty reads at boot) pays that overhead per call.
+ *
+ * A batch instead enqueues every call asynchronously up front and then waits
+ * once. All messages are already sitting in the target's incoming queue the
+ * first time it gets scheduled, so it services the whole burst in one
+ * activation and the caller collects all results in a single completion pass,
+ * rather than ping-ponging between the boxes per call.
+ *
+ * For payloads too large for the four register-sized RPC parameters, the
+ * convention is to carry bulk data out of band: allocate the buffer with
+ * uvisor_page_malloc() (or place it in a box-shared memory region covered by
+ * an ACL for both boxes) and pass only its address and size as RPC
+ * parameters. The RPC message then stays register-sized no matter the
+ * payload, and the callee reads the data in place instead of having it
+ * marshalled across the boundary.
+ *
+ * Batches must not outlive their scope (the result tokens refer to live
+ * message slots), and a batch may only be waited on once.
+ */
+
+/* Most calls a single batch can carry. A batch holds one result token and
+ * one return value per call, so the cost of a larger batch is two words of
+ * caller memory per slot. */
+#ifndef UVISOR_RPC_BATCH_MAX
+#define UVISOR_RPC_BATCH_MAX 24
+#endif
+
+typedef struct uvisor_rpc_batch {
+    uvisor_rpc_result_t results[UVISOR_RPC_BATCH_MAX];
+    uint32_t rets[UVISOR_RPC_BATCH_MAX];
+    size_t count;
+} uvisor_rpc_batch_t;
+
+/** Reset a batch so it can record a new burst of calls. */
+static inline void uvisor_rpc_batch_init(uvisor_rpc_batch_t * batch)
+{
+    batch->count = 0;
+}
+
+/** Start one call of a batch.
+ *
+ * The call is enqueued asynchronously through the target's RPC gateway and
+ * its result token recorded in the batch; nothing blocks here. The return
+ * value of the call is available from uvisor_rpc_batch_ret() after
+ * uvisor_rpc_batch_wait() has completed the batch.
+ *
+ * @param batch    the batch to record the call in
+ * @param p0..p3   the four parameters to call the target function with
+ * @param gateway  the RPC gateway of the target function
+ * @return         the index of the call within the batch, or a negative
+ *                 error if the batch is full or the target's message queue
+ *                 has no free slot (in which case wait for the calls made so
+ *                 far and retry in a fresh batch)
+ */
+static inline int uvisor_rpc_batch_call(uvisor_rpc_batch_t * batch,
+                                        uint32_t p0, uint32_t p1, uint32_t p2, uint32_t p3,
+                                        const TRPCGateway * gateway)
+{
+    uvisor_rpc_result_t result;
+
+    if (batch->count >= UVISOR_RPC_BATCH_MAX) {
+        return -1;
+    }
+
+    result = rpc_fncall_async(p0, p1, p2, p3, gateway);
+    if (uvisor_result_counter(result) == (uvisor_rpc_result_t) UVISOR_RESULT_INVALID_COUNTER) {
+        return -1;
+    }
+
+    batch->results[batch->count] = result;
+    batch->rets[batch->count] = 0;
+    return (int) batch->count++;
+}
+
+/** Wait for every call of a batch to finish.
+ *
+ * Collects the return value of each call into the batch. The timeout applies
+ * per outstanding call, not to the batch as a whole, so a batch whose
+ * messages are serviced in one activation of the target box completes after
+ * roughly one timeout window even in the worst case.
+ *
+ * @param batch      the batch to wait on
+ * @param timeout_ms how long to wait (in ms) for each outstanding result
+ * @return           0 when every call completed, or the negated number of
+ *                   calls that failed or timed out (their return values in
+ *                   the batch are undefined)
+ */
+static inline int uvisor_rpc_batch_wait(uvisor_rpc_batch_t * batch, uint32_t timeout_ms)
+{
+    int failed = 0;
+    size_t i;
+
+    for (i = 0; i < batch->count; i++) {
+        if (rpc_fncall_wait(batch->results[i], timeout_ms, &batch->rets[i])) {
+            failed++;
+        }
+    }
+
+    return -failed;
+}
+
+/** Get the return value of one completed call of a batch.
+ *
+ * Only valid after uvisor_rpc_batch_wait() reported the call as completed.
+ *
+ * @param batch  the batch the call was made in
+ * @param index  the index returned by uvisor_rpc_batch_call
+ */
+static inline uint32_t uvisor_rpc_batch_ret(const uvisor_rpc_batch_t * batch, int index)
+{
+    return batch->rets[index];
+}
+
+#endif /* __UVISOR_API_RPC_BATCH_H__ */
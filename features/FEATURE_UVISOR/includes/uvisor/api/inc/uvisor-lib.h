@@ -33,6 +33,7 @@
 #include "api/inc/interrupts.h"
 #include "api/inc/register_gateway.h"
 #include "api/inc/rpc.h"
+#include "api/inc/rpc_batch.h"
 #include "api/inc/ipc.h"
 #include "api/inc/rpc_gateway.h"
 #include "api/inc/secure_access.h"
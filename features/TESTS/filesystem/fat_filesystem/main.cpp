@@ -146,6 +146,57 @@ void test_read_dir() {
 }
 
 
+// Simple test for long file names
+void test_long_filename() {
+    FATFileSystem fs("fat");
+
+    int err = fs.mount(&bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Create a file whose name needs LFN entries
+    char data[] = "long file name test data";
+    File file;
+    err = file.open(&fs, "not_an_eight_dot_three_name.txt", O_WRONLY | O_CREAT);
+    TEST_ASSERT_EQUAL(0, err);
+    ssize_t size = file.write(data, sizeof(data));
+    TEST_ASSERT_EQUAL(sizeof(data), size);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Long names match case-insensitively
+    err = file.open(&fs, "NOT_AN_EIGHT_DOT_THREE_NAME.TXT", O_RDONLY);
+    TEST_ASSERT_EQUAL(0, err);
+    size = file.read(data, sizeof(data));
+    TEST_ASSERT_EQUAL(sizeof(data), size);
+    TEST_ASSERT_EQUAL_STRING("long file name test data", data);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Directory iteration returns the name with its stored case
+    Dir dir;
+    err = dir.open(&fs, "/");
+    TEST_ASSERT_EQUAL(0, err);
+
+    struct dirent *de;
+    bool long_name_found = false;
+
+    while ((de = readdir(&dir))) {
+        if (strcmp(de->d_name, "not_an_eight_dot_three_name.txt") == 0) {
+            long_name_found = true;
+            TEST_ASSERT_EQUAL(DT_REG, de->d_type);
+        }
+    }
+
+    TEST_ASSERT_MESSAGE(long_name_found, "Could not find \"not_an_eight_dot_three_name.txt\"");
+
+    err = dir.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases) {
     GREENTEA_SETUP(10, "default_auto");
@@ -157,6 +208,7 @@ Case cases[] = {
     Case("Testing read write < block", test_read_write<BLOCK_SIZE/2>),
     Case("Testing read write > block", test_read_write<2*BLOCK_SIZE>),
     Case("Testing dir iteration", test_read_dir),
+    Case("Testing long file names", test_long_filename),
 };
 
 Specification specification(test_setup, cases);
@@ -0,0 +1,205 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#include "HeapBlockDevice.h"
+#include "FATFileSystem.h"
+#include <stdlib.h>
+#include "mbed_retarget.h"
+
+using namespace utest::v1;
+
+#ifndef MBED_EXTENDED_TESTS
+    #error [NOT_SUPPORTED] Filesystem tests not supported by default
+#endif
+
+// Test block device
+#define BLOCK_SIZE 512
+HeapBlockDevice bd(256*BLOCK_SIZE, BLOCK_SIZE);
+
+// Size of the preallocated extent, several clusters worth
+#define ALLOC_SIZE (16*1024)
+
+
+// Test formatting
+void test_format() {
+    int err = FATFileSystem::format(&bd);
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+
+// Preallocate a file and stream data into the reserved extent
+void test_allocate_stream() {
+    FATFileSystem fs("fat");
+
+    int err = fs.mount(&bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    uint8_t *buffer = (uint8_t *)malloc(ALLOC_SIZE);
+    TEST_ASSERT(buffer);
+
+    // Fill with random sequence
+    srand(1);
+    for (int i = 0; i < ALLOC_SIZE; i++) {
+        buffer[i] = 0xff & rand();
+    }
+
+    File file;
+    err = file.open(&fs, "prealloc.dat", O_WRONLY | O_CREAT);
+    TEST_ASSERT_EQUAL(0, err);
+    err = file.allocate(ALLOC_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(ALLOC_SIZE, file.size());
+
+    // Stream into the reserved space from the start of the file
+    off_t off = file.seek(0, SEEK_SET);
+    TEST_ASSERT_EQUAL(0, off);
+    ssize_t size = file.write(buffer, ALLOC_SIZE);
+    TEST_ASSERT_EQUAL(ALLOC_SIZE, size);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Check that the data survives a reopen
+    err = file.open(&fs, "prealloc.dat", O_RDONLY);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(ALLOC_SIZE, file.size());
+    size = file.read(buffer, ALLOC_SIZE);
+    TEST_ASSERT_EQUAL(ALLOC_SIZE, size);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    srand(1);
+    for (int i = 0; i < ALLOC_SIZE; i++) {
+        TEST_ASSERT_EQUAL(0xff & rand(), buffer[i]);
+    }
+
+    free(buffer);
+
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+
+// Seek deep into a preallocated file without writing the space in between
+void test_allocate_seek() {
+    FATFileSystem fs("fat");
+
+    int err = fs.mount(&bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    File file;
+    err = file.open(&fs, "sparse.dat", O_WRONLY | O_CREAT);
+    TEST_ASSERT_EQUAL(0, err);
+    err = file.allocate(ALLOC_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Write a marker into the last byte of the extent
+    uint8_t marker = 0xa5;
+    off_t off = file.seek(ALLOC_SIZE-1, SEEK_SET);
+    TEST_ASSERT_EQUAL(ALLOC_SIZE-1, off);
+    ssize_t size = file.write(&marker, 1);
+    TEST_ASSERT_EQUAL(1, size);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // The size and the marker must survive a reopen
+    err = file.open(&fs, "sparse.dat", O_RDONLY);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(ALLOC_SIZE, file.size());
+    marker = 0;
+    off = file.seek(ALLOC_SIZE-1, SEEK_SET);
+    TEST_ASSERT_EQUAL(ALLOC_SIZE-1, off);
+    size = file.read(&marker, 1);
+    TEST_ASSERT_EQUAL(1, size);
+    TEST_ASSERT_EQUAL(0xa5, marker);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+
+// Refused preallocations must leave the file unharmed
+void test_allocate_errors() {
+    FATFileSystem fs("fat");
+
+    int err = fs.mount(&bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Preallocating a file that already has content is refused
+    File file;
+    err = file.open(&fs, "prealloc.dat", O_WRONLY);
+    TEST_ASSERT_EQUAL(0, err);
+    err = file.allocate(BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(-EINVAL, err);
+    TEST_ASSERT_EQUAL(ALLOC_SIZE, file.size());
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // As is preallocating through a read-only handle
+    err = file.open(&fs, "prealloc.dat", O_RDONLY);
+    TEST_ASSERT_EQUAL(0, err);
+    err = file.allocate(BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(-EINVAL, err);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // A request larger than the volume fails with the file intact
+    err = file.open(&fs, "toobig.dat", O_WRONLY | O_CREAT);
+    TEST_ASSERT_EQUAL(0, err);
+    err = file.allocate(64*1024*1024);
+    TEST_ASSERT_EQUAL(-ENOSPC, err);
+    TEST_ASSERT_EQUAL(0, file.size());
+    err = file.allocate(0);
+    TEST_ASSERT_EQUAL(-EINVAL, err);
+
+    // The handle is still usable for ordinary writes afterwards
+    uint8_t marker = 0x5a;
+    ssize_t size = file.write(&marker, 1);
+    TEST_ASSERT_EQUAL(1, size);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = fs.remove("toobig.dat");
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Testing formating", test_format),
+    Case("Testing preallocated streaming", test_allocate_stream),
+    Case("Testing seek within preallocation", test_allocate_seek),
+    Case("Testing refused preallocations", test_allocate_errors),
+};
+
+Specification specification(test_setup, cases);
+
+int main() {
+    return !Harness::run(specification);
+}
@@ -0,0 +1,283 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#include "HeapBlockDevice.h"
+#include "WearLevelingBlockDevice.h"
+#include <stdlib.h>
+
+using namespace utest::v1;
+
+#define TEST_UNIT_SIZE 512
+#define TEST_UNIT_COUNT 16
+#define TEST_PROGRAM_SIZE 16
+#define TEST_SPARE_UNITS 2
+#define TEST_WEAR_THRESHOLD 4
+
+/* Mirrors the on-flash layout: two 16-byte slots at the start of each
+ * unit, so the header is 32 bytes and the payload 480 */
+#define TEST_HDR_SIZE (2*TEST_PROGRAM_SIZE)
+#define TEST_PAYLOAD_SIZE (TEST_UNIT_SIZE - TEST_HDR_SIZE)
+#define TEST_MAGIC 0x314c574d
+#define TEST_NONE 0xffffffff
+
+/* Slot 1 of a unit header: {magic, logical, seq, pad} */
+static void read_claim(BlockDevice *bd, bd_size_t phys,
+                       uint32_t *logical, uint32_t *seq)
+{
+    uint32_t slot[4];
+    int err = bd->read(slot, phys*TEST_UNIT_SIZE + TEST_PROGRAM_SIZE, sizeof(slot));
+    TEST_ASSERT_EQUAL(0, err);
+    if (slot[0] == TEST_MAGIC) {
+        *logical = slot[1];
+        *seq = slot[2];
+    } else {
+        *logical = TEST_NONE;
+        *seq = 0;
+    }
+}
+
+static void fill_block(uint8_t *block, unsigned seed)
+{
+    srand(seed);
+    for (bd_size_t i = 0; i < TEST_PAYLOAD_SIZE; i++) {
+        block[i] = 0xff & rand();
+    }
+}
+
+static void check_block(WearLevelingBlockDevice *wl, bd_size_t logical, unsigned seed)
+{
+    uint8_t *block = new uint8_t[TEST_PAYLOAD_SIZE];
+    int err = wl->read(block, logical*TEST_PAYLOAD_SIZE, TEST_PAYLOAD_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+
+    srand(seed);
+    for (bd_size_t i = 0; i < TEST_PAYLOAD_SIZE; i++) {
+        TEST_ASSERT_EQUAL(0xff & rand(), block[i]);
+    }
+    delete[] block;
+}
+
+static void write_block(WearLevelingBlockDevice *wl, bd_size_t logical, unsigned seed)
+{
+    uint8_t *block = new uint8_t[TEST_PAYLOAD_SIZE];
+    fill_block(block, seed);
+    int err = wl->program(block, logical*TEST_PAYLOAD_SIZE, TEST_PAYLOAD_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    delete[] block;
+}
+
+
+// Writes and rewrites every logical unit, forcing copy-on-write relocation
+void test_read_write_relocation() {
+    HeapBlockDevice bd(TEST_UNIT_COUNT*TEST_UNIT_SIZE,
+            1, TEST_PROGRAM_SIZE, TEST_UNIT_SIZE);
+    WearLevelingBlockDevice wl(&bd, TEST_SPARE_UNITS, TEST_WEAR_THRESHOLD);
+
+    int err = wl.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    bd_size_t logical_units = (TEST_UNIT_COUNT - TEST_SPARE_UNITS);
+    TEST_ASSERT_EQUAL(logical_units*TEST_PAYLOAD_SIZE, wl.size());
+    TEST_ASSERT_EQUAL(TEST_PROGRAM_SIZE, wl.get_erase_size());
+
+    // First pass lands in fresh units
+    for (bd_size_t l = 0; l < logical_units; l++) {
+        write_block(&wl, l, 1000 + l);
+    }
+    for (bd_size_t l = 0; l < logical_units; l++) {
+        check_block(&wl, l, 1000 + l);
+    }
+
+    // Rewriting programmed blocks relocates without a prior erase, and
+    // must not disturb the neighbours
+    for (int pass = 0; pass < 4; pass++) {
+        write_block(&wl, 0, 2000 + pass);
+        check_block(&wl, 0, 2000 + pass);
+        for (bd_size_t l = 1; l < logical_units; l++) {
+            check_block(&wl, l, 1000 + l);
+        }
+    }
+
+    err = wl.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+// Simulated power loss mid-relocation: two units claim the same logical
+// index and init must resolve the conflict by sequence number
+void test_power_loss_recovery() {
+    HeapBlockDevice bd(TEST_UNIT_COUNT*TEST_UNIT_SIZE,
+            1, TEST_PROGRAM_SIZE, TEST_UNIT_SIZE);
+
+    uint32_t old_phys = TEST_NONE;
+    uint32_t old_seq = 0;
+
+    {
+        WearLevelingBlockDevice wl(&bd, TEST_SPARE_UNITS, TEST_WEAR_THRESHOLD);
+        TEST_ASSERT_EQUAL(0, wl.init());
+        write_block(&wl, 0, 42);
+        TEST_ASSERT_EQUAL(0, wl.deinit());
+    }
+
+    // Find the unit holding logical 0 and a spare (no slot 1 claim)
+    bd.init();
+    uint32_t spare_phys = TEST_NONE;
+    for (bd_size_t p = 0; p < TEST_UNIT_COUNT; p++) {
+        uint32_t logical, seq;
+        read_claim(&bd, p, &logical, &seq);
+        if (logical == 0) {
+            old_phys = p;
+            old_seq = seq;
+        } else if (logical == TEST_NONE && spare_phys == TEST_NONE) {
+            spare_phys = p;
+        }
+    }
+    TEST_ASSERT(old_phys != TEST_NONE);
+    TEST_ASSERT(spare_phys != TEST_NONE);
+
+    // Forge the state an interrupted relocation leaves behind: the spare
+    // carries the new payload and a newer claim on logical 0, while the
+    // old unit was never reclaimed
+    uint8_t *block = new uint8_t[TEST_PAYLOAD_SIZE];
+    fill_block(block, 43);
+    TEST_ASSERT_EQUAL(0, bd.program(block,
+            spare_phys*TEST_UNIT_SIZE + TEST_HDR_SIZE, TEST_PAYLOAD_SIZE));
+    uint32_t slot[4] = {TEST_MAGIC, 0, old_seq + 1, TEST_NONE};
+    TEST_ASSERT_EQUAL(0, bd.program(slot,
+            spare_phys*TEST_UNIT_SIZE + TEST_PROGRAM_SIZE, TEST_PROGRAM_SIZE));
+    delete[] block;
+
+    {
+        // The higher sequence number wins: logical 0 now reads the new
+        // payload, and the stale unit is erased back into the spare pool
+        // (visible as one more erase than the winner's single format)
+        WearLevelingBlockDevice wl(&bd, TEST_SPARE_UNITS, TEST_WEAR_THRESHOLD);
+        TEST_ASSERT_EQUAL(0, wl.init());
+        check_block(&wl, 0, 43);
+        TEST_ASSERT_EQUAL(2, wl.get_erase_count(old_phys));
+        TEST_ASSERT_EQUAL(1, wl.get_erase_count(spare_phys));
+        TEST_ASSERT_EQUAL(0, wl.deinit());
+    }
+
+    // A conflicting claim with a lower sequence number loses: the mapping
+    // is unchanged and the forged unit is reclaimed instead
+    {
+        WearLevelingBlockDevice wl(&bd, TEST_SPARE_UNITS, TEST_WEAR_THRESHOLD);
+        TEST_ASSERT_EQUAL(0, wl.init());
+        write_block(&wl, 1, 44);
+        TEST_ASSERT_EQUAL(0, wl.deinit());
+    }
+
+    uint32_t cur_phys = TEST_NONE;
+    uint32_t cur_seq = 0;
+    spare_phys = TEST_NONE;
+    for (bd_size_t p = 0; p < TEST_UNIT_COUNT; p++) {
+        uint32_t logical, seq;
+        read_claim(&bd, p, &logical, &seq);
+        if (logical == 1) {
+            cur_phys = p;
+            cur_seq = seq;
+        } else if (logical == TEST_NONE && spare_phys == TEST_NONE) {
+            spare_phys = p;
+        }
+    }
+    TEST_ASSERT(cur_phys != TEST_NONE);
+    TEST_ASSERT(cur_seq > 0);
+    TEST_ASSERT(spare_phys != TEST_NONE);
+
+    uint32_t loser[4] = {TEST_MAGIC, 1, cur_seq - 1, TEST_NONE};
+    TEST_ASSERT_EQUAL(0, bd.program(loser,
+            spare_phys*TEST_UNIT_SIZE + TEST_PROGRAM_SIZE, TEST_PROGRAM_SIZE));
+
+    {
+        // Both logical units keep their data, and the forged loser is
+        // erased back into the spare pool
+        WearLevelingBlockDevice wl(&bd, TEST_SPARE_UNITS, TEST_WEAR_THRESHOLD);
+        TEST_ASSERT_EQUAL(0, wl.init());
+        check_block(&wl, 0, 43);
+        check_block(&wl, 1, 44);
+        TEST_ASSERT_EQUAL(1, wl.get_erase_count(cur_phys));
+        TEST_ASSERT_EQUAL(2, wl.get_erase_count(spare_phys));
+        TEST_ASSERT_EQUAL(0, wl.deinit());
+    }
+}
+
+// Hammering one logical unit must rotate cold units into service so no
+// single unit takes all the erases
+void test_static_wear_rotation() {
+    HeapBlockDevice bd(TEST_UNIT_COUNT*TEST_UNIT_SIZE,
+            1, TEST_PROGRAM_SIZE, TEST_UNIT_SIZE);
+    WearLevelingBlockDevice wl(&bd, TEST_SPARE_UNITS, TEST_WEAR_THRESHOLD);
+
+    TEST_ASSERT_EQUAL(0, wl.init());
+
+    bd_size_t logical_units = (TEST_UNIT_COUNT - TEST_SPARE_UNITS);
+    for (bd_size_t l = 0; l < logical_units; l++) {
+        write_block(&wl, l, 3000 + l);
+    }
+
+    // 200 rewrites of one logical unit; cold data must follow the
+    // rotation unharmed
+    for (int pass = 0; pass < 200; pass++) {
+        write_block(&wl, 0, 4000 + pass);
+    }
+    check_block(&wl, 0, 4000 + 199);
+    for (bd_size_t l = 1; l < logical_units; l++) {
+        check_block(&wl, l, 3000 + l);
+    }
+
+    // The spread between the most and least worn unit stays bounded by
+    // the rotation threshold (plus the in-flight relocation)
+    uint32_t max_wear = 0;
+    uint32_t min_wear = 0xffffffff;
+    for (bd_size_t p = 0; p < wl.get_unit_count(); p++) {
+        uint32_t wear = wl.get_erase_count(p);
+        if (wear > max_wear) {
+            max_wear = wear;
+        }
+        if (wear < min_wear) {
+            min_wear = wear;
+        }
+    }
+    printf("erase counts: min %lu max %lu\n",
+            (unsigned long)min_wear, (unsigned long)max_wear);
+    TEST_ASSERT(max_wear >= 10);
+    TEST_ASSERT(max_wear - min_wear <= TEST_WEAR_THRESHOLD + 2);
+
+    TEST_ASSERT_EQUAL(0, wl.deinit());
+}
+
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(60, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Testing read write with relocation", test_read_write_relocation),
+    Case("Testing recovery from interrupted relocation", test_power_loss_recovery),
+    Case("Testing static wear rotation", test_static_wear_rotation),
+};
+
+Specification specification(test_setup, cases);
+
+int main() {
+    return !Harness::run(specification);
+}
@@ -69,6 +69,16 @@ ssize_t Dir::read(struct dirent *ent)
     return _fs->dir_read(_dir, ent);
 }
 
+ssize_t Dir::read(struct dirent *ents, struct stat *sts, size_t count)
+{
+    MBED_ASSERT(_fs);
+    memset(ents, 0, count * sizeof(struct dirent));
+    if (sts) {
+        memset(sts, 0, count * sizeof(struct stat));
+    }
+    return _fs->dir_read(_dir, ents, sts, count);
+}
+
 void Dir::seek(off_t offset)
 {
     MBED_ASSERT(_fs);
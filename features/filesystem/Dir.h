@@ -69,6 +69,23 @@ public:
      */
     virtual ssize_t read(struct dirent *ent);
 
+    /** Read a batch of directory entries with their stat info
+     *
+     *  Reads up to count entries in one call. The stat info is filled
+     *  from the directory entries themselves, so listing a directory does
+     *  not re-walk the path from the root for every file as a read and
+     *  stat loop would. Fails with -ENOSYS on filesystems without
+     *  batching support; callers should fall back to read and stat.
+     *
+     *  @param ents     Array of count directory entries to fill out
+     *  @param sts      Array of count stat structures to fill out, may be
+     *                  NULL if the stat info is not needed
+     *  @param count    Number of entries to read
+     *  @return         Number of entries read, 0 at end of directory,
+     *                  negative error on failure
+     */
+    ssize_t read(struct dirent *ents, struct stat *sts, size_t count);
+
     /** Set the current position of the directory
      *
      *  @param offset   Offset of the location to seek to,
@@ -110,3 +110,21 @@ off_t File::size()
     return _fs->file_size(_file);
 }
 
+int File::mmap(const void **addr, off_t offset, size_t size)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_mmap(_file, offset, size, addr);
+}
+
+int File::allocate(off_t size)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_allocate(_file, size);
+}
+
+int File::seekmap(uint32_t *table, size_t count)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_seekmap(_file, table, count);
+}
+
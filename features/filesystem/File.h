@@ -126,6 +126,61 @@ public:
      */
     virtual off_t size();
 
+    /** Map a region of the file for zero-copy reading
+     *
+     *  When the file's extent is contiguous on the underlying block device
+     *  and the device is directly addressable, such as memory-mapped QSPI
+     *  flash, returns a pointer through which the file contents can be
+     *  read in place without copying. The pointer stays valid until the
+     *  file is closed. The file must be open read-only and the region must
+     *  lie within the file. Fails with -ENOSYS on filesystems without
+     *  mapping support and -ENODEV when the extent is fragmented or the
+     *  device is not directly addressable; callers should fall back to
+     *  read() on failure.
+     *
+     *  @param addr     Destination for the address of the mapped region
+     *  @param offset   Offset in the file of the region to map
+     *  @param size     Size of the region to map in bytes
+     *  @return         0 on success, negative error code on failure
+     */
+    int mmap(const void **addr, off_t offset, size_t size);
+
+    /** Preallocate space for the file as one contiguous extent
+     *
+     *  Reserves size bytes of consecutive storage up front and attaches
+     *  them to the file, so subsequent streaming writes land on
+     *  sequential sectors with no allocator activity. The file must be
+     *  open for writing and still empty, and the filesystem must have a
+     *  contiguous free run of the requested size; fails with -ENOSPC
+     *  otherwise and with -ENOSYS on filesystems without preallocation
+     *  support. On success the file's size is the preallocated size and
+     *  the content of bytes not yet written is undefined.
+     *
+     *  @param size     Number of bytes to preallocate
+     *  @return         0 on success, negative error code on failure
+     */
+    int allocate(off_t size);
+
+    /** Attach a cluster map table for fast random seeks within the file
+     *
+     *  Walks the file's extents once and records them in the caller's
+     *  table; after that, seeks resolve through the table in O(log n)
+     *  instead of walking the filesystem's allocation structures from
+     *  the start of the file, which matters for random access into
+     *  large files on slow block devices. The file must be open
+     *  read-only. The table must stay valid until the file is closed or
+     *  the map is detached by passing a NULL table; the required table
+     *  size grows with the file's fragmentation, and -ENOMEM is
+     *  returned when the table is too small, with the needed entry
+     *  count left in table[0]. Fails with -ENOSYS on filesystems
+     *  without seek map support.
+     *
+     *  @param table    Table for the map, or NULL to detach the map
+     *  @param count    Number of uint32_t entries in the table
+     *  @return         0 on success, negative error code on failure
+     */
+    int seekmap(uint32_t *table, size_t count);
+
 private:
     FileSystem *_fs;
     fs_file_t _file;
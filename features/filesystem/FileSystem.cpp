@@ -79,6 +79,21 @@ off_t FileSystem::file_size(fs_file_t file)
     return size;
 }
 
+int FileSystem::file_mmap(fs_file_t file, off_t offset, size_t size, const void **addr)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_allocate(fs_file_t file, off_t size)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_seekmap(fs_file_t file, uint32_t *table, size_t count)
+{
+    return -ENOSYS;
+}
+
 int FileSystem::dir_open(fs_dir_t *dir, const char *path)
 {
     return -ENOSYS;
@@ -94,6 +109,11 @@ ssize_t FileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
     return -ENOSYS;
 }
 
+ssize_t FileSystem::dir_read(fs_dir_t dir, struct dirent *ents, struct stat *sts, size_t count)
+{
+    return -ENOSYS;
+}
+
 void FileSystem::dir_seek(fs_dir_t dir, off_t offset)
 {
 }
@@ -196,6 +196,53 @@ protected:
      */
     virtual off_t file_size(fs_file_t file);
 
+    /** Map a region of the file for zero-copy reading
+     *
+     *  When the file's extent is contiguous on the underlying block device
+     *  and the device is directly addressable, such as memory-mapped QSPI
+     *  flash, returns a pointer through which the file contents can be
+     *  read without copying. The pointer stays valid until the file is
+     *  closed or written to. Returns -ENOSYS on filesystems without
+     *  mapping support.
+     *
+     *  @param file     File handle, must be open for reading only
+     *  @param offset   Offset in the file of the region to map
+     *  @param size     Size of the region to map in bytes
+     *  @param addr     Destination for the address of the mapped region
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_mmap(fs_file_t file, off_t offset, size_t size, const void **addr);
+
+    /** Preallocate space for the file as one contiguous extent
+     *
+     *  Reserves size bytes of consecutive storage and attaches them to
+     *  the file, so subsequent streaming writes land on sequential
+     *  sectors without allocator walks. Fails when no contiguous run of
+     *  that size is free. Returns -ENOSYS on filesystems without
+     *  preallocation support.
+     *
+     *  @param file     File handle, must be open for writing and empty
+     *  @param size     Number of bytes to preallocate
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_allocate(fs_file_t file, off_t size);
+
+    /** Attach a cluster map table for fast random seeks within the file
+     *
+     *  Walks the file's extents once and records them in the caller's
+     *  table, after which seeks resolve through the table instead of
+     *  walking the filesystem's allocation structures from the start of
+     *  the file. The table must stay valid until the file is closed or
+     *  the map is detached by passing a NULL table. Returns -ENOSYS on
+     *  filesystems without seek map support.
+     *
+     *  @param file     File handle, must be open for reading only
+     *  @param table    Table for the map, or NULL to detach the map
+     *  @param count    Number of uint32_t entries in the table
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_seekmap(fs_file_t file, uint32_t *table, size_t count);
+
     /** Open a directory on the filesystem
      *
      *  @param dir      Destination for the handle to the directory
@@ -219,6 +266,24 @@ protected:
      */
     virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ent);
 
+    /** Read a batch of directory entries with their stat info
+     *
+     *  Reads up to count entries in one call, keeping the directory open
+     *  across the batch so the filesystem can fill the stat info from the
+     *  directory entries themselves instead of re-walking the path from
+     *  the root for every file. Filesystems without batching support
+     *  return -ENOSYS, callers should fall back to dir_read and stat.
+     *
+     *  @param dir      Dir handle
+     *  @param ents     Array of count directory entries to fill out
+     *  @param sts      Array of count stat structures to fill out, may be
+     *                  NULL if the stat info is not needed
+     *  @param count    Number of entries to read
+     *  @return         Number of entries read, 0 at end of directory,
+     *                  negative error on failure
+     */
+    virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ents, struct stat *sts, size_t count);
+
     /** Set the current position of the directory
      *
      *  @param dir      Dir handle
@@ -0,0 +1,236 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncBlockDevice.h"
+
+/* Completion bridge for the synchronous wrappers: queue the operation
+ * behind any pending asynchronous work and block until it reports back */
+struct async_bd_sync_op {
+    rtos::Semaphore sem;
+    int err;
+
+    async_bd_sync_op() : sem(0), err(0) {}
+
+    void done(int result)
+    {
+        err = result;
+        sem.release();
+    }
+};
+
+
+AsyncBlockDevice::AsyncBlockDevice(BlockDevice *bd,
+                                   osPriority priority, uint32_t stack_size)
+    : _bd(bd)
+    , _queue()
+    , _thread(priority, stack_size)
+    , _running(false)
+{
+}
+
+AsyncBlockDevice::~AsyncBlockDevice()
+{
+    deinit();
+}
+
+int AsyncBlockDevice::init()
+{
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    if (!_running) {
+        if (_thread.start(mbed::callback(&_queue,
+                &events::EventQueue::dispatch_forever)) != osOK) {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+        _running = true;
+    }
+
+    return 0;
+}
+
+int AsyncBlockDevice::deinit()
+{
+    if (_running) {
+        sync();
+        _queue.break_dispatch();
+        _thread.join();
+        _running = false;
+    }
+
+    return _bd->deinit();
+}
+
+int AsyncBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    if (!_running) {
+        return _bd->read(buffer, addr, size);
+    }
+
+    async_bd_sync_op op;
+    int err = read_async(buffer, addr, size,
+                         mbed::callback(&op, &async_bd_sync_op::done));
+    if (err) {
+        return err;
+    }
+
+    op.sem.wait();
+    return op.err;
+}
+
+int AsyncBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    if (!_running) {
+        return _bd->program(buffer, addr, size);
+    }
+
+    async_bd_sync_op op;
+    int err = program_async(buffer, addr, size,
+                            mbed::callback(&op, &async_bd_sync_op::done));
+    if (err) {
+        return err;
+    }
+
+    op.sem.wait();
+    return op.err;
+}
+
+int AsyncBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    if (!_running) {
+        return _bd->erase(addr, size);
+    }
+
+    async_bd_sync_op op;
+    int err = erase_async(addr, size,
+                          mbed::callback(&op, &async_bd_sync_op::done));
+    if (err) {
+        return err;
+    }
+
+    op.sem.wait();
+    return op.err;
+}
+
+int AsyncBlockDevice::read_async(void *buffer, bd_addr_t addr, bd_size_t size,
+                                 mbed::Callback<void(int)> done)
+{
+    if (!_running) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!_queue.call(this, &AsyncBlockDevice::_do_read,
+                     buffer, addr, size, done)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return 0;
+}
+
+int AsyncBlockDevice::program_async(const void *buffer, bd_addr_t addr,
+                                    bd_size_t size,
+                                    mbed::Callback<void(int)> done)
+{
+    if (!_running) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!_queue.call(this, &AsyncBlockDevice::_do_program,
+                     buffer, addr, size, done)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return 0;
+}
+
+int AsyncBlockDevice::erase_async(bd_addr_t addr, bd_size_t size,
+                                  mbed::Callback<void(int)> done)
+{
+    if (!_running) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!_queue.call(this, &AsyncBlockDevice::_do_erase, addr, size, done)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return 0;
+}
+
+int AsyncBlockDevice::sync()
+{
+    if (!_running) {
+        return 0;
+    }
+
+    async_bd_sync_op op;
+    if (!_queue.call(&op, &async_bd_sync_op::done, 0)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    op.sem.wait();
+    return op.err;
+}
+
+void AsyncBlockDevice::_do_read(void *buffer, bd_addr_t addr, bd_size_t size,
+                                mbed::Callback<void(int)> done)
+{
+    int err = _bd->read(buffer, addr, size);
+    if (done) {
+        done(err);
+    }
+}
+
+void AsyncBlockDevice::_do_program(const void *buffer, bd_addr_t addr,
+                                   bd_size_t size,
+                                   mbed::Callback<void(int)> done)
+{
+    int err = _bd->program(buffer, addr, size);
+    if (done) {
+        done(err);
+    }
+}
+
+void AsyncBlockDevice::_do_erase(bd_addr_t addr, bd_size_t size,
+                                 mbed::Callback<void(int)> done)
+{
+    int err = _bd->erase(addr, size);
+    if (done) {
+        done(err);
+    }
+}
+
+bd_size_t AsyncBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t AsyncBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t AsyncBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t AsyncBlockDevice::size() const
+{
+    return _bd->size();
+}
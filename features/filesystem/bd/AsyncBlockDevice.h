@@ -0,0 +1,216 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_ASYNC_BLOCK_DEVICE_H
+#define MBED_ASYNC_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+#include "mbed.h"
+
+
+/** Block device for running storage operations of another block device
+ *  in the background
+ *
+ *  Operations submitted through the _async methods are queued to a
+ *  worker thread and report completion through a Callback, so a slow
+ *  erase or program (tens of ms on SPI flash) no longer stalls the
+ *  calling thread. The synchronous BlockDevice interface remains
+ *  available and is queued behind any pending asynchronous work, so
+ *  both can be mixed and operations always execute in submission order.
+ *
+ *  Completion callbacks run in the context of the worker thread.
+ *
+ *  @code
+ *  #include "mbed.h"
+ *  #include "SPIFBlockDevice.h"
+ *  #include "AsyncBlockDevice.h"
+ *
+ *  SPIFBlockDevice spif(PTE2, PTE4, PTE1, PTE5);
+ *  AsyncBlockDevice bd(&spif);
+ *
+ *  void log_done(int err) {
+ *      // previous block is on its way to flash, buffer is free again
+ *  }
+ *
+ *  int main() {
+ *      bd.init();
+ *      bd.program_async(samples, 0, 4096, log_done);
+ *      // keep acquiring samples while the block is programmed
+ *  }
+ *  @endcode
+ */
+class AsyncBlockDevice : public BlockDevice
+{
+public:
+    /** Lifetime of the block device
+     *
+     *  @param bd           Block device to perform the operations on
+     *  @param priority     Priority of the worker thread
+     *  @param stack_size   Stack size of the worker thread
+     */
+    AsyncBlockDevice(BlockDevice *bd,
+                     osPriority priority = osPriorityNormal,
+                     uint32_t stack_size = OS_STACK_SIZE);
+
+    /** Lifetime of a block device
+     */
+    virtual ~AsyncBlockDevice();
+
+    /** Initialize a block device and start the worker thread
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  Waits for pending operations to complete and stops the worker
+     *  thread.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Read blocks from a block device
+     *
+     *  Queued behind any pending asynchronous operations.
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed.
+     *  Queued behind any pending asynchronous operations.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  The state of an erased block is undefined until it has been programmed.
+     *  Queued behind any pending asynchronous operations.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Read blocks from a block device in the background
+     *
+     *  The buffer must stay valid until done is called.
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param done     Called from the worker thread with the result of
+     *                  the read
+     *  @return         0 if the operation was queued,
+     *                  negative error code on failure
+     */
+    int read_async(void *buffer, bd_addr_t addr, bd_size_t size,
+                   mbed::Callback<void(int)> done);
+
+    /** Program blocks to a block device in the background
+     *
+     *  The blocks must have been erased prior to being programmed. The
+     *  buffer must stay valid until done is called.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param done     Called from the worker thread with the result of
+     *                  the program
+     *  @return         0 if the operation was queued,
+     *                  negative error code on failure
+     */
+    int program_async(const void *buffer, bd_addr_t addr, bd_size_t size,
+                      mbed::Callback<void(int)> done);
+
+    /** Erase blocks on a block device in the background
+     *
+     *  The state of an erased block is undefined until it has been programmed.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param done     Called from the worker thread with the result of
+     *                  the erase
+     *  @return         0 if the operation was queued,
+     *                  negative error code on failure
+     */
+    int erase_async(bd_addr_t addr, bd_size_t size,
+                    mbed::Callback<void(int)> done);
+
+    /** Wait for all queued operations to complete
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    int sync();
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programable block
+     *
+     *  @return         Size of a programable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of a eraseable block
+     *
+     *  @return         Size of a eraseable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+private:
+    void _do_read(void *buffer, bd_addr_t addr, bd_size_t size,
+                  mbed::Callback<void(int)> done);
+    void _do_program(const void *buffer, bd_addr_t addr, bd_size_t size,
+                     mbed::Callback<void(int)> done);
+    void _do_erase(bd_addr_t addr, bd_size_t size,
+                   mbed::Callback<void(int)> done);
+
+    BlockDevice *_bd;
+    events::EventQueue _queue;
+    rtos::Thread _thread;
+    bool _running;
+};
+
+
+#endif
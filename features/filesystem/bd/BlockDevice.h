@@ -18,6 +18,7 @@
 #define MBED_BLOCK_DEVICE_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 
 /** Enum of standard error codes
@@ -112,6 +113,24 @@ public:
         return 0;
     }
 
+    /** Get a pointer for directly reading a region of the block device
+     *
+     *  Memory-mapped devices, such as XIP-capable QSPI flash, can return a
+     *  pointer through which the region is readable without an intermediate
+     *  copy. The pointer stays valid until the device is deinitialized or
+     *  the region is programmed or erased. Devices that are not directly
+     *  addressable return NULL, which is the default.
+     *
+     *  @param addr     Address of the region to map
+     *  @param size     Size of the region to map in bytes
+     *  @return         Pointer to the region, NULL if the region is not
+     *                  directly addressable
+     */
+    virtual const void *map(bd_addr_t addr, bd_size_t size)
+    {
+        return NULL;
+    }
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
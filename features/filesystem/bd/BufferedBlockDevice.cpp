@@ -0,0 +1,268 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BufferedBlockDevice.h"
+#include <string.h>
+
+
+BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd,
+                                         bd_size_t line_size, bd_size_t line_count)
+    : _bd(bd)
+    , _line_size(line_size)
+    , _line_count(line_count)
+    , _lines(0)
+    , _data(0)
+    , _use_counter(0)
+{
+}
+
+BufferedBlockDevice::~BufferedBlockDevice()
+{
+    deinit();
+}
+
+int BufferedBlockDevice::init()
+{
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    // Lines must pack whole read/program blocks and never straddle an
+    // erase block, so an erase always covers cached lines completely
+    if (_line_size % _bd->get_read_size() != 0 ||
+        _line_size % _bd->get_program_size() != 0 ||
+        _bd->get_erase_size() % _line_size != 0) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!_lines) {
+        _lines = new cache_line[_line_count];
+        _data = new uint8_t[_line_size * _line_count];
+        for (bd_size_t i = 0; i < _line_count; i++) {
+            _lines[i].data = _data + i * _line_size;
+            _lines[i].valid = false;
+            _lines[i].dirty = false;
+        }
+    }
+
+    return 0;
+}
+
+int BufferedBlockDevice::deinit()
+{
+    if (_lines) {
+        int err = sync();
+        if (err) {
+            return err;
+        }
+
+        delete[] _lines;
+        delete[] _data;
+        _lines = 0;
+        _data = 0;
+    }
+
+    return _bd->deinit();
+}
+
+BufferedBlockDevice::cache_line *BufferedBlockDevice::find_line(bd_addr_t line_addr)
+{
+    for (bd_size_t i = 0; i < _line_count; i++) {
+        if (_lines[i].valid && _lines[i].addr == line_addr) {
+            return &_lines[i];
+        }
+    }
+
+    return 0;
+}
+
+int BufferedBlockDevice::flush_line(cache_line *line)
+{
+    if (!line->dirty) {
+        return 0;
+    }
+
+    int err = _bd->program(line->data, line->addr, _line_size);
+    if (err) {
+        return err;
+    }
+
+    line->dirty = false;
+    return 0;
+}
+
+BufferedBlockDevice::cache_line *BufferedBlockDevice::alloc_line(
+        bd_addr_t line_addr, bool fill, int *err)
+{
+    // Take an invalid line if there is one, the LRU one otherwise
+    cache_line *victim = &_lines[0];
+    for (bd_size_t i = 0; i < _line_count; i++) {
+        if (!_lines[i].valid) {
+            victim = &_lines[i];
+            break;
+        }
+        if (_lines[i].use < victim->use) {
+            victim = &_lines[i];
+        }
+    }
+
+    *err = flush_line(victim);
+    if (*err) {
+        return 0;
+    }
+
+    if (fill) {
+        *err = _bd->read(victim->data, line_addr, _line_size);
+        if (*err) {
+            victim->valid = false;
+            return 0;
+        }
+    }
+
+    victim->addr = line_addr;
+    victim->valid = true;
+    victim->dirty = false;
+    return victim;
+}
+
+int BufferedBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_read(addr, size));
+    uint8_t *b = static_cast<uint8_t *>(buffer);
+
+    while (size > 0) {
+        bd_addr_t line_addr = addr - (addr % _line_size);
+        bd_size_t off = addr - line_addr;
+        bd_size_t chunk = _line_size - off;
+        if (chunk > size) {
+            chunk = size;
+        }
+
+        cache_line *line = find_line(line_addr);
+        if (line) {
+            memcpy(b, line->data + off, static_cast<size_t>(chunk));
+            line->use = ++_use_counter;
+        } else if (chunk == _line_size) {
+            // Whole-line miss: read through without polluting the cache
+            int err = _bd->read(b, addr, chunk);
+            if (err) {
+                return err;
+            }
+        } else {
+            int err;
+            line = alloc_line(line_addr, true, &err);
+            if (!line) {
+                return err;
+            }
+            memcpy(b, line->data + off, static_cast<size_t>(chunk));
+            line->use = ++_use_counter;
+        }
+
+        b += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+
+    return 0;
+}
+
+int BufferedBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_program(addr, size));
+    const uint8_t *b = static_cast<const uint8_t *>(buffer);
+
+    while (size > 0) {
+        bd_addr_t line_addr = addr - (addr % _line_size);
+        bd_size_t off = addr - line_addr;
+        bd_size_t chunk = _line_size - off;
+        if (chunk > size) {
+            chunk = size;
+        }
+
+        cache_line *line = find_line(line_addr);
+        if (!line) {
+            // A full-line write needs no fill, a partial one does so the
+            // whole line can be written back later
+            int err;
+            line = alloc_line(line_addr, chunk != _line_size, &err);
+            if (!line) {
+                return err;
+            }
+        }
+
+        memcpy(line->data + off, b, static_cast<size_t>(chunk));
+        line->dirty = true;
+        line->use = ++_use_counter;
+
+        b += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+
+    return 0;
+}
+
+int BufferedBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+
+    // Erased content is undefined, so pending writes in the range are
+    // obsolete: drop the lines rather than flushing them
+    for (bd_size_t i = 0; i < _line_count; i++) {
+        if (_lines[i].valid &&
+            _lines[i].addr >= addr && _lines[i].addr < addr + size) {
+            _lines[i].valid = false;
+            _lines[i].dirty = false;
+        }
+    }
+
+    return _bd->erase(addr, size);
+}
+
+int BufferedBlockDevice::sync()
+{
+    for (bd_size_t i = 0; i < _line_count; i++) {
+        if (_lines[i].valid) {
+            int err = flush_line(&_lines[i]);
+            if (err) {
+                return err;
+            }
+        }
+    }
+
+    return 0;
+}
+
+bd_size_t BufferedBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t BufferedBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t BufferedBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t BufferedBlockDevice::size() const
+{
+    return _bd->size();
+}
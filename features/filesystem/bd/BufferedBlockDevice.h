@@ -0,0 +1,173 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_BUFFERED_BLOCK_DEVICE_H
+#define MBED_BUFFERED_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+#include "mbed.h"
+
+
+/** Block device with a write-back cache in front of another block device
+ *
+ *  Keeps a configurable number of cache lines in RAM with LRU eviction.
+ *  Repeated reads of the same blocks - FAT metadata is the classic case -
+ *  are served from RAM instead of the medium, and programs are absorbed
+ *  by the cache and written back on eviction or an explicit sync().
+ *
+ *  Reads and programs covering a whole cache line that is not already
+ *  cached bypass the cache fill, so streaming bulk data does not evict
+ *  the hot metadata lines.
+ *
+ *  Dirty lines live in RAM until written back: call sync() at the points
+ *  where the data must be on the medium. The line size must be a multiple
+ *  of the underlying read and program sizes and divide the erase size.
+ *
+ *  @code
+ *  #include "mbed.h"
+ *  #include "SPIFBlockDevice.h"
+ *  #include "BufferedBlockDevice.h"
+ *  #include "FATFileSystem.h"
+ *
+ *  SPIFBlockDevice spif(PTE2, PTE4, PTE1, PTE5);
+ *  BufferedBlockDevice bd(&spif, 512, 8);
+ *  FATFileSystem fs("fs", &bd);
+ *
+ *  // ... file operations hit the cache instead of the SPI bus ...
+ *  bd.sync();
+ *  @endcode
+ */
+class BufferedBlockDevice : public BlockDevice
+{
+public:
+    /** Lifetime of the memory block device
+     *
+     *  @param bd           Block device to cache
+     *  @param line_size    Size of a cache line in bytes, a multiple of
+     *                      the underlying read and program sizes
+     *  @param line_count   Number of cache lines
+     */
+    BufferedBlockDevice(BlockDevice *bd,
+                        bd_size_t line_size = 512, bd_size_t line_count = 8);
+
+    /** Lifetime of a block device
+     */
+    virtual ~BufferedBlockDevice();
+
+    /** Initialize a block device and allocate the cache
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  Writes back any dirty cache lines and releases the cache.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed. The
+     *  data may stay in the cache until eviction or sync().
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  The state of an erased block is undefined until it has been
+     *  programmed. Cached lines in the erased range are dropped.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Write back all dirty cache lines to the underlying device
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    int sync();
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programable block
+     *
+     *  @return         Size of a programable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of a eraseable block
+     *
+     *  @return         Size of a eraseable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+private:
+    struct cache_line {
+        bd_addr_t addr;
+        uint64_t use;
+        uint8_t *data;
+        bool valid;
+        bool dirty;
+    };
+
+    cache_line *find_line(bd_addr_t line_addr);
+    cache_line *alloc_line(bd_addr_t line_addr, bool fill, int *err);
+    int flush_line(cache_line *line);
+
+    BlockDevice *_bd;
+    bd_size_t _line_size;
+    bd_size_t _line_count;
+    cache_line *_lines;
+    uint8_t *_data;
+    uint64_t _use_counter;
+};
+
+
+#endif
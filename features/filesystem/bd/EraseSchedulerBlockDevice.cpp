@@ -0,0 +1,246 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EraseSchedulerBlockDevice.h"
+#include "events/mbed_shared_queues.h"
+#include <string.h>
+
+/* Per-unit pre-erase state */
+enum {
+    STATE_UNKNOWN = 0,  /* may hold data, erase before programming */
+    STATE_QUEUED  = 1,  /* trimmed, waiting for the background erase */
+    STATE_ERASED  = 2,  /* pre-erased, an erase() is free */
+};
+
+
+EraseSchedulerBlockDevice::EraseSchedulerBlockDevice(BlockDevice *bd,
+                                                     events::EventQueue *queue)
+    : _bd(bd)
+    , _queue(queue)
+    , _default_queue(queue == NULL)
+    , _state(0)
+    , _units(0)
+    , _unit_size(0)
+    , _pending(0)
+    , _scan(0)
+    , _job_id(0)
+    , _scheduled(false)
+    , _running(false)
+{
+}
+
+EraseSchedulerBlockDevice::~EraseSchedulerBlockDevice()
+{
+    deinit();
+}
+
+int EraseSchedulerBlockDevice::init()
+{
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    if (_default_queue) {
+        _queue = mbed::mbed_event_queue();
+        if (!_queue) {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+    }
+
+    _mutex.lock();
+    _unit_size = _bd->get_erase_size();
+    _units = _bd->size() / _unit_size;
+
+    if (!_state) {
+        _state = new uint8_t[_units];
+    }
+    memset(_state, STATE_UNKNOWN, static_cast<size_t>(_units));
+
+    _pending = 0;
+    _scan = 0;
+    _scheduled = false;
+    _running = true;
+    _mutex.unlock();
+
+    return 0;
+}
+
+int EraseSchedulerBlockDevice::deinit()
+{
+    _mutex.lock();
+    _running = false;
+    int job = _job_id;
+    _mutex.unlock();
+
+    // A job that already started waits out our critical section above
+    // and then sees _running cleared; one that has not is cancelled
+    if (_queue) {
+        _queue->cancel(job);
+    }
+
+    _mutex.lock();
+    if (_state) {
+        delete[] _state;
+        _state = 0;
+    }
+    _mutex.unlock();
+
+    return _bd->deinit();
+}
+
+void EraseSchedulerBlockDevice::erase_next()
+{
+    _mutex.lock();
+    if (!_running || !_state || _pending == 0) {
+        _scheduled = false;
+        _mutex.unlock();
+        return;
+    }
+
+    // One unit per event keeps the shared queue responsive
+    bd_size_t unit = _units;
+    for (bd_size_t i = 0; i < _units; i++) {
+        bd_size_t u = _scan + i;
+        if (u >= _units) {
+            u -= _units;
+        }
+        if (_state[u] == STATE_QUEUED) {
+            unit = u;
+            break;
+        }
+    }
+
+    if (unit == _units) {
+        _pending = 0;
+        _scheduled = false;
+        _mutex.unlock();
+        return;
+    }
+
+    int err = _bd->erase(unit * _unit_size, _unit_size);
+    _state[unit] = err ? STATE_UNKNOWN : STATE_ERASED;
+    _scan = (unit + 1 < _units) ? unit + 1 : 0;
+    _pending--;
+
+    _scheduled = (_pending > 0);
+    if (_scheduled) {
+        _job_id = _queue->call(this, &EraseSchedulerBlockDevice::erase_next);
+        if (!_job_id) {
+            _scheduled = false;
+        }
+    }
+    _mutex.unlock();
+}
+
+int EraseSchedulerBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_read(addr, size));
+
+    _mutex.lock();
+    int err = _bd->read(buffer, addr, size);
+    _mutex.unlock();
+    return err;
+}
+
+int EraseSchedulerBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_program(addr, size));
+
+    _mutex.lock();
+    int err = _bd->program(buffer, addr, size);
+    if (!err && _state) {
+        for (bd_size_t u = addr / _unit_size;
+             u <= (addr + size - 1) / _unit_size; u++) {
+            if (_state[u] == STATE_QUEUED) {
+                _pending--;
+            }
+            _state[u] = STATE_UNKNOWN;
+        }
+    }
+    _mutex.unlock();
+    return err;
+}
+
+int EraseSchedulerBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+
+    _mutex.lock();
+    int err = 0;
+    for (bd_size_t u = addr / _unit_size;
+         u < (addr + size) / _unit_size && !err; u++) {
+        // The common case after a trim: already erased in the background
+        if (_state[u] == STATE_ERASED) {
+            continue;
+        }
+
+        err = _bd->erase(u * _unit_size, _unit_size);
+        if (!err) {
+            if (_state[u] == STATE_QUEUED) {
+                _pending--;
+            }
+            _state[u] = STATE_ERASED;
+        }
+    }
+    _mutex.unlock();
+    return err;
+}
+
+int EraseSchedulerBlockDevice::trim(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+
+    _mutex.lock();
+    for (bd_size_t u = addr / _unit_size;
+         u < (addr + size) / _unit_size; u++) {
+        if (_state[u] == STATE_UNKNOWN) {
+            _state[u] = STATE_QUEUED;
+            _pending++;
+        }
+    }
+
+    if (_pending > 0 && !_scheduled && _running) {
+        _scheduled = true;
+        _job_id = _queue->call(this, &EraseSchedulerBlockDevice::erase_next);
+        if (!_job_id) {
+            // Queue full: the next trim or the running job retries
+            _scheduled = false;
+        }
+    }
+    _mutex.unlock();
+    return 0;
+}
+
+bd_size_t EraseSchedulerBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t EraseSchedulerBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t EraseSchedulerBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t EraseSchedulerBlockDevice::size() const
+{
+    return _bd->size();
+}
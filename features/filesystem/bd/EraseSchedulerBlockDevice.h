@@ -0,0 +1,173 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_ERASE_SCHEDULER_BLOCK_DEVICE_H
+#define MBED_ERASE_SCHEDULER_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+#include "mbed.h"
+
+
+/** Block device that pre-erases trimmed regions in the background
+ *
+ *  Erases dominate write tail latency on flash: a block erase takes tens
+ *  of milliseconds while a program takes well under one. This device
+ *  turns the trim() hint into background work: trimmed erase units -
+ *  FATFileSystem trims the clusters of deleted files - are queued and
+ *  erased one at a time from the shared event queue while the device is
+ *  otherwise idle. An erase() of a unit that has already been pre-erased
+ *  returns immediately, so writes into reclaimed space nearly always
+ *  land on pre-erased sectors and skip the erase stall entirely.
+ *
+ *  All operations, including the background erase, serialize on an
+ *  internal mutex, so a foreground access can still wait out at most one
+ *  unit erase. Pre-erase state is tracked in RAM at one byte per erase
+ *  unit and does not survive a reset; pending trims are a hint and are
+ *  dropped on deinit.
+ *
+ *  @code
+ *  #include "mbed.h"
+ *  #include "SPIFBlockDevice.h"
+ *  #include "EraseSchedulerBlockDevice.h"
+ *  #include "FATFileSystem.h"
+ *
+ *  SPIFBlockDevice spif(PTE2, PTE4, PTE1, PTE5);
+ *  EraseSchedulerBlockDevice sched(&spif);
+ *  FATFileSystem fs("fs", &sched);
+ *
+ *  // deleting files trims their clusters; later appends find the
+ *  // space already erased
+ *  @endcode
+ */
+class EraseSchedulerBlockDevice : public BlockDevice
+{
+public:
+    /** Lifetime of the block device
+     *
+     *  @param bd       Block device to schedule erases for
+     *  @param queue    Event queue for the background erases, the shared
+     *                  event queue when NULL
+     */
+    EraseSchedulerBlockDevice(BlockDevice *bd, events::EventQueue *queue = NULL);
+
+    /** Lifetime of a block device
+     */
+    virtual ~EraseSchedulerBlockDevice();
+
+    /** Initialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  Cancels the background job; erase units still queued stay
+     *  untrimmed, which the trim hint allows.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  Units already erased in the background return immediately.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Mark blocks as no longer in use and queue them for pre-erasing
+     *
+     *  Whole erase units covered by the range are erased in the
+     *  background from the event queue.
+     *
+     *  @param addr     Address of block to mark as unused
+     *  @param size     Size to mark as unused in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programable block
+     *
+     *  @return         Size of a programable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of a eraseable block
+     *
+     *  @return         Size of a eraseable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+private:
+    void erase_next();
+
+    BlockDevice *_bd;
+    events::EventQueue *_queue;
+    bool _default_queue;
+    PlatformMutex _mutex;
+    uint8_t *_state;
+    bd_size_t _units;
+    bd_size_t _unit_size;
+    bd_size_t _pending;
+    bd_size_t _scan;
+    int _job_id;
+    bool _scheduled;
+    bool _running;
+};
+
+
+#endif
@@ -15,40 +15,113 @@
  */
 
 #include "HeapBlockDevice.h"
+#include <new>
+
+// Blocks covered by one leaf of the two-level block table. Only the
+// directory is sized for the whole device, one pointer per
+// HEAP_BLOCK_DEVICE_PAGE_BLOCKS blocks, so simulating geometries much
+// larger than the data a test actually touches stays cheap
+#define HEAP_BLOCK_DEVICE_PAGE_BLOCKS 256
+
+struct heap_block_page {
+    bd_size_t used;
+    uint8_t *blocks[HEAP_BLOCK_DEVICE_PAGE_BLOCKS];
+};
 
 
 HeapBlockDevice::HeapBlockDevice(bd_size_t size, bd_size_t block)
     : _read_size(block), _program_size(block), _erase_size(block)
-    , _count(size / block), _blocks(0)
+    , _count(size / block), _pages(0)
 {
     MBED_ASSERT(_count * _erase_size == size);
 }
 
 HeapBlockDevice::HeapBlockDevice(bd_size_t size, bd_size_t read, bd_size_t program, bd_size_t erase)
     : _read_size(read), _program_size(program), _erase_size(erase)
-    , _count(size / erase), _blocks(0)
+    , _count(size / erase), _pages(0)
 {
     MBED_ASSERT(_count * _erase_size == size);
 }
 
 HeapBlockDevice::~HeapBlockDevice()
 {
-    if (_blocks) {
-        for (size_t i = 0; i < _count; i++) {
-            free(_blocks[i]);
+    if (_pages) {
+        bd_size_t npages = (_count + HEAP_BLOCK_DEVICE_PAGE_BLOCKS - 1)
+                / HEAP_BLOCK_DEVICE_PAGE_BLOCKS;
+        for (bd_size_t i = 0; i < npages; i++) {
+            if (_pages[i]) {
+                for (size_t j = 0; j < HEAP_BLOCK_DEVICE_PAGE_BLOCKS; j++) {
+                    free(_pages[i]->blocks[j]);
+                }
+                delete _pages[i];
+            }
+        }
+
+        delete[] _pages;
+        _pages = 0;
+    }
+}
+
+uint8_t *HeapBlockDevice::block_at(bd_addr_t block) const
+{
+    heap_block_page *page = _pages[block / HEAP_BLOCK_DEVICE_PAGE_BLOCKS];
+    if (!page) {
+        return 0;
+    }
+    return page->blocks[block % HEAP_BLOCK_DEVICE_PAGE_BLOCKS];
+}
+
+uint8_t *HeapBlockDevice::block_alloc(bd_addr_t block)
+{
+    heap_block_page *&page = _pages[block / HEAP_BLOCK_DEVICE_PAGE_BLOCKS];
+    if (!page) {
+        page = new (std::nothrow) heap_block_page;
+        if (!page) {
+            return 0;
+        }
+        page->used = 0;
+        memset(page->blocks, 0, sizeof(page->blocks));
+    }
+
+    uint8_t *&b = page->blocks[block % HEAP_BLOCK_DEVICE_PAGE_BLOCKS];
+    if (!b) {
+        // Zeroed so the unprogrammed remainder of a partially programmed
+        // block reads back as zeroes, the same as an unmaterialized block
+        b = (uint8_t*)calloc(1, _erase_size);
+        if (b) {
+            page->used += 1;
         }
+    }
+    return b;
+}
+
+void HeapBlockDevice::block_free(bd_addr_t block)
+{
+    heap_block_page *&page = _pages[block / HEAP_BLOCK_DEVICE_PAGE_BLOCKS];
+    if (!page) {
+        return;
+    }
 
-        delete[] _blocks;
-        _blocks = 0;
+    uint8_t *&b = page->blocks[block % HEAP_BLOCK_DEVICE_PAGE_BLOCKS];
+    if (b) {
+        free(b);
+        b = 0;
+        page->used -= 1;
+        if (page->used == 0) {
+            delete page;
+            page = 0;
+        }
     }
 }
 
 int HeapBlockDevice::init()
 {
-    if (!_blocks) {
-        _blocks = new uint8_t*[_count];
-        for (size_t i = 0; i < _count; i++) {
-            _blocks[i] = 0;
+    if (!_pages) {
+        bd_size_t npages = (_count + HEAP_BLOCK_DEVICE_PAGE_BLOCKS - 1)
+                / HEAP_BLOCK_DEVICE_PAGE_BLOCKS;
+        _pages = new heap_block_page*[npages];
+        for (bd_size_t i = 0; i < npages; i++) {
+            _pages[i] = 0;
         }
     }
 
@@ -57,7 +130,7 @@ int HeapBlockDevice::init()
 
 int HeapBlockDevice::deinit()
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_pages != NULL);
     // Memory is lazily cleaned up in destructor to allow
     // data to live across de/reinitialization
     return BD_ERROR_OK;
@@ -65,31 +138,31 @@ int HeapBlockDevice::deinit()
 
 bd_size_t HeapBlockDevice::get_read_size() const
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_pages != NULL);
     return _read_size;
 }
 
 bd_size_t HeapBlockDevice::get_program_size() const
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_pages != NULL);
     return _program_size;
 }
 
 bd_size_t HeapBlockDevice::get_erase_size() const
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_pages != NULL);
     return _erase_size;
 }
 
 bd_size_t HeapBlockDevice::size() const
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_pages != NULL);
     return _count * _erase_size;
 }
 
 int HeapBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_pages != NULL);
     MBED_ASSERT(is_valid_read(addr, size));
     uint8_t *buffer = static_cast<uint8_t*>(b);
 
@@ -97,9 +170,12 @@ int HeapBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
         bd_addr_t hi = addr / _erase_size;
         bd_addr_t lo = addr % _erase_size;
 
-        if (_blocks[hi]) {
-            memcpy(buffer, &_blocks[hi][lo], _read_size);
+        uint8_t *block = block_at(hi);
+        if (block) {
+            memcpy(buffer, &block[lo], _read_size);
         } else {
+            // Unprogrammed blocks read back as zeroes without being
+            // materialized
             memset(buffer, 0, _read_size);
         }
 
@@ -113,7 +189,7 @@ int HeapBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 
 int HeapBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_pages != NULL);
     MBED_ASSERT(is_valid_program(addr, size));
     const uint8_t *buffer = static_cast<const uint8_t*>(b);
 
@@ -121,14 +197,12 @@ int HeapBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
         bd_addr_t hi = addr / _erase_size;
         bd_addr_t lo = addr % _erase_size;
 
-        if (!_blocks[hi]) {
-            _blocks[hi] = (uint8_t*)malloc(_erase_size);
-            if (!_blocks[hi]) {
-                return BD_ERROR_DEVICE_ERROR;
-            }
+        uint8_t *block = block_alloc(hi);
+        if (!block) {
+            return BD_ERROR_DEVICE_ERROR;
         }
 
-        memcpy(&_blocks[hi][lo], buffer, _program_size);
+        memcpy(&block[lo], buffer, _program_size);
 
         buffer += _program_size;
         addr += _program_size;
@@ -140,10 +214,46 @@ int HeapBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
 int HeapBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_pages != NULL);
     MBED_ASSERT(is_valid_erase(addr, size));
     // TODO assert on programming unerased blocks
 
     return 0;
 }
 
+int HeapBlockDevice::trim(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(_pages != NULL);
+    MBED_ASSERT(is_valid_erase(addr, size));
+
+    while (size > 0) {
+        block_free(addr / _erase_size);
+        addr += _erase_size;
+        size -= _erase_size;
+    }
+
+    return 0;
+}
+
+const void *HeapBlockDevice::map(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(_pages != NULL);
+    if (size == 0 || addr + size > this->size()) {
+        return NULL;
+    }
+
+    // Blocks are allocated separately, so only regions within a single
+    // allocated erase block are contiguous in memory
+    bd_addr_t hi = addr / _erase_size;
+    bd_addr_t lo = addr % _erase_size;
+    if ((addr + size - 1) / _erase_size != hi) {
+        return NULL;
+    }
+
+    uint8_t *block = block_at(hi);
+    if (!block) {
+        return NULL;
+    }
+
+    return &block[lo];
+}
@@ -26,9 +26,17 @@
 #include "mbed.h"
 
 
+// One leaf of the sparse block table, covers a fixed run of blocks
+struct heap_block_page;
+
 /** Lazily allocated heap-backed block device
  *
- * Useful for simulating a block device and tests
+ * Useful for simulating a block device and tests. Block storage is kept
+ * in a sparse two-level table: only a small directory is sized for the
+ * whole device and per-block buffers materialize on first program, so a
+ * device much larger than available RAM can be simulated as long as the
+ * test only touches part of it. Unprogrammed blocks read back as zeroes
+ * and trim() releases block storage back to the heap.
  *
  * @code
  * #include "mbed.h"
@@ -112,6 +120,30 @@ public:
      */
     virtual int erase(bd_addr_t addr, bd_size_t size);
 
+    /** Mark blocks as no longer in use
+     *
+     *  Releases the heap storage behind the trimmed blocks, which then
+     *  read back as zeroes until programmed again. Lets long-running
+     *  simulations hand memory back as their filesystem frees space.
+     *
+     *  @param addr     Address of block to mark as unused
+     *  @param size     Size to mark as unused in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    /** Get a pointer for directly reading a region of the block device
+     *
+     *  The heap storage is directly addressable one erase block at a time,
+     *  which makes this device useful for testing map-aware code paths.
+     *
+     *  @param addr     Address of the region to map
+     *  @param size     Size of the region to map in bytes
+     *  @return         Pointer to the region, NULL if the region spans
+     *                  erase blocks or has not been programmed
+     */
+    virtual const void *map(bd_addr_t addr, bd_size_t size);
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -137,11 +169,15 @@ public:
     virtual bd_size_t size() const;
 
 private:
+    uint8_t *block_at(bd_addr_t block) const;
+    uint8_t *block_alloc(bd_addr_t block);
+    void block_free(bd_addr_t block);
+
     bd_size_t _read_size;
     bd_size_t _program_size;
     bd_size_t _erase_size;
     bd_size_t _count;
-    uint8_t **_blocks;
+    heap_block_page **_pages;
 };
 
 
@@ -15,6 +15,7 @@
  */
 
 #include "MBRBlockDevice.h"
+#include "platform/mbed_critical.h"
 #include <algorithm>
 
 
@@ -63,6 +64,75 @@ static void tochs(uint32_t lba, uint8_t chs[3])
     chs[2] = (sector >> 14) & 0xff;
 }
 
+// Shared registry of parsed partition tables, keyed by the underlying
+// device, so sibling partitions of one device read and parse the MBR
+// sector once between them rather than once per instance
+#define MBR_CACHE_SIZE 4
+
+struct mbr_cache_entry {
+    BlockDevice *bd;
+    uint8_t type[4];
+    uint32_t lba_offset[4];
+    uint32_t lba_size[4];
+};
+
+static struct mbr_cache_entry mbr_cache[MBR_CACHE_SIZE];
+
+static bool mbr_cache_find(BlockDevice *bd, int part,
+        uint8_t *type, uint32_t *lba_offset, uint32_t *lba_size)
+{
+    bool found = false;
+
+    core_util_critical_section_enter();
+    for (int i = 0; i < MBR_CACHE_SIZE; i++) {
+        if (mbr_cache[i].bd == bd) {
+            *type = mbr_cache[i].type[part-1];
+            *lba_offset = mbr_cache[i].lba_offset[part-1];
+            *lba_size = mbr_cache[i].lba_size[part-1];
+            found = true;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+    return found;
+}
+
+static void mbr_cache_store(BlockDevice *bd, const struct mbr_table *table)
+{
+    struct mbr_cache_entry *entry = NULL;
+
+    core_util_critical_section_enter();
+    for (int i = 0; i < MBR_CACHE_SIZE; i++) {
+        if (mbr_cache[i].bd == bd || (!entry && !mbr_cache[i].bd)) {
+            entry = &mbr_cache[i];
+            if (mbr_cache[i].bd == bd) {
+                break;
+            }
+        }
+    }
+    // If the registry is full the table just gets re-read next init
+    if (entry) {
+        entry->bd = bd;
+        for (int part = 0; part < 4; part++) {
+            entry->type[part] = table->entries[part].type;
+            entry->lba_offset[part] = fromle32(table->entries[part].lba_offset);
+            entry->lba_size[part] = fromle32(table->entries[part].lba_size);
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+static void mbr_cache_drop(BlockDevice *bd)
+{
+    core_util_critical_section_enter();
+    for (int i = 0; i < MBR_CACHE_SIZE; i++) {
+        if (mbr_cache[i].bd == bd) {
+            mbr_cache[i].bd = NULL;
+        }
+    }
+    core_util_critical_section_exit();
+}
+
 
 // Partition after address are turned into absolute
 // addresses, assumes bd is initialized
@@ -115,6 +185,9 @@ static int partition_absolute(
 
     err = bd->program(buffer, 512-buffer_size, buffer_size);
     delete[] buffer;
+
+    // The on-disk table changed, drop any cached copy
+    mbr_cache_drop(bd);
     return err;
 }
 
@@ -180,57 +253,79 @@ int MBRBlockDevice::partition(BlockDevice *bd, int part, uint8_t type,
 }
 
 MBRBlockDevice::MBRBlockDevice(BlockDevice *bd, int part)
-    : _bd(bd), _part(part)
+    : _bd(bd), _read_size(0), _program_size(0), _erase_size(0), _part(part)
 {
     MBED_ASSERT(_part >= 1 && _part <= 4);
 }
 
 int MBRBlockDevice::init()
 {
-    int err = _bd->init();
-    if (err) {
-        return err;
-    }
-
-    // Allocate smallest buffer necessary to write MBR
-    uint32_t buffer_size = std::max<uint32_t>(_bd->get_read_size(), sizeof(struct mbr_table));
-    uint8_t *buffer = new uint8_t[buffer_size];
+    uint8_t type;
+    uint32_t lba_offset;
+    uint32_t lba_size;
 
-    err = _bd->read(buffer, 512-buffer_size, buffer_size);
+    int err = _bd->init();
     if (err) {
-        delete[] buffer;
         return err;
     }
 
-    // Check for valid table
-    struct mbr_table *table = reinterpret_cast<struct mbr_table*>(
-            &buffer[buffer_size - sizeof(struct mbr_table)]);
-    if (table->signature[0] != 0x55 || table->signature[1] != 0xaa) {
+    // Cache the underlying block sizes so the per-I/O validity checks
+    // and size queries don't go through the device's virtual getters
+    _read_size = _bd->get_read_size();
+    _program_size = _bd->get_program_size();
+    _erase_size = _bd->get_erase_size();
+
+    if (!mbr_cache_find(_bd, _part, &type, &lba_offset, &lba_size)) {
+        // Allocate smallest buffer necessary to write MBR
+        uint32_t buffer_size = std::max<uint32_t>(_read_size, sizeof(struct mbr_table));
+        uint8_t *buffer = new uint8_t[buffer_size];
+
+        err = _bd->read(buffer, 512-buffer_size, buffer_size);
+        if (err) {
+            delete[] buffer;
+            return err;
+        }
+
+        // Check for valid table
+        struct mbr_table *table = reinterpret_cast<struct mbr_table*>(
+                &buffer[buffer_size - sizeof(struct mbr_table)]);
+        if (table->signature[0] != 0x55 || table->signature[1] != 0xaa) {
+            delete[] buffer;
+            return BD_ERROR_INVALID_MBR;
+        }
+
+        // Share the parsed table with sibling partitions
+        mbr_cache_store(_bd, table);
+
+        type = table->entries[_part-1].type;
+        lba_offset = fromle32(table->entries[_part-1].lba_offset);
+        lba_size = fromle32(table->entries[_part-1].lba_size);
         delete[] buffer;
-        return BD_ERROR_INVALID_MBR;
     }
 
     // Check for valid entry
-    if (table->entries[_part-1].type == 0x00) {
-        delete[] buffer;
+    if (type == 0x00) {
         return BD_ERROR_INVALID_PARTITION;
     }
 
     // Get partition attributes
-    bd_size_t sector = std::max<uint32_t>(_bd->get_erase_size(), 512);
-    _type = table->entries[_part-1].type;
-    _offset = fromle32(table->entries[_part-1].lba_offset) * sector;
-    _size   = fromle32(table->entries[_part-1].lba_size)   * sector;
+    bd_size_t sector = std::max<uint32_t>(_erase_size, 512);
+    _type = type;
+    _offset = lba_offset * sector;
+    _size   = lba_size   * sector;
 
-    // Check that block addresses are valid
+    // Check that block addresses are valid; alignment is proven once
+    // here, the per-I/O asserts below only re-check relative addresses
     MBED_ASSERT(_bd->is_valid_erase(_offset, _size));
 
-    delete[] buffer;
     return 0;
 }
 
 int MBRBlockDevice::deinit()
 {
+    // The underlying device may be swapped while deinitialized, don't
+    // trust the cached table past this point
+    mbr_cache_drop(_bd);
     return _bd->deinit();
 }
 
@@ -254,16 +349,25 @@ int MBRBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 
 bd_size_t MBRBlockDevice::get_read_size() const
 {
+    if (_read_size) {
+        return _read_size;
+    }
     return _bd->get_read_size();
 }
 
 bd_size_t MBRBlockDevice::get_program_size() const
 {
+    if (_program_size) {
+        return _program_size;
+    }
     return _bd->get_program_size();
 }
 
 bd_size_t MBRBlockDevice::get_erase_size() const
 {
+    if (_erase_size) {
+        return _erase_size;
+    }
     return _bd->get_erase_size();
 }
 
@@ -219,6 +219,12 @@ protected:
     BlockDevice *_bd;
     bd_size_t _offset;
     bd_size_t _size;
+    // Block sizes of the underlying device, cached at init so the
+    // per-I/O validity checks and size queries don't chase the
+    // underlying device's virtual getters
+    bd_size_t _read_size;
+    bd_size_t _program_size;
+    bd_size_t _erase_size;
     uint8_t _type;
     uint8_t _part;
 };
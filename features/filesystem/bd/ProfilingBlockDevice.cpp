@@ -15,14 +15,46 @@
  */
 
 #include "ProfilingBlockDevice.h"
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#include <string.h>
 
 
+// Index of the power-of-two bucket holding v, clamped to the last bucket
+static uint32_t profile_bucket(bd_size_t v)
+{
+    uint32_t b = 0;
+    while ((v >> (b + 1)) != 0 && b < BD_OP_STATS_BUCKETS - 1) {
+        b++;
+    }
+    return b;
+}
+
+static void profile_op(bd_op_stats_t *stats, bd_size_t size, uint32_t latency)
+{
+    if (stats->count == 0 || latency < stats->min_latency) {
+        stats->min_latency = latency;
+    }
+    if (latency > stats->max_latency) {
+        stats->max_latency = latency;
+    }
+
+    stats->count += 1;
+    stats->bytes += size;
+    stats->total_latency += latency;
+    stats->latency_hist[profile_bucket(latency)] += 1;
+    stats->size_hist[profile_bucket(size)] += 1;
+}
+
 ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd)
     : _bd(bd)
     , _read_count(0)
     , _program_count(0)
     , _erase_count(0)
 {
+    memset(&_read_stats, 0, sizeof(_read_stats));
+    memset(&_program_stats, 0, sizeof(_program_stats));
+    memset(&_erase_stats, 0, sizeof(_erase_stats));
 }
 
 int ProfilingBlockDevice::init()
@@ -37,27 +69,36 @@ int ProfilingBlockDevice::deinit()
 
 int ProfilingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
+    timestamp_t start = ticker_read(get_us_ticker_data());
     int err = _bd->read(b, addr, size);
     if (!err) {
         _read_count += size;
+        profile_op(&_read_stats, size,
+                   ticker_read(get_us_ticker_data()) - start);
     }
     return err;
 }
 
 int ProfilingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
+    timestamp_t start = ticker_read(get_us_ticker_data());
     int err = _bd->program(b, addr, size);
     if (!err) {
         _program_count += size;
+        profile_op(&_program_stats, size,
+                   ticker_read(get_us_ticker_data()) - start);
     }
     return err;
 }
 
 int ProfilingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
+    timestamp_t start = ticker_read(get_us_ticker_data());
     int err = _bd->erase(addr, size);
     if (!err) {
         _erase_count += size;
+        profile_op(&_erase_stats, size,
+                   ticker_read(get_us_ticker_data()) - start);
     }
     return err;
 }
@@ -87,6 +128,9 @@ void ProfilingBlockDevice::reset()
     _read_count = 0;
     _program_count = 0;
     _erase_count = 0;
+    memset(&_read_stats, 0, sizeof(_read_stats));
+    memset(&_program_stats, 0, sizeof(_program_stats));
+    memset(&_erase_stats, 0, sizeof(_erase_stats));
 }
 
 bd_size_t ProfilingBlockDevice::get_read_count() const
@@ -103,3 +147,18 @@ bd_size_t ProfilingBlockDevice::get_erase_count() const
 {
     return _erase_count;
 }
+
+void ProfilingBlockDevice::get_read_stats(bd_op_stats_t *stats) const
+{
+    *stats = _read_stats;
+}
+
+void ProfilingBlockDevice::get_program_stats(bd_op_stats_t *stats) const
+{
+    *stats = _program_stats;
+}
+
+void ProfilingBlockDevice::get_erase_stats(bd_op_stats_t *stats) const
+{
+    *stats = _erase_stats;
+}
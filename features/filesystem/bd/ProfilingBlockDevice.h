@@ -25,8 +25,31 @@
 #include "BlockDevice.h"
 #include "mbed.h"
 
+/** Number of power-of-two buckets in the profile histograms */
+#define BD_OP_STATS_BUCKETS 16
+
+/** Profile of one operation type (read, program or erase)
+ *
+ *  Histogram bucket i counts values in [2^i, 2^(i+1)), the last bucket
+ *  is open-ended. Latencies are in microseconds, sizes in bytes.
+ */
+typedef struct bd_op_stats {
+    bd_size_t count;        /**< Number of operations */
+    bd_size_t bytes;        /**< Total bytes transferred */
+    uint32_t min_latency;   /**< Shortest operation in us */
+    uint32_t max_latency;   /**< Longest operation in us */
+    uint64_t total_latency; /**< Sum of operation latencies in us */
+    uint32_t latency_hist[BD_OP_STATS_BUCKETS]; /**< Latency distribution */
+    uint32_t size_hist[BD_OP_STATS_BUCKETS];    /**< Op-size distribution */
+} bd_op_stats_t;
+
 
 /** Block device for measuring storage operations of another block device
+ *
+ *  Each operation is timed with the microsecond ticker and recorded in
+ *  per-operation-type latency and op-size histograms, so a workload of
+ *  thousands of small reads is distinguishable from a few large ones
+ *  with the same byte total.
  *
  *  @code
  *  #include "mbed.h"
@@ -42,6 +65,13 @@
  *  printf("read count: %lld\n", profiler.get_read_count());
  *  printf("program count: %lld\n", profiler.get_program_count());
  *  printf("erase count: %lld\n", profiler.get_erase_count());
+ *
+ *  bd_op_stats_t stats;
+ *  profiler.get_read_stats(&stats);
+ *  printf("reads: %lld, worst %lu us\n", stats.count, stats.max_latency);
+ *  for (int i = 0; i < BD_OP_STATS_BUCKETS; i++) {
+ *      printf("  %d us: %lu\n", 1 << i, stats.latency_hist[i]);
+ *  }
  */
 class ProfilingBlockDevice : public BlockDevice
 {
@@ -148,11 +178,32 @@ public:
      */
     bd_size_t get_erase_count() const;
 
+    /** Get a snapshot of the read profile
+     *
+     *  @param stats    Destination for the profile of read operations
+     */
+    void get_read_stats(bd_op_stats_t *stats) const;
+
+    /** Get a snapshot of the program profile
+     *
+     *  @param stats    Destination for the profile of program operations
+     */
+    void get_program_stats(bd_op_stats_t *stats) const;
+
+    /** Get a snapshot of the erase profile
+     *
+     *  @param stats    Destination for the profile of erase operations
+     */
+    void get_erase_stats(bd_op_stats_t *stats) const;
+
 private:
     BlockDevice *_bd;
     bd_size_t _read_count;
     bd_size_t _program_count;
     bd_size_t _erase_count;
+    bd_op_stats_t _read_stats;
+    bd_op_stats_t _program_stats;
+    bd_op_stats_t _erase_stats;
 };
 
 
@@ -93,6 +93,14 @@ int SlicingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return _bd->erase(addr + _start, size);
 }
 
+const void *SlicingBlockDevice::map(bd_addr_t addr, bd_size_t size)
+{
+    if (addr + size > this->size()) {
+        return NULL;
+    }
+    return _bd->map(addr + _start, size);
+}
+
 bd_size_t SlicingBlockDevice::get_read_size() const
 {
     return _bd->get_read_size();
@@ -115,6 +115,18 @@ public:
      */
     virtual int erase(bd_addr_t addr, bd_size_t size);
 
+    /** Get a pointer for directly reading a region of the block device
+     *
+     *  Forwarded to the underlying block device with the slice offset
+     *  applied, NULL if the underlying device is not directly addressable.
+     *
+     *  @param addr     Address of the region to map
+     *  @param size     Size of the region to map in bytes
+     *  @return         Pointer to the region, NULL if the region is not
+     *                  directly addressable
+     */
+    virtual const void *map(bd_addr_t addr, bd_size_t size);
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -0,0 +1,517 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WearLevelingBlockDevice.h"
+#include <string.h>
+
+/* "MWL1" - identifies a valid header slot */
+static const uint32_t WL_MAGIC = 0x314c574d;
+/* Logical index of a spare unit, and the unmapped entry in the table */
+static const uint32_t WL_NONE = 0xffffffff;
+/* On-flash size of one header slot, rounded up to the program size at
+ * init. The header holds two slots so each is only ever programmed into
+ * erased flash: slot 0 (the erase count) right after the erase, slot 1
+ * (logical index and sequence number) when the spare is put in service */
+static const bd_size_t WL_SLOT_SIZE = 16;
+
+
+WearLevelingBlockDevice::WearLevelingBlockDevice(BlockDevice *bd,
+                                                 bd_size_t spare_units,
+                                                 uint32_t wear_threshold)
+    : _bd(bd)
+    , _spare_units(spare_units)
+    , _wear_threshold(wear_threshold)
+    , _unit_size(0)
+    , _hdr_size(0)
+    , _payload_size(0)
+    , _units(0)
+    , _logical_units(0)
+    , _map(0)
+    , _owner(0)
+    , _wear(0)
+    , _scratch(0)
+    , _scratch_size(0)
+    , _seq(0)
+{
+}
+
+WearLevelingBlockDevice::~WearLevelingBlockDevice()
+{
+    deinit();
+}
+
+int WearLevelingBlockDevice::init()
+{
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    bd_size_t prog = _bd->get_program_size();
+
+    _unit_size = _bd->get_erase_size();
+    _hdr_size = 2 * (((WL_SLOT_SIZE + prog - 1) / prog) * prog);
+    _payload_size = _unit_size - _hdr_size;
+    _units = _bd->size() / _unit_size;
+    _logical_units = _units - _spare_units;
+
+    if (_unit_size % prog != 0 ||
+        prog % _bd->get_read_size() != 0 ||
+        _hdr_size >= _unit_size ||
+        _spare_units < 1 || _units <= _spare_units) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!_map) {
+        _map = new uint32_t[_logical_units];
+        _owner = new uint32_t[_units];
+        _wear = new uint32_t[_units];
+
+        // Copies and header writes go through one scratch buffer, kept
+        // large enough that byte-programmable devices still see big chunks
+        _scratch_size = _hdr_size;
+        while (_scratch_size < 512) {
+            _scratch_size *= 2;
+        }
+        _scratch = new uint8_t[_scratch_size];
+    }
+
+    for (bd_size_t l = 0; l < _logical_units; l++) {
+        _map[l] = WL_NONE;
+    }
+
+    // Rebuild the translation table from the unit headers. Two units
+    // claiming the same logical index mean a relocation was interrupted
+    // before the stale unit was reclaimed: the higher sequence number wins
+    _seq = 0;
+    bool *stale = new bool[_units];
+
+    for (bd_size_t p = 0; p < _units; p++) {
+        unit_header hdr;
+        stale[p] = false;
+
+        err = read_header(p, &hdr);
+        if (err) {
+            delete[] stale;
+            return err;
+        }
+
+        _owner[p] = WL_NONE;
+        if (hdr.magic != WL_MAGIC) {
+            _wear[p] = 0;
+            stale[p] = true;
+            continue;
+        }
+
+        _wear[p] = hdr.erase_count;
+        if (hdr.seq >= _seq) {
+            _seq = hdr.seq + 1;
+        }
+
+        if (hdr.logical >= _logical_units) {
+            continue;
+        }
+
+        if (_map[hdr.logical] == WL_NONE) {
+            _map[hdr.logical] = p;
+            _owner[p] = hdr.logical;
+        } else {
+            bd_size_t q = _map[hdr.logical];
+            unit_header other;
+            err = read_header(q, &other);
+            if (err) {
+                delete[] stale;
+                return err;
+            }
+
+            if (hdr.seq > other.seq) {
+                stale[q] = true;
+                _owner[q] = WL_NONE;
+                _map[hdr.logical] = p;
+                _owner[p] = hdr.logical;
+            } else {
+                stale[p] = true;
+            }
+        }
+    }
+
+    // Claim unformatted units and reclaim stale ones as spares
+    for (bd_size_t p = 0; p < _units && !err; p++) {
+        if (stale[p]) {
+            err = format_unit(p);
+        }
+    }
+
+    delete[] stale;
+    return err;
+}
+
+int WearLevelingBlockDevice::deinit()
+{
+    if (_map) {
+        delete[] _map;
+        delete[] _owner;
+        delete[] _wear;
+        delete[] _scratch;
+        _map = 0;
+        _owner = 0;
+        _wear = 0;
+        _scratch = 0;
+    }
+
+    return _bd->deinit();
+}
+
+int WearLevelingBlockDevice::read_header(bd_size_t phys, unit_header *hdr)
+{
+    int err = _bd->read(_scratch, phys * _unit_size, _hdr_size);
+    if (err) {
+        return err;
+    }
+
+    unit_slot slot0, slot1;
+    memcpy(&slot0, _scratch, sizeof(unit_slot));
+    memcpy(&slot1, _scratch + _hdr_size / 2, sizeof(unit_slot));
+
+    hdr->magic = slot0.magic;
+    hdr->erase_count = slot0.value;
+    if (slot1.magic == WL_MAGIC) {
+        hdr->logical = slot1.value;
+        hdr->seq = slot1.seq;
+    } else {
+        hdr->logical = WL_NONE;
+        hdr->seq = 0;
+    }
+    return 0;
+}
+
+int WearLevelingBlockDevice::write_slot(bd_size_t phys, bd_size_t which,
+                                        uint32_t value, uint32_t seq)
+{
+    unit_slot slot;
+    slot.magic = WL_MAGIC;
+    slot.value = value;
+    slot.seq = seq;
+    slot.pad = 0xffffffff;
+
+    bd_size_t slot_size = _hdr_size / 2;
+    memset(_scratch, 0xff, static_cast<size_t>(slot_size));
+    memcpy(_scratch, &slot, sizeof(unit_slot));
+    return _bd->program(_scratch, phys * _unit_size + which * slot_size,
+                        slot_size);
+}
+
+int WearLevelingBlockDevice::write_header(bd_size_t phys, uint32_t logical)
+{
+    // Slot 1 is still erased on a freshly formatted unit, so claiming a
+    // spare never reprograms written flash
+    return write_slot(phys, 1, logical, _seq++);
+}
+
+int WearLevelingBlockDevice::format_unit(bd_size_t phys)
+{
+    int err = _bd->erase(phys * _unit_size, _unit_size);
+    if (err) {
+        return err;
+    }
+
+    _wear[phys]++;
+    _owner[phys] = WL_NONE;
+    return write_slot(phys, 0, _wear[phys], 0);
+}
+
+int WearLevelingBlockDevice::pick_spare(bd_size_t *spare)
+{
+    bd_size_t best = WL_NONE;
+
+    for (bd_size_t p = 0; p < _units; p++) {
+        if (_owner[p] == WL_NONE &&
+            (best == WL_NONE || _wear[p] < _wear[best])) {
+            best = p;
+        }
+    }
+
+    if (best == WL_NONE) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    *spare = best;
+    return 0;
+}
+
+int WearLevelingBlockDevice::copy_payload(bd_size_t dst, bd_size_t src,
+                                          bd_size_t off, const uint8_t *data,
+                                          bd_size_t len)
+{
+    for (bd_size_t pos = 0; pos < _payload_size; pos += _scratch_size) {
+        bd_size_t n = _payload_size - pos;
+        if (n > _scratch_size) {
+            n = _scratch_size;
+        }
+
+        bool touched = false;
+        if (src != WL_NONE) {
+            int err = _bd->read(_scratch,
+                                src * _unit_size + _hdr_size + pos, n);
+            if (err) {
+                return err;
+            }
+            touched = true;
+        } else {
+            memset(_scratch, 0xff, static_cast<size_t>(n));
+        }
+
+        // Overlay the new data where it intersects this chunk
+        if (off < pos + n && off + len > pos) {
+            bd_size_t lo = (off > pos) ? off : pos;
+            bd_size_t hi = (off + len < pos + n) ? off + len : pos + n;
+            memcpy(_scratch + (lo - pos), data + (lo - off),
+                   static_cast<size_t>(hi - lo));
+            touched = true;
+        }
+
+        // Nothing to put in an erased chunk - skip the program
+        if (!touched) {
+            continue;
+        }
+
+        int err = _bd->program(_scratch,
+                               dst * _unit_size + _hdr_size + pos, n);
+        if (err) {
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+int WearLevelingBlockDevice::relocate(bd_size_t logical,
+                                      bd_size_t off, const uint8_t *data,
+                                      bd_size_t len)
+{
+    bd_size_t spare;
+    int err = pick_spare(&spare);
+    if (err) {
+        return err;
+    }
+
+    // Static wear leveling: if the spare has been erased far more often
+    // than the least-worn unit, move that unit's cold data onto the spare
+    // and recycle the cold unit as the relocation target instead
+    bd_size_t cold = spare;
+    for (bd_size_t p = 0; p < _units; p++) {
+        if (_wear[p] < _wear[cold]) {
+            cold = p;
+        }
+    }
+
+    if (_owner[cold] != WL_NONE &&
+        _wear[spare] > _wear[cold] + _wear_threshold) {
+        err = copy_payload(spare, cold, 0, 0, 0);
+        if (err) {
+            return err;
+        }
+        err = write_header(spare, _owner[cold]);
+        if (err) {
+            return err;
+        }
+
+        _map[_owner[cold]] = spare;
+        _owner[spare] = _owner[cold];
+
+        err = format_unit(cold);
+        if (err) {
+            return err;
+        }
+        spare = cold;
+    }
+
+    bd_size_t old = _map[logical];
+
+    err = copy_payload(spare, (old == WL_NONE) ? WL_NONE : old,
+                       off, data, len);
+    if (err) {
+        return err;
+    }
+
+    // Header last: until it lands, an interrupted relocation leaves the
+    // old unit as the valid copy
+    err = write_header(spare, logical);
+    if (err) {
+        return err;
+    }
+
+    _map[logical] = spare;
+    _owner[spare] = logical;
+
+    if (old != WL_NONE) {
+        return format_unit(old);
+    }
+    return 0;
+}
+
+int WearLevelingBlockDevice::range_erased(bd_size_t phys,
+                                          bd_size_t off, bd_size_t len,
+                                          bool *erased)
+{
+    *erased = true;
+    while (len > 0) {
+        bd_size_t n = (len > _scratch_size) ? _scratch_size : len;
+        int err = _bd->read(_scratch, phys * _unit_size + _hdr_size + off, n);
+        if (err) {
+            return err;
+        }
+
+        for (bd_size_t i = 0; i < n; i++) {
+            if (_scratch[i] != 0xff) {
+                *erased = false;
+                return 0;
+            }
+        }
+
+        off += n;
+        len -= n;
+    }
+
+    return 0;
+}
+
+int WearLevelingBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_read(addr, size));
+    uint8_t *b = static_cast<uint8_t *>(buffer);
+
+    while (size > 0) {
+        bd_size_t l = addr / _payload_size;
+        bd_size_t off = addr % _payload_size;
+        bd_size_t n = _payload_size - off;
+        if (n > size) {
+            n = size;
+        }
+
+        if (_map[l] != WL_NONE) {
+            int err = _bd->read(b, _map[l] * _unit_size + _hdr_size + off, n);
+            if (err) {
+                return err;
+            }
+        } else {
+            memset(b, 0xff, static_cast<size_t>(n));
+        }
+
+        b += n;
+        addr += n;
+        size -= n;
+    }
+
+    return 0;
+}
+
+int WearLevelingBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_program(addr, size));
+    const uint8_t *b = static_cast<const uint8_t *>(buffer);
+
+    while (size > 0) {
+        bd_size_t l = addr / _payload_size;
+        bd_size_t off = addr % _payload_size;
+        bd_size_t n = _payload_size - off;
+        if (n > size) {
+            n = size;
+        }
+
+        // Programming still-erased blocks of a mapped unit needs no
+        // relocation, so sequential streaming writes go straight through
+        bool in_place = false;
+        if (_map[l] != WL_NONE) {
+            int err = range_erased(_map[l], off, n, &in_place);
+            if (err) {
+                return err;
+            }
+        }
+
+        int err;
+        if (in_place) {
+            err = _bd->program(b, _map[l] * _unit_size + _hdr_size + off, n);
+        } else {
+            err = relocate(l, off, b, n);
+        }
+        if (err) {
+            return err;
+        }
+
+        b += n;
+        addr += n;
+        size -= n;
+    }
+
+    return 0;
+}
+
+int WearLevelingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+
+    // Unmap the logical units the range fully covers; partially covered
+    // units keep their data, which "state undefined after erase" allows
+    bd_size_t first = (addr + _payload_size - 1) / _payload_size;
+    bd_size_t last = (addr + size) / _payload_size;
+
+    for (bd_size_t l = first; l < last; l++) {
+        if (_map[l] != WL_NONE) {
+            int err = format_unit(_map[l]);
+            if (err) {
+                return err;
+            }
+            _map[l] = WL_NONE;
+        }
+    }
+
+    return 0;
+}
+
+bd_size_t WearLevelingBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t WearLevelingBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t WearLevelingBlockDevice::get_erase_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t WearLevelingBlockDevice::size() const
+{
+    bd_size_t unit = _bd->get_erase_size();
+    bd_size_t prog = _bd->get_program_size();
+    bd_size_t hdr = 2 * (((WL_SLOT_SIZE + prog - 1) / prog) * prog);
+
+    return (_bd->size() / unit - _spare_units) * (unit - hdr);
+}
+
+bd_size_t WearLevelingBlockDevice::get_unit_count() const
+{
+    return _bd->size() / _bd->get_erase_size();
+}
+
+uint32_t WearLevelingBlockDevice::get_erase_count(bd_size_t unit) const
+{
+    return _wear ? _wear[unit] : 0;
+}
@@ -0,0 +1,218 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_WEAR_LEVELING_BLOCK_DEVICE_H
+#define MBED_WEAR_LEVELING_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+#include "mbed.h"
+
+
+/** Flash translation layer for running a filesystem on raw NOR flash
+ *
+ *  Maps logical erase units onto physical units of the underlying device
+ *  through a table rebuilt at init from a small header stored in each
+ *  unit. Rewriting data relocates the unit to a spare with copy-on-write,
+ *  so the presented device can be programmed without a prior erase and a
+ *  write costs at most one unit copy plus one unit erase - no device-wide
+ *  garbage collection pause.
+ *
+ *  Spares are chosen by lowest erase count, and units whose count falls
+ *  too far behind are rotated in, so repeated rewrites of the same
+ *  logical sectors - FAT's allocation table is the classic case - spread
+ *  over the whole device instead of wearing out one erase unit. Erase
+ *  counts are persisted in the unit headers and survive reboots.
+ *
+ *  Each unit donates its first program blocks to the header, so the
+ *  presented size is slightly smaller than the underlying device. Units
+ *  without a valid header are claimed and erased on the first init.
+ *
+ *  Small scattered writes still relocate a whole unit each; a
+ *  BufferedBlockDevice in front absorbs them into whole-line writes.
+ *
+ *  @code
+ *  #include "mbed.h"
+ *  #include "SPIFBlockDevice.h"
+ *  #include "WearLevelingBlockDevice.h"
+ *  #include "FATFileSystem.h"
+ *
+ *  SPIFBlockDevice spif(PTE2, PTE4, PTE1, PTE5);
+ *  WearLevelingBlockDevice ftl(&spif);
+ *  FATFileSystem fs("fs", &ftl);
+ *  @endcode
+ */
+class WearLevelingBlockDevice : public BlockDevice
+{
+public:
+    /** Lifetime of the block device
+     *
+     *  @param bd               Block device to translate, erased in units
+     *                          of its erase size
+     *  @param spare_units      Number of physical units kept aside as
+     *                          relocation targets
+     *  @param wear_threshold   Maximum allowed spread between erase
+     *                          counts before a cold unit is rotated into
+     *                          service as a spare
+     */
+    WearLevelingBlockDevice(BlockDevice *bd,
+                            bd_size_t spare_units = 2,
+                            uint32_t wear_threshold = 64);
+
+    /** Lifetime of a block device
+     */
+    virtual ~WearLevelingBlockDevice();
+
+    /** Initialize a block device and rebuild the translation table
+     *
+     *  Scans the unit headers, resolves interrupted relocations and
+     *  claims unformatted units.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  No prior erase is required: rewriting programmed blocks relocates
+     *  their unit to a spare.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  Logical units fully covered by the range are unmapped and their
+     *  physical units reclaimed as spares.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programable block
+     *
+     *  @return         Size of a programable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of a eraseable block
+     *
+     *  Equals the program size, as programs never need a prior erase.
+     *
+     *  @return         Size of a eraseable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the total logical size of the device
+     *
+     *  Smaller than the underlying device by the spare units and the
+     *  per-unit headers.
+     *
+     *  @return         Size of the device in bytes
+     */
+    virtual bd_size_t size() const;
+
+    /** Get the number of physical erase units
+     *
+     *  @return         Number of erase units on the underlying device
+     */
+    bd_size_t get_unit_count() const;
+
+    /** Get the erase count of a physical unit
+     *
+     *  @param unit     Physical unit index, less than get_unit_count()
+     *  @return         Number of times the unit has been erased
+     */
+    uint32_t get_erase_count(bd_size_t unit) const;
+
+private:
+    /* One on-flash header slot; a unit has two so that each is only ever
+     * programmed into erased flash */
+    struct unit_slot {
+        uint32_t magic;
+        uint32_t value;
+        uint32_t seq;
+        uint32_t pad;
+    };
+
+    /* In-memory view of both slots of a unit */
+    struct unit_header {
+        uint32_t magic;
+        uint32_t logical;
+        uint32_t erase_count;
+        uint32_t seq;
+    };
+
+    int read_header(bd_size_t phys, unit_header *hdr);
+    int write_slot(bd_size_t phys, bd_size_t which, uint32_t value, uint32_t seq);
+    int write_header(bd_size_t phys, uint32_t logical);
+    int format_unit(bd_size_t phys);
+    int copy_payload(bd_size_t dst, bd_size_t src,
+                     bd_size_t off, const uint8_t *data, bd_size_t len);
+    int relocate(bd_size_t logical,
+                 bd_size_t off, const uint8_t *data, bd_size_t len);
+    int pick_spare(bd_size_t *spare);
+    int range_erased(bd_size_t phys, bd_size_t off, bd_size_t len, bool *erased);
+
+    BlockDevice *_bd;
+    bd_size_t _spare_units;
+    uint32_t _wear_threshold;
+    bd_size_t _unit_size;
+    bd_size_t _hdr_size;
+    bd_size_t _payload_size;
+    bd_size_t _units;
+    bd_size_t _logical_units;
+    uint32_t *_map;
+    uint32_t *_owner;
+    uint32_t *_wear;
+    uint8_t *_scratch;
+    bd_size_t _scratch_size;
+    uint32_t _seq;
+};
+
+
+#endif
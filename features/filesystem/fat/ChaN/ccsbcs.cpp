@@ -24,6 +24,32 @@
 #include "ff.h"
 
 
+#if _CODE_PAGE == 1
+/* ASCII-only configuration: names are restricted to 7-bit characters, so
+/  conversion collapses to a range check and no codepage tables are linked */
+
+WCHAR ff_convert (	/* Converted character, Returns zero on error */
+	WCHAR	chr,	/* Character code to be converted */
+	UINT	dir		/* 0: Unicode to OEM code, 1: OEM code to Unicode */
+)
+{
+	(void)dir;		/* ASCII is identical in both directions */
+
+	return (chr < 0x80) ? chr : 0;
+}
+
+
+WCHAR ff_wtoupper (	/* Returns upper converted character */
+	WCHAR chr		/* Unicode character to be upper converted */
+)
+{
+	if (chr >= 0x61 && chr <= 0x7A) chr -= 0x20;
+
+	return chr;
+}
+
+#else
+
 #if _CODE_PAGE == 437
 #define _TBLDEF 1
 static
@@ -346,3 +372,5 @@ WCHAR ff_wtoupper (	/* Returns upper converted character */
 	return chr;
 }
 
+#endif	/* _CODE_PAGE == 1 */
+
@@ -308,10 +308,9 @@ typedef struct {
 				0xA9,0xAA,0xAC,0xAD,0xB5,0xB6,0xB7,0xB8,0xBD,0xBE,0xC6,0xC7,0xCF,0xCF,0xD0,0xEF, \
 				0xF0,0xF1,0xD1,0xD2,0xD3,0xF5,0xD4,0xF7,0xF8,0xF9,0xD5,0x96,0x95,0x98,0xFE,0xFF}
 
-#elif _CODE_PAGE == 1	/* ASCII (for only non-LFN cfg) */
-#if _USE_LFN
-#error Cannot use LFN feature without valid code page.
-#endif
+#elif _CODE_PAGE == 1	/* ASCII */
+/* LFN is supported through the table-free ASCII converters in ccsbcs.cpp,
+/  names are restricted to 7-bit characters */
 #define _DF1S	0
 
 #else
@@ -3554,6 +3553,72 @@ FRESULT f_truncate (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Allocate a Contiguous Block to the File                               */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_expand (
+	FIL* fp,	/* Pointer to the file object */
+	DWORD fsz	/* File size to be expanded to */
+)
+{
+	FRESULT res;
+	FATFS *fs;
+	DWORD n, clst, stcl, scl, ncl, tcl;
+
+
+	res = validate(fp);						/* Check validity of the object */
+	if (res != FR_OK) LEAVE_FF(fp->fs, res);
+	fs = fp->fs;
+	if (fp->err) LEAVE_FF(fs, (FRESULT)fp->err);
+	if (fsz == 0 || fp->fsize != 0 || !(fp->flag & FA_WRITE))
+		LEAVE_FF(fs, FR_DENIED);			/* Only an empty writable file can be expanded */
+	n = (DWORD)fs->csize * SS(fs);			/* Cluster size */
+	tcl = (fsz - 1) / n + 1;				/* Number of clusters required */
+	stcl = fs->last_clust;					/* Suggested start point of the search */
+	if (stcl < 2 || stcl >= fs->n_fatent) stcl = 2;
+
+	scl = clst = stcl; ncl = 0;
+	for (;;) {								/* Find a contiguous cluster block */
+		n = get_fat(fs, clst);
+		if (n == 1) { res = FR_INT_ERR; break; }
+		if (n == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
+		if (n == 0) {						/* Is it a free cluster? */
+			if (++ncl == tcl) break;		/* Contiguous cluster block found */
+		} else {
+			scl = clst + 1; ncl = 0;		/* Restart the run at the next cluster */
+		}
+		if (++clst >= fs->n_fatent) {		/* Wrap around the FAT; a run cannot cross it */
+			clst = 2; scl = 2; ncl = 0;
+		}
+		if (clst == stcl) { res = FR_DENIED; break; }	/* No contiguous block on the volume */
+	}
+
+	if (res == FR_OK) {						/* Create a cluster chain on the block */
+		for (clst = scl, n = tcl; n; clst++, n--) {
+			res = put_fat(fs, clst, (n == 1) ? 0x0FFFFFFF : clst + 1);
+			if (res != FR_OK) break;
+		}
+	}
+	if (res == FR_OK) {						/* Attach the block to the file */
+		fs->last_clust = scl + tcl - 1;		/* Suggested start for the next allocation */
+		fp->sclust = scl;
+		fp->fsize = fsz;
+		fp->flag |= FA__WRITTEN;
+		if (fs->free_clust != 0xFFFFFFFF && fs->free_clust >= tcl) {	/* Update FSINFO */
+			fs->free_clust -= tcl;
+			fs->fsi_flag |= 1;
+		}
+	} else {
+		if (res != FR_DENIED) fp->err = (BYTE)res;
+	}
+
+	LEAVE_FF(fs, res);
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Delete a File or Directory                                            */
 /*-----------------------------------------------------------------------*/
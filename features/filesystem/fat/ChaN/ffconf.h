@@ -45,7 +45,7 @@
 /* This option switches f_mkfs() function. (0:Disable or 1:Enable) */
 
 
-#define	_USE_FASTSEEK	0
+#define	_USE_FASTSEEK	1
 /* This option switches fast seek feature. (0:Disable or 1:Enable) */
 
 
@@ -63,11 +63,16 @@
 / Locale and Namespace Configurations
 /---------------------------------------------------------------------------*/
 
+#ifdef MBED_CONF_FILESYSTEM_FAT_CODE_PAGE
+#define _CODE_PAGE	MBED_CONF_FILESYSTEM_FAT_CODE_PAGE
+#else
 #define _CODE_PAGE	850
+#endif
 /* This option specifies the OEM code page to be used on the target system.
 /  Incorrect setting of the code page can cause a file open failure.
+/  Selectable at build time through the filesystem.fat-code-page config.
 /
-/   1   - ASCII (No extended character. Non-LFN cfg. only)
+/   1   - ASCII (7-bit names only, no conversion tables)
 /   437 - U.S.
 /   720 - Arabic
 /   737 - Greek
@@ -26,6 +26,7 @@
 #include "mbed_debug.h"
 #include "mbed_critical.h"
 #include <errno.h>
+#include <new>
 
 #include "FATFileSystem.h"
 
@@ -452,10 +453,33 @@ void FATFileSystem::unlock() {
 
 
 ////// File operations //////
+
+#ifndef MBED_CONF_FILESYSTEM_FAT_READ_AHEAD_SIZE
+#define MBED_CONF_FILESYSTEM_FAT_READ_AHEAD_SIZE 4096
+#endif
+
+/* File handle with an optional read-ahead buffer. For files opened with
+ * O_RDONLY | O_RDAHEAD sequential reads are served from the buffer, which
+ * is refilled with a single large f_read() so the block device sees one
+ * multi-sector read instead of one small read per cluster. fil.fptr then
+ * runs ahead of the position the caller sees; the logical position is
+ * fil.fptr - (ralen - rapos). */
+struct fat_file {
+    FIL fil;
+    uint8_t *rabuf;  /* read-ahead buffer, NULL when read-ahead is off */
+    size_t rasize;   /* size of rabuf */
+    size_t ralen;    /* valid bytes in rabuf */
+    size_t rapos;    /* next unconsumed byte in rabuf */
+};
+
 int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags) {
     debug_if(FFS_DBG, "open(%s) on filesystem [%s], drv [%s]\n", path, getName(), _id);
 
-    FIL *fh = new FIL;
+    fat_file *fh = new fat_file;
+    fh->rabuf = NULL;
+    fh->rasize = 0;
+    fh->ralen = 0;
+    fh->rapos = 0;
     Deferred<const char*> fpath = fat_path_prefix(_id, path);
 
     /* POSIX flags -> FatFS open mode */
@@ -476,7 +500,7 @@ int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags) {
     }
 
     lock();
-    FRESULT res = f_open(fh, fpath, openmode);
+    FRESULT res = f_open(&fh->fil, fpath, openmode);
 
     if (res != FR_OK) {
         unlock();
@@ -486,31 +510,81 @@ int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags) {
     }
 
     if (flags & O_APPEND) {
-        f_lseek(fh, fh->fsize);
+        f_lseek(&fh->fil, fh->fil.fsize);
     }
     unlock();
 
+    /* Read-ahead is only useful (and only safe, since writes and the
+     * buffer would disagree on the file position) for read-only files,
+     * the hint is ignored otherwise */
+    if ((flags & O_RDAHEAD) && !(flags & (O_RDWR | O_WRONLY))) {
+        fh->rabuf = new (std::nothrow) uint8_t[MBED_CONF_FILESYSTEM_FAT_READ_AHEAD_SIZE];
+        if (fh->rabuf) {
+            fh->rasize = MBED_CONF_FILESYSTEM_FAT_READ_AHEAD_SIZE;
+        }
+    }
+
     *file = fh;
     return 0;
 }
 
 int FATFileSystem::file_close(fs_file_t file) {
-    FIL *fh = static_cast<FIL*>(file);
+    fat_file *fh = static_cast<fat_file*>(file);
 
     lock();
-    FRESULT res = f_close(fh);
+    FRESULT res = f_close(&fh->fil);
     unlock();
 
+    delete[] fh->rabuf;
     delete fh;
     return fat_error_remap(res);
 }
 
 ssize_t FATFileSystem::file_read(fs_file_t file, void *buffer, size_t len) {
-    FIL *fh = static_cast<FIL*>(file);
+    fat_file *fh = static_cast<fat_file*>(file);
+    uint8_t *b = static_cast<uint8_t*>(buffer);
 
     lock();
     UINT n;
-    FRESULT res = f_read(fh, buffer, len, &n);
+    FRESULT res = FR_OK;
+
+    if (!fh->rabuf) {
+        res = f_read(&fh->fil, b, len, &n);
+    } else {
+        size_t total = 0;
+
+        while (total < len) {
+            size_t avail = fh->ralen - fh->rapos;
+            if (avail > 0) {
+                size_t chunk = len - total;
+                if (chunk > avail) {
+                    chunk = avail;
+                }
+                memcpy(b + total, fh->rabuf + fh->rapos, chunk);
+                fh->rapos += chunk;
+                total += chunk;
+                continue;
+            }
+
+            /* Buffer drained: requests at least as large as the buffer
+             * go straight through, smaller ones trigger a refill. Either
+             * way ff turns the contiguous span into multi-sector reads */
+            if (len - total >= fh->rasize) {
+                res = f_read(&fh->fil, b + total, len - total, &n);
+                total += n;
+                break;
+            }
+
+            res = f_read(&fh->fil, fh->rabuf, fh->rasize, &n);
+            fh->ralen = n;
+            fh->rapos = 0;
+            if (res != FR_OK || n == 0) {
+                break;
+            }
+        }
+
+        n = total;
+    }
     unlock();
 
     if (res != FR_OK) {
@@ -522,11 +596,11 @@ ssize_t FATFileSystem::file_read(fs_file_t file, void *buffer, size_t len) {
 }
 
 ssize_t FATFileSystem::file_write(fs_file_t file, const void *buffer, size_t len) {
-    FIL *fh = static_cast<FIL*>(file);
+    fat_file *fh = static_cast<fat_file*>(file);
 
     lock();
     UINT n;
-    FRESULT res = f_write(fh, buffer, len, &n);
+    FRESULT res = f_write(&fh->fil, buffer, len, &n);
     unlock();
 
     if (res != FR_OK) {
@@ -538,10 +612,10 @@ ssize_t FATFileSystem::file_write(fs_file_t file, const void *buffer, size_t len
 }
 
 int FATFileSystem::file_sync(fs_file_t file) {
-    FIL *fh = static_cast<FIL*>(file);
+    fat_file *fh = static_cast<fat_file*>(file);
 
     lock();
-    FRESULT res = f_sync(fh);
+    FRESULT res = f_sync(&fh->fil);
     unlock();
 
     if (res != FR_OK) {
@@ -551,17 +625,21 @@ int FATFileSystem::file_sync(fs_file_t file) {
 }
 
 off_t FATFileSystem::file_seek(fs_file_t file, off_t offset, int whence) {
-    FIL *fh = static_cast<FIL*>(file);
+    fat_file *fh = static_cast<fat_file*>(file);
 
     lock();
     if (whence == SEEK_END) {
-        offset += fh->fsize;
+        offset += fh->fil.fsize;
     } else if(whence==SEEK_CUR) {
-        offset += fh->fptr;
+        /* fptr runs ahead of the caller's position by what is still
+         * buffered, seek relative to the position the caller sees */
+        offset += fh->fil.fptr - (fh->ralen - fh->rapos);
     }
 
-    FRESULT res = f_lseek(fh, offset);
-    off_t noffset = fh->fptr;
+    FRESULT res = f_lseek(&fh->fil, offset);
+    off_t noffset = fh->fil.fptr;
+    fh->ralen = 0;
+    fh->rapos = 0;
     unlock();
 
     if (res != FR_OK) {
@@ -573,25 +651,161 @@ off_t FATFileSystem::file_seek(fs_file_t file, off_t offset, int whence) {
 }
 
 off_t FATFileSystem::file_tell(fs_file_t file) {
-    FIL *fh = static_cast<FIL*>(file);
+    fat_file *fh = static_cast<fat_file*>(file);
 
     lock();
-    off_t res = fh->fptr;
+    off_t res = fh->fil.fptr - (fh->ralen - fh->rapos);
     unlock();
 
     return res;
 }
 
 off_t FATFileSystem::file_size(fs_file_t file) {
-    FIL *fh = static_cast<FIL*>(file);
+    fat_file *fh = static_cast<fat_file*>(file);
 
     lock();
-    off_t res = fh->fsize;
+    off_t res = fh->fil.fsize;
     unlock();
 
     return res;
 }
 
+int FATFileSystem::file_mmap(fs_file_t file, off_t offset, size_t size, const void **addr) {
+    fat_file *fh = static_cast<fat_file*>(file);
+
+    lock();
+    /* Mapping a writable file would bypass its dirty sector cache */
+    if (fh->fil.flag & FA_WRITE) {
+        unlock();
+        return -EINVAL;
+    }
+
+    if (offset < 0 || size == 0 || (bd_size_t)offset + size > fh->fil.fsize) {
+        unlock();
+        return -EINVAL;
+    }
+
+    FATFS *fs = fh->fil.fs;
+#if _MAX_SS == _MIN_SS
+    bd_size_t ssize = _MIN_SS;
+#else
+    bd_size_t ssize = fs->ssize;
+#endif
+    DWORD bcs = (DWORD)fs->csize * ssize;
+
+    /* Walk the region's cluster chain to check that it is one contiguous
+     * extent on the device. Seeking to byte ci*bcs + 1 leaves fil.clust on
+     * cluster index ci of the file, and the forward walk follows the chain
+     * one step per cluster */
+    DWORD save = fh->fil.fptr;
+    DWORD ci0 = offset / bcs;
+    DWORD cin = (offset + size - 1) / bcs;
+    DWORD first = 0;
+    bool contiguous = true;
+
+    FRESULT res = FR_OK;
+    for (DWORD ci = ci0; ci <= cin && contiguous; ci++) {
+        res = f_lseek(&fh->fil, ci * bcs + 1);
+        if (res != FR_OK) {
+            break;
+        }
+        if (ci == ci0) {
+            first = fh->fil.clust;
+        } else if (fh->fil.clust != first + (ci - ci0)) {
+            contiguous = false;
+        }
+    }
+
+    FRESULT rres = f_lseek(&fh->fil, save);
+    unlock();
+
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "f_lseek() failed: %d\n", res);
+        return fat_error_remap(res);
+    }
+    if (rres != FR_OK) {
+        return fat_error_remap(rres);
+    }
+    if (!contiguous) {
+        return -ENODEV;
+    }
+
+    /* Resolve the first cluster to a device address and ask the block
+     * device for a directly readable pointer */
+    bd_addr_t sect = (bd_addr_t)fs->database + (bd_addr_t)(first - 2) * fs->csize;
+    bd_addr_t daddr = sect * ssize + ((bd_addr_t)offset - (bd_addr_t)ci0 * bcs);
+
+    const void *p = _ffs[_id]->map(daddr, size);
+    if (!p) {
+        return -ENODEV;
+    }
+
+    *addr = p;
+    return 0;
+}
+
+int FATFileSystem::file_allocate(fs_file_t file, off_t size) {
+    fat_file *fh = static_cast<fat_file*>(file);
+
+    if (size <= 0) {
+        return -EINVAL;
+    }
+
+    lock();
+    if (!(fh->fil.flag & FA_WRITE) || (fh->fil.fsize != 0)) {
+        unlock();
+        return -EINVAL;
+    }
+    FRESULT res = f_expand(&fh->fil, (DWORD)size);
+    unlock();
+
+    if (res == FR_DENIED) {
+        /* Preconditions were checked above, so denial means the volume has
+         * no contiguous run of free clusters large enough */
+        debug_if(FFS_DBG, "f_expand() found no contiguous run for %d bytes\n", (int)size);
+        return -ENOSPC;
+    }
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "f_expand() failed: %d\n", res);
+    }
+    return fat_error_remap(res);
+}
+
+int FATFileSystem::file_seekmap(fs_file_t file, uint32_t *table, size_t count) {
+    fat_file *fh = static_cast<fat_file*>(file);
+
+    lock();
+    if (!table) {
+        /* Detach the map, seeks go back to walking the FAT */
+        fh->fil.cltbl = NULL;
+        unlock();
+        return 0;
+    }
+
+    /* Growing a file through f_write ignores the map, so only allow it
+     * on files opened for reading */
+    if ((fh->fil.flag & FA_WRITE) || (count < 1)) {
+        unlock();
+        return -EINVAL;
+    }
+
+    /* f_lseek fills the table with (length, start cluster) fragment
+     * pairs; the first entry carries the table size in and the used
+     * entry count out */
+    table[0] = (uint32_t)count;
+    fh->fil.cltbl = (DWORD*)table;
+    FRESULT res = f_lseek(&fh->fil, CREATE_LINKMAP);
+    if (res != FR_OK) {
+        fh->fil.cltbl = NULL;
+    }
+    unlock();
+
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "f_lseek(CREATE_LINKMAP) failed: %d\n", res);
+    }
+    return fat_error_remap(res);
+}
+
 
 ////// Dir operations //////
 int FATFileSystem::dir_open(fs_dir_t *dir, const char *path) {
@@ -656,6 +870,61 @@ ssize_t FATFileSystem::dir_read(fs_dir_t dir, struct dirent *ent) {
     return 1;
 }
 
+ssize_t FATFileSystem::dir_read(fs_dir_t dir, struct dirent *ents, struct stat *sts, size_t count) {
+    FATFS_DIR *dh = static_cast<FATFS_DIR*>(dir);
+    size_t n = 0;
+
+    lock();
+    while (n < count) {
+        struct dirent *ent = &ents[n];
+        FILINFO finfo;
+
+#if _USE_LFN
+        finfo.lfname = ent->d_name;
+        finfo.lfsize = NAME_MAX;
+#endif // _USE_LFN
+
+        FRESULT res = f_readdir(dh, &finfo);
+        if (res != FR_OK) {
+            unlock();
+            /* Entries already read are still valid, the error shows up
+             * again on the next batch */
+            return n ? (ssize_t)n : fat_error_remap(res);
+        } else if (finfo.fname[0] == 0) {
+            break;
+        }
+
+        ent->d_type = (finfo.fattrib & AM_DIR) ? DT_DIR : DT_REG;
+
+#if _USE_LFN
+        if (ent->d_name[0] == 0) {
+            // No long filename so use short filename.
+            strncpy(ent->d_name, finfo.fname, NAME_MAX);
+        }
+#else
+        strncpy(ent->d_name, finfo.fname, NAME_MAX);
+#endif
+
+        if (sts) {
+            /* Same info a stat() would return, without the path walk */
+            struct stat *st = &sts[n];
+#ifdef TOOLCHAIN_GCC
+            st->st_size = finfo.fsize;
+            st->st_mode = 0;
+            st->st_mode |= (finfo.fattrib & AM_DIR) ? S_IFDIR : S_IFREG;
+            st->st_mode |= (finfo.fattrib & AM_RDO) ?
+                (S_IRUSR | S_IXUSR | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) :
+                (S_IRWXU | S_IRWXG | S_IRWXO);
+#endif /* TOOLCHAIN_GCC */
+        }
+
+        n++;
+    }
+    unlock();
+
+    return n;
+}
+
 void FATFileSystem::dir_seek(fs_dir_t dir, off_t offset) {
     FATFS_DIR *dh = static_cast<FATFS_DIR*>(dir);
 
@@ -145,7 +145,10 @@ protected:
      *  @param file     Destination for the handle to a newly created file
      *  @param path     The name of the file to open
      *  @param flags    The flags to open the file in, one of O_RDONLY, O_WRONLY, O_RDWR,
-     *                  bitwise or'd with one of O_CREAT, O_TRUNC, O_APPEND
+     *                  bitwise or'd with one of O_CREAT, O_TRUNC, O_APPEND.
+     *                  O_RDONLY may additionally be or'd with O_RDAHEAD to
+     *                  enable read-ahead buffering for sequential reads,
+     *                  sized by the filesystem.fat-read-ahead-size config
      *  @return         0 on success, negative error code on failure
      */
     virtual int file_open(fs_file_t *file, const char *path, int flags);
@@ -208,6 +211,51 @@ protected:
      */
     virtual off_t file_size(fs_file_t file);
 
+    /** Map a region of the file for zero-copy reading
+     *
+     *  Succeeds when the region occupies consecutive clusters and the
+     *  underlying block device is directly addressable, fails with
+     *  -ENODEV otherwise. The file must be open read-only.
+     *
+     *  @param file     File handle
+     *  @param offset   Offset in the file of the region to map
+     *  @param size     Size of the region to map in bytes
+     *  @param addr     Destination for the address of the mapped region
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_mmap(fs_file_t file, off_t offset, size_t size, const void **addr);
+
+    /** Preallocate space for the file as one contiguous cluster run
+     *
+     *  Searches the FAT for a contiguous run of free clusters covering
+     *  size bytes and links it to the file in one pass, so streaming
+     *  writes follow the premade chain on sequential sectors instead of
+     *  walking the FAT for a free cluster as the file grows. Fails with
+     *  -ENOSPC when no contiguous run is large enough. The file must be
+     *  open for writing and still empty.
+     *
+     *  @param file     File handle
+     *  @param size     Number of bytes to preallocate
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_allocate(fs_file_t file, off_t size);
+
+    /** Attach a cluster link map table for fast random seeks
+     *
+     *  Walks the file's cluster chain once and records its fragments in
+     *  the caller's table (FatFs CLMT format), after which f_lseek
+     *  resolves any offset from the table instead of chasing FAT links
+     *  from the start of the file. The file must be open read-only. The
+     *  table must stay valid until the file is closed or the map is
+     *  detached by passing a NULL table.
+     *
+     *  @param file     File handle
+     *  @param table    Table for the map, or NULL to detach the map
+     *  @param count    Number of uint32_t entries in the table
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_seekmap(fs_file_t file, uint32_t *table, size_t count);
+
     /** Open a directory on the filesystem
      *
      *  @param dir      Destination for the handle to the directory
@@ -231,6 +279,22 @@ protected:
      */
     virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ent);
 
+    /** Read a batch of directory entries with their stat info
+     *
+     *  The stat info comes straight from the FAT directory entries, so a
+     *  batch costs one pass over the directory's cluster chain instead of
+     *  one path lookup from the root per file.
+     *
+     *  @param dir      Dir handle
+     *  @param ents     Array of count directory entries to fill out
+     *  @param sts      Array of count stat structures to fill out, may be
+     *                  NULL if the stat info is not needed
+     *  @param count    Number of entries to read
+     *  @return         Number of entries read, 0 at end of directory,
+     *                  negative error on failure
+     */
+    virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ents, struct stat *sts, size_t count);
+
     /** Set the current position of the directory
      *
      *  @param dir      Dir handle
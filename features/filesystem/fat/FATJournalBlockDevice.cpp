@@ -0,0 +1,386 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FATJournalBlockDevice.h"
+#include <string.h>
+
+/* "MFJ1" - identifies a committed journal record */
+static const uint32_t FJ_MAGIC = 0x314a464d;
+/* Record carries a full sector image after the header */
+static const uint32_t FJ_TYPE_DATA = 1;
+/* Record marks the home copy of the sector as current again */
+static const uint32_t FJ_TYPE_INVALIDATE = 2;
+/* On-flash header size, rounded up to the program size at init */
+static const bd_size_t FJ_HEADER_SIZE = 16;
+
+static const bd_addr_t FJ_NO_PENDING = (bd_addr_t)-1;
+
+
+FATJournalBlockDevice::FATJournalBlockDevice(BlockDevice *bd,
+                                             bd_size_t journal_units)
+    : _bd(bd)
+    , _journal_units(journal_units)
+    , _sector_size(0)
+    , _hdr_size(0)
+    , _journal_addr(0)
+    , _journal_size(0)
+    , _journal_off(0)
+    , _map(0)
+    , _map_count(0)
+    , _map_capacity(0)
+    , _scratch(0)
+    , _pending_erase(FJ_NO_PENDING)
+    , _pending_size(0)
+{
+}
+
+FATJournalBlockDevice::~FATJournalBlockDevice()
+{
+    deinit();
+}
+
+int FATJournalBlockDevice::init()
+{
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    bd_size_t unit = _bd->get_erase_size();
+    bd_size_t prog = _bd->get_program_size();
+
+    // Match the sector size the FAT driver derives from the device
+    _sector_size = (unit < 512) ? 512 : unit;
+    _hdr_size = ((FJ_HEADER_SIZE + prog - 1) / prog) * prog;
+    _journal_size = _journal_units * unit;
+    _journal_addr = _bd->size() - _journal_size;
+
+    if (unit % prog != 0 ||
+        prog % _bd->get_read_size() != 0 ||
+        _sector_size % unit != 0 ||
+        _journal_size < 2 * (_hdr_size + _sector_size) ||
+        _journal_size >= _bd->size()) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!_map) {
+        _map_capacity = _journal_size / (_hdr_size + _sector_size) + 1;
+        _map = new map_entry[_map_capacity];
+        _scratch = new uint8_t[_sector_size];
+    }
+
+    _map_count = 0;
+    _journal_off = 0;
+    _pending_erase = FJ_NO_PENDING;
+
+    // Replay records left by a power loss, then reset the journal so the
+    // whole region is erased and ready for appending
+    err = replay();
+    if (err) {
+        return err;
+    }
+    return checkpoint();
+}
+
+int FATJournalBlockDevice::deinit()
+{
+    if (_map) {
+        int err = sync();
+        if (err) {
+            return err;
+        }
+
+        delete[] _map;
+        delete[] _scratch;
+        _map = 0;
+        _scratch = 0;
+    }
+
+    return _bd->deinit();
+}
+
+FATJournalBlockDevice::map_entry *FATJournalBlockDevice::find_sector(bd_addr_t home)
+{
+    for (bd_size_t i = 0; i < _map_count; i++) {
+        if (_map[i].home == home) {
+            return &_map[i];
+        }
+    }
+
+    return 0;
+}
+
+int FATJournalBlockDevice::replay()
+{
+    while (_journal_off + _hdr_size <= _journal_size) {
+        record_header hdr;
+        int err = _bd->read(_scratch, _journal_addr + _journal_off, _hdr_size);
+        if (err) {
+            return err;
+        }
+        memcpy(&hdr, _scratch, sizeof(record_header));
+
+        bd_addr_t home = (bd_addr_t)hdr.sector * _sector_size;
+        if (hdr.magic != FJ_MAGIC || home + _sector_size > size()) {
+            break;
+        }
+
+        if (hdr.type == FJ_TYPE_DATA) {
+            if (_journal_off + _hdr_size + _sector_size > _journal_size) {
+                break;
+            }
+
+            map_entry *entry = find_sector(home);
+            if (!entry) {
+                entry = &_map[_map_count++];
+                entry->home = home;
+            }
+            entry->data = _journal_addr + _journal_off + _hdr_size;
+            _journal_off += _hdr_size + _sector_size;
+        } else if (hdr.type == FJ_TYPE_INVALIDATE) {
+            map_entry *entry = find_sector(home);
+            if (entry) {
+                *entry = _map[--_map_count];
+            }
+            _journal_off += _hdr_size;
+        } else {
+            break;
+        }
+    }
+
+    return 0;
+}
+
+int FATJournalBlockDevice::write_home(bd_addr_t home, bd_addr_t data)
+{
+    int err = _bd->read(_scratch, data, _sector_size);
+    if (err) {
+        return err;
+    }
+
+    err = _bd->erase(home, _sector_size);
+    if (err) {
+        return err;
+    }
+
+    return _bd->program(_scratch, home, _sector_size);
+}
+
+int FATJournalBlockDevice::checkpoint()
+{
+    for (bd_size_t i = 0; i < _map_count; i++) {
+        int err = write_home(_map[i].home, _map[i].data);
+        if (err) {
+            return err;
+        }
+    }
+
+    // The journal stays intact until every sector image is home, so a
+    // power loss during the checkpoint just replays it again
+    int err = _bd->erase(_journal_addr, _journal_size);
+    if (err) {
+        return err;
+    }
+
+    _map_count = 0;
+    _journal_off = 0;
+    return 0;
+}
+
+int FATJournalBlockDevice::append_record(bd_addr_t home, const uint8_t *data)
+{
+    if (_journal_off + _hdr_size + _sector_size > _journal_size) {
+        int err = checkpoint();
+        if (err) {
+            return err;
+        }
+    }
+
+    // Data first, header last: the record only exists once its header
+    // lands, so a torn append is ignored on replay
+    int err = _bd->program(data, _journal_addr + _journal_off + _hdr_size,
+                           _sector_size);
+    if (err) {
+        return err;
+    }
+
+    record_header hdr;
+    hdr.magic = FJ_MAGIC;
+    hdr.type = FJ_TYPE_DATA;
+    hdr.sector = (uint32_t)(home / _sector_size);
+    hdr.pad = 0xffffffff;
+
+    memset(_scratch, 0xff, static_cast<size_t>(_hdr_size));
+    memcpy(_scratch, &hdr, sizeof(record_header));
+    err = _bd->program(_scratch, _journal_addr + _journal_off, _hdr_size);
+    if (err) {
+        return err;
+    }
+
+    map_entry *entry = find_sector(home);
+    if (!entry) {
+        entry = &_map[_map_count++];
+        entry->home = home;
+    }
+    entry->data = _journal_addr + _journal_off + _hdr_size;
+    _journal_off += _hdr_size + _sector_size;
+    return 0;
+}
+
+int FATJournalBlockDevice::invalidate_sector(bd_addr_t home)
+{
+    if (!find_sector(home)) {
+        return 0;
+    }
+
+    if (_journal_off + _hdr_size > _journal_size) {
+        // Checkpointing empties the map, nothing left to invalidate
+        return checkpoint();
+    }
+
+    record_header hdr;
+    hdr.magic = FJ_MAGIC;
+    hdr.type = FJ_TYPE_INVALIDATE;
+    hdr.sector = (uint32_t)(home / _sector_size);
+    hdr.pad = 0xffffffff;
+
+    memset(_scratch, 0xff, static_cast<size_t>(_hdr_size));
+    memcpy(_scratch, &hdr, sizeof(record_header));
+    int err = _bd->program(_scratch, _journal_addr + _journal_off, _hdr_size);
+    if (err) {
+        return err;
+    }
+
+    _journal_off += _hdr_size;
+    map_entry *entry = find_sector(home);
+    *entry = _map[--_map_count];
+    return 0;
+}
+
+int FATJournalBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_read(addr, size));
+    uint8_t *b = static_cast<uint8_t *>(buffer);
+
+    while (size > 0) {
+        bd_addr_t home = addr - (addr % _sector_size);
+        bd_size_t off = addr - home;
+        bd_size_t n = _sector_size - off;
+        if (n > size) {
+            n = size;
+        }
+
+        map_entry *entry = find_sector(home);
+        bd_addr_t src = entry ? entry->data + off : addr;
+        int err = _bd->read(b, src, n);
+        if (err) {
+            return err;
+        }
+
+        b += n;
+        addr += n;
+        size -= n;
+    }
+
+    return 0;
+}
+
+int FATJournalBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_program(addr, size));
+    const uint8_t *b = static_cast<const uint8_t *>(buffer);
+
+    // Single-sector rewrites - FAT, directory and tail data sectors
+    // flushed by f_sync - append to the journal
+    if (size == _sector_size && addr % _sector_size == 0) {
+        if (_pending_erase == addr) {
+            _pending_erase = FJ_NO_PENDING;
+        }
+        return append_record(addr, b);
+    }
+
+    // Bulk writes go in place: honour a deferred erase first, and mark
+    // stale journal copies so replay cannot resurrect them
+    if (_pending_erase != FJ_NO_PENDING &&
+        addr < _pending_erase + _pending_size && addr + size > _pending_erase) {
+        int err = _bd->erase(_pending_erase, _pending_size);
+        if (err) {
+            return err;
+        }
+        _pending_erase = FJ_NO_PENDING;
+    }
+
+    for (bd_addr_t home = addr - (addr % _sector_size);
+         home < addr + size; home += _sector_size) {
+        int err = invalidate_sector(home);
+        if (err) {
+            return err;
+        }
+    }
+
+    return _bd->program(b, addr, size);
+}
+
+int FATJournalBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+
+    // A single-sector erase precedes a single-sector rewrite, which will
+    // be journaled: defer it so the home sector is not cycled
+    if (size == _sector_size) {
+        _pending_erase = addr;
+        _pending_size = size;
+        return 0;
+    }
+
+    for (bd_addr_t home = addr; home < addr + size; home += _sector_size) {
+        int err = invalidate_sector(home);
+        if (err) {
+            return err;
+        }
+    }
+
+    return _bd->erase(addr, size);
+}
+
+int FATJournalBlockDevice::sync()
+{
+    if (_map_count == 0 && _journal_off == 0) {
+        return 0;
+    }
+
+    return checkpoint();
+}
+
+bd_size_t FATJournalBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t FATJournalBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t FATJournalBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t FATJournalBlockDevice::size() const
+{
+    return _bd->size() - _journal_units * _bd->get_erase_size();
+}
@@ -0,0 +1,202 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_FAT_JOURNAL_BLOCK_DEVICE_H
+#define MBED_FAT_JOURNAL_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+#include "mbed.h"
+
+
+/** Sector journal for cheap, power-fail-safe FATFileSystem syncs
+ *
+ *  FATFileSystem rewrites full FAT and directory sectors in place on
+ *  every f_sync - an erase plus program cycle per sector per sync, which
+ *  dominates when small appends are synced frequently for power-fail
+ *  safety. Mounted between the filesystem and the storage, this device
+ *  turns those rewrites into appends: the single-sector erase is
+ *  deferred and the new sector image is appended to a reserved,
+ *  pre-erased journal region at the end of the device, committed by a
+ *  small header programmed after the data. In-place erases and programs
+ *  of the hot sectors only happen when the journal fills and its latest
+ *  sector images are checkpointed home, so they amortize across many
+ *  syncs.
+ *
+ *  A sync is durable once the record header lands: after power loss the
+ *  journal is replayed on the next init(), writing the newest image of
+ *  each sector back to its home location. A torn record has no valid
+ *  header and is ignored. Multi-sector writes - bulk file data - bypass
+ *  the journal and go in place at full speed.
+ *
+ *  The journal region is taken from the end of the device, so the
+ *  presented size shrinks by journal_units erase units. Format the
+ *  filesystem through this device, not the raw one.
+ *
+ *  @code
+ *  #include "mbed.h"
+ *  #include "SPIFBlockDevice.h"
+ *  #include "FATJournalBlockDevice.h"
+ *  #include "FATFileSystem.h"
+ *
+ *  SPIFBlockDevice spif(PTE2, PTE4, PTE1, PTE5);
+ *  FATJournalBlockDevice journal(&spif);
+ *  FATFileSystem fs("fs", &journal);
+ *
+ *  // frequent small appends: each sync appends to the journal instead
+ *  // of rewriting the FAT and directory sectors in place
+ *  @endcode
+ */
+class FATJournalBlockDevice : public BlockDevice
+{
+public:
+    /** Lifetime of the block device
+     *
+     *  @param bd             Block device to journal
+     *  @param journal_units  Number of erase units reserved for the
+     *                        journal region
+     */
+    FATJournalBlockDevice(BlockDevice *bd, bd_size_t journal_units = 16);
+
+    /** Lifetime of a block device
+     */
+    virtual ~FATJournalBlockDevice();
+
+    /** Initialize a block device and replay the journal
+     *
+     *  Sector images left in the journal by a power loss are written
+     *  back to their home locations before the device is presented.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  Checkpoints the journal so all data is in its home location.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Read blocks from a block device
+     *
+     *  Sectors with a newer image in the journal are read from there.
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  Single-sector programs are appended to the journal; larger
+     *  programs go to their home location.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  Single-sector erases are deferred: the sector is rewritten
+     *  through the journal instead of in place.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Checkpoint the journal
+     *
+     *  Writes the latest journaled sector images to their home
+     *  locations and resets the journal region.
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    int sync();
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programable block
+     *
+     *  @return         Size of a programable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of a eraseable block
+     *
+     *  @return         Size of a eraseable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the total size of the device, excluding the journal region
+     *
+     *  @return         Size of the device in bytes
+     */
+    virtual bd_size_t size() const;
+
+private:
+    struct record_header {
+        uint32_t magic;
+        uint32_t type;
+        uint32_t sector;
+        uint32_t pad;
+    };
+
+    struct map_entry {
+        bd_addr_t home;
+        bd_addr_t data;
+    };
+
+    map_entry *find_sector(bd_addr_t home);
+    int append_record(bd_addr_t home, const uint8_t *data);
+    int invalidate_sector(bd_addr_t home);
+    int write_home(bd_addr_t home, bd_addr_t data);
+    int checkpoint();
+    int replay();
+
+    BlockDevice *_bd;
+    bd_size_t _journal_units;
+    bd_size_t _sector_size;
+    bd_size_t _hdr_size;
+    bd_addr_t _journal_addr;
+    bd_size_t _journal_size;
+    bd_size_t _journal_off;
+    map_entry *_map;
+    bd_size_t _map_count;
+    bd_size_t _map_capacity;
+    uint8_t *_scratch;
+    bd_addr_t _pending_erase;
+    bd_size_t _pending_size;
+};
+
+
+#endif
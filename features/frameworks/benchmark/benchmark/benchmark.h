@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/Callback.h"
+
+#ifndef MBED_CONF_BENCHMARK_MAX_ITERATIONS
+#define MBED_CONF_BENCHMARK_MAX_ITERATIONS 64
+#endif
+
+/** On-target micro benchmark with warmup, per-iteration samples and a
+ * machine-readable report.
+ *
+ * The measured quantity is CPU cycles from the DWT cycle counter on
+ * cores that have one (Cortex-M3 and up), microseconds from the us
+ * ticker otherwise; unit() says which. The timer read-pair overhead is
+ * calibrated once and subtracted from every sample.
+ *
+ * report() emits one greentea key-value pair per benchmark:
+ *
+ *     {{benchmark;<name>;<unit>;<iterations>;<min>;<median>;<p99>;<max>}}
+ *
+ * which the host log archives verbatim, giving CI a stable record to
+ * diff between runs. For an on-target regression gate, pair within()
+ * with a unity assertion:
+ *
+ * @code
+ * Benchmark bench("memcpy_1k");
+ * bench.run(callback(do_memcpy));
+ * bench.report();
+ * TEST_ASSERT_TRUE(bench.within(BASELINE_MEMCPY_1K, 25));
+ * @endcode
+ *
+ * A baseline of 0 disables the gate, so suites run and report before a
+ * baseline has been recorded.
+ */
+class Benchmark {
+public:
+    /** Create a benchmark
+     *
+     * @param name       Short identifier, no semicolons
+     * @param iterations Number of measured iterations, capped at
+     *                   MBED_CONF_BENCHMARK_MAX_ITERATIONS
+     * @param warmup     Unmeasured iterations run first, to fill caches
+     *                   and train branch predictors
+     */
+    Benchmark(const char *name,
+              uint32_t iterations = MBED_CONF_BENCHMARK_MAX_ITERATIONS,
+              uint32_t warmup = 8);
+
+    /** Run the benchmark: warmup, then one timed call per iteration */
+    void run(mbed::Callback<void()> func);
+
+    /** Read the benchmark timer, for manually sampled benchmarks
+     *
+     * Useful when the interval does not fit a callback - for instance
+     * from an interrupt handler timestamping the start of a wakeup
+     * latency measurement.
+     *
+     * @return The current time in unit()
+     */
+    static uint32_t read_timer();
+
+    /** Record one externally measured sample
+     *
+     * Ignored once the sample buffer is full. Call complete() after the
+     * last sample and before reading any statistic.
+     *
+     * @param sample The measured interval in unit()
+     */
+    void add_sample(uint32_t sample);
+
+    /** Finish a manually sampled benchmark by sorting its samples */
+    void complete();
+
+    /** Number of recorded samples */
+    uint32_t iterations() const;
+
+    /** Fastest iteration */
+    uint32_t minimum() const;
+
+    /** Slowest iteration */
+    uint32_t maximum() const;
+
+    /** Median iteration */
+    uint32_t median() const;
+
+    /** 99th percentile iteration */
+    uint32_t percentile99() const;
+
+    /** Unit of every sample: "cycles" or "us" */
+    const char *unit() const;
+
+    /** Send the machine-readable result record to the host */
+    void report() const;
+
+    /** Check the median against a recorded baseline
+     *
+     * @param baseline  Baseline median, in unit(); 0 means no baseline
+     *                  yet, which always passes
+     * @param tolerance_percent Allowed regression over the baseline
+     * @return true when within the baseline (or no baseline is set)
+     */
+    bool within(uint32_t baseline, uint32_t tolerance_percent) const;
+
+private:
+    static void timer_init();
+    static uint32_t timer_read();
+    void sort_samples();
+
+    const char *_name;
+    uint32_t _iterations;
+    uint32_t _warmup;
+    uint32_t _count;
+    uint32_t _overhead;
+    uint32_t _samples[MBED_CONF_BENCHMARK_MAX_ITERATIONS]; /**< Sorted ascending after run() */
+};
+
+#endif // BENCHMARK_H
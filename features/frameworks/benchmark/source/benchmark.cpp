@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "greentea-client/test_env.h"
+
+#include <stdio.h>
+
+#ifdef TARGET_LIKE_MBED
+#include "cmsis.h"
+#endif
+
+#if defined(__CORTEX_M) && (__CORTEX_M >= 3)
+#define BENCHMARK_USE_DWT 1
+#else
+#define BENCHMARK_USE_DWT 0
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#endif
+
+void Benchmark::timer_init()
+{
+#if BENCHMARK_USE_DWT
+    // Enable once; re-zeroing CYCCNT would corrupt in-flight manual samples
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+}
+
+uint32_t Benchmark::timer_read()
+{
+#if BENCHMARK_USE_DWT
+    return DWT->CYCCNT;
+#else
+    return (uint32_t)ticker_read_us(get_us_ticker_data());
+#endif
+}
+
+Benchmark::Benchmark(const char *name, uint32_t iterations, uint32_t warmup)
+    : _name(name), _iterations(iterations), _warmup(warmup), _count(0), _overhead(0)
+{
+    if (_iterations > MBED_CONF_BENCHMARK_MAX_ITERATIONS) {
+        _iterations = MBED_CONF_BENCHMARK_MAX_ITERATIONS;
+    }
+    if (_iterations == 0) {
+        _iterations = 1;
+    }
+
+    timer_init();
+
+    // Calibrate the cost of an empty measurement so samples only carry
+    // the workload itself
+    _overhead = (uint32_t)-1;
+    for (int i = 0; i < 16; i++) {
+        uint32_t start = timer_read();
+        uint32_t stop = timer_read();
+        if (stop - start < _overhead) {
+            _overhead = stop - start;
+        }
+    }
+}
+
+void Benchmark::run(mbed::Callback<void()> func)
+{
+    for (uint32_t i = 0; i < _warmup; i++) {
+        func();
+    }
+
+    for (uint32_t i = 0; i < _iterations; i++) {
+        uint32_t start = timer_read();
+        func();
+        uint32_t stop = timer_read();
+        uint32_t sample = stop - start;
+        _samples[i] = (sample > _overhead) ? (sample - _overhead) : 0;
+    }
+    _count = _iterations;
+    sort_samples();
+}
+
+uint32_t Benchmark::read_timer()
+{
+    timer_init();
+    return timer_read();
+}
+
+void Benchmark::add_sample(uint32_t sample)
+{
+    if (_count < _iterations) {
+        _samples[_count++] = sample;
+    }
+}
+
+void Benchmark::complete()
+{
+    sort_samples();
+}
+
+void Benchmark::sort_samples()
+{
+    // Insertion sort; sample counts are small
+    for (uint32_t i = 1; i < _count; i++) {
+        uint32_t value = _samples[i];
+        uint32_t j = i;
+        while (j > 0 && _samples[j - 1] > value) {
+            _samples[j] = _samples[j - 1];
+            j--;
+        }
+        _samples[j] = value;
+    }
+}
+
+uint32_t Benchmark::iterations() const
+{
+    return _count;
+}
+
+uint32_t Benchmark::minimum() const
+{
+    return (_count > 0) ? _samples[0] : 0;
+}
+
+uint32_t Benchmark::maximum() const
+{
+    return (_count > 0) ? _samples[_count - 1] : 0;
+}
+
+uint32_t Benchmark::median() const
+{
+    return (_count > 0) ? _samples[_count / 2] : 0;
+}
+
+uint32_t Benchmark::percentile99() const
+{
+    if (_count == 0) {
+        return 0;
+    }
+    uint32_t index = (_count * 99) / 100;
+    if (index >= _count) {
+        index = _count - 1;
+    }
+    return _samples[index];
+}
+
+const char *Benchmark::unit() const
+{
+#if BENCHMARK_USE_DWT
+    return "cycles";
+#else
+    return "us";
+#endif
+}
+
+void Benchmark::report() const
+{
+    char record[128];
+    snprintf(record, sizeof(record), "%s;%s;%lu;%lu;%lu;%lu;%lu",
+             _name, unit(),
+             (unsigned long)iterations(),
+             (unsigned long)minimum(),
+             (unsigned long)median(),
+             (unsigned long)percentile99(),
+             (unsigned long)maximum());
+    greentea_send_kv("benchmark", record);
+}
+
+bool Benchmark::within(uint32_t baseline, uint32_t tolerance_percent) const
+{
+    if (baseline == 0) {
+        return true;
+    }
+    uint64_t ceiling = (uint64_t)baseline + ((uint64_t)baseline * tolerance_percent) / 100;
+    return (uint64_t)median() <= ceiling;
+}
@@ -23,6 +23,10 @@
 #include "greentea-client/greentea_serial.h"
 #include "greentea-client/greentea_metrics.h"
 
+#ifndef MBED_CONF_GREENTEA_CLIENT_BINARY_TRANSPORT
+#define MBED_CONF_GREENTEA_CLIENT_BINARY_TRANSPORT 0
+#endif
+
 
 /**
  *   Generic test suite transport protocol keys
@@ -282,6 +286,90 @@ inline void greentea_write_int(const int val)
     }
 }
 
+#if MBED_CONF_GREENTEA_CLIENT_BINARY_TRANSPORT
+
+/**
+ *****************************************************************************
+ *  Binary framed transport (DUT to host direction only)
+ *****************************************************************************
+ *
+ *  Key-value messages are sent as length-prefixed binary records instead of
+ *  the plain-text "{{key;value}}\r\n" framing:
+ *
+ *      0x01                      start of record (SOH)
+ *      len_lo len_hi             16-bit little-endian payload length
+ *      payload                   "key;value[;value...]", not NUL terminated
+ *
+ *  The payload keeps the semicolon-separated layout of the text protocol, so
+ *  a host-side decoder only needs to strip the 3-byte header and reuse its
+ *  existing key-value split. Records are assembled in full before any byte
+ *  hits the wire, so the bytes of one record are emitted back-to-back and a
+ *  record boundary can never interleave with stray application output. The
+ *  host-to-DUT direction stays textual: traffic from the host is a handful
+ *  of messages per suite and greentea_parse_kv() remains unchanged.
+ */
+
+#define GREENTEA_RECORD_SOH         0x01
+#define GREENTEA_RECORD_PAYLOAD_MAX 160
+
+static void greentea_write_record(const char *payload, size_t len)
+{
+    greentea_serial->putc(GREENTEA_RECORD_SOH);
+    greentea_serial->putc(len & 0xff);
+    greentea_serial->putc((len >> 8) & 0xff);
+    for (size_t i = 0; i < len; i++) {
+        greentea_serial->putc(payload[i]);
+    }
+}
+
+static void greentea_send_record(const char *record, int len)
+{
+    if (len < 0) {
+        return;
+    }
+    if (len >= GREENTEA_RECORD_PAYLOAD_MAX) {
+        len = GREENTEA_RECORD_PAYLOAD_MAX - 1; /* snprintf truncated */
+    }
+    greentea_write_record(record, len);
+}
+
+extern "C" void greentea_send_kv(const char *key, const char *val) {
+    if (key && val) {
+        char record[GREENTEA_RECORD_PAYLOAD_MAX];
+        greentea_send_record(record, snprintf(record, sizeof(record), "%s;%s", key, val));
+    }
+}
+
+void greentea_send_kv(const char *key, const int val) {
+    if (key) {
+        char record[GREENTEA_RECORD_PAYLOAD_MAX];
+        greentea_send_record(record, snprintf(record, sizeof(record), "%s;%d", key, val));
+    }
+}
+
+void greentea_send_kv(const char *key, const char *val, const int result) {
+    if (key) {
+        char record[GREENTEA_RECORD_PAYLOAD_MAX];
+        greentea_send_record(record, snprintf(record, sizeof(record), "%s;%s;%d", key, val, result));
+    }
+}
+
+void greentea_send_kv(const char *key, const char *val, const int passes, const int failures) {
+    if (key) {
+        char record[GREENTEA_RECORD_PAYLOAD_MAX];
+        greentea_send_record(record, snprintf(record, sizeof(record), "%s;%s;%d;%d", key, val, passes, failures));
+    }
+}
+
+void greentea_send_kv(const char *key, const int passes, const int failures) {
+    if (key) {
+        char record[GREENTEA_RECORD_PAYLOAD_MAX];
+        greentea_send_record(record, snprintf(record, sizeof(record), "%s;%d;%d", key, passes, failures));
+    }
+}
+
+#else /* !MBED_CONF_GREENTEA_CLIENT_BINARY_TRANSPORT */
+
 /**
  * \brief Encapsulate and send key-value message from DUT to host
  *
@@ -418,6 +506,8 @@ void greentea_send_kv(const char *key, const int passes, const int failures) {
     }
 }
 
+#endif /* MBED_CONF_GREENTEA_CLIENT_BINARY_TRANSPORT */
+
 /**
  * \brief Send message with timeout to master in seconds
  *
@@ -629,6 +629,38 @@
            "r6", "r7", "r8", "r9", "cc"         \
          );
 
+#elif defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+
+/*
+ * Thumb-2 with the DSP extension (Cortex-M4, M7 and later). UMAAL computes
+ * RdHi:RdLo = Rn * Rm + RdLo + RdHi and cannot overflow, so one instruction
+ * replaces the UMLAL/ADDS/ADC sequence below: r5 carries the destination
+ * limb in, r2 carries the running carry, and both come back out updated.
+ */
+
+#define MULADDC_INIT                                    \
+    asm(                                                \
+            "ldr    r0, %3                      \n\t"   \
+            "ldr    r1, %4                      \n\t"   \
+            "ldr    r2, %5                      \n\t"   \
+            "ldr    r3, %6                      \n\t"
+
+#define MULADDC_CORE                                    \
+            "ldr    r4, [r0], #4                \n\t"   \
+            "ldr    r5, [r1]                    \n\t"   \
+            "umaal  r5, r2, r3, r4              \n\t"   \
+            "str    r5, [r1], #4                \n\t"
+
+#define MULADDC_STOP                                    \
+            "str    r2, %0                      \n\t"   \
+            "str    r1, %1                      \n\t"   \
+            "str    r0, %2                      \n\t"   \
+         : "=m" (c),  "=m" (d), "=m" (s)        \
+         : "m" (s), "m" (d), "m" (c), "m" (b)   \
+         : "r0", "r1", "r2", "r3", "r4", "r5",  \
+           "cc"                                 \
+         );
+
 #else
 
 #define MULADDC_INIT                                    \
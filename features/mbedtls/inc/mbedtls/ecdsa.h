@@ -127,6 +127,82 @@ int mbedtls_ecdsa_verify( mbedtls_ecp_group *grp,
                   const unsigned char *buf, size_t blen,
                   const mbedtls_ecp_point *Q, const mbedtls_mpi *r, const mbedtls_mpi *s);
 
+#if defined(MBEDTLS_ECP_INCREMENTAL)
+/**
+ * \brief           Context for an incremental ECDSA operation
+ *
+ *                  All fields are for internal use by
+ *                  mbedtls_ecdsa_sign_inc() and mbedtls_ecdsa_verify_inc()
+ *                  and must not be touched.
+ */
+typedef struct
+{
+    int state;                          /*!< progress marker            */
+    int key_tries;                      /*!< retries on bad ephemerals  */
+    int sign_tries;                     /*!< retries on zero signatures */
+    mbedtls_mpi k;                      /*!< signing: ephemeral scalar  */
+    mbedtls_mpi u1, u2;                 /*!< verification: scalars      */
+    mbedtls_ecp_point R;                /*!< intermediate point         */
+    mbedtls_ecp_mul_inc_context mul;    /*!< signing multiplication     */
+    mbedtls_ecp_muladd_inc_context muladd; /*!< verification sum        */
+}
+mbedtls_ecdsa_inc_context;
+
+/**
+ * \brief           Initialize an incremental ECDSA context
+ */
+void mbedtls_ecdsa_inc_init( mbedtls_ecdsa_inc_context *ctx );
+
+/**
+ * \brief           Free an incremental ECDSA context
+ *
+ *                  Safe to call on a context in any state, including
+ *                  mid-operation to abandon it.
+ */
+void mbedtls_ecdsa_inc_free( mbedtls_ecdsa_inc_context *ctx );
+
+/**
+ * \brief           Incremental version of mbedtls_ecdsa_sign()
+ *
+ *                  Computes the same signature, but spread over several
+ *                  calls: each one performs at most max_steps units of
+ *                  point arithmetic (see mbedtls_ecp_mul_inc()), so long
+ *                  signing operations can be interleaved with
+ *                  latency-sensitive work. Call repeatedly with the same
+ *                  arguments until it returns something other than
+ *                  MBEDTLS_ERR_ECP_IN_PROGRESS; buf must stay valid across
+ *                  the whole sequence of calls.
+ *
+ * \return          MBEDTLS_ERR_ECP_IN_PROGRESS if more calls are needed,
+ *                  0 on completion with the signature in r and s, or an
+ *                  MBEDTLS_ERR_ECP_XXX or MBEDTLS_ERR_MPI_XXX error code.
+ *                  The context is reset on both completion and failure.
+ */
+int mbedtls_ecdsa_sign_inc( mbedtls_ecp_group *grp,
+                mbedtls_ecdsa_inc_context *ctx,
+                mbedtls_mpi *r, mbedtls_mpi *s,
+                const mbedtls_mpi *d, const unsigned char *buf, size_t blen,
+                int (*f_rng)(void *, unsigned char *, size_t), void *p_rng,
+                size_t max_steps );
+
+/**
+ * \brief           Incremental version of mbedtls_ecdsa_verify()
+ *
+ *                  Same calling convention as mbedtls_ecdsa_sign_inc().
+ *
+ * \return          MBEDTLS_ERR_ECP_IN_PROGRESS if more calls are needed,
+ *                  0 if the signature is valid,
+ *                  MBEDTLS_ERR_ECP_VERIFY_FAILED if it is not, or an
+ *                  MBEDTLS_ERR_ECP_XXX or MBEDTLS_ERR_MPI_XXX error code
+ */
+int mbedtls_ecdsa_verify_inc( mbedtls_ecp_group *grp,
+                mbedtls_ecdsa_inc_context *ctx,
+                const unsigned char *buf, size_t blen,
+                const mbedtls_ecp_point *Q,
+                const mbedtls_mpi *r, const mbedtls_mpi *s,
+                size_t max_steps );
+#endif /* MBEDTLS_ECP_INCREMENTAL */
+
 /**
  * \brief           Compute ECDSA signature and write it to buffer,
  *                  serialized as defined in RFC 4492 page 20.
@@ -36,6 +36,7 @@
 #define MBEDTLS_ERR_ECP_RANDOM_FAILED                     -0x4D00  /**< Generation of random value, such as (ephemeral) key, failed. */
 #define MBEDTLS_ERR_ECP_INVALID_KEY                       -0x4C80  /**< Invalid private or public key. */
 #define MBEDTLS_ERR_ECP_SIG_LEN_MISMATCH                  -0x4C00  /**< Signature is valid but shorter than the user-supplied length. */
+#define MBEDTLS_ERR_ECP_IN_PROGRESS                       -0x4B00  /**< Incremental operation in progress, call again. */
 
 #if !defined(MBEDTLS_ECP_ALT)
 /*
@@ -555,6 +556,128 @@ int mbedtls_ecp_muladd( mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
              const mbedtls_mpi *m, const mbedtls_ecp_point *P,
              const mbedtls_mpi *n, const mbedtls_ecp_point *Q );
 
+#if defined(MBEDTLS_ECP_INCREMENTAL)
+/**
+ * \brief           Context for an incremental multiplication
+ *
+ *                  All fields are for internal use by
+ *                  mbedtls_ecp_mul_inc() and must not be touched.
+ */
+typedef struct
+{
+    int state;                  /*!< progress marker                */
+    unsigned char w;            /*!< comb window width              */
+    unsigned char m_is_odd;     /*!< parity of the original scalar  */
+    unsigned char p_eq_g;       /*!< multiplying the generator?     */
+    unsigned char pre_len;      /*!< number of precomputed points   */
+    unsigned char T_is_heap;    /*!< context owns the table         */
+    unsigned char k[ ( MBEDTLS_ECP_MAX_BITS + 1 ) / 2 + 1 ];
+                                /*!< comb representation of scalar  */
+    size_t d;                   /*!< number of comb digits          */
+    size_t i;                   /*!< digits left to process         */
+    mbedtls_ecp_point R;        /*!< running accumulator            */
+    mbedtls_ecp_point *T;       /*!< precomputed points             */
+}
+mbedtls_ecp_mul_inc_context;
+
+/**
+ * \brief           Initialize an incremental multiplication context
+ */
+void mbedtls_ecp_mul_inc_init( mbedtls_ecp_mul_inc_context *ctx );
+
+/**
+ * \brief           Free an incremental multiplication context
+ *
+ *                  Safe to call on a context in any state, including
+ *                  mid-operation to abandon it.
+ */
+void mbedtls_ecp_mul_inc_free( mbedtls_ecp_mul_inc_context *ctx );
+
+/**
+ * \brief           Incremental multiplication R = m * P
+ *
+ *                  Performs the same computation as mbedtls_ecp_mul(),
+ *                  including its timing countermeasures, but spread over
+ *                  several calls so that other work can run in between.
+ *                  Call repeatedly with the same arguments until it
+ *                  returns something other than
+ *                  MBEDTLS_ERR_ECP_IN_PROGRESS.
+ *
+ * \note            Only short Weierstrass curves are supported; Montgomery
+ *                  curves use a ladder with no comparable resume point.
+ *
+ * \note            The first call also performs the comb precomputation,
+ *                  which for a point other than the generator costs about
+ *                  as much as the multiplication itself. For the generator
+ *                  the table is cached in the group (or, with
+ *                  MBEDTLS_ECP_STATIC_COMB, read from flash), so slices
+ *                  stay close to max_steps comb digits of work.
+ *
+ * \param grp       ECP group
+ * \param ctx       Incremental context, freshly initialized or as left by
+ *                  the previous call
+ * \param R         Destination point, written on final success only
+ * \param m         Integer by which to multiply
+ * \param P         Point to multiply
+ * \param f_rng     RNG function (see mbedtls_ecp_mul())
+ * \param p_rng     RNG parameter
+ * \param max_steps Maximum comb digits to process in this call; each digit
+ *                  costs one point doubling plus one addition and covers
+ *                  about w bits of the scalar (w is 4 to 6 in practice)
+ *
+ * \return          MBEDTLS_ERR_ECP_IN_PROGRESS if more calls are needed,
+ *                  0 on completion, or an MBEDTLS_ERR_ECP_XXX or
+ *                  MBEDTLS_ERR_MPI_XXX error code on failure. The context
+ *                  is reset on both completion and failure.
+ */
+int mbedtls_ecp_mul_inc( mbedtls_ecp_group *grp,
+             mbedtls_ecp_mul_inc_context *ctx, mbedtls_ecp_point *R,
+             const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+             int (*f_rng)(void *, unsigned char *, size_t), void *p_rng,
+             size_t max_steps );
+
+/**
+ * \brief           Context for an incremental multiply-and-add
+ *
+ *                  All fields are for internal use by
+ *                  mbedtls_ecp_muladd_inc() and must not be touched.
+ */
+typedef struct
+{
+    int phase;                      /*!< which multiplication is running */
+    mbedtls_ecp_mul_inc_context mul;/*!< context for the current one     */
+    mbedtls_ecp_point mP;           /*!< result of the first one         */
+}
+mbedtls_ecp_muladd_inc_context;
+
+/**
+ * \brief           Initialize an incremental multiply-and-add context
+ */
+void mbedtls_ecp_muladd_inc_init( mbedtls_ecp_muladd_inc_context *ctx );
+
+/**
+ * \brief           Free an incremental multiply-and-add context
+ */
+void mbedtls_ecp_muladd_inc_free( mbedtls_ecp_muladd_inc_context *ctx );
+
+/**
+ * \brief           Incremental computation of R = m * P + n * Q
+ *
+ *                  Split-up version of mbedtls_ecp_muladd(), with the same
+ *                  calling convention as mbedtls_ecp_mul_inc(). Like
+ *                  mbedtls_ecp_muladd() it is intended for public values
+ *                  only and takes no RNG for blinding.
+ *
+ * \return          MBEDTLS_ERR_ECP_IN_PROGRESS if more calls are needed,
+ *                  0 on completion, or an error code on failure
+ */
+int mbedtls_ecp_muladd_inc( mbedtls_ecp_group *grp,
+             mbedtls_ecp_muladd_inc_context *ctx, mbedtls_ecp_point *R,
+             const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+             const mbedtls_mpi *n, const mbedtls_ecp_point *Q,
+             size_t max_steps );
+#endif /* MBEDTLS_ECP_INCREMENTAL */
+
 /**
  * \brief           Check that a point is a valid public key on this curve
  *
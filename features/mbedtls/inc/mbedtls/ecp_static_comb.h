@@ -0,0 +1,66 @@
+/**
+ * \file ecp_static_comb.h
+ *
+ * \brief Compile-time fixed-base comb tables for elliptic curve multiplication
+ *
+ *  Copyright (C) 2006-2017, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+#ifndef MBEDTLS_ECP_STATIC_COMB_H
+#define MBEDTLS_ECP_STATIC_COMB_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_ECP_C) && defined(MBEDTLS_ECP_STATIC_COMB)
+
+#include "ecp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief           Look up a compile-time comb table for fixed-base
+ *                  multiplication by the group generator
+ *
+ *                  The returned points live in flash: only X and Y are
+ *                  populated (normalized, Z implicitly 1), which is all the
+ *                  comb multiplication reads from its precomputed points.
+ *                  The table must never be written to or freed, and in
+ *                  particular must never be stored into \c grp->T.
+ *
+ * \param grp       ECP group with the generator the table was built for
+ * \param w         Comb window width the caller is about to use
+ * \param d         Number of comb teeth, ceil( nbits / w )
+ *
+ * \return          Table of 2^(w-1) points, or NULL when no table was built
+ *                  for this (curve, w, d) combination
+ */
+const mbedtls_ecp_point *mbedtls_ecp_static_comb_table( const mbedtls_ecp_group *grp,
+                                                        unsigned char w, size_t d );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_ECP_C && MBEDTLS_ECP_STATIC_COMB */
+
+#endif /* ecp_static_comb.h */
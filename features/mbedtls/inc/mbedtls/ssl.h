@@ -789,6 +789,15 @@ struct mbedtls_ssl_context
 
     void *p_bio;                /*!< context for I/O operations   */
 
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+    void (*f_partial)(void *, const unsigned char *, size_t);
+                                /*!< Internal callback fed with the bytes of
+                                     the current record received so far, so
+                                     the Certificate message can be processed
+                                     while still in transit */
+    void *p_partial;            /*!< context for f_partial */
+#endif
+
     /*
      * Session layer
      */
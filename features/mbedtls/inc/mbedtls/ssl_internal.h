@@ -217,6 +217,16 @@ struct mbedtls_ssl_handshake_params
     mbedtls_x509_crt *sni_ca_chain;     /*!< trusted CAs from SNI callback  */
     mbedtls_x509_crl *sni_ca_crl;       /*!< trusted CAs CRLs from SNI      */
 #endif /* MBEDTLS_SSL_SERVER_NAME_INDICATION */
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+    mbedtls_x509_crt *pipeline_chain;   /*!< peer chain parsed while the
+                                             Certificate message was being
+                                             received                      */
+    size_t pipeline_offset;             /*!< bytes of the record consumed   */
+    size_t pipeline_end;                /*!< end of the Certificate message
+                                             within the record buffer      */
+    unsigned char pipeline_err;         /*!< pipeline gave up, fall back to
+                                             parsing the complete message  */
+#endif /* MBEDTLS_X509_CRT_PIPELINE */
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
     unsigned int out_msg_seq;           /*!<  Outgoing handshake sequence number */
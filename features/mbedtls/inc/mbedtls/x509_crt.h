@@ -89,6 +89,10 @@ typedef struct mbedtls_x509_crt
     mbedtls_pk_type_t sig_pk;           /**< Internal representation of the Public Key algorithm of the signature algorithm, e.g. MBEDTLS_PK_RSA */
     void *sig_opts;             /**< Signature options to be passed to mbedtls_pk_verify_ext(), e.g. for RSASSA-PSS */
 
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+    unsigned char sig_verified; /**< Internal use: 1 if the signature was already checked against the next certificate in the list, see mbedtls_x509_crt_check_signature() */
+#endif
+
     struct mbedtls_x509_crt *next;     /**< Next certificate in the CA-chain. */
 }
 mbedtls_x509_crt;
@@ -345,6 +349,32 @@ int mbedtls_x509_crt_verify_with_profile( mbedtls_x509_crt *crt,
                      int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
                      void *p_vrfy );
 
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+/**
+ * \brief          Check the signature of a certificate against a candidate
+ *                 issuer, ahead of the full chain verification.
+ *
+ *                 On success child->sig_verified is set, and
+ *                 mbedtls_x509_crt_verify() will not repeat the public-key
+ *                 operation for this link as long as parent is the next
+ *                 certificate in the same list. This lets the TLS layer
+ *                 check each link of an incoming chain while the rest of
+ *                 the Certificate message is still in transit.
+ *
+ * \param child    Certificate whose signature is checked
+ * \param parent   Candidate issuer, usually child->next
+ *
+ * \note           Only the signature itself is checked here: validity
+ *                 dates, profile, usage and trust anchoring are still the
+ *                 business of mbedtls_x509_crt_verify().
+ *
+ * \return         0 if the signature is valid,
+ *                 MBEDTLS_ERR_X509_CERT_VERIFY_FAILED otherwise
+ */
+int mbedtls_x509_crt_check_signature( mbedtls_x509_crt *child,
+                                      mbedtls_x509_crt *parent );
+#endif /* MBEDTLS_X509_CRT_PIPELINE */
+
 #if defined(MBEDTLS_X509_CHECK_KEY_USAGE)
 /**
  * \brief          Check usage of certificate against keyUsage extension.
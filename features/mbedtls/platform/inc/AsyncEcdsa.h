@@ -0,0 +1,134 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ASYNC_ECDSA_H
+#define ASYNC_ECDSA_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_INCREMENTAL)
+
+#include "mbedtls/ecdsa.h"
+#include "events/EventQueue.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** Event-queue driven ECDSA signing and verification
+ *
+ *  Runs mbed TLS's incremental ECDSA operations as a chain of short events
+ *  on an EventQueue, so a signature that would otherwise monopolize the CPU
+ *  for hundreds of milliseconds is processed in slices between whatever else
+ *  the queue is dispatching. Stacks with radio deadlines (BLE, 802.15.4) can
+ *  hand their shared event queue to this class and keep servicing the radio
+ *  while crypto makes progress, without a dedicated thread.
+ *
+ *  Requires MBEDTLS_ECP_INCREMENTAL. One operation may be in flight per
+ *  instance; start and completion run on the queue's dispatch context, and
+ *  sign()/verify() must not race with it from another thread.
+ */
+class AsyncEcdsa : private NonCopyable<AsyncEcdsa> {
+public:
+    /** Create an ECDSA engine on an event queue
+     *
+     *  @param queue            Queue the slices are dispatched on
+     *  @param steps_per_slice  Point operations per event; each step is one
+     *                          doubling plus one addition, roughly 1-2 ms on
+     *                          a Cortex-M4 for P-256. Smaller values give
+     *                          finer-grained scheduling at slightly more
+     *                          total overhead.
+     */
+    AsyncEcdsa(events::EventQueue *queue, size_t steps_per_slice = 8);
+
+    /** Cancel any operation in flight and destroy the engine
+     *
+     *  The completion callback of a cancelled operation is not invoked.
+     */
+    ~AsyncEcdsa();
+
+    /** Start computing an ECDSA signature of a hashed message
+     *
+     *  Arguments follow mbedtls_ecdsa_sign(); all pointers must stay valid
+     *  until the done callback runs. The callback receives 0 with the
+     *  signature in r and s, or an mbed TLS error code.
+     *
+     *  @return 0 if the operation was started,
+     *          MBEDTLS_ERR_ECP_IN_PROGRESS if one is already in flight, or
+     *          MBEDTLS_ERR_ECP_ALLOC_FAILED if the queue rejected the event
+     */
+    int sign(mbedtls_ecp_group *grp, mbedtls_mpi *r, mbedtls_mpi *s,
+             const mbedtls_mpi *d, const unsigned char *hash, size_t hlen,
+             int (*f_rng)(void *, unsigned char *, size_t), void *p_rng,
+             Callback<void(int)> done);
+
+    /** Start verifying an ECDSA signature of a hashed message
+     *
+     *  Arguments follow mbedtls_ecdsa_verify(); all pointers must stay valid
+     *  until the done callback runs. The callback receives 0 for a valid
+     *  signature, MBEDTLS_ERR_ECP_VERIFY_FAILED for an invalid one, or
+     *  another mbed TLS error code.
+     *
+     *  @return 0 if the operation was started,
+     *          MBEDTLS_ERR_ECP_IN_PROGRESS if one is already in flight, or
+     *          MBEDTLS_ERR_ECP_ALLOC_FAILED if the queue rejected the event
+     */
+    int verify(mbedtls_ecp_group *grp,
+               const unsigned char *hash, size_t hlen,
+               const mbedtls_ecp_point *Q,
+               const mbedtls_mpi *r, const mbedtls_mpi *s,
+               Callback<void(int)> done);
+
+    /** Check whether an operation is in flight */
+    bool busy() const;
+
+private:
+    enum Operation {
+        OP_NONE,
+        OP_SIGN,
+        OP_VERIFY
+    };
+
+    void slice();
+    void finish(int status);
+    int post_slice();
+
+    events::EventQueue *_queue;
+    size_t _steps;
+    Operation _op;
+    int _event_id;
+    mbedtls_ecdsa_inc_context _ctx;
+    Callback<void(int)> _done;
+
+    mbedtls_ecp_group *_grp;
+    const unsigned char *_hash;
+    size_t _hlen;
+    mbedtls_mpi *_sig_r, *_sig_s;
+    const mbedtls_mpi *_d;
+    int (*_f_rng)(void *, unsigned char *, size_t);
+    void *_p_rng;
+    const mbedtls_ecp_point *_Q;
+    const mbedtls_mpi *_ver_r, *_ver_s;
+};
+
+} // namespace mbed
+
+#endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_INCREMENTAL */
+
+#endif /* ASYNC_ECDSA_H */
@@ -0,0 +1,122 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TLS_SESSION_STORE_H
+#define TLS_SESSION_STORE_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_SSL_TLS_C) && DEVICE_FLASH
+
+#include "mbedtls/ssl.h"
+#include "drivers/FlashIAP.h"
+
+namespace mbed {
+
+/** Persist a TLS session across reboots
+ *
+ *  A device that reboots between connections pays a full handshake on
+ *  every wake. This class serializes an mbedtls_ssl_session - including
+ *  the RFC 5077 ticket when the build carries one - into a caller-provided
+ *  internal flash region through FlashIAP, and restores it at boot, so
+ *  mbedtls_ssl_set_session() can arrange an abbreviated handshake for the
+ *  common reconnect.
+ *
+ *  Records are appended log-structured across the region with a sequence
+ *  number and CRC; the region is only erased when it is full, spreading
+ *  wear over all of its sectors. The newest valid record wins at boot, so
+ *  a reset mid-write at worst loses the session being saved.
+ *
+ *  The peer certificate chain is not persisted - the stored
+ *  verify_result carries the outcome of its verification - and a record
+ *  saved by a build with different session features is rejected rather
+ *  than half-restored.
+ *
+ *  @note The master secret and ticket are stored in plaintext, so the
+ *        region should live in internal flash covered by the target's
+ *        readout protection.
+ */
+class TLSSessionStore : private NonCopyable<TLSSessionStore> {
+public:
+    /** Create a session store on a flash region
+     *
+     *  @param addr Start of the region, sector-aligned
+     *  @param size Size of the region, a multiple of the sector size and
+     *              large enough for one serialized session (a few hundred
+     *              bytes, plus the server's ticket size when tickets are
+     *              in use)
+     */
+    TLSSessionStore(uint32_t addr, uint32_t size);
+
+    ~TLSSessionStore();
+
+    /** Initialize the flash and locate the newest stored session
+     *
+     *  @return 0 on success, negative error code on failure
+     */
+    int init();
+
+    /** Release the flash
+     *
+     *  @return 0 on success, negative error code on failure
+     */
+    int deinit();
+
+    /** Save a session, replacing any previously stored one
+     *
+     *  @param session Session obtained from mbedtls_ssl_get_session()
+     *  @return 0 on success, negative error code on failure
+     */
+    int save(const mbedtls_ssl_session *session);
+
+    /** Restore the newest stored session
+     *
+     *  @param session Freshly initialized session to fill in; pass it to
+     *                 mbedtls_ssl_set_session() before the handshake
+     *  @return 0 on success, negative error code if nothing valid is
+     *          stored or the record does not match this build
+     */
+    int load(mbedtls_ssl_session *session);
+
+    /** Erase the region, discarding any stored session
+     *
+     *  @return 0 on success, negative error code on failure
+     */
+    int clear();
+
+private:
+    int scan();
+    uint32_t record_space(uint32_t payload_len) const;
+
+    FlashIAP _flash;
+    uint32_t _addr;
+    uint32_t _size;
+    uint32_t _page_size;
+    uint32_t _next_off;
+    uint32_t _latest_off;
+    uint32_t _latest_len;
+    uint32_t _seq;
+    bool _inited;
+};
+
+} // namespace mbed
+
+#endif /* MBEDTLS_SSL_TLS_C && DEVICE_FLASH */
+
+#endif /* TLS_SESSION_STORE_H */
@@ -0,0 +1,71 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TLS_ARENA_H
+#define MBED_TLS_ARENA_H
+
+/*
+ * Static arena mode for mbed TLS allocations.
+ *
+ * A TLS handshake calloc/frees hundreds of short-lived blocks (bignum
+ * limbs, handshake buffers), which fragments a small shared heap and can
+ * fail mid-handshake once the heap is aged. Defining
+ * MBEDTLS_MBED_ARENA_SIZE (bytes, e.g. via a target or app macro)
+ * carves a static arena of that size and routes every mbed TLS
+ * allocation into it through the library's buffer allocator, so TLS can
+ * no longer fragment - or be starved by - the rest of the system.
+ *
+ * Call mbed_tls_arena_init() once before the first TLS use. To measure
+ * the worst-case arena size for a given mbedtls config, build with
+ * MBEDTLS_MEMORY_DEBUG, exercise the heaviest handshake, and read
+ * mbed_tls_arena_peak(); size the arena to that plus ~10% margin.
+ */
+
+#if defined(MBEDTLS_MBED_ARENA_SIZE)
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Point mbed TLS allocations at the static arena
+ *
+ *  Must run before any mbed TLS allocation; safe to call repeatedly,
+ *  only the first call takes effect.
+ */
+void mbed_tls_arena_init( void );
+
+/** Peak arena usage in bytes since boot
+ *
+ *  @return High-water mark of arena bytes in use, or 0 when the build
+ *          lacks MBEDTLS_MEMORY_DEBUG
+ */
+size_t mbed_tls_arena_peak( void );
+
+/** Current arena usage in bytes
+ *
+ *  @return Arena bytes currently allocated, or 0 when the build lacks
+ *          MBEDTLS_MEMORY_DEBUG
+ */
+size_t mbed_tls_arena_used( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_MBED_ARENA_SIZE */
+
+#endif /* MBED_TLS_ARENA_H */
@@ -0,0 +1,117 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CA_STORE_H
+#define MBED_CA_STORE_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBED_CA_STORE) && defined(MBEDTLS_X509_CRT_PARSE_C)
+
+#include <stddef.h>
+#include "mbedtls/x509_crt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Indexed trusted CA store in flash.
+ *
+ * mbed_ca_store_gen.py compiles the product's CA bundle into a const
+ * table of DER blobs indexed by a 32-bit hash of each subject Name, so
+ * finding the issuer of a certificate is a binary search plus a single
+ * memcmp instead of DER-parsing the whole bundle, and only the one CA
+ * actually needed for a connection is ever parsed into RAM.
+ *
+ * Typical use before a handshake, once the peer's chain is known or for
+ * the common single-server case at boot:
+ *
+ *     mbedtls_x509_crt trust;
+ *     mbedtls_x509_crt_init( &trust );
+ *     mbed_ca_store_chain_for( peer_chain, &trust );
+ *     mbedtls_ssl_conf_ca_chain( &conf, &trust, NULL );
+ *
+ * or mbed_ca_store_load_all() to materialize the full bundle once at
+ * boot instead of once per connection.
+ */
+
+/** One certificate in the generated store, sorted by subject_hash */
+typedef struct {
+    unsigned long subject_hash;     /**< FNV-1a over the subject Name TLV */
+    const unsigned char *der;       /**< DER certificate in flash         */
+    unsigned short der_len;         /**< Length of der                    */
+    unsigned short subject_off;     /**< Offset of the subject Name TLV   */
+    unsigned short subject_len;     /**< Length of the subject Name TLV   */
+} mbed_ca_store_entry_t;
+
+/** Generated by mbed_ca_store_gen.py */
+extern const mbed_ca_store_entry_t mbed_ca_store_entries[];
+extern const size_t mbed_ca_store_entry_count;
+
+/** Find the stored certificate whose subject equals a Name element
+ *
+ *  @param name_raw Raw DER of the Name to match (tag included), as in
+ *                  the issuer_raw/subject_raw fields of mbedtls_x509_crt
+ *  @param name_len Length of name_raw
+ *  @param der      Set to the matching DER blob on success
+ *  @param der_len  Set to its length on success
+ *  @return 0 on success, -1 if no stored CA has that subject
+ */
+int mbed_ca_store_find(const unsigned char *name_raw, size_t name_len,
+                       const unsigned char **der, size_t *der_len);
+
+/** Parse the stored issuer of a certificate
+ *
+ *  @param child  Certificate whose issuer is looked up
+ *  @param parent Initialized certificate to parse the issuer into
+ *  @return 0 on success, -1 if the issuer is not in the store, or an
+ *          MBEDTLS_ERR_X509_XXX code if it fails to parse
+ */
+int mbed_ca_store_parent_of(const mbedtls_x509_crt *child,
+                            mbedtls_x509_crt *parent);
+
+/** Build the minimal trust chain for a peer chain
+ *
+ *  Parses the stored issuer of the last certificate of the peer's chain
+ *  and follows further issuers within the store up to a self-signed
+ *  root, appending each to trust. The result is the smallest trust list
+ *  mbedtls_x509_crt_verify() needs for this peer.
+ *
+ *  @param chain Peer certificate chain
+ *  @param trust Initialized certificate list to append to
+ *  @return 0 if at least one issuer was found, -1 if none was
+ */
+int mbed_ca_store_chain_for(const mbedtls_x509_crt *chain,
+                            mbedtls_x509_crt *trust);
+
+/** Parse every certificate in the store into one list
+ *
+ *  @param trust Initialized certificate list to append to
+ *  @return 0 on success, or the first MBEDTLS_ERR_X509_XXX failure
+ */
+int mbed_ca_store_load_all(mbedtls_x509_crt *trust);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBED_CA_STORE && MBEDTLS_X509_CRT_PARSE_C */
+
+#endif /* MBED_CA_STORE_H */
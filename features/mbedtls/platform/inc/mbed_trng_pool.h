@@ -0,0 +1,73 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TRNG_POOL_H
+#define MBED_TRNG_POOL_H
+
+/*
+ * Background-maintained TRNG entropy pool.
+ *
+ * Some target TRNGs block for milliseconds per read, and with the default
+ * mbedtls_hardware_poll() that stall lands in the middle of a TLS handshake.
+ * Defining MBED_TRNG_POOL_SIZE (bytes, e.g. via a target or app macro)
+ * inserts a pool between the TRNG and mbed TLS: the idle thread tops it up
+ * a chunk at a time while the system has nothing better to do, and
+ * mbedtls_hardware_poll() serves entropy requests from it without touching
+ * the hardware. Only when the pool is drained does a request fall back to
+ * a synchronous TRNG read.
+ *
+ * Pool bytes are raw TRNG output and are wiped as they are consumed.
+ */
+
+#if defined(DEVICE_TRNG) && defined(MBED_TRNG_POOL_SIZE)
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Top up the pool with one chunk of TRNG output
+ *
+ *  Does nothing when the pool is full. May block for as long as the
+ *  target's TRNG takes to produce a chunk, so only call it from a context
+ *  with nothing better to do - by default the RTOS idle thread calls it
+ *  through mbed_idle_background_hook().
+ */
+void mbed_trng_pool_fill(void);
+
+/** Serve entropy from the pool
+ *
+ *  Takes up to len bytes without blocking. May return fewer than requested;
+ *  the consumed bytes are wiped from the pool.
+ *
+ *  @param output  Buffer to fill
+ *  @param len     Bytes requested
+ *  @param olen    Set to the number of bytes actually delivered
+ *  @return        0 if at least one byte was delivered, -1 if the pool
+ *                 is empty and the caller must fall back to the TRNG
+ */
+int mbed_trng_pool_read(unsigned char *output, size_t len, size_t *olen);
+
+/** Bytes currently available in the pool */
+size_t mbed_trng_pool_available(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEVICE_TRNG && MBED_TRNG_POOL_SIZE */
+
+#endif /* MBED_TRNG_POOL_H */
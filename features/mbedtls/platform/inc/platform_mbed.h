@@ -21,6 +21,13 @@
 #define MBEDTLS_ENTROPY_HARDWARE_ALT
 #endif
 
+/* Static arena mode: route all mbed TLS allocations into a dedicated
+ * buffer of MBEDTLS_MBED_ARENA_SIZE bytes, see mbed_arena.h */
+#if defined(MBEDTLS_MBED_ARENA_SIZE)
+#define MBEDTLS_PLATFORM_MEMORY
+#define MBEDTLS_MEMORY_BUFFER_ALLOC_C
+#endif
+
 #if defined(MBEDTLS_CONFIG_HW_SUPPORT)
 #include "mbedtls_device.h"
 #endif
@@ -0,0 +1,142 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncEcdsa.h"
+
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_INCREMENTAL)
+
+namespace mbed {
+
+AsyncEcdsa::AsyncEcdsa(events::EventQueue *queue, size_t steps_per_slice)
+    : _queue(queue), _steps(steps_per_slice), _op(OP_NONE), _event_id(0),
+      _done(), _grp(NULL), _hash(NULL), _hlen(0),
+      _sig_r(NULL), _sig_s(NULL), _d(NULL), _f_rng(NULL), _p_rng(NULL),
+      _Q(NULL), _ver_r(NULL), _ver_s(NULL)
+{
+    mbedtls_ecdsa_inc_init(&_ctx);
+}
+
+AsyncEcdsa::~AsyncEcdsa()
+{
+    if (_event_id) {
+        _queue->cancel(_event_id);
+    }
+    mbedtls_ecdsa_inc_free(&_ctx);
+}
+
+int AsyncEcdsa::sign(mbedtls_ecp_group *grp, mbedtls_mpi *r, mbedtls_mpi *s,
+                     const mbedtls_mpi *d, const unsigned char *hash, size_t hlen,
+                     int (*f_rng)(void *, unsigned char *, size_t), void *p_rng,
+                     Callback<void(int)> done)
+{
+    if (_op != OP_NONE) {
+        return MBEDTLS_ERR_ECP_IN_PROGRESS;
+    }
+
+    _grp = grp;
+    _sig_r = r;
+    _sig_s = s;
+    _d = d;
+    _hash = hash;
+    _hlen = hlen;
+    _f_rng = f_rng;
+    _p_rng = p_rng;
+    _done = done;
+    _op = OP_SIGN;
+
+    return post_slice();
+}
+
+int AsyncEcdsa::verify(mbedtls_ecp_group *grp,
+                       const unsigned char *hash, size_t hlen,
+                       const mbedtls_ecp_point *Q,
+                       const mbedtls_mpi *r, const mbedtls_mpi *s,
+                       Callback<void(int)> done)
+{
+    if (_op != OP_NONE) {
+        return MBEDTLS_ERR_ECP_IN_PROGRESS;
+    }
+
+    _grp = grp;
+    _hash = hash;
+    _hlen = hlen;
+    _Q = Q;
+    _ver_r = r;
+    _ver_s = s;
+    _done = done;
+    _op = OP_VERIFY;
+
+    return post_slice();
+}
+
+bool AsyncEcdsa::busy() const
+{
+    return _op != OP_NONE;
+}
+
+int AsyncEcdsa::post_slice()
+{
+    _event_id = _queue->call(this, &AsyncEcdsa::slice);
+    if (!_event_id) {
+        _op = OP_NONE;
+        _done = Callback<void(int)>();
+        mbedtls_ecdsa_inc_free(&_ctx);
+        return MBEDTLS_ERR_ECP_ALLOC_FAILED;
+    }
+    return 0;
+}
+
+void AsyncEcdsa::slice()
+{
+    int ret;
+
+    _event_id = 0;
+
+    if (_op == OP_SIGN) {
+        ret = mbedtls_ecdsa_sign_inc(_grp, &_ctx, _sig_r, _sig_s, _d,
+                                     _hash, _hlen, _f_rng, _p_rng, _steps);
+    } else {
+        ret = mbedtls_ecdsa_verify_inc(_grp, &_ctx, _hash, _hlen,
+                                       _Q, _ver_r, _ver_s, _steps);
+    }
+
+    if (ret == MBEDTLS_ERR_ECP_IN_PROGRESS) {
+        _event_id = _queue->call(this, &AsyncEcdsa::slice);
+        if (!_event_id) {
+            mbedtls_ecdsa_inc_free(&_ctx);
+            finish(MBEDTLS_ERR_ECP_ALLOC_FAILED);
+        }
+        return;
+    }
+
+    finish(ret);
+}
+
+void AsyncEcdsa::finish(int status)
+{
+    Callback<void(int)> done = _done;
+
+    _op = OP_NONE;
+    _done = Callback<void(int)>();
+
+    if (done) {
+        done(status);
+    }
+}
+
+} // namespace mbed
+
+#endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_INCREMENTAL */
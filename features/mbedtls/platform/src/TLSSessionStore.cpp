@@ -0,0 +1,477 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TLSSessionStore.h"
+
+#if defined(MBEDTLS_SSL_TLS_C) && DEVICE_FLASH
+
+#include "mbedtls/platform.h"
+
+#include <string.h>
+
+namespace mbed {
+
+/* Record layout in flash: a fixed header directly followed by the payload,
+ * the whole padded to the program page size. "TSS1" guards both against
+ * garbage and against future layout changes. */
+#define STORE_MAGIC         0x54535331
+#define STORE_HEADER_LEN    16
+#define STORE_ERASED        0xFFFFFFFF
+
+/* Payload feature flags; a record must have been written by a build with
+ * the same session layout to be restored */
+#define STORE_FLAG_TIME     0x01
+#define STORE_FLAG_TICKET   0x02
+#define STORE_FLAG_MFL      0x04
+#define STORE_FLAG_TRUNC    0x08
+#define STORE_FLAG_ETM      0x10
+
+static uint8_t store_flags(void)
+{
+    uint8_t flags = 0;
+
+#if defined(MBEDTLS_HAVE_TIME)
+    flags |= STORE_FLAG_TIME;
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    flags |= STORE_FLAG_TICKET;
+#endif
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    flags |= STORE_FLAG_MFL;
+#endif
+#if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
+    flags |= STORE_FLAG_TRUNC;
+#endif
+#if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC)
+    flags |= STORE_FLAG_ETM;
+#endif
+
+    return flags;
+}
+
+static void w32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)(v >> 0);
+}
+
+static uint32_t r32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8) | ((uint32_t)p[3] << 0);
+}
+
+static uint32_t store_crc32(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+
+    return ~crc;
+}
+
+/* Serialized payload size for a session */
+static uint32_t session_payload_len(const mbedtls_ssl_session *session)
+{
+    uint32_t len = 1 + 4 + 1 + 1 + 32 + 48 + 4;
+
+#if defined(MBEDTLS_HAVE_TIME)
+    len += 8;
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    len += 4 + session->ticket_len + 4;
+#else
+    (void) session;
+#endif
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    len += 1;
+#endif
+#if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
+    len += 1;
+#endif
+#if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC)
+    len += 1;
+#endif
+
+    return len;
+}
+
+/* The peer certificate chain is deliberately not serialized: verify_result
+ * preserves the outcome of its verification, and mbedtls needs no more than
+ * that to resume */
+static void session_serialize(const mbedtls_ssl_session *session, uint8_t *p)
+{
+    *p++ = store_flags();
+
+    w32(p, (uint32_t) session->ciphersuite);
+    p += 4;
+    *p++ = (uint8_t) session->compression;
+    *p++ = (uint8_t) session->id_len;
+    memcpy(p, session->id, 32);
+    p += 32;
+    memcpy(p, session->master, 48);
+    p += 48;
+    w32(p, session->verify_result);
+    p += 4;
+
+#if defined(MBEDTLS_HAVE_TIME)
+    w32(p, (uint32_t)((uint64_t) session->start >> 32));
+    p += 4;
+    w32(p, (uint32_t) session->start);
+    p += 4;
+#endif
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    w32(p, session->ticket_len);
+    p += 4;
+    if (session->ticket_len > 0) {
+        memcpy(p, session->ticket, session->ticket_len);
+        p += session->ticket_len;
+    }
+    w32(p, session->ticket_lifetime);
+    p += 4;
+#endif
+
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    *p++ = session->mfl_code;
+#endif
+#if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
+    *p++ = (uint8_t) session->trunc_hmac;
+#endif
+#if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC)
+    *p++ = (uint8_t) session->encrypt_then_mac;
+#endif
+}
+
+static int session_deserialize(mbedtls_ssl_session *session,
+                               const uint8_t *p, uint32_t len)
+{
+    const uint8_t *end = p + len;
+
+    if (len < 1 + 4 + 1 + 1 + 32 + 48 + 4) {
+        return -1;
+    }
+
+    /* Refuse records written by a build with a different session layout */
+    if (*p++ != store_flags()) {
+        return -1;
+    }
+
+    session->ciphersuite = (int) r32(p);
+    p += 4;
+    session->compression = *p++;
+    session->id_len = *p++;
+    if (session->id_len > 32) {
+        return -1;
+    }
+    memcpy(session->id, p, 32);
+    p += 32;
+    memcpy(session->master, p, 48);
+    p += 48;
+    session->verify_result = r32(p);
+    p += 4;
+
+#if defined(MBEDTLS_HAVE_TIME)
+    if (end - p < 8) {
+        return -1;
+    }
+    session->start = (mbedtls_time_t)(((uint64_t) r32(p) << 32) | r32(p + 4));
+    p += 8;
+#endif
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    if (end - p < 4) {
+        return -1;
+    }
+    session->ticket_len = r32(p);
+    p += 4;
+    if ((uint32_t)(end - p) < session->ticket_len + 4) {
+        return -1;
+    }
+    if (session->ticket_len > 0) {
+        session->ticket = (unsigned char *) mbedtls_calloc(1, session->ticket_len);
+        if (session->ticket == NULL) {
+            return -1;
+        }
+        memcpy(session->ticket, p, session->ticket_len);
+        p += session->ticket_len;
+    }
+    session->ticket_lifetime = r32(p);
+    p += 4;
+#endif
+
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    if (end - p < 1) {
+        return -1;
+    }
+    session->mfl_code = *p++;
+#endif
+#if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
+    if (end - p < 1) {
+        return -1;
+    }
+    session->trunc_hmac = *p++;
+#endif
+#if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC)
+    if (end - p < 1) {
+        return -1;
+    }
+    session->encrypt_then_mac = *p++;
+#endif
+
+    return p == end ? 0 : -1;
+}
+
+TLSSessionStore::TLSSessionStore(uint32_t addr, uint32_t size)
+    : _flash(), _addr(addr), _size(size), _page_size(0),
+      _next_off(0), _latest_off(0), _latest_len(0), _seq(0), _inited(false)
+{
+}
+
+TLSSessionStore::~TLSSessionStore()
+{
+    if (_inited) {
+        deinit();
+    }
+}
+
+uint32_t TLSSessionStore::record_space(uint32_t payload_len) const
+{
+    uint32_t total = STORE_HEADER_LEN + payload_len;
+    return ((total + _page_size - 1) / _page_size) * _page_size;
+}
+
+int TLSSessionStore::init()
+{
+    int ret;
+
+    if (_inited) {
+        return 0;
+    }
+
+    ret = _flash.init();
+    if (ret != 0) {
+        return ret;
+    }
+
+    _page_size = _flash.get_page_size();
+    _inited = true;
+
+    ret = scan();
+    if (ret != 0) {
+        _flash.deinit();
+        _inited = false;
+    }
+
+    return ret;
+}
+
+int TLSSessionStore::deinit()
+{
+    if (!_inited) {
+        return 0;
+    }
+
+    _inited = false;
+    return _flash.deinit();
+}
+
+/* Walk the region and find the newest valid record and the write cursor */
+int TLSSessionStore::scan()
+{
+    uint8_t header[STORE_HEADER_LEN];
+    uint32_t off = 0;
+
+    _latest_len = 0;
+    _seq = 0;
+    /* Anything unexpected makes the next save erase the region first */
+    _next_off = _size;
+
+    while (off + STORE_HEADER_LEN <= _size) {
+        if (_flash.read(header, _addr + off, STORE_HEADER_LEN) != 0) {
+            return -1;
+        }
+
+        uint32_t magic = r32(header);
+        if (magic == STORE_ERASED) {
+            /* Clean end of the log: append here */
+            _next_off = off;
+            return 0;
+        }
+        if (magic != STORE_MAGIC) {
+            return 0;
+        }
+
+        uint32_t seq = r32(header + 4);
+        uint32_t len = r32(header + 8);
+        uint32_t crc = r32(header + 12);
+
+        if (len == 0 || off + record_space(len) > _size) {
+            return 0;
+        }
+
+        uint8_t *payload = (uint8_t *) mbedtls_calloc(1, len);
+        if (payload == NULL) {
+            return -1;
+        }
+
+        if (_flash.read(payload, _addr + off + STORE_HEADER_LEN, len) != 0 ||
+            store_crc32(payload, len) != crc) {
+            mbedtls_free(payload);
+            return 0;
+        }
+        mbedtls_free(payload);
+
+        if (seq >= _seq) {
+            _seq = seq + 1;
+            _latest_off = off;
+            _latest_len = len;
+        }
+
+        off += record_space(len);
+    }
+
+    return 0;
+}
+
+int TLSSessionStore::save(const mbedtls_ssl_session *session)
+{
+    int ret = 0;
+
+    if (!_inited) {
+        return -1;
+    }
+
+    uint32_t payload_len = session_payload_len(session);
+    uint32_t total = record_space(payload_len);
+
+    if (total > _size) {
+        return -1;
+    }
+
+    uint8_t *buf = (uint8_t *) mbedtls_calloc(1, total);
+    if (buf == NULL) {
+        return -1;
+    }
+
+    session_serialize(session, buf + STORE_HEADER_LEN);
+
+    w32(buf + 0, STORE_MAGIC);
+    w32(buf + 4, _seq);
+    w32(buf + 8, payload_len);
+    w32(buf + 12, store_crc32(buf + STORE_HEADER_LEN, payload_len));
+
+    /* Out of room (or dirty region): recycle it. This is the only time
+     * anything is erased, so wear is spread over the whole region. */
+    if (_next_off + total > _size) {
+        ret = _flash.erase(_addr, _size);
+        if (ret != 0) {
+            goto out;
+        }
+        _next_off = 0;
+        _latest_len = 0;
+    }
+
+    /* Program in pieces - page program must not cross a sector boundary */
+    {
+        uint32_t addr = _addr + _next_off;
+        uint32_t left = total;
+        const uint8_t *p = buf;
+
+        while (left > 0) {
+            uint32_t sector_size = _flash.get_sector_size(addr);
+            uint32_t sector_end = (addr / sector_size + 1) * sector_size;
+            uint32_t chunk = sector_end - addr;
+            if (chunk > left) {
+                chunk = left;
+            }
+
+            ret = _flash.program(p, addr, chunk);
+            if (ret != 0) {
+                goto out;
+            }
+
+            addr += chunk;
+            p += chunk;
+            left -= chunk;
+        }
+    }
+
+    _latest_off = _next_off;
+    _latest_len = payload_len;
+    _next_off += total;
+    _seq++;
+
+out:
+    memset(buf, 0, total);
+    mbedtls_free(buf);
+
+    return ret;
+}
+
+int TLSSessionStore::load(mbedtls_ssl_session *session)
+{
+    int ret;
+
+    if (!_inited || _latest_len == 0) {
+        return -1;
+    }
+
+    uint8_t *payload = (uint8_t *) mbedtls_calloc(1, _latest_len);
+    if (payload == NULL) {
+        return -1;
+    }
+
+    ret = _flash.read(payload, _addr + _latest_off + STORE_HEADER_LEN,
+                      _latest_len);
+    if (ret == 0) {
+        ret = session_deserialize(session, payload, _latest_len);
+    }
+
+    memset(payload, 0, _latest_len);
+    mbedtls_free(payload);
+
+    return ret;
+}
+
+int TLSSessionStore::clear()
+{
+    int ret;
+
+    if (!_inited) {
+        return -1;
+    }
+
+    ret = _flash.erase(_addr, _size);
+    if (ret == 0) {
+        _next_off = 0;
+        _latest_len = 0;
+        _seq = 0;
+    }
+
+    return ret;
+}
+
+} // namespace mbed
+
+#endif /* MBEDTLS_SSL_TLS_C && DEVICE_FLASH */
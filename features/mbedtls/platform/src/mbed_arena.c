@@ -0,0 +1,68 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_MBED_ARENA_SIZE)
+
+#include "mbed_arena.h"
+#include "mbedtls/memory_buffer_alloc.h"
+
+/* Lives in .bss, so TLS memory is accounted at link time instead of
+ * competing with the runtime heap */
+static unsigned char mbed_tls_arena[MBEDTLS_MBED_ARENA_SIZE];
+static int mbed_tls_arena_inited = 0;
+
+void mbed_tls_arena_init( void )
+{
+    if( mbed_tls_arena_inited )
+        return;
+
+    mbed_tls_arena_inited = 1;
+    mbedtls_memory_buffer_alloc_init( mbed_tls_arena, sizeof( mbed_tls_arena ) );
+}
+
+size_t mbed_tls_arena_peak( void )
+{
+#if defined(MBEDTLS_MEMORY_DEBUG)
+    size_t max_used = 0;
+    size_t max_blocks = 0;
+
+    mbedtls_memory_buffer_alloc_max_get( &max_used, &max_blocks );
+    return( max_used );
+#else
+    return( 0 );
+#endif
+}
+
+size_t mbed_tls_arena_used( void )
+{
+#if defined(MBEDTLS_MEMORY_DEBUG)
+    size_t cur_used = 0;
+    size_t cur_blocks = 0;
+
+    mbedtls_memory_buffer_alloc_cur_get( &cur_used, &cur_blocks );
+    return( cur_used );
+#else
+    return( 0 );
+#endif
+}
+
+#endif /* MBEDTLS_MBED_ARENA_SIZE */
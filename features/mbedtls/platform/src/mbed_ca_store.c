@@ -0,0 +1,143 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_ca_store.h"
+
+#if defined(MBED_CA_STORE) && defined(MBEDTLS_X509_CRT_PARSE_C)
+
+#include <string.h>
+
+/* Must match fnv1a() in mbed_ca_store_gen.py */
+static unsigned long ca_store_hash(const unsigned char *buf, size_t len)
+{
+    unsigned long h = 0x811c9dc5ul;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        h = ((h ^ buf[i]) * 0x01000193ul) & 0xfffffffful;
+    }
+
+    return h;
+}
+
+int mbed_ca_store_find(const unsigned char *name_raw, size_t name_len,
+                       const unsigned char **der, size_t *der_len)
+{
+    unsigned long hash = ca_store_hash(name_raw, name_len);
+    size_t lo = 0;
+    size_t hi = mbed_ca_store_entry_count;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (mbed_ca_store_entries[mid].subject_hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    /* Walk all entries sharing the hash and confirm with a real compare */
+    for (; lo < mbed_ca_store_entry_count &&
+           mbed_ca_store_entries[lo].subject_hash == hash; lo++) {
+        const mbed_ca_store_entry_t *entry = &mbed_ca_store_entries[lo];
+
+        if (entry->subject_len == name_len &&
+            memcmp(entry->der + entry->subject_off, name_raw, name_len) == 0) {
+            *der = entry->der;
+            *der_len = entry->der_len;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+int mbed_ca_store_parent_of(const mbedtls_x509_crt *child,
+                            mbedtls_x509_crt *parent)
+{
+    const unsigned char *der;
+    size_t der_len;
+
+    if (mbed_ca_store_find(child->issuer_raw.p, child->issuer_raw.len,
+                           &der, &der_len) != 0) {
+        return -1;
+    }
+
+    return mbedtls_x509_crt_parse_der(parent, der, der_len);
+}
+
+int mbed_ca_store_chain_for(const mbedtls_x509_crt *chain,
+                            mbedtls_x509_crt *trust)
+{
+    const mbedtls_x509_crt *cur = chain;
+    size_t depth;
+    int found = 0;
+    int ret;
+
+    /* Start from the last certificate the peer presented */
+    while (cur->next != NULL) {
+        cur = cur->next;
+    }
+
+    /* Follow issuers inside the store; entry_count bounds the walk so a
+     * cross-signed loop cannot run forever */
+    for (depth = 0; depth < mbed_ca_store_entry_count; depth++) {
+        /* Self-signed: the root is already in the list, stop */
+        if (found &&
+            cur->issuer_raw.len == cur->subject_raw.len &&
+            memcmp(cur->issuer_raw.p, cur->subject_raw.p,
+                   cur->subject_raw.len) == 0) {
+            break;
+        }
+
+        ret = mbed_ca_store_parent_of(cur, trust);
+        if (ret < -1) {
+            return ret;
+        }
+        if (ret != 0) {
+            break;
+        }
+
+        found = 1;
+
+        cur = trust;
+        while (cur->next != NULL) {
+            cur = cur->next;
+        }
+    }
+
+    return found ? 0 : -1;
+}
+
+int mbed_ca_store_load_all(mbedtls_x509_crt *trust)
+{
+    size_t i;
+    int ret;
+
+    for (i = 0; i < mbed_ca_store_entry_count; i++) {
+        ret = mbedtls_x509_crt_parse_der(trust,
+                                         mbed_ca_store_entries[i].der,
+                                         mbed_ca_store_entries[i].der_len);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+#endif /* MBED_CA_STORE && MBEDTLS_X509_CRT_PARSE_C */
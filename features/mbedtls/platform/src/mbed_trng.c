@@ -18,7 +18,18 @@
 
 #include "hal/trng_api.h"
 
+#if defined(MBED_TRNG_POOL_SIZE)
+#include "mbed_trng_pool.h"
+#endif
+
 int mbedtls_hardware_poll( void *data, unsigned char *output, size_t len, size_t *olen ) {
+#if defined(MBED_TRNG_POOL_SIZE)
+    /* Serve from the background-filled pool when it has anything to give;
+     * only a drained pool falls through to a blocking TRNG read */
+    if (mbed_trng_pool_read(output, len, olen) == 0) {
+        return 0;
+    }
+#endif
     trng_t trng_obj;
     trng_init(&trng_obj);
     int ret = trng_get_bytes(&trng_obj, output, len, olen);
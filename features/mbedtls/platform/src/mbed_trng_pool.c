@@ -0,0 +1,121 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(DEVICE_TRNG) && defined(MBED_TRNG_POOL_SIZE)
+
+#include "mbed_trng_pool.h"
+#include "hal/trng_api.h"
+#include "platform/mbed_critical.h"
+
+#include <string.h>
+
+/* TRNG bytes requested per fill; one idle-loop pass tops up at most this much */
+#ifndef MBED_TRNG_POOL_CHUNK
+#define MBED_TRNG_POOL_CHUNK 32
+#endif
+
+/* Ring buffer: the idle thread produces at the tail, entropy requests
+ * consume at the head. Index updates happen in critical sections; the
+ * slow TRNG read itself runs outside them. */
+static unsigned char trng_pool[MBED_TRNG_POOL_SIZE];
+static size_t trng_pool_head;
+static size_t trng_pool_count;
+
+void mbed_trng_pool_fill(void)
+{
+    trng_t trng_obj;
+    unsigned char chunk[MBED_TRNG_POOL_CHUNK];
+    size_t space, n, got, tail;
+    int ret;
+
+    core_util_critical_section_enter();
+    space = sizeof(trng_pool) - trng_pool_count;
+    core_util_critical_section_exit();
+
+    if (space == 0) {
+        return;
+    }
+
+    n = space < sizeof(chunk) ? space : sizeof(chunk);
+
+    got = 0;
+    trng_init(&trng_obj);
+    ret = trng_get_bytes(&trng_obj, chunk, n, &got);
+    trng_free(&trng_obj);
+
+    if (ret != 0 || got == 0) {
+        return;
+    }
+
+    core_util_critical_section_enter();
+    /* Space may have shrunk while the TRNG was busy - never overwrite */
+    space = sizeof(trng_pool) - trng_pool_count;
+    if (got > space) {
+        got = space;
+    }
+    tail = (trng_pool_head + trng_pool_count) % sizeof(trng_pool);
+    for (n = 0; n < got; n++) {
+        trng_pool[tail] = chunk[n];
+        tail = (tail + 1) % sizeof(trng_pool);
+    }
+    trng_pool_count += got;
+    core_util_critical_section_exit();
+
+    memset(chunk, 0, sizeof(chunk));
+}
+
+int mbed_trng_pool_read(unsigned char *output, size_t len, size_t *olen)
+{
+    size_t n, i;
+
+    core_util_critical_section_enter();
+    if (trng_pool_count == 0) {
+        core_util_critical_section_exit();
+        *olen = 0;
+        return -1;
+    }
+
+    n = len < trng_pool_count ? len : trng_pool_count;
+    for (i = 0; i < n; i++) {
+        output[i] = trng_pool[trng_pool_head];
+        trng_pool[trng_pool_head] = 0;
+        trng_pool_head = (trng_pool_head + 1) % sizeof(trng_pool);
+    }
+    trng_pool_count -= n;
+    core_util_critical_section_exit();
+
+    *olen = n;
+    return 0;
+}
+
+size_t mbed_trng_pool_available(void)
+{
+    size_t count;
+
+    core_util_critical_section_enter();
+    count = trng_pool_count;
+    core_util_critical_section_exit();
+
+    return count;
+}
+
+/* Called by the RTOS idle loop whenever the system is about to sleep */
+void mbed_idle_background_hook(void)
+{
+    mbed_trng_pool_fill();
+}
+
+#endif /* DEVICE_TRNG && MBED_TRNG_POOL_SIZE */
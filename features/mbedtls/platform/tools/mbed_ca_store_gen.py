@@ -0,0 +1,151 @@
+#!/usr/bin/env python
+"""
+mbed_ca_store_gen.py - compile trusted CA certificates into an indexed
+const table for mbed_ca_store.
+
+Copyright (c) 2017 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Usage:
+    python mbed_ca_store_gen.py -o mbed_ca_store_data.c ca1.pem ca2.der ...
+
+Each input may be a DER certificate or a PEM file holding one or more
+certificates. The output is a C file placing the DER blobs in flash
+together with an index sorted by a 32-bit FNV-1a hash of each
+certificate's subject Name element, so mbed_ca_store_find() can locate
+an issuer with a binary search and parse a single certificate instead
+of the whole bundle. Build the generated file into the image and define
+MBED_CA_STORE.
+"""
+
+import argparse
+import base64
+import re
+import sys
+
+PEM_RE = re.compile(
+    r"-----BEGIN CERTIFICATE-----(.*?)-----END CERTIFICATE-----", re.S)
+
+FNV_BASIS = 0x811c9dc5
+FNV_PRIME = 0x01000193
+
+
+def fnv1a(data):
+    h = FNV_BASIS
+    for byte in bytearray(data):
+        h = ((h ^ byte) * FNV_PRIME) & 0xffffffff
+    return h
+
+
+def read_tlv(der, off):
+    """Return (tag, header_len, content_len) of the DER element at off"""
+    tag = bytearray(der)[off]
+    first = bytearray(der)[off + 1]
+    if first & 0x80:
+        n = first & 0x7f
+        length = 0
+        for byte in bytearray(der)[off + 2:off + 2 + n]:
+            length = (length << 8) | byte
+        return tag, 2 + n, length
+    return tag, 2, first
+
+
+def subject_tlv(der):
+    """Return (offset, length) of the subject Name element, tag included"""
+    tag, hdr, _ = read_tlv(der, 0)
+    if tag != 0x30:
+        raise ValueError("not a DER SEQUENCE")
+    # TBSCertificate
+    tag, tbs_hdr, _ = read_tlv(der, hdr)
+    if tag != 0x30:
+        raise ValueError("no TBSCertificate")
+    off = hdr + tbs_hdr
+    # [0] version (optional), serial, signature, issuer, validity, subject
+    fields = []
+    while len(fields) < 6:
+        tag, fhdr, flen = read_tlv(der, off)
+        fields.append((off, fhdr + flen, tag))
+        off += fhdr + flen
+    if fields[0][2] == 0xa0:
+        sub = fields[5]
+    else:
+        sub = fields[4]
+    return sub[0], sub[1]
+
+
+def load_certs(paths):
+    certs = []
+    for path in paths:
+        with open(path, "rb") as infile:
+            raw = infile.read()
+        blocks = PEM_RE.findall(raw.decode("ascii", "ignore"))
+        if blocks:
+            for block in blocks:
+                certs.append(base64.b64decode("".join(block.split())))
+        else:
+            certs.append(raw)
+    return certs
+
+
+def emit(certs, out):
+    out.write("/* Autogenerated by mbed_ca_store_gen.py - do not edit */\n")
+    out.write("#include \"mbed_ca_store.h\"\n\n")
+    out.write("#if defined(MBED_CA_STORE)\n\n")
+
+    entries = []
+    for idx, der in enumerate(certs):
+        sub_off, sub_len = subject_tlv(der)
+        entries.append((fnv1a(der[sub_off:sub_off + sub_len]),
+                        idx, sub_off, sub_len, der))
+
+    for _, idx, _, _, der in entries:
+        out.write("static const unsigned char ca%d_der[] = {" % idx)
+        for i, byte in enumerate(bytearray(der)):
+            if i % 12 == 0:
+                out.write("\n    ")
+            out.write("0x%02x, " % byte)
+        out.write("\n};\n\n")
+
+    out.write("const mbed_ca_store_entry_t mbed_ca_store_entries[] = {\n")
+    for shash, idx, sub_off, sub_len, der in sorted(entries):
+        out.write("    { 0x%08xul, ca%d_der, %d, %d, %d },\n" %
+                  (shash, idx, len(der), sub_off, sub_len))
+    out.write("};\n\n")
+    out.write("const size_t mbed_ca_store_entry_count =\n"
+              "    sizeof( mbed_ca_store_entries ) /"
+              " sizeof( mbed_ca_store_entries[0] );\n\n")
+    out.write("#endif /* MBED_CA_STORE */\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Generate an indexed const CA store from certificates")
+    parser.add_argument("-o", "--output", required=True,
+                        help="output C file")
+    parser.add_argument("certs", nargs="+",
+                        help="input certificates (PEM or DER)")
+    args = parser.parse_args()
+
+    certs = load_certs(args.certs)
+    if not certs:
+        sys.stderr.write("no certificates found\n")
+        return 1
+
+    with open(args.output, "w") as out:
+        emit(certs, out)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -278,6 +278,265 @@ cleanup:
     return( ret );
 }
 
+#if defined(MBEDTLS_ECP_INCREMENTAL)
+/*
+ * Incremental sign/verify: the scalar multiplications run through the
+ * incremental ECP interface a slice at a time, the cheap MPI arithmetic
+ * around them runs in the first or last slice. The math and the retry and
+ * blinding logic are the same as in the one-shot functions above.
+ */
+
+/* Internal values of ctx->state */
+#define ECDSA_INC_FRESH         0
+#define ECDSA_INC_SIGN_MUL      1
+#define ECDSA_INC_VERIFY_MULADD 2
+
+void mbedtls_ecdsa_inc_init( mbedtls_ecdsa_inc_context *ctx )
+{
+    ctx->state = ECDSA_INC_FRESH;
+    ctx->key_tries = 0;
+    ctx->sign_tries = 0;
+    mbedtls_mpi_init( &ctx->k );
+    mbedtls_mpi_init( &ctx->u1 ); mbedtls_mpi_init( &ctx->u2 );
+    mbedtls_ecp_point_init( &ctx->R );
+    mbedtls_ecp_mul_inc_init( &ctx->mul );
+    mbedtls_ecp_muladd_inc_init( &ctx->muladd );
+}
+
+void mbedtls_ecdsa_inc_free( mbedtls_ecdsa_inc_context *ctx )
+{
+    if( ctx == NULL )
+        return;
+
+    mbedtls_mpi_free( &ctx->k );
+    mbedtls_mpi_free( &ctx->u1 ); mbedtls_mpi_free( &ctx->u2 );
+    mbedtls_ecp_point_free( &ctx->R );
+    mbedtls_ecp_mul_inc_free( &ctx->mul );
+    mbedtls_ecp_muladd_inc_free( &ctx->muladd );
+
+    ctx->state = ECDSA_INC_FRESH;
+    ctx->key_tries = 0;
+    ctx->sign_tries = 0;
+}
+
+int mbedtls_ecdsa_sign_inc( mbedtls_ecp_group *grp,
+                mbedtls_ecdsa_inc_context *ctx,
+                mbedtls_mpi *r, mbedtls_mpi *s,
+                const mbedtls_mpi *d, const unsigned char *buf, size_t blen,
+                int (*f_rng)(void *, unsigned char *, size_t), void *p_rng,
+                size_t max_steps )
+{
+    int ret, key_tries, blind_tries;
+    mbedtls_mpi e, t;
+
+    /* Fail cleanly on curves such as Curve25519 that can't be used for ECDSA */
+    if( grp->N.p == NULL )
+        return( MBEDTLS_ERR_ECP_BAD_INPUT_DATA );
+
+    mbedtls_mpi_init( &e ); mbedtls_mpi_init( &t );
+
+    if( ctx->state == ECDSA_INC_FRESH )
+    {
+        /*
+         * Steps 1-2: generate a suitable ephemeral scalar.
+         * r = xR can only be checked once the multiplication finishes, so
+         * a zero r restarts from here via the key_tries counter instead of
+         * the inner loop of mbedtls_ecdsa_sign().
+         */
+        key_tries = 0;
+        do
+        {
+            size_t n_size = ( grp->nbits + 7 ) / 8;
+            MBEDTLS_MPI_CHK( mbedtls_mpi_fill_random( &ctx->k, n_size,
+                                                      f_rng, p_rng ) );
+            MBEDTLS_MPI_CHK( mbedtls_mpi_shift_r( &ctx->k,
+                                                  8 * n_size - grp->nbits ) );
+
+            if( ++key_tries > 30 )
+            {
+                ret = MBEDTLS_ERR_ECP_RANDOM_FAILED;
+                goto cleanup;
+            }
+        }
+        while( mbedtls_mpi_cmp_int( &ctx->k, 1 ) < 0 ||
+               mbedtls_mpi_cmp_mpi( &ctx->k, &grp->N ) >= 0 );
+
+        ctx->state = ECDSA_INC_SIGN_MUL;
+    }
+
+    /*
+     * Step 3: R = k G, a slice at a time
+     */
+    ret = mbedtls_ecp_mul_inc( grp, &ctx->mul, &ctx->R, &ctx->k, &grp->G,
+                               f_rng, p_rng, max_steps );
+    if( ret == MBEDTLS_ERR_ECP_IN_PROGRESS )
+    {
+        mbedtls_mpi_free( &e ); mbedtls_mpi_free( &t );
+        return( ret );
+    }
+    if( ret != 0 )
+        goto cleanup;
+
+    MBEDTLS_MPI_CHK( mbedtls_mpi_mod_mpi( r, &ctx->R.X, &grp->N ) );
+
+    if( mbedtls_mpi_cmp_int( r, 0 ) == 0 )
+    {
+        if( ++ctx->key_tries > 10 )
+        {
+            ret = MBEDTLS_ERR_ECP_RANDOM_FAILED;
+            goto cleanup;
+        }
+
+        ctx->state = ECDSA_INC_FRESH;
+        mbedtls_mpi_free( &e ); mbedtls_mpi_free( &t );
+        return( MBEDTLS_ERR_ECP_IN_PROGRESS );
+    }
+
+    /*
+     * Step 5: derive MPI from hashed message
+     */
+    MBEDTLS_MPI_CHK( derive_mpi( grp, &e, buf, blen ) );
+
+    /*
+     * Generate a random value to blind inv_mod in next step,
+     * avoiding a potential timing leak.
+     */
+    blind_tries = 0;
+    do
+    {
+        size_t n_size = ( grp->nbits + 7 ) / 8;
+        MBEDTLS_MPI_CHK( mbedtls_mpi_fill_random( &t, n_size, f_rng, p_rng ) );
+        MBEDTLS_MPI_CHK( mbedtls_mpi_shift_r( &t, 8 * n_size - grp->nbits ) );
+
+        if( ++blind_tries > 30 )
+        {
+            ret = MBEDTLS_ERR_ECP_RANDOM_FAILED;
+            goto cleanup;
+        }
+    }
+    while( mbedtls_mpi_cmp_int( &t, 1 ) < 0 ||
+           mbedtls_mpi_cmp_mpi( &t, &grp->N ) >= 0 );
+
+    /*
+     * Step 6: compute s = (e + r * d) / k = t (e + rd) / (kt) mod n
+     */
+    MBEDTLS_MPI_CHK( mbedtls_mpi_mul_mpi( s, r, d ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_add_mpi( &e, &e, s ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_mul_mpi( &e, &e, &t ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_mul_mpi( &ctx->k, &ctx->k, &t ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_inv_mod( s, &ctx->k, &grp->N ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_mul_mpi( s, s, &e ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_mod_mpi( s, s, &grp->N ) );
+
+    if( mbedtls_mpi_cmp_int( s, 0 ) == 0 )
+    {
+        if( ++ctx->sign_tries > 10 )
+        {
+            ret = MBEDTLS_ERR_ECP_RANDOM_FAILED;
+            goto cleanup;
+        }
+
+        ctx->state = ECDSA_INC_FRESH;
+        mbedtls_mpi_free( &e ); mbedtls_mpi_free( &t );
+        return( MBEDTLS_ERR_ECP_IN_PROGRESS );
+    }
+
+cleanup:
+    mbedtls_mpi_free( &e ); mbedtls_mpi_free( &t );
+    mbedtls_ecdsa_inc_free( ctx );
+
+    return( ret );
+}
+
+int mbedtls_ecdsa_verify_inc( mbedtls_ecp_group *grp,
+                mbedtls_ecdsa_inc_context *ctx,
+                const unsigned char *buf, size_t blen,
+                const mbedtls_ecp_point *Q,
+                const mbedtls_mpi *r, const mbedtls_mpi *s,
+                size_t max_steps )
+{
+    int ret;
+    mbedtls_mpi e, s_inv;
+
+    mbedtls_mpi_init( &e ); mbedtls_mpi_init( &s_inv );
+
+    /* Fail cleanly on curves such as Curve25519 that can't be used for ECDSA */
+    if( grp->N.p == NULL )
+        return( MBEDTLS_ERR_ECP_BAD_INPUT_DATA );
+
+    if( ctx->state == ECDSA_INC_FRESH )
+    {
+        /*
+         * Step 1: make sure r and s are in range 1..n-1
+         */
+        if( mbedtls_mpi_cmp_int( r, 1 ) < 0 ||
+            mbedtls_mpi_cmp_mpi( r, &grp->N ) >= 0 ||
+            mbedtls_mpi_cmp_int( s, 1 ) < 0 ||
+            mbedtls_mpi_cmp_mpi( s, &grp->N ) >= 0 )
+        {
+            ret = MBEDTLS_ERR_ECP_VERIFY_FAILED;
+            goto cleanup;
+        }
+
+        /*
+         * Additional precaution: make sure Q is valid
+         */
+        MBEDTLS_MPI_CHK( mbedtls_ecp_check_pubkey( grp, Q ) );
+
+        /*
+         * Steps 3-4: u1 = e / s mod n, u2 = r / s mod n
+         */
+        MBEDTLS_MPI_CHK( derive_mpi( grp, &e, buf, blen ) );
+
+        MBEDTLS_MPI_CHK( mbedtls_mpi_inv_mod( &s_inv, s, &grp->N ) );
+
+        MBEDTLS_MPI_CHK( mbedtls_mpi_mul_mpi( &ctx->u1, &e, &s_inv ) );
+        MBEDTLS_MPI_CHK( mbedtls_mpi_mod_mpi( &ctx->u1, &ctx->u1, &grp->N ) );
+
+        MBEDTLS_MPI_CHK( mbedtls_mpi_mul_mpi( &ctx->u2, r, &s_inv ) );
+        MBEDTLS_MPI_CHK( mbedtls_mpi_mod_mpi( &ctx->u2, &ctx->u2, &grp->N ) );
+
+        ctx->state = ECDSA_INC_VERIFY_MULADD;
+    }
+
+    /*
+     * Step 5: R = u1 G + u2 Q, a slice at a time
+     */
+    ret = mbedtls_ecp_muladd_inc( grp, &ctx->muladd, &ctx->R,
+                                  &ctx->u1, &grp->G, &ctx->u2, Q, max_steps );
+    if( ret == MBEDTLS_ERR_ECP_IN_PROGRESS )
+    {
+        mbedtls_mpi_free( &e ); mbedtls_mpi_free( &s_inv );
+        return( ret );
+    }
+    if( ret != 0 )
+        goto cleanup;
+
+    if( mbedtls_ecp_is_zero( &ctx->R ) )
+    {
+        ret = MBEDTLS_ERR_ECP_VERIFY_FAILED;
+        goto cleanup;
+    }
+
+    /*
+     * Steps 6-8: reduce xR mod n and check it against r
+     */
+    MBEDTLS_MPI_CHK( mbedtls_mpi_mod_mpi( &ctx->R.X, &ctx->R.X, &grp->N ) );
+
+    if( mbedtls_mpi_cmp_mpi( &ctx->R.X, r ) != 0 )
+    {
+        ret = MBEDTLS_ERR_ECP_VERIFY_FAILED;
+        goto cleanup;
+    }
+
+cleanup:
+    mbedtls_mpi_free( &e ); mbedtls_mpi_free( &s_inv );
+    mbedtls_ecdsa_inc_free( ctx );
+
+    return( ret );
+}
+#endif /* MBEDTLS_ECP_INCREMENTAL */
+
 /*
  * Convert a signature (given by context) to ASN.1
  */
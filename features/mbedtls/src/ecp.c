@@ -67,6 +67,10 @@
 
 #include "mbedtls/ecp_internal.h"
 
+#if defined(MBEDTLS_ECP_STATIC_COMB)
+#include "mbedtls/ecp_static_comb.h"
+#endif
+
 #if ( defined(__ARMCC_VERSION) || defined(_MSC_VER) ) && \
     !defined(inline) && !defined(__cplusplus)
 #define inline __inline
@@ -1407,6 +1411,15 @@ static int ecp_mul_comb( mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
      */
     T = p_eq_g ? grp->T : NULL;
 
+#if defined(MBEDTLS_ECP_STATIC_COMB)
+    /*
+     * For the generator, a table may already exist in flash. It is only
+     * used locally and never stored into grp->T, which must stay freeable.
+     */
+    if( T == NULL && p_eq_g )
+        T = (mbedtls_ecp_point *) mbedtls_ecp_static_comb_table( grp, w, d );
+#endif
+
     if( T == NULL )
     {
         T = mbedtls_calloc( pre_len, sizeof( mbedtls_ecp_point ) );
@@ -1464,6 +1477,256 @@ cleanup:
     return( ret );
 }
 
+#if defined(MBEDTLS_ECP_INCREMENTAL)
+/*
+ * Incremental variant of the comb method: the setup (precomputation and comb
+ * recoding) runs on the first call, then each call advances the main loop of
+ * ecp_mul_comb_core() by at most max_steps digits, so long multiplications
+ * can be interleaved with latency-sensitive work. The sequence of point
+ * operations is identical to the one-shot path, so the timing countermeasures
+ * are unchanged.
+ */
+
+/* Internal values of ctx->state */
+#define ECP_MUL_INC_FRESH       0
+#define ECP_MUL_INC_RUNNING     1
+
+void mbedtls_ecp_mul_inc_init( mbedtls_ecp_mul_inc_context *ctx )
+{
+    memset( ctx, 0, sizeof( mbedtls_ecp_mul_inc_context ) );
+    mbedtls_ecp_point_init( &ctx->R );
+}
+
+void mbedtls_ecp_mul_inc_free( mbedtls_ecp_mul_inc_context *ctx )
+{
+    unsigned char i;
+
+    if( ctx == NULL )
+        return;
+
+    if( ctx->T != NULL && ctx->T_is_heap )
+    {
+        for( i = 0; i < ctx->pre_len; i++ )
+            mbedtls_ecp_point_free( &ctx->T[i] );
+        mbedtls_free( ctx->T );
+    }
+
+    mbedtls_ecp_point_free( &ctx->R );
+
+    ctx->T = NULL;
+    ctx->T_is_heap = 0;
+    ctx->state = ECP_MUL_INC_FRESH;
+}
+
+/*
+ * Setup: everything ecp_mul_comb() does before its main loop
+ */
+static int ecp_mul_inc_start( mbedtls_ecp_group *grp,
+                              mbedtls_ecp_mul_inc_context *ctx,
+                              const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+                              int (*f_rng)(void *, unsigned char *, size_t),
+                              void *p_rng )
+{
+    int ret;
+    mbedtls_mpi M, mm;
+
+    mbedtls_mpi_init( &M );
+    mbedtls_mpi_init( &mm );
+
+    if( mbedtls_mpi_get_bit( &grp->N, 0 ) != 1 )
+        return( MBEDTLS_ERR_ECP_BAD_INPUT_DATA );
+
+    /* Window and comb sizes exactly as in ecp_mul_comb() */
+    ctx->w = grp->nbits >= 384 ? 5 : 4;
+
+#if MBEDTLS_ECP_FIXED_POINT_OPTIM == 1
+    ctx->p_eq_g = ( mbedtls_mpi_cmp_mpi( &P->Y, &grp->G.Y ) == 0 &&
+                    mbedtls_mpi_cmp_mpi( &P->X, &grp->G.X ) == 0 );
+    if( ctx->p_eq_g )
+        ctx->w++;
+#else
+    ctx->p_eq_g = 0;
+#endif
+
+    if( ctx->w > MBEDTLS_ECP_WINDOW_SIZE )
+        ctx->w = MBEDTLS_ECP_WINDOW_SIZE;
+    if( ctx->w >= grp->nbits )
+        ctx->w = 2;
+
+    ctx->pre_len = 1U << ( ctx->w - 1 );
+    ctx->d = ( grp->nbits + ctx->w - 1 ) / ctx->w;
+
+    ctx->T = ctx->p_eq_g ? grp->T : NULL;
+    ctx->T_is_heap = 0;
+
+#if defined(MBEDTLS_ECP_STATIC_COMB)
+    if( ctx->T == NULL && ctx->p_eq_g )
+        ctx->T = (mbedtls_ecp_point *) mbedtls_ecp_static_comb_table( grp,
+                                                            ctx->w, ctx->d );
+#endif
+
+    if( ctx->T == NULL )
+    {
+        ctx->T = mbedtls_calloc( ctx->pre_len, sizeof( mbedtls_ecp_point ) );
+        if( ctx->T == NULL )
+        {
+            ret = MBEDTLS_ERR_ECP_ALLOC_FAILED;
+            goto cleanup;
+        }
+        ctx->T_is_heap = 1;
+
+        MBEDTLS_MPI_CHK( ecp_precompute_comb( grp, ctx->T, P, ctx->w, ctx->d ) );
+
+        if( ctx->p_eq_g )
+        {
+            /* Hand the table over to the group cache, as ecp_mul_comb() does */
+            grp->T = ctx->T;
+            grp->T_size = ctx->pre_len;
+            ctx->T_is_heap = 0;
+        }
+    }
+
+    /* Make sure M is odd, using m * P = - (N - m) * P */
+    ctx->m_is_odd = ( mbedtls_mpi_get_bit( m, 0 ) == 1 );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_copy( &M, m ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_sub_mpi( &mm, &grp->N, m ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_safe_cond_assign( &M, &mm, ! ctx->m_is_odd ) );
+
+    ecp_comb_fixed( ctx->k, ctx->d, ctx->w, &M );
+
+    /* First iteration of ecp_mul_comb_core(): non-zero start, randomized */
+    ctx->i = ctx->d;
+    MBEDTLS_MPI_CHK( ecp_select_comb( grp, &ctx->R, ctx->T, ctx->pre_len,
+                                      ctx->k[ctx->i] ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_lset( &ctx->R.Z, 1 ) );
+    if( f_rng != 0 )
+        MBEDTLS_MPI_CHK( ecp_randomize_jac( grp, &ctx->R, f_rng, p_rng ) );
+
+    ctx->state = ECP_MUL_INC_RUNNING;
+
+cleanup:
+    mbedtls_mpi_free( &M );
+    mbedtls_mpi_free( &mm );
+
+    return( ret );
+}
+
+int mbedtls_ecp_mul_inc( mbedtls_ecp_group *grp,
+             mbedtls_ecp_mul_inc_context *ctx, mbedtls_ecp_point *R,
+             const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+             int (*f_rng)(void *, unsigned char *, size_t), void *p_rng,
+             size_t max_steps )
+{
+    int ret = 0;
+    size_t steps = 0;
+    mbedtls_ecp_point Txi;
+
+    mbedtls_ecp_point_init( &Txi );
+
+    if( ctx->state == ECP_MUL_INC_FRESH )
+    {
+        /* Same sanity checks as mbedtls_ecp_mul() */
+        if( mbedtls_mpi_cmp_int( &P->Z, 1 ) != 0 )
+            return( MBEDTLS_ERR_ECP_BAD_INPUT_DATA );
+
+        if( ecp_get_type( grp ) != ECP_TYPE_SHORT_WEIERSTRASS )
+            return( MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE );
+
+        if( ( ret = mbedtls_ecp_check_privkey( grp, m ) ) != 0 ||
+            ( ret = mbedtls_ecp_check_pubkey( grp, P ) ) != 0 )
+            return( ret );
+
+        MBEDTLS_MPI_CHK( ecp_mul_inc_start( grp, ctx, m, P, f_rng, p_rng ) );
+    }
+
+    /* Main loop of ecp_mul_comb_core(), at most max_steps digits at a time */
+    while( ctx->i != 0 && steps++ < max_steps )
+    {
+        ctx->i--;
+        MBEDTLS_MPI_CHK( ecp_double_jac( grp, &ctx->R, &ctx->R ) );
+        MBEDTLS_MPI_CHK( ecp_select_comb( grp, &Txi, ctx->T, ctx->pre_len,
+                                          ctx->k[ctx->i] ) );
+        MBEDTLS_MPI_CHK( ecp_add_mixed( grp, &ctx->R, &ctx->R, &Txi ) );
+    }
+
+    if( ctx->i != 0 )
+    {
+        mbedtls_ecp_point_free( &Txi );
+        return( MBEDTLS_ERR_ECP_IN_PROGRESS );
+    }
+
+    /* Tail of ecp_mul_comb(): recover m * P from M * P and normalize */
+    MBEDTLS_MPI_CHK( ecp_safe_invert_jac( grp, &ctx->R, ! ctx->m_is_odd ) );
+    MBEDTLS_MPI_CHK( ecp_normalize_jac( grp, &ctx->R ) );
+    MBEDTLS_MPI_CHK( mbedtls_ecp_copy( R, &ctx->R ) );
+
+cleanup:
+    mbedtls_ecp_point_free( &Txi );
+    mbedtls_ecp_mul_inc_free( ctx );
+
+    return( ret );
+}
+
+void mbedtls_ecp_muladd_inc_init( mbedtls_ecp_muladd_inc_context *ctx )
+{
+    ctx->phase = 0;
+    mbedtls_ecp_mul_inc_init( &ctx->mul );
+    mbedtls_ecp_point_init( &ctx->mP );
+}
+
+void mbedtls_ecp_muladd_inc_free( mbedtls_ecp_muladd_inc_context *ctx )
+{
+    if( ctx == NULL )
+        return;
+
+    mbedtls_ecp_mul_inc_free( &ctx->mul );
+    mbedtls_ecp_point_free( &ctx->mP );
+    ctx->phase = 0;
+}
+
+int mbedtls_ecp_muladd_inc( mbedtls_ecp_group *grp,
+             mbedtls_ecp_muladd_inc_context *ctx, mbedtls_ecp_point *R,
+             const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+             const mbedtls_mpi *n, const mbedtls_ecp_point *Q,
+             size_t max_steps )
+{
+    int ret;
+
+    if( ecp_get_type( grp ) != ECP_TYPE_SHORT_WEIERSTRASS )
+        return( MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE );
+
+    /* As in mbedtls_ecp_muladd(): public values, so no blinding RNG */
+    if( ctx->phase == 0 )
+    {
+        ret = mbedtls_ecp_mul_inc( grp, &ctx->mul, &ctx->mP, m, P,
+                                   NULL, NULL, max_steps );
+        if( ret == MBEDTLS_ERR_ECP_IN_PROGRESS )
+            return( ret );
+        if( ret != 0 )
+            goto cleanup;
+
+        ctx->phase = 1;
+        return( MBEDTLS_ERR_ECP_IN_PROGRESS );
+    }
+
+    ret = mbedtls_ecp_mul_inc( grp, &ctx->mul, R, n, Q,
+                               NULL, NULL, max_steps );
+    if( ret == MBEDTLS_ERR_ECP_IN_PROGRESS )
+        return( ret );
+    if( ret != 0 )
+        goto cleanup;
+
+    MBEDTLS_MPI_CHK( ecp_add_mixed( grp, R, &ctx->mP, R ) );
+    MBEDTLS_MPI_CHK( ecp_normalize_jac( grp, R ) );
+
+cleanup:
+    mbedtls_ecp_muladd_inc_free( ctx );
+
+    return( ret );
+}
+
+#endif /* MBEDTLS_ECP_INCREMENTAL */
+
 #endif /* ECP_SHORTWEIERSTRASS */
 
 #if defined(ECP_MONTGOMERY)
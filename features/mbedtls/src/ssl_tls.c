@@ -2397,6 +2397,12 @@ int mbedtls_ssl_fetch_input( mbedtls_ssl_context *ssl, size_t nb_want )
                 return( ret );
 
             ssl->in_left += ret;
+
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+            /* Let the consumer overlap processing with reception */
+            if( ssl->f_partial != NULL )
+                ssl->f_partial( ssl->p_partial, ssl->in_hdr, ssl->in_left );
+#endif
         }
     }
 
@@ -4309,6 +4315,104 @@ write_msg:
     return( ret );
 }
 
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+/*
+ * Incrementally parse and check the peer's chain while the Certificate
+ * message trickles in. Called from mbedtls_ssl_fetch_input() with all bytes
+ * of the current record received so far; only registered while the record
+ * layer is still in the clear, so the buffer really is the plaintext
+ * handshake message. Everything here is advisory: on any surprise we set
+ * pipeline_err and mbedtls_ssl_parse_certificate() falls back to the
+ * regular parse of the complete message.
+ */
+static void ssl_pipeline_feed( void *p_ctx, const unsigned char *buf,
+                               size_t len )
+{
+    mbedtls_ssl_context *ssl = (mbedtls_ssl_context *) p_ctx;
+    mbedtls_ssl_handshake_params *hs = ssl->handshake;
+    size_t hdr, n;
+    int ret;
+
+    if( hs == NULL || hs->pipeline_err != 0 || hs->pipeline_chain == NULL )
+        return;
+
+    if( hs->pipeline_offset == 0 )
+    {
+        hdr = mbedtls_ssl_hdr_len( ssl ) + mbedtls_ssl_hs_hdr_len( ssl ) + 3;
+
+        if( len < hdr )
+            return;
+
+        /* Must be a clear-text handshake record carrying a Certificate;
+         * anything else (alert, empty certificate, ...) is left entirely
+         * to the regular code path */
+        if( buf[0] != MBEDTLS_SSL_MSG_HANDSHAKE ||
+            buf[mbedtls_ssl_hdr_len( ssl )] != MBEDTLS_SSL_HS_CERTIFICATE ||
+            buf[hdr - 3] != 0 )
+        {
+            hs->pipeline_err = 1;
+            return;
+        }
+
+        /* The record may carry further handshake messages after this one;
+         * stop at the end of the Certificate message */
+        hs->pipeline_end = hdr +
+            ( ( (size_t) buf[hdr - 2] << 8 ) |
+                (size_t) buf[hdr - 1] );
+        hs->pipeline_offset = hdr;
+    }
+
+    while( hs->pipeline_offset + 3 <= hs->pipeline_end &&
+           hs->pipeline_offset + 3 <= len )
+    {
+        if( buf[hs->pipeline_offset] != 0 )
+        {
+            hs->pipeline_err = 1;
+            return;
+        }
+
+        n = ( (size_t) buf[hs->pipeline_offset + 1] << 8 ) |
+              (size_t) buf[hs->pipeline_offset + 2];
+
+        if( n < 128 || hs->pipeline_offset + 3 + n > hs->pipeline_end )
+        {
+            hs->pipeline_err = 1;
+            return;
+        }
+
+        if( len < hs->pipeline_offset + 3 + n )
+            break;
+
+        ret = mbedtls_x509_crt_parse_der( hs->pipeline_chain,
+                                          buf + hs->pipeline_offset + 3, n );
+        if( ret != 0 &&
+            ret != MBEDTLS_ERR_X509_UNKNOWN_SIG_ALG + MBEDTLS_ERR_OID_NOT_FOUND )
+        {
+            hs->pipeline_err = 1;
+            return;
+        }
+
+        hs->pipeline_offset += 3 + n;
+
+        /* A new certificate is its predecessor's issuer: check that link's
+         * signature now, while the rest of the message is still in flight.
+         * Failure just leaves the flag clear, so the final verification
+         * repeats the check and reports it the usual way. */
+        if( ret == 0 )
+        {
+            mbedtls_x509_crt *cur = hs->pipeline_chain;
+
+            while( cur->next != NULL )
+            {
+                if( cur->sig_verified == 0 )
+                    mbedtls_x509_crt_check_signature( cur, cur->next );
+                cur = cur->next;
+            }
+        }
+    }
+}
+#endif /* MBEDTLS_X509_CRT_PIPELINE */
+
 int mbedtls_ssl_parse_certificate( mbedtls_ssl_context *ssl )
 {
     int ret = MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE;
@@ -4353,7 +4457,38 @@ int mbedtls_ssl_parse_certificate( mbedtls_ssl_context *ssl )
     }
 #endif
 
-    if( ( ret = mbedtls_ssl_read_record( ssl ) ) != 0 )
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+    /* While the record layer is still unprotected, parse and check the
+     * incoming chain as it arrives instead of idling on the socket. The
+     * pipeline survives MBEDTLS_ERR_SSL_WANT_READ round trips: the chain
+     * lives in the handshake params and is freed with them. */
+    if( ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_STREAM &&
+        ssl->transform_in == NULL )
+    {
+        if( ssl->handshake->pipeline_chain == NULL )
+        {
+            ssl->handshake->pipeline_chain =
+                mbedtls_calloc( 1, sizeof( mbedtls_x509_crt ) );
+            if( ssl->handshake->pipeline_chain != NULL )
+                mbedtls_x509_crt_init( ssl->handshake->pipeline_chain );
+        }
+
+        if( ssl->handshake->pipeline_chain != NULL )
+        {
+            ssl->f_partial = ssl_pipeline_feed;
+            ssl->p_partial = ssl;
+        }
+    }
+#endif /* MBEDTLS_X509_CRT_PIPELINE */
+
+    ret = mbedtls_ssl_read_record( ssl );
+
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+    ssl->f_partial = NULL;
+    ssl->p_partial = NULL;
+#endif
+
+    if( ret != 0 )
     {
         /* mbedtls_ssl_read_record may have sent an alert already. We
            let it decide whether to alert. */
@@ -4456,6 +4591,36 @@ int mbedtls_ssl_parse_certificate( mbedtls_ssl_context *ssl )
         mbedtls_free( ssl->session_negotiate->peer_cert );
     }
 
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+    /*
+     * If the pipeline consumed the Certificate message in full, adopt the
+     * chain it built: the per-link signature checks are already behind us.
+     * Anything short of a perfect match is discarded and the message is
+     * re-parsed from scratch below.
+     */
+    if( ssl->handshake->pipeline_chain != NULL &&
+        ssl->handshake->pipeline_err == 0 &&
+        ssl->handshake->pipeline_chain->version != 0 &&
+        ssl->handshake->pipeline_offset == ssl->handshake->pipeline_end &&
+        ssl->handshake->pipeline_end ==
+            mbedtls_ssl_hdr_len( ssl ) + ssl->in_hslen )
+    {
+        MBEDTLS_SSL_DEBUG_MSG( 2, ( "peer chain parsed during reception" ) );
+
+        ssl->session_negotiate->peer_cert = ssl->handshake->pipeline_chain;
+        ssl->handshake->pipeline_chain = NULL;
+
+        goto have_chain;
+    }
+
+    if( ssl->handshake->pipeline_chain != NULL )
+    {
+        mbedtls_x509_crt_free( ssl->handshake->pipeline_chain );
+        mbedtls_free( ssl->handshake->pipeline_chain );
+        ssl->handshake->pipeline_chain = NULL;
+    }
+#endif /* MBEDTLS_X509_CRT_PIPELINE */
+
     if( ( ssl->session_negotiate->peer_cert = mbedtls_calloc( 1,
                     sizeof( mbedtls_x509_crt ) ) ) == NULL )
     {
@@ -4521,6 +4686,10 @@ int mbedtls_ssl_parse_certificate( mbedtls_ssl_context *ssl )
         i += n;
     }
 
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+have_chain:
+#endif
+
     MBEDTLS_SSL_DEBUG_CRT( 3, "peer certificate", ssl->session_negotiate->peer_cert );
 
     /*
@@ -7304,6 +7473,14 @@ void mbedtls_ssl_handshake_free( mbedtls_ssl_handshake_params *handshake )
     }
 #endif /* MBEDTLS_X509_CRT_PARSE_C && MBEDTLS_SSL_SERVER_NAME_INDICATION */
 
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+    if( handshake->pipeline_chain != NULL )
+    {
+        mbedtls_x509_crt_free( handshake->pipeline_chain );
+        mbedtls_free( handshake->pipeline_chain );
+    }
+#endif
+
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
     mbedtls_free( handshake->verify_cookie );
     mbedtls_free( handshake->hs_msg );
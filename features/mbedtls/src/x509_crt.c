@@ -1897,6 +1897,38 @@ static int x509_crt_check_parent( const mbedtls_x509_crt *child,
     return( 0 );
 }
 
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+int mbedtls_x509_crt_check_signature( mbedtls_x509_crt *child,
+                                      mbedtls_x509_crt *parent )
+{
+    unsigned char hash[MBEDTLS_MD_MAX_SIZE];
+    const mbedtls_md_info_t *md_info;
+
+    child->sig_verified = 0;
+
+    /* Cheap name test before committing to the public-key operation */
+    if( x509_name_cmp( &child->issuer, &parent->subject ) != 0 )
+        return( MBEDTLS_ERR_X509_CERT_VERIFY_FAILED );
+
+    md_info = mbedtls_md_info_from_type( child->sig_md );
+    if( md_info == NULL )
+        return( MBEDTLS_ERR_X509_CERT_VERIFY_FAILED );
+
+    mbedtls_md( md_info, child->tbs.p, child->tbs.len, hash );
+
+    if( mbedtls_pk_verify_ext( child->sig_pk, child->sig_opts, &parent->pk,
+                       child->sig_md, hash, mbedtls_md_get_size( md_info ),
+                       child->sig.p, child->sig.len ) != 0 )
+    {
+        return( MBEDTLS_ERR_X509_CERT_VERIFY_FAILED );
+    }
+
+    child->sig_verified = 1;
+
+    return( 0 );
+}
+#endif /* MBEDTLS_X509_CRT_PIPELINE */
+
 static int x509_crt_verify_top(
                 mbedtls_x509_crt *child, mbedtls_x509_crt *trust_ca,
                 mbedtls_x509_crl *ca_crl,
@@ -2092,6 +2124,14 @@ static int x509_crt_verify_child(
         if( x509_profile_check_key( profile, child->sig_pk, &parent->pk ) != 0 )
             *flags |= MBEDTLS_X509_BADCERT_BAD_KEY;
 
+#if defined(MBEDTLS_X509_CRT_PIPELINE)
+        /* Skip the public-key operation if this exact link was already
+         * checked by mbedtls_x509_crt_check_signature() while the chain
+         * was being received */
+        if( child->sig_verified == 1 && parent == child->next )
+            ; /* verified during reception */
+        else
+#endif
         if( mbedtls_pk_verify_ext( child->sig_pk, child->sig_opts, &parent->pk,
                            child->sig_md, hash, mbedtls_md_get_size( md_info ),
                            child->sig.p, child->sig.len ) != 0 )
@@ -0,0 +1,287 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_AES_C)
+#if defined(MBEDTLS_AES_ALT)
+
+#include "mbedtls/aes.h"
+#include "crypto_device.h"
+
+#include <string.h>
+
+void mbedtls_aes_init( mbedtls_aes_context *ctx )
+{
+    if( crypto_device_aes_acquire() )
+    {
+        ctx->ishw = 1;
+        crypto_device_aes_init( &ctx->hw_ctx );
+    }
+    else
+    {
+        ctx->ishw = 0;
+        mbedtls_aes_sw_init( &ctx->sw_ctx );
+    }
+}
+
+void mbedtls_aes_free( mbedtls_aes_context *ctx )
+{
+    if( ctx == NULL )
+        return;
+
+    if( ctx->ishw )
+    {
+        crypto_device_aes_free( &ctx->hw_ctx );
+        crypto_device_aes_release();
+    }
+    else
+    {
+        mbedtls_aes_sw_free( &ctx->sw_ctx );
+    }
+}
+
+int mbedtls_aes_setkey_enc( mbedtls_aes_context *ctx, const unsigned char *key,
+                            unsigned int keybits )
+{
+    if( ctx->ishw )
+        return( crypto_device_aes_setkey( &ctx->hw_ctx, key, keybits,
+                                          MBEDTLS_AES_ENCRYPT ) );
+
+    return( mbedtls_aes_sw_setkey_enc( &ctx->sw_ctx, key, keybits ) );
+}
+
+int mbedtls_aes_setkey_dec( mbedtls_aes_context *ctx, const unsigned char *key,
+                            unsigned int keybits )
+{
+    if( ctx->ishw )
+        return( crypto_device_aes_setkey( &ctx->hw_ctx, key, keybits,
+                                          MBEDTLS_AES_DECRYPT ) );
+
+    return( mbedtls_aes_sw_setkey_dec( &ctx->sw_ctx, key, keybits ) );
+}
+
+int mbedtls_aes_crypt_ecb( mbedtls_aes_context *ctx,
+                           int mode,
+                           const unsigned char input[16],
+                           unsigned char output[16] )
+{
+    if( ctx->ishw )
+        return( crypto_device_aes_crypt_ecb( &ctx->hw_ctx, mode, input, output ) );
+
+    return( mbedtls_aes_sw_crypt_ecb( &ctx->sw_ctx, mode, input, output ) );
+}
+
+#if defined(MBEDTLS_CIPHER_MODE_CBC)
+int mbedtls_aes_crypt_cbc( mbedtls_aes_context *ctx,
+                           int mode,
+                           size_t length,
+                           unsigned char iv[16],
+                           const unsigned char *input,
+                           unsigned char *output )
+{
+    int i;
+    int ret;
+    unsigned char temp[16];
+
+    if( length % 16 )
+        return( MBEDTLS_ERR_AES_INVALID_INPUT_LENGTH );
+
+    if( ! ctx->ishw )
+        return( mbedtls_aes_sw_crypt_cbc( &ctx->sw_ctx, mode, length, iv,
+                                          input, output ) );
+
+    /* Whole runs through the engine (DMA) when it supports chaining */
+    ret = crypto_device_aes_crypt_cbc( &ctx->hw_ctx, mode, length, iv,
+                                       input, output );
+    if( ret != CRYPTO_DEVICE_UNSUPPORTED )
+        return( ret );
+
+    /* Engine does ECB only - chain blocks here */
+    if( mode == MBEDTLS_AES_DECRYPT )
+    {
+        while( length > 0 )
+        {
+            memcpy( temp, input, 16 );
+            ret = mbedtls_aes_crypt_ecb( ctx, mode, input, output );
+            if( ret != 0 )
+                return( ret );
+
+            for( i = 0; i < 16; i++ )
+                output[i] = (unsigned char)( output[i] ^ iv[i] );
+
+            memcpy( iv, temp, 16 );
+
+            input  += 16;
+            output += 16;
+            length -= 16;
+        }
+    }
+    else
+    {
+        while( length > 0 )
+        {
+            for( i = 0; i < 16; i++ )
+                output[i] = (unsigned char)( input[i] ^ iv[i] );
+
+            ret = mbedtls_aes_crypt_ecb( ctx, mode, output, output );
+            if( ret != 0 )
+                return( ret );
+
+            memcpy( iv, output, 16 );
+
+            input  += 16;
+            output += 16;
+            length -= 16;
+        }
+    }
+
+    return( 0 );
+}
+#endif /* MBEDTLS_CIPHER_MODE_CBC */
+
+#if defined(MBEDTLS_CIPHER_MODE_CFB)
+int mbedtls_aes_crypt_cfb128( mbedtls_aes_context *ctx,
+                              int mode,
+                              size_t length,
+                              size_t *iv_off,
+                              unsigned char iv[16],
+                              const unsigned char *input,
+                              unsigned char *output )
+{
+    int c;
+    size_t n;
+
+    if( ! ctx->ishw )
+        return( mbedtls_aes_sw_crypt_cfb128( &ctx->sw_ctx, mode, length,
+                                             iv_off, iv, input, output ) );
+
+    n = *iv_off;
+
+    if( mode == MBEDTLS_AES_DECRYPT )
+    {
+        while( length-- )
+        {
+            if( n == 0 )
+                mbedtls_aes_crypt_ecb( ctx, MBEDTLS_AES_ENCRYPT, iv, iv );
+
+            c = *input++;
+            *output++ = (unsigned char)( c ^ iv[n] );
+            iv[n] = (unsigned char) c;
+
+            n = ( n + 1 ) & 0x0F;
+        }
+    }
+    else
+    {
+        while( length-- )
+        {
+            if( n == 0 )
+                mbedtls_aes_crypt_ecb( ctx, MBEDTLS_AES_ENCRYPT, iv, iv );
+
+            iv[n] = *output++ = (unsigned char)( iv[n] ^ *input++ );
+
+            n = ( n + 1 ) & 0x0F;
+        }
+    }
+
+    *iv_off = n;
+
+    return( 0 );
+}
+
+int mbedtls_aes_crypt_cfb8( mbedtls_aes_context *ctx,
+                            int mode,
+                            size_t length,
+                            unsigned char iv[16],
+                            const unsigned char *input,
+                            unsigned char *output )
+{
+    unsigned char c;
+    unsigned char ov[17];
+
+    if( ! ctx->ishw )
+        return( mbedtls_aes_sw_crypt_cfb8( &ctx->sw_ctx, mode, length, iv,
+                                           input, output ) );
+
+    while( length-- )
+    {
+        memcpy( ov, iv, 16 );
+        mbedtls_aes_crypt_ecb( ctx, MBEDTLS_AES_ENCRYPT, iv, iv );
+
+        if( mode == MBEDTLS_AES_DECRYPT )
+            ov[16] = *input;
+
+        c = *output++ = (unsigned char)( iv[0] ^ *input++ );
+
+        if( mode == MBEDTLS_AES_ENCRYPT )
+            ov[16] = c;
+
+        memcpy( iv, ov + 1, 16 );
+    }
+
+    return( 0 );
+}
+#endif /* MBEDTLS_CIPHER_MODE_CFB */
+
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+int mbedtls_aes_crypt_ctr( mbedtls_aes_context *ctx,
+                           size_t length,
+                           size_t *nc_off,
+                           unsigned char nonce_counter[16],
+                           unsigned char stream_block[16],
+                           const unsigned char *input,
+                           unsigned char *output )
+{
+    int c, i;
+    size_t n;
+
+    if( ! ctx->ishw )
+        return( mbedtls_aes_sw_crypt_ctr( &ctx->sw_ctx, length, nc_off,
+                                          nonce_counter, stream_block,
+                                          input, output ) );
+
+    n = *nc_off;
+
+    while( length-- )
+    {
+        if( n == 0 )
+        {
+            mbedtls_aes_crypt_ecb( ctx, MBEDTLS_AES_ENCRYPT, nonce_counter,
+                                   stream_block );
+
+            for( i = 16; i > 0; i-- )
+                if( ++nonce_counter[i - 1] != 0 )
+                    break;
+        }
+        c = *input++;
+        *output++ = (unsigned char)( c ^ stream_block[n] );
+
+        n = ( n + 1 ) & 0x0F;
+    }
+
+    *nc_off = n;
+
+    return( 0 );
+}
+#endif /* MBEDTLS_CIPHER_MODE_CTR */
+
+#endif /* MBEDTLS_AES_ALT */
+#endif /* MBEDTLS_AES_C */
@@ -0,0 +1,147 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef CRYPTO_DEVICE_H
+#define CRYPTO_DEVICE_H
+
+/*
+ * Engine contract of the hardware crypto dispatch layer.
+ *
+ * A target opts in by adding the HW_CRYPTO_DISPATCH label, defining the
+ * MBEDTLS_AES_ALT / MBEDTLS_SHA256_ALT macros in its mbedtls_device.h,
+ * and implementing the functions below against its crypto engine. The
+ * dispatch layer (aes_alt.c / sha256_alt.c) decides per context at init
+ * time whether the engine could be claimed; everything it cannot claim,
+ * or that the engine declines, runs on the software fallback
+ * (aes_alt_sw.c / sha256_alt_sw.c), so the engine never has to handle
+ * concurrent contexts itself.
+ *
+ * Bulk operations are where DMA-capable engines win: the dispatch layer
+ * hands over whole CBC runs and SHA update spans, and falls back to
+ * per-block operation only when the engine returns
+ * CRYPTO_DEVICE_UNSUPPORTED.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Defines crypto_device_aes_context and crypto_device_sha256_context;
+ * provided by the target's engine port */
+#include "crypto_device_ctx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Returned by optional bulk operations the engine does not accelerate;
+ *  the dispatch layer then runs the generic per-block path instead */
+#define CRYPTO_DEVICE_UNSUPPORTED   (-1)
+
+#if defined(MBEDTLS_AES_ALT)
+
+/** Try to claim the AES engine for one context
+ *
+ *  Called once per mbedtls_aes_init; a claim lasts until the matching
+ *  crypto_device_aes_release from mbedtls_aes_free. Return 0 when the
+ *  engine is absent or fully claimed - that context then runs in
+ *  software for its whole lifetime, so the engine sees one context at
+ *  a time and needs no internal locking.
+ *
+ *  @return     Non-zero if the engine was claimed, 0 to use software
+ */
+int crypto_device_aes_acquire(void);
+
+/** Release a claim taken with crypto_device_aes_acquire */
+void crypto_device_aes_release(void);
+
+void crypto_device_aes_init(crypto_device_aes_context *ctx);
+void crypto_device_aes_free(crypto_device_aes_context *ctx);
+
+/** Load a key into the engine context
+ *
+ *  @param ctx      Engine context
+ *  @param key      Raw key material
+ *  @param keybits  128, 192 or 256
+ *  @param mode     MBEDTLS_AES_ENCRYPT or MBEDTLS_AES_DECRYPT
+ *  @return         0 on success, or MBEDTLS_ERR_AES_INVALID_KEY_LENGTH
+ */
+int crypto_device_aes_setkey(crypto_device_aes_context *ctx,
+                             const unsigned char *key, unsigned int keybits,
+                             int mode);
+
+/** Encrypt or decrypt one 16-byte block */
+int crypto_device_aes_crypt_ecb(crypto_device_aes_context *ctx, int mode,
+                                const unsigned char input[16],
+                                unsigned char output[16]);
+
+/** Run a whole CBC pass through the engine, DMA when available
+ *
+ *  length is a multiple of 16 and iv is updated on success, matching
+ *  mbedtls_aes_crypt_cbc semantics. Engines without CBC support return
+ *  CRYPTO_DEVICE_UNSUPPORTED and the dispatch layer chains ECB blocks.
+ */
+int crypto_device_aes_crypt_cbc(crypto_device_aes_context *ctx, int mode,
+                                size_t length, unsigned char iv[16],
+                                const unsigned char *input,
+                                unsigned char *output);
+
+#endif /* MBEDTLS_AES_ALT */
+
+#if defined(MBEDTLS_SHA256_ALT)
+
+/** Try to claim the SHA engine for one context; 0 means run in software */
+int crypto_device_sha256_acquire(void);
+
+/** Release a claim taken with crypto_device_sha256_acquire */
+void crypto_device_sha256_release(void);
+
+void crypto_device_sha256_init(crypto_device_sha256_context *ctx);
+void crypto_device_sha256_free(crypto_device_sha256_context *ctx);
+void crypto_device_sha256_starts(crypto_device_sha256_context *ctx, int is224);
+void crypto_device_sha256_update(crypto_device_sha256_context *ctx,
+                                 const unsigned char *input, size_t ilen);
+void crypto_device_sha256_finish(crypto_device_sha256_context *ctx,
+                                 unsigned char output[32]);
+void crypto_device_sha256_process(crypto_device_sha256_context *ctx,
+                                  const unsigned char data[64]);
+
+/** Export the running hash so a context can be cloned
+ *
+ *  Fills the fields of a software context with the engine's current
+ *  state: digest words in state, the unprocessed residue in buffer (at
+ *  most one block), and the processed byte count in total. Needed
+ *  because clones outlive the engine claim and continue in software.
+ *
+ *  @return     0 on success. Engines used with mbed TLS must support
+ *              export - the TLS handshake clones hash contexts.
+ */
+int crypto_device_sha256_export(crypto_device_sha256_context *ctx,
+                                uint32_t state[8], unsigned char buffer[64],
+                                size_t *buffer_len, uint32_t total[2],
+                                int *is224);
+
+#endif /* MBEDTLS_SHA256_ALT */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_DEVICE_H */
@@ -0,0 +1,119 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_SHA256_C)
+#if defined(MBEDTLS_SHA256_ALT)
+
+#include "mbedtls/sha256.h"
+#include "crypto_device.h"
+
+#include <string.h>
+
+void mbedtls_sha256_init( mbedtls_sha256_context *ctx )
+{
+    if( crypto_device_sha256_acquire() )
+    {
+        ctx->ishw = 1;
+        crypto_device_sha256_init( &ctx->hw_ctx );
+    }
+    else
+    {
+        ctx->ishw = 0;
+        mbedtls_sha256_sw_init( &ctx->sw_ctx );
+    }
+}
+
+void mbedtls_sha256_free( mbedtls_sha256_context *ctx )
+{
+    if( ctx == NULL )
+        return;
+
+    if( ctx->ishw )
+    {
+        crypto_device_sha256_free( &ctx->hw_ctx );
+        crypto_device_sha256_release();
+    }
+    else
+    {
+        mbedtls_sha256_sw_free( &ctx->sw_ctx );
+    }
+}
+
+void mbedtls_sha256_clone( mbedtls_sha256_context *dst,
+                           const mbedtls_sha256_context *src )
+{
+    if( src->ishw )
+    {
+        /* The engine claim is not cloneable - export the running state
+         * into a software context and let the clone continue there */
+        size_t buffer_len = 0;
+
+        dst->ishw = 0;
+        mbedtls_sha256_sw_init( &dst->sw_ctx );
+        crypto_device_sha256_export( (crypto_device_sha256_context *) &src->hw_ctx,
+                                     dst->sw_ctx.state, dst->sw_ctx.buffer,
+                                     &buffer_len, dst->sw_ctx.total,
+                                     &dst->sw_ctx.is224 );
+        (void) buffer_len;
+    }
+    else
+    {
+        dst->ishw = 0;
+        dst->sw_ctx = src->sw_ctx;
+    }
+}
+
+void mbedtls_sha256_starts( mbedtls_sha256_context *ctx, int is224 )
+{
+    if( ctx->ishw )
+        crypto_device_sha256_starts( &ctx->hw_ctx, is224 );
+    else
+        mbedtls_sha256_sw_starts( &ctx->sw_ctx, is224 );
+}
+
+void mbedtls_sha256_update( mbedtls_sha256_context *ctx, const unsigned char *input,
+                            size_t ilen )
+{
+    if( ctx->ishw )
+        crypto_device_sha256_update( &ctx->hw_ctx, input, ilen );
+    else
+        mbedtls_sha256_sw_update( &ctx->sw_ctx, input, ilen );
+}
+
+void mbedtls_sha256_finish( mbedtls_sha256_context *ctx, unsigned char output[32] )
+{
+    if( ctx->ishw )
+        crypto_device_sha256_finish( &ctx->hw_ctx, output );
+    else
+        mbedtls_sha256_sw_finish( &ctx->sw_ctx, output );
+}
+
+void mbedtls_sha256_process( mbedtls_sha256_context *ctx, const unsigned char data[64] )
+{
+    if( ctx->ishw )
+        crypto_device_sha256_process( &ctx->hw_ctx, data );
+    else
+        mbedtls_sha256_sw_process( &ctx->sw_ctx, data );
+}
+
+#endif /* MBEDTLS_SHA256_ALT */
+#endif /* MBEDTLS_SHA256_C */
@@ -62,6 +62,62 @@ public:
      * */
     void mesh_network_handler(mesh_connection_status_t status);
 
+    /** Start collecting routing and neighbor statistics
+     *
+     *  Enables the stack's statistics collection. Counters accumulate
+     *  from this call onwards and can be read at any time with
+     *  read_routing_statistics().
+     *
+     *  @return     MESH_ERROR_NONE on success
+     */
+    mesh_error_t statistics_start();
+
+    /** Read routing and neighbor statistics
+     *
+     *  @param stats_out    Structure the statistics are copied to
+     *  @return             MESH_ERROR_NONE on success,
+     *                      MESH_ERROR_STATE if statistics_start() has not been called
+     */
+    mesh_error_t read_routing_statistics(mesh_routing_statistics_t *stats_out);
+
+    /** Reset collected statistics counters to zero */
+    void statistics_reset();
+
+    /** Set neighbor table limits at run time
+     *
+     *  Limits the number of neighbors the stack adds to its neighbor
+     *  table, so RAM use can be sized to the deployment without
+     *  rebuilding the stack. When the count reaches lower_threshold the
+     *  stack starts to probabilistically ignore unknown neighbors, at
+     *  upper_threshold only nodes selecting us as a parent are added,
+     *  and at max no new neighbors are added at all.
+     *
+     *  Must be called after connect(), when the network interface exists.
+     *
+     *  @param lower_threshold  5 to 499, or 0 for no limit
+     *  @param upper_threshold  5 to 500, or 0 for no limit
+     *  @param max              5 to 500, or 0 for no limit
+     *  @return                 MESH_ERROR_NONE on success,
+     *                          MESH_ERROR_STATE if not connected,
+     *                          MESH_ERROR_PARAM on invalid limits
+     */
+    mesh_error_t set_neighbor_table_limits(uint16_t lower_threshold, uint16_t upper_threshold, uint16_t max);
+
+    /** Set neighbor entry lifetimes at run time
+     *
+     *  Controls how long inactive router and host neighbors stay in the
+     *  neighbor table before being evicted.
+     *
+     *  Must be called after connect(), when the network interface exists.
+     *
+     *  @param router_lifetime  Router neighbor lifetime in seconds, 64 to 2560
+     *  @param host_lifetime    Host neighbor lifetime in seconds, 64 to 2560
+     *  @return                 MESH_ERROR_NONE on success,
+     *                          MESH_ERROR_STATE if not connected,
+     *                          MESH_ERROR_PARAM on invalid lifetimes
+     */
+    mesh_error_t set_neighbor_lifetimes(uint16_t router_lifetime, uint16_t host_lifetime);
+
 protected:
     MeshInterfaceNanostack();
     MeshInterfaceNanostack(NanostackPhy *phy);
@@ -19,6 +19,8 @@
 
 #include "MeshInterfaceNanostack.h"
 
+struct FlashJournal_t;
+
 class ThreadInterface : public MeshInterfaceNanostack {
 public:
 
@@ -36,6 +38,24 @@ public:
     nsapi_error_t initialize(NanostackRfPhy *phy);
     virtual int connect();
     virtual int disconnect();
+
+    /** Attach a flash journal for the operational dataset cache
+     *
+     *  With mbed-mesh-api.thread-fast-attach-cache enabled, the active
+     *  operational dataset is persisted to the given journal on attach
+     *  and used on the next connect() to rejoin the same network without
+     *  the full attach, for sub-second rejoin after a reset. The journal
+     *  must be dedicated to this cache and initialized with
+     *  thread_dataset_cache_journal_callback as its completion callback.
+     *
+     *  Call before connect().
+     *
+     *  @param journal  Initialized flash journal
+     *  @return         MESH_ERROR_NONE on success,
+     *                  MESH_ERROR_PARAM if the cache feature is disabled
+     */
+    mesh_error_t dataset_cache_journal_set(struct FlashJournal_t *journal);
+
 private:
     /*
      * \brief Initialization of the interface.
@@ -50,6 +50,24 @@ typedef enum {
     MESH_BOOTSTRAP_FAILED           /*<! error in bootstrap */
 } mesh_connection_status_t;
 
+/*
+ * Routing and neighbor statistics, distilled from the stack's network
+ * statistics collection. Counters accumulate from mesh_statistics_start()
+ * (or the last mesh_statistics_reset()) onwards.
+ */
+typedef struct {
+    uint32_t rpl_total_memory;      /*<! Current RAM used by RPL routing state, in bytes */
+    uint32_t rpl_parent_changes;    /*<! Routes changed to a better-cost parent */
+    uint32_t rpl_memory_overflows;  /*<! Routing state additions refused for lack of memory */
+    uint32_t rpl_local_repairs;     /*<! RPL local repair count */
+    uint32_t rpl_global_repairs;    /*<! RPL global repair count */
+    uint32_t ip_routed_up_bytes;    /*<! Bytes forwarded towards the root */
+    uint32_t ip_no_route_drops;     /*<! Packets dropped with no route to destination */
+    uint16_t mac_tx_queue_size;     /*<! Current MAC TX queue depth */
+    uint16_t mac_tx_queue_peak;     /*<! Peak MAC TX queue depth - forwarding congestion proxy */
+    uint16_t mac_tx_buffer_overflows; /*<! Packets dropped from a full MAC TX queue */
+} mesh_routing_statistics_t;
+
 /*
  * Mesh device types
  */
@@ -17,6 +17,13 @@
 #include "MeshInterfaceNanostack.h"
 #include "NanostackInterface.h"
 #include "mesh_system.h"
+#include "nwk_stats_api.h"
+#include "net_mle_api.h"
+
+// One stats collection shared by all interfaces - the stack updates the
+// counters in place once protocol_stats_start() has been called
+static nwk_stats_t mesh_nwk_stats;
+static bool mesh_nwk_stats_enabled;
 
 MeshInterfaceNanostack::MeshInterfaceNanostack()
     : phy(NULL), _network_interface_id(-1), _device_id(-1), eui64(),
@@ -93,3 +100,81 @@ const char *MeshInterfaceNanostack::get_mac_address()
 {
     return mac_addr_str;
 }
+
+mesh_error_t MeshInterfaceNanostack::statistics_start()
+{
+    nanostack_lock();
+
+    if (!mesh_nwk_stats_enabled) {
+        protocol_stats_start(&mesh_nwk_stats);
+        mesh_nwk_stats_enabled = true;
+    }
+
+    nanostack_unlock();
+
+    return MESH_ERROR_NONE;
+}
+
+mesh_error_t MeshInterfaceNanostack::read_routing_statistics(mesh_routing_statistics_t *stats_out)
+{
+    if (stats_out == NULL) {
+        return MESH_ERROR_PARAM;
+    }
+    if (!mesh_nwk_stats_enabled) {
+        return MESH_ERROR_STATE;
+    }
+
+    nanostack_lock();
+
+    stats_out->rpl_total_memory = mesh_nwk_stats.rpl_total_memory;
+    stats_out->rpl_parent_changes = mesh_nwk_stats.rpl_route_routecost_better_change;
+    stats_out->rpl_memory_overflows = mesh_nwk_stats.rpl_memory_overflow;
+    stats_out->rpl_local_repairs = mesh_nwk_stats.rpl_local_repair;
+    stats_out->rpl_global_repairs = mesh_nwk_stats.rpl_global_repair;
+    stats_out->ip_routed_up_bytes = mesh_nwk_stats.ip_routed_up;
+    stats_out->ip_no_route_drops = mesh_nwk_stats.ip_no_route;
+    stats_out->mac_tx_queue_size = mesh_nwk_stats.mac_tx_queue_size;
+    stats_out->mac_tx_queue_peak = mesh_nwk_stats.mac_tx_queue_peak;
+    stats_out->mac_tx_buffer_overflows = mesh_nwk_stats.mac_tx_buffer_overflow;
+
+    nanostack_unlock();
+
+    return MESH_ERROR_NONE;
+}
+
+void MeshInterfaceNanostack::statistics_reset()
+{
+    nanostack_lock();
+    protocol_stats_reset();
+    nanostack_unlock();
+}
+
+mesh_error_t MeshInterfaceNanostack::set_neighbor_table_limits(uint16_t lower_threshold, uint16_t upper_threshold, uint16_t max)
+{
+    if (_network_interface_id < 0) {
+        return MESH_ERROR_STATE;
+    }
+
+    nanostack_lock();
+    int8_t status = arm_nwk_6lowpan_mle_neighbor_limits_set(_network_interface_id,
+                                                            lower_threshold, upper_threshold, max);
+    nanostack_unlock();
+
+    return status == 0 ? MESH_ERROR_NONE : MESH_ERROR_PARAM;
+}
+
+mesh_error_t MeshInterfaceNanostack::set_neighbor_lifetimes(uint16_t router_lifetime, uint16_t host_lifetime)
+{
+    if (_network_interface_id < 0) {
+        return MESH_ERROR_STATE;
+    }
+
+    nanostack_lock();
+    int8_t status = arm_nwk_6lowpan_mle_router_lifetime_set(_network_interface_id, router_lifetime);
+    if (status == 0) {
+        status = arm_nwk_6lowpan_mle_host_lifetime_set(_network_interface_id, host_lifetime);
+    }
+    nanostack_unlock();
+
+    return status == 0 ? MESH_ERROR_NONE : MESH_ERROR_PARAM;
+}
@@ -3,6 +3,9 @@
 #include "callback_handler.h"
 #include "mesh_system.h"
 #include "randLIB.h"
+#if defined(MBED_CONF_MBED_MESH_API_THREAD_FAST_ATTACH_CACHE) && MBED_CONF_MBED_MESH_API_THREAD_FAST_ATTACH_CACHE
+#include "include/thread_dataset_cache.h"
+#endif
 
 #include "ns_trace.h"
 #define TRACE_GROUP "nsth"
@@ -112,6 +115,19 @@ mesh_error_t ThreadInterface::mesh_connect()
 }
 
 
+mesh_error_t ThreadInterface::dataset_cache_journal_set(struct FlashJournal_t *journal)
+{
+#if defined(MBED_CONF_MBED_MESH_API_THREAD_FAST_ATTACH_CACHE) && MBED_CONF_MBED_MESH_API_THREAD_FAST_ATTACH_CACHE
+    nanostack_lock();
+    thread_dataset_cache_journal_set(journal);
+    nanostack_unlock();
+    return MESH_ERROR_NONE;
+#else
+    (void) journal;
+    return MESH_ERROR_PARAM;
+#endif
+}
+
 mesh_error_t ThreadInterface::mesh_disconnect()
 {
     int8_t status;
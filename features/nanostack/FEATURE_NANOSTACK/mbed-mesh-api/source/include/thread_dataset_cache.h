@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2017 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __INCLUDE_THREAD_DATASET_CACHE__
+#define __INCLUDE_THREAD_DATASET_CACHE__
+#include "ns_types.h"
+#include "thread_management_if.h"
+#include "flash_journal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Persistent cache of the Thread active operational dataset. Feeding the
+ * cached dataset back to thread_management_node_init() lets a node rejoin
+ * the same network after a reset without the full scan and commissioning
+ * dance.
+ */
+
+/*
+ * \brief Attach a flash journal to the dataset cache.
+ *
+ * The journal must have been initialized by the application with
+ * thread_dataset_cache_journal_callback as its completion callback.
+ * Until a journal is attached all cache operations are no-ops.
+ *
+ * \param journal initialized flash journal dedicated to the dataset cache
+ */
+void thread_dataset_cache_journal_set(FlashJournal_t *journal);
+
+/*
+ * \brief Journal completion callback.
+ *
+ * Pass this as the callback argument of FlashJournal_initialize() for the
+ * journal given to thread_dataset_cache_journal_set().
+ */
+void thread_dataset_cache_journal_callback(int32_t status, FlashJournal_OpCode_t cmd_code);
+
+/*
+ * \brief Read the cached operational dataset.
+ *
+ * \return pointer to the cached link configuration, valid until the next
+ *         cache operation
+ * \return NULL if no valid dataset is cached
+ */
+link_configuration_s *thread_dataset_cache_read(void);
+
+/*
+ * \brief Store the interface's active operational dataset to the cache.
+ *
+ * Reads the active dataset from the stack and writes it to the journal in
+ * the background. Nothing is written if the dataset has not changed since
+ * the last store.
+ *
+ * \param interface_id network interface ID
+ */
+void thread_dataset_cache_store(int8_t interface_id);
+
+/*
+ * \brief Drop the cached dataset.
+ *
+ * Called when attach with the cached dataset fails, so the next attempt
+ * runs the full attach.
+ */
+void thread_dataset_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __INCLUDE_THREAD_DATASET_CACHE__ */
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2017 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(MBED_CONF_MBED_MESH_API_THREAD_FAST_ATTACH_CACHE) && MBED_CONF_MBED_MESH_API_THREAD_FAST_ATTACH_CACHE
+
+#include <string.h>
+#include "include/thread_dataset_cache.h"
+
+#include "ns_trace.h"
+#define TRACE_GROUP "thdc"
+
+#define DATASET_CACHE_MAGIC     0x54445331 // "TDS1"
+#define DATASET_CACHE_VERSION   1
+
+/*
+ * The record written to the journal. The link configuration is stored
+ * by value; pointer fields inside it are zeroed before writing and
+ * after reading.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    link_configuration_s config;
+} dataset_record_t;
+
+typedef enum {
+    DATASET_CACHE_IDLE = 0,
+    DATASET_CACHE_LOGGING,
+    DATASET_CACHE_COMMITTING
+} dataset_cache_state_t;
+
+static FlashJournal_t *dataset_journal;
+static dataset_record_t dataset_record;
+static bool dataset_record_valid;
+static dataset_cache_state_t dataset_cache_state;
+static bool dataset_store_pending;
+
+static void dataset_cache_log_start(void)
+{
+    int32_t status = FlashJournal_log(dataset_journal, &dataset_record, sizeof dataset_record);
+    if (status == JOURNAL_STATUS_OK) {
+        // pending, callback continues with the commit
+        dataset_cache_state = DATASET_CACHE_LOGGING;
+    } else if (status == (int32_t) sizeof dataset_record) {
+        status = FlashJournal_commit(dataset_journal);
+        if (status == JOURNAL_STATUS_OK) {
+            dataset_cache_state = DATASET_CACHE_COMMITTING;
+        } else if (status < JOURNAL_STATUS_OK) {
+            tr_warn("dataset commit failed %"PRId32, status);
+        }
+    } else {
+        tr_warn("dataset log failed %"PRId32, status);
+    }
+}
+
+void thread_dataset_cache_journal_set(FlashJournal_t *journal)
+{
+    dataset_journal = journal;
+    dataset_record_valid = false;
+    dataset_cache_state = DATASET_CACHE_IDLE;
+    dataset_store_pending = false;
+}
+
+void thread_dataset_cache_journal_callback(int32_t status, FlashJournal_OpCode_t cmd_code)
+{
+    switch (cmd_code) {
+        case FLASH_JOURNAL_OPCODE_LOG_BLOB:
+            if (status < JOURNAL_STATUS_OK) {
+                tr_warn("dataset log failed %"PRId32, status);
+                dataset_cache_state = DATASET_CACHE_IDLE;
+                break;
+            }
+            status = FlashJournal_commit(dataset_journal);
+            if (status == JOURNAL_STATUS_OK) {
+                dataset_cache_state = DATASET_CACHE_COMMITTING;
+            } else {
+                if (status < JOURNAL_STATUS_OK) {
+                    tr_warn("dataset commit failed %"PRId32, status);
+                }
+                dataset_cache_state = DATASET_CACHE_IDLE;
+            }
+            break;
+        case FLASH_JOURNAL_OPCODE_COMMIT:
+        case FLASH_JOURNAL_OPCODE_RESET:
+            dataset_cache_state = DATASET_CACHE_IDLE;
+            if (dataset_store_pending) {
+                dataset_store_pending = false;
+                dataset_cache_log_start();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+link_configuration_s *thread_dataset_cache_read(void)
+{
+    if (dataset_journal == NULL) {
+        return NULL;
+    }
+    if (dataset_record_valid) {
+        return &dataset_record.config;
+    }
+
+    FlashJournal_Info_t info;
+    if (FlashJournal_getInfo(dataset_journal, &info) != JOURNAL_STATUS_OK) {
+        return NULL;
+    }
+    if (info.sizeofJournaledBlob != sizeof dataset_record) {
+        return NULL;
+    }
+    // reads complete synchronously on the sequential strategy; a pending
+    // or short read is simply treated as a cache miss
+    if (FlashJournal_read(dataset_journal, &dataset_record, sizeof dataset_record) != (int32_t) sizeof dataset_record) {
+        return NULL;
+    }
+    if (dataset_record.magic != DATASET_CACHE_MAGIC ||
+        dataset_record.version != DATASET_CACHE_VERSION) {
+        return NULL;
+    }
+    dataset_record.config.PSKc_ptr = NULL;
+    dataset_record.config.PSKc_len = 0;
+    dataset_record_valid = true;
+    tr_info("cached dataset: channel %d panid %04x", dataset_record.config.rfChannel, dataset_record.config.panId);
+    return &dataset_record.config;
+}
+
+void thread_dataset_cache_store(int8_t interface_id)
+{
+    if (dataset_journal == NULL) {
+        return;
+    }
+
+    link_configuration_s *config = thread_management_configuration_get(interface_id);
+    if (config == NULL) {
+        return;
+    }
+
+    dataset_record_t record;
+    memset(&record, 0, sizeof record);
+    record.magic = DATASET_CACHE_MAGIC;
+    record.version = DATASET_CACHE_VERSION;
+    record.config = *config;
+    // pointers are not meaningful across a reset
+    record.config.PSKc_ptr = NULL;
+    record.config.PSKc_len = 0;
+
+    if (dataset_record_valid &&
+        memcmp(&record, &dataset_record, sizeof record) == 0) {
+        // dataset unchanged - no flash write
+        return;
+    }
+    dataset_record = record;
+    dataset_record_valid = true;
+
+    if (dataset_cache_state != DATASET_CACHE_IDLE) {
+        dataset_store_pending = true;
+        return;
+    }
+    dataset_cache_log_start();
+}
+
+void thread_dataset_cache_clear(void)
+{
+    dataset_record_valid = false;
+    dataset_store_pending = false;
+    if (dataset_journal == NULL) {
+        return;
+    }
+    tr_info("dropping cached dataset");
+    int32_t status = FlashJournal_reset(dataset_journal);
+    if (status == JOURNAL_STATUS_OK) {
+        dataset_cache_state = DATASET_CACHE_COMMITTING; // reuse commit wait
+    } else if (status < JOURNAL_STATUS_OK) {
+        tr_warn("dataset reset failed %"PRId32, status);
+    }
+}
+
+#endif /* MBED_CONF_MBED_MESH_API_THREAD_FAST_ATTACH_CACHE */
@@ -24,6 +24,10 @@
 #include "net_polling_api.h"
 #include "include/thread_tasklet.h"
 #include "include/mesh_system.h"
+#if defined(MBED_CONF_MBED_MESH_API_THREAD_FAST_ATTACH_CACHE) && MBED_CONF_MBED_MESH_API_THREAD_FAST_ATTACH_CACHE
+#define HAVE_DATASET_CACHE
+#include "include/thread_dataset_cache.h"
+#endif
 #include <mbed_assert.h>
 #include "ns_event_loop.h"
 
@@ -165,6 +169,11 @@ void thread_tasklet_parse_network_event(arm_event_s *event)
                 tr_info("Thread bootstrap ready");
                 thread_tasklet_data_ptr->tasklet_state = TASKLET_STATE_BOOTSTRAP_READY;
                 thread_tasklet_trace_bootstrap_info();
+#ifdef HAVE_DATASET_CACHE
+                // Persist the active dataset so the next reset can
+                // rejoin this network without the full attach
+                thread_dataset_cache_store(thread_tasklet_data_ptr->nwk_if_id);
+#endif
                 thread_tasklet_network_state_changed(MESH_CONNECTED);
             }
             break;
@@ -188,6 +197,11 @@ void thread_tasklet_parse_network_event(arm_event_s *event)
             break;
         case ARM_NWK_AUHTENTICATION_FAIL:
             tr_debug("Network authentication fail");
+#ifdef HAVE_DATASET_CACHE
+            // Cached dataset is stale - drop it so the retry runs the
+            // full attach
+            thread_dataset_cache_clear();
+#endif
             thread_tasklet_data_ptr->tasklet_state = TASKLET_STATE_BOOTSTRAP_FAILED;
             break;
         default:
@@ -290,7 +304,14 @@ void thread_tasklet_configure_and_connect_to_network(void)
         read_link_configuration();
         temp_link_config = &thread_tasklet_data_ptr->link_config;
     }
-    
+#ifdef HAVE_DATASET_CACHE
+    else if ((temp_link_config = thread_dataset_cache_read()) != NULL) {
+        // Fast attach: rejoin the cached network directly, skipping the
+        // scan and commissioning steps
+        tr_info("Fast attach with cached dataset");
+    }
+#endif
+
     thread_management_node_init(thread_tasklet_data_ptr->nwk_if_id,
                            &thread_tasklet_data_ptr->channel_list,
                            &device_configuration,
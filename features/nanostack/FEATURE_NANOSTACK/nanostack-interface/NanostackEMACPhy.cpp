@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2017 ARM Limited. All rights reserved.
+ */
+
+#include "NanostackEMACPhy.h"
+
+#if DEVICE_EMAC
+
+#include <string.h>
+#include "ns_types.h"
+#include "nanostack/platform/arm_hal_phy.h"
+#include "nsdynmemLIB.h"
+#include "emac_stack_mem.h"
+
+#define ETH_MAC_ADDR_LEN 6
+
+/* The EMAC callbacks carry no context of their own beyond one user pointer,
+ * and the driver structure lives in the stack's driver table for the lifetime
+ * of the interface, so a single bridge instance is supported - the same
+ * restriction the RF PHY drivers have. */
+static emac_interface_t *single_emac;
+static phy_device_driver_s device_driver;
+static int8_t eth_driver_id = -1;
+static uint8_t mac_address[ETH_MAC_ADDR_LEN];
+static bool link_is_up;
+
+static int8_t emac_phy_interface_state_control(phy_interface_state_e state, uint8_t not_required)
+{
+    (void)not_required;
+
+    switch (state) {
+        case PHY_INTERFACE_UP:
+            return single_emac->ops.power_up(single_emac) ? 0 : -1;
+        case PHY_INTERFACE_DOWN:
+        case PHY_INTERFACE_RESET:
+            single_emac->ops.power_down(single_emac);
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+/* Frame from the stack out to the wire. Nanostack hands us a complete
+ * Ethernet frame; it only needs copying into a driver buffer. */
+static int8_t emac_phy_tx(uint8_t *data_ptr, uint16_t data_len, uint8_t tx_handle, data_protocol_e data_protocol)
+{
+    (void)data_protocol;
+
+    emac_stack_mem_t *buf = emac_stack_mem_alloc(NULL, data_len, 0);
+    if (!buf) {
+        return -1;
+    }
+    memcpy(emac_stack_mem_ptr(NULL, buf), data_ptr, data_len);
+
+    bool sent = single_emac->ops.link_out(single_emac, buf);
+    emac_stack_mem_free(NULL, buf);
+
+    if (device_driver.phy_tx_done_cb) {
+        device_driver.phy_tx_done_cb(eth_driver_id, tx_handle,
+                                     sent ? PHY_LINK_TX_SUCCESS : PHY_LINK_TX_FAIL, 0, 0);
+    }
+    return sent ? 0 : -1;
+}
+
+/* Frame from the wire in to the stack. A single-buffer frame is passed to
+ * the stack in place; a chained frame is flattened first, as the stack
+ * expects contiguous data. */
+static void emac_phy_link_input(void *data, emac_stack_mem_chain_t *chain)
+{
+    (void)data;
+
+    uint32_t total_len = emac_stack_mem_chain_len(NULL, chain);
+    if (total_len == 0 || total_len > UINT16_MAX || !device_driver.phy_rx_cb) {
+        goto discard;
+    }
+
+    {
+        emac_stack_mem_t *first = emac_stack_mem_chain_dequeue(NULL, &chain);
+        if (!chain && emac_stack_mem_len(NULL, first) == total_len) {
+            device_driver.phy_rx_cb((const uint8_t *)emac_stack_mem_ptr(NULL, first),
+                                    total_len, 0xff, 0, eth_driver_id);
+            emac_stack_mem_free(NULL, first);
+            return;
+        }
+
+        uint8_t *flat = (uint8_t *)ns_dyn_mem_temporary_alloc(total_len);
+        uint8_t *write_ptr = flat;
+        emac_stack_mem_t *mem = first;
+        do {
+            if (flat) {
+                uint32_t len = emac_stack_mem_len(NULL, mem);
+                memcpy(write_ptr, emac_stack_mem_ptr(NULL, mem), len);
+                write_ptr += len;
+            }
+            emac_stack_mem_free(NULL, mem);
+        } while (chain && (mem = emac_stack_mem_chain_dequeue(NULL, &chain)) != NULL);
+
+        if (flat) {
+            device_driver.phy_rx_cb(flat, total_len, 0xff, 0, eth_driver_id);
+            ns_dyn_mem_free(flat);
+        }
+        return;
+    }
+
+discard:
+    while (chain) {
+        emac_stack_mem_t *mem = emac_stack_mem_chain_dequeue(NULL, &chain);
+        if (!mem) {
+            break;
+        }
+        emac_stack_mem_free(NULL, mem);
+    }
+}
+
+static void emac_phy_link_state_cb(void *data, bool up)
+{
+    (void)data;
+    link_is_up = up;
+}
+
+static int8_t emac_phy_address_write(phy_address_type_e address_type, uint8_t *address_ptr)
+{
+    if (address_type != PHY_MAC_48BIT) {
+        return -1;
+    }
+    memcpy(mac_address, address_ptr, ETH_MAC_ADDR_LEN);
+    single_emac->ops.set_hwaddr(single_emac, address_ptr);
+    return 0;
+}
+
+NanostackEMACPhy::NanostackEMACPhy(emac_interface_t *emac) : _emac(emac)
+{
+}
+
+int8_t NanostackEMACPhy::phy_register()
+{
+    if (eth_driver_id >= 0) {
+        // Already registered - only the same port can be re-registered
+        return _emac == single_emac ? eth_driver_id : -1;
+    }
+
+    if (_emac->ops.get_hwaddr_size(_emac) != ETH_MAC_ADDR_LEN) {
+        return -1;
+    }
+
+    single_emac = _emac;
+    _emac->ops.get_hwaddr(_emac, mac_address);
+    _emac->ops.set_link_input_cb(_emac, emac_phy_link_input, NULL);
+    _emac->ops.set_link_state_cb(_emac, emac_phy_link_state_cb, NULL);
+
+    memset(&device_driver, 0, sizeof(device_driver));
+    device_driver.PHY_MAC = mac_address;
+    device_driver.driver_description = (char *)"EMAC";
+    device_driver.link_type = PHY_LINK_ETHERNET_TYPE;
+    /* Full Ethernet frames through the driver; leave phy_MTU zero for the
+     * stack default */
+    device_driver.address_write = &emac_phy_address_write;
+    device_driver.state_control = &emac_phy_interface_state_control;
+    device_driver.tx = &emac_phy_tx;
+
+    eth_driver_id = arm_net_phy_register(&device_driver);
+    if (eth_driver_id < 0) {
+        single_emac = NULL;
+    }
+
+    return eth_driver_id;
+}
+
+void NanostackEMACPhy::get_mac_address(uint8_t *mac)
+{
+    _emac->ops.get_hwaddr(_emac, mac);
+}
+
+void NanostackEMACPhy::set_mac_address(uint8_t *mac)
+{
+    memcpy(mac_address, mac, ETH_MAC_ADDR_LEN);
+    _emac->ops.set_hwaddr(_emac, mac);
+}
+
+#endif /* DEVICE_EMAC */
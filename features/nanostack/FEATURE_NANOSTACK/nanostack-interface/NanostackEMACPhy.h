@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2017 ARM Limited. All rights reserved.
+ */
+
+#ifndef NANOSTACK_EMAC_PHY_H_
+#define NANOSTACK_EMAC_PHY_H_
+
+#include <stdint.h>
+#include "NanostackEthernetPhy.h"
+
+#if DEVICE_EMAC
+
+#include "emac_api.h"
+
+/** Ethernet PHY driver backed by the mbed EMAC HAL.
+ *
+ * Registers the EMAC port directly with Nanostack as a PHY_LINK_ETHERNET_TYPE
+ * device driver. Border router builds can then keep 6LoWPAN-to-Ethernet
+ * forwarding inside the stack's adaptation layer - frames are rewritten and
+ * forwarded there - instead of bouncing every packet through a second IP
+ * stack and the socket layer.
+ *
+ * Use together with NanostackEthernetInterface:
+ * @code
+ * NanostackEMACPhy phy(emac);
+ * NanostackEthernetInterface eth;
+ * eth.initialize(&phy);
+ * @endcode
+ */
+class NanostackEMACPhy : public NanostackEthernetPhy {
+public:
+    /** Construct a PHY driver on top of an EMAC driver instance
+     *
+     *  @param emac     HAL EMAC driver of the Ethernet port
+     */
+    NanostackEMACPhy(emac_interface_t *emac);
+
+    /** Register this physical interface with Nanostack
+     *
+     *  Connects the EMAC receive path to the stack. Only one EMAC PHY
+     *  can be registered at a time.
+     *
+     *  @return         Device driver ID or a negative error
+     *                  code on failure
+     */
+    virtual int8_t phy_register();
+
+    /** Read the mac address of this physical interface
+     *
+     */
+    virtual void get_mac_address(uint8_t *mac);
+
+    /** Set the mac address of this physical interface
+     *
+     */
+    virtual void set_mac_address(uint8_t *mac);
+
+private:
+    emac_interface_t *_emac;
+};
+
+#endif /* DEVICE_EMAC */
+
+#endif /* NANOSTACK_EMAC_PHY_H_ */
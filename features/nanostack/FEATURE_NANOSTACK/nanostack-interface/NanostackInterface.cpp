@@ -39,6 +39,29 @@
 #define MALLOC  ns_dyn_mem_alloc
 #define FREE    ns_dyn_mem_free
 
+// Cap on datagram payload bytes queued per lending mode socket - the same
+// limit SOCKET_SO_RCVBUF imposes on the stack side queue
+#define NS_INTERFACE_LEND_QUEUE_BYTES 2048
+
+// A datagram drained from the stack for lending - payload follows the
+// header in the same allocation, and the payload pointer is what is
+// handed out to socket_recvfrom_lend callers
+struct lent_datagram_t {
+    lent_datagram_t *next;
+    ns_address_t addr;
+    uint16_t length;
+};
+
+// A send whose buffer the caller handed over with socket_sendto_adopt
+struct adopted_send_t {
+    adopted_send_t *next;
+    ns_address_t addr;
+    bool has_addr;
+    void *buffer;
+    uint16_t length;
+    NanostackInterface::send_completion_t completion;
+};
+
 // Socket state progressions:
 // UDP: UNOPENED -> DATAGRAM
 // TCP client: UNOPENED -> OPENED -> CONNECTING -> STREAM -> CLOSED
@@ -87,12 +110,25 @@ public:
     // Run callback to signal the next layer of the NSAPI
     void signal_event(void);
 
+    // Datagram buffer lending and adopted sends
+    void queue_lent_datagram(uint16_t length);
+    lent_datagram_t *dequeue_lent_datagram(void);
+    void flush_adopted(void);
+    void purge_lent(void);
+    void fail_adopted(nsapi_error_t status);
+
     void (*callback)(void *);
     void *callback_data;
     int8_t socket_id;           /*!< allocated socket ID */
     int8_t proto;               /*!< UDP or TCP */
     bool addr_valid;
     ns_address_t ns_address;
+    bool lending;               /*!< datagram buffer lending active */
+    lent_datagram_t *lent_head;
+    lent_datagram_t *lent_tail;
+    uint16_t lent_bytes;
+    adopted_send_t *adopt_head;
+    adopted_send_t *adopt_tail;
 private:
     bool attach(int8_t socket_id);
     socket_mode_t mode;
@@ -142,6 +178,12 @@ NanostackSocket::NanostackSocket(int8_t protocol)
     proto = protocol;
     addr_valid = false;
     memset(&ns_address, 0, sizeof(ns_address));
+    lending = false;
+    lent_head = NULL;
+    lent_tail = NULL;
+    lent_bytes = 0;
+    adopt_head = NULL;
+    adopt_tail = NULL;
     mode = SOCKET_MODE_UNOPENED;
 }
 
@@ -226,6 +268,9 @@ void NanostackSocket::close()
         MBED_ASSERT(SOCKET_MODE_UNOPENED == mode);
     }
 
+    purge_lent();
+    fail_adopted(NSAPI_ERROR_NO_CONNECTION);
+
     mode = SOCKET_MODE_CLOSED;
     signal_event();
 }
@@ -347,6 +392,12 @@ void NanostackSocket::event_data(socket_callback_t *sock_cb)
     MBED_ASSERT((SOCKET_MODE_STREAM == mode) ||
                 (SOCKET_MODE_DATAGRAM == mode));
 
+    if (lending && SOCKET_MODE_DATAGRAM == mode) {
+        // Drain now - the datagram is then served out by pointer
+        // rather than copied to the caller's buffer
+        queue_lent_datagram(sock_cb->d_len);
+    }
+
     signal_event();
 }
 
@@ -358,6 +409,8 @@ void NanostackSocket::event_tx_done(socket_callback_t *sock_cb)
 
     if (mode == SOCKET_MODE_DATAGRAM) {
         tr_debug("SOCKET_TX_DONE, %d bytes sent", sock_cb->d_len);
+        // Queue space freed up - push out adopted sends in order
+        flush_adopted();
     } else if (mode == SOCKET_MODE_STREAM) {
         tr_debug("SOCKET_TX_DONE, %d bytes remaining", sock_cb->d_len);
     }
@@ -409,7 +462,9 @@ void NanostackSocket::event_tx_fail(socket_callback_t *sock_cb)
             close();
             break;
         case SOCKET_MODE_DATAGRAM:
-            // TX_FAIL is non-fatal for datagram sockets
+            // TX_FAIL is non-fatal for datagram sockets, but the failed
+            // send may have freed queue space for adopted sends
+            flush_adopted();
             break;
         default:
             MBED_ASSERT(false);
@@ -427,6 +482,107 @@ void NanostackSocket::event_connection_reset(socket_callback_t *sock_cb)
     close();
 }
 
+void NanostackSocket::queue_lent_datagram(uint16_t length)
+{
+    nanostack_assert_locked();
+    MBED_ASSERT(SOCKET_MODE_DATAGRAM == mode);
+
+    lent_datagram_t *dg = NULL;
+    if (lent_bytes + length <= NS_INTERFACE_LEND_QUEUE_BYTES) {
+        dg = static_cast<lent_datagram_t *>(MALLOC(sizeof(lent_datagram_t) + length));
+    }
+    if (dg == NULL) {
+        // No room - consume and drop the datagram, just as a full
+        // stack-side receive buffer would have
+        uint8_t dump;
+        ::socket_recvfrom(socket_id, &dump, sizeof dump, 0, NULL);
+        tr_warn("lend queue full, sock=%d dropped %d bytes", socket_id, length);
+        return;
+    }
+
+    int16_t retcode = ::socket_recvfrom(socket_id, dg + 1, length, 0, &dg->addr);
+    if (retcode < 0) {
+        FREE(dg);
+        return;
+    }
+    dg->length = retcode;
+    dg->next = NULL;
+    if (lent_tail) {
+        lent_tail->next = dg;
+    } else {
+        lent_head = dg;
+    }
+    lent_tail = dg;
+    lent_bytes += retcode;
+}
+
+lent_datagram_t *NanostackSocket::dequeue_lent_datagram(void)
+{
+    nanostack_assert_locked();
+
+    lent_datagram_t *dg = lent_head;
+    if (dg) {
+        lent_head = dg->next;
+        if (lent_head == NULL) {
+            lent_tail = NULL;
+        }
+        lent_bytes -= dg->length;
+    }
+    return dg;
+}
+
+void NanostackSocket::flush_adopted(void)
+{
+    nanostack_assert_locked();
+
+    while (adopt_head) {
+        adopted_send_t *send = adopt_head;
+        ns_msghdr_t msg;
+        ns_iovec_t iov;
+        iov.iov_base = send->buffer;
+        iov.iov_len = send->length;
+        msg.msg_name = send->has_addr ? &send->addr : NULL;
+        msg.msg_namelen = send->has_addr ? sizeof send->addr : 0;
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = NULL;
+        msg.msg_controllen = 0;
+        int retcode = ::socket_sendmsg(socket_id, &msg, 0);
+        if (retcode == NS_EWOULDBLOCK) {
+            // Still no queue space - SOCKET_TX_DONE retries
+            break;
+        }
+        adopt_head = send->next;
+        if (adopt_head == NULL) {
+            adopt_tail = NULL;
+        }
+        send->completion(send->buffer, retcode < 0 ? NSAPI_ERROR_DEVICE_ERROR : NSAPI_ERROR_OK);
+        FREE(send);
+    }
+}
+
+void NanostackSocket::purge_lent(void)
+{
+    nanostack_assert_locked();
+
+    while (lent_datagram_t *dg = dequeue_lent_datagram()) {
+        FREE(dg);
+    }
+}
+
+void NanostackSocket::fail_adopted(nsapi_error_t status)
+{
+    nanostack_assert_locked();
+
+    while (adopt_head) {
+        adopted_send_t *send = adopt_head;
+        adopt_head = send->next;
+        send->completion(send->buffer, status);
+        FREE(send);
+    }
+    adopt_tail = NULL;
+}
+
 NanostackInterface *NanostackInterface::_ns_interface;
 
 NanostackInterface *NanostackInterface::get_stack()
@@ -614,6 +770,24 @@ nsapi_size_or_error_t NanostackInterface::socket_recvfrom(void *handle, SocketAd
         goto out;
     }
 
+    if (socket->lending) {
+        // Lending mode sockets are served from the drained queue so
+        // ordering against socket_recvfrom_lend is kept
+        lent_datagram_t *dg = socket->dequeue_lent_datagram();
+        if (dg == NULL) {
+            ret = NSAPI_ERROR_WOULD_BLOCK;
+        } else {
+            nsapi_size_t len = dg->length < size ? dg->length : size;
+            memcpy(buffer, dg + 1, len);
+            if (address != NULL) {
+                convert_ns_addr_to_mbed(address, &dg->addr);
+            }
+            FREE(dg);
+            ret = len;
+        }
+        goto out;
+    }
+
     ns_address_t ns_address;
 
     int retcode;
@@ -850,6 +1024,130 @@ out:
     return ret;
 }
 
+nsapi_error_t NanostackInterface::socket_buffer_lending_set(void *handle, bool active)
+{
+    NanostackSocket *socket = static_cast<NanostackSocket *>(handle);
+    if (handle == NULL) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    NanostackLockGuard lock;
+
+    if (socket->closed()) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+    if (socket->proto != SOCKET_UDP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    if (!active) {
+        socket->purge_lent();
+    }
+    socket->lending = active;
+
+    tr_debug("socket_buffer_lending_set(socket=%p) sock_id=%d, active=%d", socket, socket->socket_id, active);
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_size_or_error_t NanostackInterface::socket_recvfrom_lend(void *handle, SocketAddress *address, void **buffer)
+{
+    NanostackSocket *socket = static_cast<NanostackSocket *>(handle);
+    if (handle == NULL || buffer == NULL) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    nsapi_size_or_error_t ret;
+
+    NanostackLockGuard lock;
+
+    if (socket->closed()) {
+        ret = NSAPI_ERROR_NO_CONNECTION;
+    } else if (!socket->lending) {
+        ret = NSAPI_ERROR_UNSUPPORTED;
+    } else {
+        lent_datagram_t *dg = socket->dequeue_lent_datagram();
+        if (dg == NULL) {
+            ret = NSAPI_ERROR_WOULD_BLOCK;
+        } else {
+            if (address != NULL) {
+                convert_ns_addr_to_mbed(address, &dg->addr);
+            }
+            // Ownership of the whole allocation moves to the caller -
+            // socket_buffer_release recovers the header from the
+            // payload pointer
+            *buffer = dg + 1;
+            ret = dg->length;
+        }
+    }
+
+    tr_debug("socket_recvfrom_lend(socket=%p) sock_id=%d, ret=%i", socket, socket->socket_id, ret);
+
+    return ret;
+}
+
+void NanostackInterface::socket_buffer_release(void *buffer)
+{
+    if (buffer == NULL) {
+        return;
+    }
+
+    NanostackLockGuard lock;
+
+    FREE(static_cast<lent_datagram_t *>(buffer) - 1);
+}
+
+nsapi_size_or_error_t NanostackInterface::socket_sendto_adopt(void *handle, const SocketAddress &address, void *buffer, nsapi_size_t size, send_completion_t completion)
+{
+    NanostackSocket *socket = static_cast<NanostackSocket *>(handle);
+    if (handle == NULL || buffer == NULL || completion == NULL) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+    if (address.get_ip_version() != NSAPI_IPv6) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    if (size > UINT16_MAX) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    NanostackLockGuard lock;
+
+    if (socket->closed()) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+    if (socket->proto != SOCKET_UDP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    adopted_send_t *send = static_cast<adopted_send_t *>(MALLOC(sizeof(adopted_send_t)));
+    if (send == NULL) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    convert_mbed_addr_to_ns(&send->addr, &address);
+    send->has_addr = true;
+    send->buffer = buffer;
+    send->length = size;
+    send->completion = completion;
+    send->next = NULL;
+
+    // Always queue at the tail and flush, so adopted sends go out in
+    // arrival order. With queue space free the completion fires before
+    // this call returns.
+    if (socket->adopt_tail) {
+        socket->adopt_tail->next = send;
+    } else {
+        socket->adopt_head = send;
+    }
+    socket->adopt_tail = send;
+    socket->flush_adopted();
+
+    tr_debug("socket_sendto_adopt(socket=%p) sock_id=%d, size=%i", socket, socket->socket_id, size);
+
+    return size;
+}
+
 nsapi_size_or_error_t NanostackInterface::socket_send(void *handle, const void *data, nsapi_size_t size)
 {
     return do_sendto(handle, NULL, data, size);
@@ -32,6 +32,73 @@ class NanostackInterface : public NetworkStack {
 public:
     static NanostackInterface *get_stack();
 
+    /** Completion callback for socket_sendto_adopt
+     *
+     *  Called once per adopted buffer, when the buffer has been handed to the
+     *  stack (NSAPI_ERROR_OK) or the send has failed. Ownership of the buffer
+     *  returns to the caller. May be called from within socket_sendto_adopt
+     *  itself or later from stack event context, with the stack locked either
+     *  way, so it must not block.
+     */
+    typedef void (*send_completion_t)(void *buffer, nsapi_error_t status);
+
+    /** Enable or disable datagram buffer lending on a UDP socket
+     *
+     *  With lending enabled, received datagrams are drained from the stack
+     *  into exact-size buffers as they arrive and handed out by pointer with
+     *  socket_recvfrom_lend, so a consumer never copies the payload or
+     *  reserves worst-case receive buffers. socket_recvfrom still works and
+     *  copies from the same queue. Only supported for UDP sockets.
+     *
+     *  @param handle   Socket handle
+     *  @param active   True to enable lending, false to disable and free
+     *                  any queued datagrams
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t socket_buffer_lending_set(void *handle, bool active);
+
+    /** Receive a datagram without copying it
+     *
+     *  Hands out the oldest queued datagram of a lending mode socket.
+     *  Ownership of the buffer passes to the caller, who must return it
+     *  with socket_buffer_release once done - the same pointer can first
+     *  be passed onward to socket_sendto_adopt for copy-free forwarding.
+     *
+     *  This call is non-blocking. If no datagram is queued,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param buffer   Destination for a pointer to the datagram payload
+     *  @return         Datagram length on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t socket_recvfrom_lend(void *handle, SocketAddress *address, void **buffer);
+
+    /** Return a buffer obtained from socket_recvfrom_lend
+     *
+     *  @param buffer   Buffer pointer given out by socket_recvfrom_lend
+     */
+    void socket_buffer_release(void *buffer);
+
+    /** Send a packet over a UDP socket, adopting the caller's buffer
+     *
+     *  Unlike socket_sendto this call never returns NSAPI_ERROR_WOULD_BLOCK:
+     *  when the stack has no queue space the buffer is adopted and sent in
+     *  arrival order as space frees up. The caller must keep the buffer
+     *  intact until the completion callback returns it.
+     *
+     *  @param handle     Socket handle
+     *  @param address    The SocketAddress of the remote host
+     *  @param buffer     Buffer of data to send to the host
+     *  @param size       Size of the buffer in bytes
+     *  @param completion Function called when the buffer is released
+     *  @return           Size on acceptance, negative error code on failure
+     *                    (in which case the buffer was not adopted and
+     *                    completion will not be called)
+     */
+    nsapi_size_or_error_t socket_sendto_adopt(void *handle, const SocketAddress &address, void *buffer, nsapi_size_t size, send_completion_t completion);
+
 protected:
 
     /** Get the local IP address
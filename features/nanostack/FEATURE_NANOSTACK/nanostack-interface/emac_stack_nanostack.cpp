@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2017 ARM Limited. All rights reserved.
+ */
+
+/* Stack memory module backing for EMAC drivers in builds where Nanostack is
+ * the only IP stack. When lwip is present its pbuf-based implementation in
+ * emac_stack_lwip.cpp provides these symbols instead, and the EMAC PHY bridge
+ * interoperates with it through the same API. */
+
+#if DEVICE_EMAC && !defined(FEATURE_LWIP)
+
+#include <string.h>
+#include "ns_types.h"
+#include "nsdynmemLIB.h"
+#include "emac_stack_mem.h"
+
+typedef struct eth_buf {
+    struct eth_buf *next;
+    uint32_t len;
+    uint8_t ref;
+    void *payload;
+    /* payload storage follows the header when heap-allocated */
+} eth_buf_t;
+
+emac_stack_mem_t *emac_stack_mem_alloc(emac_stack_t *stack, uint32_t size, uint32_t align)
+{
+    (void)stack;
+
+    eth_buf_t *buf = (eth_buf_t *)ns_dyn_mem_temporary_alloc(sizeof(eth_buf_t) + size + align);
+    if (!buf) {
+        return NULL;
+    }
+
+    buf->next = NULL;
+    buf->len = size;
+    buf->ref = 1;
+    buf->payload = buf + 1;
+    if (align) {
+        uint32_t remainder = (uintptr_t)buf->payload % align;
+        if (remainder) {
+            buf->payload = (uint8_t *)buf->payload + (align - remainder);
+        }
+    }
+
+    return (emac_stack_mem_t *)buf;
+}
+
+emac_stack_mem_t *emac_stack_mem_alloc_ref(emac_stack_t *stack, void *ptr, uint32_t len,
+                                           emac_stack_mem_free_fn free_cb, void *arg)
+{
+    /* No buffer wrapping - drivers fall back to emac_stack_mem_alloc and a copy */
+    (void)stack;
+    (void)ptr;
+    (void)len;
+    (void)free_cb;
+    (void)arg;
+    return NULL;
+}
+
+void emac_stack_mem_free(emac_stack_t *stack, emac_stack_mem_t *mem)
+{
+    (void)stack;
+
+    eth_buf_t *buf = (eth_buf_t *)mem;
+    if (--buf->ref == 0) {
+        ns_dyn_mem_free(buf);
+    }
+}
+
+void emac_stack_mem_copy(emac_stack_t *stack, emac_stack_mem_t *to, emac_stack_mem_t *from)
+{
+    (void)stack;
+
+    eth_buf_t *to_buf = (eth_buf_t *)to;
+    eth_buf_t *from_buf = (eth_buf_t *)from;
+    if (to_buf->len >= from_buf->len) {
+        memcpy(to_buf->payload, from_buf->payload, from_buf->len);
+    }
+}
+
+void *emac_stack_mem_ptr(emac_stack_t *stack, emac_stack_mem_t *mem)
+{
+    (void)stack;
+    return ((eth_buf_t *)mem)->payload;
+}
+
+uint32_t emac_stack_mem_len(emac_stack_t *stack, emac_stack_mem_t *mem)
+{
+    (void)stack;
+    return ((eth_buf_t *)mem)->len;
+}
+
+void emac_stack_mem_set_len(emac_stack_t *stack, emac_stack_mem_t *mem, uint32_t len)
+{
+    (void)stack;
+    ((eth_buf_t *)mem)->len = len;
+}
+
+emac_stack_mem_t *emac_stack_mem_chain_dequeue(emac_stack_t *stack, emac_stack_mem_chain_t **chain)
+{
+    (void)stack;
+
+    eth_buf_t *head = *(eth_buf_t **)chain;
+    if (head) {
+        *chain = (emac_stack_mem_chain_t *)head->next;
+        head->next = NULL;
+    }
+    return (emac_stack_mem_t *)head;
+}
+
+uint32_t emac_stack_mem_chain_len(emac_stack_t *stack, emac_stack_mem_chain_t *chain)
+{
+    (void)stack;
+
+    uint32_t total = 0;
+    for (eth_buf_t *buf = (eth_buf_t *)chain; buf; buf = buf->next) {
+        total += buf->len;
+    }
+    return total;
+}
+
+void emac_stack_mem_ref(emac_stack_t *stack, emac_stack_mem_t *mem)
+{
+    (void)stack;
+    ((eth_buf_t *)mem)->ref++;
+}
+
+#endif /* DEVICE_EMAC && !FEATURE_LWIP */
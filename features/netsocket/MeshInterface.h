@@ -21,6 +21,7 @@
 #define MESH_INTERFACE_H
 
 #include "netsocket/NetworkInterface.h"
+#include "netsocket/NetworkStack.h"
 
 
 /** MeshInterface class
@@ -29,6 +30,40 @@
  */
 class MeshInterface : public NetworkInterface
 {
+public:
+    /** Set the size of the mesh stack's packet-buffer arena
+     *
+     *  Mesh roles have very different buffering needs - a router
+     *  forwarding multicast bursts needs a much larger arena than a
+     *  sleepy host - so the arena can be sized per product instead of
+     *  relying on the stack's default. Must be called before connect;
+     *  concrete interfaces whose stack cannot resize its arena return
+     *  NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param size     Arena size in bytes
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t set_buffer_arena_size(uint32_t size)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    /** Read utilization statistics of the mesh stack's buffer pools
+     *
+     *  Fills up to count entries with occupancy, high-water mark and
+     *  allocation-failure counters so arena sizing can be validated in
+     *  production. By default forwards to the underlying stack's
+     *  get_pool_stats; interfaces with their own accounting override it.
+     *
+     *  @param stats    Array of statistics entries to fill
+     *  @param count    Number of entries in the array
+     *  @return         Number of entries filled, or NSAPI_ERROR_UNSUPPORTED
+     *                  if the stack does not collect pool statistics
+     */
+    virtual nsapi_size_or_error_t get_pool_stats(nsapi_pool_stats_t *stats, unsigned count)
+    {
+        return get_stack()->get_pool_stats(stats, count);
+    }
 };
 
 
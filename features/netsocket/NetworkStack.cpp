@@ -21,15 +21,78 @@
 #include <new>
 
 
+// Intern cache of recently parsed literal addresses. Telemetry loops call
+// sendto(host, ...) with the same textual peer for every datagram; a string
+// compare here replaces re-scanning the literal each time. Only literals
+// are interned - resolved hostnames stay behind the DNS cache and its TTLs.
+#define NSAPI_LITERAL_INTERN_SIZE 4
+
+static struct {
+    char host[NSAPI_IP_SIZE];
+    nsapi_addr_t addr;
+} nsapi_literal_interns[NSAPI_LITERAL_INTERN_SIZE];
+static uint8_t nsapi_literal_intern_next;
+static SingletonPtr<PlatformMutex> nsapi_literal_intern_mutex;
+
+static bool nsapi_literal_intern_find(const char *name, nsapi_version_t version, nsapi_addr_t *addr)
+{
+    bool found = false;
+
+    nsapi_literal_intern_mutex->lock();
+
+    for (int i = 0; i < NSAPI_LITERAL_INTERN_SIZE; i++) {
+        if (nsapi_literal_interns[i].addr.version != NSAPI_UNSPEC &&
+                strcmp(nsapi_literal_interns[i].host, name) == 0) {
+            if (version == NSAPI_UNSPEC || version == nsapi_literal_interns[i].addr.version) {
+                *addr = nsapi_literal_interns[i].addr;
+                found = true;
+            }
+            break;
+        }
+    }
+
+    nsapi_literal_intern_mutex->unlock();
+    return found;
+}
+
+static void nsapi_literal_intern_store(const char *name, nsapi_addr_t addr)
+{
+    if (strlen(name) >= NSAPI_IP_SIZE) {
+        return;
+    }
+
+    nsapi_literal_intern_mutex->lock();
+
+    strcpy(nsapi_literal_interns[nsapi_literal_intern_next].host, name);
+    nsapi_literal_interns[nsapi_literal_intern_next].addr = addr;
+    nsapi_literal_intern_next = (nsapi_literal_intern_next + 1) % NSAPI_LITERAL_INTERN_SIZE;
+
+    nsapi_literal_intern_mutex->unlock();
+}
+
+
 // Default NetworkStack operations
+nsapi_size_or_error_t NetworkStack::get_pool_stats(nsapi_pool_stats_t *stats, unsigned count)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 nsapi_error_t NetworkStack::gethostbyname(const char *name, SocketAddress *address, nsapi_version_t version)
 {
+    // interned literals skip the parse entirely
+    nsapi_addr_t interned;
+    if (nsapi_literal_intern_find(name, version, &interned)) {
+        address->set_addr(interned);
+        return NSAPI_ERROR_OK;
+    }
+
     // check for simple ip addresses
     if (address->set_ip_address(name)) {
         if (version != NSAPI_UNSPEC && address->get_ip_version() != version) {
             return NSAPI_ERROR_DNS_FAILURE;
         }
 
+        nsapi_literal_intern_store(name, address->get_addr());
         return NSAPI_ERROR_OK;
     }
 
@@ -60,6 +123,69 @@ nsapi_error_t NetworkStack::getstackopt(int level, int optname, void *optval, un
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_sendv(nsapi_socket_t handle, const nsapi_iovec_t *iov, int iovcnt)
+{
+    nsapi_size_or_error_t total = 0;
+
+    for (int i = 0; i < iovcnt; i++) {
+        nsapi_size_or_error_t ret = socket_send(handle, iov[i].base, iov[i].len);
+        if (ret < 0) {
+            return (total > 0) ? total : ret;
+        }
+
+        total += ret;
+        if ((nsapi_size_t)ret < iov[i].len) {
+            break;
+        }
+    }
+
+    return total;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recv_borrow(nsapi_socket_t handle, void **data)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::socket_recv_release(nsapi_socket_t handle, nsapi_size_t size)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_sendmmsg(nsapi_socket_t handle, nsapi_mmsg_t *msgs, int count)
+{
+    int sent = 0;
+
+    for (int i = 0; i < count; i++) {
+        nsapi_size_or_error_t ret = socket_sendto(handle, msgs[i].address, msgs[i].data, msgs[i].size);
+        msgs[i].result = ret;
+        if (ret < 0) {
+            return (sent > 0) ? sent : ret;
+        }
+
+        sent += 1;
+    }
+
+    return sent;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmmsg(nsapi_socket_t handle, nsapi_mmsg_t *msgs, int count)
+{
+    int received = 0;
+
+    for (int i = 0; i < count; i++) {
+        nsapi_size_or_error_t ret = socket_recvfrom(handle, &msgs[i].address, msgs[i].data, msgs[i].size);
+        msgs[i].result = ret;
+        if (ret < 0) {
+            return (received > 0) ? received : ret;
+        }
+
+        received += 1;
+    }
+
+    return received;
+}
+
 nsapi_error_t NetworkStack::setsockopt(void *handle, int level, int optname, const void *optval, unsigned optlen)
 {
     return NSAPI_ERROR_UNSUPPORTED;
@@ -99,12 +225,39 @@ public:
         return address->get_ip_address();
     }
 
+    virtual nsapi_size_or_error_t get_pool_stats(nsapi_pool_stats_t *stats, unsigned count)
+    {
+        if (!_stack_api()->get_pool_stats) {
+            return NetworkStack::get_pool_stats(stats, count);
+        }
+
+        return _stack_api()->get_pool_stats(_stack(), stats, count);
+    }
+
     virtual nsapi_error_t gethostbyname(const char *name, SocketAddress *address, nsapi_version_t version)
     {
         if (!_stack_api()->gethostbyname) {
             return NetworkStack::gethostbyname(name, address, version);
         }
 
+        // interned literals skip the stack's parse entirely
+        nsapi_addr_t interned;
+        if (nsapi_literal_intern_find(name, version, &interned)) {
+            address->set_addr(interned);
+            return NSAPI_ERROR_OK;
+        }
+
+        SocketAddress literal;
+        if (literal.set_ip_address(name)) {
+            if (version != NSAPI_UNSPEC && literal.get_ip_version() != version) {
+                return NSAPI_ERROR_DNS_FAILURE;
+            }
+
+            nsapi_literal_intern_store(name, literal.get_addr());
+            address->set_addr(literal.get_addr());
+            return NSAPI_ERROR_OK;
+        }
+
         nsapi_addr_t addr = {NSAPI_UNSPEC, 0};
         nsapi_error_t err = _stack_api()->gethostbyname(_stack(), name, &addr, version);
         address->set_addr(addr);
@@ -221,6 +374,33 @@ protected:
         return _stack_api()->socket_recv(_stack(), socket, data, size);
     }
 
+    virtual nsapi_size_or_error_t socket_sendv(nsapi_socket_t socket, const nsapi_iovec_t *iov, int iovcnt)
+    {
+        if (!_stack_api()->socket_sendv) {
+            return NetworkStack::socket_sendv(socket, iov, iovcnt);
+        }
+
+        return _stack_api()->socket_sendv(_stack(), socket, iov, iovcnt);
+    }
+
+    virtual nsapi_size_or_error_t socket_recv_borrow(nsapi_socket_t socket, void **data)
+    {
+        if (!_stack_api()->socket_recv_borrow) {
+            return NSAPI_ERROR_UNSUPPORTED;
+        }
+
+        return _stack_api()->socket_recv_borrow(_stack(), socket, data);
+    }
+
+    virtual nsapi_error_t socket_recv_release(nsapi_socket_t socket, nsapi_size_t size)
+    {
+        if (!_stack_api()->socket_recv_release) {
+            return NSAPI_ERROR_UNSUPPORTED;
+        }
+
+        return _stack_api()->socket_recv_release(_stack(), socket, size);
+    }
+
     virtual nsapi_size_or_error_t socket_sendto(nsapi_socket_t socket, const SocketAddress &address, const void *data, nsapi_size_t size)
     {
         if (!_stack_api()->socket_sendto) {
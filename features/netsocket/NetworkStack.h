@@ -23,6 +23,16 @@
 #include "netsocket/NetworkInterface.h"
 
 
+/** One datagram of a batch (mmsg-style) UDP transfer
+ */
+typedef struct nsapi_mmsg {
+    SocketAddress address;          /**< Destination for send, filled with the source for receive */
+    void *data;                     /**< Payload buffer */
+    nsapi_size_t size;              /**< Size of the payload buffer in bytes */
+    nsapi_size_or_error_t result;   /**< Bytes transferred or error code for this message */
+} nsapi_mmsg_t;
+
+
 /** NetworkStack class
  *
  *  Common interface that is shared between hardware that
@@ -43,6 +53,21 @@ public:
      */
     virtual const char *get_ip_address() = 0;
 
+    /** Read utilization statistics of the stack's internal memory pools
+     *
+     *  Fills up to count entries, one per pool, with occupancy, high-water
+     *  mark and allocation-failure counters, so silent drops from exhausted
+     *  pools can be spotted and pool sizes tuned from fleet telemetry.
+     *  Counters are sampled without locking - they may be mutually
+     *  inconsistent for an instant, which is acceptable for telemetry.
+     *
+     *  @param stats    Array of statistics entries to fill
+     *  @param count    Number of entries in the array
+     *  @return         Number of entries filled, or NSAPI_ERROR_UNSUPPORTED
+     *                  if the stack does not collect pool statistics
+     */
+    virtual nsapi_size_or_error_t get_pool_stats(nsapi_pool_stats_t *stats, unsigned count);
+
     /** Translates a hostname to an IP address with specific version
      *
      *  The hostname may be either a domain name or an IP address. If the
@@ -217,6 +242,57 @@ protected:
     virtual nsapi_size_or_error_t socket_recv(nsapi_socket_t handle,
             void *data, nsapi_size_t size) = 0;
 
+    /** Send a list of buffers over a TCP socket as one message
+     *
+     *  The pieces are handed to the stack together so it can pack them into
+     *  segments without the caller staging them into one contiguous buffer.
+     *  Returns the total number of bytes sent.
+     *
+     *  This call is non-blocking. If sendv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation sends the pieces back-to-back through
+     *  socket_send.
+     *
+     *  @param handle   Socket handle
+     *  @param iov      Array of buffers to send
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendv(nsapi_socket_t handle,
+            const nsapi_iovec_t *iov, int iovcnt);
+
+    /** Borrow the stack's receive buffer without copying
+     *
+     *  Lends the next contiguous chunk of received data directly out of the
+     *  stack's own buffering. The chunk stays owned by the stack and remains
+     *  valid until it is consumed with socket_recv_release.
+     *
+     *  This call is non-blocking. If no data is buffered,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation returns NSAPI_ERROR_UNSUPPORTED for
+     *  stacks that cannot lend their buffers.
+     *
+     *  @param handle   Socket handle
+     *  @param data     Destination for a pointer into the stack's buffer
+     *  @return         Number of bytes available at *data on success,
+     *                  negative error code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_borrow(nsapi_socket_t handle, void **data);
+
+    /** Consume data lent out by socket_recv_borrow
+     *
+     *  Releases size bytes back to the stack. Consumed buffer space may be
+     *  freed or reused by the stack immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param size     Number of borrowed bytes the application is done with
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_recv_release(nsapi_socket_t handle, nsapi_size_t size);
+
     /** Send a packet over a UDP socket
      *
      *  Sends data to the specified address. Returns the number of bytes
@@ -253,6 +329,47 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
             void *buffer, nsapi_size_t size) = 0;
 
+    /** Send a batch of packets over a UDP socket
+     *
+     *  Sends each message in the array to its address, recording the number
+     *  of bytes sent or an error code in the per-message result field.
+     *  Returns the number of messages fully handed to the stack; the batch
+     *  stops at the first message that does not go out.
+     *
+     *  This call is non-blocking. If the first message would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation loops over socket_sendto.
+     *
+     *  @param handle   Socket handle
+     *  @param msgs     Array of messages to send
+     *  @param count    Number of messages in the array
+     *  @return         Number of messages sent on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendmmsg(nsapi_socket_t handle,
+            nsapi_mmsg_t *msgs, int count);
+
+    /** Receive a batch of packets over a UDP socket
+     *
+     *  Drains buffered datagrams into the array, filling each message's
+     *  address, payload and result fields. Returns the number of messages
+     *  received; the batch stops as soon as no more data is buffered.
+     *
+     *  This call is non-blocking. If no data is buffered,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation loops over socket_recvfrom.
+     *
+     *  @param handle   Socket handle
+     *  @param msgs     Array of messages to receive into
+     *  @param count    Number of messages in the array
+     *  @return         Number of messages received on success, negative
+     *                  error code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvmmsg(nsapi_socket_t handle,
+            nsapi_mmsg_t *msgs, int count);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
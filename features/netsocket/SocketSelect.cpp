@@ -0,0 +1,219 @@
+/* SocketSelect
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SocketSelect.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include "cmsis_os2.h"
+#include <string.h>
+
+#define READY_FLAG 0x1u
+
+MBED_STATIC_ASSERT(MBED_CONF_NSAPI_SOCKET_SELECT_SIZE <= 32,
+        "The ready set is kept in a 32-bit mask");
+
+SocketSelect::SocketSelect()
+    : _ready(0), _dispatch_pending(0), _flags(), _mutex(), _queue(NULL), _handler()
+{
+    memset(_entries, 0, sizeof _entries);
+}
+
+SocketSelect::~SocketSelect()
+{
+    for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SELECT_SIZE; i++) {
+        MBED_ASSERT(!_entries[i].socket);
+    }
+}
+
+void SocketSelect::select_entry::signal()
+{
+    select->_signal(mask);
+}
+
+void SocketSelect::_signal(uint32_t mask)
+{
+    uint32_t ready = _ready;
+    while (!core_util_atomic_cas_u32((uint32_t *)&_ready, &ready, ready | mask)) {
+    }
+
+    _flags.set(READY_FLAG);
+
+    // hand the ready set to the event queue, coalescing bursts of
+    // signals into the one dispatch event already in flight
+    if (_queue) {
+        uint8_t expected = 0;
+        if (core_util_atomic_cas_u8((uint8_t *)&_dispatch_pending, &expected, 1)) {
+            if (!_queue->call(this, &SocketSelect::_dispatch)) {
+                _dispatch_pending = 0;
+            }
+        }
+    }
+}
+
+uint32_t SocketSelect::_take_ready()
+{
+    uint32_t ready = _ready;
+    while (ready && !core_util_atomic_cas_u32((uint32_t *)&_ready, &ready, 0)) {
+    }
+
+    return ready;
+}
+
+nsapi_error_t SocketSelect::add(Socket *socket, uint32_t events)
+{
+    if (!socket || !(events & (EVENT_READ | EVENT_WRITE))) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex.lock();
+
+    select_entry *entry = NULL;
+    for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SELECT_SIZE; i++) {
+        if (_entries[i].socket == socket) {
+            entry = &_entries[i];
+            break;
+        }
+
+        if (!entry && !_entries[i].socket) {
+            entry = &_entries[i];
+        }
+    }
+
+    if (!entry) {
+        _mutex.unlock();
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    bool hook = (entry->socket != socket);
+    entry->select = this;
+    entry->socket = socket;
+    entry->events = events;
+    entry->mask = 1 << (entry - _entries);
+
+    _mutex.unlock();
+
+    if (hook) {
+        socket->sigio(mbed::callback(entry, &select_entry::signal));
+
+        // edges before registration are unrecoverable, so report the
+        // socket once and let the caller probe it
+        _signal(entry->mask);
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t SocketSelect::remove(Socket *socket)
+{
+    _mutex.lock();
+
+    for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SELECT_SIZE; i++) {
+        if (_entries[i].socket == socket) {
+            _entries[i].socket = NULL;
+            _mutex.unlock();
+
+            socket->sigio(NULL);
+            return NSAPI_ERROR_OK;
+        }
+    }
+
+    _mutex.unlock();
+    return NSAPI_ERROR_PARAMETER;
+}
+
+int SocketSelect::wait(nsapi_select_event_t *events, int count, int32_t timeout)
+{
+    if (!events || count <= 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    uint32_t start = osKernelGetTickCount();
+
+    while (true) {
+        uint32_t ready = _take_ready();
+
+        if (ready) {
+            _mutex.lock();
+
+            int found = 0;
+            for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SELECT_SIZE && found < count; i++) {
+                if ((ready & _entries[i].mask) && _entries[i].socket) {
+                    events[found].socket = _entries[i].socket;
+                    events[found].events = _entries[i].events;
+                    found += 1;
+                }
+            }
+
+            _mutex.unlock();
+
+            if (found > 0) {
+                return found;
+            }
+        }
+
+        uint32_t wait = osWaitForever;
+        if (timeout >= 0) {
+            uint32_t elapsed = osKernelGetTickCount() - start;
+            if (elapsed >= (uint32_t)timeout) {
+                return 0;
+            }
+            wait = timeout - elapsed;
+        }
+
+        uint32_t flags = _flags.wait_any(READY_FLAG, wait);
+        if (flags & osFlagsError) {
+            return 0;
+        }
+    }
+}
+
+void SocketSelect::_dispatch()
+{
+    _dispatch_pending = 0;
+
+    // signals arriving from here on schedule a fresh dispatch event
+    uint32_t ready = _take_ready();
+
+    for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SELECT_SIZE; i++) {
+        Socket *socket = NULL;
+        uint32_t events = 0;
+
+        _mutex.lock();
+        if ((ready & _entries[i].mask) && _entries[i].socket) {
+            socket = _entries[i].socket;
+            events = _entries[i].events;
+        }
+        _mutex.unlock();
+
+        if (socket && _handler) {
+            _handler(socket, events);
+        }
+    }
+}
+
+void SocketSelect::set_dispatch(events::EventQueue *queue,
+        mbed::Callback<void(Socket *, uint32_t)> handler)
+{
+    _mutex.lock();
+    _queue = queue;
+    _handler = handler;
+    _mutex.unlock();
+
+    // catch signals that arrived before the queue was attached
+    if (queue && _ready) {
+        _signal(0);
+    }
+}
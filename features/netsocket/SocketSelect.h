@@ -0,0 +1,152 @@
+
+/** \addtogroup netsocket */
+/** @{*/
+/* SocketSelect
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SOCKET_SELECT_H
+#define SOCKET_SELECT_H
+
+#include "netsocket/Socket.h"
+#include "rtos/EventFlags.h"
+#include "platform/PlatformMutex.h"
+#include "platform/NonCopyable.h"
+#include "events/EventQueue.h"
+
+#ifndef MBED_CONF_NSAPI_SOCKET_SELECT_SIZE
+#define MBED_CONF_NSAPI_SOCKET_SELECT_SIZE 16
+#endif
+
+/** One ready socket reported by SocketSelect::wait
+ */
+typedef struct nsapi_select_event {
+    Socket *socket;     /**< Socket that signalled */
+    uint32_t events;    /**< Interest bits the caller registered for the socket */
+} nsapi_select_event_t;
+
+/** Readiness multiplexer for a group of sockets
+ *
+ *  SocketSelect hooks the sigio callback of each registered socket and
+ *  accumulates their signals into one ready set, so a single wait call
+ *  returns a batch of ready sockets instead of one callback per socket
+ *  or a poll loop re-querying every socket.
+ *
+ *  Like sigio itself the signals are edge-style hints - a reported socket
+ *  may still return NSAPI_ERROR_WOULD_BLOCK, and the reported events are
+ *  the caller's registered interest, not a per-direction readiness. The
+ *  socket should be drained until it would block before waiting again,
+ *  or a subsequent edge may be missed.
+ *
+ *  Sockets must stay registered only while they remain open, and only one
+ *  thread may call wait at a time. Alternatively the ready set can be
+ *  dispatched on an EventQueue with set_dispatch.
+ */
+class SocketSelect : private mbed::NonCopyable<SocketSelect> {
+public:
+    /** Interest and event bits */
+    enum {
+        EVENT_READ  = 0x1,  /**< Socket may be readable */
+        EVENT_WRITE = 0x2,  /**< Socket may be writable */
+    };
+
+    SocketSelect();
+
+    /** Destroy the multiplexer
+     *
+     *  All sockets must be removed before destruction.
+     */
+    ~SocketSelect();
+
+    /** Register a socket with the multiplexer
+     *
+     *  Takes over the socket's sigio callback. The socket is reported as
+     *  ready once immediately after registration, since edges that fired
+     *  before registration cannot be recovered.
+     *
+     *  Re-adding a registered socket just updates its interest bits.
+     *
+     *  @param socket   Socket to watch
+     *  @param events   Any of EVENT_READ and EVENT_WRITE
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t add(Socket *socket, uint32_t events);
+
+    /** Remove a socket from the multiplexer
+     *
+     *  Clears the socket's sigio callback. Must be called before the
+     *  socket is closed or destroyed.
+     *
+     *  @param socket   Socket to stop watching
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t remove(Socket *socket);
+
+    /** Wait for registered sockets to signal
+     *
+     *  Blocks until at least one socket has signalled since it was last
+     *  reported, then drains the whole ready set into the array.
+     *
+     *  @param events   Array to fill with ready sockets
+     *  @param count    Number of entries in the array
+     *  @param timeout  Timeout in milliseconds, or -1 to wait forever
+     *  @return         Number of ready sockets, 0 on timeout, negative
+     *                  error code on failure
+     */
+    int wait(nsapi_select_event_t *events, int count, int32_t timeout = -1);
+
+    /** Dispatch ready sockets on an EventQueue instead of wait
+     *
+     *  When a socket signals, an event is queued that calls the handler
+     *  once for each socket in the ready set, from the queue's dispatch
+     *  context. Only one dispatch event is in flight at a time, so bursts
+     *  of signals coalesce into one pass over the ready set.
+     *
+     *  Pass NULL to detach the queue and return to using wait.
+     *
+     *  @param queue    Queue to dispatch on, or NULL to detach
+     *  @param handler  Function to call for each ready socket
+     */
+    void set_dispatch(events::EventQueue *queue,
+            mbed::Callback<void(Socket *, uint32_t)> handler);
+
+private:
+    struct select_entry {
+        SocketSelect *select;
+        Socket *socket;
+        uint32_t events;
+        uint32_t mask;
+
+        void signal();
+    };
+
+    friend struct select_entry;
+
+    void _signal(uint32_t mask);
+    void _dispatch();
+    uint32_t _take_ready();
+
+    select_entry _entries[MBED_CONF_NSAPI_SOCKET_SELECT_SIZE];
+    volatile uint32_t _ready;
+    volatile uint8_t _dispatch_pending;
+    rtos::EventFlags _flags;
+    PlatformMutex _mutex;
+    events::EventQueue *_queue;
+    mbed::Callback<void(Socket *, uint32_t)> _handler;
+};
+
+#endif
+
+/** @}*/
@@ -17,14 +17,29 @@
 #include "TCPServer.h"
 #include "mbed.h"
 
+#ifndef MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL
+#define MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL 0
+#endif
+
 TCPServer::TCPServer()
-    : _pending(0), _accept_sem(0)
+    : _pending(0), _accept_sem(0),
+      _accept_queue(0), _accept_stack(0), _accept_head(0), _accept_count(0)
 {
 }
 
 TCPServer::~TCPServer()
 {
     close();
+
+#if MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL > 0
+    // Connections drained from the stack but never claimed by accept()
+    while (_accept_count > 0) {
+        _accept_stack->socket_close(_accept_queue[_accept_head].socket);
+        _accept_head = (_accept_head + 1) % MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL;
+        _accept_count -= 1;
+    }
+    delete[] _accept_queue;
+#endif
 }
 
 nsapi_protocol_t TCPServer::get_proto()
@@ -41,40 +56,81 @@ nsapi_error_t TCPServer::listen(int backlog)
         ret = NSAPI_ERROR_NO_SOCKET;
     } else {
         ret = _stack->socket_listen(_socket, backlog);
+#if MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL > 0
+        if (ret == 0 && !_accept_queue) {
+            _accept_queue = new pending_accept[MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL];
+        }
+#endif
     }
 
     _lock.unlock();
     return ret;
 }
 
+void TCPServer::bind_connection(TCPSocket *connection, NetworkStack *stack, nsapi_socket_t socket)
+{
+    connection->_lock.lock();
+
+    if (connection->_socket) {
+        connection->close();
+    }
+
+    connection->_stack = stack;
+    connection->_socket = socket;
+    connection->_event = Callback<void()>(connection, &TCPSocket::event);
+    stack->socket_attach(socket, &Callback<void()>::thunk, &connection->_event);
+
+    connection->_lock.unlock();
+}
+
 nsapi_error_t TCPServer::accept(TCPSocket *connection, SocketAddress *address)
 {
     _lock.lock();
     nsapi_error_t ret;
 
     while (true) {
+#if MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL > 0
+        // Serve queued connections first, these were already accepted
+        // from the stack so this path never blocks
+        if (_accept_count > 0) {
+            pending_accept *entry = &_accept_queue[_accept_head];
+            if (address) {
+                *address = entry->address;
+            }
+            bind_connection(connection, _accept_stack, entry->socket);
+            _accept_head = (_accept_head + 1) % MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL;
+            _accept_count -= 1;
+            ret = 0;
+            break;
+        }
+#endif
+
         if (!_socket) {
             ret = NSAPI_ERROR_NO_SOCKET;
             break;
-        } 
+        }
 
         _pending = 0;
         void *socket;
         ret = _stack->socket_accept(_socket, &socket, address);
 
         if (0 == ret) {
-            connection->_lock.lock();
-
-            if (connection->_socket) {
-                connection->close();
+            bind_connection(connection, _stack, socket);
+
+#if MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL > 0
+            // Pull any further connections the stack has completed into
+            // the queue, freeing its backlog slots for new arrivals
+            while (_accept_queue
+                    && _accept_count < MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL) {
+                pending_accept *entry =
+                        &_accept_queue[(_accept_head + _accept_count) % MBED_CONF_NSAPI_TCP_SERVER_ACCEPT_POOL];
+                if (_stack->socket_accept(_socket, &entry->socket, &entry->address) != 0) {
+                    break;
+                }
+                _accept_stack = _stack;
+                _accept_count += 1;
             }
-
-            connection->_stack = _stack;
-            connection->_socket = socket;
-            connection->_event = Callback<void()>(connection, &TCPSocket::event);
-            _stack->socket_attach(socket, &Callback<void()>::thunk, &connection->_event);
-
-            connection->_lock.unlock();
+#endif
             break;
         } else if (NSAPI_ERROR_WOULD_BLOCK != ret) {
             break;
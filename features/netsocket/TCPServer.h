@@ -24,6 +24,9 @@
 #include "netsocket/NetworkInterface.h"
 #include "rtos/Semaphore.h"
 
+#ifndef MBED_CONF_NSAPI_TCP_SERVER_BACKLOG
+#define MBED_CONF_NSAPI_TCP_SERVER_BACKLOG 1
+#endif
 
 /** TCP socket server
  *  @addtogroup netsocket
@@ -45,7 +48,8 @@ public:
      */
     template <typename S>
     TCPServer(S *stack)
-        : _pending(0), _accept_sem(0)
+        : _pending(0), _accept_sem(0),
+          _accept_queue(0), _accept_stack(0), _accept_head(0), _accept_count(0)
     {
         open(stack);
     }
@@ -62,11 +66,12 @@ public:
      *  incoming connections.
      *
      *  @param backlog  Number of pending connections that can be queued
-     *                  simultaneously, defaults to 1
+     *                  simultaneously, defaults to the
+     *                  nsapi.tcp-server-backlog config
      *  @return         0 on success, negative error code on failure
      */
-    nsapi_error_t listen(int backlog = 1);
-    
+    nsapi_error_t listen(int backlog = MBED_CONF_NSAPI_TCP_SERVER_BACKLOG);
+
     /** Accepts a connection on a TCP socket
      *
      *  The server socket must be bound and set to listen for connections.
@@ -77,6 +82,13 @@ public:
      *  non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is returned
      *  immediately.
      *
+     *  When the nsapi.tcp-server-accept-pool config is nonzero, each
+     *  accept additionally drains any further connections already
+     *  completed by the stack into an internal queue of that size, so a
+     *  burst of connections is pulled out of the stack's backlog at once
+     *  and subsequent accepts return from the queue without touching the
+     *  stack.
+     *
      *  @param connection TCPSocket instance that will handle the incoming connection.
      *  @param address    Destination for the remote address or NULL
      *  @return           0 on success, negative error code on failure
@@ -87,8 +99,21 @@ protected:
     virtual nsapi_protocol_t get_proto();
     virtual void event();
 
+    /** Hand a connected stack socket over to the caller's TCPSocket */
+    void bind_connection(TCPSocket *connection, NetworkStack *stack, nsapi_socket_t socket);
+
+    /** Connection accepted from the stack but not yet claimed by accept() */
+    struct pending_accept {
+        nsapi_socket_t socket;
+        SocketAddress address;
+    };
+
     volatile unsigned _pending;
     rtos::Semaphore _accept_sem;
+    pending_accept *_accept_queue;
+    NetworkStack *_accept_stack;
+    unsigned _accept_head;
+    unsigned _accept_count;
 };
 
 
@@ -17,18 +17,24 @@
 #include "TCPSocket.h"
 #include "Timer.h"
 #include "mbed_assert.h"
+#include "mbed_critical.h"
+#include "events/EventQueue.h"
+
+#include <string.h>
 
 #define READ_FLAG           0x1u
 #define WRITE_FLAG          0x2u
 
 TCPSocket::TCPSocket()
     : _pending(0), _event_flag(),
-      _read_in_progress(false), _write_in_progress(false)
+      _read_in_progress(false), _write_in_progress(false),
+      _agg(NULL)
 {
 }
 
 TCPSocket::~TCPSocket()
 {
+    set_aggregation(0);
     close();
 }
 
@@ -107,6 +113,20 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
     _lock.lock();
     nsapi_size_or_error_t ret;
 
+    if (_agg) {
+        ret = agg_send(data, size);
+    } else {
+        ret = send_nolock(data, size);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t TCPSocket::send_nolock(const void *data, nsapi_size_t size)
+{
+    nsapi_size_or_error_t ret;
+
     // If this assert is hit then there are two threads
     // performing a send at the same time which is undefined
     // behavior
@@ -140,6 +160,178 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
         }
     }
 
+    _write_in_progress = false;
+    return ret;
+}
+
+nsapi_size_or_error_t TCPSocket::agg_send(const void *data, nsapi_size_t size)
+{
+    nsapi_size_or_error_t ret;
+
+    // Writes the buffer cannot hold flush it and go straight through
+    if (size >= _agg->size) {
+        ret = flush_nolock();
+        if (ret < 0 && _agg->len > 0) {
+            return ret;
+        }
+        return send_nolock(data, size);
+    }
+
+    if (_agg->len + size > _agg->size) {
+        ret = flush_nolock();
+        if (ret < 0 && _agg->len + size > _agg->size) {
+            return ret;
+        }
+    }
+
+    memcpy(_agg->buf + _agg->len, data, size);
+    _agg->len += size;
+
+    if (_agg->len == _agg->size) {
+        // Buffer exactly full - push it out now; on failure the data stays
+        // buffered and the error surfaces from a later flush
+        flush_nolock();
+    } else if (_agg->queue && _agg->flush_ms && !_agg->armed) {
+        _agg->armed = true;
+        _agg->timeout.attach_us(mbed::callback(this, &TCPSocket::agg_timeout_irq),
+                                (us_timestamp_t)_agg->flush_ms * 1000);
+    }
+
+    return size;
+}
+
+nsapi_size_or_error_t TCPSocket::flush_nolock()
+{
+    nsapi_size_t sent = 0;
+
+    while (sent < _agg->len) {
+        nsapi_size_or_error_t ret = send_nolock(_agg->buf + sent, _agg->len - sent);
+        if (ret < 0) {
+            // Keep the unsent tail buffered for a later flush
+            memmove(_agg->buf, _agg->buf + sent, _agg->len - sent);
+            _agg->len -= sent;
+            return ret;
+        }
+        sent += ret;
+    }
+
+    _agg->len = 0;
+    if (_agg->armed) {
+        _agg->timeout.detach();
+        _agg->armed = false;
+    }
+    return sent;
+}
+
+nsapi_size_or_error_t TCPSocket::flush()
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret = 0;
+
+    if (_agg && _agg->len > 0) {
+        ret = flush_nolock();
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t TCPSocket::set_aggregation(nsapi_size_t buffer_size, uint32_t flush_timeout_ms, events::EventQueue *queue)
+{
+    _lock.lock();
+    nsapi_error_t ret = NSAPI_ERROR_OK;
+
+    if (_agg) {
+        if (_agg->len > 0) {
+            flush_nolock();
+        }
+        if (_agg->armed) {
+            _agg->timeout.detach();
+            _agg->armed = false;
+        }
+        delete[] _agg->buf;
+        delete _agg;
+        _agg = NULL;
+    }
+
+    if (buffer_size > 0) {
+        _agg = new aggregator;
+        _agg->buf = new char[buffer_size];
+        _agg->size = buffer_size;
+        _agg->len = 0;
+        _agg->flush_ms = flush_timeout_ms;
+        _agg->queue = queue;
+        _agg->armed = false;
+        _agg->pending = 0;
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+void TCPSocket::agg_timeout_irq()
+{
+    _agg->armed = false;
+
+    // Coalesce into at most one queued flush at a time
+    uint8_t expected = 0;
+    if (core_util_atomic_cas_u8(&_agg->pending, &expected, 1)) {
+        if (!_agg->queue->call(this, &TCPSocket::agg_flush_dispatch)) {
+            _agg->pending = 0;
+        }
+    }
+}
+
+void TCPSocket::agg_flush_dispatch()
+{
+    _lock.lock();
+    if (_agg) {
+        _agg->pending = 0;
+        if (_agg->len > 0) {
+            flush_nolock();
+        }
+    }
+    _lock.unlock();
+}
+
+nsapi_size_or_error_t TCPSocket::sendv(const nsapi_iovec_t *iov, int iovcnt)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(!_write_in_progress);
+    _write_in_progress = true;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_sendv(_socket, iov, iovcnt);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
     _write_in_progress = false;
     _lock.unlock();
     return ret;
@@ -188,6 +380,64 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
     return ret;
 }
 
+nsapi_size_or_error_t TCPSocket::recv_borrow(void **data)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(!_read_in_progress);
+    _read_in_progress = true;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_recv_borrow(_socket, data);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _read_in_progress = false;
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t TCPSocket::recv_release(nsapi_size_t size)
+{
+    _lock.lock();
+    nsapi_error_t ret;
+
+    if (!_socket) {
+        ret = NSAPI_ERROR_NO_SOCKET;
+    } else {
+        ret = _stack->socket_recv_release(_socket, size);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 void TCPSocket::event()
 {
     _event_flag.set(READ_FLAG|WRITE_FLAG);
@@ -24,6 +24,11 @@
 #include "netsocket/NetworkStack.h"
 #include "netsocket/NetworkInterface.h"
 #include "rtos/EventFlags.h"
+#include "Timeout.h"
+
+namespace events {
+class EventQueue;
+}
 
 
 /** TCP socket connection
@@ -46,7 +51,8 @@ public:
     template <typename S>
     TCPSocket(S *stack)
         : _pending(0), _event_flag(0),
-          _read_in_progress(false), _write_in_progress(false)
+          _read_in_progress(false), _write_in_progress(false),
+          _agg(NULL)
     {
         open(stack);
     }
@@ -93,7 +99,29 @@ public:
      *                  code on failure
      */
     nsapi_size_or_error_t send(const void *data, nsapi_size_t size);
-    
+
+    /** Send a list of buffers over a TCP socket as one message
+     *
+     *  The pieces are handed to the stack together, so a header and payload
+     *  kept in separate buffers go out packed into the same segments without
+     *  being staged into one contiguous buffer first. Returns the total
+     *  number of bytes sent.
+     *
+     *  To coalesce across separate send calls instead, set the NSAPI_CORK
+     *  socket option while assembling the message and clear it to flush.
+     *
+     *  By default, sendv blocks until the data is sent. If socket is set to
+     *  non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is returned
+     *  immediately.
+     *
+     *  @param iov      Array of buffers to send
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t sendv(const nsapi_iovec_t *iov, int iovcnt);
+
+
     /** Receive data over a TCP socket
      *
      *  The socket must be connected to a remote host. Returns the number of
@@ -110,6 +138,75 @@ public:
      */
     nsapi_size_or_error_t recv(void *data, nsapi_size_t size);
 
+    /** Borrow received data directly from the network stack
+     *
+     *  Lends the next contiguous chunk of received data out of the stack's
+     *  own buffering, avoiding the copy into a caller buffer that recv
+     *  performs. The chunk belongs to the stack and stays valid until it is
+     *  handed back with recv_release; each borrowed chunk must be released
+     *  before the next borrow.
+     *
+     *  By default, recv_borrow blocks until data arrives. If the socket is
+     *  set to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is
+     *  returned immediately. Stacks without buffer lending return
+     *  NSAPI_ERROR_UNSUPPORTED; callers should fall back to recv.
+     *
+     *  @param data     Destination for a pointer into the stack's buffer
+     *  @return         Number of bytes available at *data on success,
+     *                  negative error code on failure
+     */
+    nsapi_size_or_error_t recv_borrow(void **data);
+
+    /** Return data borrowed with recv_borrow to the network stack
+     *
+     *  Consumes size bytes of the borrowed chunk; the stack may free or
+     *  reuse the space immediately. Releasing fewer bytes than were lent
+     *  keeps the remainder buffered for the next recv or recv_borrow.
+     *
+     *  @param size     Number of borrowed bytes the application is done with
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t recv_release(nsapi_size_t size);
+
+    /** Coalesce small sends into single stack calls
+     *
+     *  Gives the socket a user-side aggregation buffer: send copies data
+     *  that fits into the buffer instead of calling into the stack, and the
+     *  buffered bytes go out as one stack call when the buffer fills, when
+     *  flush is called, or - if an event queue is given - when
+     *  flush_timeout_ms elapses after the first unflushed byte. Unlike
+     *  Nagle's algorithm this never couples the delay to retransmission
+     *  state, and the deadline is under application control.
+     *
+     *  Writes that fit the buffer are always accepted; transport errors
+     *  surface from the flushing call instead. Writes at least as large as
+     *  the buffer flush it and pass straight through. Without a queue there
+     *  is no timed flush - data leaves only when the buffer fills or flush
+     *  is called.
+     *
+     *  A buffer_size of 0 flushes and disables aggregation. Timed flushes
+     *  run on the queue's dispatch thread and briefly take the socket lock.
+     *
+     *  @param buffer_size      Aggregation buffer size in bytes, 0 to disable
+     *  @param flush_timeout_ms Deadline for buffered data in milliseconds,
+     *                          0 for no timed flush
+     *  @param queue            Event queue the timed flush runs on, NULL for
+     *                          none
+     *  @return                 0 on success, negative error code on failure
+     */
+    nsapi_error_t set_aggregation(nsapi_size_t buffer_size, uint32_t flush_timeout_ms = 0, events::EventQueue *queue = NULL);
+
+    /** Send any data held in the aggregation buffer
+     *
+     *  No-op when aggregation is disabled or the buffer is empty. On a
+     *  partial send (non-blocking socket) the unsent tail stays buffered
+     *  for a later flush.
+     *
+     *  @return         Number of bytes flushed on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t flush();
+
 protected:
     friend class TCPServer;
 
@@ -120,6 +217,27 @@ protected:
     rtos::EventFlags _event_flag;
     bool _read_in_progress;
     bool _write_in_progress;
+
+private:
+    // Aggregation state, allocated only when set_aggregation enables it
+    struct aggregator {
+        char *buf;
+        nsapi_size_t size;
+        nsapi_size_t len;
+        uint32_t flush_ms;
+        events::EventQueue *queue;
+        mbed::Timeout timeout;
+        bool armed;
+        volatile uint8_t pending;
+    };
+
+    nsapi_size_or_error_t send_nolock(const void *data, nsapi_size_t size);
+    nsapi_size_or_error_t agg_send(const void *data, nsapi_size_t size);
+    nsapi_size_or_error_t flush_nolock();
+    void agg_timeout_irq();
+    void agg_flush_dispatch();
+
+    aggregator *_agg;
 };
 
 
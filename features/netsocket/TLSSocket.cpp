@@ -0,0 +1,316 @@
+/* TLSSocket
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TLSSocket.h"
+
+#if defined(MBEDTLS_SSL_CLI_C)
+
+#include "mbedtls/net_sockets.h"
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+#include <string.h>
+
+#ifndef MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE
+#define MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE 4
+#endif
+
+#define TLS_HOST_SIZE 128
+
+// Process-wide session cache keyed by peer, so a new TLSSocket instance
+// can resume a session established by an earlier one
+#if MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0
+struct tls_session_entry {
+    char host[TLS_HOST_SIZE + 1];
+    uint16_t port;
+    mbedtls_ssl_session session;
+    uint32_t sequence;
+    bool in_use;
+};
+
+static tls_session_entry tls_session_cache[MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE];
+static uint32_t tls_session_sequence;
+static SingletonPtr<PlatformMutex> tls_session_mutex;
+
+static void tls_session_cache_offer(mbedtls_ssl_context *ssl, const char *host, uint16_t port)
+{
+    tls_session_mutex->lock();
+
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        tls_session_entry *entry = &tls_session_cache[i];
+        if (entry->in_use && entry->port == port && strcmp(entry->host, host) == 0) {
+            // set_session deep-copies, so the cached session survives the
+            // handshake consuming the offered one
+            mbedtls_ssl_set_session(ssl, &entry->session);
+            break;
+        }
+    }
+
+    tls_session_mutex->unlock();
+}
+
+static void tls_session_cache_put(const char *host, uint16_t port, const mbedtls_ssl_context *ssl)
+{
+    if (strlen(host) > TLS_HOST_SIZE) {
+        return;
+    }
+
+    tls_session_mutex->lock();
+
+    // reuse the peer's entry, then a free entry, then the oldest entry
+    tls_session_entry *victim = &tls_session_cache[0];
+
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        tls_session_entry *entry = &tls_session_cache[i];
+        if (entry->in_use && entry->port == port && strcmp(entry->host, host) == 0) {
+            victim = entry;
+            break;
+        }
+
+        if (!victim->in_use) {
+            continue;
+        }
+
+        if (!entry->in_use || (int32_t)(entry->sequence - victim->sequence) < 0) {
+            victim = entry;
+        }
+    }
+
+    if (victim->in_use) {
+        mbedtls_ssl_session_free(&victim->session);
+        victim->in_use = false;
+    }
+
+    mbedtls_ssl_session_init(&victim->session);
+    if (mbedtls_ssl_get_session(ssl, &victim->session) == 0) {
+        strcpy(victim->host, host);
+        victim->port = port;
+        victim->sequence = tls_session_sequence++;
+        victim->in_use = true;
+    } else {
+        mbedtls_ssl_session_free(&victim->session);
+    }
+
+    tls_session_mutex->unlock();
+}
+#endif /* MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0 */
+
+TLSSocket::TLSSocket()
+    : _tcp(), _has_ca(false), _has_own_cert(false), _handshake_done(false)
+{
+    mbedtls_entropy_init(&_entropy);
+    mbedtls_ctr_drbg_init(&_ctr_drbg);
+    mbedtls_ssl_config_init(&_conf);
+    mbedtls_ssl_init(&_ssl);
+    mbedtls_x509_crt_init(&_ca_cert);
+    mbedtls_x509_crt_init(&_own_cert);
+    mbedtls_pk_init(&_own_key);
+}
+
+TLSSocket::~TLSSocket()
+{
+    close();
+
+    mbedtls_pk_free(&_own_key);
+    mbedtls_x509_crt_free(&_own_cert);
+    mbedtls_x509_crt_free(&_ca_cert);
+    mbedtls_ssl_free(&_ssl);
+    mbedtls_ssl_config_free(&_conf);
+    mbedtls_ctr_drbg_free(&_ctr_drbg);
+    mbedtls_entropy_free(&_entropy);
+}
+
+nsapi_error_t TLSSocket::open(NetworkStack *stack)
+{
+    int ret = mbedtls_ctr_drbg_seed(&_ctr_drbg, mbedtls_entropy_func, &_entropy,
+            NULL, 0);
+    if (ret != 0) {
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    return _tcp.open(stack);
+}
+
+nsapi_error_t TLSSocket::set_root_ca_cert(const void *ca, size_t len)
+{
+    if (mbedtls_x509_crt_parse(&_ca_cert, (const unsigned char *)ca, len) != 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _has_ca = true;
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t TLSSocket::set_client_cert_key(const void *cert, size_t cert_len,
+        const void *key, size_t key_len)
+{
+    if (mbedtls_x509_crt_parse(&_own_cert, (const unsigned char *)cert, cert_len) != 0 ||
+            mbedtls_pk_parse_key(&_own_key, (const unsigned char *)key, key_len, NULL, 0) != 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _has_own_cert = true;
+    return NSAPI_ERROR_OK;
+}
+
+int TLSSocket::_ssl_send(void *ctx, const unsigned char *buf, size_t len)
+{
+    nsapi_size_or_error_t ret = ((TCPSocket *)ctx)->send(buf, len);
+    if (ret == NSAPI_ERROR_WOULD_BLOCK) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    } else if (ret < 0) {
+        return MBEDTLS_ERR_NET_SEND_FAILED;
+    }
+
+    return ret;
+}
+
+int TLSSocket::_ssl_recv(void *ctx, unsigned char *buf, size_t len)
+{
+    nsapi_size_or_error_t ret = ((TCPSocket *)ctx)->recv(buf, len);
+    if (ret == NSAPI_ERROR_WOULD_BLOCK) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    } else if (ret < 0) {
+        return MBEDTLS_ERR_NET_RECV_FAILED;
+    }
+
+    return ret;
+}
+
+nsapi_error_t TLSSocket::_tls_error(int ret)
+{
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+
+    return NSAPI_ERROR_DEVICE_ERROR;
+}
+
+nsapi_error_t TLSSocket::connect(const char *host, uint16_t port)
+{
+    nsapi_error_t err = _tcp.connect(host, port);
+    if (err) {
+        return err;
+    }
+
+    int ret = mbedtls_ssl_config_defaults(&_conf, MBEDTLS_SSL_IS_CLIENT,
+            MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
+    if (ret != 0) {
+        _tcp.close();
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    mbedtls_ssl_conf_rng(&_conf, mbedtls_ctr_drbg_random, &_ctr_drbg);
+
+    if (_has_ca) {
+        mbedtls_ssl_conf_ca_chain(&_conf, &_ca_cert, NULL);
+        mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+    } else {
+        mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_NONE);
+    }
+
+    if (_has_own_cert) {
+        mbedtls_ssl_conf_own_cert(&_conf, &_own_cert, &_own_key);
+    }
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    mbedtls_ssl_conf_session_tickets(&_conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+
+    ret = mbedtls_ssl_setup(&_ssl, &_conf);
+    if (ret != 0) {
+        _tcp.close();
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    if (mbedtls_ssl_set_hostname(&_ssl, host) != 0) {
+        _tcp.close();
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+#if MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0
+    // offer the cached session for this peer so the server can resume
+    // it instead of running a full handshake
+    tls_session_cache_offer(&_ssl, host, port);
+#endif
+
+    mbedtls_ssl_set_bio(&_ssl, &_tcp, _ssl_send, _ssl_recv, NULL);
+
+    do {
+        ret = mbedtls_ssl_handshake(&_ssl);
+    } while (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+
+    if (ret != 0) {
+        _tcp.close();
+        return NSAPI_ERROR_AUTH_FAILURE;
+    }
+
+    _handshake_done = true;
+
+#if MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0
+    // cache the established session (ticket or session ID) for the
+    // next connect to this peer
+    tls_session_cache_put(host, port, &_ssl);
+#endif
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_size_or_error_t TLSSocket::send(const void *data, nsapi_size_t size)
+{
+    if (!_handshake_done) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    int ret = mbedtls_ssl_write(&_ssl, (const unsigned char *)data, size);
+    if (ret < 0) {
+        return _tls_error(ret);
+    }
+
+    return ret;
+}
+
+nsapi_size_or_error_t TLSSocket::recv(void *data, nsapi_size_t size)
+{
+    if (!_handshake_done) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    int ret = mbedtls_ssl_read(&_ssl, (unsigned char *)data, size);
+    if (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
+        return 0;
+    } else if (ret < 0) {
+        return _tls_error(ret);
+    }
+
+    return ret;
+}
+
+nsapi_error_t TLSSocket::close()
+{
+    if (_handshake_done) {
+        mbedtls_ssl_close_notify(&_ssl);
+        _handshake_done = false;
+    }
+
+    return _tcp.close();
+}
+
+void TLSSocket::set_timeout(int timeout)
+{
+    _tcp.set_timeout(timeout);
+}
+
+#endif /* MBEDTLS_SSL_CLI_C */
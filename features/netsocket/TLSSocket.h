@@ -0,0 +1,169 @@
+
+/** \addtogroup netsocket */
+/** @{*/
+/* TLSSocket
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TLSSOCKET_H
+#define TLSSOCKET_H
+
+#include "netsocket/TCPSocket.h"
+#include "platform/NonCopyable.h"
+
+#include "mbedtls/ssl.h"
+
+#if defined(MBEDTLS_SSL_CLI_C)
+
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+
+/** TLS socket connection
+ *
+ *  A TCP connection secured with mbed TLS. The socket keeps a small
+ *  process-wide session cache keyed by peer, so reconnecting to a host
+ *  resumes the previous session (by ticket or session ID) instead of
+ *  running a full handshake - on slow links this cuts reconnect latency
+ *  and radio airtime substantially. The cache size is set with
+ *  nsapi.tls-session-cache-size; 0 disables resumption.
+ *
+ *  Certificates are not verified unless a root CA is set with
+ *  set_root_ca_cert before connecting.
+ */
+class TLSSocket : private mbed::NonCopyable<TLSSocket> {
+public:
+    /** Create an uninitialized socket
+     *
+     *  Must call open to initialize the socket on a network stack.
+     */
+    TLSSocket();
+
+    /** Destroy a socket
+     *
+     *  Closes socket if the socket is still open
+     */
+    ~TLSSocket();
+
+    /** Opens a socket
+     *
+     *  Creates the underlying TCP socket on a network stack and seeds
+     *  the random generator used for the handshake.
+     *
+     *  @param stack    Network stack as target for socket
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t open(NetworkStack *stack);
+
+    template <typename S>
+    nsapi_error_t open(S *stack) {
+        return open(nsapi_create_stack(stack));
+    }
+
+    /** Set the root certificate authority used to verify the peer
+     *
+     *  @param ca       Root CA certificate in PEM or DER format
+     *  @param len      Length of the certificate, including the
+     *                  terminating null for PEM
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t set_root_ca_cert(const void *ca, size_t len);
+
+    /** Set the certificate and private key presented to the peer
+     *
+     *  @param cert     Client certificate in PEM or DER format
+     *  @param cert_len Length of the certificate, including the
+     *                  terminating null for PEM
+     *  @param key      Private key in PEM or DER format
+     *  @param key_len  Length of the key, including the terminating
+     *                  null for PEM
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t set_client_cert_key(const void *cert, size_t cert_len,
+            const void *key, size_t key_len);
+
+    /** Connect to a remote host and complete the TLS handshake
+     *
+     *  The hostname is used both for the server name indication and for
+     *  certificate verification, and keys the session cache entry. If a
+     *  cached session exists for the peer it is offered for resumption,
+     *  and the session established by the handshake is cached for the
+     *  next connect.
+     *
+     *  @param host     Hostname of the remote host
+     *  @param port     Port of the remote host
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t connect(const char *host, uint16_t port);
+
+    /** Send data over the TLS connection
+     *
+     *  @param data     Buffer of data to send to the host
+     *  @param size     Size of the buffer in bytes
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t send(const void *data, nsapi_size_t size);
+
+    /** Receive data over the TLS connection
+     *
+     *  @param data     Destination buffer for data received from the host
+     *  @param size     Size of the buffer in bytes
+     *  @return         Number of received bytes on success, 0 if the peer
+     *                  closed the connection, negative error code on failure
+     */
+    nsapi_size_or_error_t recv(void *data, nsapi_size_t size);
+
+    /** Close the connection
+     *
+     *  Sends a close notify to the peer if the handshake completed, then
+     *  closes the underlying TCP socket. The cached session survives the
+     *  close and is used to resume the next connection to the peer.
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t close();
+
+    /** Set timeout on blocking socket operations
+     *
+     *  @param timeout  Timeout in milliseconds, as for TCPSocket
+     */
+    void set_timeout(int timeout);
+
+private:
+    static int _ssl_send(void *ctx, const unsigned char *buf, size_t len);
+    static int _ssl_recv(void *ctx, unsigned char *buf, size_t len);
+
+    nsapi_error_t _tls_error(int ret);
+
+    TCPSocket _tcp;
+    mbedtls_entropy_context _entropy;
+    mbedtls_ctr_drbg_context _ctr_drbg;
+    mbedtls_ssl_config _conf;
+    mbedtls_ssl_context _ssl;
+    mbedtls_x509_crt _ca_cert;
+    mbedtls_x509_crt _own_cert;
+    mbedtls_pk_context _own_key;
+    bool _has_ca;
+    bool _has_own_cert;
+    bool _handshake_done;
+};
+
+#endif /* MBEDTLS_SSL_CLI_C */
+
+#endif
+
+/** @}*/
@@ -88,6 +88,89 @@ nsapi_size_or_error_t UDPSocket::sendto(const SocketAddress &address, const void
     return ret;
 }
 
+nsapi_error_t UDPSocket::set_destination(const char *host, uint16_t port)
+{
+    SocketAddress address;
+    nsapi_error_t err = _stack->gethostbyname(host, &address);
+    if (err) {
+        return NSAPI_ERROR_DNS_FAILURE;
+    }
+
+    address.set_port(port);
+
+    _lock.lock();
+    _dest = address;
+    _lock.unlock();
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_size_or_error_t UDPSocket::send(const void *data, nsapi_size_t size)
+{
+    _lock.lock();
+    SocketAddress address = _dest;
+    _lock.unlock();
+
+    // sendto is thread safe
+    return sendto(address, data, size);
+}
+
+nsapi_size_or_error_t UDPSocket::sendmmsg(nsapi_mmsg_t *msgs, int count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    int sent = 0;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_sendmmsg(_socket, msgs + sent, count - sent);
+        if (ret > 0) {
+            sent += ret;
+        }
+
+        if (sent == count) {
+            ret = sent;
+            break;
+        }
+
+        bool would_block = (ret == NSAPI_ERROR_WOULD_BLOCK)
+                || (ret > 0 && msgs[sent].result == NSAPI_ERROR_WOULD_BLOCK);
+        if (!would_block) {
+            // A real error stops the batch; report progress if any was made
+            if (ret >= 0) {
+                ret = (sent > 0) ? sent : msgs[sent].result;
+            }
+            break;
+        }
+
+        if (0 == _timeout) {
+            ret = (sent > 0) ? sent : NSAPI_ERROR_WOULD_BLOCK;
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = (sent > 0) ? sent : NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_size_or_error_t UDPSocket::recvfrom(SocketAddress *address, void *buffer, nsapi_size_t size)
 {
     _lock.lock();
@@ -125,6 +208,43 @@ nsapi_size_or_error_t UDPSocket::recvfrom(SocketAddress *address, void *buffer,
     return ret;
 }
 
+nsapi_size_or_error_t UDPSocket::recvmmsg(nsapi_mmsg_t *msgs, int count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_recvmmsg(_socket, msgs, count);
+        if (ret > 0 || (0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != ret)) {
+            // A burst was drained, or there is nothing to wait for
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 void UDPSocket::event()
 {
     _event_flag.set(READ_FLAG|WRITE_FLAG);
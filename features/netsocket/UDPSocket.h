@@ -94,6 +94,51 @@ public:
     nsapi_size_or_error_t sendto(const SocketAddress &address,
             const void *data, nsapi_size_t size);
 
+    /** Set a default destination for send
+     *
+     *  Resolves the host once and stores the result, so repeated send
+     *  calls skip the per-call hostname handling that sendto(host, ...)
+     *  performs.
+     *
+     *  @param host     Hostname of the remote host
+     *  @param port     Port of the remote host
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t set_destination(const char *host, uint16_t port);
+
+    /** Send a packet to the default destination
+     *
+     *  Sends data to the address stored by set_destination. Returns the
+     *  number of bytes sent from the buffer.
+     *
+     *  By default, send blocks until data is sent. If socket is set to
+     *  non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is returned
+     *  immediately.
+     *
+     *  @param data     Buffer of data to send to the host
+     *  @param size     Size of the buffer in bytes
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t send(const void *data, nsapi_size_t size);
+
+    /** Send a batch of packets over a UDP socket
+     *
+     *  Sends each message in the array to its address, recording the number
+     *  of bytes sent or an error code in the per-message result field. The
+     *  socket lock is taken once for the whole batch.
+     *
+     *  By default, sendmmsg blocks until every message is sent. If socket
+     *  is set to non-blocking or times out, the messages sent so far are
+     *  reported and the rest carry NSAPI_ERROR_WOULD_BLOCK in their result.
+     *
+     *  @param msgs     Array of messages to send
+     *  @param count    Number of messages in the array
+     *  @return         Number of messages sent on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t sendmmsg(nsapi_mmsg_t *msgs, int count);
+
     /** Receive a packet over a UDP socket
      *
      *  Receives data and stores the source address in address if address
@@ -112,12 +157,31 @@ public:
     nsapi_size_or_error_t recvfrom(SocketAddress *address,
             void *data, nsapi_size_t size);
 
+    /** Receive a batch of packets over a UDP socket
+     *
+     *  Drains buffered datagrams into the array, filling each message's
+     *  address, payload and result fields. The socket lock is taken once
+     *  for the whole batch.
+     *
+     *  By default, recvmmsg blocks only until the first datagram arrives
+     *  and then returns whatever burst is buffered. If socket is set to
+     *  non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is returned
+     *  immediately.
+     *
+     *  @param msgs     Array of messages to receive into
+     *  @param count    Number of messages in the array
+     *  @return         Number of messages received on success, negative
+     *                  error code on failure
+     */
+    nsapi_size_or_error_t recvmmsg(nsapi_mmsg_t *msgs, int count);
+
 protected:
     virtual nsapi_protocol_t get_proto();
     virtual void event();
 
     volatile unsigned _pending;
     rtos::EventFlags _event_flag;
+    SocketAddress _dest;
 };
 
 
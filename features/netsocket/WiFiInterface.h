@@ -21,6 +21,7 @@
 #include <string.h>
 #include "netsocket/NetworkInterface.h"
 #include "netsocket/WiFiAccessPoint.h"
+#include "Callback.h"
 
 /** WiFiInterface class
  *
@@ -99,6 +100,29 @@ public:
      *                   negative on error see @a nsapi_error
      */
     virtual nsapi_size_or_error_t scan(WiFiAccessPoint *res, nsapi_size_t count) = 0;
+
+    /** Scan for available networks, streaming each result through a callback
+     *
+     *  Unlike the array form of scan, no result storage is needed: the
+     *  callback is invoked once per discovered access point as the driver
+     *  parses it, with a WiFiAccessPoint that is only valid for the duration
+     *  of the call. Returning false from the callback stops the scan early.
+     *  The callback may run on the driver's own thread; it must not block
+     *  and must not call back into the interface.
+     *
+     *  This function will block until the scan completes or is stopped.
+     *  Drivers that do not support streaming return
+     *  NSAPI_ERROR_UNSUPPORTED; callers should fall back to the array form.
+     *
+     *  @param  cb       Callback invoked per discovered access point;
+     *                   return true to continue scanning, false to stop
+     *  @return          Number of access points seen (including any after a
+     *                   stop was requested), negative on error see @a nsapi_error
+     */
+    virtual nsapi_size_or_error_t scan(mbed::Callback<bool(const WiFiAccessPoint &)> cb)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
 };
 
 #endif
@@ -29,6 +29,9 @@
    google: https://www.google.de/search?q=APN+list   
 ---------------------------------------------------------------- */
 
+#include <stdint.h>
+#include <string.h>
+
 /**
  * Helper to generate the APN string
  */
@@ -59,6 +62,11 @@ static const char* apndef = _APN("internet",,);
  *
  * No need to add default, "internet" will be used as a default if no entry matches.
  * The APN without username/password have to be listed first.
+ *
+ * Flash footprint can be cut by defining APN_DB_SELECT_REGIONS and then
+ * APN_DB_REGION_<code> for each country block to keep (the code is the one
+ * in the block's comment, e.g. APN_DB_REGION_DE); unselected blocks are
+ * not compiled in.
  */
 
 static const APN_t apnlut[] = {
@@ -69,25 +77,34 @@ static const APN_t apnlut[] = {
 // MCC must be separated by '-' from MNC, multiple MNC can be separated by ','
 
 // 232 Austria - AUT
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_AUT)
     { /* T-Mobile */ "232-03",  _APN("m2m.business",,) },
+#endif
 
 // 460 China - CN
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_CN)
     { /* CN Mobile */"460-00",  _APN("cmnet",,)
                                 _APN("cmwap",,) },
     { /* Unicom */   "460-01",  _APN("3gnet",,)
                                 _APN("uninet","uninet","uninet") },
-                                
+#endif
+
 // 262 Germany - DE
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_DE)
     { /* T-Mobile */ "262-01",  _APN("internet.t-mobile","t-mobile","tm") },
-    { /* T-Mobile */ "262-02,06", 
+    { /* T-Mobile */ "262-02,06",
                                 _APN("m2m.business",,) },
+#endif
 
 // 222 Italy - IT
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_IT)
     { /* TIM */      "222-01",  _APN("ibox.tim.it",,) },
     { /* Vodafone */ "222-10",  _APN("web.omnitel.it",,) },
     { /* Wind */     "222-88",  _APN("internet.wind.biz",,) },
+#endif
 
 // 440 Japan - JP
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_JP)
     { /* Softbank */ "440-04,06,20,40,41,42,43,44,45,46,47,48,90,91,92,93,94,95"
                          ",96,97,98"
                                 _APN("open.softbank.ne.jp","opensoftbank","ebMNuX1FIHg9d3DA")
@@ -98,26 +115,36 @@ static const APN_t apnlut[] = {
                                 _APN("bmobilewap",,) /*BMobile*/
                                 _APN("mpr2.bizho.net","Mopera U",) /* DoCoMo */
                                 _APN("bmobile.ne.jp","bmobile@wifi2","bmobile") /*BMobile*/ },
+#endif
 
 // 204 Netherlands - NL
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_NL)
     { /* Vodafone */ "204-04",  _APN("public4.m2minternet.com",,) },
+#endif
 
 // 293 Slovenia - SI
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_SI)
     { /* Si.mobil */ "293-40",  _APN("internet.simobil.si",,) },
     { /* Tusmobil */ "293-70",  _APN("internet.tusmobil.si",,) },
+#endif
 
-// 240 Sweden SE 
+// 240 Sweden SE
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_SE)
     { /* Telia */    "240-01",  _APN("online.telia.se",,) },
     { /* Telenor */  "240-06,08",
-                                _APN("services.telenor.se",,) },              
+                                _APN("services.telenor.se",,) },
     { /* Tele2 */    "240-07",  _APN("mobileinternet.tele2.se",,) },
-    
+#endif
+
 // 228 Switzerland - CH
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_CH)
     { /* Swisscom */ "228-01",  _APN("gprs.swisscom.ch",,) },
     { /* Orange */   "228-03",  _APN("internet",,) /* contract */
                                 _APN("click",,)    /* pre-pay */ },
+#endif
 
 // 234 United Kingdom - GB
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_GB)
     { /* O2 */       "234-02,10,11",
                                 _APN("mobile.o2.co.uk","faster","web") /* contract */
                                 _APN("mobile.o2.co.uk","bypass","web") /* pre-pay */
@@ -126,8 +153,10 @@ static const APN_t apnlut[] = {
                                 _APN("pp.vodafone.co.uk","wap","wap")  /* pre-pay */ },
     { /* Three */    "234-20",  _APN("three.co.uk",,) },
     { /* Jersey */   "234-50",  _APN("jtm2m",,) /* as used on u-blox C030 U201 boards */ },
+#endif
 
 // 310 United States of America - US
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_US)
     { /* T-Mobile */ "310-026,260,490",
                                 _APN("epc.tmobile.com",,)
                                 _APN("fast.tmobile.com",,) /* LTE */ },
@@ -135,11 +164,113 @@ static const APN_t apnlut[] = {
                                 _APN("phone",,)
                                 _APN("wap.cingular","WAP@CINGULARGPRS.COM","CINGULAR1")
                                 _APN("isp.cingular","ISP@CINGULARGPRS.COM","CINGULAR1") },
+#endif
 
 // 901 International - INT
+#if !defined(APN_DB_SELECT_REGIONS) || defined(APN_DB_REGION_INT)
     { /* Transatel */ "901-37", _APN("netgprs.com","tsl","tsl") },
+#endif
 };
 
+/**
+ * Capacity of the sorted MCC/MNC index built from the table above.
+ * One slot is used per MCC/MNC pair (a table entry listing n MNCs uses
+ * n slots). If the table outgrows the index, lookups fall back to a
+ * linear scan of the table.
+ */
+#ifndef APN_DB_INDEX_SIZE
+#define APN_DB_INDEX_SIZE 128
+#endif
+
+/**
+ * Sorted index entry, keyed by MCC/MNC packed into one integer
+ */
+typedef struct {
+    uint32_t key;    /**< packed MCC/MNC, see apn_db_key */
+    const char* cfg; /**< APN configuration string of the owning entry */
+} APN_index_t;
+
+static APN_index_t apn_db_index[APN_DB_INDEX_SIZE];
+static int apn_db_index_count = 0;
+static bool apn_db_index_built = false;
+
+/**
+ * Pack MCC and MNC into one comparable key. The MNC length is part of
+ * the key so "02" and "002" stay distinct, as in the textual table.
+ */
+static inline uint32_t apn_db_key(uint32_t mcc, uint32_t mnc, uint32_t mnc_len)
+{
+    return (mcc << 11) | ((mnc_len == 3 ? 1u : 0u) << 10) | mnc;
+}
+
+/**
+ * Parse up to len decimal digits, returning the value
+ */
+static inline uint32_t apn_db_digits(const char* p, int len)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < len; i++) {
+        value = value * 10 + (p[i] - '0');
+    }
+    return value;
+}
+
+/**
+ * Expand the table into the sorted index, one slot per MCC/MNC pair.
+ * Runs once on first lookup; the table stays the single source kept by
+ * hand, so nobody has to maintain packed sorted keys manually.
+ */
+static inline bool apn_db_index_build()
+{
+    for (size_t i = 0; i < sizeof(apnlut)/sizeof(*apnlut); i++) {
+        const char* p = apnlut[i].mccmnc;
+        if (!apnlut[i].cfg) {
+            continue;
+        }
+        uint32_t mcc = apn_db_digits(p, 3);
+        p += 3;
+        while (((p[0] == '-') || (p[0] == ',')) &&
+                (p[1] >= '0') && (p[1] <= '9') &&
+                (p[2] >= '0') && (p[2] <= '9')) {
+            int l = ((p[3] >= '0') && (p[3] <= '9')) ? 3 : 2;
+            if (apn_db_index_count >= APN_DB_INDEX_SIZE) {
+                return false;
+            }
+            uint32_t key = apn_db_key(mcc, apn_db_digits(p + 1, l), l);
+            // insertion sort - the index is built once, searched often
+            int j = apn_db_index_count++;
+            while (j > 0 && apn_db_index[j-1].key > key) {
+                apn_db_index[j] = apn_db_index[j-1];
+                j--;
+            }
+            apn_db_index[j].key = key;
+            apn_db_index[j].cfg = apnlut[i].cfg;
+            p += 1 + l;
+        }
+    }
+    return true;
+}
+
+/**
+ * Binary search the index for a packed MCC/MNC key
+ */
+static inline const char* apn_db_index_find(uint32_t key)
+{
+    int lo = 0;
+    int hi = apn_db_index_count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (apn_db_index[mid].key < key) {
+            lo = mid + 1;
+        } else if (apn_db_index[mid].key > key) {
+            hi = mid - 1;
+        } else {
+            return apn_db_index[mid].cfg;
+        }
+    }
+    return NULL;
+}
+
 /**
  * Configuring APN by extraction from IMSI and matching the table.
  *
@@ -148,23 +279,37 @@ static const APN_t apnlut[] = {
 inline const char* apnconfig(const char* imsi)
 {
     const char* config = NULL;
-    if (imsi && *imsi) {
-        // many carriers use internet without username and password, os use this as default
-        // now try to lookup the setting for our table
-        for (size_t i = 0; i < sizeof(apnlut)/sizeof(*apnlut) && !config; i ++) {
-            const char* p = apnlut[i].mccmnc;
-            // check the MCC
-            if ((0 == memcmp(imsi, p, 3))) {
-                p += 3;
-                // check all the MNC, MNC length can be 2 or 3 digits
-                while (((p[0] == '-') || (p[0] == ',')) && 
-                        (p[1] >= '0') && (p[1] <= '9') && 
-                        (p[2] >= '0') && (p[2] <= '9') && !config) {
-                    int l = ((p[3] >= '0') && (p[3] <= '9')) ? 3 : 2;
-                    if (0 == memcmp(imsi+3,p+1,l))
-                        config = apnlut[i].cfg;
-                    p += 1 + l;
-                } 
+    size_t imsi_len = imsi ? strlen(imsi) : 0;
+    if (imsi_len >= 5) {
+        if (!apn_db_index_built) {
+            apn_db_index_built = apn_db_index_build();
+        }
+
+        if (apn_db_index_built) {
+            // the MNC is 2 or 3 digits and the IMSI does not say which -
+            // probe both lengths against the sorted index
+            uint32_t mcc = apn_db_digits(imsi, 3);
+            config = apn_db_index_find(apn_db_key(mcc, apn_db_digits(imsi + 3, 2), 2));
+            if (!config && imsi_len >= 6) {
+                config = apn_db_index_find(apn_db_key(mcc, apn_db_digits(imsi + 3, 3), 3));
+            }
+        } else {
+            // index capacity exceeded - scan the table directly
+            for (size_t i = 0; i < sizeof(apnlut)/sizeof(*apnlut) && !config; i ++) {
+                const char* p = apnlut[i].mccmnc;
+                // check the MCC
+                if ((0 == memcmp(imsi, p, 3))) {
+                    p += 3;
+                    // check all the MNC, MNC length can be 2 or 3 digits
+                    while (((p[0] == '-') || (p[0] == ',')) &&
+                            (p[1] >= '0') && (p[1] <= '9') &&
+                            (p[2] >= '0') && (p[2] <= '9') && !config) {
+                        int l = ((p[3] >= '0') && (p[3] <= '9')) ? 3 : 2;
+                        if (0 == memcmp(imsi+3,p+1,l))
+                            config = apnlut[i].cfg;
+                        p += 1 + l;
+                    }
+                }
             }
         }
     }
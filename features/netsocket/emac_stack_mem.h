@@ -41,6 +41,34 @@ typedef void emac_stack_t;
  */
 emac_stack_mem_t *emac_stack_mem_alloc(emac_stack_t* stack, uint32_t size, uint32_t align);
 
+/**
+ * Callback used to return a buffer wrapped with @a emac_stack_mem_alloc_ref to the driver
+ *
+ * Called once the stack has finished reading the buffer, from stack context. The driver
+ * may hand the buffer back to its DMA ring from here.
+ *
+ * @param arg     Arbitrary driver data
+ * @param payload Buffer passed to @a emac_stack_mem_alloc_ref
+ */
+typedef void (*emac_stack_mem_free_fn)(void *arg, void *payload);
+
+/**
+ * Wraps a driver-owned buffer into stack memory without copying
+ *
+ * The stack reads the payload in place, so the buffer (typically DMA-filled) must stay
+ * untouched until @a free_cb is called. Drivers that receive NULL here, or that run on a
+ * stack without buffer wrapping, should fall back to @a emac_stack_mem_alloc and a copy.
+ *
+ * @param  stack   Emac stack context
+ * @param  ptr     Driver-owned payload buffer
+ * @param  len     Payload size in bytes
+ * @param  free_cb Function called once the stack is done with the buffer
+ * @param  arg     Arbitrary driver data passed to @a free_cb
+ * @return         Allocated memory struct, or NULL if no wrapper is available
+ */
+emac_stack_mem_t *emac_stack_mem_alloc_ref(emac_stack_t* stack, void *ptr, uint32_t len,
+                                           emac_stack_mem_free_fn free_cb, void *arg);
+
 /**
  * Free memory allocated using @a stack_mem_alloc
  *
@@ -16,10 +16,20 @@
  */
 #include "nsapi_dns.h"
 #include "netsocket/UDPSocket.h"
+#include "events/mbed_shared_queues.h"
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+#include "cmsis_os2.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 
+#ifndef MBED_CONF_NSAPI_DNS_ENABLED
+#define MBED_CONF_NSAPI_DNS_ENABLED 1
+#endif
+
+#if MBED_CONF_NSAPI_DNS_ENABLED
+
 #define CLASS_IN 1
 
 #define RR_A 1
@@ -29,6 +39,17 @@
 #define DNS_BUFFER_SIZE 512
 #define DNS_TIMEOUT 5000
 #define DNS_SERVERS_SIZE 5
+#define DNS_HOST_SIZE 128
+
+// DNS cache options
+#ifndef MBED_CONF_NSAPI_DNS_CACHE_SIZE
+#define MBED_CONF_NSAPI_DNS_CACHE_SIZE 4
+#endif
+#define DNS_CACHE_SIZE MBED_CONF_NSAPI_DNS_CACHE_SIZE
+#define DNS_CACHE_NEGATIVE_TTL 30
+// Expiry comparisons are done with wrapping kernel ticks, so a TTL must
+// stay below half the 32-bit millisecond tick range
+#define DNS_CACHE_MAX_TTL (0x7fffffff / 1000)
 
 nsapi_addr_t dns_servers[DNS_SERVERS_SIZE] = {
     {NSAPI_IPv4, {8, 8, 8, 8}},                             // Google
@@ -51,6 +72,110 @@ extern "C" nsapi_error_t nsapi_dns_add_server(nsapi_addr_t addr)
 }
 
 
+// DNS cache
+#if DNS_CACHE_SIZE > 0
+struct dns_cache_entry {
+    char host[DNS_HOST_SIZE + 1];
+    nsapi_version_t version;
+    nsapi_addr_t addr;
+    nsapi_error_t result;
+    uint32_t expires;
+    uint32_t accessed;
+    bool in_use;
+};
+
+static dns_cache_entry dns_cache[DNS_CACHE_SIZE];
+static SingletonPtr<PlatformMutex> dns_cache_mutex;
+
+static bool nsapi_dns_cache_find(const char *host, nsapi_version_t version,
+        nsapi_addr_t *addr, nsapi_error_t *result)
+{
+    uint32_t now = osKernelGetTickCount();
+    bool found = false;
+
+    dns_cache_mutex->lock();
+
+    for (int i = 0; i < DNS_CACHE_SIZE; i++) {
+        dns_cache_entry *entry = &dns_cache[i];
+        if (!entry->in_use) {
+            continue;
+        }
+
+        // drop stale entries as they are encountered
+        if ((int32_t)(now - entry->expires) >= 0) {
+            entry->in_use = false;
+            continue;
+        }
+
+        if (entry->version == version && strcmp(entry->host, host) == 0) {
+            entry->accessed = now;
+            *addr = entry->addr;
+            *result = entry->result;
+            found = true;
+            break;
+        }
+    }
+
+    dns_cache_mutex->unlock();
+    return found;
+}
+
+static void nsapi_dns_cache_store(const char *host, nsapi_version_t version,
+        const nsapi_addr_t *addr, nsapi_error_t result, uint32_t ttl)
+{
+    if (strlen(host) > DNS_HOST_SIZE || ttl == 0) {
+        return;
+    }
+
+    if (ttl > DNS_CACHE_MAX_TTL) {
+        ttl = DNS_CACHE_MAX_TTL;
+    }
+
+    uint32_t now = osKernelGetTickCount();
+
+    dns_cache_mutex->lock();
+
+    // reuse an existing entry for the host, then a free entry,
+    // then the least-recently used entry
+    dns_cache_entry *victim = &dns_cache[0];
+
+    for (int i = 0; i < DNS_CACHE_SIZE; i++) {
+        dns_cache_entry *entry = &dns_cache[i];
+        if (entry->in_use && (int32_t)(now - entry->expires) >= 0) {
+            entry->in_use = false;
+        }
+
+        if (entry->in_use && entry->version == version && strcmp(entry->host, host) == 0) {
+            victim = entry;
+            break;
+        }
+
+        if (!victim->in_use) {
+            continue;
+        }
+
+        if (!entry->in_use || (int32_t)(entry->accessed - victim->accessed) < 0) {
+            victim = entry;
+        }
+    }
+
+    strcpy(victim->host, host);
+    victim->version = version;
+    if (addr) {
+        victim->addr = *addr;
+    } else {
+        memset(&victim->addr, 0, sizeof victim->addr);
+    }
+    victim->result = result;
+    victim->expires = now + ttl*1000;
+    victim->accessed = now;
+    victim->in_use = true;
+
+    dns_cache_mutex->unlock();
+}
+#endif
+
+
 // DNS packet parsing
 static void dns_append_byte(uint8_t **p, uint8_t byte)
 {
@@ -112,8 +237,10 @@ static void dns_append_question(uint8_t **p, const char *host, nsapi_version_t v
     dns_append_word(p, CLASS_IN);
 }
 
-static int dns_scan_response(const uint8_t **p, nsapi_addr_t *addr, unsigned addr_count)
+static int dns_scan_response(const uint8_t **p, nsapi_addr_t *addr, unsigned addr_count, uint32_t *ttl)
 {
+    *ttl = DNS_CACHE_MAX_TTL;
+
     // scan header
     uint16_t id    = dns_scan_word(p);
     uint16_t flags = dns_scan_word(p);
@@ -164,7 +291,8 @@ static int dns_scan_response(const uint8_t **p, nsapi_addr_t *addr, unsigned add
 
         uint16_t rtype    = dns_scan_word(p); // rtype
         uint16_t rclass   = dns_scan_word(p); // rclass
-        *p += 4;                              // ttl
+        uint32_t rttl     = dns_scan_word(p); // ttl
+        rttl = (rttl << 16) | dns_scan_word(p);
         uint16_t rdlength = dns_scan_word(p); // rdlength
 
         if (rtype == RR_A && rclass == CLASS_IN && rdlength == NSAPI_IPv4_BYTES) {
@@ -174,6 +302,9 @@ static int dns_scan_response(const uint8_t **p, nsapi_addr_t *addr, unsigned add
                 addr->bytes[i] = dns_scan_byte(p);
             }
 
+            if (rttl < *ttl) {
+                *ttl = rttl;
+            }
             addr += 1;
             count += 1;
         } else if (rtype == RR_AAAA && rclass == CLASS_IN && rdlength == NSAPI_IPv6_BYTES) {
@@ -183,6 +314,9 @@ static int dns_scan_response(const uint8_t **p, nsapi_addr_t *addr, unsigned add
                 addr->bytes[i] = dns_scan_byte(p);
             }
 
+            if (rttl < *ttl) {
+                *ttl = rttl;
+            }
             addr += 1;
             count += 1;
         } else {
@@ -200,10 +334,24 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
 {
     // check for valid host name
     int host_len = host ? strlen(host) : 0;
-    if (host_len > 128 || host_len == 0) {
+    if (host_len > DNS_HOST_SIZE || host_len == 0) {
         return NSAPI_ERROR_PARAMETER;
     }
 
+#if DNS_CACHE_SIZE > 0
+    // consult the cache before going out to the servers
+    nsapi_addr_t cached_addr;
+    nsapi_error_t cached_result;
+    if (nsapi_dns_cache_find(host, version, &cached_addr, &cached_result)) {
+        if (cached_result != NSAPI_ERROR_OK) {
+            return cached_result;
+        }
+
+        addr[0] = cached_addr;
+        return 1;
+    }
+#endif
+
     // create a udp socket
     UDPSocket socket;
     int err = socket.open(stack);
@@ -243,10 +391,24 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
         }
 
         const uint8_t *response = packet;
-        if (dns_scan_response(&response, addr, addr_count) > 0) {
+        uint32_t ttl;
+        int count = dns_scan_response(&response, addr, addr_count, &ttl);
+        if (count > 0) {
             result = NSAPI_ERROR_OK;
         }
 
+#if DNS_CACHE_SIZE > 0
+        // cache the server's answer; a definitive response with no usable
+        // records is cached briefly so reconnect storms don't keep re-asking
+        // for a name that is not there
+        if (count > 0) {
+            nsapi_dns_cache_store(host, version, &addr[0], NSAPI_ERROR_OK, ttl);
+        } else {
+            nsapi_dns_cache_store(host, version, NULL, NSAPI_ERROR_DNS_FAILURE,
+                    DNS_CACHE_NEGATIVE_TTL);
+        }
+#endif
+
         /* The DNS response is final, no need to check other servers */
         break;
     }
@@ -304,3 +466,86 @@ nsapi_error_t nsapi_dns_query(NetworkStack *stack, const char *host,
     address->set_addr(addr);
     return (nsapi_error_t)((result > 0) ? 0 : result);
 }
+
+// asynchronous queries run the blocking query on the shared event queue
+struct dns_async_query {
+    NetworkStack *stack;
+    char host[DNS_HOST_SIZE + 1];
+    nsapi_version_t version;
+    mbed::Callback<void(nsapi_error_t, SocketAddress *)> callback;
+};
+
+static void nsapi_dns_query_async_runner(dns_async_query *query)
+{
+    SocketAddress address;
+    nsapi_error_t result = nsapi_dns_query(query->stack, query->host, &address, query->version);
+    query->callback(result, (result == NSAPI_ERROR_OK) ? &address : NULL);
+    delete query;
+}
+
+nsapi_error_t nsapi_dns_query_async(NetworkStack *stack, const char *host,
+        mbed::Callback<void(nsapi_error_t, SocketAddress *)> callback,
+        nsapi_version_t version)
+{
+    int host_len = host ? strlen(host) : 0;
+    if (host_len > DNS_HOST_SIZE || host_len == 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    dns_async_query *query = new dns_async_query;
+    query->stack = stack;
+    strcpy(query->host, host);
+    query->version = version;
+    query->callback = callback;
+
+    if (!mbed::mbed_event_queue()->call(nsapi_dns_query_async_runner, query)) {
+        delete query;
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+#else /* MBED_CONF_NSAPI_DNS_ENABLED */
+
+// Resolver compiled out (nsapi.dns-enabled is false). The entry points
+// remain so NetworkStack and application code link unchanged; they just
+// report the operation as unsupported.
+
+extern "C" nsapi_error_t nsapi_dns_add_server(nsapi_addr_t addr)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+extern "C" nsapi_size_or_error_t nsapi_dns_query_multiple(nsapi_stack_t *stack, const char *host,
+        nsapi_addr_t *addr, nsapi_size_t addr_count, nsapi_version_t version)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const char *host,
+        SocketAddress *addresses, nsapi_size_t addr_count, nsapi_version_t version)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+extern "C" nsapi_error_t nsapi_dns_query(nsapi_stack_t *stack, const char *host,
+        nsapi_addr_t *addr, nsapi_version_t version)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t nsapi_dns_query(NetworkStack *stack, const char *host,
+        SocketAddress *address, nsapi_version_t version)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t nsapi_dns_query_async(NetworkStack *stack, const char *host,
+        mbed::Callback<void(nsapi_error_t, SocketAddress *)> callback,
+        nsapi_version_t version)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+#endif /* MBED_CONF_NSAPI_DNS_ENABLED */
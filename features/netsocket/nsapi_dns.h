@@ -23,6 +23,7 @@
 #include "nsapi_types.h"
 #ifdef __cplusplus
 #include "netsocket/NetworkStack.h"
+#include "platform/Callback.h"
 #endif
 
 #ifndef __cplusplus
@@ -148,6 +149,42 @@ nsapi_size_or_error_t nsapi_dns_query_multiple(S *stack, const char *host,
                 host, addr, addr_count, version);
 }
 
+/** Query a domain name server for an IP address without blocking the caller
+ *
+ *  The query is run on the shared event queue and the callback is invoked
+ *  from its dispatch context when the result is known. A cached answer is
+ *  still delivered through the callback. On failure the callback receives
+ *  a NULL address.
+ *
+ *  The callback must not be NULL and should not block the event queue for
+ *  long, as other users share its dispatch thread.
+ *
+ *  @param stack    Network stack as target for DNS query
+ *  @param host     Hostname to resolve
+ *  @param callback Function to call with the result and resolved address
+ *  @param version  IP version to resolve (defaults to NSAPI_IPv4)
+ *  @return         0 if the query was enqueued, negative error code on failure
+ */
+nsapi_error_t nsapi_dns_query_async(NetworkStack *stack, const char *host,
+        mbed::Callback<void(nsapi_error_t, SocketAddress *)> callback,
+        nsapi_version_t version = NSAPI_IPv4);
+
+/** Query a domain name server for an IP address without blocking the caller
+ *
+ *  @param stack    Network stack as target for DNS query
+ *  @param host     Hostname to resolve
+ *  @param callback Function to call with the result and resolved address
+ *  @param version  IP version to resolve (defaults to NSAPI_IPv4)
+ *  @return         0 if the query was enqueued, negative error code on failure
+ */
+template <typename S>
+nsapi_error_t nsapi_dns_query_async(S *stack, const char *host,
+        mbed::Callback<void(nsapi_error_t, SocketAddress *)> callback,
+        nsapi_version_t version = NSAPI_IPv4)
+{
+    return nsapi_dns_query_async(nsapi_create_stack(stack), host, callback, version);
+}
+
 /** Add a domain name server to list of servers to query
  *
  *  @param addr     Destination for the host address
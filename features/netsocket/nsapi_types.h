@@ -214,6 +214,8 @@ typedef enum nsapi_socket_option {
     NSAPI_LINGER,    /*!< Keeps close from returning until queues empty */
     NSAPI_SNDBUF,    /*!< Sets send buffer size */
     NSAPI_RCVBUF,    /*!< Sets recv buffer size */
+    NSAPI_CORK,      /*!< Holds back partial TCP segments so consecutive sends coalesce; cleared to flush */
+    NSAPI_NODELAY,   /*!< Disables Nagle's algorithm so small sends go out immediately */
 } nsapi_socket_option_t;
 
 /** Supported IP protocol versions of IP stack
@@ -243,6 +245,27 @@ typedef struct nsapi_wifi_ap {
     uint8_t channel;
 } nsapi_wifi_ap_t;
 
+/** nsapi_iovec structure
+ *
+ *  One contiguous piece of a vectored socket transfer
+ */
+typedef struct nsapi_iovec {
+    const void *base;  /*!< Start of the piece */
+    nsapi_size_t len;  /*!< Length of the piece in bytes */
+} nsapi_iovec_t;
+
+/** nsapi_pool_stats structure
+ *
+ *  Utilization counters for one of a stack's internal memory pools
+ */
+typedef struct nsapi_pool_stats {
+    const char *name;  /*!< Pool name, NULL if the stack has no names compiled in */
+    uint32_t avail;    /*!< Total number of elements in the pool */
+    uint32_t used;     /*!< Elements currently in use */
+    uint32_t max;      /*!< High-water mark of elements in use */
+    uint32_t err;      /*!< Allocation failures (requests dropped) */
+} nsapi_pool_stats_t;
+
 
 /** nsapi_stack structure
  *
@@ -554,6 +577,80 @@ typedef struct nsapi_stack_api
      */    
     nsapi_error_t (*getsockopt)(nsapi_stack_t *stack, nsapi_socket_t socket, int level,
             int optname, void *optval, unsigned *optlen);
+
+    /*  Borrow the stack's receive buffer without copying
+     *
+     *  Lends the next contiguous chunk of received data directly out of
+     *  the stack's own buffering to the caller. The chunk stays owned by
+     *  the stack and remains valid until it is consumed with
+     *  socket_recv_release.
+     *
+     *  This call is non-blocking. If no data is buffered,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  Stacks that cannot lend their buffers leave this entry NULL.
+     *
+     *  @param stack    Stack handle
+     *  @param socket   Socket handle
+     *  @param data     Destination for a pointer into the stack's buffer
+     *  @return         Number of bytes available at *data on success,
+     *                  negative error code on failure
+     */
+    nsapi_size_or_error_t (*socket_recv_borrow)(nsapi_stack_t *stack, nsapi_socket_t socket,
+            void **data);
+
+    /*  Consume data lent out by socket_recv_borrow
+     *
+     *  Releases size bytes back to the stack. Consumed buffer space may be
+     *  freed or reused by the stack immediately.
+     *
+     *  @param stack    Stack handle
+     *  @param socket   Socket handle
+     *  @param size     Number of borrowed bytes the application is done with
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t (*socket_recv_release)(nsapi_stack_t *stack, nsapi_socket_t socket,
+            nsapi_size_t size);
+
+    /*  Send a list of buffers over a TCP socket as one message
+     *
+     *  The pieces are handed to the stack together so it can pack them
+     *  into segments without the caller staging them into one contiguous
+     *  buffer. Returns the total number of bytes sent.
+     *
+     *  This call is non-blocking. If sendv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  Stacks without vectored send leave this entry NULL and the pieces
+     *  are sent back-to-back through socket_send instead.
+     *
+     *  @param stack    Stack handle
+     *  @param socket   Socket handle
+     *  @param iov      Array of buffers to send
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t (*socket_sendv)(nsapi_stack_t *stack, nsapi_socket_t socket,
+            const nsapi_iovec_t *iov, int iovcnt);
+
+    /*  Read utilization statistics of the stack's internal memory pools
+     *
+     *  Fills up to count entries, one per pool, and returns the number
+     *  filled. Counters are sampled without locking - they may be
+     *  mutually inconsistent for an instant, which is acceptable for
+     *  telemetry.
+     *
+     *  Stacks without pool statistics leave this entry NULL.
+     *
+     *  @param stack    Stack handle
+     *  @param stats    Array of statistics entries to fill
+     *  @param count    Number of entries in the array
+     *  @return         Number of entries filled, or negative error code
+     *                  if statistics are not compiled in
+     */
+    nsapi_size_or_error_t (*get_pool_stats)(nsapi_stack_t *stack,
+            nsapi_pool_stats_t *stats, unsigned count);
 } nsapi_stack_api_t;
 
 
@@ -250,6 +250,21 @@ typedef struct ARM_CFSTORE_KEYDESC
 } ARM_CFSTORE_KEYDESC;
 
 
+/** @brief   Descriptor for one key in a ARM_CFSTORE_DRIVER::(*ReadMultiple)() batch. */
+typedef struct ARM_CFSTORE_KV_READ
+{
+    const char* key_name;       //!< IN: zero terminated string specifying the key name.
+                                //!< Must not contain match expression characters.
+    void* value;                //!< IN: buffer supplied by the caller for CFSTORE to fill with
+                                //!< value data. May be NULL to retrieve the value length alone.
+    ARM_CFSTORE_SIZE value_len; //!< IN: length of the buffer available at value.
+                                //!< OUT: on success, the number of octets stored at value, or
+                                //!< the KV value length when value == NULL.
+    int32_t status;             //!< OUT: ARM_DRIVER_OK on success, else the error code for
+                                //!< this key e.g. key not found.
+} ARM_CFSTORE_KV_READ;
+
+
 /** @brief
  *
  * These are the command code values used for the cmd_code argument to the
@@ -762,6 +777,32 @@ typedef struct _ARM_DRIVER_CFSTORE
     int32_t (*Read)(ARM_CFSTORE_HANDLE hkey, void* data, ARM_CFSTORE_SIZE* len);
 
 
+    /** @brief  Read the values of a batch of keys in a single call.
+     *
+     * Each key named in the kvs array is located and its value data copied
+     * into the client supplied buffer without creating an open handle, which
+     * makes this the cheapest way to load many KVs e.g. reading the
+     * configuration keys at boot. The per-key completion status is reported
+     * in the ARM_CFSTORE_KV_READ descriptor.
+     *
+     * @param   kvs
+     *          IN/OUT: array of count key read descriptors (see
+     *          ARM_CFSTORE_KV_READ).
+     * @param   count
+     *          IN: number of descriptors in the kvs array.
+     *
+     * @return
+     *          return_value >= 0 => synchronous completion with the number
+     *          of keys read successfully == return_value. Keys that could
+     *          not be read report the reason in their descriptor status.
+     *          return_value < 0, error condition.
+     *
+     * ReadMultiple() always completes synchronously and does not invoke the
+     * client callback.
+     */
+    int32_t (*ReadMultiple)(ARM_CFSTORE_KV_READ* kvs, uint32_t count);
+
+
     /** @brief  Open a key-value object for future operations.
      *
      * @param   key_name
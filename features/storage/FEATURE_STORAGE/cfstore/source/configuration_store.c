@@ -259,6 +259,8 @@ static int32_t cfstore_fsm_state_handle_event(cfstore_fsm_t* fsm, cfstore_fsm_ev
 static int32_t cfstore_fsm_state_set(cfstore_fsm_t* fsm, cfstore_fsm_state_t new_state, void* ctx);
 #endif  /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
 static int32_t cfstore_get_key_name_ex(cfstore_area_hkvt_t *hkvt, char* key_name, uint8_t *key_name_len);
+static void cfstore_index_invalidate(void);
+static void cfstore_index_free(void);
 
 
 /* Walking Area HKVT's While Inserting   a New HKVT:
@@ -1429,6 +1431,11 @@ static int32_t cfstore_realloc_ex(ARM_CFSTORE_SIZE size, uint64_t *allocated_siz
     CFSTORE_FENTRYLOG("%s:entered:\n", __func__);
     CFSTORE_TP(CFSTORE_TP_MEM, "%s:cfstore_ctx_g.area_0_head=%p, cfstore_ctx_g.area_0_tail=%p, cfstore_ctx_g.area_0_len=%d, size=%d, \n", __func__, ctx->area_0_head, ctx->area_0_tail, (int) ctx->area_0_len, (int) size);
 
+    /* all KV additions, deletions and resizes come through here, and any of
+     * them can move KVs within (or move) the area, so the kv index offsets
+     * can no longer be trusted */
+    cfstore_index_invalidate();
+
     if(size > 0)
     {
         /* In the general case (size % program_unit > 0). The new area_0 size is
@@ -3136,6 +3143,193 @@ out0:
  *          returned. If a KV is not found matching the description then
  *          ARM_CFSTORE_DRIVER_ERROR_KEY_NOT_FOUND is returned.
  */
+/*
+ * KV index
+ *
+ * In-RAM hash index over the KV area so that exact-name lookups (Open(),
+ * Find() without match expression characters, ReadMultiple()) cost a hash
+ * probe rather than a linear scan with a name match against every KV.
+ * Entries store byte offsets from area_0_head so the index remains usable
+ * when realloc() moves the area; any operation that adds, deletes or
+ * resizes a KV goes through cfstore_realloc_ex() which invalidates the
+ * index, and the next exact-name lookup rebuilds it with a single walk of
+ * the area. The index requires the heap and so is not available in the
+ * client supplied memory slab configuration, where lookups fall back to
+ * scanning.
+ */
+#ifndef CFSTORE_YOTTA_CFG_CFSTORE_SRAM_ADDR
+#define CFSTORE_KV_INDEX_ENABLED 1
+#endif
+
+#ifdef CFSTORE_KV_INDEX_ENABLED
+
+/* open addressed (linear probed) table entry. offset is the byte offset of
+ * the KV head from area_0_head plus 1, so 0 marks an empty slot */
+typedef struct cfstore_index_entry_t
+{
+    uint32_t hash;
+    uint32_t offset;
+} cfstore_index_entry_t;
+
+static cfstore_index_entry_t* cfstore_index_g = NULL;
+static uint32_t cfstore_index_capacity_g = 0;
+static bool cfstore_index_valid_g = false;
+
+static void cfstore_index_invalidate(void)
+{
+    cfstore_index_valid_g = false;
+}
+
+static void cfstore_index_free(void)
+{
+    if(cfstore_index_g != NULL){
+        CFSTORE_FREE(cfstore_index_g);
+        cfstore_index_g = NULL;
+    }
+    cfstore_index_capacity_g = 0;
+    cfstore_index_valid_g = false;
+}
+
+/* @brief   djb2 string hash of a key name */
+static uint32_t cfstore_index_hash(const char* key_name)
+{
+    uint32_t hash = 5381;
+
+    while(*key_name != '\0'){
+        hash = ((hash << 5) + hash) + (uint8_t) *key_name++;
+    }
+    return hash;
+}
+
+static void cfstore_index_insert(uint32_t hash, uint32_t offset)
+{
+    uint32_t slot = hash & (cfstore_index_capacity_g - 1);
+
+    while(cfstore_index_g[slot].offset != 0){
+        slot = (slot + 1) & (cfstore_index_capacity_g - 1);
+    }
+    cfstore_index_g[slot].hash = hash;
+    cfstore_index_g[slot].offset = offset + 1;
+}
+
+/* @brief   rebuild the index with a single walk of the KV area */
+static int32_t cfstore_index_rebuild(void)
+{
+    int32_t ret;
+    uint32_t count = 0;
+    uint32_t capacity;
+    uint8_t key_name_len;
+    char key_name[CFSTORE_KEY_NAME_MAX_LENGTH+1];
+    cfstore_area_hkvt_t hkvt;
+    cfstore_ctx_t* ctx = cfstore_ctx_get();
+
+    CFSTORE_FENTRYLOG("%s:entered:\n", __func__);
+    /* first pass: count the KVs to size the table */
+    ret = cfstore_get_head_hkvt(&hkvt);
+    while(ret >= ARM_DRIVER_OK && cfstore_hkvt_is_valid(&hkvt, ctx->area_0_tail)){
+        count++;
+        ret = cfstore_get_next_hkvt(&hkvt, &hkvt);
+    }
+
+    /* capacity is the power of 2 giving a load factor of at most 0.5 */
+    capacity = 16;
+    while(capacity < 2 * count){
+        capacity *= 2;
+    }
+    if(capacity != cfstore_index_capacity_g){
+        cfstore_index_free();
+        cfstore_index_g = (cfstore_index_entry_t*) CFSTORE_MALLOC(capacity * sizeof(cfstore_index_entry_t));
+        if(cfstore_index_g == NULL){
+            CFSTORE_TP(CFSTORE_TP_MEM, "%s:unable to allocate kv index (capacity=%d)\n", __func__, (int) capacity);
+            return ARM_CFSTORE_DRIVER_ERROR_OUT_OF_MEMORY;
+        }
+        cfstore_index_capacity_g = capacity;
+    }
+    memset(cfstore_index_g, 0, capacity * sizeof(cfstore_index_entry_t));
+
+    /* second pass: insert (hash, offset) pairs */
+    ret = cfstore_get_head_hkvt(&hkvt);
+    while(ret >= ARM_DRIVER_OK && cfstore_hkvt_is_valid(&hkvt, ctx->area_0_tail)){
+        key_name_len = CFSTORE_KEY_NAME_MAX_LENGTH+1;
+        memset(key_name, 0, key_name_len);
+        ret = cfstore_get_key_name_ex(&hkvt, key_name, &key_name_len);
+        if(ret < ARM_DRIVER_OK){
+            return ret;
+        }
+        cfstore_index_insert(cfstore_index_hash(key_name), (uint32_t)(hkvt.head - ctx->area_0_head));
+        ret = cfstore_get_next_hkvt(&hkvt, &hkvt);
+    }
+    cfstore_index_valid_g = true;
+    return ARM_DRIVER_OK;
+}
+
+/* @brief   exact-name KV lookup via the hash index
+ * @return  ARM_DRIVER_OK with next set on a match,
+ *          ARM_CFSTORE_DRIVER_ERROR_KEY_NOT_FOUND when the key is not
+ *          present (or not readable by the client, matching the scan
+ *          behaviour of skipping unreadable KVs), or ARM_DRIVER_ERROR
+ *          when the index is unavailable and the caller should fall back
+ *          to scanning
+ */
+static int32_t cfstore_index_find(const char* key_name, cfstore_area_hkvt_t* next)
+{
+    uint32_t hash;
+    uint32_t slot;
+    uint8_t key_len;
+    char index_key_name[CFSTORE_KEY_NAME_MAX_LENGTH+1];
+    cfstore_ctx_t* ctx = cfstore_ctx_get();
+
+    if(!cfstore_index_valid_g){
+        if(cfstore_index_rebuild() < ARM_DRIVER_OK){
+            return ARM_DRIVER_ERROR;
+        }
+    }
+    hash = cfstore_index_hash(key_name);
+    slot = hash & (cfstore_index_capacity_g - 1);
+    while(cfstore_index_g[slot].offset != 0){
+        if(cfstore_index_g[slot].hash == hash){
+            *next = cfstore_get_hkvt_from_head_ptr(ctx->area_0_head + cfstore_index_g[slot].offset - 1);
+            key_len = CFSTORE_KEY_NAME_MAX_LENGTH+1;
+            memset(index_key_name, 0, key_len);
+            if(cfstore_get_key_name_ex(next, index_key_name, &key_len) < ARM_DRIVER_OK){
+                return ARM_DRIVER_ERROR;
+            }
+            if(strcmp(index_key_name, key_name) == 0){
+                if(cfstore_hkvt_get_flags_delete(next)){
+                    return ARM_CFSTORE_DRIVER_ERROR_KEY_NOT_FOUND;
+                }
+                if(!cfstore_is_kv_client_readable(next)){
+                    return ARM_CFSTORE_DRIVER_ERROR_KEY_NOT_FOUND;
+                }
+                CFSTORE_TP(CFSTORE_TP_FIND, "%s:Found matching key in index (key_name = \"%s\")\n", __func__, key_name);
+                return ARM_DRIVER_OK;
+            }
+        }
+        slot = (slot + 1) & (cfstore_index_capacity_g - 1);
+    }
+    return ARM_CFSTORE_DRIVER_ERROR_KEY_NOT_FOUND;
+}
+
+/* @brief   check whether a key_name_query is a literal key name rather than
+ *          a match expression, and can therefore use the index */
+static bool cfstore_index_query_is_exact(const char* key_name_query)
+{
+    return strpbrk(key_name_query, "*?[") == NULL;
+}
+
+#else /* CFSTORE_KV_INDEX_ENABLED */
+
+static void cfstore_index_invalidate(void)
+{
+}
+
+static void cfstore_index_free(void)
+{
+}
+
+#endif /* CFSTORE_KV_INDEX_ENABLED */
+
+
 static int32_t cfstore_find_ex(const char* key_name_query, cfstore_area_hkvt_t *prev, cfstore_area_hkvt_t *next)
 {
     int32_t ret = ARM_DRIVER_ERROR;
@@ -3144,6 +3338,16 @@ static int32_t cfstore_find_ex(const char* key_name_query, cfstore_area_hkvt_t *
     cfstore_ctx_t* ctx = cfstore_ctx_get();
 
     CFSTORE_TP((CFSTORE_TP_FIND|CFSTORE_TP_FENTRY), "%s:entered: key_name_query=\"%s\", prev=%p, next=%p\n", __func__, key_name_query, prev, next);
+#ifdef CFSTORE_KV_INDEX_ENABLED
+    /* exact-name queries are served from the hash index, falling back to
+     * the scan when the index is unavailable e.g. out of memory */
+    if(prev == NULL && cfstore_index_query_is_exact(key_name_query)){
+        ret = cfstore_index_find(key_name_query, next);
+        if(ret != ARM_DRIVER_ERROR){
+            return ret;
+        }
+    }
+#endif /* CFSTORE_KV_INDEX_ENABLED */
     if(prev == NULL){
         ret = cfstore_get_head_hkvt(next);
         /* CFSTORE_TP(CFSTORE_TP_FIND, "%s:next->head=%p, next->key=%p, next->value=%p, next->tail=%p, \n", __func__, next->head, next->key, next->value, next->tail); */
@@ -3773,6 +3977,61 @@ out0:
 }
 
 
+/* @brief  See definition in configuration_store.h for description. */
+static int32_t cfstore_read_multiple(ARM_CFSTORE_KV_READ* kvs, uint32_t count)
+{
+    int32_t num_read = 0;
+    uint32_t i;
+    ARM_CFSTORE_SIZE read_len;
+    cfstore_area_hkvt_t hkvt;
+    cfstore_ctx_t* ctx = cfstore_ctx_get();
+
+    CFSTORE_FENTRYLOG("%s:entered, kvs=%p, count=%d\n", __func__, kvs, (int) count);
+    if(!cfstore_ctx_is_initialised(ctx)) {
+        CFSTORE_ERRLOG("%s:Error: CFSTORE is not initialised.\n", __func__);
+        return ARM_CFSTORE_DRIVER_ERROR_UNINITIALISED;
+    }
+    if(kvs == NULL){
+        CFSTORE_ERRLOG("%s:Error: invalid kvs argument.\n", __func__);
+        return ARM_DRIVER_ERROR;
+    }
+    /* reading KVs doesnt change the sram area so this can happen independently of
+     * an oustanding async operation. its unnecessary to check the fsm state */
+    for(i = 0; i < count; i++)
+    {
+        kvs[i].status = cfstore_validate_key_name(kvs[i].key_name);
+        if(kvs[i].status < ARM_DRIVER_OK){
+            CFSTORE_TP(CFSTORE_TP_READ, "%s:invalid key_name (i=%d)\n", __func__, (int) i);
+            continue;
+        }
+        cfstore_hkvt_init(&hkvt);
+        kvs[i].status = cfstore_find_ex(kvs[i].key_name, NULL, &hkvt);
+        if(kvs[i].status < ARM_DRIVER_OK){
+            continue;
+        }
+        if(!cfstore_hkvt_is_valid(&hkvt, ctx->area_0_tail)){
+            kvs[i].status = ARM_CFSTORE_DRIVER_ERROR_KEY_NOT_FOUND;
+            continue;
+        }
+        /* cfstore_find_ex() checked the client has permission to read the KV */
+        if(kvs[i].value == NULL){
+            /* value length query */
+            kvs[i].value_len = cfstore_hkvt_get_value_len(&hkvt);
+        } else {
+            read_len = kvs[i].value_len <= cfstore_hkvt_get_value_len(&hkvt) ? kvs[i].value_len : cfstore_hkvt_get_value_len(&hkvt);
+            memcpy(kvs[i].value, hkvt.value, read_len);
+            kvs[i].value_len = read_len;
+        }
+        kvs[i].status = ARM_DRIVER_OK;
+        num_read++;
+    }
+    /* ReadMultiple() always completes synchronously and, unlike the other
+     * methods, does not invoke the client callback as the per-key status is
+     * reported in the descriptors */
+    return num_read;
+}
+
+
 /* @brief  See definition in configuration_store.h for description. */
 static int32_t cfstore_write(ARM_CFSTORE_HANDLE hkey, const char* data, ARM_CFSTORE_SIZE* len)
 {
@@ -4061,6 +4320,7 @@ static int32_t cfstore_uninitialise(void)
             ctx->area_0_tail = NULL;
             ctx->area_0_len = 0;
         }
+        cfstore_index_free();
     }
 out:
     /* notify client */
@@ -4240,6 +4500,18 @@ static int32_t cfstore_uvisor_read(ARM_CFSTORE_HANDLE hkey, void* data, ARM_CFST
 	return secure_gateway(configuration_store, __cfstore_uvisor_read, hkey, data, len);
 }
 
+UVISOR_EXTERN int32_t __cfstore_uvisor_read_multiple(ARM_CFSTORE_KV_READ* kvs, uint32_t count)
+{
+    CFSTORE_FENTRYLOG("%s:entered\n", __func__);
+	return cfstore_read_multiple(kvs, count);
+}
+
+static int32_t cfstore_uvisor_read_multiple(ARM_CFSTORE_KV_READ* kvs, uint32_t count)
+{
+    CFSTORE_FENTRYLOG("%s:entered\n", __func__);
+	return secure_gateway(configuration_store, __cfstore_uvisor_read_multiple, kvs, count);
+}
+
 UVISOR_EXTERN int32_t __cfstore_uvisor_rseek(ARM_CFSTORE_HANDLE hkey, ARM_CFSTORE_OFFSET offset)
 {
     CFSTORE_FENTRYLOG("%s:entered\n", __func__);
@@ -4296,6 +4568,7 @@ ARM_CFSTORE_DRIVER cfstore_driver =
         .Open = cfstore_uvisor_open,
         .PowerControl = cfstore_power_control,
         .Read = cfstore_uvisor_read,
+        .ReadMultiple = cfstore_uvisor_read_multiple,
         .Rseek = cfstore_uvisor_rseek,
         .Uninitialize = cfstore_uvisor_uninitialize,
         .Write = cfstore_uvisor_write,
@@ -4320,6 +4593,7 @@ ARM_CFSTORE_DRIVER cfstore_driver =
         .Open = cfstore_open,
         .PowerControl = cfstore_power_control,
         .Read = cfstore_read,
+        .ReadMultiple = cfstore_read_multiple,
         .Rseek = cfstore_rseek,
         .Uninitialize = cfstore_uninitialise,
         .Write = cfstore_write,
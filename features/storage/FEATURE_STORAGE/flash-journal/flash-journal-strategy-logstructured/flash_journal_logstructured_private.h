@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2006-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __FLASH_JOURNAL_LOGSTRUCTURED_PRIVATE_H__
+#define __FLASH_JOURNAL_LOGSTRUCTURED_PRIVATE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "flash-journal/flash_journal.h"
+#include "flash-journal-strategy-sequential/flash_journal_private.h" /* for roundUp_uint32/roundDown_uint32 and LCM_OF_ALL_ERASE_UNITS */
+
+static const uint32_t LOGSTRUCTURED_FLASH_JOURNAL_HEADER_MAGIC   = 0xCEA10AEEUL;
+static const uint32_t LOGSTRUCTURED_FLASH_JOURNAL_HEADER_VERSION = 1;
+static const uint32_t LOGSTRUCTURED_FLASH_JOURNAL_RECORD_MAGIC   = 0xCE10106AUL;
+static const uint32_t LOGSTRUCTURED_FLASH_JOURNAL_ERASED_WORD    = 0xFFFFFFFFUL;
+
+/**
+ * Size (in bytes) of the RAM buffer used for group-commit batching. Sealed
+ * records accumulate here until the buffer approaches capacity (or a flush is
+ * forced), at which point the whole batch is programmed with a single
+ * ProgramData().
+ */
+#ifndef FLASH_JOURNAL_LOGSTRUCTURED_BATCH_SIZE
+#define FLASH_JOURNAL_LOGSTRUCTURED_BATCH_SIZE 1024
+#endif
+
+/**
+ * Journal-header for the log-structured strategy; an extension of the generic
+ * header.
+ */
+typedef struct _LogStructuredFlashJournalHeader {
+    FlashJournalHeader_t genericHeader; /** Generic meta-data placed at the head of a Journal; common to all journal types. */
+    uint32_t             magic;         /** Log-structured journal header specific magic code. */
+    uint32_t             version;       /** Revision number for this log-structured journal header. */
+    uint32_t             sizeofUnit;    /** Size of each erase-unit of the circular log. */
+    uint32_t             numUnits;      /** Number of erase-units making up the circular log. */
+} LogStructuredFlashJournalHeader_t;
+
+/**
+ * Meta-data placed at the head of every record in the log. The payload
+ * follows immediately, and the record is padded out to the MTD's
+ * program_unit. Records never straddle an erase-unit boundary.
+ */
+typedef struct _LogStructuredFlashJournalRecordHead {
+    uint32_t magic;
+    uint32_t sequenceNumber; /**< monotonically increasing across records; the record with the largest sequenceNumber is the current blob. */
+    uint32_t sizeofPayload;  /**< size of the blob payload following this head; excludes padding. */
+    uint32_t crc32;          /**< CRC32 over the head and payload (not the padding). The value of this
+                              *   field is taken to be 0 for the purpose of computing the CRC. */
+} LogStructuredFlashJournalRecordHead_t;
+
+#define LOGSTRUCTURED_JOURNAL_VALID_RECORD_HEAD(PTR) \
+    ((PTR)->magic == LOGSTRUCTURED_FLASH_JOURNAL_RECORD_MAGIC)
+
+typedef struct _LogStructuredFlashJournal_t {
+    FlashJournal_Ops_t       ops;                /**< the mandatory OPS table defining the strategy. */
+    FlashJournal_Callback_t  callback;           /**< command completion callback. */
+    FlashJournal_Info_t      info;               /**< the info structure returned from GetInfo(). */
+    ARM_DRIVER_STORAGE      *mtd;                /**< The underlying Memory-Technology-Device. */
+    ARM_STORAGE_CAPABILITIES mtdCapabilities;    /**< the return from mtd->GetCapabilities(); held for quick reference. */
+    uint64_t                 mtdStartOffset;     /**< the start of the address range maintained by the underlying MTD. */
+    uint64_t                 logOffset;          /**< Storage offset at which the next flushed batch will be programmed. */
+    uint64_t                 lastRecordOffset;   /**< Storage offset of the head of the most recently flushed current blob; meaningful only when lastRecordInBatch == 0. */
+    uint32_t                 bodyOffset;         /**< offset from mtdStartOffset to the first erase-unit of the log. */
+    uint32_t                 sizeofUnit;         /**< size of each erase-unit of the log. */
+    uint32_t                 numUnits;           /**< number of erase-units making up the log. */
+    uint32_t                 nextSequenceNumber; /**< sequence number to be assigned to the next committed record. */
+    uint8_t                 *batch;              /**< RAM buffer holding sealed-but-unflushed records followed by the open record. */
+    uint32_t                 batchCapacity;      /**< allocated size of 'batch'. */
+    uint32_t                 batchLength;        /**< bytes of sealed records currently held in 'batch'. */
+    uint32_t                 pendingLength;      /**< bytes of the open (not yet committed) record, including its head; follows the sealed records in 'batch'. */
+    uint32_t                 lastRecordBatchOffset; /**< offset of the current blob's record head within 'batch'; meaningful only when lastRecordInBatch != 0. */
+    uint32_t                 lastRecordInBatch;  /**< non-zero when the current blob still lives in 'batch' rather than in storage. */
+    uint32_t                 readOffset;         /**< the logical offset within the current blob at which the next read will occur. */
+    FlashJournal_OpCode_t    prevCommand;        /**< the last command issued to the journal. */
+} LogStructuredFlashJournal_t;
+
+/**<
+ * A static assert to ensure that the size of LogStructuredFlashJournal_t is
+ * smaller than FlashJournal_t. The caller will only allocate a FlashJournal_t
+ * and expect the log-structured strategy to reuse that space.
+ */
+typedef char AssertLogStructuredJournalSizeLessThanOrEqualToGenericJournal[sizeof(LogStructuredFlashJournal_t)<=sizeof(FlashJournal_t)?1:-1];
+
+#define LOGSTRUCTURED_JOURNAL_BODY_START(JOURNAL) ((JOURNAL)->mtdStartOffset + (JOURNAL)->bodyOffset)
+#define LOGSTRUCTURED_JOURNAL_BODY_SIZE(JOURNAL)  ((uint64_t)(JOURNAL)->sizeofUnit * (JOURNAL)->numUnits)
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif /* __FLASH_JOURNAL_LOGSTRUCTURED_PRIVATE_H__ */
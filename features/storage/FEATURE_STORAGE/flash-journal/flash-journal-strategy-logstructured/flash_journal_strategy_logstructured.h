@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2006-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __FLASH_JOURNAL_STRATEGY_LOGSTRUCTURED_H__
+#define __FLASH_JOURNAL_STRATEGY_LOGSTRUCTURED_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "flash-journal/flash_journal.h"
+
+/**
+ * Create/format a log-structured flash journal over the given storage device.
+ *
+ * Unlike the sequential strategy, which rewrites a whole slot (and re-erases
+ * it) for every committed blob, the log-structured strategy appends each
+ * committed blob as a self-describing record--[header | payload | padding]--
+ * to a circular log of erase-units. Each record carries its own CRC32, so
+ * initialization recovers the latest blob by scanning record headers and a
+ * torn record at the end of the log is simply ignored. An erase-unit is only
+ * erased when the log's write pointer first wraps into it, so the number of
+ * erase cycles per committed record drops with the number of records that
+ * fit in a unit.
+ *
+ * Commits are group-committed: commit() seals the record in a RAM batch
+ * buffer and returns; the batch is flushed to storage when it fills, when a
+ * record would cross an erase-unit boundary, or when explicitly requested
+ * (an empty commit--one without preceding log()s--forces a flush, as does
+ * flashJournalStrategyLogStructured_flush()). This multiplies the sustained
+ * commit rate for small records at the cost of the records between flushes
+ * being lost on sudden power-down. Records made durable by a flush are
+ * always recovered intact or not at all, thanks to the per-record CRC.
+ *
+ * @param[in] mtd
+ *              The underlying Storage driver. This strategy requires an MTD
+ *              which completes operations synchronously.
+ *
+ * @param[in] callback
+ *              Unused at present (all operations of this strategy complete
+ *              synchronously); retained for symmetry with the sequential
+ *              strategy's format API.
+ *
+ * @return 1 to signal successful synchronous completion, else an appropriate
+ *     error code.
+ *
+ *     +-------------------------------+    ^
+ *     |                               |    |
+ *     |  Journal Header               |    |
+ *     |  starts with generic header   |    |   multiple of program_unit
+ *     |  followed by specific header  |    |   and erase-boundary
+ *     |  (padding follows)            |    |
+ *     +-------------------------------+    v
+ *     +-------------------------------+
+ *     | +---------------------------+ |    ^
+ *     | | record head | payload |pad| |    |
+ *     | +---------------------------+ |    |     erase-unit 0
+ *     | | record head | payload |pad| |    |
+ *     | +---------------------------+ |    |
+ *     | |  erased tail of the unit  | |    |
+ *     +-------------------------------+    v
+ *     +-------------------------------+
+ *     | +---------------------------+ |    ^
+ *     | | record head | payload |pad| |    |     erase-unit 1
+ *     | +---------------------------+ |    |
+ *     .                               .    .
+ *     .  records never straddle an   .    .
+ *     .  erase-unit boundary; the    .    .
+ *     .  write pointer wraps from    .    .
+ *     .  the last unit to unit 0,    .    .
+ *     |  erasing units as it enters  |    |     erase-unit 'N - 1'
+ *     |  them                        |    |
+ *     +-------------------------------+    v
+ */
+int32_t               flashJournalStrategyLogStructured_format(ARM_DRIVER_STORAGE      *mtd,
+                                                               FlashJournal_Callback_t  callback);
+
+/**
+ * Force any group-committed records still held in the RAM batch buffer out to
+ * the underlying storage. Committed records are not guaranteed to survive
+ * power-down until a flush has happened; call this at moments where
+ * durability matters (or issue an empty commit(), which is equivalent).
+ *
+ * @return 1 to signal successful synchronous completion, else an appropriate
+ *     error code.
+ */
+int32_t               flashJournalStrategyLogStructured_flush(FlashJournal_t *journal);
+
+int32_t               flashJournalStrategyLogStructured_initialize(FlashJournal_t           *journal,
+                                                                   ARM_DRIVER_STORAGE       *mtd,
+                                                                   const FlashJournal_Ops_t *ops,
+                                                                   FlashJournal_Callback_t   callback);
+FlashJournal_Status_t flashJournalStrategyLogStructured_getInfo(FlashJournal_t *journal, FlashJournal_Info_t *info);
+int32_t               flashJournalStrategyLogStructured_read(FlashJournal_t *journal, void *blob, size_t n);
+int32_t               flashJournalStrategyLogStructured_readFrom(FlashJournal_t *journal, size_t offset, void *blob, size_t n);
+int32_t               flashJournalStrategyLogStructured_log(FlashJournal_t *journal, const void *blob, size_t n);
+int32_t               flashJournalStrategyLogStructured_commit(FlashJournal_t *journal);
+int32_t               flashJournalStrategyLogStructured_reset(FlashJournal_t *journal);
+
+static const FlashJournal_Ops_t FLASH_JOURNAL_STRATEGY_LOGSTRUCTURED = {
+    flashJournalStrategyLogStructured_initialize,
+    flashJournalStrategyLogStructured_getInfo,
+    flashJournalStrategyLogStructured_read,
+    flashJournalStrategyLogStructured_readFrom,
+    flashJournalStrategyLogStructured_log,
+    flashJournalStrategyLogStructured_commit,
+    flashJournalStrategyLogStructured_reset
+};
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif /* __FLASH_JOURNAL_STRATEGY_LOGSTRUCTURED_H__ */
@@ -0,0 +1,602 @@
+/*
+ * Copyright (c) 2006-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "flash-journal-strategy-sequential/flash_journal_crc.h"
+#include "flash-journal-strategy-logstructured/flash_journal_logstructured_private.h"
+#include "flash-journal-strategy-logstructured/flash_journal_strategy_logstructured.h"
+#include <string.h>
+#include <stdlib.h>
+
+/*
+ * This strategy completes all operations synchronously and therefore requires
+ * an MTD whose operations also complete synchronously (i.e. which return
+ * positive values rather than ARM_DRIVER_OK). This mirrors the state of the
+ * sequential strategy's initialization path.
+ * TODO: add support for asynchronous MTDs.
+ */
+
+/*
+ * forward declarations of static helper functions.
+ */
+static void     mtdEventHandlerUnused(int32_t status, ARM_STORAGE_OPERATION operation);
+static int32_t  mtdGetStartAddress(ARM_DRIVER_STORAGE *mtd, uint64_t *startAddrP);
+static int32_t  flushBatch(LogStructuredFlashJournal_t *journal);
+static int32_t  scanUnitForRecords(LogStructuredFlashJournal_t *journal,
+                                   uint64_t                     unitStart,
+                                   uint32_t                    *maxSequenceNumberP,
+                                   int32_t                     *foundP,
+                                   uint64_t                    *logOffsetP);
+
+static void mtdEventHandlerUnused(int32_t status, ARM_STORAGE_OPERATION operation)
+{
+    /* this strategy only supports synchronously completing MTDs; nothing to do. */
+    (void)status;
+    (void)operation;
+}
+
+static int32_t mtdGetStartAddress(ARM_DRIVER_STORAGE *mtd, uint64_t *startAddrP)
+{
+    ARM_STORAGE_BLOCK mtdBlock;
+    if ((mtd->GetNextBlock(NULL, &mtdBlock)) != ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    }
+    if (!ARM_STORAGE_VALID_BLOCK(&mtdBlock)) {
+        return JOURNAL_STATUS_ERROR;
+    }
+
+    *startAddrP = mtdBlock.addr;
+    return JOURNAL_STATUS_OK;
+}
+
+int32_t flashJournalStrategyLogStructured_format(ARM_DRIVER_STORAGE      *mtd,
+                                                 FlashJournal_Callback_t  callback)
+{
+    (void)callback; /* all operations here complete synchronously. */
+
+    if (mtd == NULL) {
+        return JOURNAL_STATUS_PARAMETER;
+    }
+
+    int32_t rc = mtd->Initialize(mtdEventHandlerUnused);
+    if (rc < ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    }
+    if (rc == ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_UNSUPPORTED; /* asynchronous MTDs aren't supported by this strategy. */
+    }
+
+    ARM_STORAGE_INFO mtdInfo;
+    if (mtd->GetInfo(&mtdInfo) < ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    }
+    uint64_t mtdAddr;
+    if ((rc = mtdGetStartAddress(mtd, &mtdAddr)) != JOURNAL_STATUS_OK) {
+        return rc;
+    }
+
+    /* Build the header. The header occupies the first erase-unit so that the
+     * log behind it can be erased independently. */
+    LogStructuredFlashJournalHeader_t header;
+    memset(&header, 0, sizeof(header));
+    header.genericHeader.magic         = FLASH_JOURNAL_HEADER_MAGIC;
+    header.genericHeader.version       = FLASH_JOURNAL_HEADER_VERSION;
+    header.genericHeader.sizeofHeader  = sizeof(LogStructuredFlashJournalHeader_t);
+    header.genericHeader.journalOffset = roundUp_uint32(header.genericHeader.sizeofHeader, LCM_OF_ALL_ERASE_UNITS);
+    header.magic                       = LOGSTRUCTURED_FLASH_JOURNAL_HEADER_MAGIC;
+    header.version                     = LOGSTRUCTURED_FLASH_JOURNAL_HEADER_VERSION;
+    header.sizeofUnit                  = LCM_OF_ALL_ERASE_UNITS;
+
+    if ((header.genericHeader.journalOffset % mtdInfo.program_unit) != 0) {
+        return JOURNAL_STATUS_PARAMETER;
+    }
+    if (mtdInfo.total_storage < (header.genericHeader.journalOffset + header.sizeofUnit)) {
+        return JOURNAL_STATUS_PARAMETER; /* not enough space for even a single erase-unit of log. */
+    }
+    header.numUnits = (uint32_t)((mtdInfo.total_storage - header.genericHeader.journalOffset) / header.sizeofUnit);
+    header.genericHeader.totalSize = header.genericHeader.journalOffset
+                                     + ((uint64_t)header.sizeofUnit * header.numUnits);
+
+    header.genericHeader.checksum = 0;
+    flashJournalCrcReset();
+    header.genericHeader.checksum = flashJournalCrcCummulative((const unsigned char *)&header, sizeof(header));
+
+    /* Erase the entire journal extent; this removes stale records from any
+     * previous incarnation which could otherwise carry valid CRCs. */
+    rc = mtd->Erase(mtdAddr, (uint32_t)header.genericHeader.totalSize);
+    if (rc <= ARM_DRIVER_OK) {
+        return (rc == ARM_DRIVER_OK) ? JOURNAL_STATUS_UNSUPPORTED : JOURNAL_STATUS_STORAGE_IO_ERROR;
+    }
+
+    /* program the header, padded out to the program_unit. */
+    uint8_t headerBlock[sizeof(LogStructuredFlashJournalHeader_t) + 64];
+    uint32_t sizeofProgram = roundUp_uint32(sizeof(header), mtdInfo.program_unit);
+    if (sizeofProgram > sizeof(headerBlock)) {
+        return JOURNAL_STATUS_PARAMETER;
+    }
+    memset(headerBlock, 0xFF, sizeofProgram);
+    memcpy(headerBlock, &header, sizeof(header));
+    rc = mtd->ProgramData(mtdAddr, headerBlock, sizeofProgram);
+    if (rc < (int32_t)sizeofProgram) {
+        return (rc == ARM_DRIVER_OK) ? JOURNAL_STATUS_UNSUPPORTED : JOURNAL_STATUS_STORAGE_IO_ERROR;
+    }
+
+    return 1; /* synchronous completion. */
+}
+
+/**
+ * Walk the records of a single erase-unit, validating each record's CRC.
+ *
+ * @param [out] maxSequenceNumberP
+ *                  updated (together with the journal's notion of the current
+ *                  blob) whenever a record with a higher sequence number is found.
+ * @param [out] foundP
+ *                  set to 1 if this unit contained the record with the
+ *                  (so-far) highest sequence number.
+ * @param [out] logOffsetP
+ *                  the offset at which logging should resume if this unit
+ *                  turns out to hold the end of the log. Points just past the
+ *                  last valid record when the tail of the unit is still
+ *                  erased; points at the start of the *next* unit when the
+ *                  tail holds a torn/corrupt record (which must not be
+ *                  programmed over).
+ */
+static int32_t scanUnitForRecords(LogStructuredFlashJournal_t *journal,
+                                  uint64_t                     unitStart,
+                                  uint32_t                    *maxSequenceNumberP,
+                                  int32_t                     *foundP,
+                                  uint64_t                    *logOffsetP)
+{
+    uint64_t offset  = unitStart;
+    uint64_t unitEnd = unitStart + journal->sizeofUnit;
+    int32_t  rc;
+
+    *foundP     = 0;
+    *logOffsetP = unitEnd;
+
+    while ((offset + sizeof(LogStructuredFlashJournalRecordHead_t)) <= unitEnd) {
+        LogStructuredFlashJournalRecordHead_t head;
+        rc = journal->mtd->ReadData(offset, &head, sizeof(head));
+        if (rc < (int32_t)sizeof(head)) {
+            return JOURNAL_STATUS_STORAGE_IO_ERROR;
+        }
+
+        if (head.magic == LOGSTRUCTURED_FLASH_JOURNAL_ERASED_WORD) {
+            /* erased tail; logging may resume here. */
+            *logOffsetP = offset;
+            break;
+        }
+        if (!LOGSTRUCTURED_JOURNAL_VALID_RECORD_HEAD(&head) ||
+            (head.sizeofPayload > (journal->sizeofUnit - sizeof(head))) ||
+            ((offset + roundUp_uint32(sizeof(head) + head.sizeofPayload, journal->info.program_unit)) > unitEnd)) {
+            /* garbage or a torn head; everything from here to the end of the
+             * unit is suspect and will be reclaimed when the unit is next
+             * erased. Logging must not resume before then. */
+            *logOffsetP = unitEnd;
+            break;
+        }
+
+        /* validate the CRC over head and payload. */
+        uint32_t expectedCRC = head.crc32;
+        head.crc32 = 0;
+        flashJournalCrcReset();
+        flashJournalCrcCummulative((const unsigned char *)&head, sizeof(head));
+        uint8_t  crcBuffer[64];
+        uint32_t bodyIndex  = 0;
+        uint64_t bodyOffset = offset + sizeof(head);
+        uint32_t computedCRC = 0;
+        while (bodyIndex < head.sizeofPayload) {
+            uint32_t sizeofRead = head.sizeofPayload - bodyIndex;
+            if (sizeofRead > sizeof(crcBuffer)) {
+                sizeofRead = sizeof(crcBuffer);
+            }
+            rc = journal->mtd->ReadData(bodyOffset + bodyIndex, crcBuffer, sizeofRead);
+            if (rc < (int32_t)sizeofRead) {
+                return JOURNAL_STATUS_STORAGE_IO_ERROR;
+            }
+            computedCRC = flashJournalCrcCummulative(crcBuffer, sizeofRead);
+            bodyIndex  += sizeofRead;
+        }
+        if (head.sizeofPayload == 0) {
+            computedCRC = flashJournalCrcCummulative(crcBuffer, 0);
+        }
+        if (computedCRC != expectedCRC) {
+            /* a torn record marks the end of the valid log within this unit;
+             * its bytes are partially programmed, so skip the unit's tail. */
+            *logOffsetP = unitEnd;
+            break;
+        }
+
+        if ((head.sequenceNumber >= *maxSequenceNumberP) || (*maxSequenceNumberP == 0)) {
+            *maxSequenceNumberP            = head.sequenceNumber;
+            *foundP                        = 1;
+            journal->lastRecordOffset      = offset;
+            journal->info.sizeofJournaledBlob = head.sizeofPayload;
+        }
+
+        offset += roundUp_uint32(sizeof(head) + head.sizeofPayload, journal->info.program_unit);
+        *logOffsetP = offset;
+    }
+
+    return JOURNAL_STATUS_OK;
+}
+
+int32_t flashJournalStrategyLogStructured_initialize(FlashJournal_t           *_journal,
+                                                     ARM_DRIVER_STORAGE       *mtd,
+                                                     const FlashJournal_Ops_t *ops,
+                                                     FlashJournal_Callback_t   callback)
+{
+    int32_t rc = mtd->Initialize(mtdEventHandlerUnused);
+    if (rc < ARM_DRIVER_OK) {
+        memset(_journal, 0, sizeof(FlashJournal_t));
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    }
+    if (rc == ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_UNSUPPORTED; /* asynchronous MTDs aren't supported by this strategy. */
+    }
+
+    LogStructuredFlashJournal_t *journal = (LogStructuredFlashJournal_t *)_journal;
+    memset(journal, 0, sizeof(LogStructuredFlashJournal_t));
+    journal->mtd = mtd;
+
+    if ((rc = mtdGetStartAddress(mtd, &journal->mtdStartOffset)) != JOURNAL_STATUS_OK) {
+        return rc;
+    }
+
+    ARM_STORAGE_INFO mtdInfo;
+    if (mtd->GetInfo(&mtdInfo) != ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    }
+
+    /* read and verify the journal header. */
+    LogStructuredFlashJournalHeader_t header;
+    rc = mtd->ReadData(journal->mtdStartOffset, &header, sizeof(header));
+    if (rc < (int32_t)sizeof(header)) {
+        return (rc == ARM_DRIVER_OK) ? JOURNAL_STATUS_UNSUPPORTED : JOURNAL_STATUS_STORAGE_IO_ERROR;
+    }
+    if ((header.genericHeader.magic        != FLASH_JOURNAL_HEADER_MAGIC)                  ||
+        (header.genericHeader.version      != FLASH_JOURNAL_HEADER_VERSION)                ||
+        (header.genericHeader.sizeofHeader != sizeof(LogStructuredFlashJournalHeader_t))   ||
+        (header.magic                      != LOGSTRUCTURED_FLASH_JOURNAL_HEADER_MAGIC)    ||
+        (header.version                    != LOGSTRUCTURED_FLASH_JOURNAL_HEADER_VERSION)) {
+        return JOURNAL_STATUS_NOT_FORMATTED;
+    }
+    uint32_t expectedCRC = header.genericHeader.checksum;
+    header.genericHeader.checksum = 0;
+    flashJournalCrcReset();
+    if (flashJournalCrcCummulative((const unsigned char *)&header, sizeof(header)) != expectedCRC) {
+        return JOURNAL_STATUS_METADATA_ERROR;
+    }
+
+    memcpy(&journal->ops, ops, sizeof(FlashJournal_Ops_t));
+    journal->mtdCapabilities = mtd->GetCapabilities();
+    journal->bodyOffset      = header.genericHeader.journalOffset;
+    journal->sizeofUnit      = header.sizeofUnit;
+    journal->numUnits        = header.numUnits;
+    journal->callback        = callback;
+    journal->prevCommand     = FLASH_JOURNAL_OPCODE_INITIALIZE;
+
+    journal->info.program_unit = mtdInfo.program_unit;
+    journal->batchCapacity     = FLASH_JOURNAL_LOGSTRUCTURED_BATCH_SIZE;
+    if (journal->batchCapacity < roundUp_uint32(sizeof(LogStructuredFlashJournalRecordHead_t) + 1, mtdInfo.program_unit)) {
+        return JOURNAL_STATUS_PARAMETER; /* batch too small to hold even a minimal record. */
+    }
+
+    /* A blob must fit in the batch buffer and within a single erase-unit. */
+    uint32_t maxRecord = (journal->batchCapacity < journal->sizeofUnit) ? journal->batchCapacity : journal->sizeofUnit;
+    journal->info.capacity = maxRecord - sizeof(LogStructuredFlashJournalRecordHead_t);
+
+    /* Note: the journal API has no uninitialize(); this allocation is made
+     * once for the lifetime of the journal, like the singleton journal
+     * handles used elsewhere in this feature. */
+    journal->batch = (uint8_t *)malloc(journal->batchCapacity);
+    if (journal->batch == NULL) {
+        return JOURNAL_STATUS_ERROR;
+    }
+
+    /* scan the erase-units for the record with the highest sequence number. */
+    uint32_t maxSequenceNumber = 0;
+    int32_t  anyFound          = 0;
+    uint64_t logOffset         = LOGSTRUCTURED_JOURNAL_BODY_START(journal);
+    uint32_t unitIndex;
+    for (unitIndex = 0; unitIndex < journal->numUnits; unitIndex++) {
+        uint64_t unitStart = LOGSTRUCTURED_JOURNAL_BODY_START(journal) + ((uint64_t)unitIndex * journal->sizeofUnit);
+        int32_t  found;
+        uint64_t unitLogOffset;
+        if ((rc = scanUnitForRecords(journal, unitStart, &maxSequenceNumber, &found, &unitLogOffset)) != JOURNAL_STATUS_OK) {
+            free(journal->batch);
+            journal->batch = NULL;
+            return rc;
+        }
+        if (found) {
+            anyFound  = 1;
+            logOffset = unitLogOffset;
+        }
+    }
+
+    if (anyFound) {
+        if (logOffset >= (LOGSTRUCTURED_JOURNAL_BODY_START(journal) + LOGSTRUCTURED_JOURNAL_BODY_SIZE(journal))) {
+            logOffset = LOGSTRUCTURED_JOURNAL_BODY_START(journal); /* wrap back to the first unit. */
+        }
+        journal->logOffset          = logOffset;
+        journal->nextSequenceNumber = maxSequenceNumber + 1;
+    } else {
+        journal->logOffset          = LOGSTRUCTURED_JOURNAL_BODY_START(journal);
+        journal->nextSequenceNumber = 1;
+        journal->info.sizeofJournaledBlob = 0;
+    }
+
+    return 1; /* synchronous completion. */
+}
+
+FlashJournal_Status_t flashJournalStrategyLogStructured_getInfo(FlashJournal_t *_journal, FlashJournal_Info_t *infoP)
+{
+    LogStructuredFlashJournal_t *journal = (LogStructuredFlashJournal_t *)_journal;
+
+    memcpy(infoP, &journal->info, sizeof(FlashJournal_Info_t));
+    return JOURNAL_STATUS_OK;
+}
+
+int32_t flashJournalStrategyLogStructured_readFrom(FlashJournal_t *_journal, size_t offset, void *blob, size_t sizeofBlob)
+{
+    LogStructuredFlashJournal_t *journal = (LogStructuredFlashJournal_t *)_journal;
+
+    if ((journal->batch == NULL) || (blob == NULL) || (sizeofBlob == 0)) {
+        return JOURNAL_STATUS_PARAMETER;
+    }
+    if ((journal->info.sizeofJournaledBlob == 0) ||
+        (offset >= journal->info.sizeofJournaledBlob)) {
+        journal->readOffset  = 0;
+        journal->prevCommand = FLASH_JOURNAL_OPCODE_READ_BLOB;
+        return JOURNAL_STATUS_EMPTY;
+    }
+
+    size_t amount = journal->info.sizeofJournaledBlob - offset;
+    if (amount > sizeofBlob) {
+        amount = sizeofBlob;
+    }
+
+    if (journal->lastRecordInBatch) {
+        /* the current blob hasn't been flushed yet; serve the read from RAM. */
+        memcpy(blob,
+               journal->batch + journal->lastRecordBatchOffset + sizeof(LogStructuredFlashJournalRecordHead_t) + offset,
+               amount);
+    } else {
+        int32_t rc = journal->mtd->ReadData(journal->lastRecordOffset + sizeof(LogStructuredFlashJournalRecordHead_t) + offset,
+                                            blob, amount);
+        if (rc < (int32_t)amount) {
+            return (rc == ARM_DRIVER_OK) ? JOURNAL_STATUS_UNSUPPORTED : JOURNAL_STATUS_STORAGE_IO_ERROR;
+        }
+    }
+
+    journal->readOffset  = offset + amount;
+    journal->prevCommand = FLASH_JOURNAL_OPCODE_READ_BLOB;
+    return (int32_t)amount;
+}
+
+int32_t flashJournalStrategyLogStructured_read(FlashJournal_t *_journal, void *blob, size_t sizeofBlob)
+{
+    LogStructuredFlashJournal_t *journal = (LogStructuredFlashJournal_t *)_journal;
+
+    if (journal->prevCommand != FLASH_JOURNAL_OPCODE_READ_BLOB) {
+        journal->readOffset = 0;
+    }
+
+    return flashJournalStrategyLogStructured_readFrom(_journal, journal->readOffset, blob, sizeofBlob);
+}
+
+int32_t flashJournalStrategyLogStructured_log(FlashJournal_t *_journal, const void *blob, size_t sizeofBlob)
+{
+    LogStructuredFlashJournal_t *journal = (LogStructuredFlashJournal_t *)_journal;
+    int32_t rc;
+
+    if ((journal->batch == NULL) || (blob == NULL) || (sizeofBlob == 0)) {
+        return JOURNAL_STATUS_PARAMETER;
+    }
+
+    if (journal->pendingLength == 0) {
+        /* opening a new record; reserve space for its head. */
+        if ((journal->batchLength + sizeof(LogStructuredFlashJournalRecordHead_t)) > journal->batchCapacity) {
+            if ((rc = flushBatch(journal)) < JOURNAL_STATUS_OK) {
+                return rc;
+            }
+        }
+        journal->pendingLength = sizeof(LogStructuredFlashJournalRecordHead_t);
+    }
+
+    /* the whole record--head, payload and padding--must fit in the batch
+     * buffer and within a single erase-unit. */
+    uint32_t maxRecord = (journal->batchCapacity < journal->sizeofUnit) ? journal->batchCapacity : journal->sizeofUnit;
+    if (roundUp_uint32(journal->pendingLength + sizeofBlob, journal->info.program_unit) > maxRecord) {
+        return JOURNAL_STATUS_BOUNDED_CAPACITY;
+    }
+
+    if ((journal->batchLength + journal->pendingLength + sizeofBlob) > journal->batchCapacity) {
+        /* make room by flushing the sealed records ahead of the open one. */
+        if ((rc = flushBatch(journal)) < JOURNAL_STATUS_OK) {
+            return rc;
+        }
+    }
+
+    memcpy(journal->batch + journal->batchLength + journal->pendingLength, blob, sizeofBlob);
+    journal->pendingLength += sizeofBlob;
+    journal->prevCommand    = FLASH_JOURNAL_OPCODE_LOG_BLOB;
+    return (int32_t)sizeofBlob; /* synchronous completion. */
+}
+
+int32_t flashJournalStrategyLogStructured_commit(FlashJournal_t *_journal)
+{
+    LogStructuredFlashJournal_t *journal = (LogStructuredFlashJournal_t *)_journal;
+    int32_t rc;
+
+    if (journal->batch == NULL) {
+        return JOURNAL_STATUS_NOT_INITIALIZED;
+    }
+
+    if (journal->pendingLength == 0) {
+        /* an empty commit acts as an explicit flush of the batched records;
+         * this is the caller's durability point. */
+        journal->prevCommand = FLASH_JOURNAL_OPCODE_COMMIT;
+        return flushBatch(journal);
+    }
+
+    uint32_t sizeofPayload = journal->pendingLength - sizeof(LogStructuredFlashJournalRecordHead_t);
+    uint32_t sizeofRecord  = roundUp_uint32(journal->pendingLength, journal->info.program_unit);
+
+    if ((journal->batchLength + sizeofRecord) > journal->batchCapacity) {
+        /* need room for the padding; flush the sealed records first. */
+        if ((rc = flushBatch(journal)) < JOURNAL_STATUS_OK) {
+            return rc;
+        }
+    }
+
+    /* records never straddle an erase-unit boundary; skip ahead (and possibly
+     * wrap) if this one would. The batch maps onto a contiguous range of
+     * storage, so the sealed records must be flushed before the log-offset
+     * can jump. */
+    uint64_t bodyStart   = LOGSTRUCTURED_JOURNAL_BODY_START(journal);
+    uint64_t recordStart = journal->logOffset + journal->batchLength;
+    uint32_t unitOffset  = (uint32_t)((recordStart - bodyStart) % journal->sizeofUnit);
+    if ((unitOffset + sizeofRecord) > journal->sizeofUnit) {
+        if ((rc = flushBatch(journal)) < JOURNAL_STATUS_OK) {
+            return rc;
+        }
+        journal->logOffset = bodyStart + roundUp_uint32((uint32_t)(journal->logOffset - bodyStart), journal->sizeofUnit);
+        if (journal->logOffset >= (bodyStart + LOGSTRUCTURED_JOURNAL_BODY_SIZE(journal))) {
+            journal->logOffset = bodyStart; /* wrap back to the first unit. */
+        }
+    }
+
+    /* seal the record: fill in its head, compute the CRC and pad it out. */
+    LogStructuredFlashJournalRecordHead_t *head =
+        (LogStructuredFlashJournalRecordHead_t *)(journal->batch + journal->batchLength);
+    head->magic          = LOGSTRUCTURED_FLASH_JOURNAL_RECORD_MAGIC;
+    head->sequenceNumber = journal->nextSequenceNumber;
+    head->sizeofPayload  = sizeofPayload;
+    head->crc32          = 0;
+    flashJournalCrcReset();
+    head->crc32 = flashJournalCrcCummulative((const unsigned char *)head, journal->pendingLength);
+    memset(journal->batch + journal->batchLength + journal->pendingLength, 0xFF,
+           sizeofRecord - journal->pendingLength);
+
+    journal->lastRecordBatchOffset     = journal->batchLength;
+    journal->lastRecordInBatch         = 1;
+    journal->info.sizeofJournaledBlob  = sizeofPayload;
+    journal->batchLength              += sizeofRecord;
+    journal->pendingLength             = 0;
+    journal->nextSequenceNumber++;
+    journal->prevCommand = FLASH_JOURNAL_OPCODE_COMMIT;
+
+    /* group-commit: only flush once the batch can't usefully take another
+     * record. */
+    if ((journal->batchCapacity - journal->batchLength) <
+        roundUp_uint32(sizeof(LogStructuredFlashJournalRecordHead_t) + 1, journal->info.program_unit)) {
+        if ((rc = flushBatch(journal)) < JOURNAL_STATUS_OK) {
+            return rc;
+        }
+    }
+
+    return 1; /* synchronous completion. */
+}
+
+int32_t flashJournalStrategyLogStructured_reset(FlashJournal_t *_journal)
+{
+    LogStructuredFlashJournal_t *journal = (LogStructuredFlashJournal_t *)_journal;
+
+    if (journal->batch == NULL) {
+        return JOURNAL_STATUS_NOT_INITIALIZED;
+    }
+
+    /* all units must be erased: stale records elsewhere in the log carry
+     * valid CRCs and would otherwise be rediscovered at the next
+     * initialize(). */
+    uint64_t bodyStart = LOGSTRUCTURED_JOURNAL_BODY_START(journal);
+    int32_t rc = journal->mtd->Erase(bodyStart, (uint32_t)LOGSTRUCTURED_JOURNAL_BODY_SIZE(journal));
+    if (rc <= ARM_DRIVER_OK) {
+        return (rc == ARM_DRIVER_OK) ? JOURNAL_STATUS_UNSUPPORTED : JOURNAL_STATUS_STORAGE_IO_ERROR;
+    }
+
+    journal->logOffset                = bodyStart;
+    journal->batchLength              = 0;
+    journal->pendingLength            = 0;
+    journal->lastRecordInBatch        = 0;
+    journal->lastRecordOffset         = 0;
+    journal->nextSequenceNumber       = 1;
+    journal->info.sizeofJournaledBlob = 0;
+    journal->readOffset               = 0;
+    journal->prevCommand              = FLASH_JOURNAL_OPCODE_RESET;
+    return 1; /* synchronous completion. */
+}
+
+int32_t flashJournalStrategyLogStructured_flush(FlashJournal_t *_journal)
+{
+    LogStructuredFlashJournal_t *journal = (LogStructuredFlashJournal_t *)_journal;
+
+    if (journal->batch == NULL) {
+        return JOURNAL_STATUS_NOT_INITIALIZED;
+    }
+    return flushBatch(journal);
+}
+
+/**
+ * Program the sealed records held in the batch buffer at the current
+ * log-offset, erasing any erase-unit the write pointer newly enters. An open
+ * (not yet committed) record is retained in the buffer.
+ */
+static int32_t flushBatch(LogStructuredFlashJournal_t *journal)
+{
+    int32_t rc;
+
+    if (journal->batchLength == 0) {
+        return 1; /* nothing to flush. */
+    }
+
+    /* Erase every unit whose start lies within the range being programmed.
+     * Offsets inside a unit whose boundary was crossed by an earlier flush
+     * are already erased. This is where erase-cycles are saved: one erase
+     * per unit-full of records rather than one per commit. */
+    uint64_t bodyStart = LOGSTRUCTURED_JOURNAL_BODY_START(journal);
+    uint64_t eraseAddr = bodyStart + roundUp_uint32((uint32_t)(journal->logOffset - bodyStart), journal->sizeofUnit);
+    while (eraseAddr < (journal->logOffset + journal->batchLength)) {
+        rc = journal->mtd->Erase(eraseAddr, journal->sizeofUnit);
+        if (rc <= ARM_DRIVER_OK) {
+            return (rc == ARM_DRIVER_OK) ? JOURNAL_STATUS_UNSUPPORTED : JOURNAL_STATUS_STORAGE_IO_ERROR;
+        }
+        eraseAddr += journal->sizeofUnit;
+    }
+
+    rc = journal->mtd->ProgramData(journal->logOffset, journal->batch, journal->batchLength);
+    if (rc < (int32_t)journal->batchLength) {
+        return (rc == ARM_DRIVER_OK) ? JOURNAL_STATUS_UNSUPPORTED : JOURNAL_STATUS_STORAGE_IO_ERROR;
+    }
+
+    if (journal->lastRecordInBatch) {
+        journal->lastRecordOffset  = journal->logOffset + journal->lastRecordBatchOffset;
+        journal->lastRecordInBatch = 0;
+    }
+
+    /* an open record, if any, slides down to the front of the buffer. */
+    if (journal->pendingLength) {
+        memmove(journal->batch, journal->batch + journal->batchLength, journal->pendingLength);
+    }
+    journal->logOffset  += journal->batchLength;
+    journal->batchLength = 0;
+    if (journal->logOffset >= (bodyStart + LOGSTRUCTURED_JOURNAL_BODY_SIZE(journal))) {
+        journal->logOffset = bodyStart; /* the flush ended exactly at the end of the log; wrap. */
+    }
+
+    return 1; /* synchronous completion. */
+}
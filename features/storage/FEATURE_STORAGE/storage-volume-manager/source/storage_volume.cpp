@@ -23,6 +23,7 @@
 #endif
 
 #include "storage-volume-manager/storage_volume_manager.h"
+#include "platform/mbed_critical.h"
 #include <string.h>
 #include <inttypes.h>
 
@@ -32,10 +33,72 @@
 
 void StorageVolume::setup(uint64_t _addr, uint64_t _size, StorageVolumeManager *_volumeManager)
 {
-    volumeOffset  = _addr;
-    volumeSize    = _size;
-    volumeManager = _volumeManager;
-    allocated     = true;
+    volumeOffset   = _addr;
+    volumeSize     = _size;
+    volumeManager  = _volumeManager;
+    allocated      = true;
+    pendingOp.code = PENDING_OP_NONE;
+}
+
+int32_t StorageVolume::queuePendingOp(uint8_t code, uint64_t addr, void *readData, const void *programData, uint32_t size, ARM_POWER_STATE state)
+{
+    int32_t rc = ARM_DRIVER_ERROR_BUSY;
+
+    core_util_critical_section_enter();
+    if (pendingOp.code == PENDING_OP_NONE) {
+        pendingOp.code        = code;
+        pendingOp.state       = state;
+        pendingOp.addr        = addr;
+        pendingOp.readData    = readData;
+        pendingOp.programData = programData;
+        pendingOp.size        = size;
+        rc = ARM_DRIVER_OK; /* queued; completion callback follows once launched */
+    }
+    core_util_critical_section_exit();
+    return rc;
+}
+
+int32_t StorageVolume::launchPendingOp(ARM_STORAGE_OPERATION *operationP)
+{
+    PendingOp op;
+
+    core_util_critical_section_enter();
+    op = pendingOp;
+    pendingOp.code = PENDING_OP_NONE;
+    core_util_critical_section_exit();
+
+    int32_t rc;
+    volumeManager->activeVolume = this;
+    switch (op.code) {
+        case PENDING_OP_POWER_CONTROL:
+            *operationP = ARM_STORAGE_OPERATION_POWER_CONTROL;
+            rc = volumeManager->getStorage()->PowerControl(op.state);
+            break;
+        case PENDING_OP_READ_DATA:
+            *operationP = ARM_STORAGE_OPERATION_READ_DATA;
+            rc = volumeManager->getStorage()->ReadData(volumeOffset + op.addr, op.readData, op.size);
+            break;
+        case PENDING_OP_PROGRAM_DATA:
+            *operationP = ARM_STORAGE_OPERATION_PROGRAM_DATA;
+            rc = volumeManager->getStorage()->ProgramData(volumeOffset + op.addr, op.programData, op.size);
+            break;
+        case PENDING_OP_ERASE:
+            *operationP = ARM_STORAGE_OPERATION_ERASE;
+            rc = volumeManager->getStorage()->Erase(volumeOffset + op.addr, op.size);
+            break;
+        case PENDING_OP_ERASE_ALL:
+            *operationP = ARM_STORAGE_OPERATION_ERASE_ALL;
+            rc = volumeManager->getStorage()->EraseAll();
+            break;
+        default:
+            *operationP = ARM_STORAGE_OPERATION_GET_STATUS; /* placeholder; can't happen */
+            rc = ARM_DRIVER_ERROR;
+            break;
+    }
+    if (rc != ARM_DRIVER_OK) {
+        volumeManager->activeVolume = NULL; /* we're certain that there is no more pending asynch. activity */
+    }
+    return rc;
 }
 
 ARM_DRIVER_VERSION StorageVolume::GetVersion(void)
@@ -85,7 +148,9 @@ int32_t StorageVolume::PowerControl(ARM_POWER_STATE state)
         return STORAGE_VOLUME_MANAGER_STATUS_ERROR_VOLUME_NOT_ALLOCATED;
     }
     if (volumeManager->activeVolume != NULL) {
-        return ARM_DRIVER_ERROR_BUSY;
+        /* Another volume holds the storage; park the request in this
+         * volume's slot rather than failing it. */
+        return queuePendingOp(PENDING_OP_POWER_CONTROL, 0, NULL, NULL, 0, state);
     }
 
     volumeManager->activeVolume = this;
@@ -102,12 +167,14 @@ int32_t StorageVolume::ReadData(uint64_t addr, void *data, uint32_t size)
     if (!allocated) {
         return STORAGE_VOLUME_MANAGER_STATUS_ERROR_VOLUME_NOT_ALLOCATED;
     }
-    if (volumeManager->activeVolume != NULL) {
-        return ARM_DRIVER_ERROR_BUSY;
-    }
     if ((size > volumeSize) || ((addr + size) > volumeSize)) {
         return ARM_DRIVER_ERROR_PARAMETER;
     }
+    if (volumeManager->activeVolume != NULL) {
+        /* Another volume holds the storage; park the (already validated)
+         * request in this volume's slot rather than failing it. */
+        return queuePendingOp(PENDING_OP_READ_DATA, addr, data, NULL, size, ARM_POWER_OFF);
+    }
 
     volumeManager->activeVolume = this;
     int32_t rc = volumeManager->getStorage()->ReadData(volumeOffset + addr, data, size);
@@ -123,12 +190,12 @@ int32_t StorageVolume::ProgramData(uint64_t addr, const void *data, uint32_t siz
     if (!allocated) {
         return STORAGE_VOLUME_MANAGER_STATUS_ERROR_VOLUME_NOT_ALLOCATED;
     }
-    if (volumeManager->activeVolume != NULL) {
-        return ARM_DRIVER_ERROR_BUSY;
-    }
     if ((size > volumeSize) || ((addr + size) > volumeSize)) {
         return ARM_DRIVER_ERROR_PARAMETER;
     }
+    if (volumeManager->activeVolume != NULL) {
+        return queuePendingOp(PENDING_OP_PROGRAM_DATA, addr, NULL, data, size, ARM_POWER_OFF);
+    }
 
     volumeManager->activeVolume = this;
     int32_t rc = volumeManager->getStorage()->ProgramData(volumeOffset + addr, data, size);
@@ -144,12 +211,12 @@ int32_t StorageVolume::Erase(uint64_t addr, uint32_t size)
     if (!allocated) {
         return STORAGE_VOLUME_MANAGER_STATUS_ERROR_VOLUME_NOT_ALLOCATED;
     }
-    if (volumeManager->activeVolume != NULL) {
-        return ARM_DRIVER_ERROR_BUSY;
-    }
     if ((size > volumeSize) || ((addr + size) > volumeSize)) {
         return ARM_DRIVER_ERROR_PARAMETER;
     }
+    if (volumeManager->activeVolume != NULL) {
+        return queuePendingOp(PENDING_OP_ERASE, addr, NULL, NULL, size, ARM_POWER_OFF);
+    }
 
     volumeManager->activeVolume = this;
     int32_t rc = volumeManager->getStorage()->Erase(volumeOffset + addr, size);
@@ -165,9 +232,6 @@ int32_t StorageVolume::EraseAll(void)
     if (!allocated) {
         return STORAGE_VOLUME_MANAGER_STATUS_ERROR_VOLUME_NOT_ALLOCATED;
     }
-    if (volumeManager->activeVolume != NULL) {
-        return ARM_DRIVER_ERROR_BUSY;
-    }
 
     int32_t rc;
 
@@ -184,6 +248,10 @@ int32_t StorageVolume::EraseAll(void)
         }
     }
 
+    if (volumeManager->activeVolume != NULL) {
+        return queuePendingOp(PENDING_OP_ERASE_ALL, 0, NULL, NULL, 0, ARM_POWER_OFF);
+    }
+
     volumeManager->activeVolume = this;
     rc = volumeManager->getStorage()->EraseAll();
     if (rc != ARM_DRIVER_OK) {
@@ -194,7 +262,10 @@ int32_t StorageVolume::EraseAll(void)
 
 ARM_STORAGE_STATUS StorageVolume::GetStatus(void)
 {
-    const uint32_t busy = ((volumeManager->activeVolume != NULL) ? (uint32_t)1 : (uint32_t)0);
+    /* busy reflects this volume only: an operation in flight on its behalf,
+     * or one parked in its pending slot. Activity belonging to sibling
+     * volumes no longer shows up here. */
+    const uint32_t busy = (((volumeManager->activeVolume == this) || hasPendingOp()) ? (uint32_t)1 : (uint32_t)0);
     ARM_STORAGE_STATUS status = {0, 0};
     status.busy = busy;
     return status;
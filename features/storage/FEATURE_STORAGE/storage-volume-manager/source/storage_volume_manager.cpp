@@ -113,6 +113,7 @@ STORAGE_API_DEFINITIONS_FOR_VOLUMES(MAX_VOLUMES);
 int32_t StorageVolumeManager::initialize(ARM_DRIVER_STORAGE *mtd, InitializeCallback_t callback)
 {
     activeVolume        = NULL;
+    nextDispatchIndex   = 0;
     initializeCallback  = callback;
 
     storage             = mtd;
@@ -273,6 +274,13 @@ void StorageVolumeManager::storageCallback(int32_t status, ARM_STORAGE_OPERATION
                 if (callbackVolume->isAllocated() && callbackVolume->getCallback()) {
                     (callbackVolume->getCallback())(status, operation);
                 }
+
+                /* The storage is free again (unless the callback claimed it);
+                 * launch operations parked on the other volumes. Start the
+                 * scan past the volume just served, so it queues behind its
+                 * siblings for the next turn. */
+                volumeManager->nextDispatchIndex = ((callbackVolume - &volumeManager->volumes[0]) + 1) % MAX_VOLUMES;
+                volumeManager->dispatchPendingOps();
             }
             break;
 
@@ -282,6 +290,45 @@ void StorageVolumeManager::storageCallback(int32_t status, ARM_STORAGE_OPERATION
     }
 }
 
+void StorageVolumeManager::dispatchPendingOps(void)
+{
+    /*
+     * Drain the per-volume pending slots while the storage is idle. The scan
+     * resumes past the last volume dispatched, so volumes take fair turns
+     * and a stream of requests on one volume cannot starve the others.
+     * idleScans counts consecutive volumes found with nothing to launch; a
+     * full idle round means we're done (callbacks invoked below may park
+     * new operations, which resets the count).
+     */
+    size_t idleScans = 0;
+    while ((activeVolume == NULL) && (idleScans < MAX_VOLUMES)) {
+        size_t index = nextDispatchIndex;
+        nextDispatchIndex = (nextDispatchIndex + 1) % MAX_VOLUMES;
+
+        StorageVolume *volume = &volumes[index];
+        if (!volume->isAllocated() || !volume->hasPendingOp()) {
+            idleScans++;
+            continue;
+        }
+        idleScans = 0;
+
+        ARM_STORAGE_OPERATION operation;
+        int32_t rc = volume->launchPendingOp(&operation);
+        if (rc == ARM_DRIVER_OK) {
+            /* asynchronous activity pending; its completion callback
+             * re-enters this drain. */
+            return;
+        }
+
+        /* The operation completed synchronously (or failed to launch). The
+         * caller was promised a callback when the operation was parked, so
+         * deliver one here with the driver's return value. */
+        if (volume->getCallback()) {
+            (volume->getCallback())(rc, operation);
+        }
+    }
+}
+
 size_t StorageVolumeManager::findIndexOfUnusedVolume(void) const {
     size_t index;
     for (index = 0; index < MAX_VOLUMES; index++) {
@@ -93,6 +93,23 @@ public:
                           "Use MBRBlockDevice for volumes instead")
     StorageVolume() : allocated(false) { /* empty */ }
 
+    /**
+     * Codes for the per-volume pending-operation slot. While the underlying
+     * storage is mid-operation for one volume, a request arriving on another
+     * volume is parked in its slot (instead of failing with
+     * ARM_DRIVER_ERROR_BUSY) and launched from the completion callback; the
+     * volume-manager rotates across volumes when draining slots so no volume
+     * can starve its siblings.
+     */
+    enum PendingOpCode {
+        PENDING_OP_NONE = 0,
+        PENDING_OP_POWER_CONTROL,
+        PENDING_OP_READ_DATA,
+        PENDING_OP_PROGRAM_DATA,
+        PENDING_OP_ERASE,
+        PENDING_OP_ERASE_ALL,
+    };
+
 public:
     void setup(uint64_t addr, uint64_t size, StorageVolumeManager *volumeManager);
 
@@ -139,6 +156,34 @@ public:
     }
 
 private:
+    /**
+     * Park an operation in this volume's pending slot; it is launched from
+     * the storage completion callback once the underlying storage frees up.
+     *
+     * @return ARM_DRIVER_OK if the operation was queued (a callback will
+     *     follow), else ARM_DRIVER_ERROR_BUSY if this volume already has an
+     *     operation outstanding.
+     */
+    int32_t queuePendingOp(uint8_t code, uint64_t addr, void *readData, const void *programData, uint32_t size, ARM_POWER_STATE state);
+
+    /**
+     * Launch the operation parked in the pending slot. Called by the
+     * volume-manager with the underlying storage idle.
+     *
+     * @param[out] operationP
+     *               The ARM_STORAGE_OPERATION corresponding to the launched
+     *               operation; needed by the caller to synthesize a
+     *               completion callback if the launch completes synchronously.
+     *
+     * @return ARM_DRIVER_OK if asynchronous activity is pending, else the
+     *     driver's synchronous return value.
+     */
+    int32_t launchPendingOp(ARM_STORAGE_OPERATION *operationP);
+
+    bool hasPendingOp(void) const {
+        return pendingOp.code != PENDING_OP_NONE;
+    }
+
     bool overlapsWithBlock(const ARM_STORAGE_BLOCK* blockP) const {
         return (((blockP->addr + blockP->size) <= volumeOffset) || ((volumeOffset + volumeSize) <= blockP->addr)) ? false : true;
     }
@@ -155,11 +200,24 @@ private:
     }
 
 private:
+    struct PendingOp {
+        uint8_t         code;        /* one of PendingOpCode */
+        ARM_POWER_STATE state;       /* for PENDING_OP_POWER_CONTROL */
+        uint64_t        addr;        /* volume-relative address */
+        void           *readData;    /* for PENDING_OP_READ_DATA */
+        const void     *programData; /* for PENDING_OP_PROGRAM_DATA */
+        uint32_t        size;
+    };
+
+private:
+    friend class StorageVolumeManager;
+
     bool                    allocated;
     uint64_t                volumeOffset;
     uint64_t                volumeSize;
     ARM_Storage_Callback_t  callback;
     StorageVolumeManager   *volumeManager;
+    PendingOp               pendingOp;
 };
 
 class StorageVolumeManager {
@@ -219,6 +277,7 @@ private:
     friend int32_t StorageVolume::ProgramData(uint64_t addr, const void *data, uint32_t size);
     friend int32_t StorageVolume::Erase(uint64_t addr, uint32_t size);
     friend int32_t StorageVolume::EraseAll(void);
+    friend int32_t StorageVolume::launchPendingOp(ARM_STORAGE_OPERATION *operationP);
     friend ARM_STORAGE_STATUS StorageVolume::GetStatus(void);
     StorageVolume *activeVolume; /* This state-variable is set to point to a volume
                                   * while there is pending activity. It tracks
@@ -258,12 +317,21 @@ private:
 private:
     size_t findIndexOfUnusedVolume(void) const;
 
+    /**
+     * Launch pending per-volume operations while the underlying storage is
+     * idle. Volumes are visited round-robin starting past the last one
+     * dispatched, so a busy volume cannot starve its siblings. Called from
+     * the storage completion callback.
+     */
+    void dispatchPendingOps(void);
+
 private:
     bool                      initialized;
     ARM_DRIVER_STORAGE       *storage;
     ARM_STORAGE_INFO          storageInfo;
     ARM_STORAGE_CAPABILITIES  storageCapabilities;
     StorageVolume             volumes[MAX_VOLUMES];
+    size_t                    nextDispatchIndex;
 };
 
 #endif /* __STORAGE_VOLUME_MANAGER_H__ */
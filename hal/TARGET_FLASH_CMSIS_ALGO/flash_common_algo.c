@@ -18,9 +18,6 @@
 #include "flash_data.h"
 #include "mbed_critical.h"
 
-#define MBED_FLASH_ALGO_ERASE   1UL
-#define MBED_FLASH_ALGO_PROGRAM 2UL
-
 extern uint32_t SystemCoreClock;
 
 /*
@@ -82,22 +79,104 @@ static int32_t flash_algo_uninit(flash_t *obj, uint32_t address, uint32_t functi
     return ((flash_algo_jump_t)(((uint32_t)&jump_to_flash_algo) | 1))(&arguments);
 }
 
+// Init for the requested function code, unless a resident session is
+// already initialized for it. Should be called within critical section
+static int32_t flash_algo_enter(flash_t *obj, uint32_t address, uint32_t function)
+{
+    if (!obj->algo_session) {
+        return flash_algo_init(obj, address, function);
+    }
+    if (obj->algo_session != function) {
+        flash_algo_uninit(obj, address, obj->algo_session);
+        obj->algo_session = function;
+        return flash_algo_init(obj, address, function);
+    }
+    return 0;
+}
+
+// UnInit unless a resident session keeps the algorithm initialized.
+// Should be called within critical section
+static int32_t flash_algo_exit(flash_t *obj, uint32_t address, uint32_t function)
+{
+    if (!obj->algo_session) {
+        return flash_algo_uninit(obj, address, function);
+    }
+    return 0;
+}
+
 
 int32_t flash_init(flash_t *obj)
 {
     flash_set_target_config(obj);
+    obj->algo_session = 0;
     return 0;
 }
 
 int32_t flash_free(flash_t *obj)
 {
+    if (obj->algo_session) {
+        flash_algo_session_close(obj);
+    }
+    return 0;
+}
+
+int32_t flash_algo_session_open(flash_t *obj)
+{
+    if (obj->algo_session) {
+        return 0;
+    }
+
+    core_util_critical_section_enter();
+    int32_t ret = flash_algo_init(obj, obj->target_config->flash_start, MBED_FLASH_ALGO_PROGRAM);
+    core_util_critical_section_exit();
+
+    if (ret) {
+        return -1;
+    }
+    obj->algo_session = MBED_FLASH_ALGO_PROGRAM;
     return 0;
 }
 
+int32_t flash_algo_session_close(flash_t *obj)
+{
+    if (!obj->algo_session) {
+        return -1;
+    }
+
+    core_util_critical_section_enter();
+    int32_t ret = flash_algo_uninit(obj, obj->target_config->flash_start, obj->algo_session);
+    core_util_critical_section_exit();
+
+    obj->algo_session = 0;
+    return ret ? -1 : 0;
+}
+
+int32_t flash_algo_session_exec(flash_t *obj, const flash_algo_op_t *ops, uint32_t count)
+{
+    if (!obj->algo_session) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t ret;
+        if (ops[i].op == MBED_FLASH_ALGO_ERASE) {
+            ret = flash_erase_sector(obj, ops[i].address);
+        } else if (ops[i].op == MBED_FLASH_ALGO_PROGRAM) {
+            ret = flash_program_page(obj, ops[i].address, ops[i].data, ops[i].size);
+        } else {
+            ret = -1;
+        }
+        if (ret) {
+            return i;
+        }
+    }
+    return count;
+}
+
 int32_t flash_erase_sector(flash_t *obj, uint32_t address)
 {
     core_util_critical_section_enter();
-    flash_algo_init(obj, address, MBED_FLASH_ALGO_ERASE);
+    flash_algo_enter(obj, address, MBED_FLASH_ALGO_ERASE);
 
     args_t arguments = {
         .r0 = address,
@@ -109,7 +188,7 @@ int32_t flash_erase_sector(flash_t *obj, uint32_t address)
     };
     int32_t ret = ((flash_algo_jump_t)(((uint32_t)&jump_to_flash_algo) | 1))(&arguments);
 
-    flash_algo_uninit(obj, address, MBED_FLASH_ALGO_ERASE);
+    flash_algo_exit(obj, address, MBED_FLASH_ALGO_ERASE);
     core_util_critical_section_exit();
     return ret ? -1 : 0;
 }
@@ -118,7 +197,7 @@ int32_t flash_erase_sector(flash_t *obj, uint32_t address)
 int32_t flash_program_page(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size)
 {
     core_util_critical_section_enter();
-    flash_algo_init(obj, address, MBED_FLASH_ALGO_PROGRAM);
+    flash_algo_enter(obj, address, MBED_FLASH_ALGO_PROGRAM);
 
     args_t arguments = {
         .r0 = address,
@@ -130,7 +209,7 @@ int32_t flash_program_page(flash_t *obj, uint32_t address, const uint8_t *data,
     };
     int32_t ret = ((flash_algo_jump_t)(((uint32_t)&jump_to_flash_algo) | 1))(&arguments);
 
-    flash_algo_uninit(obj, address, MBED_FLASH_ALGO_PROGRAM);
+    flash_algo_exit(obj, address, MBED_FLASH_ALGO_PROGRAM);
     core_util_critical_section_exit();
     return ret ? -1 : 0;
 }
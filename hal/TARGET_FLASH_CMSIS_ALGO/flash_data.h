@@ -18,6 +18,10 @@
 
 #include <stdint.h>
 
+// Function codes passed to the algorithm's Init/UnInit
+#define MBED_FLASH_ALGO_ERASE   1UL
+#define MBED_FLASH_ALGO_PROGRAM 2UL
+
 // Target flash algorithm structure
 typedef struct {
     const uint32_t init;
@@ -45,8 +49,21 @@ typedef struct {
 struct flash_s {
     const flash_target_config_t *target_config;
     const flash_algo_t *flash_algo;
+    // Function code (MBED_FLASH_ALGO_*) the resident algorithm is
+    // currently initialized for, or 0 when each operation runs its own
+    // Init/UnInit pair
+    uint32_t algo_session;
 };
 
+// One entry of a queued operation list executed by
+// flash_algo_session_exec
+typedef struct {
+    uint32_t op;            // MBED_FLASH_ALGO_ERASE or MBED_FLASH_ALGO_PROGRAM
+    uint32_t address;
+    const uint8_t *data;    // program only
+    uint32_t size;          // program only
+} flash_algo_op_t;
+
 typedef struct {
     uint32_t r0;
     uint32_t r1;
@@ -75,6 +92,36 @@ extern "C" {
  */
 void flash_set_target_config(flash_t *obj);
 
+/* Open a resident algorithm session
+ *
+ * Runs the algorithm's Init once and keeps it resident: until the
+ * session is closed, flash_erase_sector and flash_program_page skip the
+ * per-call Init/UnInit pair and only re-run it when the function code
+ * changes between erase and program. Removes the fixed per-operation
+ * overhead when an update performs thousands of small programs.
+ *
+ * Returns 0 on success, -1 when Init failed.
+ */
+int32_t flash_algo_session_open(flash_t *obj);
+
+/* Close a resident algorithm session
+ *
+ * Runs the algorithm's UnInit and returns to per-operation Init/UnInit.
+ * Returns 0 on success, -1 when UnInit failed or no session was open.
+ */
+int32_t flash_algo_session_close(flash_t *obj);
+
+/* Execute a queued operation list within an open session
+ *
+ * Runs the operations in order, taking the critical section per
+ * operation so interrupts are serviced between entries. Stops at the
+ * first failing operation.
+ *
+ * Returns the number of operations completed (count on full success),
+ * or -1 when no session is open.
+ */
+int32_t flash_algo_session_exec(flash_t *obj, const flash_algo_op_t *ops, uint32_t count);
+
 #ifdef __cplusplus
 };
 #endif
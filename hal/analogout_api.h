@@ -23,10 +23,21 @@
 
 #if DEVICE_ANALOGOUT
 
+#if DEVICE_ANALOGOUT_ASYNCH
+#include "hal/dma_api.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if DEVICE_ANALOGOUT_ASYNCH
+#define DAC_EVENT_ERROR         (1 << 1) /**< Stream stopped on a DMA error or underrun */
+#define DAC_EVENT_HALF_COMPLETE (1 << 2) /**< First half of the circular buffer was played */
+#define DAC_EVENT_COMPLETE      (1 << 3) /**< Second half of the circular buffer was played */
+#define DAC_EVENT_ALL           (DAC_EVENT_ERROR | DAC_EVENT_HALF_COMPLETE | DAC_EVENT_COMPLETE)
+#endif
+
 /** Analogout hal structure. dac_s is declared in the target's hal
  */
 typedef struct dac_s dac_t;
@@ -82,6 +93,53 @@ uint16_t analogout_read_u16(dac_t *obj);
 
 /**@}*/
 
+#if DEVICE_ANALOGOUT_ASYNCH
+/**
+ * \defgroup hal_analogout_asynch Asynchronous Analogout Hardware Abstraction Layer
+ * @{
+ */
+
+/** Start streaming a circular sample buffer to the DAC
+ *
+ * The buffer is played continuously by timer-paced DMA: when the last sample
+ * has been converted the transfer wraps to the first one without CPU
+ * involvement. DAC_EVENT_HALF_COMPLETE and DAC_EVENT_COMPLETE fire on every
+ * lap so each half of the buffer can be refilled while the other is playing.
+ *
+ * @param[in] obj                The analogout object
+ * @param[in] buffer             Circular buffer of normalised 16-bit samples
+ * @param[in] length             Number of samples in the buffer
+ * @param[in] samples_per_second DAC conversion rate driven by the pacing timer
+ * @param[in] handler            Analogout interrupt handler
+ * @param[in] event              The logical OR of events to be registered
+ * @param[in] hint               A suggestion for how to use DMA with this transfer
+ */
+void analogout_stream(dac_t *obj, const uint16_t *buffer, size_t length, uint32_t samples_per_second, uint32_t handler, uint32_t event, DMAUsage hint);
+
+/** The asynchronous stream IRQ handler
+ *
+ * Reads the half/complete/error state out of the DMA controller and clears it.
+ * @param[in] obj The analogout object
+ * @return Event flags if an event condition was met; otherwise 0
+ */
+uint32_t analogout_irq_handler_asynch(dac_t *obj);
+
+/** Check whether a stream is being played
+ *
+ * @param[in] obj The analogout object
+ * @return Non-zero if the DAC is streaming, zero otherwise
+ */
+uint8_t analogout_active(dac_t *obj);
+
+/** Stop the stream and the pacing timer
+ *
+ * @param obj The analogout object
+ */
+void analogout_stream_abort(dac_t *obj);
+
+/**@}*/
+#endif
+
 #ifdef __cplusplus
 }
 #endif
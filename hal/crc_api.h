@@ -0,0 +1,100 @@
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CRC_API_H
+#define MBED_CRC_API_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "device.h"
+
+/** Commonly used generator polynomials, given in their normal
+ * (non-reflected) form without the implicit top bit.
+ */
+typedef enum crc_polynomial {
+    POLY_7BIT_SD    = 0x09,       /**< x7+x3+1 */
+    POLY_8BIT_CCITT = 0x07,       /**< x8+x2+x+1 */
+    POLY_16BIT_CCITT = 0x1021,    /**< x16+x12+x5+1 */
+    POLY_16BIT_IBM  = 0x8005,     /**< x16+x15+x2+1 */
+    POLY_32BIT_ANSI = 0x04C11DB7  /**< x32+x26+x23+x22+x16+x12+x11+x10+x8+x7+x5+x4+x2+x+1 */
+} crc_polynomial_t;
+
+/** Full description of a CRC computation */
+typedef struct crc_mbed_config {
+    uint32_t polynomial;          /**< Generator polynomial, normal form */
+    uint8_t width;                /**< Width of the CRC in bits, up to 32 */
+    uint32_t initial_xor;         /**< Initial value of the shift register */
+    uint32_t final_xor;           /**< Value XORed into the final remainder */
+    bool reflect_in;              /**< Feed input bytes least significant bit first */
+    bool reflect_out;             /**< Reflect the final remainder */
+} crc_mbed_config_t;
+
+#if DEVICE_CRC
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Determine whether the hardware CRC unit can run this configuration
+ *
+ * Fixed-function units typically support only a few polynomials; the CRC
+ * driver falls back to its software implementation when this returns
+ * false.
+ *
+ * @param config The computation to check
+ * @return true when hal_crc_compute_partial_start() accepts this config
+ */
+bool hal_crc_is_supported(const crc_mbed_config_t *config);
+
+/** Configure the hardware and begin a computation
+ *
+ * @param config The computation to set up
+ */
+void hal_crc_compute_partial_start(const crc_mbed_config_t *config);
+
+/** Feed a block of data into the running computation
+ *
+ * May be called repeatedly to checksum scattered buffers. Targets whose
+ * CRC unit has a data register are free to service large blocks with a
+ * DMA channel (a dma_transfer_t with a fixed destination); the call must
+ * not return until the block has been consumed.
+ *
+ * @param data Input bytes
+ * @param size Number of bytes
+ */
+void hal_crc_compute_partial(const uint8_t *data, const size_t size);
+
+/** Finish the computation and read back the result
+ *
+ * Output reflection and the final XOR of the current configuration are
+ * applied. The peripheral may be reconfigured afterwards.
+ *
+ * @return The CRC, in the low bits when the width is below 32
+ */
+uint32_t hal_crc_get_result(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_CRC
+
+#endif
+
+/** @}*/
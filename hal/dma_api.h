@@ -20,8 +20,15 @@
 #define MBED_DMA_API_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 #define DMA_ERROR_OUT_OF_CHANNELS (-1)
+#define DMA_ERROR_QUEUE_FULL      (-2)
+#define DMA_ERROR_UNSUPPORTED     (-3)
+
+/** Completion status passed to a transfer handler */
+#define DMA_TRANSFER_COMPLETE 0
+#define DMA_TRANSFER_ERROR    (-1)
 
 typedef enum {
     DMA_USAGE_NEVER,
@@ -31,16 +38,102 @@ typedef enum {
     DMA_USAGE_ALLOCATED
 } DMAUsage;
 
+/** Priority of a queued transfer: when no channel is free, pending
+ * transfers are started highest priority first, in submission order
+ * within one priority.
+ */
+typedef enum {
+    DMA_PRIORITY_LOW = 0,
+    DMA_PRIORITY_NORMAL = 1,
+    DMA_PRIORITY_HIGH = 2
+} dma_priority_t;
+
+/** One element of a (possibly linked) transfer
+ *
+ * Memory-to-memory moves increment both addresses; a peripheral end
+ * keeps its address fixed by clearing the corresponding _inc flag, and
+ * width selects the register access size. Descriptors are chained
+ * through next and must stay valid until the completion handler runs.
+ */
+typedef struct dma_transfer_s {
+    const void *src;             /**< Source address */
+    void *dst;                   /**< Destination address */
+    uint32_t length;             /**< Length of this element in bytes */
+    uint8_t width;               /**< Access width in bytes: 1, 2 or 4 */
+    uint8_t src_inc;             /**< Advance the source address (memory side) */
+    uint8_t dst_inc;             /**< Advance the destination address (memory side) */
+    const struct dma_transfer_s *next; /**< Next element of a linked transfer, NULL ends the chain */
+} dma_transfer_t;
+
+/** Completion handler of an asynchronous transfer
+ *
+ * @param context The context registered with the transfer
+ * @param status  DMA_TRANSFER_COMPLETE or DMA_TRANSFER_ERROR
+ */
+typedef void (*dma_transfer_handler_t)(void *context, int status);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 void dma_init(void);
 
+/** Allocate a hardware channel
+ *
+ * Targets return DMA_ERROR_OUT_OF_CHANNELS when every channel is busy,
+ * which makes the channel manager queue the transfer. The default
+ * implementation, used by targets without a DMA engine, returns
+ * DMA_ERROR_UNSUPPORTED, which makes it fall back to a CPU copy instead.
+ */
 int dma_channel_allocate(uint32_t capabilities);
 
 int dma_channel_free(int channelid);
 
+/** Start a transfer chain on an allocated channel
+ *
+ * Implemented by targets with a DMA engine; the default implementation
+ * reports DMA_ERROR_UNSUPPORTED, making the channel manager fall back
+ * to a CPU copy. On completion the target must call
+ * dma_manager_transfer_done() from its transfer interrupt handler.
+ *
+ * @param channelid Channel obtained from dma_channel_allocate()
+ * @param transfer  First element of the transfer chain
+ * @return 0 when the transfer was started, DMA_ERROR_UNSUPPORTED otherwise
+ */
+int dma_transfer_start(int channelid, const dma_transfer_t *transfer);
+
+/** Submit an asynchronous (linked) transfer
+ *
+ * The transfer runs on a DMA channel when one is free; otherwise it is
+ * queued and started, highest priority first, as channels complete. On
+ * targets without a DMA engine the chain is copied by the CPU and the
+ * handler runs before this function returns, so callers need no
+ * target-specific path.
+ *
+ * The handler may be invoked from interrupt context.
+ *
+ * @param transfer First element of the transfer chain, valid until the
+ *                 handler has run
+ * @param priority Arbitration priority among queued transfers
+ * @param handler  Completion handler, may be NULL
+ * @param context  Opaque pointer passed to the handler
+ * @return 0 when the transfer was started or queued, DMA_ERROR_QUEUE_FULL
+ *         when too many transfers are already waiting for a channel
+ */
+int dma_transfer_async(const dma_transfer_t *transfer, dma_priority_t priority,
+                       dma_transfer_handler_t handler, void *context);
+
+/** Report the completion of a transfer started with dma_transfer_start()
+ *
+ * Called by the target's DMA interrupt handler. Runs the registered
+ * completion handler and hands the freed channel to the next pending
+ * transfer.
+ *
+ * @param channelid Channel whose transfer finished
+ * @param status    DMA_TRANSFER_COMPLETE or DMA_TRANSFER_ERROR
+ */
+void dma_manager_transfer_done(int channelid, int status);
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,6 +30,23 @@ typedef struct emac_interface emac_interface_t;
  * This interface should be used to abstract low level access to networking hardware
  */
 
+/**
+ * Capability flags reported through @a emac_get_capabilities_fn
+ *
+ * A driver sets a CHECKSUM_GEN flag when the MAC inserts that checksum
+ * into outgoing frames in hardware, and a CHECKSUM_CHECK flag when the
+ * MAC verifies it on reception (dropping bad frames); the IP stack then
+ * skips the corresponding software checksum work.
+ */
+#define EMAC_CAPABILITY_CHECKSUM_GEN_IP     0x0001
+#define EMAC_CAPABILITY_CHECKSUM_GEN_UDP    0x0002
+#define EMAC_CAPABILITY_CHECKSUM_GEN_TCP    0x0004
+#define EMAC_CAPABILITY_CHECKSUM_GEN_ICMP   0x0008
+#define EMAC_CAPABILITY_CHECKSUM_CHECK_IP   0x0100
+#define EMAC_CAPABILITY_CHECKSUM_CHECK_UDP  0x0200
+#define EMAC_CAPABILITY_CHECKSUM_CHECK_TCP  0x0400
+#define EMAC_CAPABILITY_CHECKSUM_CHECK_ICMP 0x0800
+
 /**
  * Callback to be register with Emac interface and to be called fore received packets
  *
@@ -102,6 +119,23 @@ typedef void (*emac_set_hwaddr_fn)(emac_interface_t *emac, uint8_t *addr);
  */
 typedef bool (*emac_link_out_fn)(emac_interface_t *emac, emac_stack_mem_t *buf);
 
+/**
+ * Sends a chain of buffers over the link as one frame
+ *
+ * For MACs with chained (scatter-gather) DMA descriptors: each piece of the
+ * chain is posted as its own descriptor, so a frame assembled from several
+ * buffers (say a protocol header and a payload) goes out without being
+ * flattened into a bounce buffer first. The driver must hold a reference on
+ * each piece (@a emac_stack_mem_ref) until its descriptor has completed.
+ *
+ * That can not be called from an interrupt context.
+ *
+ * @param emac  Emac interface
+ * @param chain Chain of buffers making up one frame
+ * @return      True if the frame was sent successfully, False otherwise
+ */
+typedef bool (*emac_link_out_chain_fn)(emac_interface_t *emac, emac_stack_mem_chain_t *chain);
+
 /**
  * Initializes the HW
  *
@@ -134,6 +168,17 @@ typedef void (*emac_set_link_input_cb_fn)(emac_interface_t *emac, emac_link_inpu
  */
 typedef void (*emac_set_link_state_cb_fn)(emac_interface_t *emac, emac_link_state_change_fn state_cb, void *data);
 
+/**
+ * Returns the hardware offload capabilities of the interface
+ *
+ * Drivers without hardware offloads leave this entry NULL, which is
+ * treated as no capabilities.
+ *
+ * @param emac Emac interface
+ * @return     EMAC_CAPABILITY flags, ORed together
+ */
+typedef uint32_t (*emac_get_capabilities_fn)(emac_interface_t *emac);
+
 typedef struct emac_interface_ops {
     emac_get_mtu_size_fn        get_mtu_size;
     emac_get_ifname_fn          get_ifname;
@@ -145,6 +190,12 @@ typedef struct emac_interface_ops {
     emac_power_down_fn          power_down;
     emac_set_link_input_cb_fn   set_link_input_cb;
     emac_set_link_state_cb_fn   set_link_state_cb;
+    /* Appended so existing driver initializers keep working - they get
+     * a NULL entry, meaning no hardware offloads */
+    emac_get_capabilities_fn    get_capabilities;
+    /* Appended; NULL means the MAC cannot scatter-gather and frames are
+     * delivered through link_out instead */
+    emac_link_out_chain_fn      link_out_chain;
 } emac_interface_ops_t;
 
 typedef struct emac_interface {
@@ -47,6 +47,32 @@ int ethernet_receive(void);
 // if data == NULL, throw the bytes away
 int ethernet_read(char *data, int size);
 
+// Zero-copy receive extension.
+//
+// Targets whose MAC fills DMA descriptor buffers can lend those buffers
+// to the application instead of copying each frame out through
+// ethernet_read. The default implementations are weak stubs reporting
+// the extension as unsupported, so targets opt in by overriding them.
+
+// a received frame lent to the application: data points into the DMA
+// buffer, token identifies the descriptor for release
+typedef struct {
+    void *data;
+    int size;
+    void *token;
+} ethernet_frame_t;
+
+// harvest up to count completed receive descriptors without copying,
+// filling one ethernet_frame_t per frame.
+// return the number of frames lent (0 if none pending),
+// or -1 if the target does not support zero-copy receive.
+// Lent buffers stay out of the DMA ring until released; frames must fit
+// a single descriptor buffer, and must be released in the order lent.
+int ethernet_receive_zerocopy(ethernet_frame_t *frames, int count);
+
+// return a lent descriptor buffer to the DMA ring
+void ethernet_release_frame(ethernet_frame_t *frame);
+
 // get the ethernet address
 void ethernet_address(char *mac);
 
@@ -0,0 +1,265 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hal/dma_api.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+#include "platform/mbed_assert.h"
+
+/* Number of transfers that may wait for a free channel at one time */
+#ifndef MBED_CONF_PLATFORM_DMA_PENDING_TRANSFERS
+#define MBED_CONF_PLATFORM_DMA_PENDING_TRANSFERS 8
+#endif
+
+/* Hardware channels the manager will drive concurrently */
+#define DMA_MANAGER_MAX_CHANNELS 8
+
+/* Targets without a DMA engine do not provide dma_api.c at all, so the
+ * allocator and the start hook default to "no channel"/"not supported"
+ * here and the manager degrades to a CPU copy. */
+MBED_WEAK void dma_init(void)
+{
+}
+
+MBED_WEAK int dma_channel_allocate(uint32_t capabilities)
+{
+    (void)capabilities;
+    return DMA_ERROR_UNSUPPORTED;
+}
+
+MBED_WEAK int dma_channel_free(int channelid)
+{
+    (void)channelid;
+    return 0;
+}
+
+MBED_WEAK int dma_transfer_start(int channelid, const dma_transfer_t *transfer)
+{
+    (void)channelid;
+    (void)transfer;
+    return DMA_ERROR_UNSUPPORTED;
+}
+
+typedef struct {
+    const dma_transfer_t *transfer;
+    dma_transfer_handler_t handler;
+    void *context;
+    uint8_t priority;
+    uint8_t used;
+    uint32_t order;               /* submission order, for FIFO within a priority */
+} dma_pending_t;
+
+typedef struct {
+    int channelid;
+    dma_transfer_handler_t handler;
+    void *context;
+    uint8_t used;
+} dma_active_t;
+
+static dma_pending_t dma_pending[MBED_CONF_PLATFORM_DMA_PENDING_TRANSFERS];
+static dma_active_t dma_active[DMA_MANAGER_MAX_CHANNELS];
+static uint32_t dma_order_next = 0;
+static uint8_t dma_inited = 0;
+
+/* Copy a transfer chain with the core, honoring width and the address
+ * increment flags so peripheral-style descriptors behave as they would
+ * on a DMA engine. */
+static void dma_cpu_copy(const dma_transfer_t *transfer)
+{
+    for (; transfer != NULL; transfer = transfer->next) {
+        uint32_t count = transfer->length / transfer->width;
+        const uint8_t *src = (const uint8_t *)transfer->src;
+        uint8_t *dst = (uint8_t *)transfer->dst;
+
+        for (uint32_t i = 0; i < count; i++) {
+            switch (transfer->width) {
+                case 4:
+                    *(volatile uint32_t *)dst = *(const volatile uint32_t *)src;
+                    break;
+                case 2:
+                    *(volatile uint16_t *)dst = *(const volatile uint16_t *)src;
+                    break;
+                default:
+                    *(volatile uint8_t *)dst = *(const volatile uint8_t *)src;
+                    break;
+            }
+            if (transfer->src_inc) {
+                src += transfer->width;
+            }
+            if (transfer->dst_inc) {
+                dst += transfer->width;
+            }
+        }
+    }
+}
+
+/* Pick the pending transfer to start next: highest priority first,
+ * submission order within one priority. Returns NULL when none wait. */
+static dma_pending_t *dma_pending_pick(void)
+{
+    dma_pending_t *best = NULL;
+    for (int i = 0; i < MBED_CONF_PLATFORM_DMA_PENDING_TRANSFERS; i++) {
+        dma_pending_t *p = &dma_pending[i];
+        if (!p->used) {
+            continue;
+        }
+        if (best == NULL || p->priority > best->priority ||
+                (p->priority == best->priority && (int32_t)(p->order - best->order) < 0)) {
+            best = p;
+        }
+    }
+    return best;
+}
+
+/* Try to run one transfer on a hardware channel; interrupts must be
+ * masked. Returns 0 on success, DMA_ERROR_OUT_OF_CHANNELS or
+ * DMA_ERROR_UNSUPPORTED when it could not be started. */
+static int dma_try_start(const dma_transfer_t *transfer,
+                         dma_transfer_handler_t handler, void *context)
+{
+    int channelid = dma_channel_allocate(DMA_USAGE_TEMPORARY_ALLOCATED);
+    if (channelid == DMA_ERROR_UNSUPPORTED) {
+        return DMA_ERROR_UNSUPPORTED;
+    }
+    if (channelid < 0) {
+        return DMA_ERROR_OUT_OF_CHANNELS;
+    }
+
+    dma_active_t *active = NULL;
+    for (int i = 0; i < DMA_MANAGER_MAX_CHANNELS; i++) {
+        if (!dma_active[i].used) {
+            active = &dma_active[i];
+            break;
+        }
+    }
+    if (active == NULL) {
+        dma_channel_free(channelid);
+        return DMA_ERROR_OUT_OF_CHANNELS;
+    }
+
+    active->channelid = channelid;
+    active->handler = handler;
+    active->context = context;
+    active->used = 1;
+
+    if (dma_transfer_start(channelid, transfer) != 0) {
+        active->used = 0;
+        dma_channel_free(channelid);
+        return DMA_ERROR_UNSUPPORTED;
+    }
+    return 0;
+}
+
+int dma_transfer_async(const dma_transfer_t *transfer, dma_priority_t priority,
+                       dma_transfer_handler_t handler, void *context)
+{
+    MBED_ASSERT(transfer != NULL);
+
+    core_util_critical_section_enter();
+    if (!dma_inited) {
+        dma_init();
+        dma_inited = 1;
+    }
+
+    int started = dma_try_start(transfer, handler, context);
+    if (started == 0) {
+        core_util_critical_section_exit();
+        return 0;
+    }
+
+    if (started == DMA_ERROR_OUT_OF_CHANNELS) {
+        /* all channels busy - queue and let the completion path start it */
+        for (int i = 0; i < MBED_CONF_PLATFORM_DMA_PENDING_TRANSFERS; i++) {
+            dma_pending_t *p = &dma_pending[i];
+            if (!p->used) {
+                p->transfer = transfer;
+                p->handler = handler;
+                p->context = context;
+                p->priority = (uint8_t)priority;
+                p->order = dma_order_next++;
+                p->used = 1;
+                core_util_critical_section_exit();
+                return 0;
+            }
+        }
+        core_util_critical_section_exit();
+        return DMA_ERROR_QUEUE_FULL;
+    }
+
+    core_util_critical_section_exit();
+
+    /* No DMA engine - move the data with the core and complete in place */
+    dma_cpu_copy(transfer);
+    if (handler) {
+        handler(context, DMA_TRANSFER_COMPLETE);
+    }
+    return 0;
+}
+
+void dma_manager_transfer_done(int channelid, int status)
+{
+    core_util_critical_section_enter();
+
+    dma_active_t *active = NULL;
+    for (int i = 0; i < DMA_MANAGER_MAX_CHANNELS; i++) {
+        if (dma_active[i].used && dma_active[i].channelid == channelid) {
+            active = &dma_active[i];
+            break;
+        }
+    }
+    if (active == NULL) {
+        core_util_critical_section_exit();
+        return;
+    }
+
+    dma_transfer_handler_t handler = active->handler;
+    void *context = active->context;
+    active->used = 0;
+
+    /* arbitrate: hand the channel to the best waiting transfer */
+    dma_pending_t *next = dma_pending_pick();
+    if (next != NULL) {
+        if (dma_transfer_start(channelid, next->transfer) == 0) {
+            active->channelid = channelid;
+            active->handler = next->handler;
+            active->context = next->context;
+            active->used = 1;
+            next->used = 0;
+        } else {
+            /* engine refused the chain - complete it with the core */
+            dma_pending_t taken = *next;
+            next->used = 0;
+            dma_channel_free(channelid);
+            core_util_critical_section_exit();
+
+            dma_cpu_copy(taken.transfer);
+            if (taken.handler) {
+                taken.handler(taken.context, DMA_TRANSFER_COMPLETE);
+            }
+            if (handler) {
+                handler(context, status);
+            }
+            return;
+        }
+    } else {
+        dma_channel_free(channelid);
+    }
+
+    core_util_critical_section_exit();
+
+    if (handler) {
+        handler(context, status);
+    }
+}
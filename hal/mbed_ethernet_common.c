@@ -0,0 +1,40 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hal/ethernet_api.h"
+
+#if DEVICE_ETHERNET
+
+#include "platform/mbed_toolchain.h"
+
+/* Weak defaults for the zero-copy receive extension. Targets whose MAC
+ * uses a DMA descriptor ring override both with implementations that
+ * lend descriptor buffers directly; everyone else reports the extension
+ * as unsupported and keeps the copying ethernet_receive/ethernet_read
+ * path. */
+
+MBED_WEAK int ethernet_receive_zerocopy(ethernet_frame_t *frames, int count)
+{
+    (void)frames;
+    (void)count;
+    return -1;
+}
+
+MBED_WEAK void ethernet_release_frame(ethernet_frame_t *frame)
+{
+    (void)frame;
+}
+
+#endif
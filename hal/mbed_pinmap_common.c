@@ -16,6 +16,8 @@
 #include "hal/pinmap.h"
 #include "platform/mbed_error.h"
 
+#include <stddef.h>
+
 void pinmap_pinout(PinName pin, const PinMap *map) {
     if (pin == NC)
         return;
@@ -68,6 +70,27 @@ uint32_t pinmap_peripheral(PinName pin, const PinMap* map) {
     return peripheral;
 }
 
+const PinMap *pinmap_entry(PinName pin, const PinMap *map) {
+    if (pin == (PinName)NC)
+        return NULL;
+
+    while (map->pin != NC) {
+        if (map->pin == pin)
+            return map;
+        map++;
+    }
+    error("pinmap not found for peripheral");
+    return NULL;
+}
+
+void pinmap_pinout_entry(const PinMap *entry) {
+    if (entry == NULL)
+        return;
+
+    pin_function(entry->pin, entry->function);
+    pin_mode(entry->pin, PullNone);
+}
+
 uint32_t pinmap_find_function(PinName pin, const PinMap* map) {
     while (map->pin != NC) {
         if (map->pin == pin)
@@ -0,0 +1,31 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hal/port_api.h"
+#include "platform/mbed_toolchain.h"
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+
+/* Overridden by targets whose PinName encoding allows recovering the
+ * port; without a decoding the bus drivers keep their per-pin path. */
+MBED_WEAK int port_decode_pin(PinName pin, PortName *port, int *pin_n)
+{
+    (void)pin;
+    (void)port;
+    (void)pin_n;
+    return -1;
+}
+
+#endif
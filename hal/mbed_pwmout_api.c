@@ -0,0 +1,30 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hal/pwmout_api.h"
+#include "platform/mbed_toolchain.h"
+
+#if DEVICE_PWMOUT
+
+/* Overridden by targets that can commit all compare registers on one
+ * timer update event; the default applies the channels back to back. */
+MBED_WEAK void pwmout_apply_group(pwmout_t **objs, const int *pulsewidths_us, int count)
+{
+    for (int i = 0; i < count; i++) {
+        pwmout_pulsewidth_us(objs[i], pulsewidths_us[i]);
+    }
+}
+
+#endif
@@ -18,14 +18,86 @@
 #include "mbed_critical.h"
 #include "sleep_api.h"
 #include "mbed_error.h"
+#include "mbed_stats.h"
 #include <limits.h>
+#include <string.h>
 
 #if DEVICE_SLEEP
 
 // deep sleep locking counter. A target is allowed to deep sleep if counter == 0
 static uint16_t deep_sleep_lock = 0U;
 
-void sleep_manager_lock_deep_sleep(void)
+#ifdef MBED_SLEEP_STATS_ENABLED
+
+#include "us_ticker_api.h"
+#include "cmsis.h"
+
+#ifndef MBED_CONF_PLATFORM_SLEEP_STATS_WAKEUP_LOG
+#define MBED_CONF_PLATFORM_SLEEP_STATS_WAKEUP_LOG 8
+#endif
+
+// per-owner lock record, indexed by the compact sleep_lock_owner_t IDs
+static mbed_stats_sleep_lock_t sleep_lock_stats[SLEEP_LOCK_OWNER_COUNT];
+// when the owner's first outstanding lock was taken
+static us_timestamp_t sleep_lock_since[SLEEP_LOCK_OWNER_COUNT];
+
+static mbed_stats_wakeup_t wakeup_log[MBED_CONF_PLATFORM_SLEEP_STATS_WAKEUP_LOG];
+static uint32_t wakeup_log_next = 0;
+static uint32_t wakeup_log_count = 0;
+
+// all three hooks below run with interrupts masked by their caller
+
+static void sleep_stats_lock(uint32_t owner)
+{
+    if (owner >= SLEEP_LOCK_OWNER_COUNT) {
+        owner = SLEEP_LOCK_OWNER_OTHER;
+    }
+    mbed_stats_sleep_lock_t *stats = &sleep_lock_stats[owner];
+    stats->owner = owner;
+    stats->lock_cnt++;
+    if (stats->held++ == 0) {
+        sleep_lock_since[owner] = ticker_read_us(get_us_ticker_data());
+    }
+}
+
+static void sleep_stats_unlock(uint32_t owner)
+{
+    if (owner >= SLEEP_LOCK_OWNER_COUNT) {
+        owner = SLEEP_LOCK_OWNER_OTHER;
+    }
+    mbed_stats_sleep_lock_t *stats = &sleep_lock_stats[owner];
+    if (stats->held != 0 && --stats->held == 0) {
+        stats->total_blocked_us +=
+                ticker_read_us(get_us_ticker_data()) - sleep_lock_since[owner];
+    }
+}
+
+static void sleep_stats_wakeup(uint32_t deep)
+{
+    mbed_stats_wakeup_t *wakeup = &wakeup_log[wakeup_log_next];
+    wakeup_log_next = (wakeup_log_next + 1) % MBED_CONF_PLATFORM_SLEEP_STATS_WAKEUP_LOG;
+    if (wakeup_log_count < MBED_CONF_PLATFORM_SLEEP_STATS_WAKEUP_LOG) {
+        wakeup_log_count++;
+    }
+    wakeup->timestamp = ticker_read_us(get_us_ticker_data());
+#ifdef SCB_ICSR_VECTPENDING_Msk
+    // the waking interrupt is still held pending by our critical section
+    wakeup->cause = (SCB->ICSR & SCB_ICSR_VECTPENDING_Msk) >> SCB_ICSR_VECTPENDING_Pos;
+#else
+    wakeup->cause = 0;
+#endif
+    wakeup->deep = deep;
+}
+
+#else
+
+#define sleep_stats_lock(owner)   ((void)(owner))
+#define sleep_stats_unlock(owner) ((void)(owner))
+#define sleep_stats_wakeup(deep)  ((void)(deep))
+
+#endif
+
+void sleep_manager_lock_deep_sleep_id(uint32_t owner)
 {
     core_util_critical_section_enter();
     if (deep_sleep_lock == USHRT_MAX) {
@@ -33,10 +105,11 @@ void sleep_manager_lock_deep_sleep(void)
         error("Deep sleep lock would overflow (> USHRT_MAX)");
     }
     core_util_atomic_incr_u16(&deep_sleep_lock, 1);
+    sleep_stats_lock(owner);
     core_util_critical_section_exit();
 }
 
-void sleep_manager_unlock_deep_sleep(void)
+void sleep_manager_unlock_deep_sleep_id(uint32_t owner)
 {
     core_util_critical_section_enter();
     if (deep_sleep_lock == 0) {
@@ -44,9 +117,20 @@ void sleep_manager_unlock_deep_sleep(void)
         error("Deep sleep lock would underflow (< 0)");
     }
     core_util_atomic_decr_u16(&deep_sleep_lock, 1);
+    sleep_stats_unlock(owner);
     core_util_critical_section_exit();
 }
 
+void sleep_manager_lock_deep_sleep(void)
+{
+    sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_OTHER);
+}
+
+void sleep_manager_unlock_deep_sleep(void)
+{
+    sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_OTHER);
+}
+
 bool sleep_manager_can_deep_sleep(void)
 {
     return deep_sleep_lock == 0 ? true : false;
@@ -58,11 +142,14 @@ void sleep_manager_sleep_auto(void)
 // debug profile should keep debuggers attached, no deep sleep allowed
 #ifdef MBED_DEBUG
     hal_sleep();
+    sleep_stats_wakeup(0);
 #else
     if (sleep_manager_can_deep_sleep()) {
         hal_deepsleep();
+        sleep_stats_wakeup(1);
     } else {
         hal_sleep();
+        sleep_stats_wakeup(0);
     }
 #endif
     core_util_critical_section_exit();
@@ -83,6 +170,16 @@ void sleep_manager_unlock_deep_sleep(void)
 
 }
 
+void sleep_manager_lock_deep_sleep_id(uint32_t owner)
+{
+    (void)owner;
+}
+
+void sleep_manager_unlock_deep_sleep_id(uint32_t owner)
+{
+    (void)owner;
+}
+
 bool sleep_manager_can_deep_sleep(void)
 {
     // no sleep implemented
@@ -90,3 +187,51 @@ bool sleep_manager_can_deep_sleep(void)
 }
 
 #endif
+
+size_t mbed_stats_sleep_lock_get_each(mbed_stats_sleep_lock_t *stats, size_t count)
+{
+    memset(stats, 0, count * sizeof(mbed_stats_sleep_lock_t));
+    size_t i = 0;
+
+#if DEVICE_SLEEP && defined(MBED_SLEEP_STATS_ENABLED)
+    core_util_critical_section_enter();
+    us_timestamp_t now = ticker_read_us(get_us_ticker_data());
+    for (uint32_t owner = 0; owner < SLEEP_LOCK_OWNER_COUNT && i < count; owner++) {
+        if (sleep_lock_stats[owner].lock_cnt != 0) {
+            stats[i] = sleep_lock_stats[owner];
+            if (stats[i].held != 0) {
+                // show the hold in progress, a stuck lock stands out
+                stats[i].total_blocked_us += now - sleep_lock_since[owner];
+            }
+            i++;
+        }
+    }
+    core_util_critical_section_exit();
+#endif
+
+    return i;
+}
+
+size_t mbed_stats_wakeup_get_each(mbed_stats_wakeup_t *stats, size_t count)
+{
+    memset(stats, 0, count * sizeof(mbed_stats_wakeup_t));
+    size_t i = 0;
+
+#if DEVICE_SLEEP && defined(MBED_SLEEP_STATS_ENABLED)
+    core_util_critical_section_enter();
+    uint32_t n = wakeup_log_count;
+    if (n > count) {
+        n = count;
+    }
+    // copy chronologically, starting from the oldest retained entry
+    uint32_t idx = (wakeup_log_next + MBED_CONF_PLATFORM_SLEEP_STATS_WAKEUP_LOG - n)
+            % MBED_CONF_PLATFORM_SLEEP_STATS_WAKEUP_LOG;
+    for (; i < n; i++) {
+        stats[i] = wakeup_log[idx];
+        idx = (idx + 1) % MBED_CONF_PLATFORM_SLEEP_STATS_WAKEUP_LOG;
+    }
+    core_util_critical_section_exit();
+#endif
+
+    return i;
+}
@@ -22,6 +22,47 @@
 static void schedule_interrupt(const ticker_data_t *const ticker);
 static void update_present_time(const ticker_data_t *const ticker);
 
+/* State of the generator deciding how many express levels an inserted
+ * event is linked at; correctness never depends on the draw, only the
+ * expected search length does */
+static uint32_t skip_level_seed = 0x9E3779B9;
+
+/*
+ * Draw the number of express levels for a new event: each level is
+ * reached with probability 1/4.
+ */
+static unsigned event_random_level(void)
+{
+    uint32_t r = skip_level_seed;
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    skip_level_seed = r;
+
+    unsigned level = 0;
+    while ((level < TICKER_EVENT_SKIP_LEVELS) && ((r & 3) == 0)) {
+        level++;
+        r >>= 2;
+    }
+    return level;
+}
+
+/*
+ * Unlink the head event from the queue, including any express level it
+ * heads. The head is the earliest event, so at every level where it is
+ * present it is the first element.
+ */
+static void event_queue_pop_head(ticker_event_queue_t *queue)
+{
+    ticker_event_t *p = queue->head;
+    for (unsigned l = 0; l < TICKER_EVENT_SKIP_LEVELS; l++) {
+        if (queue->skip_head[l] == p) {
+            queue->skip_head[l] = p->skip[l];
+        }
+    }
+    queue->head = p->next;
+}
+
 /*
  * Initialize a ticker instance.  
  */
@@ -53,6 +94,9 @@ static void initialize(const ticker_data_t *ticker)
 
     ticker->queue->event_handler = NULL;
     ticker->queue->head = NULL;
+    for (unsigned l = 0; l < TICKER_EVENT_SKIP_LEVELS; l++) {
+        ticker->queue->skip_head[l] = NULL;
+    }
     ticker->queue->tick_last_read = ticker->interface->read();
     ticker->queue->tick_remainder = 0;
     ticker->queue->frequency = frequency;
@@ -112,12 +156,18 @@ static void update_present_time(const ticker_data_t *const ticker)
 {
 
     ticker_event_queue_t *queue = ticker->queue;
+    core_util_critical_section_enter();
     uint32_t ticker_time = ticker->interface->read();
     if (ticker_time == ticker->queue->tick_last_read) {
         // No work to do
+        core_util_critical_section_exit();
         return;
     }
 
+    /* Odd sequence values flag the time state as inconsistent so the
+       lock-free snapshot in ticker_read_us can detect a torn read */
+    queue->seq++;
+
     uint64_t elapsed_ticks = (ticker_time - queue->tick_last_read) & queue->bitmask;
     queue->tick_last_read = ticker_time;
 
@@ -154,6 +204,8 @@ static void update_present_time(const ticker_data_t *const ticker)
 
     // Update current time
     queue->present_time += elapsed_us;
+    queue->seq++;
+    core_util_critical_section_exit();
 }
 
 /**
@@ -268,11 +320,11 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
         // update the current timestamp used by the queue 
         update_present_time(ticker);
 
-        if (ticker->queue->head->timestamp <= ticker->queue->present_time) { 
+        if (ticker->queue->head->timestamp <= ticker->queue->present_time) {
             // This event was in the past:
             //      point to the following one and execute its handler
             ticker_event_t *p = ticker->queue->head;
-            ticker->queue->head = ticker->queue->head->next;
+            event_queue_pop_head(ticker->queue);
             if (ticker->queue->event_handler != NULL) {
                 (*ticker->queue->event_handler)(p->id); // NOTE: the handler can set new events
             }
@@ -316,30 +368,55 @@ void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *o
     obj->timestamp = timestamp;
     obj->id = id;
 
-    /* Go through the list until we either reach the end, or find
-       an element this should come before (which is possibly the
-       head). */
-    ticker_event_t *prev = NULL, *p = ticker->queue->head;
-    while (p != NULL) {
-        /* check if we come before p */
-        if (timestamp < p->timestamp) {
-            break;
+    ticker_event_queue_t *queue = ticker->queue;
+
+    /* Locate the insertion point by descending the express levels: at each
+       level, advance past every event scheduled at or before this timestamp,
+       remembering the last event passed so the new event can be linked in
+       behind it. Only a logarithmic number of events is visited instead of
+       the whole list. */
+    ticker_event_t *prev = NULL;
+    ticker_event_t *update[TICKER_EVENT_SKIP_LEVELS];
+    for (int l = TICKER_EVENT_SKIP_LEVELS - 1; l >= 0; l--) {
+        ticker_event_t *p = prev ? prev->skip[l] : queue->skip_head[l];
+        while (p != NULL && p->timestamp <= timestamp) {
+            prev = p;
+            p = p->skip[l];
         }
-        /* go to the next element */
+        update[l] = prev;
+    }
+    ticker_event_t *p = prev ? prev->next : queue->head;
+    while (p != NULL && p->timestamp <= timestamp) {
         prev = p;
         p = p->next;
     }
-    
+
     /* if we're at the end p will be NULL, which is correct */
     obj->next = p;
 
     /* if prev is NULL we're at the head */
     if (prev == NULL) {
-        ticker->queue->head = obj;
+        queue->head = obj;
     } else {
         prev->next = obj;
     }
 
+    /* Link the event into the express levels it was drawn for */
+    obj->level = event_random_level();
+    for (unsigned l = 0; l < TICKER_EVENT_SKIP_LEVELS; l++) {
+        if (l < obj->level) {
+            if (update[l] != NULL) {
+                obj->skip[l] = update[l]->skip[l];
+                update[l]->skip[l] = obj;
+            } else {
+                obj->skip[l] = queue->skip_head[l];
+                queue->skip_head[l] = obj;
+            }
+        } else {
+            obj->skip[l] = NULL;
+        }
+    }
+
     schedule_interrupt(ticker);
 
     core_util_critical_section_exit();
@@ -349,14 +426,44 @@ void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
 {
     core_util_critical_section_enter();
 
+    ticker_event_queue_t *queue = ticker->queue;
+
     // remove this object from the list
-    if (ticker->queue->head == obj) {
+    if (queue->head == obj) {
         // first in the list, so just drop me
-        ticker->queue->head = obj->next;
+        event_queue_pop_head(queue);
         schedule_interrupt(ticker);
     } else {
-        // find the object before me, then drop me
-        ticker_event_t* p = ticker->queue->head;
+        /* Descend the express levels with a strict comparison so the cursor
+           stops before any run of events sharing this timestamp, then scan
+           that run at each level for the object and unlink it where found.
+           The run is scanned with its own cursor so the descent position is
+           not advanced past the object's spot when the object is absent
+           from a level. */
+        ticker_event_t *prev = NULL;
+        for (int l = TICKER_EVENT_SKIP_LEVELS - 1; l >= 0; l--) {
+            ticker_event_t *p = prev ? prev->skip[l] : queue->skip_head[l];
+            while (p != NULL && p->timestamp < obj->timestamp) {
+                prev = p;
+                p = p->skip[l];
+            }
+            ticker_event_t *tie_prev = prev;
+            while (p != NULL && p->timestamp == obj->timestamp && p != obj) {
+                tie_prev = p;
+                p = p->skip[l];
+            }
+            if (p == obj) {
+                if (tie_prev != NULL) {
+                    tie_prev->skip[l] = obj->skip[l];
+                } else {
+                    queue->skip_head[l] = obj->skip[l];
+                }
+            }
+        }
+
+        // find the object before me, then drop me; the descent already
+        // skipped everything scheduled strictly earlier
+        ticker_event_t *p = prev ? prev : queue->head;
         while (p != NULL) {
             if (p->next == obj) {
                 p->next = obj->next;
@@ -377,6 +484,30 @@ timestamp_t ticker_read(const ticker_data_t *const ticker)
 us_timestamp_t ticker_read_us(const ticker_data_t *const ticker)
 {
     initialize(ticker);
+
+    /* Lock-free fast path: when the hardware count has not moved since the
+       last update, present_time is already exact, so return a snapshot of it
+       guarded by the sequence counter instead of masking interrupts. The
+       counter is odd while an update is in flight and changes when one
+       completes, so a torn snapshot is detected and retried. Any tick
+       movement takes the updating slow path, which keeps the overflow
+       extension advancing exactly as it always has. The volatile access
+       keeps the snapshot loads ordered against the counter checks. */
+    const volatile ticker_event_queue_t *queue = ticker->queue;
+    do {
+        uint32_t seq = queue->seq;
+        us_timestamp_t base = queue->present_time;
+        uint32_t tick_last_read = queue->tick_last_read;
+        if ((seq & 1) || (seq != queue->seq)) {
+            // An update was in flight, the snapshot may be torn - retry
+            continue;
+        }
+        if (ticker->interface->read() != tick_last_read) {
+            break;
+        }
+        return base;
+    } while (1);
+
     update_present_time(ticker);
     return ticker->queue->present_time;
 }
@@ -41,6 +41,29 @@ void     pinmap_pinout    (PinName pin, const PinMap *map);
 uint32_t pinmap_find_peripheral(PinName pin, const PinMap* map);
 uint32_t pinmap_find_function(PinName pin, const PinMap* map);
 
+/** Find the map entry for a pin with a single table scan
+ *
+ * One scan yields both the peripheral and the function, so an init
+ * path that needs to resolve the peripheral first and configure the
+ * pin later can hold on to the entry instead of scanning the table a
+ * second time in pinmap_pinout.
+ *
+ * @param pin The pin to look up
+ * @param map The pin map to scan
+ * @return The matching entry, or NULL if pin is NC. A connected pin
+ *         with no mapping is an error, as in pinmap_peripheral
+ */
+const PinMap *pinmap_entry(PinName pin, const PinMap *map);
+
+/** Configure a pin from an already resolved map entry, without a scan
+ *
+ * Applies the same function and mode that pinmap_pinout would, minus
+ * the table walk. A NULL entry (an NC pin) is ignored.
+ *
+ * @param entry Entry previously returned by pinmap_entry
+ */
+void pinmap_pinout_entry(const PinMap *entry);
+
 #ifdef __cplusplus
 }
 #endif
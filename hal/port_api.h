@@ -44,6 +44,21 @@ typedef struct port_s port_t;
  */
 PinName port_pin(PortName port, int pin_n);
 
+/** Decode a pin into the port it belongs to and its bit position
+ *
+ * The inverse of port_pin(). The default implementation reports that no
+ * decoding is available, which makes callers such as BusOut fall back to
+ * driving their pins individually; targets with a regular PinName
+ * encoding override it so that pins sharing a port can be written with a
+ * single masked port access.
+ *
+ * @param pin   The pin to decode, not NC
+ * @param port  Receives the port name
+ * @param pin_n Receives the pin number within the port
+ * @return 0 when decoded, -1 when the target cannot decode pin names
+ */
+int port_decode_pin(PinName pin, PortName *port, int *pin_n);
+
 /** Initilize the port
  *
  * @param obj  The port object to initialize
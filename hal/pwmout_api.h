@@ -107,6 +107,20 @@ void pwmout_pulsewidth_ms(pwmout_t *obj, int ms);
  */
 void pwmout_pulsewidth_us(pwmout_t *obj, int us);
 
+/** Apply new pulse widths to a group of channels in one operation
+ *
+ * Called with interrupts disabled. The default implementation writes the
+ * channels back to back; targets whose timers have buffered (shadow)
+ * compare registers override it to load every compare register and then
+ * trigger a single update event, so all channels switch on the same
+ * period boundary.
+ *
+ * @param objs            The channels to update
+ * @param pulsewidths_us  New pulse width of each channel, in microseconds
+ * @param count           Number of channels
+ */
+void pwmout_apply_group(pwmout_t **objs, const int *pulsewidths_us, int count);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -37,12 +37,25 @@ typedef uint32_t timestamp_t;
  */
 typedef uint64_t us_timestamp_t;
 
+/** Number of express levels layered over the event list.
+ *
+ * The event queue is a skip list: the full set of events is kept sorted in
+ * the singly linked list threaded through 'next', and up to this many
+ * sparser express lists are layered on top of it so insertion can locate
+ * its spot in O(log n) expected steps instead of walking every event.
+ * Three levels with a 1/4 promotion rate cover queues of several hundred
+ * events.
+ */
+#define TICKER_EVENT_SKIP_LEVELS 3
+
 /** Ticker's event structure
  */
 typedef struct ticker_event_s {
     us_timestamp_t         timestamp; /**< Event's timestamp */
     uint32_t               id;        /**< TimerEvent object */
     struct ticker_event_s *next;      /**< Next event in the queue */
+    struct ticker_event_s *skip[TICKER_EVENT_SKIP_LEVELS]; /**< Next event at each express level */
+    uint8_t                level;     /**< Number of express levels this event is linked at */
 } ticker_event_t;
 
 typedef void (*ticker_event_handler)(uint32_t id);
@@ -72,6 +85,7 @@ typedef struct {
 typedef struct {
     ticker_event_handler event_handler; /**< Event handler */
     ticker_event_t *head;               /**< A pointer to head */
+    ticker_event_t *skip_head[TICKER_EVENT_SKIP_LEVELS]; /**< Head of each express level */
     uint32_t frequency;                 /**< Frequency of the timer in Hz */
     uint32_t bitmask;                   /**< Mask to be applied to time values read */
     uint32_t max_delta;                 /**< Largest delta in ticks that can be used when scheduling */
@@ -79,6 +93,7 @@ typedef struct {
     uint32_t tick_last_read;            /**< Last tick read */
     uint64_t tick_remainder;            /**< Ticks that have not been added to base_time */
     us_timestamp_t present_time;        /**< Store the timestamp used for present time */
+    volatile uint32_t seq;              /**< Sequence counter, odd while the time state above is rewritten */
     bool initialized;                   /**< Indicate if the instance is initialized */
 } ticker_event_queue_t;
 
@@ -60,6 +60,7 @@
 #include "drivers/AnalogIn.h"
 #include "drivers/AnalogOut.h"
 #include "drivers/PwmOut.h"
+#include "drivers/PwmGroup.h"
 #include "drivers/Serial.h"
 #include "drivers/SPI.h"
 #include "drivers/SPISlave.h"
@@ -70,11 +71,13 @@
 #include "drivers/RawSerial.h"
 #include "drivers/UARTSerial.h"
 #include "drivers/FlashIAP.h"
+#include "drivers/CRC.h"
 
 // mbed Internal components
 #include "drivers/Timer.h"
 #include "drivers/Ticker.h"
 #include "drivers/Timeout.h"
+#include "drivers/TimeoutPool.h"
 #include "drivers/LowPowerTimeout.h"
 #include "drivers/LowPowerTicker.h"
 #include "drivers/LowPowerTimer.h"
@@ -20,7 +20,10 @@
 
 #include "ATCmdParser.h"
 #include "mbed_poll.h"
+#include <new>
 #include "mbed_debug.h"
+#include "mbed_critical.h"
+#include "events/EventQueue.h"
 
 #ifdef LF
 #undef LF
@@ -53,6 +56,12 @@ int ATCmdParser::putc(char c)
 
 int ATCmdParser::getc()
 {
+    // Bytes a dispatch pass pulled from the file handle but did not
+    // consume are handed back before touching the stream again
+    if (_pb_head != _pb_tail) {
+        return (unsigned char)_pushback[_pb_head++];
+    }
+
     pollfh fhs;
     fhs.fh = _fh;
     fhs.events = POLLIN;
@@ -68,6 +77,7 @@ int ATCmdParser::getc()
 
 void ATCmdParser::flush()
 {
+    _pb_head = _pb_tail = 0;
     while (_fh->readable()) {
         unsigned char ch;
         _fh->read(&ch, 1);
@@ -78,13 +88,23 @@ void ATCmdParser::flush()
 // read/write handling with timeouts
 int ATCmdParser::write(const char *data, int size)
 {
-    int i = 0;
-    for ( ; i < size; i++) {
-        if (putc(data[i]) < 0) {
+    pollfh fhs;
+    fhs.fh = _fh;
+    fhs.events = POLLOUT;
+
+    int written = 0;
+    while (written < size) {
+        int count = poll(&fhs, 1, _timeout);
+        if (count <= 0 || !(fhs.revents & POLLOUT)) {
+            return -1;
+        }
+        ssize_t ret = _fh->write(data + written, size - written);
+        if (ret <= 0) {
             return -1;
         }
+        written += ret;
     }
-    return i;
+    return written;
 }
 
 int ATCmdParser::read(char *data, int size)
@@ -104,18 +124,12 @@ int ATCmdParser::read(char *data, int size)
 // printf/scanf handling
 int ATCmdParser::vprintf(const char *format, va_list args)
 {
-
-    if (vsprintf(_buffer, format, args) < 0) {
+    int len = vsprintf(_buffer, format, args);
+    if (len < 0) {
         return false;
     }
 
-    int i = 0;
-    for ( ; _buffer[i]; i++) {
-        if (putc(_buffer[i]) < 0) {
-            return -1;
-        }
-    }
-    return i;
+    return write(_buffer, len);
 }
 
 int ATCmdParser::vscanf(const char *format, va_list args)
@@ -183,25 +197,70 @@ int ATCmdParser::vscanf(const char *format, va_list args)
 // Command parsing with line handling
 bool ATCmdParser::vsend(const char *command, va_list args)
 {
-    // Create and send command
-    if (vsprintf(_buffer, command, args) < 0) {
+    // Create the command in the working buffer
+    int len = vsprintf(_buffer, command, args);
+    if (len < 0 || len + _output_delim_size > _buffer_size) {
         return false;
     }
 
-    for (int i = 0; _buffer[i]; i++) {
-        if (putc(_buffer[i]) < 0) {
-            return false;
-        }
+    // Append the newline and hand the whole command to the file handle
+    // in a single write instead of a putc per byte
+    memcpy(_buffer + len, _output_delimiter, _output_delim_size);
+
+    if (write(_buffer, len + _output_delim_size) != len + _output_delim_size) {
+        return false;
     }
 
-    // Finish with newline
-    for (size_t i = 0; _output_delimiter[i]; i++) {
-        if (putc(_output_delimiter[i]) < 0) {
+    _buffer[len] = 0;
+    debug_if(_dbg_on, "AT> %s\n", _buffer);
+    return true;
+}
+
+int ATCmdParser::vsend_pipelined(const char *expected, const char *command, va_list args)
+{
+    if (_pl_count >= sizeof(_pipeline) / sizeof(_pipeline[0])) {
+        return -1;
+    }
+
+    if (!vsend(command, args)) {
+        return -1;
+    }
+
+    _pipeline[(_pl_head + _pl_count) % (sizeof(_pipeline) / sizeof(_pipeline[0]))] = expected;
+    _pl_count++;
+    return ++_pl_tag;
+}
+
+bool ATCmdParser::pipeline_match(const char *response, ...)
+{
+    // Varargs trampoline so the stored expectation can be handed to
+    // vrecv with a valid (if empty) argument list
+    va_list args;
+    va_start(args, response);
+    bool res = vrecv(response, args);
+    va_end(args);
+    return res;
+}
+
+bool ATCmdParser::pipeline_wait(int tag)
+{
+    if (tag < 0 || tag > _pl_tag) {
+        tag = _pl_tag;
+    }
+
+    // The oldest outstanding command carries tag _pl_tag - _pl_count + 1
+    while (_pl_count && (_pl_tag - _pl_count) < tag) {
+        if (!pipeline_match(_pipeline[_pl_head])) {
+            // The modem and the pipeline are out of sync; drop the
+            // remaining expectations to return to lockstep operation
+            _pl_head = 0;
+            _pl_count = 0;
             return false;
         }
+        _pl_head = (_pl_head + 1) % (sizeof(_pipeline) / sizeof(_pipeline[0]));
+        _pl_count--;
     }
 
-    debug_if(_dbg_on, "AT> %s\n", _buffer);
     return true;
 }
 
@@ -356,6 +415,15 @@ bool ATCmdParser::send(const char *command, ...)
     return res;
 }
 
+int ATCmdParser::send_pipelined(const char *expected, const char *command, ...)
+{
+    va_list args;
+    va_start(args, command);
+    int res = vsend_pipelined(expected, command, args);
+    va_end(args);
+    return res;
+}
+
 bool ATCmdParser::recv(const char *response, ...)
 {
     va_list args;
@@ -368,12 +436,43 @@ bool ATCmdParser::recv(const char *response, ...)
 // oob registration
 void ATCmdParser::oob(const char *prefix, Callback<void()> cb)
 {
-    struct oob *oob = new struct oob;
+    struct oob *oob;
+    if (_arena) {
+        void *mem = mbed_arena_alloc(_arena, sizeof(struct oob));
+        MBED_ASSERT(mem != NULL);
+        oob = new (mem) struct oob;
+    } else {
+        oob = new struct oob;
+    }
     oob->len = strlen(prefix);
     oob->prefix = prefix;
     oob->cb = cb;
     oob->next = _oobs;
     _oobs = oob;
+
+    // Keep the dispatch-mode matcher current: record the first byte for
+    // the line filter and make sure the staging area fits the prefix
+    unsigned char first = prefix[0];
+    _oob_first[first >> 5] |= 1UL << (first & 31);
+
+    if (oob->len > _oob_match_size) {
+        char *match;
+        if (_arena) {
+            // The outgrown staging area is left in the arena until reset
+            match = (char *)mbed_arena_alloc(_arena, oob->len);
+            MBED_ASSERT(match != NULL);
+        } else {
+            match = new char[oob->len];
+        }
+        if (_oob_match) {
+            memcpy(match, _oob_match, _oob_match_size);
+            if (!_arena) {
+                delete[] _oob_match;
+            }
+        }
+        _oob_match = match;
+        _oob_match_size = oob->len;
+    }
 }
 
 void ATCmdParser::abort()
@@ -420,4 +519,116 @@ bool ATCmdParser::process_oob()
     }
 }
 
+// Event-driven oob dispatch
+void ATCmdParser::set_oob_dispatch(events::EventQueue *queue)
+{
+    if (_oob_queue == queue) {
+        return;
+    }
+
+    _oob_queue = queue;
+    _oob_match_len = 0;
+    _oob_discard = false;
+
+    if (queue) {
+        // sigio fires immediately if data is already pending
+        _fh->sigio(mbed::callback(this, &ATCmdParser::oob_readable));
+    } else {
+        _fh->sigio(NULL);
+    }
+}
+
+void ATCmdParser::oob_readable()
+{
+    // May run in interrupt context; keep at most one dispatch in flight
+    uint8_t expected = 0;
+    if (!core_util_atomic_cas_u8((uint8_t *)&_oob_pending, &expected, 1)) {
+        return;
+    }
+
+    if (!_oob_queue->call(this, &ATCmdParser::dispatch_oob)) {
+        _oob_pending = 0;
+    }
+}
+
+int ATCmdParser::oob_getc()
+{
+    // Refill the staging buffer in bulk; everything left over when
+    // dispatch stops is consumed by getc before the stream is touched
+    if (_pb_head == _pb_tail) {
+        if (!_fh->readable()) {
+            return -1;
+        }
+
+        ssize_t read = _fh->read(_pushback, sizeof(_pushback));
+        if (read <= 0) {
+            return -1;
+        }
+
+        _pb_head = 0;
+        _pb_tail = read;
+    }
+
+    return (unsigned char)_pushback[_pb_head++];
+}
+
+void ATCmdParser::dispatch_oob()
+{
+    // Clear before draining so a sigio racing with us queues a new pass
+    _oob_pending = 0;
+
+    int c;
+    while ((c = oob_getc()) >= 0) {
+        if (c == LF || c == CR) {
+            _oob_match_len = 0;
+            _oob_discard = false;
+            continue;
+        }
+
+        if (_oob_discard) {
+            continue;
+        }
+
+        // Lines whose first byte starts no registered prefix are skipped
+        // without walking the oob list at all
+        if (_oob_match_len == 0 &&
+                !(_oob_first[(unsigned char)c >> 5] & (1UL << (c & 31)))) {
+            _oob_discard = true;
+            continue;
+        }
+
+        if (_oob_match_len >= _oob_match_size) {
+            _oob_discard = true;
+            continue;
+        }
+        _oob_match[_oob_match_len++] = c;
+
+        // Check for oob data
+        bool alive = false;
+        for (struct oob *oob = _oobs; oob; oob = oob->next) {
+            if (_oob_match_len > oob->len ||
+                    memcmp(oob->prefix, _oob_match, _oob_match_len) != 0) {
+                continue;
+            }
+
+            if (_oob_match_len == oob->len) {
+                debug_if(_dbg_on, "AT! %s\r\n", oob->prefix);
+                // The callback may consume the rest of the line through
+                // read/recv; unconsumed staged bytes are replayed by getc
+                _oob_match_len = 0;
+                oob->cb();
+                alive = true;
+                break;
+            }
+
+            alive = true;
+        }
+
+        if (!alive) {
+            _oob_discard = true;
+            _oob_match_len = 0;
+        }
+    }
+}
+
 
@@ -23,6 +23,11 @@
 #include "mbed.h"
 #include <cstdarg>
 #include "Callback.h"
+#include "platform/mbed_arena.h"
+
+namespace events {
+class EventQueue;
+}
 
 /**
  * Parser class for parsing AT commands
@@ -71,6 +76,37 @@ private:
     };
     oob *_oobs;
 
+    // Event-driven oob dispatch
+    events::EventQueue *_oob_queue;
+    uint32_t _oob_first[8];     // bitmap of first bytes of registered prefixes
+    char *_oob_match;           // staging for the prefix being matched
+    unsigned _oob_match_size;
+    unsigned _oob_match_len;
+    bool _oob_discard;          // rest of current line cannot match any prefix
+    volatile uint8_t _oob_pending;
+
+    // Staging buffer for bulk reads; bytes a dispatch pass pulled from the
+    // file handle but did not consume are handed back through getc
+    char _pushback[32];
+    uint8_t _pb_head;
+    uint8_t _pb_tail;
+
+    // Arena backing the working buffer and oob registrations, or NULL
+    // when they come from the heap
+    mbed_arena_t *_arena;
+
+    // Expected responses of pipelined commands whose replies have not
+    // been collected yet, oldest first
+    const char *_pipeline[8];
+    uint8_t _pl_head;
+    uint8_t _pl_count;
+    int _pl_tag;
+
+    int oob_getc();
+    void oob_readable();
+    void dispatch_oob();
+    bool pipeline_match(const char *response, ...);
+
 public:
 
     /**
@@ -84,9 +120,45 @@ public:
      */
     ATCmdParser(FileHandle *fh, const char *output_delimiter = "\r",
              int buffer_size = 256, int timeout = 8000, bool debug = false)
-            : _fh(fh), _buffer_size(buffer_size), _in_prev(0), _oobs(NULL)
+            : _fh(fh), _buffer_size(buffer_size), _in_prev(0), _oobs(NULL),
+              _oob_queue(NULL), _oob_match(NULL), _oob_match_size(0),
+              _oob_match_len(0), _oob_discard(false), _oob_pending(0),
+              _pb_head(0), _pb_tail(0), _arena(NULL),
+              _pl_head(0), _pl_count(0), _pl_tag(0)
     {
         _buffer = new char[buffer_size];
+        memset(_oob_first, 0, sizeof(_oob_first));
+        set_timeout(timeout);
+        set_delimiter(output_delimiter);
+        debug_on(debug);
+    }
+
+    /**
+     * Constructor taking an arena to allocate from
+     *
+     * The working buffer and oob registrations are carved from the arena
+     * instead of the heap, so the parser allocates nothing in steady
+     * state. The arena must outlive the parser and must not be reset
+     * while the parser is in use.
+     *
+     * @param fh A FileHandle to a digital interface to use for AT commands
+     * @param arena arena backing the parser's allocations
+     * @param output_delimiter end of command line termination
+     * @param buffer_size size of internal buffer for transaction
+     * @param timeout timeout of the connection
+     * @param debug turns on/off debug output for AT commands
+     */
+    ATCmdParser(FileHandle *fh, mbed_arena_t *arena, const char *output_delimiter = "\r",
+             int buffer_size = 256, int timeout = 8000, bool debug = false)
+            : _fh(fh), _buffer_size(buffer_size), _in_prev(0), _oobs(NULL),
+              _oob_queue(NULL), _oob_match(NULL), _oob_match_size(0),
+              _oob_match_len(0), _oob_discard(false), _oob_pending(0),
+              _pb_head(0), _pb_tail(0), _arena(arena),
+              _pl_head(0), _pl_count(0), _pl_tag(0)
+    {
+        _buffer = (char *)mbed_arena_alloc(_arena, buffer_size);
+        MBED_ASSERT(_buffer != NULL);
+        memset(_oob_first, 0, sizeof(_oob_first));
         set_timeout(timeout);
         set_delimiter(output_delimiter);
         debug_on(debug);
@@ -97,12 +169,20 @@ public:
      */
     ~ATCmdParser()
     {
+        set_oob_dispatch(NULL);
         while (_oobs) {
             struct oob *oob = _oobs;
             _oobs = oob->next;
-            delete oob;
+            if (_arena) {
+                oob->~oob();
+            } else {
+                delete oob;
+            }
+        }
+        if (!_arena) {
+            delete[] _oob_match;
+            delete[] _buffer;
         }
-        delete[] _buffer;
     }
 
     /**
@@ -192,6 +272,57 @@ public:
 
     bool vsend(const char *command, va_list args);
 
+    /**
+     * Send an AT command without waiting for its response
+     *
+     * The command is written out immediately and the expected response is
+     * queued, so the modem processes one command while the next one is
+     * still being transmitted. Responses are collected in order by
+     * pipeline_wait(). AT modems answer commands in the order they were
+     * received, so FIFO matching is sufficient.
+     *
+     * The expected response is matched like a recv() format string but
+     * must not extract any values (%% and %* conversions are allowed) and
+     * must stay valid until it has been collected - a string literal in
+     * practice.
+     *
+     * @param expected recv-style format string the response must match
+     * @param command printf-like format string of command to send which
+     *                is appended with a newline
+     * @param ... all printf-like arguments to insert into command
+     * @return tag identifying the queued command, or -1 if the pipeline
+     *         is full or the command could not be sent
+     */
+    int send_pipelined(const char *expected, const char *command, ...) MBED_PRINTF_METHOD(2,3);
+
+    int vsend_pipelined(const char *expected, const char *command, va_list args);
+
+    /**
+     * Collect responses of pipelined commands
+     *
+     * Receives and matches the expected responses of commands queued with
+     * send_pipelined(), oldest first, up to and including the given tag.
+     * On a mismatch or timeout the remaining expectations are dropped, as
+     * the modem and the pipeline are no longer in lockstep.
+     *
+     * Call with the default argument to drain the whole pipeline; this
+     * must be done before using plain recv(), which would otherwise
+     * consume the pipelined responses.
+     *
+     * @param tag tag returned by send_pipelined(), or -1 to wait for all
+     *            outstanding responses
+     * @return true only if all collected responses matched
+     */
+    bool pipeline_wait(int tag = -1);
+
+    /**
+     * Number of pipelined commands whose responses are outstanding
+     */
+    int pipeline_depth()
+    {
+        return _pl_count;
+    }
+
     /**
      * Receive an AT response
      *
@@ -276,6 +407,25 @@ public:
      */
     void oob(const char *prefix, mbed::Callback<void()> func);
 
+    /**
+     * Dispatch out-of-band data through an event queue
+     *
+     * Attaches the parser to the file handle's sigio and drains incoming
+     * data in bulk chunks from the event queue, so unsolicited lines are
+     * matched and their oob callbacks invoked without a thread blocked in
+     * recv or process_oob and without per-character reads. Lines whose
+     * first byte matches no registered prefix are skipped outright.
+     *
+     * Callbacks run on the queue's dispatch thread and may read the rest
+     * of the line with read/recv as usual. Commands must be sent from
+     * that same thread (typically by posting them to the queue) so they
+     * do not race with dispatch.
+     *
+     * @param queue event queue to dispatch from, NULL to detach and
+     *              return to blocking-mode oob processing
+     */
+    void set_oob_dispatch(events::EventQueue *queue);
+
     /**
      * Flushes the underlying stream
      */
@@ -0,0 +1,105 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2014-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/CThunk.h"
+#include "platform/mbed_critical.h"
+
+CThunkBase* volatile CThunkBase::s_pool[MBED_CONF_PLATFORM_CTHUNK_POOL_SIZE];
+
+/* Each pre-generated trampoline is tied to its pool slot at compile time;
+ * the indirection through the slot is what makes the code immutable. */
+void CThunkBase::trampoline_0(void) { pool_dispatch(0); }
+void CThunkBase::trampoline_1(void) { pool_dispatch(1); }
+void CThunkBase::trampoline_2(void) { pool_dispatch(2); }
+void CThunkBase::trampoline_3(void) { pool_dispatch(3); }
+void CThunkBase::trampoline_4(void) { pool_dispatch(4); }
+void CThunkBase::trampoline_5(void) { pool_dispatch(5); }
+void CThunkBase::trampoline_6(void) { pool_dispatch(6); }
+void CThunkBase::trampoline_7(void) { pool_dispatch(7); }
+void CThunkBase::trampoline_8(void) { pool_dispatch(8); }
+void CThunkBase::trampoline_9(void) { pool_dispatch(9); }
+void CThunkBase::trampoline_10(void) { pool_dispatch(10); }
+void CThunkBase::trampoline_11(void) { pool_dispatch(11); }
+void CThunkBase::trampoline_12(void) { pool_dispatch(12); }
+void CThunkBase::trampoline_13(void) { pool_dispatch(13); }
+void CThunkBase::trampoline_14(void) { pool_dispatch(14); }
+void CThunkBase::trampoline_15(void) { pool_dispatch(15); }
+
+const CThunkEntry CThunkBase::s_entries[CTHUNK_POOL_MAX] = {
+    &CThunkBase::trampoline_0,
+    &CThunkBase::trampoline_1,
+    &CThunkBase::trampoline_2,
+    &CThunkBase::trampoline_3,
+    &CThunkBase::trampoline_4,
+    &CThunkBase::trampoline_5,
+    &CThunkBase::trampoline_6,
+    &CThunkBase::trampoline_7,
+    &CThunkBase::trampoline_8,
+    &CThunkBase::trampoline_9,
+    &CThunkBase::trampoline_10,
+    &CThunkBase::trampoline_11,
+    &CThunkBase::trampoline_12,
+    &CThunkBase::trampoline_13,
+    &CThunkBase::trampoline_14,
+    &CThunkBase::trampoline_15
+};
+
+CThunkBase::CThunkBase() : m_dispatch(NULL), m_pool_index(-1)
+{
+}
+
+CThunkBase::~CThunkBase()
+{
+    pool_release();
+}
+
+CThunkEntry CThunkBase::pool_claim(CThunkDispatch dispatch)
+{
+    m_dispatch = dispatch;
+    if (m_pool_index >= 0) {
+        return s_entries[m_pool_index];
+    }
+    core_util_critical_section_enter();
+    for (int i = 0; i < MBED_CONF_PLATFORM_CTHUNK_POOL_SIZE; i++) {
+        if (s_pool[i] == NULL) {
+            s_pool[i] = this;
+            m_pool_index = i;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+    return (m_pool_index >= 0) ? s_entries[m_pool_index] : NULL;
+}
+
+void CThunkBase::pool_release(void)
+{
+    if (m_pool_index >= 0) {
+        s_pool[m_pool_index] = NULL;
+        m_pool_index = -1;
+    }
+}
+
+void CThunkBase::pool_dispatch(unsigned int index)
+{
+    CThunkBase *thunk = s_pool[index];
+    if (thunk && thunk->m_dispatch) {
+        thunk->m_dispatch(thunk);
+    }
+}
+
+void CThunkBase::call_dispatch(CThunkBase *thunk)
+{
+    thunk->m_dispatch(thunk);
+}
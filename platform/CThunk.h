@@ -34,9 +34,28 @@
 #ifndef __CTHUNK_H__
 #define __CTHUNK_H__
 
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/mbed_assert.h"
+
 #define CTHUNK_ADDRESS 1
 #define CTHUNK_VARIABLES volatile uint32_t code[2]
 
+/* Binding prefers a pre-generated trampoline from a const flash pool: the
+ * trampoline code never changes, so claiming one is a couple of data writes
+ * with no cache maintenance, and it executes from flash, which keeps it
+ * compatible with execute-never RAM policies. Only when the pool is
+ * exhausted is a trampoline synthesized in RAM the old way. */
+#ifndef MBED_CONF_PLATFORM_CTHUNK_POOL_SIZE
+#define MBED_CONF_PLATFORM_CTHUNK_POOL_SIZE 8
+#endif
+
+#define CTHUNK_POOL_MAX 16
+
+#if MBED_CONF_PLATFORM_CTHUNK_POOL_SIZE > CTHUNK_POOL_MAX
+#error "cthunk-pool-size must not exceed 16"
+#endif
+
 #if (defined(__CORTEX_M3) || defined(__CORTEX_M4) || defined(__CORTEX_M7) || defined(__CORTEX_A9) \
     || defined(__CORTEX_M23) || defined(__CORTEX_M33))
 /**
@@ -54,6 +73,7 @@
                              m_thunk.code[0] = 0xE890A001; \
                              m_thunk.code[1] = 0x00008007; \
                          } while (0)
+#define CTHUNK_RAM_TRAMPOLINE 1
 
 #elif (defined(__CORTEX_M0PLUS) || defined(__CORTEX_M0))
 /*
@@ -66,15 +86,71 @@
                              m_thunk.code[0] = 0xC80FA001; \
                              m_thunk.code[1] = 0x00004718; \
                          } while (0)
+#define CTHUNK_RAM_TRAMPOLINE 1
 
 #else
-#error "Target is not currently suported."
+/* No RAM trampoline encoding for this core: binding beyond the flash pool
+ * is not possible. */
+#define CTHUNK_RAM_TRAMPOLINE 0
 #endif
 
 /* IRQ/Exception compatible thunk entry function */
 typedef void (*CThunkEntry)(void);
 /** @}*/
 
+/**
+ * Non-template part of CThunk: the pool of pre-generated flash trampolines
+ *
+ * @note Synchronization level: Interrupt safe
+ * @ingroup platform
+ */
+class CThunkBase
+{
+    protected:
+        typedef void (*CThunkDispatch)(CThunkBase* thunk);
+
+        CThunkBase();
+        ~CThunkBase();
+
+        /* Claim a flash trampoline and point it at this thunk.
+         * Returns the trampoline's entry, or NULL if the pool is exhausted. */
+        CThunkEntry pool_claim(CThunkDispatch dispatch);
+
+        /* Return this thunk's trampoline to the pool */
+        void pool_release(void);
+
+        /* Forward a RAM-synthesized trampoline into the dispatcher */
+        static void call_dispatch(CThunkBase* thunk);
+
+        CThunkDispatch m_dispatch;
+        int m_pool_index;
+
+    private:
+        static void pool_dispatch(unsigned int index);
+
+        static void trampoline_0(void);
+        static void trampoline_1(void);
+        static void trampoline_2(void);
+        static void trampoline_3(void);
+        static void trampoline_4(void);
+        static void trampoline_5(void);
+        static void trampoline_6(void);
+        static void trampoline_7(void);
+        static void trampoline_8(void);
+        static void trampoline_9(void);
+        static void trampoline_10(void);
+        static void trampoline_11(void);
+        static void trampoline_12(void);
+        static void trampoline_13(void);
+        static void trampoline_14(void);
+        static void trampoline_15(void);
+
+        /* Thunk owning each pool slot, NULL when the slot is free */
+        static CThunkBase* volatile s_pool[MBED_CONF_PLATFORM_CTHUNK_POOL_SIZE];
+        /* Entry points of the pre-generated trampolines, lives in flash */
+        static const CThunkEntry s_entries[CTHUNK_POOL_MAX];
+};
+
 /**
  * Class for created a pointer with data bound to it
  *
@@ -82,7 +158,7 @@ typedef void (*CThunkEntry)(void);
  * @ingroup platform
  */
 template<class T>
-class CThunk
+class CThunk : private CThunkBase
 {
     public:
         typedef void (T::*CCallbackSimple)(void);
@@ -134,22 +210,33 @@ class CThunk
 
         inline void context(void* context)
         {
-            m_thunk.context = (uint32_t)context;
+            m_context = context;
         }
 
         inline void context(uint32_t context)
         {
-            m_thunk.context = context;
+            m_context = (void*)(uintptr_t)context;
         }
-        
+
         inline uint32_t entry(void)
         {
+            if (m_entry != NULL) {
+                /* function pointer already carries the thumb bit */
+                return (uint32_t)(uintptr_t)m_entry;
+            }
+#if CTHUNK_RAM_TRAMPOLINE
             return (((uint32_t)&m_thunk)|CTHUNK_ADDRESS);
+#else
+            return 0;
+#endif
         }
 
         /* get thunk entry point for connecting rhunk to an IRQ table */
         inline operator CThunkEntry(void)
         {
+            if (m_entry != NULL) {
+                return m_entry;
+            }
             return (CThunkEntry)entry();
         }
 
@@ -162,13 +249,28 @@ class CThunk
         /* simple test function */
         inline void call(void)
         {
-            (((CThunkEntry)(entry()))());
+            ((CThunkEntry)(*this))();
         }
 
     private:
         T* m_instance;
+        void* m_context;
         volatile CCallback m_callback;
+        CThunkEntry m_entry;
 
+        /* Typed dispatcher: both the flash pool and the RAM fallback route
+         * through this with the thunk itself as the only argument */
+        static void dispatch(CThunkBase* thunk)
+        {
+            CThunk* self = static_cast<CThunk*>(thunk);
+            T* instance = self->m_instance;
+            CCallback callback = self->m_callback;
+            if(instance && callback) {
+                (instance->*callback)(self->m_context);
+            }
+        }
+
+#if CTHUNK_RAM_TRAMPOLINE
 // TODO: this needs proper fix, to refactor toolchain header file and all its use
 // PACKED there is not defined properly for IAR
 #if defined (__ICCARM__)
@@ -191,27 +293,29 @@ class CThunk
         } __attribute__((__packed__)) CThunkTrampoline;
 #endif
 
-        static void trampoline(T* instance, void* context, CCallback* callback)
-        {
-            if(instance && *callback) {
-                (static_cast<T*>(instance)->**callback)(context);
-            }
-        }
-
         volatile CThunkTrampoline m_thunk;
+#endif
 
         inline void init(T *instance, CCallback callback, void* context)
         {
-            /* remember callback - need to add this level of redirection
-               as pointer size for member functions differs between platforms */
+            m_instance = instance;
             m_callback = callback;
+            m_context = context;
 
-            /* populate thunking trampoline */
+            /* a pooled trampoline is plain data binding: no code is written,
+               no cache maintenance is needed */
+            m_entry = pool_claim(&CThunk::dispatch);
+            if (m_entry != NULL) {
+                return;
+            }
+
+#if CTHUNK_RAM_TRAMPOLINE
+            /* pool exhausted: synthesize the trampoline in RAM */
             CTHUNK_ASSIGMENT;
-            m_thunk.context = (uint32_t)context;
-            m_thunk.instance = (uint32_t)instance;
-            m_thunk.callback = (uint32_t)&m_callback;
-            m_thunk.trampoline = (uint32_t)&trampoline;
+            m_thunk.instance = (uint32_t)static_cast<CThunkBase*>(this);
+            m_thunk.context = 0;
+            m_thunk.callback = 0;
+            m_thunk.trampoline = (uint32_t)&call_dispatch;
 
 #if defined(__CORTEX_A9)
             /* Data cache clean */
@@ -220,7 +324,7 @@ class CThunk
                 uint32_t start_addr = (uint32_t)&m_thunk & 0xFFFFFFE0;
                 uint32_t end_addr   = (uint32_t)&m_thunk + sizeof(m_thunk);
                 uint32_t addr;
-                
+
                 /* Data cache clean and invalid */
                 for (addr = start_addr; addr < end_addr; addr += 0x20) {
                     __v7_clean_inv_dcache_mva((void *)addr);
@@ -240,6 +344,10 @@ class CThunk
 #endif
             __ISB();
             __DSB();
+#else
+            /* no RAM trampoline encoding for this core */
+            MBED_ASSERT(m_entry != NULL);
+#endif
         }
 };
 
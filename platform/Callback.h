@@ -91,6 +91,7 @@ public:
             func._ops->move(this, &func);
         }
         _ops = func._ops;
+        _call = func._call;
     }
 
     /** Create a Callback with a member function
@@ -523,8 +524,8 @@ public:
     /** Call the attached function
      */
     R call() const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this);
+        MBED_ASSERT(_call);
+        return _call(this);
     }
 
     /** Call the attached function
@@ -574,25 +575,29 @@ private:
 
     // Dynamically dispatched operations
     const struct ops {
-        R (*call)(const void*);
         void (*move)(void*, const void*);
         void (*dtor)(void*);
     } *_ops;
 
+    // Direct pointer to the attached type's call thunk. Invocation
+    // loads this and the stored target, skipping the ops table that
+    // copy and destruction still dispatch through.
+    R (*_call)(const void*);
+
     // Generate operations for function object
     template <typename F>
     void generate(const F &f) {
         static const ops ops = {
-            &Callback::function_call<F>,
             &Callback::function_move<F>,
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) - sizeof(_call) >= sizeof(F),
                 "Type F must not exceed the size of the Callback class");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
+        _call = &Callback::function_call<F>;
     }
 
     // Function attributes
@@ -666,6 +671,7 @@ public:
             func._ops->move(this, &func);
         }
         _ops = func._ops;
+        _call = func._call;
     }
 
     /** Create a Callback with a member function
@@ -1098,8 +1104,8 @@ public:
     /** Call the attached function
      */
     R call(A0 a0) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0);
+        MBED_ASSERT(_call);
+        return _call(this, a0);
     }
 
     /** Call the attached function
@@ -1150,25 +1156,29 @@ private:
 
     // Dynamically dispatched operations
     const struct ops {
-        R (*call)(const void*, A0);
         void (*move)(void*, const void*);
         void (*dtor)(void*);
     } *_ops;
 
+    // Direct pointer to the attached type's call thunk. Invocation
+    // loads this and the stored target, skipping the ops table that
+    // copy and destruction still dispatch through.
+    R (*_call)(const void*, A0);
+
     // Generate operations for function object
     template <typename F>
     void generate(const F &f) {
         static const ops ops = {
-            &Callback::function_call<F>,
             &Callback::function_move<F>,
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) - sizeof(_call) >= sizeof(F),
                 "Type F must not exceed the size of the Callback class");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
+        _call = &Callback::function_call<F>;
     }
 
     // Function attributes
@@ -1242,6 +1252,7 @@ public:
             func._ops->move(this, &func);
         }
         _ops = func._ops;
+        _call = func._call;
     }
 
     /** Create a Callback with a member function
@@ -1674,8 +1685,8 @@ public:
     /** Call the attached function
      */
     R call(A0 a0, A1 a1) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0, a1);
+        MBED_ASSERT(_call);
+        return _call(this, a0, a1);
     }
 
     /** Call the attached function
@@ -1727,25 +1738,29 @@ private:
 
     // Dynamically dispatched operations
     const struct ops {
-        R (*call)(const void*, A0, A1);
         void (*move)(void*, const void*);
         void (*dtor)(void*);
     } *_ops;
 
+    // Direct pointer to the attached type's call thunk. Invocation
+    // loads this and the stored target, skipping the ops table that
+    // copy and destruction still dispatch through.
+    R (*_call)(const void*, A0, A1);
+
     // Generate operations for function object
     template <typename F>
     void generate(const F &f) {
         static const ops ops = {
-            &Callback::function_call<F>,
             &Callback::function_move<F>,
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) - sizeof(_call) >= sizeof(F),
                 "Type F must not exceed the size of the Callback class");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
+        _call = &Callback::function_call<F>;
     }
 
     // Function attributes
@@ -1819,6 +1834,7 @@ public:
             func._ops->move(this, &func);
         }
         _ops = func._ops;
+        _call = func._call;
     }
 
     /** Create a Callback with a member function
@@ -2251,8 +2267,8 @@ public:
     /** Call the attached function
      */
     R call(A0 a0, A1 a1, A2 a2) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0, a1, a2);
+        MBED_ASSERT(_call);
+        return _call(this, a0, a1, a2);
     }
 
     /** Call the attached function
@@ -2305,25 +2321,29 @@ private:
 
     // Dynamically dispatched operations
     const struct ops {
-        R (*call)(const void*, A0, A1, A2);
         void (*move)(void*, const void*);
         void (*dtor)(void*);
     } *_ops;
 
+    // Direct pointer to the attached type's call thunk. Invocation
+    // loads this and the stored target, skipping the ops table that
+    // copy and destruction still dispatch through.
+    R (*_call)(const void*, A0, A1, A2);
+
     // Generate operations for function object
     template <typename F>
     void generate(const F &f) {
         static const ops ops = {
-            &Callback::function_call<F>,
             &Callback::function_move<F>,
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) - sizeof(_call) >= sizeof(F),
                 "Type F must not exceed the size of the Callback class");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
+        _call = &Callback::function_call<F>;
     }
 
     // Function attributes
@@ -2397,6 +2417,7 @@ public:
             func._ops->move(this, &func);
         }
         _ops = func._ops;
+        _call = func._call;
     }
 
     /** Create a Callback with a member function
@@ -2829,8 +2850,8 @@ public:
     /** Call the attached function
      */
     R call(A0 a0, A1 a1, A2 a2, A3 a3) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0, a1, a2, a3);
+        MBED_ASSERT(_call);
+        return _call(this, a0, a1, a2, a3);
     }
 
     /** Call the attached function
@@ -2884,25 +2905,29 @@ private:
 
     // Dynamically dispatched operations
     const struct ops {
-        R (*call)(const void*, A0, A1, A2, A3);
         void (*move)(void*, const void*);
         void (*dtor)(void*);
     } *_ops;
 
+    // Direct pointer to the attached type's call thunk. Invocation
+    // loads this and the stored target, skipping the ops table that
+    // copy and destruction still dispatch through.
+    R (*_call)(const void*, A0, A1, A2, A3);
+
     // Generate operations for function object
     template <typename F>
     void generate(const F &f) {
         static const ops ops = {
-            &Callback::function_call<F>,
             &Callback::function_move<F>,
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) - sizeof(_call) >= sizeof(F),
                 "Type F must not exceed the size of the Callback class");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
+        _call = &Callback::function_call<F>;
     }
 
     // Function attributes
@@ -2976,6 +3001,7 @@ public:
             func._ops->move(this, &func);
         }
         _ops = func._ops;
+        _call = func._call;
     }
 
     /** Create a Callback with a member function
@@ -3408,8 +3434,8 @@ public:
     /** Call the attached function
      */
     R call(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0, a1, a2, a3, a4);
+        MBED_ASSERT(_call);
+        return _call(this, a0, a1, a2, a3, a4);
     }
 
     /** Call the attached function
@@ -3464,25 +3490,29 @@ private:
 
     // Dynamically dispatched operations
     const struct ops {
-        R (*call)(const void*, A0, A1, A2, A3, A4);
         void (*move)(void*, const void*);
         void (*dtor)(void*);
     } *_ops;
 
+    // Direct pointer to the attached type's call thunk. Invocation
+    // loads this and the stored target, skipping the ops table that
+    // copy and destruction still dispatch through.
+    R (*_call)(const void*, A0, A1, A2, A3, A4);
+
     // Generate operations for function object
     template <typename F>
     void generate(const F &f) {
         static const ops ops = {
-            &Callback::function_call<F>,
             &Callback::function_move<F>,
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) - sizeof(_call) >= sizeof(F),
                 "Type F must not exceed the size of the Callback class");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
+        _call = &Callback::function_call<F>;
     }
 
     // Function attributes
@@ -72,6 +72,58 @@ public:
         return data_popped;
     }
 
+    /** Get direct access to the contiguous region at the read position
+     *
+     *  Returns a pointer to the oldest element and the number of elements
+     *  readable without wrapping, so block consumers can memcpy or DMA
+     *  straight out of the ring and then release the region with pop_n().
+     *  The region stays valid as long as nothing pops and producers do not
+     *  push into a full buffer (a full-buffer push overwrites the tail).
+     *
+     * @param data Filled with a pointer to the contiguous region
+     * @return Number of elements readable at the pointer without wrapping
+     */
+    CounterType peek_contiguous(const T **data) const {
+        core_util_critical_section_enter();
+        CounterType len;
+        if ((_head == _tail) && !_full) {
+            len = 0;
+        } else if (_head > _tail) {
+            len = _head - _tail;
+        } else {
+            len = BufferSize - _tail;
+        }
+        *data = &_pool[_tail];
+        core_util_critical_section_exit();
+        return len;
+    }
+
+    /** Pop up to n elements from the buffer without copying them out
+     *
+     *  Releases elements previously examined through peek_contiguous().
+     *
+     * @param n Number of elements to discard from the read position
+     * @return Number of elements actually discarded
+     */
+    CounterType pop_n(CounterType n) {
+        core_util_critical_section_enter();
+        CounterType size;
+        if (_full) {
+            size = BufferSize;
+        } else {
+            size = (_head - _tail + BufferSize) % BufferSize;
+        }
+        if (n > size) {
+            n = size;
+        }
+        if (n > 0) {
+            _tail = (_tail + n) % BufferSize;
+            _full = false;
+        }
+        core_util_critical_section_exit();
+        return n;
+    }
+
     /** Check if the buffer is empty
      *
      * @return True if the buffer is empty, false if not
@@ -44,13 +44,13 @@ private:
 public:
     DeepSleepLock(): _lock_count(1)
     {
-        sleep_manager_lock_deep_sleep();
+        sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_APP);
     }
 
     ~DeepSleepLock()
     {
         if (_lock_count) {
-            sleep_manager_unlock_deep_sleep();
+            sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_APP);
         }
     }
 
@@ -60,7 +60,7 @@ public:
     {
         uint16_t count = core_util_atomic_incr_u16(&_lock_count, 1);
         if (1 == count) {
-            sleep_manager_lock_deep_sleep();
+            sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_APP);
         }
         if (0 == count) {
             error("DeepSleepLock overflow (> USHRT_MAX)");
@@ -73,7 +73,7 @@ public:
     {
         uint16_t count = core_util_atomic_decr_u16(&_lock_count, 1);
         if (count == 0) {
-            sleep_manager_unlock_deep_sleep();
+            sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_APP);
         }
         if (count == USHRT_MAX) {
             core_util_critical_section_exit();
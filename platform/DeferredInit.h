@@ -0,0 +1,106 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DEFERRED_INIT_CLASS_H
+#define MBED_DEFERRED_INIT_CLASS_H
+
+#include <stdint.h>
+#include <new>
+#include "platform/mbed_deferred_init.h"
+#include "platform/SingletonPtr.h"
+
+/** Utility class deferring a static object's constructor past boot
+ *
+ * Like SingletonPtr this is a POD wrapper, so declaring one at global
+ * scope costs nothing before main() - the wrapped constructor does not
+ * run at static initialization time, which is the point on parts where
+ * flash-wait-state constructor code dominates time-to-main.
+ *
+ * Unlike SingletonPtr the instance can also join the deferred
+ * initialization registry via register_lazy(), so a background call to
+ * mbed_deferred_init_run_all() constructs it during idle time and the
+ * first real use finds it already built.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * @note: This class must only be used in a static context -
+ * this class must never be allocated or created on the
+ * stack.
+ * @ingroup platform
+ */
+template <class T>
+struct DeferredInit {
+
+    /** Get a pointer to the underlying object, constructing it if needed
+     *
+     * @returns
+     *   A pointer to the object
+     */
+    T* get() {
+        T *p = _ptr;
+        if (NULL == p) {
+            p = init();
+        }
+        return p;
+    }
+
+    /** Get a pointer to the underlying object
+     *
+     * @returns
+     *   A pointer to the object
+     */
+    T* operator->() {
+        return get();
+    }
+
+    /** Add this instance to the deferred initialization registry
+     *
+     * Cheap enough to call during boot; construction then happens on
+     * first use or when mbed_deferred_init_run_all() runs, whichever
+     * comes first.
+     */
+    void register_lazy() {
+        _entry.fn = &DeferredInit::construct;
+        _entry.context = this;
+        mbed_deferred_init_register(&_entry);
+    }
+
+    /** Construction slow path, shared by get() and the registry */
+    T* init() {
+        singleton_lock();
+        if (NULL == _ptr) {
+            _ptr = new (_data) T();
+        }
+        T *p = _ptr;
+        singleton_unlock();
+        return p;
+    }
+
+    static void construct(void *self) {
+        ((DeferredInit *)self)->init();
+    }
+
+    // These are zero initialized when in global scope
+    mbed_deferred_init_t _entry;
+    T *_ptr;
+    // Force data to be 4 byte aligned
+    uint32_t _data[(sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
+};
+
+#endif
+
+/** @}*/
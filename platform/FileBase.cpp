@@ -20,16 +20,34 @@
 namespace mbed {
 
 FileBase *FileBase::_head = NULL;
+FileBase *FileBase::_hash_head[FileBase::HASH_BUCKETS] = { NULL };
+FileBase *FileBase::_lookup_cache = NULL;
 SingletonPtr<PlatformMutex> FileBase::_mutex;
 
+uint32_t FileBase::name_hash(const char *name, unsigned int len) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (unsigned int i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
 FileBase::FileBase(const char *name, PathType t) : _next(NULL),
+                                                   _hash_next(NULL),
                                                    _name(name),
+                                                   _name_len(name ? std::strlen(name) : 0),
+                                                   _name_hash(name ? name_hash(name, std::strlen(name)) : 0),
                                                    _path_type(t) {
     _mutex->lock();
     if (name != NULL) {
         // put this object at head of the list
         _next = _head;
         _head = this;
+        // and at the head of its name-hash chain
+        FileBase **bucket = &_hash_head[_name_hash % HASH_BUCKETS];
+        _hash_next = *bucket;
+        *bucket = this;
     } else {
         _next = NULL;
     }
@@ -49,6 +67,15 @@ FileBase::~FileBase() {
             }
             p->_next = _next;
         }
+        // and from its name-hash chain
+        FileBase **pp = &_hash_head[_name_hash % HASH_BUCKETS];
+        while (*pp != this) {
+            pp = &(*pp)->_hash_next;
+        }
+        *pp = _hash_next;
+        if (_lookup_cache == this) {
+            _lookup_cache = NULL;
+        }
     }
     _mutex->unlock();
 
@@ -59,15 +86,22 @@ FileBase::~FileBase() {
 }
 
 FileBase *FileBase::lookup(const char *name, unsigned int len) {
+    uint32_t hash = name_hash(name, len);
     _mutex->lock();
-    FileBase *p = _head;
-    while (p != NULL) {
-        /* Check that p->_name matches name and is the correct length */
-        if (p->_name != NULL && std::strncmp(p->_name, name, len) == 0 && std::strlen(p->_name) == len) {
+    /* Most lookups resolve to the same mount as the previous one, so try
+     * the last hit before walking a hash chain */
+    FileBase *p = _lookup_cache;
+    if (p != NULL && p->_name_hash == hash && p->_name_len == len && std::strncmp(p->_name, name, len) == 0) {
+        _mutex->unlock();
+        return p;
+    }
+    for (p = _hash_head[hash % HASH_BUCKETS]; p != NULL; p = p->_hash_next) {
+        /* The string compare only runs on a full hash and length match */
+        if (p->_name_hash == hash && p->_name_len == len && std::strncmp(p->_name, name, len) == 0) {
+            _lookup_cache = p;
             _mutex->unlock();
             return p;
         }
-        p = p->_next;
     }
     _mutex->unlock();
     return NULL;
@@ -20,6 +20,7 @@ typedef int FILEHANDLE;
 
 #include <cstdio>
 #include <cstring>
+#include <stdint.h>
 
 #include "platform/platform.h"
 #include "platform/SingletonPtr.h"
@@ -54,11 +55,21 @@ public:
 
     /* disallow copy constructor and assignment operators */
 private:
+    /* Number of chains in the name-hash registry used by lookup() */
+    static const unsigned int HASH_BUCKETS = 8;
+
+    static uint32_t name_hash(const char *name, unsigned int len);
+
     static FileBase *_head;
+    static FileBase *_hash_head[HASH_BUCKETS];
+    static FileBase *_lookup_cache;
     static SingletonPtr<PlatformMutex> _mutex;
 
     FileBase   *_next;
+    FileBase   *_hash_next;
     const char * const _name;
+    const unsigned int _name_len;
+    const uint32_t _name_hash;
     const PathType _path_type;
 };
 
@@ -16,6 +16,7 @@
 #include "FileHandle.h"
 #include "platform/mbed_retarget.h"
 #include "platform/mbed_critical.h"
+#include <errno.h>
 
 namespace mbed {
 
@@ -33,6 +34,47 @@ off_t FileHandle::size()
     return size;
 }
 
+ssize_t FileHandle::readv(const iovec_t *iov, int iovcnt)
+{
+    ssize_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t ret = read(iov[i].base, iov[i].len);
+        if (ret < 0) {
+            return total > 0 ? total : ret;
+        }
+        total += ret;
+        if ((size_t)ret < iov[i].len) {
+            break;
+        }
+    }
+    return total;
+}
+
+ssize_t FileHandle::writev(const iovec_t *iov, int iovcnt)
+{
+    ssize_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t ret = write(iov[i].base, iov[i].len);
+        if (ret < 0) {
+            return total > 0 ? total : ret;
+        }
+        total += ret;
+        if ((size_t)ret < iov[i].len) {
+            break;
+        }
+    }
+    return total;
+}
+
+ssize_t FileHandle::read_borrow(const void **buffer)
+{
+    return -ENOSYS;
+}
+
+void FileHandle::read_release(size_t size)
+{
+}
+
 std::FILE *fdopen(FileHandle *fh, const char *mode)
 {
     return mbed_fdopen(fh, mode);
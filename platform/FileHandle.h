@@ -27,6 +27,13 @@ typedef int FILEHANDLE;
 namespace mbed {
 /** \addtogroup platform */
 
+/** An I/O vector: one contiguous piece of a vectored transfer
+ * @ingroup platform
+ */
+struct iovec_t {
+    void *base;    /**< Start of the piece */
+    size_t len;    /**< Length of the piece in bytes */
+};
 
 /** Class FileHandle
  *
@@ -64,6 +71,56 @@ public:
      */
     virtual ssize_t write(const void *buffer, size_t size) = 0;
 
+    /** Read the contents of a file into multiple buffers
+     *
+     *  The vector is filled in order; semantics otherwise follow read().
+     *  The default implementation issues one read() per piece - devices
+     *  able to gather data more cheaply should override it.
+     *
+     *  @param iov      Array of buffer pieces to read in to
+     *  @param iovcnt   The number of pieces in the array
+     *  @return         The total number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t readv(const iovec_t *iov, int iovcnt);
+
+    /** Write the contents of multiple buffers to a file
+     *
+     *  The pieces are written in order as if concatenated; semantics
+     *  otherwise follow write(). The default implementation issues one
+     *  write() per piece - devices able to scatter data more cheaply
+     *  should override it.
+     *
+     *  @param iov      Array of buffer pieces to write from
+     *  @param iovcnt   The number of pieces in the array
+     *  @return         The total number of bytes written, negative error on failure
+     */
+    virtual ssize_t writev(const iovec_t *iov, int iovcnt);
+
+    /** Borrow a contiguous run of received data without copying it
+     *
+     *  Devices that buffer reception internally can expose their buffer
+     *  directly, letting protocol pumps parse in place instead of copying
+     *  through an intermediate buffer. The run stays valid until it is
+     *  returned with read_release(); reads must not be issued while a
+     *  borrow is outstanding. Never blocks.
+     *
+     *  The default implementation returns -ENOSYS - callers fall back
+     *  to read().
+     *
+     *  @param buffer   Filled with a pointer to the received data
+     *  @return         The number of bytes borrowed, -EAGAIN if no data
+     *                  is pending, -ENOSYS if unsupported, other negative
+     *                  error on failure
+     */
+    virtual ssize_t read_borrow(const void **buffer);
+
+    /** Return data borrowed with read_borrow() and consume it
+     *
+     *  @param size     The number of bytes to consume, at most the size
+     *                  of the outstanding borrow
+     */
+    virtual void read_release(size_t size);
+
     /** Move the file position to a given offset from from a given location
      *
      *  @param offset   The offset from whence to move to
@@ -240,6 +297,37 @@ public:
     {
         //Default for real files. Do nothing for real files.
     }
+
+    /** Register poll()'s wakeup hook
+     *
+     *  Internal plumbing for poll(). This is a second callback slot, fired
+     *  on the same state changes as the sigio() callback, so that poll()
+     *  can block on the handle without disturbing whatever the owner has
+     *  registered with sigio(). Not intended for application use.
+     *
+     *  @param func     Function to call on state change
+     */
+    void attach_poll_wakeup(Callback<void()> func)
+    {
+        _poll_cb = func;
+    }
+
+protected:
+    /** Fire poll()'s wakeup hook, if one is attached
+     *
+     *  Derived classes that support sigio() must call this wherever they
+     *  would call the sigio() callback (whether or not one is set), so a
+     *  poll() blocked on this handle re-scans it.
+     */
+    void poll_notify()
+    {
+        if (_poll_cb) {
+            _poll_cb();
+        }
+    }
+
+private:
+    Callback<void()> _poll_cb;
 };
 
 /** Not a member function
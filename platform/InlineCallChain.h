@@ -0,0 +1,157 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INLINECALLCHAIN_H
+#define MBED_INLINECALLCHAIN_H
+
+#include "platform/Callback.h"
+#include "platform/CallChain.h"
+#include "platform/NonCopyable.h"
+#include "platform/mbed_critical.h"
+
+namespace mbed {
+/** \addtogroup platform */
+
+/** Fixed-capacity alternative to CallChain for interrupt fanout.
+ *
+ * Where CallChain heap-allocates a linked node per attached callback and
+ * chases pointers on every invocation, InlineCallChain stores its
+ * callbacks in an inline array: attaching never allocates, call() is a
+ * linear walk over contiguous memory, and a chain embedded in a driver
+ * costs a fixed, known amount of RAM. This makes it suitable for
+ * fanning events out to multiple subscribers from ISR context, where
+ * both the heap and an unbounded walk are unwelcome.
+ *
+ * Freed slots are reused by later add() calls, so callbacks run in slot
+ * order, which matches attachment order only while nothing has been
+ * removed from the middle of the chain. Use CallChain where strict
+ * insertion ordering or an unbounded count matters more than
+ * determinism.
+ *
+ * @note Synchronization level: Interrupt safe. add(), remove() and
+ *       clear() mutate the slots inside a critical section; call() runs
+ *       lock-free and may safely interrupt any of them.
+ *
+ * @ingroup platform
+ */
+template <unsigned N>
+class InlineCallChain : private NonCopyable<InlineCallChain<N> > {
+public:
+    /** Create an empty chain */
+    InlineCallChain() : _top(0) {
+        // Slots default-construct to null callbacks, which mark them free
+    }
+
+    /** Add a function to the chain, in the first free slot
+     *
+     *  @param func Function to add; must not be a null callback
+     *
+     *  @returns
+     *  The function object stored for 'func', usable as a handle for
+     *  remove(), or NULL if the chain is full
+     */
+    pFunctionPointer_t add(Callback<void()> func) {
+        pFunctionPointer_t handle = NULL;
+        if (!func) {
+            return NULL;
+        }
+        core_util_critical_section_enter();
+        for (unsigned i = 0; i < N; i++) {
+            if (!_slots[i]) {
+                _slots[i] = func;
+                if (i >= _top) {
+                    _top = i + 1;
+                }
+                handle = &_slots[i];
+                break;
+            }
+        }
+        core_util_critical_section_exit();
+        return handle;
+    }
+
+    /** Remove a function from the chain
+     *
+     *  @param f Handle returned by add()
+     *
+     *  @returns
+     *  true if the function was found and removed, false otherwise
+     */
+    bool remove(pFunctionPointer_t f) {
+        bool removed = false;
+        core_util_critical_section_enter();
+        if (f >= &_slots[0] && f < &_slots[N] && *f) {
+            *f = Callback<void()>();
+            while (_top > 0 && !_slots[_top - 1]) {
+                _top--;
+            }
+            removed = true;
+        }
+        core_util_critical_section_exit();
+        return removed;
+    }
+
+    /** Clear the chain (remove all functions) */
+    void clear() {
+        core_util_critical_section_enter();
+        for (unsigned i = 0; i < _top; i++) {
+            _slots[i] = Callback<void()>();
+        }
+        _top = 0;
+        core_util_critical_section_exit();
+    }
+
+    /** Get the number of functions in the chain */
+    unsigned size() const {
+        unsigned elements = 0;
+        core_util_critical_section_enter();
+        for (unsigned i = 0; i < _top; i++) {
+            if (_slots[i]) {
+                elements++;
+            }
+        }
+        core_util_critical_section_exit();
+        return elements;
+    }
+
+    /** Check whether the chain has room for another function */
+    bool full() const {
+        return size() == N;
+    }
+
+    /** Call all the functions in the chain, in slot order */
+    void call() {
+        // _top never exceeds the highest occupied slot, so the walk is
+        // bounded by the chain's historical occupancy, not by N
+        unsigned top = _top;
+        for (unsigned i = 0; i < top; i++) {
+            if (_slots[i]) {
+                _slots[i].call();
+            }
+        }
+    }
+
+    void operator ()(void) {
+        call();
+    }
+
+private:
+    Callback<void()> _slots[N];
+    unsigned _top;
+};
+
+} // namespace mbed
+
+#endif
@@ -22,6 +22,10 @@
 #include <stdio.h>
 #include <errno.h>
 
+#ifndef MBED_CONF_PLATFORM_LOCAL_FILE_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_LOCAL_FILE_BUFFER_SIZE 0
+#endif
+
 namespace mbed {
 
 /* Extension to FINFO type defined in RTL.h (in Keil RL) - adds 'create time'. */
@@ -108,11 +112,45 @@ FILEHANDLE local_file_open(const char* name, int flags) {
     return fh;
 }
 
-LocalFileHandle::LocalFileHandle(FILEHANDLE fh) : _fh(fh), pos(0) {
+LocalFileHandle::LocalFileHandle(FILEHANDLE fh) : _fh(fh), pos(0),
+        _buf(NULL), _buf_size(MBED_CONF_PLATFORM_LOCAL_FILE_BUFFER_SIZE),
+        _buf_len(0), _buf_pos(0), _buf_dirty(false) {
     // No lock needed in constructor
+    if (_buf_size > 0) {
+        _buf = new unsigned char[_buf_size];
+    }
+}
+
+LocalFileHandle::~LocalFileHandle() {
+    delete[] _buf;
+}
+
+// Drain pending buffered writes to the host in a single trap
+int LocalFileHandle::flush_buffer() {
+    if (_buf_dirty && (_buf_len > 0)) {
+        size_t not_written = semihost_write(_fh, _buf, _buf_len, 0);
+        _buf_len = 0;
+        _buf_dirty = false;
+        if (not_written != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Forget read-ahead data and pull the host file position back to 'pos'
+void LocalFileHandle::discard_readahead() {
+    if (!_buf_dirty && (_buf_len > _buf_pos)) {
+        semihost_seek(_fh, pos);
+    }
+    _buf_len = 0;
+    _buf_pos = 0;
 }
 
 int LocalFileHandle::close() {
+    lock();
+    flush_buffer();
+    unlock();
     int retval = semihost_close(_fh);
     delete this;
     return retval;
@@ -120,20 +158,88 @@ int LocalFileHandle::close() {
 
 ssize_t LocalFileHandle::write(const void *buffer, size_t length) {
     lock();
-    ssize_t n = semihost_write(_fh, (const unsigned char*)buffer, length, 0); // number of characters not written
-    n = length - n; // number of characters written
-    pos += n;
+    if (NULL == _buf) {
+        ssize_t n = semihost_write(_fh, (const unsigned char*)buffer, length, 0); // number of characters not written
+        n = length - n; // number of characters written
+        pos += n;
+        unlock();
+        return n;
+    }
+
+    if (!_buf_dirty) {
+        discard_readahead();
+    }
+    if (_buf_len + length > _buf_size) {
+        if (flush_buffer() < 0) {
+            unlock();
+            return -1;
+        }
+    }
+    if (length >= _buf_size) {
+        // Too big to batch - one large trap straight from the caller's buffer
+        ssize_t n = semihost_write(_fh, (const unsigned char*)buffer, length, 0);
+        n = length - n;
+        pos += n;
+        unlock();
+        return n;
+    }
+    memcpy(&_buf[_buf_len], buffer, length);
+    _buf_len += length;
+    _buf_dirty = true;
+    pos += length;
     unlock();
-    return n;
+    return length;
 }
 
 ssize_t LocalFileHandle::read(void *buffer, size_t length) {
     lock();
-    ssize_t n = semihost_read(_fh, (unsigned char*)buffer, length, 0); // number of characters not read
-    n = length - n; // number of characters read
-    pos += n;
+    if (NULL == _buf) {
+        ssize_t n = semihost_read(_fh, (unsigned char*)buffer, length, 0); // number of characters not read
+        n = length - n; // number of characters read
+        pos += n;
+        unlock();
+        return n;
+    }
+
+    if (_buf_dirty) {
+        if (flush_buffer() < 0) {
+            unlock();
+            return -1;
+        }
+    }
+    size_t total = 0;
+    // Serve what is left of the read-ahead buffer first
+    if (_buf_len > _buf_pos) {
+        size_t chunk = _buf_len - _buf_pos;
+        if (chunk > length) {
+            chunk = length;
+        }
+        memcpy(buffer, &_buf[_buf_pos], chunk);
+        _buf_pos += chunk;
+        pos += chunk;
+        total += chunk;
+        length -= chunk;
+        buffer = (unsigned char*)buffer + chunk;
+    }
+    if (length >= _buf_size) {
+        // Too big to batch - one large trap straight into the caller's buffer
+        ssize_t n = semihost_read(_fh, (unsigned char*)buffer, length, 0);
+        n = length - n;
+        pos += n;
+        total += n;
+    } else if (length > 0) {
+        // Refill the read-ahead buffer with one large trap
+        size_t got = _buf_size - semihost_read(_fh, _buf, _buf_size, 0);
+        _buf_len = got;
+        _buf_pos = 0;
+        size_t chunk = (got > length) ? length : got;
+        memcpy(buffer, _buf, chunk);
+        _buf_pos = chunk;
+        pos += chunk;
+        total += chunk;
+    }
     unlock();
-    return n;
+    return total;
 }
 
 int LocalFileHandle::isatty() {
@@ -145,6 +251,8 @@ int LocalFileHandle::isatty() {
 
 off_t LocalFileHandle::seek(off_t position, int whence) {
     lock();
+    flush_buffer();
+    discard_readahead();
     if (whence == SEEK_CUR) {
         position += pos;
     } else if (whence == SEEK_END) {
@@ -160,6 +268,10 @@ off_t LocalFileHandle::seek(off_t position, int whence) {
 
 int LocalFileHandle::sync() {
     lock();
+    if (flush_buffer() < 0) {
+        unlock();
+        return -1;
+    }
     int ret = semihost_ensure(_fh);
     unlock();
     return ret;
@@ -167,6 +279,7 @@ int LocalFileHandle::sync() {
 
 off_t LocalFileHandle::size() {
     lock();
+    flush_buffer();
     off_t off = semihost_flen(_fh);
     unlock();
     return off;
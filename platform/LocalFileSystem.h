@@ -34,12 +34,21 @@ FILEHANDLE local_file_open(const char* name, int flags);
 /**
  * @class LocalFileHandle
  * @ingroup platform
+ *
+ * Every semihosting operation halts the core for the duration of the trap,
+ * so when platform.local-file-buffer-size is non-zero a RAM staging buffer
+ * batches small reads and writes into large transfers: writes collect in
+ * the buffer and drain in one trap when it fills (or on sync, seek, size
+ * and close), reads pull a whole buffer of data ahead and are served from
+ * RAM. A zero buffer size keeps every call an individual trap.
  */
 class LocalFileHandle : public FileHandle, private NonCopyable<LocalFileHandle> {
 
 public:
     LocalFileHandle(FILEHANDLE fh);
 
+    virtual ~LocalFileHandle();
+
     virtual int close();
 
     virtual ssize_t write(const void *buffer, size_t length);
@@ -57,9 +66,18 @@ public:
 protected:
     virtual void lock();
     virtual void unlock();
+
+    int flush_buffer();
+    void discard_readahead();
+
     FILEHANDLE _fh;
     int pos;
     PlatformMutex _mutex;
+    unsigned char *_buf;
+    size_t _buf_size;
+    size_t _buf_len;   // valid bytes: pending writes, or read-ahead data
+    size_t _buf_pos;   // read-ahead bytes already handed to the caller
+    bool _buf_dirty;   // buffer holds writes not yet on the host
 };
 
 /** A filesystem for accessing the local mbed Microcontroller USB disk drive
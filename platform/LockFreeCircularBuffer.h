@@ -0,0 +1,136 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_LOCKFREECIRCULARBUFFER_H
+#define MBED_LOCKFREECIRCULARBUFFER_H
+
+#include "platform/mbed_critical.h"
+#include "cmsis.h"
+
+namespace mbed {
+/** \addtogroup platform */
+
+/** Templated Circular buffer class with lock-free producers
+ *
+ *  A multi-producer/single-consumer variant of CircularBuffer. Producers
+ *  reserve a slot with an atomic compare-and-swap instead of masking
+ *  interrupts, so concurrent pushes from several ISRs and threads cost a
+ *  few cycles and never inflate interrupt latency. Only one context may
+ *  pop at a time.
+ *
+ *  Unlike CircularBuffer, push() rejects data when the buffer is full
+ *  instead of overwriting the oldest element, since overwriting cannot be
+ *  done without excluding the other producers.
+ *
+ *  @note Synchronization level: Interrupt safe (pop from a single context only)
+ *  @ingroup platform
+ */
+template<typename T, uint32_t BufferSize>
+class LockFreeCircularBuffer {
+public:
+    LockFreeCircularBuffer() : _head(0), _tail(0) {
+        for (uint32_t i = 0; i < BufferSize; i++) {
+            _ready[i] = 0;
+        }
+    }
+
+    ~LockFreeCircularBuffer() {
+    }
+
+    /** Push the transaction to the buffer
+     *
+     * @param data Data to be pushed to the buffer
+     * @return True if a slot was free and data was stored, false if the buffer is full
+     */
+    bool push(const T& data) {
+        uint32_t head;
+        do {
+            head = _head;
+            if (head - _tail >= BufferSize) {
+                return false;
+            }
+        } while (!core_util_atomic_cas_u32((uint32_t *)&_head, &head, head + 1));
+        uint32_t slot = head % BufferSize;
+        _pool[slot] = data;
+        /* Publish after the payload is in place so the consumer never
+         * reads a half-written slot. The barrier keeps the payload store
+         * from reordering past the volatile publishing store. */
+        __DMB();
+        _ready[slot] = 1;
+        return true;
+    }
+
+    /** Pop the transaction from the buffer
+     *
+     * @param data Data to be popped from the buffer
+     * @return True if the buffer is not empty and data contains a transaction, false otherwise
+     */
+    bool pop(T& data) {
+        if (_tail == _head) {
+            return false;
+        }
+        uint32_t slot = _tail % BufferSize;
+        if (!_ready[slot]) {
+            /* A producer reserved the slot but has not finished writing it */
+            return false;
+        }
+        data = _pool[slot];
+        /* The payload must be read out before the release store lets a
+         * producer reuse the slot. */
+        __DMB();
+        _ready[slot] = 0;
+        /* Single consumer - a plain store is enough to release the slot */
+        _tail = _tail + 1;
+        return true;
+    }
+
+    /** Check if the buffer is empty
+     *
+     * @return True if the buffer is empty, false if not
+     */
+    bool empty() const {
+        return _head == _tail;
+    }
+
+    /** Check if the buffer is full
+     *
+     * @return True if the buffer is full, false if not
+     */
+    bool full() const {
+        return _head - _tail >= BufferSize;
+    }
+
+    /** Reset the buffer
+     *
+     *  Must not be called while producers or the consumer are active.
+     */
+    void reset() {
+        _head = 0;
+        _tail = 0;
+        for (uint32_t i = 0; i < BufferSize; i++) {
+            _ready[i] = 0;
+        }
+    }
+
+private:
+    T _pool[BufferSize];
+    volatile uint8_t _ready[BufferSize];
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+};
+
+}
+
+#endif
@@ -74,22 +74,22 @@ template <class T>
 struct SingletonPtr {
 
     /** Get a pointer to the underlying singleton
+     *
+     * After construction this is a load and a taken compare - the global
+     * mutex is only ever touched on the construction path.
      *
      * @returns
      *   A pointer to the singleton
      */
     T* get() {
-        if (NULL == _ptr) {
-            singleton_lock();
-            if (NULL == _ptr) {
-                _ptr = new (_data) T();
-            }
-            singleton_unlock();
+        T *p = _ptr;
+        if (NULL == p) {
+            p = init();
         }
         // _ptr was not zero initialized or was
         // corrupted if this assert is hit
-        MBED_ASSERT(_ptr == (T *)&_data);
-        return _ptr;
+        MBED_ASSERT(p == (T *)&_data);
+        return p;
     }
 
     /** Get a pointer to the underlying singleton
@@ -101,11 +101,62 @@ struct SingletonPtr {
         return get();
     }
 
+    /** Construction slow path - kept out of get() so the hot path stays
+     * small enough to inline at every call site
+     */
+    T* init() {
+        singleton_lock();
+        if (NULL == _ptr) {
+            _ptr = new (_data) T();
+        }
+        T *p = _ptr;
+        singleton_unlock();
+        return p;
+    }
+
     // This is zero initialized when in global scope
     T *_ptr;
     // Force data to be 4 byte aligned
     uint32_t _data[(sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
 };
 
+/** Statically initialized variant of SingletonPtr for types whose
+ * zero-initialized state is already valid (plain data, counters, or
+ * classes that are empty without an RTOS).
+ *
+ * There is no lazy construction and therefore no flag, no lock and no
+ * branch - get() compiles down to the object's address, which matters
+ * for singletons consulted on every driver transaction.
+ *
+ * @note: Like SingletonPtr, this class must only be used in a static
+ * context so the instance is zero initialized at load time. No
+ * constructor is ever run, which is why T must not need one.
+ * @ingroup platform
+ */
+template <class T>
+struct StaticSingletonPtr {
+
+    /** Get a pointer to the underlying singleton
+     *
+     * @returns
+     *   A pointer to the singleton
+     */
+    T* get() {
+        return &_instance;
+    }
+
+    /** Get a pointer to the underlying singleton
+     *
+     * @returns
+     *   A pointer to the singleton
+     */
+    T* operator->() {
+        return get();
+    }
+
+    // This is zero initialized when in global scope
+    T _instance;
+};
+
 #endif
 
@@ -16,9 +16,79 @@
 #include "platform/Stream.h"
 #include "platform/mbed_error.h"
 #include <errno.h>
+#include <string.h>
+#include <stdint.h>
 
 namespace mbed {
 
+/* Check whether a format string only uses conversions the in-place
+ * formatter handles; anything else goes through vfprintf as before.
+ * Supported: flags '-' and '0', a numeric width, a numeric precision
+ * (strings and floats only), 'h'/'l' length modifiers, and the
+ * conversions d, i, u, x, X, c, s, p, f and %%. */
+static bool format_is_simple(const char *format)
+{
+    for (const char *f = format; *f; f++) {
+        if (*f != '%') {
+            continue;
+        }
+        f++;
+        if (*f == '%') {
+            continue;
+        }
+        while (*f == '-' || *f == '0') {
+            f++;
+        }
+        while (*f >= '0' && *f <= '9') {
+            f++;
+        }
+        bool precision = false;
+        if (*f == '.') {
+            precision = true;
+            f++;
+            while (*f >= '0' && *f <= '9') {
+                f++;
+            }
+        }
+        if (*f == 'l') {
+            f++;
+            if (*f == 'l') {
+                f++;
+            }
+        } else if (*f == 'h') {
+            f++;
+            if (*f == 'h') {
+                f++;
+            }
+        }
+        switch (*f) {
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'p': case 'c':
+                if (precision) {
+                    return false;
+                }
+                break;
+            case 's': case 'f':
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+/* Write the digits of 'value' backwards, ending at 'end'; returns a pointer
+ * to the first digit */
+static char *format_unsigned(char *end, unsigned long long value, unsigned base, bool upper)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char *p = end;
+    do {
+        *--p = digits[value % base];
+        value /= base;
+    } while (value);
+    return p;
+}
+
 Stream::Stream(const char *name) : FileLike(name), _file(NULL) {
     // No lock needed in constructor
     /* open ourselves */
@@ -125,13 +195,10 @@ off_t Stream::size() {
 }
 
 int Stream::printf(const char* format, ...) {
-    lock();
     std::va_list arg;
     va_start(arg, format);
-    fflush(_file);
-    int r = vfprintf(_file, format, arg);
+    int r = vprintf(format, arg);
     va_end(arg);
-    unlock();
     return r;
 }
 
@@ -149,11 +216,215 @@ int Stream::scanf(const char* format, ...) {
 int Stream::vprintf(const char* format, std::va_list args) {
     lock();
     fflush(_file);
-    int r = vfprintf(_file, format, args);
+    int r;
+    if (format_is_simple(format)) {
+        r = vformat(format, args);
+    } else {
+        r = vfprintf(_file, format, args);
+    }
     unlock();
     return r;
 }
 
+int Stream::emit_repeat(char c, int n) {
+    char pad[8];
+    memset(pad, c, sizeof(pad));
+    int count = 0;
+    while (n > 0) {
+        int chunk = n < (int)sizeof(pad) ? n : (int)sizeof(pad);
+        count += write(pad, chunk);
+        n -= chunk;
+    }
+    return count;
+}
+
+int Stream::vformat(const char *format, std::va_list args) {
+    int count = 0;
+    const char *f = format;
+
+    while (*f) {
+        /* Literal runs go out in one write */
+        if (*f != '%') {
+            const char *run = f;
+            while (*f && *f != '%') {
+                f++;
+            }
+            count += write(run, f - run);
+            continue;
+        }
+        f++;
+        if (*f == '%') {
+            count += write("%", 1);
+            f++;
+            continue;
+        }
+
+        bool left = false, zero = false;
+        for (;; f++) {
+            if (*f == '-') {
+                left = true;
+            } else if (*f == '0') {
+                zero = true;
+            } else {
+                break;
+            }
+        }
+        int width = 0;
+        while (*f >= '0' && *f <= '9') {
+            width = width * 10 + (*f++ - '0');
+        }
+        int precision = -1;
+        if (*f == '.') {
+            f++;
+            precision = 0;
+            while (*f >= '0' && *f <= '9') {
+                precision = precision * 10 + (*f++ - '0');
+            }
+        }
+        int longs = 0;
+        if (*f == 'l') {
+            longs = 1;
+            f++;
+            if (*f == 'l') {
+                longs = 2;
+                f++;
+            }
+        } else if (*f == 'h') {
+            f++;
+            if (*f == 'h') {
+                f++;
+            }
+        }
+        char conv = *f++;
+
+        /* Worst case is a 20-digit integer part, point and 9 fraction digits */
+        char buf[40];
+        char *end = buf + sizeof(buf);
+        const char *prefix = "";
+        int prefix_len = 0;
+        const char *body;
+        int body_len;
+
+        switch (conv) {
+            case 'd': case 'i': {
+                long long value = (longs == 2) ? va_arg(args, long long) :
+                                  (longs == 1) ? va_arg(args, long) : va_arg(args, int);
+                unsigned long long mag = (value < 0) ? -(unsigned long long)value : value;
+                if (value < 0) {
+                    prefix = "-";
+                    prefix_len = 1;
+                }
+                body = format_unsigned(end, mag, 10, false);
+                body_len = end - body;
+                break;
+            }
+            case 'u': case 'x': case 'X': {
+                unsigned long long value =
+                        (longs == 2) ? va_arg(args, unsigned long long) :
+                        (longs == 1) ? va_arg(args, unsigned long) : va_arg(args, unsigned int);
+                body = format_unsigned(end, value, (conv == 'u') ? 10 : 16, conv == 'X');
+                body_len = end - body;
+                break;
+            }
+            case 'p': {
+                prefix = "0x";
+                prefix_len = 2;
+                body = format_unsigned(end, (uintptr_t)va_arg(args, void *), 16, false);
+                body_len = end - body;
+                break;
+            }
+            case 'c': {
+                buf[0] = (char)va_arg(args, int);
+                body = buf;
+                body_len = 1;
+                break;
+            }
+            case 's': {
+                body = va_arg(args, const char *);
+                body_len = strlen(body);
+                if (precision >= 0 && body_len > precision) {
+                    body_len = precision;
+                }
+                break;
+            }
+            case 'f': {
+                double value = va_arg(args, double);
+                int prec = (precision < 0) ? 6 : (precision > 9) ? 9 : precision;
+                if (value != value) {
+                    body = "nan";
+                    body_len = 3;
+                    zero = false;
+                } else if (value > 4e18 || value < -4e18) {
+                    /* Out of integer range (or infinite) - punt this one
+                     * conversion to stdio, the stream is unbuffered */
+                    count += fprintf(_file, "%*.*f", left ? -width : width, prec, value);
+                    continue;
+                } else {
+                    double mag = value;
+                    if (value < 0 || (value == 0 && 1 / value < 0)) {
+                        prefix = "-";
+                        prefix_len = 1;
+                        mag = -mag;
+                    }
+                    unsigned long long scale = 1;
+                    for (int i = 0; i < prec; i++) {
+                        scale *= 10;
+                    }
+                    unsigned long long ipart = (unsigned long long)mag;
+                    double fraction = (mag - ipart) * scale;
+                    unsigned long long fpart = (unsigned long long)fraction;
+                    double remainder = fraction - fpart;
+                    /* Round half to even, as stdio does */
+                    if (remainder > 0.5 || (remainder == 0.5 && (fpart & 1))) {
+                        fpart++;
+                    }
+                    if (fpart >= scale) {
+                        fpart -= scale;
+                        ipart++;
+                    }
+                    char *p = end;
+                    if (prec > 0) {
+                        p = format_unsigned(p, fpart, 10, false);
+                        while (end - p < prec) {
+                            *--p = '0';
+                        }
+                        *--p = '.';
+                    }
+                    body = format_unsigned(p, ipart, 10, false);
+                    body_len = end - body;
+                }
+                break;
+            }
+            default:
+                /* Unreachable - format_is_simple vetted the string */
+                continue;
+        }
+
+        int pad = width - prefix_len - body_len;
+        if (pad > 0 && !left && zero && conv != 'c' && conv != 's') {
+            if (prefix_len) {
+                count += write(prefix, prefix_len);
+            }
+            count += emit_repeat('0', pad);
+            count += write(body, body_len);
+        } else {
+            if (pad > 0 && !left) {
+                count += emit_repeat(' ', pad);
+            }
+            if (prefix_len) {
+                count += write(prefix, prefix_len);
+            }
+            if (body_len) {
+                count += write(body, body_len);
+            }
+            if (pad > 0 && left) {
+                count += emit_repeat(' ', pad);
+            }
+        }
+    }
+    return count;
+}
+
 int Stream::vscanf(const char* format, std::va_list args) {
     lock();
     fflush(_file);
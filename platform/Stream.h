@@ -81,6 +81,13 @@ protected:
     virtual void unlock() {
         // Stub
     }
+
+private:
+    /* Lightweight formatter behind printf/vprintf - formats the common
+     * conversions in place and emits them with bulk write() calls, skipping
+     * the stdio machinery and its per-character round trip */
+    int vformat(const char *format, std::va_list args);
+    int emit_repeat(char c, int n);
 };
 
 } // namespace mbed
@@ -0,0 +1,146 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TRANSACTIONQUEUE_H
+#define MBED_TRANSACTIONQUEUE_H
+
+#include "platform/Transaction.h"
+#include "platform/NonCopyable.h"
+#include "platform/mbed_critical.h"
+
+namespace mbed {
+/** \addtogroup platform */
+
+/** Shared transaction queue engine for asynchronous drivers.
+ *
+ * Generalizes the transaction queue SPI has always kept privately, so
+ * every asynch driver chains queued transfers the same way: a driver
+ * class owns one static TransactionQueue, add() enqueues a transaction
+ * and starts it at once when its peripheral is idle, and the driver's
+ * completion interrupt calls dispatch_next() so the next queued
+ * transaction starts straight from interrupt context, back-to-back with
+ * the one that finished.
+ *
+ * Dispatch arbitrates per peripheral: it starts the oldest queued
+ * transaction whose peripheral is free, rather than blindly popping the
+ * head, so one busy bus never stalls transactions queued for an idle
+ * one. Transactions for the same instance always run in the order they
+ * were added.
+ *
+ * Class must provide:
+ * - bool transfer_active() - whether its peripheral is mid-transfer
+ * - void start_transaction(TransactionType *) - begin a transfer
+ *
+ * TransactionType defaults to transaction_t; drivers whose transfers
+ * need more than a buffer pair (such as I2C with its slave address and
+ * repeated-start flag) queue their own type instead.
+ *
+ * @note Synchronization level: Interrupt safe
+ * @ingroup platform
+ */
+template <typename Class, int QueueSize, typename TransactionType = transaction_t>
+class TransactionQueue : private NonCopyable<TransactionQueue<Class, QueueSize, TransactionType> > {
+public:
+    TransactionQueue() : _count(0) {
+    }
+
+    /** Add a transaction, starting it immediately if the peripheral is idle
+     *
+     *  @param obj  The driver instance the transaction belongs to
+     *  @param data The transaction to queue
+     *
+     *  @returns 0 on success, -1 if the queue is full
+     */
+    int add(Class *obj, const TransactionType &data) {
+        int ret = -1;
+        core_util_critical_section_enter();
+        if (_count < QueueSize) {
+            _entries[_count].obj = obj;
+            _entries[_count].data = data;
+            _count++;
+            if (!obj->transfer_active()) {
+                dispatch();
+            }
+            ret = 0;
+        }
+        core_util_critical_section_exit();
+        return ret;
+    }
+
+    /** Start the next queued transaction whose peripheral is idle, if any
+     *
+     *  Called from a driver's completion interrupt so a queued
+     *  transaction follows the finished one without a gap.
+     *
+     *  @returns true if a transaction was started, false if none was
+     *  eligible
+     */
+    bool dispatch_next() {
+        bool started;
+        core_util_critical_section_enter();
+        started = dispatch();
+        core_util_critical_section_exit();
+        return started;
+    }
+
+    /** Discard all queued transactions without starting them */
+    void clear() {
+        core_util_critical_section_enter();
+        _count = 0;
+        core_util_critical_section_exit();
+    }
+
+    /** Check whether the queue has room for another transaction */
+    bool full() const {
+        return _count == QueueSize;
+    }
+
+    /** Check whether any transactions are queued */
+    bool empty() const {
+        return _count == 0;
+    }
+
+private:
+    struct entry_t {
+        Class *obj;
+        TransactionType data;
+    };
+
+    // Must be called inside a critical section
+    bool dispatch() {
+        for (int i = 0; i < _count; i++) {
+            if (!_entries[i].obj->transfer_active()) {
+                entry_t entry = _entries[i];
+                for (int j = i; j < _count - 1; j++) {
+                    _entries[j] = _entries[j + 1];
+                }
+                _count--;
+                entry.obj->start_transaction(&entry.data);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // _entries[0.._count) hold queued transactions in arrival order;
+    // QueueSize is small, so compacting on dispatch beats ring
+    // bookkeeping
+    entry_t _entries[QueueSize];
+    int _count;
+};
+
+} // namespace mbed
+
+#endif
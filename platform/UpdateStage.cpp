@@ -0,0 +1,253 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "platform/UpdateStage.h"
+
+#ifdef DEVICE_FLASH
+
+#ifndef MBED_CONF_PLATFORM_UPDATE_STAGE_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_UPDATE_STAGE_BUFFER_SIZE 512
+#endif
+
+namespace mbed {
+
+UpdateStage::UpdateStage(uint32_t stage_addr, uint32_t stage_size)
+    : _stage_addr(stage_addr), _stage_size(stage_size), _buf_size(0),
+      _fill(0), _fill_len(0), _prog_len(0), _prog_off(0),
+      _write_addr(0), _erase_addr(0), _image_size(0), _received(0),
+      _init(false), _staging(false)
+{
+    _buf[0] = NULL;
+    _buf[1] = NULL;
+}
+
+UpdateStage::~UpdateStage()
+{
+    if (_init) {
+        deinit();
+    }
+}
+
+int UpdateStage::init()
+{
+    if (_init) {
+        return 0;
+    }
+    if (_flash.init()) {
+        return -1;
+    }
+
+    // staging region must cover whole sectors
+    uint32_t sector_size = _flash.get_sector_size(_stage_addr);
+    if ((_stage_addr % sector_size) != 0 || _stage_size == 0) {
+        _flash.deinit();
+        return -1;
+    }
+
+    // round the configured buffer size up to a whole number of pages
+    uint32_t page_size = _flash.get_page_size();
+    _buf_size = MBED_CONF_PLATFORM_UPDATE_STAGE_BUFFER_SIZE;
+    if (_buf_size < page_size) {
+        _buf_size = page_size;
+    }
+    _buf_size = ((_buf_size + page_size - 1) / page_size) * page_size;
+
+    _buf[0] = new uint8_t[_buf_size];
+    _buf[1] = new uint8_t[_buf_size];
+
+    _init = true;
+    return 0;
+}
+
+int UpdateStage::deinit()
+{
+    if (!_init) {
+        return 0;
+    }
+    if (_staging) {
+        mbedtls_sha256_free(&_sha);
+        _staging = false;
+    }
+    delete[] _buf[0];
+    delete[] _buf[1];
+    _buf[0] = NULL;
+    _buf[1] = NULL;
+    _init = false;
+    return _flash.deinit();
+}
+
+int UpdateStage::start(uint32_t image_size)
+{
+    if (!_init || image_size == 0 || image_size > _stage_size) {
+        return -1;
+    }
+    if (_staging) {
+        mbedtls_sha256_free(&_sha);
+    }
+
+    _fill = 0;
+    _fill_len = 0;
+    _prog_len = 0;
+    _prog_off = 0;
+    _write_addr = _stage_addr;
+    _erase_addr = _stage_addr;
+    _image_size = image_size;
+    _received = 0;
+
+    mbedtls_sha256_init(&_sha);
+    mbedtls_sha256_starts(&_sha, 0);
+    _staging = true;
+    return 0;
+}
+
+int UpdateStage::write(const void *buffer, size_t size)
+{
+    if (!_staging || _received + size > _image_size) {
+        return -1;
+    }
+
+    const uint8_t *data = (const uint8_t *) buffer;
+    mbedtls_sha256_update(&_sha, data, size);
+    _received += size;
+
+    while (size) {
+        uint32_t space = _buf_size - _fill_len;
+        uint32_t chunk = (size < space) ? size : space;
+        memcpy(_buf[_fill] + _fill_len, data, chunk);
+        _fill_len += chunk;
+        data += chunk;
+        size -= chunk;
+
+        if (_fill_len == _buf_size) {
+            // hand the full buffer over for programming, blocking only
+            // if the previous buffer has not finished yet
+            int err = drain();
+            if (err) {
+                return err;
+            }
+            _prog_len = _buf_size;
+            _prog_off = 0;
+            _fill ^= 1;
+            _fill_len = 0;
+        }
+    }
+
+    // kick one page so programming makes progress even if the caller
+    // never pumps, the rest overlaps with the next network receive
+    int err = program_page();
+    return (err < 0) ? err : 0;
+}
+
+int UpdateStage::pump()
+{
+    if (!_staging) {
+        return 0;
+    }
+    return program_page();
+}
+
+int UpdateStage::finish(const uint8_t *expected_hash, uint8_t *computed_hash)
+{
+    if (!_staging || _received != _image_size) {
+        return -1;
+    }
+
+    int err = drain();
+    if (err) {
+        return err;
+    }
+
+    if (_fill_len) {
+        // pad the tail out to a whole number of pages, the padding is
+        // not part of the image and is not hashed
+        uint32_t page_size = _flash.get_page_size();
+        uint32_t padded = ((_fill_len + page_size - 1) / page_size) * page_size;
+        memset(_buf[_fill] + _fill_len, 0xFF, padded - _fill_len);
+        _prog_len = padded;
+        _prog_off = 0;
+        _fill ^= 1;
+        _fill_len = 0;
+        err = drain();
+        if (err) {
+            return err;
+        }
+    }
+
+    uint8_t hash[32];
+    mbedtls_sha256_finish(&_sha, hash);
+    mbedtls_sha256_free(&_sha);
+    _staging = false;
+
+    if (computed_hash) {
+        memcpy(computed_hash, hash, sizeof(hash));
+    }
+    if (expected_hash && memcmp(hash, expected_hash, sizeof(hash)) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+uint32_t UpdateStage::get_stage_address() const
+{
+    return _stage_addr;
+}
+
+uint32_t UpdateStage::get_stage_size() const
+{
+    return _stage_size;
+}
+
+int UpdateStage::program_page()
+{
+    if (!_prog_len) {
+        return 0;
+    }
+
+    // erase a sector the first time the write pointer enters it
+    if (_write_addr == _erase_addr) {
+        uint32_t sector_size = _flash.get_sector_size(_erase_addr);
+        if (_erase_addr + sector_size > _stage_addr + _stage_size) {
+            return -1;
+        }
+        if (_flash.erase(_erase_addr, sector_size)) {
+            return -1;
+        }
+        _erase_addr += sector_size;
+    }
+
+    uint32_t page_size = _flash.get_page_size();
+    if (_flash.program(_buf[_fill ^ 1] + _prog_off, _write_addr, page_size)) {
+        return -1;
+    }
+    _prog_off += page_size;
+    _prog_len -= page_size;
+    _write_addr += page_size;
+    return _prog_len ? 1 : 0;
+}
+
+int UpdateStage::drain()
+{
+    int err;
+    do {
+        err = program_page();
+    } while (err > 0);
+    return err;
+}
+
+} /* namespace mbed */
+
+#endif
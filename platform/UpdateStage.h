@@ -0,0 +1,175 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_UPDATE_STAGE_H
+#define MBED_UPDATE_STAGE_H
+
+#include "device.h"
+
+#if defined(DEVICE_FLASH) || defined(DOXYGEN_ONLY)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "drivers/FlashIAP.h"
+#include "platform/NonCopyable.h"
+#include "mbedtls/sha256.h"
+
+namespace mbed {
+/** \addtogroup platform */
+/** @{*/
+
+/** Staging area for streamed firmware images
+ *
+ *  Accepts an update image in arbitrarily sized chunks, programs it
+ *  into a staging region of internal flash and maintains a rolling
+ *  SHA-256 of the image as it arrives. Chunks are collected in one of
+ *  two page sized buffers while the other is programmed, so the
+ *  receive path only blocks when it gets ahead of the flash. The image
+ *  is verified against an expected digest before it is declared good,
+ *  after which a bootloader may swap to it with mbed_start_application.
+ *
+ *  Sectors of the staging region are erased on demand just ahead of
+ *  the write pointer rather than all up front, so start returns
+ *  immediately and erase time is spread across the download.
+ *
+ *  @note Synchronization level: Not protected
+ */
+class UpdateStage : private NonCopyable<UpdateStage> {
+public:
+    /** Create an update stage over a region of internal flash
+     *
+     *  @param stage_addr   Start address of the staging region, must be
+     *                      aligned to a sector boundary
+     *  @param stage_size   Size of the staging region in bytes, must be
+     *                      a multiple of the sector size
+     */
+    UpdateStage(uint32_t stage_addr, uint32_t stage_size);
+    ~UpdateStage();
+
+    /** Initialize the underlying flash and allocate the staging buffers
+     *
+     *  Should be called once per lifetime of the object.
+     *  @return 0 on success or a negative error code on failure
+     */
+    int init();
+
+    /** Deinitialize the underlying flash and release the staging buffers
+     *
+     *  @return 0 on success or a negative error code on failure
+     */
+    int deinit();
+
+    /** Begin staging a new image
+     *
+     *  Resets the write pointer to the start of the staging region and
+     *  restarts the rolling hash. Any previously staged image is
+     *  overwritten.
+     *
+     *  @param image_size   Size of the image to be streamed in bytes,
+     *                      must fit in the staging region
+     *  @return 0 on success or a negative error code on failure
+     */
+    int start(uint32_t image_size);
+
+    /** Append a chunk of the image
+     *
+     *  The chunk is copied into the staging buffers and hashed, and at
+     *  most one page is programmed before returning, so the caller can
+     *  go back to receiving while pump drives the rest of the
+     *  programming from a low priority context. Blocks only when both
+     *  buffers are full.
+     *
+     *  @param buffer   Chunk data
+     *  @param size     Chunk size in bytes
+     *  @return 0 on success or a negative error code on failure
+     */
+    int write(const void *buffer, size_t size);
+
+    /** Advance background programming by one page
+     *
+     *  Should be called repeatedly from a low priority context, for
+     *  example an event queue, to overlap flash programming with the
+     *  network receive path. Erases a sector when the write pointer
+     *  first enters it.
+     *
+     *  @return 1 if buffered data remains to be programmed, 0 if the
+     *          stage is idle, or a negative error code on failure
+     */
+    int pump();
+
+    /** Complete the image and verify it
+     *
+     *  Flushes the remaining buffered data to flash, padding the final
+     *  page with 0xFF, and finalizes the rolling SHA-256 over exactly
+     *  the image bytes.
+     *
+     *  @param expected_hash    SHA-256 the received image must match,
+     *                          may be NULL to skip verification
+     *  @param computed_hash    Destination for the computed SHA-256,
+     *                          may be NULL
+     *  @return 0 if the image was staged (and verified when an expected
+     *          hash was given), or a negative error code on failure
+     */
+    int finish(const uint8_t *expected_hash, uint8_t *computed_hash = NULL);
+
+    /** Get the start address of the staging region
+     *
+     *  @return Start address of the staging region
+     */
+    uint32_t get_stage_address() const;
+
+    /** Get the size of the staging region
+     *
+     *  @return Size of the staging region in bytes
+     */
+    uint32_t get_stage_size() const;
+
+private:
+    /* Program one page from the in-flight buffer, erasing ahead as needed
+     *
+     *  @return 1 if in-flight data remains, 0 if idle, negative error on failure
+     */
+    int program_page();
+
+    /* Drive program_page until the in-flight buffer is empty
+     *
+     *  @return 0 on success or a negative error code on failure
+     */
+    int drain();
+
+    FlashIAP _flash;
+    uint32_t _stage_addr;
+    uint32_t _stage_size;
+    uint32_t _buf_size;
+    uint8_t *_buf[2];
+    int _fill;              /* index of the buffer collecting chunks   */
+    uint32_t _fill_len;     /* bytes collected in the filling buffer   */
+    uint32_t _prog_len;     /* bytes left in the buffer being programmed */
+    uint32_t _prog_off;     /* programming offset into that buffer     */
+    uint32_t _write_addr;   /* next flash address to program           */
+    uint32_t _erase_addr;   /* flash is erased up to this address      */
+    uint32_t _image_size;
+    uint32_t _received;
+    bool _init;
+    bool _staging;
+    mbedtls_sha256_context _sha;
+};
+
+/** @}*/
+} /* namespace mbed */
+
+#endif  /* DEVICE_FLASH */
+
+#endif  /* MBED_UPDATE_STAGE_H */
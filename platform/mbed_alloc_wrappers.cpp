@@ -52,6 +52,94 @@ static SingletonPtr<PlatformMutex> mem_trace_mutex;
 #ifdef MBED_HEAP_STATS_ENABLED
 static SingletonPtr<PlatformMutex> malloc_stats_mutex;
 static mbed_stats_heap_t heap_stats = {0, 0, 0, 0, 0};
+
+/* Per-call-site attribution: a small table keyed by the malloc caller's
+ * return address. Each allocation remembers its site index in the header's
+ * pad word so free can credit the right site. Sites beyond the table
+ * capacity only show up in the global totals. */
+#ifndef MBED_CONF_PLATFORM_HEAP_STATS_MAX_SITES
+#define MBED_CONF_PLATFORM_HEAP_STATS_MAX_SITES 16
+#endif
+
+#if MBED_CONF_PLATFORM_HEAP_STATS_MAX_SITES > 0
+
+#define HEAP_SITE_UNTRACKED 0xFFFFFFFF
+
+static mbed_stats_heap_site_t heap_site_stats[MBED_CONF_PLATFORM_HEAP_STATS_MAX_SITES];
+
+/* Called with malloc_stats_mutex held */
+static uint32_t heap_site_alloc(void *caller, size_t size) {
+    uint32_t caller_addr = (uint32_t)(uintptr_t)caller;
+    for (uint32_t i = 0; i < MBED_CONF_PLATFORM_HEAP_STATS_MAX_SITES; i++) {
+        mbed_stats_heap_site_t *site = &heap_site_stats[i];
+        if (site->caller != caller_addr && site->caller != 0) {
+            continue;
+        }
+        site->caller = caller_addr;
+        site->alloc_cnt += 1;
+        site->current_size += size;
+        site->total_size += size;
+        if (site->current_size > site->max_size) {
+            site->max_size = site->current_size;
+        }
+        return i;
+    }
+    return HEAP_SITE_UNTRACKED;
+}
+
+/* Called with malloc_stats_mutex held */
+static void heap_site_free(uint32_t index, uint32_t size) {
+    if (index >= MBED_CONF_PLATFORM_HEAP_STATS_MAX_SITES) {
+        return;
+    }
+    heap_site_stats[index].alloc_cnt -= 1;
+    heap_site_stats[index].current_size -= size;
+}
+
+#else
+
+#define HEAP_SITE_UNTRACKED 0xFFFFFFFF
+#define heap_site_alloc(caller, size)   HEAP_SITE_UNTRACKED
+#define heap_site_free(index, size)     ((void)0)
+
+#endif // #if MBED_CONF_PLATFORM_HEAP_STATS_MAX_SITES > 0
+
+/* Per-region attribution for targets with a secondary heap bank (HEAP2).
+ * An allocation is classified by the address the allocator returned, so
+ * free can credit the same bank without any extra header state. Region 0
+ * is the primary heap; region 1 only fills in when mbed_heap2_size != 0. */
+extern unsigned char *mbed_heap_start;
+extern uint32_t mbed_heap_size;
+extern unsigned char *mbed_heap2_start;
+extern uint32_t mbed_heap2_size;
+
+static mbed_stats_heap_region_t heap_region_stats[2];
+
+static mbed_stats_heap_region_t *heap_region_of(void *ptr) {
+    if (mbed_heap2_size &&
+        ((unsigned char *)ptr >= mbed_heap2_start) &&
+        ((unsigned char *)ptr < mbed_heap2_start + mbed_heap2_size)) {
+        return &heap_region_stats[1];
+    }
+    return &heap_region_stats[0];
+}
+
+/* Called with malloc_stats_mutex held */
+static void heap_region_alloc(void *ptr, size_t size) {
+    mbed_stats_heap_region_t *region = heap_region_of(ptr);
+    region->alloc_cnt += 1;
+    region->current_size += size;
+    if (region->current_size > region->max_size) {
+        region->max_size = region->current_size;
+    }
+}
+
+/* Called with malloc_stats_mutex held */
+static void heap_region_free(void *ptr, uint32_t size) {
+    mbed_stats_heap_region_t *region = heap_region_of(ptr);
+    region->alloc_cnt -= 1;
+    region->current_size -= size;
+}
 #endif
 
 void mbed_stats_heap_get(mbed_stats_heap_t *stats)
@@ -68,6 +156,45 @@ void mbed_stats_heap_get(mbed_stats_heap_t *stats)
 #endif
 }
 
+size_t mbed_stats_heap_sites_get(mbed_stats_heap_site_t *stats, size_t count)
+{
+    memset(stats, 0, count * sizeof(mbed_stats_heap_site_t));
+#if defined(MBED_HEAP_STATS_ENABLED) && MBED_CONF_PLATFORM_HEAP_STATS_MAX_SITES > 0
+    size_t i = 0;
+    malloc_stats_mutex->lock();
+    for (uint32_t site = 0; site < MBED_CONF_PLATFORM_HEAP_STATS_MAX_SITES && i < count; site++) {
+        if (heap_site_stats[site].caller != 0) {
+            memcpy(&stats[i++], &heap_site_stats[site], sizeof(mbed_stats_heap_site_t));
+        }
+    }
+    malloc_stats_mutex->unlock();
+    return i;
+#else
+    return 0;
+#endif
+}
+
+size_t mbed_stats_heap_regions_get(mbed_stats_heap_region_t *stats, size_t count)
+{
+    memset(stats, 0, count * sizeof(mbed_stats_heap_region_t));
+#ifdef MBED_HEAP_STATS_ENABLED
+    size_t i = 0;
+    malloc_stats_mutex->lock();
+    heap_region_stats[0].region_start = (uint32_t)(uintptr_t)mbed_heap_start;
+    heap_region_stats[0].reserved_size = mbed_heap_size;
+    heap_region_stats[1].region_start = (uint32_t)(uintptr_t)mbed_heap2_start;
+    heap_region_stats[1].reserved_size = mbed_heap2_size;
+    size_t regions = mbed_heap2_size ? 2 : 1;
+    for (size_t region = 0; region < regions && i < count; region++) {
+        memcpy(&stats[i++], &heap_region_stats[region], sizeof(mbed_stats_heap_region_t));
+    }
+    malloc_stats_mutex->unlock();
+    return i;
+#else
+    return 0;
+#endif
+}
+
 /******************************************************************************/
 /* GCC memory allocation wrappers                                             */
 /******************************************************************************/
@@ -96,6 +223,7 @@ extern "C" void * __wrap__malloc_r(struct _reent * r, size_t size) {
     alloc_info_t *alloc_info = (alloc_info_t*)__real__malloc_r(r, size + sizeof(alloc_info_t));
     if (alloc_info != NULL) {
         alloc_info->size = size;
+        alloc_info->pad = heap_site_alloc(MBED_CALLER_ADDR(), size);
         ptr = (void*)(alloc_info + 1);
         heap_stats.current_size += size;
         heap_stats.total_size += size;
@@ -103,6 +231,7 @@ extern "C" void * __wrap__malloc_r(struct _reent * r, size_t size) {
         if (heap_stats.current_size > heap_stats.max_size) {
             heap_stats.max_size = heap_stats.current_size;
         }
+        heap_region_alloc(alloc_info, size);
     } else {
         heap_stats.alloc_fail_cnt += 1;
     }
@@ -166,6 +295,8 @@ extern "C" void __wrap__free_r(struct _reent * r, void * ptr) {
         alloc_info = ((alloc_info_t*)ptr) - 1;
         heap_stats.current_size -= alloc_info->size;
         heap_stats.alloc_cnt -= 1;
+        heap_site_free(alloc_info->pad, alloc_info->size);
+        heap_region_free(alloc_info, alloc_info->size);
     }
     __real__free_r(r, (void*)alloc_info);
     malloc_stats_mutex->unlock();
@@ -249,6 +380,7 @@ extern "C" void* SUB_MALLOC(size_t size) {
     alloc_info_t *alloc_info = (alloc_info_t*)SUPER_MALLOC(size + sizeof(alloc_info_t));
     if (alloc_info != NULL) {
         alloc_info->size = size;
+        alloc_info->pad = heap_site_alloc(MBED_CALLER_ADDR(), size);
         ptr = (void*)(alloc_info + 1);
         heap_stats.current_size += size;
         heap_stats.total_size += size;
@@ -256,6 +388,7 @@ extern "C" void* SUB_MALLOC(size_t size) {
         if (heap_stats.current_size > heap_stats.max_size) {
             heap_stats.max_size = heap_stats.current_size;
         }
+        heap_region_alloc(alloc_info, size);
     } else {
         heap_stats.alloc_fail_cnt += 1;
     }
@@ -333,6 +466,8 @@ extern "C" void SUB_FREE(void *ptr) {
         alloc_info = ((alloc_info_t*)ptr) - 1;
         heap_stats.current_size -= alloc_info->size;
         heap_stats.alloc_cnt -= 1;
+        heap_site_free(alloc_info->pad, alloc_info->size);
+        heap_region_free(alloc_info, alloc_info->size);
     }
     SUPER_FREE((void*)alloc_info);
     malloc_stats_mutex->unlock();
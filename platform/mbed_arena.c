@@ -0,0 +1,78 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_arena.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+#include "platform/mbed_mem_trace.h"
+#include <string.h>
+
+/* Keep returned blocks as aligned as the heap's */
+#define ARENA_ALIGN 8
+
+void mbed_arena_init(mbed_arena_t *arena, void *buffer, size_t size)
+{
+    memset(arena, 0, sizeof(mbed_arena_t));
+    arena->buffer = buffer;
+    arena->size = size;
+}
+
+void *mbed_arena_alloc(mbed_arena_t *arena, size_t size)
+{
+    void *ptr = NULL;
+    size_t block = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    core_util_critical_section_enter();
+    /* The buffer itself may not be aligned - round the first allocation up */
+    size_t offset = arena->used;
+    size_t misalign = ((uintptr_t)arena->buffer + offset) & (ARENA_ALIGN - 1);
+    if (misalign) {
+        offset += ARENA_ALIGN - misalign;
+    }
+    if (offset <= arena->size && block <= arena->size - offset) {
+        ptr = arena->buffer + offset;
+        arena->used = offset + block;
+        arena->alloc_cnt += 1;
+        if (arena->used > arena->max_used) {
+            arena->max_used = arena->used;
+        }
+    } else {
+        arena->fail_cnt += 1;
+    }
+    core_util_critical_section_exit();
+
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_malloc(ptr, size, MBED_CALLER_ADDR());
+#endif
+    return ptr;
+}
+
+void mbed_arena_reset(mbed_arena_t *arena)
+{
+    core_util_critical_section_enter();
+    arena->used = 0;
+    arena->alloc_cnt = 0;
+    core_util_critical_section_exit();
+
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_free(arena->buffer, MBED_CALLER_ADDR());
+#endif
+}
+
+size_t mbed_arena_available(const mbed_arena_t *arena)
+{
+    return arena->size - arena->used;
+}
@@ -0,0 +1,92 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_ARENA_H
+#define MBED_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Arena (region) allocator over a caller-provided buffer.
+ *
+ * An arena hands out storage by bumping a pointer - allocation is O(1)
+ * and there is no per-block free. Instead the whole arena is recycled at
+ * once with mbed_arena_reset(). Components that allocate in bursts
+ * (parsers, request handlers) can carve their transient storage from an
+ * arena backed by a static buffer and leave the global heap untouched,
+ * so steady-state operation neither allocates nor fragments.
+ *
+ * Allocation and reset are interrupt safe. With MBED_MEM_TRACING_ENABLED
+ * defined, arena operations are reported through the mbed_mem_trace
+ * callback like heap operations.
+ */
+typedef struct mbed_arena_s {
+    uint8_t *buffer;        /**< Backing storage, provided by the caller. */
+    size_t size;            /**< Size of the backing storage in bytes. */
+    size_t used;            /**< Bytes handed out since init or the last reset. */
+    size_t max_used;        /**< High-water mark of used, across resets. */
+    uint32_t alloc_cnt;     /**< Allocations since init or the last reset. */
+    uint32_t fail_cnt;      /**< Allocations refused for lack of space, across resets. */
+} mbed_arena_t;
+
+/** Initialize an arena over a buffer
+ *
+ * @param arena     The arena to initialize
+ * @param buffer    Backing storage; must stay valid for the arena's lifetime
+ * @param size      Size of the backing storage in bytes
+ */
+void mbed_arena_init(mbed_arena_t *arena, void *buffer, size_t size);
+
+/** Allocate storage from an arena
+ *
+ * The returned block is 8-byte aligned. There is no matching free - the
+ * storage is reclaimed when the arena is reset.
+ *
+ * @param arena     The arena to allocate from
+ * @param size      Number of bytes to allocate
+ * @return          Pointer to the storage, or NULL if the arena is exhausted
+ */
+void *mbed_arena_alloc(mbed_arena_t *arena, size_t size);
+
+/** Recycle an arena, reclaiming all storage allocated from it
+ *
+ * Outstanding pointers into the arena become invalid. The high-water
+ * mark and failure count are kept so sizing can be verified in the field.
+ *
+ * @param arena     The arena to reset
+ */
+void mbed_arena_reset(mbed_arena_t *arena);
+
+/** Return the number of bytes still allocatable from an arena
+ *
+ * @param arena     The arena to query
+ * @return          Bytes remaining before mbed_arena_alloc returns NULL
+ */
+size_t mbed_arena_available(const mbed_arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
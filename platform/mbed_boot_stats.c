@@ -0,0 +1,105 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/mbed_boot_stats.h"
+
+#include <stdio.h>
+
+#ifdef MBED_BOOT_STATS_ENABLED
+
+#include "cmsis.h"
+
+#if defined(__CORTEX_M) && (__CORTEX_M >= 3)
+#define BOOT_STATS_HAVE_DWT 1
+#else
+#define BOOT_STATS_HAVE_DWT 0
+#endif
+
+static uint32_t boot_stage_cycles[MBED_BOOT_STAGE_COUNT];
+static uint8_t boot_stage_seen[MBED_BOOT_STAGE_COUNT];
+
+static const char *const boot_stage_names[MBED_BOOT_STAGE_COUNT] = {
+    "entry",
+    "stack/heap",
+    "sdk init",
+    "kernel init",
+    "rtos start",
+    "libc/c++ init",
+    "main",
+};
+
+void mbed_boot_stats_record(mbed_boot_stage_t stage)
+{
+    uint32_t cycles = 0;
+
+#if BOOT_STATS_HAVE_DWT
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    cycles = DWT->CYCCNT;
+#endif
+
+    if ((uint32_t)stage < MBED_BOOT_STAGE_COUNT && !boot_stage_seen[stage]) {
+        boot_stage_cycles[stage] = cycles;
+        boot_stage_seen[stage] = 1;
+    }
+}
+
+uint32_t mbed_boot_stats_get(mbed_boot_stage_t stage)
+{
+    if ((uint32_t)stage < MBED_BOOT_STAGE_COUNT && boot_stage_seen[stage]) {
+        return boot_stage_cycles[stage];
+    }
+    return 0;
+}
+
+void mbed_boot_stats_report(void)
+{
+    uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    uint32_t previous = 0;
+
+    if (cycles_per_us == 0) {
+        cycles_per_us = 1;
+    }
+
+    printf("boot stage            cycles      delta us\r\n");
+    for (uint32_t stage = 0; stage < MBED_BOOT_STAGE_COUNT; stage++) {
+        if (!boot_stage_seen[stage]) {
+            continue;
+        }
+        uint32_t cycles = boot_stage_cycles[stage];
+        printf("%-16s %11lu %13lu\r\n",
+               boot_stage_names[stage],
+               (unsigned long)cycles,
+               (unsigned long)((cycles - previous) / cycles_per_us));
+        previous = cycles;
+    }
+}
+
+#else
+
+uint32_t mbed_boot_stats_get(mbed_boot_stage_t stage)
+{
+    (void)stage;
+    return 0;
+}
+
+void mbed_boot_stats_report(void)
+{
+}
+
+#endif
@@ -0,0 +1,82 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BOOT_STATS_H
+#define MBED_BOOT_STATS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Stages of the boot sequence, in the order they complete.
+ *
+ * Timestamps are cycle counts from the DWT cycle counter, enabled at the
+ * first recorded stage; on cores without a DWT (Cortex-M0) all stages
+ * read as 0. The stages map onto the consolidated startup in
+ * rtos/mbed_boot.c; on the mbed 2 bare metal startup only ENTRY,
+ * SDK_INIT and MAIN are seen.
+ */
+typedef enum {
+    MBED_BOOT_STAGE_ENTRY = 0,   /**< Toolchain entry reached, RAM initialized */
+    MBED_BOOT_STAGE_STACK_HEAP,  /**< Stack and heap layout done */
+    MBED_BOOT_STAGE_SDK_INIT,    /**< mbed_sdk_init (target clocks and board) done */
+    MBED_BOOT_STAGE_KERNEL_INIT, /**< osKernelInitialize done */
+    MBED_BOOT_STAGE_RTOS_START,  /**< Kernel running, main thread scheduled */
+    MBED_BOOT_STAGE_LIBC_INIT,   /**< C library init and C++ static constructors done */
+    MBED_BOOT_STAGE_MAIN,        /**< main() entered */
+    MBED_BOOT_STAGE_COUNT
+} mbed_boot_stage_t;
+
+#ifdef MBED_BOOT_STATS_ENABLED
+
+/** Record the completion of a boot stage
+ *
+ * Called from the startup code; the first recorded occurrence of a stage
+ * wins, later calls are ignored.
+ *
+ * @param stage The stage that has just completed
+ */
+void mbed_boot_stats_record(mbed_boot_stage_t stage);
+
+#else
+#define mbed_boot_stats_record(stage) ((void)(stage))
+#endif
+
+/** Get the timestamp of a boot stage
+ *
+ * @param stage The stage to query
+ * @return Cycle count at the end of the stage, 0 when the stage was not
+ *         recorded or boot stats are disabled
+ */
+uint32_t mbed_boot_stats_get(mbed_boot_stage_t stage);
+
+/** Print a table of the recorded boot stages
+ *
+ * Each recorded stage is printed with its cycle count and the time spent
+ * since the previous recorded stage, converted with SystemCoreClock.
+ */
+void mbed_boot_stats_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
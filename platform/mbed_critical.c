@@ -22,10 +22,57 @@
 #include "cmsis.h"
 #include "platform/mbed_assert.h"
 #include "platform/mbed_toolchain.h"
+#include "platform/mbed_stats.h"
+#include <string.h>
 
 static volatile uint32_t interrupt_enable_counter = 0;
 static volatile bool critical_interrupts_disabled = false;
 
+#ifdef MBED_CRITICAL_STATS_ENABLED
+#ifndef MBED_CONF_PLATFORM_CRITICAL_STATS_MAX_SITES
+#define MBED_CONF_PLATFORM_CRITICAL_STATS_MAX_SITES 16
+#endif
+
+static mbed_stats_critical_t critical_stats_table[MBED_CONF_PLATFORM_CRITICAL_STATS_MAX_SITES];
+static uint32_t critical_enter_cycles = 0;
+static uint32_t critical_enter_caller = 0;
+
+/* Read the DWT cycle counter, starting it on first use - same lazy enable
+ * as the CPU stats hook in mbed_rtx_handlers.c */
+static uint32_t critical_stats_cycles(void)
+{
+#if defined(DWT) && defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+/* Account a finished masked window to its enter site. Runs with interrupts
+ * still disabled, so the table needs no further protection. */
+static void critical_stats_update(uint32_t cycles)
+{
+    for (uint32_t i = 0; i < MBED_CONF_PLATFORM_CRITICAL_STATS_MAX_SITES; i++) {
+        mbed_stats_critical_t *site = &critical_stats_table[i];
+        if (site->caller != critical_enter_caller && site->caller != 0) {
+            continue;
+        }
+        site->caller = critical_enter_caller;
+        site->enter_cnt += 1;
+        site->total_cycles += cycles;
+        if (cycles > site->max_cycles) {
+            site->max_cycles = cycles;
+        }
+        return;
+    }
+    /* Table full - windows from further sites go unaccounted */
+}
+#endif /* MBED_CRITICAL_STATS_ENABLED */
+
 bool core_util_are_interrupts_enabled(void)
 {
 #if defined(__CORTEX_A9)
@@ -59,6 +106,10 @@ MBED_WEAK void core_util_critical_section_enter(void)
     /* Save the interrupt disabled state as it was prior to any nested critical section lock use */
     if (!interrupt_enable_counter) {
         critical_interrupts_disabled = interrupts_disabled;
+#ifdef MBED_CRITICAL_STATS_ENABLED
+        critical_enter_cycles = critical_stats_cycles();
+        critical_enter_caller = (uint32_t)(uintptr_t)MBED_CALLER_ADDR();
+#endif
     }
 
     /* If the interrupt_enable_counter overflows or we are in a nested critical section and interrupts
@@ -96,6 +147,9 @@ MBED_WEAK void core_util_critical_section_exit(void)
            interrupts were enabled on entry to the first critical section.
         */
         if (!interrupt_enable_counter && !critical_interrupts_disabled) {
+#ifdef MBED_CRITICAL_STATS_ENABLED
+            critical_stats_update(critical_stats_cycles() - critical_enter_cycles);
+#endif
             __enable_irq();
         }
     }
@@ -200,6 +254,114 @@ uint32_t core_util_atomic_decr_u32(uint32_t *valuePtr, uint32_t delta)
     return newValue;
 }
 
+uint8_t core_util_atomic_exchange_u8(uint8_t *valuePtr, uint8_t desiredValue)
+{
+    uint8_t oldValue;
+    do {
+        oldValue = __LDREXB((volatile uint8_t*)valuePtr);
+    } while (__STREXB(desiredValue, (volatile uint8_t*)valuePtr));
+    return oldValue;
+}
+
+uint16_t core_util_atomic_exchange_u16(uint16_t *valuePtr, uint16_t desiredValue)
+{
+    uint16_t oldValue;
+    do {
+        oldValue = __LDREXH((volatile uint16_t*)valuePtr);
+    } while (__STREXH(desiredValue, (volatile uint16_t*)valuePtr));
+    return oldValue;
+}
+
+uint32_t core_util_atomic_exchange_u32(uint32_t *valuePtr, uint32_t desiredValue)
+{
+    uint32_t oldValue;
+    do {
+        oldValue = __LDREXW((volatile uint32_t*)valuePtr);
+    } while (__STREXW(desiredValue, (volatile uint32_t*)valuePtr));
+    return oldValue;
+}
+
+uint8_t core_util_atomic_fetch_or_u8(uint8_t *valuePtr, uint8_t arg)
+{
+    uint8_t oldValue;
+    do {
+        oldValue = __LDREXB((volatile uint8_t*)valuePtr);
+    } while (__STREXB(oldValue | arg, (volatile uint8_t*)valuePtr));
+    return oldValue;
+}
+
+uint16_t core_util_atomic_fetch_or_u16(uint16_t *valuePtr, uint16_t arg)
+{
+    uint16_t oldValue;
+    do {
+        oldValue = __LDREXH((volatile uint16_t*)valuePtr);
+    } while (__STREXH(oldValue | arg, (volatile uint16_t*)valuePtr));
+    return oldValue;
+}
+
+uint32_t core_util_atomic_fetch_or_u32(uint32_t *valuePtr, uint32_t arg)
+{
+    uint32_t oldValue;
+    do {
+        oldValue = __LDREXW((volatile uint32_t*)valuePtr);
+    } while (__STREXW(oldValue | arg, (volatile uint32_t*)valuePtr));
+    return oldValue;
+}
+
+uint8_t core_util_atomic_fetch_and_u8(uint8_t *valuePtr, uint8_t arg)
+{
+    uint8_t oldValue;
+    do {
+        oldValue = __LDREXB((volatile uint8_t*)valuePtr);
+    } while (__STREXB(oldValue & arg, (volatile uint8_t*)valuePtr));
+    return oldValue;
+}
+
+uint16_t core_util_atomic_fetch_and_u16(uint16_t *valuePtr, uint16_t arg)
+{
+    uint16_t oldValue;
+    do {
+        oldValue = __LDREXH((volatile uint16_t*)valuePtr);
+    } while (__STREXH(oldValue & arg, (volatile uint16_t*)valuePtr));
+    return oldValue;
+}
+
+uint32_t core_util_atomic_fetch_and_u32(uint32_t *valuePtr, uint32_t arg)
+{
+    uint32_t oldValue;
+    do {
+        oldValue = __LDREXW((volatile uint32_t*)valuePtr);
+    } while (__STREXW(oldValue & arg, (volatile uint32_t*)valuePtr));
+    return oldValue;
+}
+
+uint8_t core_util_atomic_fetch_xor_u8(uint8_t *valuePtr, uint8_t arg)
+{
+    uint8_t oldValue;
+    do {
+        oldValue = __LDREXB((volatile uint8_t*)valuePtr);
+    } while (__STREXB(oldValue ^ arg, (volatile uint8_t*)valuePtr));
+    return oldValue;
+}
+
+uint16_t core_util_atomic_fetch_xor_u16(uint16_t *valuePtr, uint16_t arg)
+{
+    uint16_t oldValue;
+    do {
+        oldValue = __LDREXH((volatile uint16_t*)valuePtr);
+    } while (__STREXH(oldValue ^ arg, (volatile uint16_t*)valuePtr));
+    return oldValue;
+}
+
+uint32_t core_util_atomic_fetch_xor_u32(uint32_t *valuePtr, uint32_t arg)
+{
+    uint32_t oldValue;
+    do {
+        oldValue = __LDREXW((volatile uint32_t*)valuePtr);
+    } while (__STREXW(oldValue ^ arg, (volatile uint32_t*)valuePtr));
+    return oldValue;
+}
+
 #else
 
 bool core_util_atomic_cas_u8(uint8_t *ptr, uint8_t *expectedCurrentValue, uint8_t desiredValue)
@@ -316,6 +478,126 @@ uint32_t core_util_atomic_decr_u32(uint32_t *valuePtr, uint32_t delta)
     return newValue;
 }
 
+uint8_t core_util_atomic_exchange_u8(uint8_t *valuePtr, uint8_t desiredValue)
+{
+    uint8_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = desiredValue;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint16_t core_util_atomic_exchange_u16(uint16_t *valuePtr, uint16_t desiredValue)
+{
+    uint16_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = desiredValue;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint32_t core_util_atomic_exchange_u32(uint32_t *valuePtr, uint32_t desiredValue)
+{
+    uint32_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = desiredValue;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint8_t core_util_atomic_fetch_or_u8(uint8_t *valuePtr, uint8_t arg)
+{
+    uint8_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue | arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint16_t core_util_atomic_fetch_or_u16(uint16_t *valuePtr, uint16_t arg)
+{
+    uint16_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue | arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint32_t core_util_atomic_fetch_or_u32(uint32_t *valuePtr, uint32_t arg)
+{
+    uint32_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue | arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint8_t core_util_atomic_fetch_and_u8(uint8_t *valuePtr, uint8_t arg)
+{
+    uint8_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue & arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint16_t core_util_atomic_fetch_and_u16(uint16_t *valuePtr, uint16_t arg)
+{
+    uint16_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue & arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint32_t core_util_atomic_fetch_and_u32(uint32_t *valuePtr, uint32_t arg)
+{
+    uint32_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue & arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint8_t core_util_atomic_fetch_xor_u8(uint8_t *valuePtr, uint8_t arg)
+{
+    uint8_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue ^ arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint16_t core_util_atomic_fetch_xor_u16(uint16_t *valuePtr, uint16_t arg)
+{
+    uint16_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue ^ arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint32_t core_util_atomic_fetch_xor_u32(uint32_t *valuePtr, uint32_t arg)
+{
+    uint32_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue ^ arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
 #endif
 
 
@@ -334,3 +616,271 @@ void *core_util_atomic_decr_ptr(void **valuePtr, ptrdiff_t delta) {
     return (void *)core_util_atomic_decr_u32((uint32_t *)valuePtr, (uint32_t)delta);
 }
 
+/* Aligned accesses up to the word size are single-copy atomic on all
+ * supported cores, so loads and stores only need barriers for ordering:
+ * acquire orders everything after the load, release everything before
+ * the store. The relaxed variants are the bare access. */
+
+static void atomic_order_barrier(mbed_memory_order order)
+{
+    if (order != mbed_memory_order_relaxed) {
+        __DMB();
+    }
+}
+
+uint8_t core_util_atomic_load_u8(const volatile uint8_t *valuePtr)
+{
+    return core_util_atomic_load_explicit_u8(valuePtr, mbed_memory_order_seq_cst);
+}
+
+uint16_t core_util_atomic_load_u16(const volatile uint16_t *valuePtr)
+{
+    return core_util_atomic_load_explicit_u16(valuePtr, mbed_memory_order_seq_cst);
+}
+
+uint32_t core_util_atomic_load_u32(const volatile uint32_t *valuePtr)
+{
+    return core_util_atomic_load_explicit_u32(valuePtr, mbed_memory_order_seq_cst);
+}
+
+uint64_t core_util_atomic_load_u64(const volatile uint64_t *valuePtr)
+{
+    return core_util_atomic_load_explicit_u64(valuePtr, mbed_memory_order_seq_cst);
+}
+
+void *core_util_atomic_load_ptr(void *const volatile *valuePtr)
+{
+    return (void *)core_util_atomic_load_explicit_u32((const volatile uint32_t *)valuePtr, mbed_memory_order_seq_cst);
+}
+
+uint8_t core_util_atomic_load_explicit_u8(const volatile uint8_t *valuePtr, mbed_memory_order order)
+{
+    uint8_t value = *valuePtr;
+    atomic_order_barrier(order);
+    return value;
+}
+
+uint16_t core_util_atomic_load_explicit_u16(const volatile uint16_t *valuePtr, mbed_memory_order order)
+{
+    uint16_t value = *valuePtr;
+    atomic_order_barrier(order);
+    return value;
+}
+
+uint32_t core_util_atomic_load_explicit_u32(const volatile uint32_t *valuePtr, mbed_memory_order order)
+{
+    uint32_t value = *valuePtr;
+    atomic_order_barrier(order);
+    return value;
+}
+
+uint64_t core_util_atomic_load_explicit_u64(const volatile uint64_t *valuePtr, mbed_memory_order order)
+{
+    /* no doubleword exclusive on M-profile - a 64-bit access is not
+     * single-copy atomic, so it must be read under the critical section */
+    uint64_t value;
+    core_util_critical_section_enter();
+    value = *valuePtr;
+    core_util_critical_section_exit();
+    atomic_order_barrier(order);
+    return value;
+}
+
+void core_util_atomic_store_u8(volatile uint8_t *valuePtr, uint8_t desiredValue)
+{
+    core_util_atomic_store_explicit_u8(valuePtr, desiredValue, mbed_memory_order_seq_cst);
+}
+
+void core_util_atomic_store_u16(volatile uint16_t *valuePtr, uint16_t desiredValue)
+{
+    core_util_atomic_store_explicit_u16(valuePtr, desiredValue, mbed_memory_order_seq_cst);
+}
+
+void core_util_atomic_store_u32(volatile uint32_t *valuePtr, uint32_t desiredValue)
+{
+    core_util_atomic_store_explicit_u32(valuePtr, desiredValue, mbed_memory_order_seq_cst);
+}
+
+void core_util_atomic_store_u64(volatile uint64_t *valuePtr, uint64_t desiredValue)
+{
+    core_util_atomic_store_explicit_u64(valuePtr, desiredValue, mbed_memory_order_seq_cst);
+}
+
+void core_util_atomic_store_ptr(void *volatile *valuePtr, void *desiredValue)
+{
+    core_util_atomic_store_explicit_u32((volatile uint32_t *)valuePtr, (uint32_t)desiredValue, mbed_memory_order_seq_cst);
+}
+
+void core_util_atomic_store_explicit_u8(volatile uint8_t *valuePtr, uint8_t desiredValue, mbed_memory_order order)
+{
+    atomic_order_barrier(order);
+    *valuePtr = desiredValue;
+    if (order == mbed_memory_order_seq_cst) {
+        __DMB();
+    }
+}
+
+void core_util_atomic_store_explicit_u16(volatile uint16_t *valuePtr, uint16_t desiredValue, mbed_memory_order order)
+{
+    atomic_order_barrier(order);
+    *valuePtr = desiredValue;
+    if (order == mbed_memory_order_seq_cst) {
+        __DMB();
+    }
+}
+
+void core_util_atomic_store_explicit_u32(volatile uint32_t *valuePtr, uint32_t desiredValue, mbed_memory_order order)
+{
+    atomic_order_barrier(order);
+    *valuePtr = desiredValue;
+    if (order == mbed_memory_order_seq_cst) {
+        __DMB();
+    }
+}
+
+void core_util_atomic_store_explicit_u64(volatile uint64_t *valuePtr, uint64_t desiredValue, mbed_memory_order order)
+{
+    atomic_order_barrier(order);
+    core_util_critical_section_enter();
+    *valuePtr = desiredValue;
+    core_util_critical_section_exit();
+    if (order == mbed_memory_order_seq_cst) {
+        __DMB();
+    }
+}
+
+void *core_util_atomic_exchange_ptr(void **valuePtr, void *desiredValue)
+{
+    return (void *)core_util_atomic_exchange_u32((uint32_t *)valuePtr, (uint32_t)desiredValue);
+}
+
+/* The 64-bit read-modify-write operations use the critical section on
+ * every core: the Cortex-M exclusive monitor is at most 32 bits wide */
+
+bool core_util_atomic_cas_u64(uint64_t *ptr, uint64_t *expectedCurrentValue, uint64_t desiredValue)
+{
+    bool success;
+    uint64_t currentValue;
+    core_util_critical_section_enter();
+    currentValue = *ptr;
+    if (currentValue == *expectedCurrentValue) {
+        *ptr = desiredValue;
+        success = true;
+    } else {
+        *expectedCurrentValue = currentValue;
+        success = false;
+    }
+    core_util_critical_section_exit();
+    return success;
+}
+
+uint64_t core_util_atomic_incr_u64(uint64_t *valuePtr, uint64_t delta)
+{
+    uint64_t newValue;
+    core_util_critical_section_enter();
+    newValue = *valuePtr + delta;
+    *valuePtr = newValue;
+    core_util_critical_section_exit();
+    return newValue;
+}
+
+uint64_t core_util_atomic_decr_u64(uint64_t *valuePtr, uint64_t delta)
+{
+    uint64_t newValue;
+    core_util_critical_section_enter();
+    newValue = *valuePtr - delta;
+    *valuePtr = newValue;
+    core_util_critical_section_exit();
+    return newValue;
+}
+
+uint64_t core_util_atomic_exchange_u64(uint64_t *valuePtr, uint64_t desiredValue)
+{
+    uint64_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = desiredValue;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint64_t core_util_atomic_fetch_or_u64(uint64_t *valuePtr, uint64_t arg)
+{
+    uint64_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue | arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint64_t core_util_atomic_fetch_and_u64(uint64_t *valuePtr, uint64_t arg)
+{
+    uint64_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue & arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+uint64_t core_util_atomic_fetch_xor_u64(uint64_t *valuePtr, uint64_t arg)
+{
+    uint64_t oldValue;
+    core_util_critical_section_enter();
+    oldValue = *valuePtr;
+    *valuePtr = oldValue ^ arg;
+    core_util_critical_section_exit();
+    return oldValue;
+}
+
+/* The spinlocks ride on the atomics above: exclusive-access builds get a
+ * true multi-core-safe lock, critical-section builds degrade to the same
+ * single-core guarantees the rest of this file provides. */
+
+void core_util_spinlock_init(core_util_spinlock_t *lock)
+{
+    lock->lock = 0;
+}
+
+bool core_util_spinlock_try_lock(core_util_spinlock_t *lock)
+{
+    uint8_t expected = 0;
+    if (!core_util_atomic_cas_u8((uint8_t *)&lock->lock, &expected, 1)) {
+        return false;
+    }
+    __DMB();
+    return true;
+}
+
+void core_util_spinlock_lock(core_util_spinlock_t *lock)
+{
+    while (!core_util_spinlock_try_lock(lock)) {
+        /* spin - the holder is another core or will be preempted */
+    }
+}
+
+void core_util_spinlock_unlock(core_util_spinlock_t *lock)
+{
+    __DMB();
+    lock->lock = 0;
+}
+
+size_t mbed_stats_critical_get_each(mbed_stats_critical_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    size_t i = 0;
+    memset(stats, 0, count * sizeof(mbed_stats_critical_t));
+#ifdef MBED_CRITICAL_STATS_ENABLED
+    core_util_critical_section_enter();
+    for (uint32_t t = 0; t < MBED_CONF_PLATFORM_CRITICAL_STATS_MAX_SITES && i < count; t++) {
+        if (critical_stats_table[t].caller != 0) {
+            stats[i] = critical_stats_table[t];
+            i++;
+        }
+    }
+    core_util_critical_section_exit();
+#endif
+    return i;
+}
+
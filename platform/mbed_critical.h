@@ -360,6 +360,256 @@ uint32_t core_util_atomic_decr_u32(uint32_t *valuePtr, uint32_t delta);
  */
 void *core_util_atomic_decr_ptr(void **valuePtr, ptrdiff_t delta);
 
+/**
+ * Memory ordering constraints for the _explicit atomic variants.
+ *
+ * The plain (non-_explicit) loads and stores are sequentially
+ * consistent. Relaxed accesses guarantee atomicity only and let the
+ * compiler and hardware reorder freely around them - right for
+ * statistics counters and the data words of a sequence lock. Acquire
+ * applies to loads, release to stores, pairing so that everything
+ * written before a release store is visible after the acquire load
+ * that reads it.
+ */
+typedef enum mbed_memory_order {
+    mbed_memory_order_relaxed,
+    mbed_memory_order_acquire,
+    mbed_memory_order_release,
+    mbed_memory_order_seq_cst
+} mbed_memory_order;
+
+/**
+ * Atomic load.
+ * @param  valuePtr Target memory location.
+ * @return          The loaded value.
+ */
+uint8_t core_util_atomic_load_u8(const volatile uint8_t *valuePtr);
+
+/** \copydoc core_util_atomic_load_u8 */
+uint16_t core_util_atomic_load_u16(const volatile uint16_t *valuePtr);
+
+/** \copydoc core_util_atomic_load_u8 */
+uint32_t core_util_atomic_load_u32(const volatile uint32_t *valuePtr);
+
+/** \copydoc core_util_atomic_load_u8 */
+uint64_t core_util_atomic_load_u64(const volatile uint64_t *valuePtr);
+
+/** \copydoc core_util_atomic_load_u8 */
+void *core_util_atomic_load_ptr(void *const volatile *valuePtr);
+
+/**
+ * Atomic load with explicit ordering.
+ * @param  valuePtr Target memory location.
+ * @param  order    mbed_memory_order_relaxed, _acquire or _seq_cst.
+ * @return          The loaded value.
+ */
+uint8_t core_util_atomic_load_explicit_u8(const volatile uint8_t *valuePtr, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_load_explicit_u8 */
+uint16_t core_util_atomic_load_explicit_u16(const volatile uint16_t *valuePtr, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_load_explicit_u8 */
+uint32_t core_util_atomic_load_explicit_u32(const volatile uint32_t *valuePtr, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_load_explicit_u8 */
+uint64_t core_util_atomic_load_explicit_u64(const volatile uint64_t *valuePtr, mbed_memory_order order);
+
+/**
+ * Atomic store.
+ * @param  valuePtr     Target memory location.
+ * @param  desiredValue The value to store.
+ */
+void core_util_atomic_store_u8(volatile uint8_t *valuePtr, uint8_t desiredValue);
+
+/** \copydoc core_util_atomic_store_u8 */
+void core_util_atomic_store_u16(volatile uint16_t *valuePtr, uint16_t desiredValue);
+
+/** \copydoc core_util_atomic_store_u8 */
+void core_util_atomic_store_u32(volatile uint32_t *valuePtr, uint32_t desiredValue);
+
+/** \copydoc core_util_atomic_store_u8 */
+void core_util_atomic_store_u64(volatile uint64_t *valuePtr, uint64_t desiredValue);
+
+/** \copydoc core_util_atomic_store_u8 */
+void core_util_atomic_store_ptr(void *volatile *valuePtr, void *desiredValue);
+
+/**
+ * Atomic store with explicit ordering.
+ * @param  valuePtr     Target memory location.
+ * @param  desiredValue The value to store.
+ * @param  order        mbed_memory_order_relaxed, _release or _seq_cst.
+ */
+void core_util_atomic_store_explicit_u8(volatile uint8_t *valuePtr, uint8_t desiredValue, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_store_explicit_u8 */
+void core_util_atomic_store_explicit_u16(volatile uint16_t *valuePtr, uint16_t desiredValue, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_store_explicit_u8 */
+void core_util_atomic_store_explicit_u32(volatile uint32_t *valuePtr, uint32_t desiredValue, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_store_explicit_u8 */
+void core_util_atomic_store_explicit_u64(volatile uint64_t *valuePtr, uint64_t desiredValue, mbed_memory_order order);
+
+/**
+ * Atomic exchange.
+ * @param  valuePtr     Target memory location.
+ * @param  desiredValue The value to store.
+ * @return              The value held before the exchange.
+ */
+uint8_t core_util_atomic_exchange_u8(uint8_t *valuePtr, uint8_t desiredValue);
+
+/** \copydoc core_util_atomic_exchange_u8 */
+uint16_t core_util_atomic_exchange_u16(uint16_t *valuePtr, uint16_t desiredValue);
+
+/** \copydoc core_util_atomic_exchange_u8 */
+uint32_t core_util_atomic_exchange_u32(uint32_t *valuePtr, uint32_t desiredValue);
+
+/** \copydoc core_util_atomic_exchange_u8 */
+uint64_t core_util_atomic_exchange_u64(uint64_t *valuePtr, uint64_t desiredValue);
+
+/** \copydoc core_util_atomic_exchange_u8 */
+void *core_util_atomic_exchange_ptr(void **valuePtr, void *desiredValue);
+
+/**
+ * Atomic bitwise OR.
+ * @param  valuePtr Target memory location.
+ * @param  arg      The value to OR in.
+ * @return          The value held before the operation.
+ *
+ * @note The fetch_ operations return the previous value, following the
+ *       C11 convention; incr and decr return the new value.
+ */
+uint8_t core_util_atomic_fetch_or_u8(uint8_t *valuePtr, uint8_t arg);
+
+/** \copydoc core_util_atomic_fetch_or_u8 */
+uint16_t core_util_atomic_fetch_or_u16(uint16_t *valuePtr, uint16_t arg);
+
+/** \copydoc core_util_atomic_fetch_or_u8 */
+uint32_t core_util_atomic_fetch_or_u32(uint32_t *valuePtr, uint32_t arg);
+
+/** \copydoc core_util_atomic_fetch_or_u8 */
+uint64_t core_util_atomic_fetch_or_u64(uint64_t *valuePtr, uint64_t arg);
+
+/**
+ * Atomic bitwise AND.
+ * @param  valuePtr Target memory location.
+ * @param  arg      The value to AND in.
+ * @return          The value held before the operation.
+ */
+uint8_t core_util_atomic_fetch_and_u8(uint8_t *valuePtr, uint8_t arg);
+
+/** \copydoc core_util_atomic_fetch_and_u8 */
+uint16_t core_util_atomic_fetch_and_u16(uint16_t *valuePtr, uint16_t arg);
+
+/** \copydoc core_util_atomic_fetch_and_u8 */
+uint32_t core_util_atomic_fetch_and_u32(uint32_t *valuePtr, uint32_t arg);
+
+/** \copydoc core_util_atomic_fetch_and_u8 */
+uint64_t core_util_atomic_fetch_and_u64(uint64_t *valuePtr, uint64_t arg);
+
+/**
+ * Atomic bitwise XOR.
+ * @param  valuePtr Target memory location.
+ * @param  arg      The value to XOR in.
+ * @return          The value held before the operation.
+ */
+uint8_t core_util_atomic_fetch_xor_u8(uint8_t *valuePtr, uint8_t arg);
+
+/** \copydoc core_util_atomic_fetch_xor_u8 */
+uint16_t core_util_atomic_fetch_xor_u16(uint16_t *valuePtr, uint16_t arg);
+
+/** \copydoc core_util_atomic_fetch_xor_u8 */
+uint32_t core_util_atomic_fetch_xor_u32(uint32_t *valuePtr, uint32_t arg);
+
+/** \copydoc core_util_atomic_fetch_xor_u8 */
+uint64_t core_util_atomic_fetch_xor_u64(uint64_t *valuePtr, uint64_t arg);
+
+/**
+ * Atomic compare and set, 64-bit. See core_util_atomic_cas_u32 for the
+ * full contract.
+ *
+ * @note The Cortex-M exclusive monitor is 32-bit wide, so all 64-bit
+ *       operations are carried out in a critical section even on cores
+ *       with exclusive access support.
+ *
+ * @param  ptr                  The target memory location.
+ * @param[in,out] expectedCurrentValue Expected value; updated with the
+ *                              current value on failure.
+ * @param[in] desiredValue      The new value to set.
+ * @return                      true if the value was updated.
+ */
+bool core_util_atomic_cas_u64(uint64_t *ptr, uint64_t *expectedCurrentValue, uint64_t desiredValue);
+
+/**
+ * Atomic increment, 64-bit.
+ * @param  valuePtr Target memory location being incremented.
+ * @param  delta    The amount being incremented.
+ * @return          The new incremented value.
+ */
+uint64_t core_util_atomic_incr_u64(uint64_t *valuePtr, uint64_t delta);
+
+/**
+ * Atomic decrement, 64-bit.
+ * @param  valuePtr Target memory location being decremented.
+ * @param  delta    The amount being decremented.
+ * @return          The new decremented value.
+ */
+uint64_t core_util_atomic_decr_u64(uint64_t *valuePtr, uint64_t delta);
+
+/**
+ * Lock type for the spinlock primitives below.
+ *
+ * Statically initialize with CORE_UTIL_SPINLOCK_INIT, or dynamically with
+ * core_util_spinlock_init().
+ */
+typedef struct core_util_spinlock {
+    volatile uint8_t lock;
+} core_util_spinlock_t;
+
+#define CORE_UTIL_SPINLOCK_INIT { 0 }
+
+/** Initialize a spinlock to the unlocked state
+  *
+  * @param lock The lock to initialize
+  */
+void core_util_spinlock_init(core_util_spinlock_t *lock);
+
+/** Attempt to acquire a spinlock without spinning
+  *
+  * Built on the exclusive-access atomics, so on multi-core parts the
+  * acquisition is visible to and safe against the other core, unlike a
+  * critical section which only masks the local core's interrupts. On
+  * single-core builds an uncontended acquisition is a single
+  * compare-and-set.
+  *
+  * @note Spinlocks do not mask interrupts. A lock shared with interrupt
+  * handlers must be taken with interrupts masked (wrap the acquisition in
+  * core_util_critical_section_enter/exit), or the spin can deadlock against
+  * the local core's own handler.
+  *
+  * @param lock The lock to acquire
+  * @return true if the lock was acquired, false if it is held elsewhere
+  */
+bool core_util_spinlock_try_lock(core_util_spinlock_t *lock);
+
+/** Acquire a spinlock, spinning until it becomes available
+  *
+  * See core_util_spinlock_try_lock() for the interrupt-masking caveat.
+  *
+  * @param lock The lock to acquire
+  */
+void core_util_spinlock_lock(core_util_spinlock_t *lock);
+
+/** Release a spinlock acquired with core_util_spinlock_lock() or
+  * core_util_spinlock_try_lock()
+  *
+  * Writes made while holding the lock are visible to the next acquirer
+  * before the release is.
+  *
+  * @param lock The lock to release
+  */
+void core_util_spinlock_unlock(core_util_spinlock_t *lock);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,74 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/mbed_deferred_init.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+
+#include <stddef.h>
+
+static mbed_deferred_init_t *deferred_init_head;
+
+void mbed_deferred_init_register(mbed_deferred_init_t *entry)
+{
+    mbed_deferred_init_t *node;
+
+    MBED_ASSERT(entry->fn != NULL);
+
+    core_util_critical_section_enter();
+    for (node = deferred_init_head; node != NULL; node = node->next) {
+        if (node == entry) {
+            core_util_critical_section_exit();
+            return;
+        }
+    }
+    entry->next = deferred_init_head;
+    deferred_init_head = entry;
+    core_util_critical_section_exit();
+}
+
+void mbed_deferred_init_run(mbed_deferred_init_t *entry)
+{
+    /* Claim the entry under the critical section but run the
+     * initialization outside it - constructors are free to allocate,
+     * take mutexes or wait.
+     */
+    core_util_critical_section_enter();
+    if (entry->done) {
+        core_util_critical_section_exit();
+        return;
+    }
+    entry->done = 1;
+    core_util_critical_section_exit();
+
+    entry->fn(entry->context);
+}
+
+void mbed_deferred_init_run_all(void)
+{
+    mbed_deferred_init_t *node;
+
+    /* The list only ever grows at the head, so it can be walked without
+     * holding a lock; mbed_deferred_init_run arbitrates each entry.
+     */
+    core_util_critical_section_enter();
+    node = deferred_init_head;
+    core_util_critical_section_exit();
+
+    while (node != NULL) {
+        mbed_deferred_init_run(node);
+        node = node->next;
+    }
+}
@@ -0,0 +1,81 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DEFERRED_INIT_H
+#define MBED_DEFERRED_INIT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initialization function of a deferred subsystem
+ *
+ * @param context Opaque pointer passed through from the registry entry
+ */
+typedef void (*mbed_deferred_init_fn)(void *context);
+
+/** Registry entry for a subsystem whose initialization is deferred
+ *
+ * Place in zero-initialized storage and fill in fn and context before
+ * registering; the registry owns the remaining fields.
+ */
+typedef struct mbed_deferred_init_s {
+    mbed_deferred_init_fn fn;          /**< Initialization to run */
+    void *context;                     /**< Passed to fn */
+    uint32_t done;                     /**< Non-zero once fn has run */
+    struct mbed_deferred_init_s *next; /**< Registry list link */
+} mbed_deferred_init_t;
+
+/** Add a subsystem to the deferred initialization registry
+ *
+ * Registration is cheap - a couple of pointer stores under a critical
+ * section - so it can be done early in boot where the initialization
+ * itself would be too slow. Registering an entry twice is a no-op.
+ *
+ * @param entry The entry to register, with fn and context filled in
+ */
+void mbed_deferred_init_register(mbed_deferred_init_t *entry);
+
+/** Run one deferred initialization if it has not run yet
+ *
+ * The initialization runs exactly once; the entry does not need to be
+ * registered. A concurrent caller that loses the race returns without
+ * waiting for the initialization to complete - first-use paths that
+ * must observe a fully constructed object should go through
+ * DeferredInit<T>::get(), which adds that guarantee.
+ *
+ * @param entry The entry to run
+ */
+void mbed_deferred_init_run(mbed_deferred_init_t *entry);
+
+/** Run every registered initialization that is still pending
+ *
+ * Call from a background or idle context - for example queued on the
+ * shared event queue after main() starts - to front-load construction
+ * so later first uses do not pay for it.
+ */
+void mbed_deferred_init_run_all(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
@@ -19,6 +19,7 @@
 #include "platform/mbed_toolchain.h"
 #include "platform/mbed_error.h"
 #include "platform/mbed_interface.h"
+#include "platform/mbed_flight_recorder.h"
 #if DEVICE_STDIO_MESSAGES
 #include <stdio.h>
 #endif
@@ -33,6 +34,13 @@ WEAK void error(const char* format, ...) {
     }
     error_in_progress = 1;
 
+    // Preserve the events leading up to the failure before anything else
+    // runs; the frozen trace survives a RAM-preserving reset
+    MBED_FLIGHT_EVENT(MBED_FLIGHT_TYPE_ERROR, format);
+#ifdef MBED_FLIGHT_RECORDER_ENABLED
+    mbed_flight_recorder_freeze();
+#endif
+
 #ifndef NDEBUG
     va_list arg;
     va_start(arg, format);
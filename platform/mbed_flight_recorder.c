@@ -0,0 +1,184 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/mbed_flight_recorder.h"
+
+#ifdef MBED_FLIGHT_RECORDER_ENABLED
+
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+#include "platform/mbed_assert.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef TARGET_LIKE_MBED
+#include "cmsis.h"
+#endif
+
+#ifndef MBED_CONF_PLATFORM_FLIGHT_RECORDER_RECORDS
+#define MBED_CONF_PLATFORM_FLIGHT_RECORDER_RECORDS 128
+#endif
+
+MBED_STATIC_ASSERT((MBED_CONF_PLATFORM_FLIGHT_RECORDER_RECORDS &
+                    (MBED_CONF_PLATFORM_FLIGHT_RECORDER_RECORDS - 1)) == 0,
+                   "platform.flight-recorder-records must be a power of two");
+
+#define FLIGHT_RING_MASK (MBED_CONF_PLATFORM_FLIGHT_RECORDER_RECORDS - 1)
+
+/* Distinguishes a ring that survived a RAM-preserving reset from the
+ * garbage a cold boot leaves behind. */
+#define FLIGHT_MAGIC_ARMED  0xF117DA7Au
+#define FLIGHT_MAGIC_FROZEN 0xF117DEADu
+
+typedef struct {
+    uint32_t magic;
+    uint32_t next;  /* records ever written; free running */
+    mbed_flight_record_t records[MBED_CONF_PLATFORM_FLIGHT_RECORDER_RECORDS];
+} flight_ring_t;
+
+/* The ring must sit in a section the startup code does not zero, or a
+ * frozen trace would be wiped before anyone can read it. The mbed linker
+ * scripts carry a .noinit NOLOAD region for exactly this kind of data.
+ */
+static flight_ring_t flight_ring MBED_SECTION(".noinit");
+
+static uint32_t flight_timestamp(void)
+{
+#if defined(DWT) && defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+void mbed_flight_record(uint32_t type, uint32_t data)
+{
+    /* One compare rejects the cold-boot, unarmed and frozen states at
+     * once, keeping the hot path to the claim and three stores. A record
+     * being written while a freeze hits may be torn; the decoder sees at
+     * most one implausible entry at the newest end of the trace. */
+    if (flight_ring.magic != FLIGHT_MAGIC_ARMED) {
+        return;
+    }
+
+    uint32_t idx = core_util_atomic_incr_u32(&flight_ring.next, 1) - 1;
+    mbed_flight_record_t *rec = &flight_ring.records[idx & FLIGHT_RING_MASK];
+    rec->timestamp = flight_timestamp();
+    rec->type = type;
+    rec->data = data;
+}
+
+void mbed_flight_recorder_init(void)
+{
+    core_util_critical_section_enter();
+    if (flight_ring.magic != FLIGHT_MAGIC_FROZEN) {
+        /* Cold boot or clean previous run - start a fresh trace. A
+         * frozen ring is left exactly as the crash left it. */
+        flight_ring.next = 0;
+        flight_ring.magic = FLIGHT_MAGIC_ARMED;
+    }
+    core_util_critical_section_exit();
+}
+
+void mbed_flight_recorder_freeze(void)
+{
+    if (flight_ring.magic == FLIGHT_MAGIC_ARMED) {
+        flight_ring.magic = FLIGHT_MAGIC_FROZEN;
+    }
+}
+
+void mbed_flight_recorder_reset(void)
+{
+    core_util_critical_section_enter();
+    flight_ring.next = 0;
+    flight_ring.magic = FLIGHT_MAGIC_ARMED;
+    core_util_critical_section_exit();
+}
+
+bool mbed_flight_recorder_is_frozen(void)
+{
+    return flight_ring.magic == FLIGHT_MAGIC_FROZEN;
+}
+
+size_t mbed_flight_recorder_read(mbed_flight_record_t *out, size_t count)
+{
+    if (flight_ring.magic != FLIGHT_MAGIC_ARMED &&
+            flight_ring.magic != FLIGHT_MAGIC_FROZEN) {
+        return 0;
+    }
+
+    uint32_t next = flight_ring.next;
+    uint32_t available = next;
+    if (available > MBED_CONF_PLATFORM_FLIGHT_RECORDER_RECORDS) {
+        available = MBED_CONF_PLATFORM_FLIGHT_RECORDER_RECORDS;
+    }
+
+    size_t n = 0;
+    uint32_t idx = next - available;
+    while (n < count && available) {
+        out[n++] = flight_ring.records[idx++ & FLIGHT_RING_MASK];
+        available--;
+    }
+    return n;
+}
+
+void mbed_flight_recorder_dump(void)
+{
+    mbed_flight_record_t rec;
+    uint32_t next = flight_ring.next;
+    uint32_t available = next;
+
+    if (flight_ring.magic != FLIGHT_MAGIC_ARMED &&
+            flight_ring.magic != FLIGHT_MAGIC_FROZEN) {
+        return;
+    }
+    if (available > MBED_CONF_PLATFORM_FLIGHT_RECORDER_RECORDS) {
+        available = MBED_CONF_PLATFORM_FLIGHT_RECORDER_RECORDS;
+    }
+
+    printf("flight recorder: %lu events%s\r\n", (unsigned long)available,
+           mbed_flight_recorder_is_frozen() ? " (frozen)" : "");
+    for (uint32_t idx = next - available; available; idx++, available--) {
+        rec = flight_ring.records[idx & FLIGHT_RING_MASK];
+        printf("%lu %lu 0x%lx\r\n", (unsigned long)rec.timestamp,
+               (unsigned long)rec.type, (unsigned long)rec.data);
+    }
+}
+
+#else
+
+bool mbed_flight_recorder_is_frozen(void)
+{
+    return false;
+}
+
+size_t mbed_flight_recorder_read(mbed_flight_record_t *out, size_t count)
+{
+    (void)out;
+    (void)count;
+    return 0;
+}
+
+void mbed_flight_recorder_dump(void)
+{
+}
+
+#endif
@@ -0,0 +1,135 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FLIGHT_RECORDER_H
+#define MBED_FLIGHT_RECORDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Event types stored in mbed_flight_record_t::type. Values from
+ * MBED_FLIGHT_TYPE_USER upward are free for the application. */
+#define MBED_FLIGHT_TYPE_THREAD_SWITCH  1   /**< data = incoming thread id */
+#define MBED_FLIGHT_TYPE_IRQ_ENTER      2   /**< data = IRQ number */
+#define MBED_FLIGHT_TYPE_IRQ_EXIT       3   /**< data = IRQ number */
+#define MBED_FLIGHT_TYPE_ERROR          4   /**< data = address of the error format string */
+#define MBED_FLIGHT_TYPE_USER           0x80
+
+/**
+ * One flight recorder event.
+ *
+ * The timestamp is the DWT cycle counter at the time of the event (0 on
+ * cores without a DWT); a decoder divides by the core clock to recover
+ * time and uses wraps of the free-running counter for ordering within
+ * the ring, which mbed_flight_recorder_read already returns oldest
+ * first.
+ */
+typedef struct {
+    uint32_t timestamp;     /**< DWT cycle count at the event. */
+    uint32_t type;          /**< One of the MBED_FLIGHT_TYPE values. */
+    uint32_t data;          /**< Event argument. */
+} mbed_flight_record_t;
+
+/**
+ * Record an event.
+ *
+ * Compiles away entirely unless MBED_FLIGHT_RECORDER_ENABLED is set.
+ * The enabled path is one atomic increment and three word stores, safe
+ * from threads and interrupt handlers alike.
+ *
+ * @param type one of the MBED_FLIGHT_TYPE constants
+ * @param data event argument (any integer or pointer-sized value)
+ */
+#ifdef MBED_FLIGHT_RECORDER_ENABLED
+#define MBED_FLIGHT_EVENT(type, data) mbed_flight_record((type), (uint32_t)(data))
+#else
+#define MBED_FLIGHT_EVENT(type, data) ((void)0)
+#endif
+
+#ifdef MBED_FLIGHT_RECORDER_ENABLED
+
+/** Store an event in the ring. Use MBED_FLIGHT_EVENT so disabled builds
+ * pay nothing.
+ *
+ * Events are dropped while the recorder is not armed - before
+ * mbed_flight_recorder_init() and after a freeze.
+ *
+ * @param type one of the MBED_FLIGHT_TYPE constants
+ * @param data event argument
+ */
+void mbed_flight_record(uint32_t type, uint32_t data);
+
+/** Arm the flight recorder.
+ *
+ * Call once early in the application. The ring lives in a noinit
+ * section, so if the previous run froze a trace and the reset kept RAM
+ * powered, the trace is still there: in that case the recorder stays
+ * frozen so the trace can be read out, and recording only resumes
+ * after mbed_flight_recorder_reset(). On a cold boot the ring is
+ * cleared and recording starts.
+ */
+void mbed_flight_recorder_init(void);
+
+/** Freeze the ring so the events leading up to a failure survive.
+ *
+ * Called by error(); can also be called from application fault paths.
+ * Safe from interrupt handlers. Frozen state persists across a
+ * RAM-preserving reset.
+ */
+void mbed_flight_recorder_freeze(void);
+
+/** Clear the ring and resume recording after a frozen trace was read */
+void mbed_flight_recorder_reset(void);
+
+#endif
+
+/** Check whether a frozen trace is waiting to be read
+ *
+ * @return true if the recorder holds a frozen trace
+ */
+bool mbed_flight_recorder_is_frozen(void);
+
+/**
+ * Copy the recorded events, oldest first.
+ *
+ * Usable on a live ring but primarily meant for reading a frozen trace
+ * after reboot, before mbed_flight_recorder_reset() re-arms recording.
+ *
+ * @param out destination for the copied records
+ * @param count capacity of 'out' in records
+ * @return the number of records copied
+ */
+size_t mbed_flight_recorder_read(mbed_flight_record_t *out, size_t count);
+
+/** Print the recorded events to the console, oldest first, one
+ * "timestamp type data" line per event - the zero-dependency way to get
+ * a frozen trace off a field unit.
+ */
+void mbed_flight_recorder_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
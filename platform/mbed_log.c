@@ -0,0 +1,89 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_log.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+
+#ifndef MBED_CONF_PLATFORM_LOG_BUFFER_RECORDS
+#define MBED_CONF_PLATFORM_LOG_BUFFER_RECORDS 64
+#endif
+
+#if MBED_CONF_PLATFORM_LOG_LEVEL > MBED_LOG_LEVEL_NONE
+
+MBED_STATIC_ASSERT((MBED_CONF_PLATFORM_LOG_BUFFER_RECORDS &
+                    (MBED_CONF_PLATFORM_LOG_BUFFER_RECORDS - 1)) == 0,
+                   "platform.log-buffer-records must be a power of two");
+
+#define LOG_RING_MASK (MBED_CONF_PLATFORM_LOG_BUFFER_RECORDS - 1)
+
+static mbed_log_record_t log_ring[MBED_CONF_PLATFORM_LOG_BUFFER_RECORDS];
+/* Records ever written; doubles as the sequence number */
+static uint32_t log_write_idx;
+/* Next sequence number the reader expects */
+static uint32_t log_read_seq;
+
+void mbed_log_write(uint8_t level, const char *msg, uint32_t arg0, uint32_t arg1)
+{
+    /* Claim a slot with a single atomic increment - concurrent writers never
+     * contend on the same record. 'seq_level' is stored last so a record only
+     * looks valid to the reader once its payload is in place. */
+    uint32_t seq = core_util_atomic_incr_u32(&log_write_idx, 1) - 1;
+    mbed_log_record_t *rec = &log_ring[seq & LOG_RING_MASK];
+    rec->id = (uint32_t)(uintptr_t)msg;
+    rec->arg0 = arg0;
+    rec->arg1 = arg1;
+    rec->seq_level = (seq << 8) | level;
+}
+
+size_t mbed_log_read(mbed_log_record_t *out, size_t count)
+{
+    size_t n = 0;
+
+    uint32_t write = log_write_idx;
+    /* Records more than one ring behind the writer are already overwritten */
+    if (write - log_read_seq > LOG_RING_MASK + 1) {
+        log_read_seq = write - (LOG_RING_MASK + 1);
+    }
+    while (log_read_seq != write && n < count) {
+        uint32_t seq = log_read_seq++;
+        out[n] = log_ring[seq & LOG_RING_MASK];
+        /* Skip records a writer replaced (or has not finished) under us */
+        if (out[n].seq_level == ((seq << 8) | (out[n].seq_level & 0xff))) {
+            n++;
+        }
+    }
+    return n;
+}
+
+#else
+
+void mbed_log_write(uint8_t level, const char *msg, uint32_t arg0, uint32_t arg1)
+{
+    (void)level;
+    (void)msg;
+    (void)arg0;
+    (void)arg1;
+}
+
+size_t mbed_log_read(mbed_log_record_t *out, size_t count)
+{
+    (void)out;
+    (void)count;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,115 @@
+
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_LOG_H
+#define MBED_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Log levels, in decreasing severity. platform.log-level selects the highest
+ * level compiled in; calls above it cost nothing. */
+#define MBED_LOG_LEVEL_NONE     0
+#define MBED_LOG_LEVEL_ERROR    1
+#define MBED_LOG_LEVEL_WARN     2
+#define MBED_LOG_LEVEL_INFO     3
+#define MBED_LOG_LEVEL_DEBUG    4
+
+#ifndef MBED_CONF_PLATFORM_LOG_LEVEL
+#define MBED_CONF_PLATFORM_LOG_LEVEL MBED_LOG_LEVEL_WARN
+#endif
+
+/**
+ * Fixed-size binary log record, as stored by 'mbed_log_write'.
+ *
+ * 'seq_level' holds the record's sequence number shifted left by 8, with the
+ * level in the low byte. 'id' is the flash address of the message's string
+ * literal - the text itself is never copied, a decoder recovers it from the
+ * image's ELF file (or by reading flash at that address).
+ */
+typedef struct {
+    uint32_t seq_level;     /**< (sequence number << 8) | level. */
+    uint32_t id;            /**< Address of the message's string literal. */
+    uint32_t arg0;          /**< First message argument. */
+    uint32_t arg1;          /**< Second message argument. */
+} mbed_log_record_t;
+
+/**
+ * Log a message at the given level.
+ *
+ * 'msg' must be a string literal; only its address is recorded, so the hot
+ * path is one atomic increment and four word stores into the log ring -
+ * cheap enough to leave enabled in production code.
+ *
+ * NOTE: If 'level' is a constant above platform.log-level and the compiler
+ * optimization level is greater than 0, the whole statement will be compiled
+ * away and the arguments will not be evaluated.
+ *
+ * @param level one of the MBED_LOG_LEVEL constants
+ * @param msg string literal describing the event
+ * @param arg0 first message argument (any integer or pointer-sized value)
+ * @param arg1 second message argument
+ */
+#define MBED_LOG(level, msg, arg0, arg1) \
+    do { \
+        if ((level) <= MBED_CONF_PLATFORM_LOG_LEVEL) { \
+            mbed_log_write((level), (msg), (uint32_t)(arg0), (uint32_t)(arg1)); \
+        } \
+    } while (0)
+
+#define MBED_LOG_ERROR(msg, arg0, arg1) MBED_LOG(MBED_LOG_LEVEL_ERROR, msg, arg0, arg1)
+#define MBED_LOG_WARN(msg, arg0, arg1)  MBED_LOG(MBED_LOG_LEVEL_WARN,  msg, arg0, arg1)
+#define MBED_LOG_INFO(msg, arg0, arg1)  MBED_LOG(MBED_LOG_LEVEL_INFO,  msg, arg0, arg1)
+#define MBED_LOG_DEBUG(msg, arg0, arg1) MBED_LOG(MBED_LOG_LEVEL_DEBUG, msg, arg0, arg1)
+
+/**
+ * Store a log record. DO NOT CALL DIRECTLY - use the MBED_LOG macros so
+ * disabled levels are removed at compile time.
+ *
+ * @param level one of the MBED_LOG_LEVEL constants
+ * @param msg string literal describing the event
+ * @param arg0 first message argument
+ * @param arg1 second message argument
+ */
+void mbed_log_write(uint8_t level, const char *msg, uint32_t arg0, uint32_t arg1);
+
+/**
+ * Copy the oldest unread records out of the log ring.
+ *
+ * Safe to call while logging is active; records overwritten or still being
+ * written while the copy is taken are skipped, which a decoder observes as
+ * gaps in the sequence numbers.
+ *
+ * @param out destination for the copied records.
+ * @param count capacity of 'out' in records.
+ * @return the number of records copied.
+ */
+size_t mbed_log_read(mbed_log_record_t *out, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
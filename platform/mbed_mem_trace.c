@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include "platform/mbed_mem_trace.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
 
 /******************************************************************************
  * Internal variables, functions and helpers
@@ -26,6 +27,13 @@
 
 /* The callback function that will be called after a traced memory operations finishes. */
 static mbed_mem_trace_cb_t mem_trace_cb;
+/* Storage for the binary ring tracer (mbed_mem_trace_ring_setup). 'ring_mask' is
+ * the record count minus one, 'ring_write' counts records ever written and doubles
+ * as the sequence number, 'ring_read_seq' is the next sequence the reader expects. */
+static mbed_mem_trace_record_t *ring_records;
+static uint32_t ring_mask;
+static uint32_t ring_write;
+static uint32_t ring_read_seq;
 /* 'trave_level' guards "trace inside trace" situations (for example, the implementation
  * of realloc() might call malloc() internally, and since malloc() is also traced, this could
  * result in two calls to the callback function instead of one. */
@@ -113,3 +121,74 @@ void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...) {
     va_end(va);
 }
 
+void mbed_mem_trace_ring_setup(mbed_mem_trace_record_t *records, uint32_t count) {
+    /* Power of two so slot selection is a mask, not a divide */
+    MBED_ASSERT((count != 0) && ((count & (count - 1)) == 0));
+    ring_records = records;
+    ring_mask = count - 1;
+    ring_write = 0;
+    ring_read_seq = 0;
+    mbed_mem_trace_set_callback(mbed_mem_trace_ring_callback);
+}
+
+void mbed_mem_trace_ring_callback(uint8_t op, void *res, void *caller, ...) {
+    va_list va;
+    uint32_t arg0 = 0, arg1 = 0;
+
+    va_start(va, caller);
+    switch (op) {
+        case MBED_MEM_TRACE_MALLOC:
+            arg0 = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_REALLOC:
+            arg0 = (uint32_t)va_arg(va, void*);
+            arg1 = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_CALLOC:
+            arg0 = va_arg(va, size_t);
+            arg1 = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_FREE:
+            arg0 = (uint32_t)va_arg(va, void*);
+            break;
+    }
+    va_end(va);
+
+    /* Claim a slot with a single atomic increment - concurrent tracers never
+     * contend on the same record, they only race the reader, which detects a
+     * torn record by its stale sequence number. 'seq_op' is stored last so a
+     * record only looks valid once its payload is in place. */
+    uint32_t seq = core_util_atomic_incr_u32(&ring_write, 1) - 1;
+    mbed_mem_trace_record_t *rec = &ring_records[seq & ring_mask];
+    rec->res = (uint32_t)res;
+    rec->caller = (uint32_t)caller;
+    rec->arg0 = arg0;
+    rec->arg1 = arg1;
+    rec->seq_op = (seq << 8) | op;
+}
+
+size_t mbed_mem_trace_ring_read(mbed_mem_trace_record_t *out, size_t count) {
+    size_t n = 0;
+
+    if (ring_records == NULL) {
+        return 0;
+    }
+    uint32_t write = ring_write;
+    /* Records more than one ring behind the writer are already overwritten */
+    if (write - ring_read_seq > ring_mask + 1) {
+        ring_read_seq = write - (ring_mask + 1);
+    }
+    while (ring_read_seq != write && n < count) {
+        uint32_t seq = ring_read_seq++;
+        out[n] = ring_records[seq & ring_mask];
+        /* Skip records the writer replaced (or has not finished) under us */
+        if (out[n].seq_op == ((seq << 8) | (out[n].seq_op & 0xff))) {
+            n++;
+        }
+    }
+    return n;
+}
+
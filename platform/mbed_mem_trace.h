@@ -133,6 +133,64 @@ void mbed_mem_trace_free(void *ptr, void *caller);
  */
 void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...);
 
+/**
+ * Fixed-size binary trace record, as written by 'mbed_mem_trace_ring_callback'.
+ *
+ * 'seq_op' holds the record's sequence number shifted left by 8, with the
+ * operation ID (MBED_MEM_TRACE_MALLOC and friends) in the low byte. The
+ * sequence number lets a decoder order records and detect how many were
+ * overwritten between reads. The meaning of 'arg0'/'arg1' follows the traced
+ * operation's arguments:
+ *
+ * - for 'malloc': arg0 = size.
+ * - for 'realloc': arg0 = ptr, arg1 = size.
+ * - for 'calloc': arg0 = nmemb, arg1 = size.
+ * - for 'free': arg0 = ptr.
+ */
+typedef struct {
+    uint32_t seq_op;    /**< (sequence number << 8) | operation ID. */
+    uint32_t res;       /**< Result of the operation (0 for 'free'). */
+    uint32_t caller;    /**< Caller of the memory operation. */
+    uint32_t arg0;      /**< First operation argument (see above). */
+    uint32_t arg1;      /**< Second operation argument (see above). */
+} mbed_mem_trace_record_t;
+
+/**
+ * Set up the binary ring tracer and install 'mbed_mem_trace_ring_callback'
+ * as the trace callback.
+ *
+ * Unlike the default callback, the ring callback does no formatting or I/O:
+ * each traced operation claims a slot with a single atomic increment and
+ * stores one fixed-size record, so tracing can stay enabled in production.
+ * When the ring is full the oldest records are overwritten. Records are
+ * decoded off-target, either by draining them with 'mbed_mem_trace_ring_read'
+ * (for example from a low priority thread that ships them over a socket) or
+ * by reading the buffer post-mortem with a debugger.
+ *
+ * @param records storage for the ring; must stay valid while tracing is enabled.
+ * @param count number of records in 'records'; must be a power of two.
+ */
+void mbed_mem_trace_ring_setup(mbed_mem_trace_record_t *records, uint32_t count);
+
+/**
+ * Binary ring trace callback. DO NOT CALL DIRECTLY. It is installed by
+ * 'mbed_mem_trace_ring_setup'.
+ */
+void mbed_mem_trace_ring_callback(uint8_t op, void *res, void *caller, ...);
+
+/**
+ * Copy the oldest unread records out of the trace ring.
+ *
+ * Safe to call while tracing is active; records overwritten or still being
+ * written while the copy is taken are skipped, which a decoder observes as
+ * gaps in the sequence numbers.
+ *
+ * @param out destination for the copied records.
+ * @param count capacity of 'out' in records.
+ * @return the number of records copied.
+ */
+size_t mbed_mem_trace_ring_read(mbed_mem_trace_record_t *out, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,9 +22,17 @@
 #define SECONDS_BY_MINUTES 60
 #define MINUTES_BY_HOUR 60
 #define SECONDS_BY_HOUR (SECONDS_BY_MINUTES * MINUTES_BY_HOUR)
-#define HOURS_BY_DAY 24 
+#define HOURS_BY_DAY 24
 #define SECONDS_BY_DAY (SECONDS_BY_HOUR * HOURS_BY_DAY)
 
+/*
+ * Number of days elapsed between the 1st of january 1970 and the 1st of
+ * january of (1970 + i): 365 per year plus one for every leap year completed
+ * before that date, the first of which is 1972. Valid over the [70:138]
+ * year range handled by this unit.
+ */
+#define DAYS_BEFORE_YEAR(i) (((i) * 365) + (((i) + 1) / 4))
+
 /*
  * 2 dimensional array containing the number of seconds elapsed before a given 
  * month.
@@ -128,33 +136,27 @@ bool _rtc_localtime(time_t timestamp, struct tm* time_info) {
     // representation ranging from [0:6]
     time_info->tm_wday = (timestamp + 4) % 7;
 
-    // years start at 70
-    time_info->tm_year = 70;
-    while (true) { 
-        if (_rtc_is_leap_year(time_info->tm_year) && timestamp >= 366) {
-            ++time_info->tm_year;
-            timestamp -= 366;
-        } else if (!_rtc_is_leap_year(time_info->tm_year) && timestamp >= 365) {
-            ++time_info->tm_year;
-            timestamp -= 365;
-        } else {
-            // the remaining days are less than a years
-            break;
-        }
+    // years start at 70. Dividing by 365 either lands on the right year or
+    // overshoots by one because of the accumulated leap days, never more.
+    int years = timestamp / 365;
+    if (DAYS_BEFORE_YEAR(years) > timestamp) {
+        --years;
     }
+    time_info->tm_year = 70 + years;
+    timestamp -= DAYS_BEFORE_YEAR(years);
 
     time_info->tm_yday = timestamp;
 
-    // convert days into seconds and find the current month
-    timestamp *= SECONDS_BY_DAY;
-    time_info->tm_mon = 11;
+    // the same trick finds the month: day of year / 31 is either the right
+    // month or the one before it, since no month falls short of 31 days by
+    // more than 3.
     bool leap = _rtc_is_leap_year(time_info->tm_year);
-    for (uint32_t i = 0; i < 12; ++i) {
-        if ((uint32_t) timestamp < seconds_before_month[leap][i]) {
-            time_info->tm_mon = i - 1;
-            break;
-        }
+    int month = timestamp / 31;
+    timestamp *= SECONDS_BY_DAY;
+    if ((month < 11) && ((uint32_t) timestamp >= seconds_before_month[leap][month + 1])) {
+        ++month;
     }
+    time_info->tm_mon = month;
 
     // remove month from timestamp and compute the number of days.
     // note: unlike other fields, days are not 0 indexed.
@@ -17,28 +17,46 @@
 #include "FileHandle.h"
 #include "Timer.h"
 #ifdef MBED_CONF_RTOS_PRESENT
-#include "rtos/Thread.h"
+#include "rtos/Semaphore.h"
 #endif
 
 namespace mbed {
 
+#ifdef MBED_CONF_RTOS_PRESENT
+static void poll_wakeup(rtos::Semaphore *sem)
+{
+    sem->release();
+}
+#endif
+
 // timeout -1 forever, or milliseconds
 int poll(pollfh fhs[], unsigned nfhs, int timeout)
 {
     /**
-     * TODO Proper wake-up mechanism.
-     * In order to correctly detect availability of read/write a FileHandle, we needed
-     * a select or poll mechanisms. We opted for poll as POSIX defines in
-     * http://pubs.opengroup.org/onlinepubs/009695399/functions/poll.html Currently,
-     * mbed::poll() just spins and scans filehandles looking for any events we are
-     * interested in. In future, his spinning behaviour will be replaced with
-     * condition variables.
+     * This follows the poll semantics POSIX defines in
+     * http://pubs.opengroup.org/onlinepubs/009695399/functions/poll.html
      */
     Timer timer;
     if (timeout > 0) {
         timer.start();
     }
 
+#ifdef MBED_CONF_RTOS_PRESENT
+    /* One wait object serves all the handles - any handle's state change
+     * releases it and the scan below works out which handles became ready.
+     * The semaphore latches a wakeup, so an event that fires between a scan
+     * and the wait is not lost. The wakeup goes through the handles' poll
+     * hook, which is fired alongside sigio, so any sigio callback the
+     * caller has installed stays attached and keeps working.
+     */
+    rtos::Semaphore sem(0, 1);
+    for (unsigned n = 0; n < nfhs; n++) {
+        if (fhs[n].fh) {
+            fhs[n].fh->attach_poll_wakeup(callback(poll_wakeup, &sem));
+        }
+    }
+#endif
+
     int count = 0;
     for (;;) {
         /* Scan the file handles */
@@ -59,16 +77,30 @@ int poll(pollfh fhs[], unsigned nfhs, int timeout)
             break;
         }
 
-        /* Nothing selected - this is where timeout handling would be needed */
+        /* Nothing selected - wait for a state change (or the timeout) */
         if (timeout == 0 || (timeout > 0 && timer.read_ms() > timeout)) {
             break;
         }
 #ifdef MBED_CONF_RTOS_PRESENT
-        // TODO - proper blocking
-        // wait for condition variable, wait queue whatever here
-        rtos::Thread::wait(1);
+        uint32_t wait_ms = osWaitForever;
+        if (timeout > 0) {
+            int remaining = timeout - timer.read_ms();
+            if (remaining < 0) {
+                remaining = 0;
+            }
+            wait_ms = remaining;
+        }
+        sem.wait(wait_ms);
 #endif
     }
+
+#ifdef MBED_CONF_RTOS_PRESENT
+    for (unsigned n = 0; n < nfhs; n++) {
+        if (fhs[n].fh) {
+            fhs[n].fh->attach_poll_wakeup(NULL);
+        }
+    }
+#endif
     return count;
 }
 
@@ -87,24 +87,31 @@ extern const char __stderr_name[] = "/stderr";
 unsigned char *mbed_heap_start = 0;
 uint32_t mbed_heap_size = 0;
 
+/* Optional secondary heap region in a discontiguous RAM bank, configured by
+ * mbed_set_stack_heap() when the target defines HEAP2_START/HEAP2_SIZE.
+ * Size stays 0 when there is no second bank. */
+unsigned char *mbed_heap2_start = 0;
+uint32_t mbed_heap2_size = 0;
+
 /* newlib has the filehandle field in the FILE struct as a short, so
  * we can't just return a Filehandle* from _open and instead have to
  * put it in a filehandles array and return the index into that array
  * (or rather index+3, as filehandles 0-2 are stdin/out/err).
+ *
+ * Slots are claimed and released with atomic compare-and-swap rather
+ * than a mutex, so the table never serializes threads doing stdio -
+ * dispatch on an open handle is a plain indexed load, and open/close
+ * race only on the individual slot.
  */
 static FileHandle *filehandles[OPEN_MAX];
-static SingletonPtr<PlatformMutex> filehandle_mutex;
 
 namespace mbed {
 void remove_filehandle(FileHandle *file) {
-    filehandle_mutex->lock();
     /* Remove all open filehandles for this */
     for (unsigned int fh_i = 0; fh_i < sizeof(filehandles)/sizeof(*filehandles); fh_i++) {
-        if (filehandles[fh_i] == file) {
-            filehandles[fh_i] = NULL;
-        }
+        void *expected = file;
+        core_util_atomic_cas_ptr((void **)&filehandles[fh_i], &expected, NULL);
     }
-    filehandle_mutex->unlock();
 }
 }
 
@@ -127,6 +134,83 @@ static void init_serial() {
 #endif
 }
 
+#if DEVICE_SERIAL
+#if MBED_CONF_PLATFORM_STDIO_BUFFERED_SERIAL
+
+/* Console output ring buffer, drained from the UART TX interrupt. A write
+ * to stdout/stderr costs the copy into the buffer and the UART transmits
+ * in the background; the caller only waits when the buffer is full.
+ * Output from an ISR or a critical section, where the drain interrupt
+ * cannot run, flushes the buffer and writes through polled instead. */
+static unsigned char stdio_out_buf[MBED_CONF_PLATFORM_STDIO_BUFFER_SIZE];
+static volatile unsigned int stdio_out_buf_in;
+static volatile unsigned int stdio_out_buf_out;
+static bool stdio_out_irq_set;
+
+static void console_drain_polled() {
+    while (stdio_out_buf_out != stdio_out_buf_in) {
+        serial_putc(&stdio_uart, stdio_out_buf[stdio_out_buf_out]);
+        stdio_out_buf_out = (stdio_out_buf_out + 1) % sizeof(stdio_out_buf);
+    }
+}
+
+static void console_tx_irq(uint32_t id, SerialIrq event) {
+    if (event != TxIrq) {
+        return;
+    }
+    while (stdio_out_buf_out != stdio_out_buf_in && serial_writable(&stdio_uart)) {
+        serial_putc(&stdio_uart, stdio_out_buf[stdio_out_buf_out]);
+        stdio_out_buf_out = (stdio_out_buf_out + 1) % sizeof(stdio_out_buf);
+    }
+    if (stdio_out_buf_out == stdio_out_buf_in) {
+        serial_irq_set(&stdio_uart, TxIrq, 0);
+    }
+}
+
+static void console_putc(char c) {
+    if (core_util_is_isr_active() || !core_util_are_interrupts_enabled()) {
+        /* The drain interrupt cannot run - write through, flushing the
+         * buffer first to keep the output in order */
+        console_drain_polled();
+        serial_putc(&stdio_uart, c);
+        return;
+    }
+
+    core_util_critical_section_enter();
+    if (!stdio_out_irq_set) {
+        serial_irq_handler(&stdio_uart, console_tx_irq, 0);
+        stdio_out_irq_set = true;
+    }
+    unsigned int next = (stdio_out_buf_in + 1) % sizeof(stdio_out_buf);
+    while (next == stdio_out_buf_out) {
+        /* Buffer full - let the TX interrupt drain a byte */
+        core_util_critical_section_exit();
+        core_util_critical_section_enter();
+    }
+    stdio_out_buf[stdio_out_buf_in] = c;
+    stdio_out_buf_in = next;
+    serial_irq_set(&stdio_uart, TxIrq, 1);
+    core_util_critical_section_exit();
+}
+
+static void console_flush() {
+    core_util_critical_section_enter();
+    console_drain_polled();
+    core_util_critical_section_exit();
+}
+
+#else
+
+static inline void console_putc(char c) {
+    serial_putc(&stdio_uart, c);
+}
+
+static inline void console_flush() {
+}
+
+#endif /* MBED_CONF_PLATFORM_STDIO_BUFFERED_SERIAL */
+#endif /* DEVICE_SERIAL */
+
 /**
  * Sets errno when file opening fails.
  * Wipes out the filehandle too.
@@ -223,20 +307,20 @@ extern "C" FILEHANDLE PREFIX(_open)(const char* name, int openmode) {
     #endif
 
     // find the first empty slot in filehandles
-    filehandle_mutex->lock();
     unsigned int fh_i;
     for (fh_i = 0; fh_i < sizeof(filehandles)/sizeof(*filehandles); fh_i++) {
-    	/* Take a next free filehandle slot available. */
-        if (filehandles[fh_i] == NULL) break;
+    	/* Claim the next free filehandle slot atomically - a successful
+    	 * compare-and-swap from NULL to RESERVED owns the slot. */
+        void *expected = NULL;
+        if (core_util_atomic_cas_ptr((void **)&filehandles[fh_i], &expected, (void *)FILE_HANDLE_RESERVED)) {
+            break;
+        }
     }
     if (fh_i >= sizeof(filehandles)/sizeof(*filehandles)) {
         /* Too many file handles have been opened */
         errno = EMFILE;
-        filehandle_mutex->unlock();
         return -1;
     }
-    filehandles[fh_i] = (FileHandle*)FILE_HANDLE_RESERVED;
-    filehandle_mutex->unlock();
 
     FileHandle *res = NULL;
 
@@ -315,14 +399,14 @@ extern "C" int PREFIX(_write)(FILEHANDLE fh, const unsigned char *buffer, unsign
 #if MBED_CONF_PLATFORM_STDIO_CONVERT_NEWLINES
         for (unsigned int i = 0; i < length; i++) {
             if (buffer[i] == '\n' && stdio_out_prev != '\r') {
-                 serial_putc(&stdio_uart, '\r');
+                 console_putc('\r');
             }
-            serial_putc(&stdio_uart, buffer[i]);
+            console_putc(buffer[i]);
             stdio_out_prev = buffer[i];
         }
 #else
         for (unsigned int i = 0; i < length; i++) {
-            serial_putc(&stdio_uart, buffer[i]);
+            console_putc(buffer[i]);
         }
 #endif
 #endif
@@ -352,7 +436,7 @@ extern "C" void PREFIX(_exit)(int return_code) {
 }
 
 extern "C" void _ttywrch(int ch) {
-    serial_putc(&stdio_uart, ch);
+    console_putc(ch);
 }
 #endif
 
@@ -416,6 +500,45 @@ extern "C" int PREFIX(_read)(FILEHANDLE fh, unsigned char *buffer, unsigned int
 #endif
 }
 
+/* Vectored I/O on a filehandle index. Only real FileHandles support
+ * gathering/scattering; the console filehandles 0-2 do not. */
+extern "C" ssize_t mbed_writev(int fildes, const mbed::iovec_t *iov, int iovcnt) {
+    if (fildes < 3) {
+        errno = EBADF;
+        return -1;
+    }
+    FileHandle* fhc = filehandles[fildes-3];
+    if (fhc == NULL) {
+        errno = EBADF;
+        return -1;
+    }
+
+    ssize_t n = fhc->writev(iov, iovcnt);
+    if (n < 0) {
+        errno = -n;
+        return -1;
+    }
+    return n;
+}
+
+extern "C" ssize_t mbed_readv(int fildes, const mbed::iovec_t *iov, int iovcnt) {
+    if (fildes < 3) {
+        errno = EBADF;
+        return -1;
+    }
+    FileHandle* fhc = filehandles[fildes-3];
+    if (fhc == NULL) {
+        errno = EBADF;
+        return -1;
+    }
+
+    ssize_t n = fhc->readv(iov, iovcnt);
+    if (n < 0) {
+        errno = -n;
+        return -1;
+    }
+    return n;
+}
 
 #ifdef __ARMCC_VERSION
 extern "C" int PREFIX(_istty)(FILEHANDLE fh)
@@ -750,17 +873,39 @@ extern "C" caddr_t _sbrk(int incr) {
     unsigned char*        prev_heap = heap;
     unsigned char*        new_heap = heap + incr;
 
+    // Once the break has moved into the secondary bank it stays there
+    if (mbed_heap2_size && (heap >= mbed_heap2_start) && (heap <= mbed_heap2_start + mbed_heap2_size)) {
+        if ((new_heap < mbed_heap2_start) || (new_heap > mbed_heap2_start + mbed_heap2_size)) {
+            errno = ENOMEM;
+            return (caddr_t)-1;
+        }
+        heap = new_heap;
+        return (caddr_t) prev_heap;
+    }
+
+    bool overflow = false;
 #if defined(TARGET_CORTEX_A)
     if (new_heap >= (unsigned char*)&__HeapLimit) {     /* __HeapLimit is end of heap section */
 #else
     if (new_heap >= (unsigned char*)__get_MSP()) {
 #endif
-        errno = ENOMEM;
-        return (caddr_t)-1;
+        overflow = true;
     }
 
     // Additional heap checking if set
     if (mbed_heap_size && (new_heap >= mbed_heap_start + mbed_heap_size)) {
+        overflow = true;
+    }
+
+    if (overflow) {
+        // Primary bank exhausted - continue the break in the secondary bank
+        // if one is configured. Newlib's allocator copes with a
+        // discontiguous sbrk and simply opens a new chunk there.
+        if ((incr > 0) && mbed_heap2_size && ((uint32_t)incr <= mbed_heap2_size)) {
+            prev_heap = mbed_heap2_start;
+            heap = mbed_heap2_start + incr;
+            return (caddr_t) prev_heap;
+        }
         errno = ENOMEM;
         return (caddr_t)-1;
     }
@@ -782,6 +927,9 @@ extern "C" void exit(int return_code) {
 #if MBED_CONF_PLATFORM_STDIO_FLUSH_AT_EXIT
     fflush(stdout);
     fflush(stderr);
+#if DEVICE_SERIAL
+    console_flush();
+#endif
 #endif
 #endif
 
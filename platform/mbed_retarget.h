@@ -45,6 +45,7 @@ typedef unsigned int  gid_t;    ///< Group ID
 #define O_TRUNC  0x0400 ///< Truncate file to zero length
 #define O_EXCL   0x0800 ///< Fail if file exists
 #define O_APPEND 0x0008 ///< Set file offset to end of file prior to each write
+#define O_RDAHEAD 0x1000 ///< mbed extension: hint that the file will be read sequentially
 
 #define NAME_MAX 255    ///< Maximum size of a name in a file path
 
@@ -64,8 +65,14 @@ typedef unsigned int  gid_t;    ///< Group ID
 namespace mbed {
 class FileHandle;
 class DirHandle;
+struct iovec_t;
 std::FILE *mbed_fdopen(FileHandle *fh, const char *mode);
 }
+
+/* Vectored I/O on an open filehandle index - see FileHandle::writev/readv */
+extern "C" ssize_t mbed_writev(int fildes, const mbed::iovec_t *iov, int iovcnt);
+extern "C" ssize_t mbed_readv(int fildes, const mbed::iovec_t *iov, int iovcnt);
+
 typedef mbed::DirHandle DIR;
 #else
 typedef struct Dir DIR;
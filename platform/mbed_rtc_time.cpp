@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #include "hal/rtc_api.h"
+#include "hal/ticker_api.h"
+#if DEVICE_LOWPOWERTIMER
+#include "hal/lp_ticker_api.h"
+#endif
 
 #include "platform/mbed_critical.h"
 #include "platform/mbed_rtc_time.h"
@@ -22,6 +26,48 @@
 
 static SingletonPtr<PlatformMutex> _mutex;
 
+#if DEVICE_LOWPOWERTIMER
+/* Cached view of the RTC, anchored to the low power ticker. time()
+ * extrapolates from this snapshot instead of touching the RTC hardware,
+ * and periodically re-anchors to bound drift between the lp ticker and
+ * the RTC. The lp ticker is the anchor because it keeps counting through
+ * deep sleep (the us ticker stops there), and ticker_read_us() gives an
+ * initialized 64 bit timestamp, so there is no wrap hazard. Readers take
+ * no lock: the sequence counter is odd while an update is in flight and
+ * changes across one, so a torn snapshot is detected and simply re-read.
+ * Targets without a low power ticker get no cache and read the RTC on
+ * every call, as before. */
+typedef struct {
+    time_t epoch;
+    us_timestamp_t anchor_us;
+    bool valid;
+} time_cache_t;
+
+static volatile time_cache_t _time_cache = {0, 0, false};
+static volatile uint32_t _time_cache_seq = 0;
+
+/* Re-anchor every 30 minutes to track the RTC */
+#define TIME_CACHE_RESYNC_US (1800u * 1000000u)
+
+/* Called with _mutex held */
+static void time_cache_update(time_t t, bool valid)
+{
+    core_util_critical_section_enter();
+    _time_cache_seq++;              // odd: update in flight
+    _time_cache.epoch = t;
+    _time_cache.anchor_us = ticker_read_us(get_lp_ticker_data());
+    _time_cache.valid = valid;
+    _time_cache_seq++;              // even: snapshot consistent again
+    core_util_critical_section_exit();
+}
+#else
+static void time_cache_update(time_t t, bool valid)
+{
+    (void)t;
+    (void)valid;
+}
+#endif
+
 #if DEVICE_RTC
 static void (*_rtc_init)(void) = rtc_init;
 static int (*_rtc_isenabled)(void) = rtc_isenabled;
@@ -44,16 +90,43 @@ time_t time(time_t *timer)
 #endif
 
 {
+#if DEVICE_LOWPOWERTIMER
+    // Fast path: extrapolate from the cached snapshot without taking a lock
+    time_t epoch;
+    us_timestamp_t anchor_us;
+    bool valid;
+    uint32_t seq;
+    do {
+        seq = _time_cache_seq;
+        epoch = _time_cache.epoch;
+        anchor_us = _time_cache.anchor_us;
+        valid = _time_cache.valid;
+    } while ((seq & 1) || (seq != _time_cache_seq));
+
+    if (valid) {
+        us_timestamp_t elapsed_us = ticker_read_us(get_lp_ticker_data()) - anchor_us;
+        if (elapsed_us < TIME_CACHE_RESYNC_US) {
+            time_t t = epoch + (time_t)(elapsed_us / 1000000);
+            if (timer != NULL) {
+                *timer = t;
+            }
+            return t;
+        }
+    }
+#endif
+
+    // Slow path: read the RTC and re-anchor the cache
     _mutex->lock();
     if (_rtc_isenabled != NULL) {
         if (!(_rtc_isenabled())) {
             set_time(0);
         }
     }
-    
+
     time_t t = (time_t)-1;
     if (_rtc_read != NULL) {
         t = _rtc_read();
+        time_cache_update(t, t != (time_t)-1);
     }
 
     if (timer != NULL) {
@@ -70,6 +143,7 @@ void set_time(time_t t) {
     }
     if (_rtc_write != NULL) {
         _rtc_write(t);
+        time_cache_update(t, true);
     }
     _mutex->unlock();
 }
@@ -80,6 +154,8 @@ void attach_rtc(time_t (*read_rtc)(void), void (*write_rtc)(time_t), void (*init
     _rtc_write = write_rtc;
     _rtc_init = init_rtc;
     _rtc_isenabled = isenabled_rtc;
+    // The cached snapshot came from the previous RTC
+    time_cache_update(0, false);
     _mutex->unlock();
 }
 
@@ -15,6 +15,7 @@
  */
 
 #include "mbed_toolchain.h"
+#include "platform/mbed_boot_stats.h"
 #include <stdlib.h>
 #include <stdint.h>
 #include "cmsis.h"
@@ -71,16 +72,19 @@ void mbed_copy_nvic(void)
 
 int $Super$$main(void);
 
-int $Sub$$main(void) 
+int $Sub$$main(void)
 {
     mbed_main();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_MAIN);
     return $Super$$main();
 }
 
-void _platform_post_stackheap_init(void) 
+void _platform_post_stackheap_init(void)
 {
+    mbed_boot_stats_record(MBED_BOOT_STAGE_ENTRY);
     mbed_copy_nvic();
     mbed_sdk_init();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_SDK_INIT);
 }
 
 #elif defined (__GNUC__) 
@@ -89,15 +93,18 @@ extern int __real_main(void);
 
 void software_init_hook(void)
 {
+    mbed_boot_stats_record(MBED_BOOT_STAGE_ENTRY);
     mbed_copy_nvic();
     mbed_sdk_init();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_SDK_INIT);
     software_init_hook_rtos();
 }
 
 
-int __wrap_main(void) 
+int __wrap_main(void)
 {
     mbed_main();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_MAIN);
     return __real_main();
 }
 
@@ -22,6 +22,7 @@
 #include "sleep_api.h"
 #include "mbed_toolchain.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -83,6 +84,48 @@ void sleep_manager_lock_deep_sleep(void);
  */
 void sleep_manager_unlock_deep_sleep(void);
 
+/** Compact IDs naming the driver class holding a deep sleep lock
+ *
+ * Passed to the _id variants of the lock functions so lock counts and
+ * blocked time can be attributed per owner in telemetry; the records are
+ * read back with mbed_stats_sleep_lock_get_each(). Locks taken through
+ * the plain functions count against SLEEP_LOCK_OWNER_OTHER.
+ */
+typedef enum {
+    SLEEP_LOCK_OWNER_OTHER = 0, /**< Untagged callers */
+    SLEEP_LOCK_OWNER_TICKER,    /**< Attached Ticker/Timeout handlers */
+    SLEEP_LOCK_OWNER_TIMER,     /**< Running Timer instances */
+    SLEEP_LOCK_OWNER_SERIAL,    /**< SerialBase and derivatives such as UARTSerial */
+    SLEEP_LOCK_OWNER_SPI,       /**< Asynchronous SPI transfers */
+    SLEEP_LOCK_OWNER_I2C,       /**< Asynchronous I2C transfers */
+    SLEEP_LOCK_OWNER_CAN,       /**< CAN interrupt handlers */
+    SLEEP_LOCK_OWNER_PWM,       /**< Active PwmOut channels */
+    SLEEP_LOCK_OWNER_WAIT,      /**< Sub-millisecond busy waits */
+    SLEEP_LOCK_OWNER_DAC,       /**< AnalogOut waveform playback */
+    SLEEP_LOCK_OWNER_RTOS,      /**< RTOS idle loop bookkeeping */
+    SLEEP_LOCK_OWNER_APP,       /**< Application DeepSleepLock instances */
+    SLEEP_LOCK_OWNER_COUNT      /**< Number of owner IDs */
+} sleep_lock_owner_t;
+
+/** Lock the deep sleep mode on behalf of a known owner
+ *
+ * Behaves exactly like sleep_manager_lock_deep_sleep() and additionally
+ * attributes the lock to the given sleep_lock_owner_t ID when
+ * MBED_SLEEP_STATS_ENABLED is defined.
+ *
+ * @param owner ID of the driver class taking the lock
+ */
+void sleep_manager_lock_deep_sleep_id(uint32_t owner);
+
+/** Unlock the deep sleep mode on behalf of a known owner
+ *
+ * Use unlocking in pair with sleep_manager_lock_deep_sleep_id(), passing
+ * the same owner ID.
+ *
+ * @param owner ID of the driver class releasing the lock
+ */
+void sleep_manager_unlock_deep_sleep_id(uint32_t owner);
+
 /** Get the status of deep sleep allowance for a target
  *
  * @return true if a target can go to deepsleep, false otherwise
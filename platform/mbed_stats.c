@@ -2,6 +2,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "mbed_assert.h"
+#include "mbed_critical.h"
 
 #if MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
@@ -65,6 +66,211 @@ size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count)
     return i;
 }
 
+#if MBED_STACK_STATS_ENABLED && MBED_CONF_RTOS_PRESENT
+
+typedef struct {
+    uint32_t thread_id;
+    const uint32_t *stack_mem;
+    uint32_t stack_size;
+    uint32_t free_words;
+} stack_scan_entry_t;
+
+static stack_scan_entry_t stack_scan_table[MBED_CONF_PLATFORM_STACK_SCAN_MAX_THREADS];
+
+static stack_scan_entry_t *stack_scan_entry(uint32_t thread_id)
+{
+    unsigned i;
+    stack_scan_entry_t *unused = NULL;
+
+    for (i = 0; i < MBED_CONF_PLATFORM_STACK_SCAN_MAX_THREADS; i++) {
+        if (stack_scan_table[i].thread_id == thread_id) {
+            return &stack_scan_table[i];
+        }
+        if (!unused && stack_scan_table[i].thread_id == 0) {
+            unused = &stack_scan_table[i];
+        }
+    }
+
+    // table full, thread goes unaccounted
+    if (unused) {
+        unused->thread_id = thread_id;
+        unused->stack_mem = NULL;
+    }
+    return unused;
+}
+
+void mbed_stats_stack_scan_chunk(uint32_t thread_id, const uint32_t *stack_mem, uint32_t stack_size, uint32_t fill_pattern)
+{
+    unsigned budget = MBED_CONF_PLATFORM_STACK_SCAN_WORDS;
+
+    core_util_critical_section_enter();
+    stack_scan_entry_t *entry = stack_scan_entry(thread_id);
+    if (entry) {
+        if (entry->stack_mem != stack_mem || entry->stack_size != stack_size) {
+            // new thread, or the id was recycled with a different stack
+            entry->stack_mem = stack_mem;
+            entry->stack_size = stack_size;
+            entry->free_words = (stack_size / sizeof(uint32_t)) - 1;
+        }
+        /* The paint is consumed from the top down, so the free region is
+         * contiguous above the magic word at the base. If the boundary word
+         * is still painted nothing below it was touched and the pass is
+         * done after one read; otherwise the boundary creeps down a bounded
+         * number of words per pass. The watermark only ever grows.
+         */
+        while (budget && entry->free_words > 0 &&
+                stack_mem[entry->free_words] != fill_pattern) {
+            entry->free_words--;
+            budget--;
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+#endif
+
+void mbed_stats_stack_watermark_get(mbed_stats_stack_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_stack_t));
+
+#if MBED_STACK_STATS_ENABLED && MBED_CONF_RTOS_PRESENT
+    unsigned i;
+
+    core_util_critical_section_enter();
+    for (i = 0; i < MBED_CONF_PLATFORM_STACK_SCAN_MAX_THREADS; i++) {
+        if (stack_scan_table[i].thread_id != 0 && stack_scan_table[i].stack_mem != NULL) {
+            stats->max_size += stack_scan_table[i].stack_size
+                    - stack_scan_table[i].free_words * sizeof(uint32_t);
+            stats->reserved_size += stack_scan_table[i].stack_size;
+            stats->stack_cnt++;
+        }
+    }
+    core_util_critical_section_exit();
+#endif
+}
+
+size_t mbed_stats_stack_watermark_get_each(mbed_stats_stack_t *stats, size_t count)
+{
+    memset(stats, 0, count * sizeof(mbed_stats_stack_t));
+    size_t n = 0;
+
+#if MBED_STACK_STATS_ENABLED && MBED_CONF_RTOS_PRESENT
+    unsigned i;
+
+    core_util_critical_section_enter();
+    for (i = 0; i < MBED_CONF_PLATFORM_STACK_SCAN_MAX_THREADS && n < count; i++) {
+        if (stack_scan_table[i].thread_id != 0 && stack_scan_table[i].stack_mem != NULL) {
+            stats[n].thread_id = stack_scan_table[i].thread_id;
+            stats[n].max_size = stack_scan_table[i].stack_size
+                    - stack_scan_table[i].free_words * sizeof(uint32_t);
+            stats[n].reserved_size = stack_scan_table[i].stack_size;
+            stats[n].stack_cnt = 1;
+            n++;
+        }
+    }
+    core_util_critical_section_exit();
+#endif
+
+    return n;
+}
+
+#if MBED_CPU_STATS_ENABLED && MBED_CONF_RTOS_PRESENT
+
+typedef struct {
+    uint32_t thread_id;
+    uint64_t cycles;
+} cpu_stats_entry_t;
+
+static cpu_stats_entry_t cpu_stats_table[MBED_CONF_PLATFORM_CPU_STATS_MAX_THREADS];
+static uint32_t cpu_stats_prev_thread;
+static uint32_t cpu_stats_prev_cycles;
+
+static cpu_stats_entry_t *cpu_stats_entry(uint32_t thread_id)
+{
+    unsigned i;
+    cpu_stats_entry_t *unused = NULL;
+
+    for (i = 0; i < MBED_CONF_PLATFORM_CPU_STATS_MAX_THREADS; i++) {
+        if (cpu_stats_table[i].thread_id == thread_id) {
+            return &cpu_stats_table[i];
+        }
+        if (!unused && cpu_stats_table[i].thread_id == 0) {
+            unused = &cpu_stats_table[i];
+        }
+    }
+
+    // table full, thread goes unaccounted
+    if (unused) {
+        unused->thread_id = thread_id;
+    }
+    return unused;
+}
+
+/* Called from the RTX scheduler in handler mode on every context switch with
+ * the incoming thread and the current DWT cycle count; charges the cycles
+ * elapsed since the previous switch to the outgoing thread. Runs with the
+ * scheduler's own serialization, so no locking is needed here - it must stay
+ * short as it is on every switch path.
+ */
+void mbed_stats_cpu_switch_hook(uint32_t thread_id, uint32_t cycles)
+{
+    if (cpu_stats_prev_thread) {
+        cpu_stats_entry_t *entry = cpu_stats_entry(cpu_stats_prev_thread);
+        if (entry) {
+            entry->cycles += cycles - cpu_stats_prev_cycles;
+        }
+    }
+    cpu_stats_prev_thread = thread_id;
+    cpu_stats_prev_cycles = cycles;
+}
+
+#endif
+
+void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_cpu_t));
+
+#if MBED_CPU_STATS_ENABLED && MBED_CONF_RTOS_PRESENT
+    unsigned i;
+
+    core_util_critical_section_enter();
+    for (i = 0; i < MBED_CONF_PLATFORM_CPU_STATS_MAX_THREADS; i++) {
+        if (cpu_stats_table[i].thread_id != 0) {
+            stats->cycles += cpu_stats_table[i].cycles;
+            stats->thread_cnt++;
+        }
+    }
+    core_util_critical_section_exit();
+#endif
+}
+
+size_t mbed_stats_cpu_get_each(mbed_stats_cpu_t *stats, size_t count)
+{
+    memset(stats, 0, count * sizeof(mbed_stats_cpu_t));
+    size_t n = 0;
+
+#if MBED_CPU_STATS_ENABLED && MBED_CONF_RTOS_PRESENT
+    unsigned i;
+
+    core_util_critical_section_enter();
+    for (i = 0; i < MBED_CONF_PLATFORM_CPU_STATS_MAX_THREADS && n < count; i++) {
+        if (cpu_stats_table[i].thread_id != 0) {
+            stats[n].thread_id = cpu_stats_table[i].thread_id;
+            stats[n].cycles = cpu_stats_table[i].cycles;
+            stats[n].thread_cnt = 1;
+            n++;
+        }
+    }
+    core_util_critical_section_exit();
+#endif
+
+    return n;
+}
+
 #if MBED_STACK_STATS_ENABLED && !MBED_CONF_RTOS_PRESENT
 #warning Stack statistics are currently not supported without the rtos.
 #endif
+
+#if MBED_CPU_STATS_ENABLED && !MBED_CONF_RTOS_PRESENT
+#warning CPU statistics are currently not supported without the rtos.
+#endif
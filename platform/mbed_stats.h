@@ -41,6 +41,52 @@ typedef struct {
  */
 void mbed_stats_heap_get(mbed_stats_heap_t *stats);
 
+typedef struct {
+    uint32_t caller;            /**< Return address of the allocating call site. */
+    uint32_t alloc_cnt;         /**< Current number of allocations from this site. */
+    uint32_t current_size;      /**< Bytes allocated currently from this site. */
+    uint32_t total_size;        /**< Cumulative sum of bytes ever allocated from this site. */
+    uint32_t max_size;          /**< Max bytes allocated at a given time from this site. */
+} mbed_stats_heap_site_t;
+
+/**
+ *  Fill the passed array of stat structures with per-call-site heap stats.
+ *
+ *  Requires MBED_HEAP_STATS_ENABLED. Attribution is keyed by the return
+ *  address of the malloc call; up to platform.heap-stats-max-sites distinct
+ *  sites are tracked and allocations from further sites only appear in the
+ *  global totals.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_heap_site_t structures to fill
+ *  @param count    The number of mbed_stats_heap_site_t structures in the provided array
+ *  @return         The number of mbed_stats_heap_site_t structures that have been filled,
+ *                  this is equal to the number of call sites tracked.
+ */
+size_t mbed_stats_heap_sites_get(mbed_stats_heap_site_t *stats, size_t count);
+
+typedef struct {
+    uint32_t region_start;      /**< Base address of the heap region. */
+    uint32_t reserved_size;     /**< Number of bytes reserved for this region. */
+    uint32_t current_size;      /**< Bytes allocated currently from this region. */
+    uint32_t max_size;          /**< Max bytes allocated at a given time from this region. */
+    uint32_t alloc_cnt;         /**< Current number of allocations living in this region. */
+} mbed_stats_heap_region_t;
+
+/**
+ *  Fill the passed array of stat structures with per-region heap stats.
+ *
+ *  Requires MBED_HEAP_STATS_ENABLED. On targets with a single heap region
+ *  one structure is filled; on targets with a secondary RAM bank
+ *  (HEAP2_START/HEAP2_SIZE) the spill bank is reported as a second region,
+ *  showing how allocations are spread across the banks.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_heap_region_t structures to fill
+ *  @param count    The number of mbed_stats_heap_region_t structures in the provided array
+ *  @return         The number of mbed_stats_heap_region_t structures that have been filled,
+ *                  this is equal to the number of configured heap regions.
+ */
+size_t mbed_stats_heap_regions_get(mbed_stats_heap_region_t *stats, size_t count);
+
 typedef struct {
     uint32_t thread_id;         /**< Identifier for thread that owns the stack or 0 if multiple threads. */
     uint32_t max_size;          /**< Maximum number of bytes used on the stack. */
@@ -66,6 +112,150 @@ void mbed_stats_stack_get(mbed_stats_stack_t *stats);
  */
 size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count);
 
+/**
+ *  Fill the passed in structure with the cached stack watermarks of all
+ *  scanned threads. The thread_id will be 0 and stack_cnt will represent
+ *  number of threads.
+ *
+ *  Requires MBED_STACK_STATS_ENABLED. Unlike mbed_stats_stack_get this does
+ *  not walk any stack painting: the watermarks are maintained by the idle
+ *  loop, which inspects a few words of one thread's stack per pass, so this
+ *  is cheap enough to read on every telemetry upload.
+ *
+ *  @param stats    A pointer to the mbed_stats_stack_t structure to fill
+ */
+void mbed_stats_stack_watermark_get(mbed_stats_stack_t *stats);
+
+/**
+ *  Fill the passed array of stat structures with the cached stack watermark
+ *  of each scanned thread.
+ *
+ *  Up to platform.stack-scan-max-threads threads are tracked. A freshly
+ *  created thread reads as unused until the scanner reaches it, and a
+ *  watermark can lag a deep excursion by a few idle passes - the value only
+ *  ever grows, so it is safe to size stacks against.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_stack_t structures to fill
+ *  @param count    The number of mbed_stats_stack_t structures in the provided array
+ *  @return         The number of mbed_stats_stack_t structures that have been filled,
+ *                  this is equal to the number of threads tracked.
+ */
+size_t mbed_stats_stack_watermark_get_each(mbed_stats_stack_t *stats, size_t count);
+
+/**
+ *  Advance the incremental watermark scan of one thread's stack.
+ *
+ *  Called by the RTOS idle loop with the thread's stack region and the
+ *  paint pattern the stack was filled with. At most
+ *  platform.stack-scan-words words at the free/used boundary are examined,
+ *  so the steady-state cost is a single word read per call.
+ *
+ *  @param thread_id    Identifier of the thread that owns the stack
+ *  @param stack_mem    Base (lowest address) of the stack region
+ *  @param stack_size   Size of the stack region in bytes
+ *  @param fill_pattern Word the unused part of the stack is painted with
+ */
+void mbed_stats_stack_scan_chunk(uint32_t thread_id, const uint32_t *stack_mem, uint32_t stack_size, uint32_t fill_pattern);
+
+typedef struct {
+    uint32_t thread_id;         /**< Identifier for the thread or 0 if multiple threads. */
+    uint64_t cycles;            /**< CPU cycles consumed by the thread, from the DWT cycle counter. */
+    uint32_t thread_cnt;        /**< Number of thread stats accumulated in the structure. */
+} mbed_stats_cpu_t;
+
+/**
+ *  Fill the passed in structure with CPU cycles accumulated for all threads. The thread_id will be 0
+ *  and thread_cnt will represent number of threads. Requires MBED_CPU_STATS_ENABLED and a target
+ *  with a DWT cycle counter; the cycles accounting is updated on every context switch by the RTX
+ *  integration layer, so reading it is cheap enough for always-on profiling.
+ *
+ *  @param stats    A pointer to the mbed_stats_cpu_t structure to fill
+ */
+void mbed_stats_cpu_get(mbed_stats_cpu_t *stats);
+
+/**
+ *  Fill the passed array of stat structures with the CPU cycles consumed by each tracked thread.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_cpu_t structures to fill
+ *  @param count    The number of mbed_stats_cpu_t structures in the provided array
+ *  @return         The number of mbed_stats_cpu_t structures that have been filled,
+ *                  this is equal to the number of threads tracked.
+ */
+size_t mbed_stats_cpu_get_each(mbed_stats_cpu_t *stats, size_t count);
+
+typedef struct {
+    uint32_t caller;            /**< Return address of the outermost critical section enter. */
+    uint32_t enter_cnt;         /**< Number of interrupt-masked windows opened by this site. */
+    uint32_t max_cycles;        /**< Longest masked window from this site, in CPU cycles. */
+    uint64_t total_cycles;      /**< Cycles spent masked by this site in total. */
+} mbed_stats_critical_t;
+
+/**
+ *  Fill the passed array of stat structures with the interrupt masking record
+ *  of each critical section call site.
+ *
+ *  Requires MBED_CRITICAL_STATS_ENABLED and a target with a DWT cycle counter.
+ *  Attribution is keyed by the return address of the outermost
+ *  core_util_critical_section_enter; up to platform.critical-stats-max-sites
+ *  distinct sites are tracked. Dividing total_cycles by enter_cnt gives the
+ *  average window, max_cycles the worst case - the offenders behind interrupt
+ *  latency jitter.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_critical_t structures to fill
+ *  @param count    The number of mbed_stats_critical_t structures in the provided array
+ *  @return         The number of mbed_stats_critical_t structures that have been filled,
+ *                  this is equal to the number of call sites tracked.
+ */
+size_t mbed_stats_critical_get_each(mbed_stats_critical_t *stats, size_t count);
+
+typedef struct {
+    uint32_t owner;             /**< sleep_lock_owner_t ID of the lock holder. */
+    uint32_t lock_cnt;          /**< Cumulative number of deep sleep locks taken by this owner. */
+    uint32_t held;              /**< Locks this owner holds right now. */
+    uint64_t total_blocked_us;  /**< Time this owner has spent blocking deep sleep. */
+} mbed_stats_sleep_lock_t;
+
+/**
+ *  Fill the passed array of stat structures with the deep sleep lock record
+ *  of each owner.
+ *
+ *  Requires MBED_SLEEP_STATS_ENABLED. Owners are the compact
+ *  sleep_lock_owner_t IDs passed to sleep_manager_lock_deep_sleep_id();
+ *  locks taken through the untagged functions appear under
+ *  SLEEP_LOCK_OWNER_OTHER. An owner still holding a lock has its hold so
+ *  far included in total_blocked_us, so a stuck lock is visible without
+ *  waiting for the release.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_sleep_lock_t structures to fill
+ *  @param count    The number of mbed_stats_sleep_lock_t structures in the provided array
+ *  @return         The number of mbed_stats_sleep_lock_t structures that have been filled,
+ *                  this is equal to the number of owners that ever took the lock.
+ */
+size_t mbed_stats_sleep_lock_get_each(mbed_stats_sleep_lock_t *stats, size_t count);
+
+typedef struct {
+    uint64_t timestamp;         /**< Microsecond timestamp of the wakeup. */
+    uint32_t cause;             /**< Exception number pending at wakeup, 0 if unknown. */
+    uint32_t deep;              /**< 1 if the wakeup ended deep sleep, 0 for shallow sleep. */
+} mbed_stats_wakeup_t;
+
+/**
+ *  Fill the passed array of stat structures with the most recent wakeups
+ *  recorded by sleep_manager_sleep_auto(), oldest first.
+ *
+ *  Requires MBED_SLEEP_STATS_ENABLED. The cause is the exception number
+ *  found pending when the sleep call returned - the interrupt that woke
+ *  the core, still held off by the sleep manager's critical section. Up
+ *  to platform.sleep-stats-wakeup-log entries are retained, the oldest
+ *  are overwritten.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_wakeup_t structures to fill
+ *  @param count    The number of mbed_stats_wakeup_t structures in the provided array
+ *  @return         The number of mbed_stats_wakeup_t structures that have been filled,
+ *                  this is equal to the number of wakeups retained.
+ */
+size_t mbed_stats_wakeup_get_each(mbed_stats_wakeup_t *stats, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
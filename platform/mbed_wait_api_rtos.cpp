@@ -23,6 +23,15 @@
 #include "rtos/rtos.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_sleep.h"
+#include "drivers/Timeout.h"
+
+#ifndef MBED_CONF_PLATFORM_WAIT_US_SLEEP_THRESHOLD
+#define MBED_CONF_PLATFORM_WAIT_US_SLEEP_THRESHOLD 100
+#endif
+
+// The wake handler has no work to do - its interrupt ends the sleep below
+static void wait_us_wake(void) {
+}
 
 void wait(float s) {
     wait_us(s * 1000000.0f);
@@ -36,15 +45,38 @@ void wait_us(int us) {
     const ticker_data_t *const ticker = get_us_ticker_data();
 
     uint32_t start = ticker_read(ticker);
+    // The RTOS and ticker-wake paths are only usable from thread context
+    // with interrupts enabled: in handler mode interrupts read as enabled,
+    // but an ISR at or above the us ticker's priority would sleep waiting
+    // for a wake that can never preempt it
+    bool can_sleep = core_util_are_interrupts_enabled() &&
+            !core_util_is_isr_active();
     // Use the RTOS to wait for millisecond delays if possible
     int ms = us / 1000;
-    if ((ms > 0) && core_util_are_interrupts_enabled()) {
-        sleep_manager_lock_deep_sleep();
+    if ((ms > 0) && can_sleep) {
+        sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_WAIT);
         Thread::wait((uint32_t)ms);
-        sleep_manager_unlock_deep_sleep();
+        sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_WAIT);
+    }
+    // Sleep through the sub-millisecond remainder on a one-shot ticker
+    // wake when it is long enough to repay the cost of programming the
+    // wake. Timeout's attach holds the deep sleep lock, so the us ticker
+    // keeps counting while the core sleeps; unrelated interrupts just
+    // re-enter the loop.
+    if (can_sleep) {
+        uint32_t elapsed = ticker_read(ticker) - start;
+        if (((uint32_t)us > elapsed) &&
+            ((uint32_t)us - elapsed >= MBED_CONF_PLATFORM_WAIT_US_SLEEP_THRESHOLD)) {
+            mbed::Timeout wake;
+            wake.attach_us(mbed::callback(wait_us_wake), (uint32_t)us - elapsed);
+            while ((ticker_read(ticker) - start) < (uint32_t)us) {
+                sleep();
+            }
+            wake.detach();
+        }
     }
-    // Use busy waiting for sub-millisecond delays, or for the whole
-    // interval if interrupts are not enabled
+    // Busy wait the tail of the interval, or the whole interval when
+    // called from IRQ context or with interrupts disabled
     while ((ticker_read(ticker) - start) < (uint32_t)us);
 }
 
@@ -0,0 +1,128 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2017 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "rtos/ConditionVariable.h"
+
+#include "mbed_error.h"
+#include "mbed_assert.h"
+
+namespace rtos {
+
+ConditionVariable::Waiter::Waiter() : sem(0), prev(NULL), next(NULL), in_list(false)
+{
+}
+
+ConditionVariable::ConditionVariable(Mutex &mutex) : _mutex(mutex), _wait_list(NULL)
+{
+}
+
+void ConditionVariable::wait()
+{
+    wait_for(osWaitForever);
+}
+
+bool ConditionVariable::wait_for(uint32_t millisec)
+{
+    Waiter current_thread;
+
+    /* the wait list is protected by the caller-held mutex; being on the
+       list before the unlock is what makes a notification between unlock
+       and sleep land on the semaphore rather than getting lost */
+    _add_wait_list(&_wait_list, &current_thread);
+    _mutex.unlock();
+
+    int32_t sem_count = current_thread.sem.wait(millisec);
+    bool timeout = (sem_count > 0) ? false : true;
+
+    _mutex.lock();
+    if (current_thread.in_list) {
+        _remove_wait_list(&_wait_list, &current_thread);
+    }
+
+    return timeout;
+}
+
+void ConditionVariable::notify_one()
+{
+    if (_wait_list) {
+        Waiter *waiter = _wait_list;
+        _remove_wait_list(&_wait_list, waiter);
+        waiter->sem.release();
+    }
+}
+
+void ConditionVariable::notify_all()
+{
+    /* releasing under a kernel lock defers rescheduling until the unlock,
+       so all waiters are readied in one scheduler pass and the highest
+       priority one is picked once, instead of a switch per release */
+    osKernelLock();
+    while (_wait_list) {
+        Waiter *waiter = _wait_list;
+        _remove_wait_list(&_wait_list, waiter);
+        waiter->sem.release();
+    }
+    osKernelUnlock();
+}
+
+ConditionVariable::~ConditionVariable()
+{
+    MBED_ASSERT(NULL == _wait_list);
+}
+
+void ConditionVariable::_add_wait_list(Waiter **wait_list, Waiter *waiter)
+{
+    if (NULL == *wait_list) {
+        // Nothing in the list so add it directly
+        *wait_list = waiter;
+        waiter->next = waiter;
+        waiter->prev = waiter;
+    } else {
+        // Add after the last element
+        Waiter *first = *wait_list;
+        Waiter *last = (*wait_list)->prev;
+        waiter->next = first;
+        waiter->prev = last;
+        last->next = waiter;
+        first->prev = waiter;
+    }
+    waiter->in_list = true;
+}
+
+void ConditionVariable::_remove_wait_list(Waiter **wait_list, Waiter *waiter)
+{
+    if (waiter->next == waiter) {
+        // This was the last element in the list
+        *wait_list = NULL;
+    } else {
+        if (*wait_list == waiter) {
+            // The head of the list is being removed
+            *wait_list = waiter->next;
+        }
+        waiter->prev->next = waiter->next;
+        waiter->next->prev = waiter->prev;
+    }
+    waiter->next = NULL;
+    waiter->prev = NULL;
+    waiter->in_list = false;
+}
+
+}
@@ -0,0 +1,108 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2017 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef CONDITIONVARIABLE_H
+#define CONDITIONVARIABLE_H
+
+#include <stdint.h>
+#include "cmsis_os2.h"
+
+#include "rtos/Mutex.h"
+#include "rtos/Semaphore.h"
+
+#include "platform/NonCopyable.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+
+/** The ConditionVariable class lets threads wait, with the associated Mutex
+ released, until another thread signals that a condition they care about may
+ have changed. Waking and re-acquiring the mutex are coordinated through a
+ wait list protected by the mutex itself, so no notification is ever lost
+ between the unlock and the sleep - the race that makes hand-rolled
+ Semaphore-plus-Mutex constructions either unsafe or a thundering herd.
+
+ The mutex must be locked by the current thread when calling wait, wait_for,
+ notify_one or notify_all. Each waiter sleeps on its own semaphore, so
+ notify_one wakes exactly one thread, and notify_all releases all current
+ waiters inside a single kernel lock so the scheduler runs one pass instead
+ of one per waiter.
+
+ @note
+ Memory considerations: The condition variable and its per-waiter bookkeeping
+ live on the stacks of the participating threads (static or dynamic RTOS
+ memory pools are not being used).
+*/
+class ConditionVariable : private mbed::NonCopyable<ConditionVariable> {
+public:
+    /** Create and Initialize a ConditionVariable object
+     *
+     * @param mutex mutex this condition variable is associated with.
+     */
+    ConditionVariable(Mutex &mutex);
+
+    /** Wait for a notification.
+     *
+     * The mutex is released while waiting and re-acquired before returning.
+     * Spurious wakeups can occur, so the condition must be re-checked in a
+     * loop around the wait.
+     */
+    void wait();
+
+    /** Wait for a notification or until the timeout expires.
+     *
+     * The mutex is released while waiting and re-acquired before returning.
+     *
+     * @param millisec timeout value or osWaitForever in case of no timeout.
+     * @return true if the timeout expired, false otherwise.
+     */
+    bool wait_for(uint32_t millisec);
+
+    /** Notify one waiting thread. */
+    void notify_one();
+
+    /** Notify all waiting threads in a single scheduler pass. */
+    void notify_all();
+
+    ~ConditionVariable();
+
+protected:
+    struct Waiter {
+        Waiter();
+        Semaphore sem;
+        Waiter *prev;
+        Waiter *next;
+        bool in_list;
+    };
+
+    static void _add_wait_list(Waiter **wait_list, Waiter *waiter);
+    static void _remove_wait_list(Waiter **wait_list, Waiter *waiter);
+
+    Mutex &_mutex;
+    Waiter *_wait_list;
+};
+
+}
+
+#endif
+
+/** @}*/
@@ -57,6 +57,22 @@ uint32_t EventFlags::clear(uint32_t flags)
     return osEventFlagsClear(_id, flags);
 }
 
+uint32_t EventFlags::broadcast(uint32_t flags)
+{
+    uint32_t ret;
+
+    /* With the kernel locked the set readies every waiter without running
+       any of them, and the clear lands before the unlock triggers the one
+       deferred scheduler pass - so each current waiter wakes exactly once
+       and the flags cannot leak to threads that were not yet waiting. */
+    osKernelLock();
+    ret = osEventFlagsSet(_id, flags);
+    osEventFlagsClear(_id, flags);
+    osKernelUnlock();
+
+    return ret;
+}
+
 uint32_t EventFlags::get() const
 {
     return osEventFlagsGet(_id);
@@ -63,6 +63,18 @@ public:
      */
     uint32_t clear(uint32_t flags = 0x7fffffff);
 
+    /** Wake every thread currently waiting for the specified Event Flags, then clear them.
+      The set and clear happen with the kernel locked, so all waiters are released in a single
+      scheduler pass and the flags never remain set: threads that start waiting afterwards block
+      until the next broadcast, and a woken thread that immediately waits again takes its place
+      at the back of the wait list, round-robining equal-priority waiters across broadcasts.
+      Waiters must not consume the flags themselves, i.e. they must wait with clear set to false.
+      This cannot be called from interrupt service routines.
+      @param   flags  specifies the flags that shall be broadcast.
+      @return  event flags at the time of the wakeup or error code if highest bit set (@a osFlagsError).
+     */
+    uint32_t broadcast(uint32_t flags);
+
     /** Get the currently set Event Flags.
       @return  set event flags.
      */
@@ -0,0 +1,144 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2017 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Semaphore.h"
+#include "cmsis_os2.h"
+
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include "platform/NonCopyable.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+
+/** The MailBox class is a lock-free alternative to Mail for high-rate
+ message passing. Where Mail composes a MemoryPool and a Queue, costing a
+ kernel call for the allocation and another for the enqueue, MailBox keeps
+ its messages in a ring owned by the object: reserve() hands a producer a
+ slot with a single atomic compare-and-swap, the message is constructed
+ directly in that slot, and put() publishes it with a store plus one
+ semaphore release to wake the consumer. Producers may be threads or
+ interrupt handlers; there must be a single consumer.
+
+ Messages are received in reservation order and must be freed in the order
+ they were received.
+
+  @tparam  T         data type of a single message element.
+  @tparam  queue_sz  maximum number of messages in queue.
+
+ @note
+ Memory considerations: The message store and control structures are
+ contained in the object itself (static or dynamic RTOS memory pools are
+ not being used).
+*/
+template<typename T, uint32_t queue_sz>
+class MailBox : private mbed::NonCopyable<MailBox<T, queue_sz> > {
+public:
+    /** Create and Initialise MailBox. */
+    MailBox() : _sem(0), _head(0), _read(0), _free(0) {
+        memset((void *)_ready, 0, sizeof(_ready));
+    }
+
+    /** Reserve the next free message slot
+      The returned memory is uninitialized; the producer fills it in place
+      and publishes it with MailBox::put. The reserve function is irq safe.
+      @return  pointer to a memory block of type T, or NULL if the ring is full.
+    */
+    T *reserve(void) {
+        uint32_t head = _head;
+        do {
+            if (head - _free >= queue_sz) {
+                return NULL;
+            }
+        } while (!core_util_atomic_cas_u32((uint32_t *)&_head, &head, head + 1));
+
+        return slot(head);
+    }
+
+    /** Publish a message in the queue
+      The put function is irq safe.
+      @param   mptr  memory block previously reserved with MailBox::reserve.
+    */
+    void put(T *mptr) {
+        _ready[index_of(mptr)] = 1;
+        _sem.release();
+    }
+
+    /** Get a message from the queue
+      @param   millisec  timeout value or 0 in case of no time-out. (default: osWaitForever).
+      @return  pointer to the message, or NULL on timeout.
+    */
+    T *get(uint32_t millisec = osWaitForever) {
+        if (_sem.wait(millisec) < 1) {
+            return NULL;
+        }
+
+        // a producer that reserved an earlier slot may still be filling
+        // it in; its put is no more than a few stores away
+        while (!_ready[_read % queue_sz]) {
+        }
+
+        T *mptr = slot(_read);
+        _read++;
+        return mptr;
+    }
+
+    /** Free a message, making its slot available to producers
+      Messages must be freed in the order they were received.
+      @param   mptr  pointer to the message that was obtained with MailBox::get.
+    */
+    void free(T *mptr) {
+        MBED_ASSERT(index_of(mptr) == _free % queue_sz);
+        _ready[_free % queue_sz] = 0;
+        _free++;
+    }
+
+private:
+    T *slot(uint32_t i) {
+        return (T *)((char *)_pool + (i % queue_sz) * sizeof(T));
+    }
+
+    uint32_t index_of(T *mptr) {
+        return ((char *)mptr - (char *)_pool) / sizeof(T);
+    }
+
+    Semaphore _sem;
+    volatile uint32_t _head;
+    uint32_t _read;
+    volatile uint32_t _free;
+    volatile uint8_t _ready[queue_sz];
+
+    /* Slot storage, sized in uint64_t for worst-case alignment */
+    uint64_t _pool[(queue_sz * sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+};
+
+}
+
+#endif
+
+/** @}*/
@@ -29,6 +29,7 @@
 #include "mbed_rtos1_types.h"
 #include "mbed_rtos_storage.h"
 #include "platform/NonCopyable.h"
+#include "platform/mbed_critical.h"
 
 namespace rtos {
 /** \addtogroup rtos */
@@ -101,6 +102,115 @@ private:
     mbed_rtos_storage_mem_pool_t _obj_mem;
 };
 
+/** A fixed-size memory pool variant tuned for interrupt-heavy use, such as
+  DMA descriptor and packet buffer pools. Blocks are carved at the requested
+  alignment so descriptors that need, say, 32-byte alignment are not
+  over-allocated, and alloc/free are an O(1) free-list swap under a
+  few-cycle interrupt mask - no kernel entry, safe from ISRs and threads
+  alike. The pool tracks its high-water mark so each pool can be sized from
+  observed worst-case occupancy.
+
+  @tparam  T            data type of a single object (element).
+  @tparam  pool_sz      maximum number of objects (elements) in the memory pool.
+  @tparam  block_align  alignment in bytes of each block, a power of two no smaller than 4. (default: 8)
+
+ @note
+ Memory considerations: The memory pool data store and control structures are
+ contained in the object itself (static or dynamic RTOS memory pools are not
+ being used).
+*/
+template<typename T, uint32_t pool_sz, uint32_t block_align = 8>
+class FastMemoryPool : private mbed::NonCopyable<FastMemoryPool<T, pool_sz, block_align> > {
+    MBED_STATIC_ASSERT(pool_sz > 0, "Invalid memory pool size. Must be greater than 0.");
+    MBED_STATIC_ASSERT(block_align >= 4 && (block_align & (block_align - 1)) == 0,
+            "Block alignment must be a power of two no smaller than 4.");
+public:
+    /** Create and Initialize a memory pool. */
+    FastMemoryPool() : _free(NULL), _used(0), _max_used(0) {
+        char *base = (char *)(((uintptr_t)_pool_mem + block_align - 1) & ~(uintptr_t)(block_align - 1));
+        for (uint32_t i = 0; i < pool_sz; i++) {
+            block_t *b = (block_t *)(base + i * block_size);
+            b->next = _free;
+            _free = b;
+        }
+    }
+
+    /** Allocate an aligned memory block of type T from the pool. The alloc function is irq safe.
+      @return  address of the allocated memory block or NULL in case of no memory available.
+    */
+    T* alloc(void) {
+        core_util_critical_section_enter();
+        block_t *b = _free;
+        if (b != NULL) {
+            _free = b->next;
+            _used++;
+            if (_used > _max_used) {
+                _max_used = _used;
+            }
+        }
+        core_util_critical_section_exit();
+        return (T*)b;
+    }
+
+    /** Allocate an aligned memory block of type T from the pool and set memory block to zero.
+      The calloc function is irq safe.
+      @return  address of the allocated memory block or NULL in case of no memory available.
+    */
+    T* calloc(void) {
+        T *item = alloc();
+        if (item != NULL) {
+            memset(item, 0, sizeof(T));
+        }
+        return item;
+    }
+
+    /** Free a memory block. The free function is irq safe.
+      @param   block  address of the allocated memory block to be freed.
+      @return         osOK on successful deallocation, osErrorParameter if given memory block is NULL.
+    */
+    osStatus free(T *block) {
+        if (block == NULL) {
+            return osErrorParameter;
+        }
+        block_t *b = (block_t *)block;
+        core_util_critical_section_enter();
+        b->next = _free;
+        _free = b;
+        _used--;
+        core_util_critical_section_exit();
+        return osOK;
+    }
+
+    /** Get the number of blocks currently allocated from the pool.
+      @return  number of allocated blocks.
+    */
+    uint32_t used(void) const {
+        return _used;
+    }
+
+    /** Get the highest number of blocks ever allocated from the pool at one time.
+      @return  high-water mark of allocated blocks.
+    */
+    uint32_t max_used(void) const {
+        return _max_used;
+    }
+
+private:
+    /* Block stride keeps every block on a block_align boundary; blocks hold
+       the free-list link while unallocated, so they are at least pointer
+       sized by the alignment floor of 4. */
+    static const uint32_t block_size = (sizeof(T) + block_align - 1) & ~(block_align - 1);
+
+    struct block_t {
+        block_t *next;
+    };
+
+    block_t  *_free;
+    uint32_t  _used;
+    uint32_t  _max_used;
+    char      _pool_mem[block_size * pool_sz + block_align - 1];
+};
+
 }
 #endif
 
@@ -24,6 +24,7 @@
 #include <string.h>
 #include "mbed_error.h"
 #include "mbed_assert.h"
+#include "platform/mbed_critical.h"
 
 namespace rtos {
 
@@ -37,6 +38,113 @@ Mutex::Mutex(const char *name)
     constructor(name);
 }
 
+#if MBED_CONF_RTOS_MUTEX_SPIN_FAST_PATH
+
+void Mutex::constructor(const char *name)
+{
+    (void)name;
+    _state = 0;
+    _owner = NULL;
+    _recursions = 0;
+}
+
+/* Atomically exchange the lock word, returning the previous value */
+static uint32_t state_exchange(volatile uint32_t *state, uint32_t desired)
+{
+    uint32_t current = *state;
+    while (!core_util_atomic_cas_u32((uint32_t *)state, &current, desired)) {
+    }
+    return current;
+}
+
+osStatus Mutex::lock(uint32_t millisec) {
+    osThreadId_t self = osThreadGetId();
+    uint32_t expected = 0;
+
+    /* uncontended fast path: one compare-and-swap, no kernel entry */
+    if (core_util_atomic_cas_u32((uint32_t *)&_state, &expected, 1)) {
+        _owner = self;
+        _recursions = 0;
+        return osOK;
+    }
+
+    if (_owner == self) {
+        _recursions++;
+        return osOK;
+    }
+
+    /* bounded spin: short critical sections usually release within a few
+       dozen cycles, cheaper than parking the thread in the kernel */
+    for (uint32_t i = 0; i < MBED_CONF_RTOS_MUTEX_SPIN_COUNT; i++) {
+        expected = 0;
+        if (core_util_atomic_cas_u32((uint32_t *)&_state, &expected, 1)) {
+            _owner = self;
+            _recursions = 0;
+            return osOK;
+        }
+    }
+
+    if (millisec == 0) {
+        return osErrorResource;
+    }
+
+    /* slow path: mark the lock contended and sleep until the holder hands
+       it over; exchanging 2 both acquires a free lock and records that the
+       next unlock must wake a sleeper */
+    uint32_t start = osKernelGetTickCount();
+    while (state_exchange(&_state, 2) != 0) {
+        uint32_t remaining = millisec;
+        if (millisec != osWaitForever) {
+            uint32_t elapsed = osKernelGetTickCount() - start;
+            if (elapsed >= millisec) {
+                return osErrorTimeout;
+            }
+            remaining = millisec - elapsed;
+        }
+        if (_wait.wait(remaining) < 1) {
+            return osErrorTimeout;
+        }
+    }
+    _owner = self;
+    _recursions = 0;
+    return osOK;
+}
+
+bool Mutex::trylock() {
+    uint32_t expected = 0;
+    if (core_util_atomic_cas_u32((uint32_t *)&_state, &expected, 1)) {
+        _owner = osThreadGetId();
+        _recursions = 0;
+        return true;
+    }
+    if (_owner == osThreadGetId()) {
+        _recursions++;
+        return true;
+    }
+    return false;
+}
+
+osStatus Mutex::unlock() {
+    if (_owner != osThreadGetId()) {
+        return osErrorResource;
+    }
+    if (_recursions) {
+        _recursions--;
+        return osOK;
+    }
+    _owner = NULL;
+    if (state_exchange(&_state, 0) == 2) {
+        /* a sleeper may be waiting; wake one to retry the acquire */
+        _wait.release();
+    }
+    return osOK;
+}
+
+Mutex::~Mutex() {
+}
+
+#else
+
 void Mutex::constructor(const char *name)
 {
     memset(&_obj_mem, 0, sizeof(_obj_mem));
@@ -65,4 +173,6 @@ Mutex::~Mutex() {
     osMutexDelete(_id);
 }
 
+#endif
+
 }
@@ -29,6 +29,10 @@
 
 #include "platform/NonCopyable.h"
 
+#if MBED_CONF_RTOS_MUTEX_SPIN_FAST_PATH
+#include "rtos/Semaphore.h"
+#endif
+
 namespace rtos {
 /** \addtogroup rtos */
 /** @{*/
@@ -39,6 +43,12 @@ namespace rtos {
  @note
  Memory considerations: The mutex control structures will be created on current thread's stack, both for the mbed OS
  and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
+
+ @note
+ With the rtos.mutex-spin-fast-path configuration option the RTX mutex is replaced by an atomic
+ spin-then-block implementation: uncontended lock and unlock are a single compare-and-swap with
+ no kernel entry, and contended locks spin briefly before sleeping. In this mode the mutex does
+ not provide priority inheritance.
 */
 class Mutex : private mbed::NonCopyable<Mutex> {
 public:
@@ -81,9 +91,16 @@ public:
 private:
     void constructor(const char *name = NULL);
 
+#if MBED_CONF_RTOS_MUTEX_SPIN_FAST_PATH
+    volatile uint32_t         _state;       /* 0 free, 1 locked, 2 locked with waiters */
+    osThreadId_t              _owner;
+    uint32_t                  _recursions;
+    Semaphore                 _wait;
+#else
     osMutexId_t               _id;
     osMutexAttr_t             _attr;
     mbed_rtos_storage_mutex_t _obj_mem;
+#endif
 };
 
 }
@@ -113,6 +113,57 @@ public:
         return event;
     }
 
+    /** Put multiple messages in a Queue with a single call.
+      Waits up to millisec for space for the first message; the remaining
+      messages are enqueued without blocking, so a burst costs at most one
+      kernel wait instead of one per message.
+      @param   data      array of message pointers.
+      @param   n         number of messages in the array.
+      @param   millisec  timeout for the first message or 0 in case of no time-out. (default: 0)
+      @return  number of messages put into the queue.
+    */
+    uint32_t put_n(T * const *data, uint32_t n, uint32_t millisec=0) {
+        uint32_t done = 0;
+        while (done < n) {
+            osStatus_t res = osMessageQueuePut(_id, &data[done], 0, done ? 0 : millisec);
+            if (res != osOK) {
+                break;
+            }
+            done++;
+        }
+        return done;
+    }
+
+    /** Get multiple messages from a Queue with a single call.
+      Waits up to millisec for the first message; any further messages
+      already queued are retrieved without blocking, so a burst costs at
+      most one kernel wait instead of one per message.
+      @param   data      array to receive the message pointers.
+      @param   n         capacity of the array.
+      @param   millisec  timeout for the first message or 0 in case of no time-out. (default: osWaitForever)
+      @return  number of messages retrieved from the queue.
+    */
+    uint32_t get_n(T **data, uint32_t n, uint32_t millisec=osWaitForever) {
+        uint32_t done = 0;
+        while (done < n) {
+            osStatus_t res = osMessageQueueGet(_id, &data[done], NULL, done ? 0 : millisec);
+            if (res != osOK) {
+                break;
+            }
+            done++;
+        }
+        return done;
+    }
+
+    /** Retrieve all currently queued messages without blocking.
+      @param   data  array to receive the message pointers.
+      @param   n     capacity of the array.
+      @return  number of messages retrieved from the queue.
+    */
+    uint32_t drain(T **data, uint32_t n) {
+        return get_n(data, n, 0);
+    }
+
 private:
     osMessageQueueId_t            _id;
     osMessageQueueAttr_t          _attr;
@@ -21,6 +21,7 @@
  */
 #include "rtos/Semaphore.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
 
 #include <string.h>
 
@@ -34,6 +35,94 @@ Semaphore::Semaphore(int32_t count, uint16_t max_count) {
     constructor(count, max_count);
 }
 
+#if MBED_CONF_RTOS_SEMAPHORE_FAST_PATH
+
+void Semaphore::constructor(int32_t count, uint16_t max_count) {
+    _count = count;
+    _waiters = 0;
+    _max_count = max_count;
+
+    /* kernel semaphore used only to park and wake contended waiters; the
+       token count itself lives in _count and is maintained with CAS */
+    memset(&_obj_mem, 0, sizeof(_obj_mem));
+    memset(&_attr, 0, sizeof(_attr));
+    _attr.cb_mem = &_obj_mem;
+    _attr.cb_size = sizeof(_obj_mem);
+    _id = osSemaphoreNew(0xffff, 0, &_attr);
+    MBED_ASSERT(_id != NULL);
+}
+
+/* Take one token with a CAS, returning the count before the take or 0
+   when no token is available */
+int32_t Semaphore::try_acquire() {
+    uint32_t count = _count;
+    while (count > 0) {
+        if (core_util_atomic_cas_u32((uint32_t *)&_count, &count, count - 1)) {
+            return count;
+        }
+    }
+    return 0;
+}
+
+int32_t Semaphore::wait(uint32_t millisec) {
+    /* uncontended fast path: one compare-and-swap, no kernel entry */
+    int32_t taken = try_acquire();
+    if (taken > 0) {
+        return taken;
+    }
+
+    if (millisec == 0) {
+        return 0;
+    }
+
+    /* slow path: park in the kernel until a release hands a token over.
+       The waiter count is raised before the recheck, so a release either
+       sees the waiter or the waiter sees its token */
+    uint32_t start = osKernelGetTickCount();
+    core_util_atomic_incr_u32((uint32_t *)&_waiters, 1);
+    while (true) {
+        taken = try_acquire();
+        if (taken > 0) {
+            core_util_atomic_decr_u32((uint32_t *)&_waiters, 1);
+            return taken;
+        }
+
+        uint32_t remaining = millisec;
+        if (millisec != osWaitForever) {
+            uint32_t elapsed = osKernelGetTickCount() - start;
+            if (elapsed >= millisec) {
+                core_util_atomic_decr_u32((uint32_t *)&_waiters, 1);
+                return 0;
+            }
+            remaining = millisec - elapsed;
+        }
+        osSemaphoreAcquire(_id, remaining);
+    }
+}
+
+osStatus Semaphore::release(void) {
+    /* uncontended fast path: return the token with a CAS, from thread or
+       interrupt context alike */
+    uint32_t count = _count;
+    do {
+        if (count >= _max_count) {
+            return osErrorResource;
+        }
+    } while (!core_util_atomic_cas_u32((uint32_t *)&_count, &count, count + 1));
+
+    /* kernel entry only when a parked waiter must be woken to retry */
+    if (_waiters) {
+        osSemaphoreRelease(_id);
+    }
+    return osOK;
+}
+
+Semaphore::~Semaphore() {
+    osSemaphoreDelete(_id);
+}
+
+#else
+
 void Semaphore::constructor(int32_t count, uint16_t max_count) {
     memset(&_obj_mem, 0, sizeof(_obj_mem));
     memset(&_attr, 0, sizeof(_attr));
@@ -65,4 +154,6 @@ Semaphore::~Semaphore() {
     osSemaphoreDelete(_id);
 }
 
+#endif
+
 }
@@ -70,6 +70,13 @@ public:
 private:
     void constructor(int32_t count, uint16_t max_count);
 
+#if MBED_CONF_RTOS_SEMAPHORE_FAST_PATH
+    int32_t try_acquire();
+
+    volatile uint32_t             _count;     /* available tokens */
+    volatile uint32_t             _waiters;   /* threads parked in the kernel */
+    uint16_t                      _max_count;
+#endif
     osSemaphoreId_t               _id;
     osSemaphoreAttr_t             _attr;
     mbed_rtos_storage_semaphore_t _obj_mem;
@@ -168,6 +168,7 @@
 #include "cmsis_os2.h"
 #include "mbed_toolchain.h"
 #include "mbed_error.h"
+#include "platform/mbed_boot_stats.h"
 #if defined(__IAR_SYSTEMS_ICC__ ) && (__VER__ >= 8000000)
 #include <DLib_Threads.h>
 #endif
@@ -175,6 +176,10 @@
 extern unsigned char *mbed_heap_start;
 extern uint32_t mbed_heap_size;
 
+/* Secondary heap region - only used if the target defines HEAP2_START */
+extern unsigned char *mbed_heap2_start;
+extern uint32_t mbed_heap2_size;
+
 unsigned char *mbed_stack_isr_start = 0;
 uint32_t mbed_stack_isr_size = 0;
 
@@ -211,6 +216,12 @@ osMutexAttr_t             singleton_mutex_attr;
 #if defined(HEAP_SIZE) && !defined(HEAP_START)
     #error "HEAP_START must be defined if HEAP_SIZE is defined"
 #endif
+#if defined(HEAP2_START) && !defined(HEAP2_SIZE)
+    #error "HEAP2_SIZE must be defined if HEAP2_START is defined"
+#endif
+#if defined(HEAP2_SIZE) && !defined(HEAP2_START)
+    #error "HEAP2_START must be defined if HEAP2_SIZE is defined"
+#endif
 
 /* IAR - INITIAL_SP and HEAP_START ignored as described in Memory layout notes above
  */
@@ -254,6 +265,8 @@ osMutexAttr_t             singleton_mutex_attr;
  * mbed_set_stack_heap purpose is to set the following variables:
  * -mbed_heap_start
  * -mbed_heap_size
+ * -mbed_heap2_start (when a secondary region is configured)
+ * -mbed_heap2_size
  * -mbed_stack_isr_start
  * -mbed_stack_isr_size
  */
@@ -276,6 +289,14 @@ void mbed_set_stack_heap(void) {
     /* Heap - everything else */
     mbed_heap_size = free_size;
     mbed_heap_start = free_start;
+
+#ifdef HEAP2_START
+    /* Secondary heap - a discontiguous RAM bank the allocator glue spills
+     * into once the primary bank is exhausted, so allocations stay in the
+     * (usually faster) primary bank for as long as it has room */
+    mbed_heap2_start = (unsigned char *)(HEAP2_START);
+    mbed_heap2_size = (uint32_t)(HEAP2_SIZE);
+#endif
 }
 
 static void mbed_cpy_nvic(void)
@@ -346,13 +367,17 @@ void _main_init (void) __attribute__((section(".ARM.Collect$$$$000000FF")));
 void $Super$$__cpp_initialize__aeabi_(void);
 
 void _main_init (void) {
+    mbed_boot_stats_record(MBED_BOOT_STAGE_ENTRY);
     mbed_set_stack_heap();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_STACK_HEAP);
     /* Copy the vector table to RAM only if uVisor is not in use. */
 #if !(defined(FEATURE_UVISOR) && defined(TARGET_UVISOR_SUPPORTED))
     mbed_cpy_nvic();
 #endif
     mbed_sdk_init();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_SDK_INIT);
     osKernelInitialize();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_KERNEL_INIT);
     mbed_start_main();
     for (;;);
 }
@@ -366,6 +391,7 @@ void $Sub$$__cpp_initialize__aeabi_(void)
 
 void pre_main()
 {
+    mbed_boot_stats_record(MBED_BOOT_STAGE_RTOS_START);
     singleton_mutex_attr.name = "singleton_mutex";
     singleton_mutex_attr.attr_bits = osMutexRecursive | osMutexPrioInherit | osMutexRobust;
     singleton_mutex_attr.cb_size = sizeof(singleton_mutex_obj);
@@ -373,6 +399,8 @@ void pre_main()
     singleton_mutex_id = osMutexNew(&singleton_mutex_attr);
 
     $Super$$__cpp_initialize__aeabi_();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_LIBC_INIT);
+    mbed_boot_stats_record(MBED_BOOT_STAGE_MAIN);
     main();
 }
 
@@ -386,6 +414,7 @@ extern int main(int argc, char* argv[]);
 
 void pre_main (void)
 {
+    mbed_boot_stats_record(MBED_BOOT_STAGE_RTOS_START);
     singleton_mutex_attr.name = "singleton_mutex";
     singleton_mutex_attr.attr_bits = osMutexRecursive | osMutexPrioInherit | osMutexRobust;
     singleton_mutex_attr.cb_size = sizeof(singleton_mutex_obj);
@@ -393,7 +422,9 @@ void pre_main (void)
     singleton_mutex_id = osMutexNew(&singleton_mutex_attr);
 
     __rt_lib_init((unsigned)mbed_heap_start, (unsigned)(mbed_heap_start + mbed_heap_size));
+    mbed_boot_stats_record(MBED_BOOT_STAGE_LIBC_INIT);
 
+    mbed_boot_stats_record(MBED_BOOT_STAGE_MAIN);
     main(0, NULL);
 }
 
@@ -409,16 +440,37 @@ __asm(".global __use_no_semihosting\n\t");
 #pragma import(__use_two_region_memory)
 #endif
 
+#if defined(HEAP2_START)
+/* Called by the ARM C library when the heap runs out of memory. Donates the
+   secondary RAM bank to the heap (once), so the library heap spans both
+   banks without product-specific scatter file changes. */
+unsigned __user_heap_extend(int ignore, void **base, unsigned requested_size)
+{
+    static int heap2_donated;
+    (void)ignore;
+    if (heap2_donated || (requested_size > mbed_heap2_size)) {
+        return 0;
+    }
+    heap2_donated = 1;
+    *base = mbed_heap2_start;
+    return mbed_heap2_size & ~7u;
+}
+#endif /* defined(HEAP2_START) */
+
 /* Called by the C library */
 void __rt_entry (void) {
     __user_setup_stackheap();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_ENTRY);
     mbed_set_stack_heap();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_STACK_HEAP);
     /* Copy the vector table to RAM only if uVisor is not in use. */
 #if !(defined(FEATURE_UVISOR) && defined(TARGET_UVISOR_SUPPORTED))
     mbed_cpy_nvic();
 #endif
     mbed_sdk_init();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_SDK_INIT);
     _platform_post_stackheap_init();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_KERNEL_INIT);
     mbed_start_main();
 }
 
@@ -489,6 +541,7 @@ int __wrap_main(void) {
 
 void pre_main(void)
 {
+    mbed_boot_stats_record(MBED_BOOT_STAGE_RTOS_START);
     singleton_mutex_attr.name = "singleton_mutex";
     singleton_mutex_attr.attr_bits = osMutexRecursive | osMutexPrioInherit | osMutexRobust;
     singleton_mutex_attr.cb_size = sizeof(singleton_mutex_obj);
@@ -508,19 +561,25 @@ void pre_main(void)
     env_mutex_id = osMutexNew(&env_mutex_attr);
 
     __libc_init_array();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_LIBC_INIT);
 
+    mbed_boot_stats_record(MBED_BOOT_STAGE_MAIN);
     main(0, NULL);
 }
 
 void software_init_hook(void)
 {
+    mbed_boot_stats_record(MBED_BOOT_STAGE_ENTRY);
     mbed_set_stack_heap();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_STACK_HEAP);
     /* Copy the vector table to RAM only if uVisor is not in use. */
 #if !(defined(FEATURE_UVISOR) && defined(TARGET_UVISOR_SUPPORTED))
     mbed_cpy_nvic();
 #endif
     mbed_sdk_init();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_SDK_INIT);
     osKernelInitialize();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_KERNEL_INIT);
     /* uvisor_lib_init calls RTOS functions, so must be called after the RTOS has
      * been initialized. */
 #ifdef   FEATURE_UVISOR
@@ -575,6 +634,7 @@ static uint8_t low_level_init_needed;
 
 void pre_main(void)
 {
+    mbed_boot_stats_record(MBED_BOOT_STAGE_RTOS_START);
     singleton_mutex_attr.name = "singleton_mutex";
     singleton_mutex_attr.attr_bits = osMutexRecursive | osMutexPrioInherit | osMutexRobust;
     singleton_mutex_attr.cb_size = sizeof(singleton_mutex_obj);
@@ -588,8 +648,10 @@ void pre_main(void)
     if (low_level_init_needed) {
         __iar_dynamic_initialization();
     }
+    mbed_boot_stats_record(MBED_BOOT_STAGE_LIBC_INIT);
 
     mbed_main();
+    mbed_boot_stats_record(MBED_BOOT_STAGE_MAIN);
     main();
 }
 
@@ -610,14 +672,19 @@ void __iar_program_start( void )
     mbed_cpy_nvic();
 #endif
     mbed_sdk_init();
+    /* Stats live in statics, so can only be recorded after __iar_data_init3 */
+    mbed_boot_stats_record(MBED_BOOT_STAGE_ENTRY);
+    mbed_boot_stats_record(MBED_BOOT_STAGE_SDK_INIT);
   }
 
   mbed_set_stack_heap();
+  mbed_boot_stats_record(MBED_BOOT_STAGE_STACK_HEAP);
 
   /* Store in a global variable after RAM has been initialized */
   low_level_init_needed = low_level_init_needed_local;
 
   osKernelInitialize();
+  mbed_boot_stats_record(MBED_BOOT_STAGE_KERNEL_INIT);
 
   mbed_start_main();
 }
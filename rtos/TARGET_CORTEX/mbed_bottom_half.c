@@ -0,0 +1,130 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_bottom_half.h"
+
+#include <string.h>
+#include "cmsis_os2.h"
+#include "mbed_rtos_storage.h"
+#include "mbed_assert.h"
+#include "mbed_critical.h"
+#include "hal/us_ticker_api.h"
+
+#ifndef MBED_BH_THREAD_STACK_SIZE
+#define MBED_BH_THREAD_STACK_SIZE 1024
+#endif
+
+/* Pending bottom halves form a lock-free LIFO stack; the drain thread takes
+ * the whole stack in one exchange and reverses it, giving FIFO service order
+ * without any ISR-side locking.
+ */
+static mbed_bh_t *volatile bh_head;
+static osSemaphoreId_t bh_sem;
+static osThreadId_t bh_thread;
+
+static mbed_rtos_storage_semaphore_t bh_sem_mem;
+static mbed_rtos_storage_thread_t bh_thread_mem;
+static uint64_t bh_stack[MBED_BH_THREAD_STACK_SIZE / sizeof(uint64_t)];
+
+static void bh_drain(void *argument)
+{
+    (void)argument;
+
+    for (;;) {
+        osSemaphoreAcquire(bh_sem, osWaitForever);
+
+        mbed_bh_t *list = bh_head;
+        while (list && !core_util_atomic_cas_ptr((void **)&bh_head, (void **)&list, NULL)) {
+        }
+
+        /* reverse into post order */
+        mbed_bh_t *bh = NULL;
+        while (list) {
+            mbed_bh_t *next = list->next;
+            list->next = bh;
+            bh = list;
+            list = next;
+        }
+
+        while (bh) {
+            mbed_bh_t *next = bh->next;
+
+            uint32_t latency = us_ticker_read() - bh->post_time;
+            if (latency > bh->max_latency_us) {
+                bh->max_latency_us = latency;
+            }
+
+            /* clear pending before running so a post from the handler's own
+               interrupt is not lost */
+            bh->pending = 0;
+            bh->handler(bh->arg);
+            bh->runs++;
+
+            bh = next;
+        }
+    }
+}
+
+void mbed_bh_init(mbed_bh_t *bh, void (*handler)(void *), void *arg)
+{
+    memset(bh, 0, sizeof(mbed_bh_t));
+    bh->handler = handler;
+    bh->arg = arg;
+
+    core_util_critical_section_enter();
+    if (!bh_thread) {
+        osSemaphoreAttr_t sem_attr;
+        memset(&sem_attr, 0, sizeof(sem_attr));
+        sem_attr.name = "mbed_bh_sem";
+        sem_attr.cb_mem = &bh_sem_mem;
+        sem_attr.cb_size = sizeof(bh_sem_mem);
+        bh_sem = osSemaphoreNew(0xffff, 0, &sem_attr);
+        MBED_ASSERT(bh_sem);
+
+        osThreadAttr_t thread_attr;
+        memset(&thread_attr, 0, sizeof(thread_attr));
+        thread_attr.name = "mbed_bh_thread";
+        thread_attr.priority = osPriorityRealtime;
+        thread_attr.stack_mem = bh_stack;
+        thread_attr.stack_size = sizeof(bh_stack);
+        thread_attr.cb_mem = &bh_thread_mem;
+        thread_attr.cb_size = sizeof(bh_thread_mem);
+        bh_thread = osThreadNew(bh_drain, NULL, &thread_attr);
+        MBED_ASSERT(bh_thread);
+    }
+    core_util_critical_section_exit();
+}
+
+int mbed_bh_post(mbed_bh_t *bh)
+{
+    uint8_t expected = 0;
+    core_util_atomic_incr_u32(&bh->posts, 1);
+
+    if (!core_util_atomic_cas_u8((uint8_t *)&bh->pending, &expected, 1)) {
+        /* already queued, coalesce */
+        return 0;
+    }
+
+    bh->post_time = us_ticker_read();
+
+    mbed_bh_t *head = bh_head;
+    do {
+        bh->next = head;
+    } while (!core_util_atomic_cas_ptr((void **)&bh_head, (void **)&head, bh));
+
+    osSemaphoreRelease(bh_sem);
+    return 1;
+}
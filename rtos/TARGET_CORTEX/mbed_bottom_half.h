@@ -0,0 +1,83 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BOTTOM_HALF_H
+#define MBED_BOTTOM_HALF_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup rtos */
+/** @{*/
+
+/** Deferred interrupt processing (bottom halves)
+ *
+ * A bottom half is a handler a driver registers once and then posts from its
+ * interrupt service routine to defer the heavy part of interrupt handling to
+ * thread context. Posting is a couple of atomic operations plus a semaphore
+ * release - no allocation, no queue locks - so it is safe and cheap from any
+ * ISR. Posted bottom halves are drained in post order by a single shared
+ * highest-priority thread; a bottom half that is posted again before it has
+ * run is coalesced into the pending one.
+ *
+ * Each source carries its own counters so interrupt load and ISR-to-thread
+ * latency can be inspected per driver in the field.
+ */
+typedef struct mbed_bh {
+    /* internal */
+    void (*handler)(void *);
+    void *arg;
+    struct mbed_bh *next;
+    volatile uint8_t pending;
+    uint32_t post_time;
+
+    /* statistics, maintained by the framework */
+    uint32_t posts;           /**< Number of posts, including coalesced ones. */
+    uint32_t runs;            /**< Number of times the handler has run. */
+    uint32_t max_latency_us;  /**< Worst-case microseconds from post to handler entry. */
+} mbed_bh_t;
+
+/** Initialize a bottom half and bind it to a handler.
+ *
+ * Must be called from thread context before the first post; the first
+ * initialization in the system starts the shared drain thread.
+ *
+ * @param bh      bottom half to initialize, owned by the caller.
+ * @param handler function to run in the drain thread when the bottom half is posted.
+ * @param arg     argument passed to the handler.
+ */
+void mbed_bh_init(mbed_bh_t *bh, void (*handler)(void *), void *arg);
+
+/** Post a bottom half for execution in the drain thread.
+ *
+ * Safe to call from interrupt service routines and from threads. If the
+ * bottom half is already pending the post is coalesced and the handler
+ * runs once.
+ *
+ * @param bh  initialized bottom half.
+ * @return    1 if the bottom half was queued, 0 if it was already pending.
+ */
+int mbed_bh_post(mbed_bh_t *bh);
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -24,6 +24,7 @@
 #ifdef RTE_Compiler_EventRecorder
 #include "EventRecorder.h"              // Keil::Compiler:Event Recorder
 // Used from rtx_evr.c
+#define EvtRtxThreadSwitch             EventID(EventLevelOp,  0xF2U, 0x18U)
 #define EvtRtxThreadExit               EventID(EventLevelAPI, 0xF2U, 0x19U)
 #define EvtRtxThreadTerminate          EventID(EventLevelAPI, 0xF2U, 0x1AU)
 #endif
@@ -146,6 +147,45 @@ void EvrRtxMessageQueueError (osMessageQueueId_t mq_id, int32_t status)
 
 #endif
 
+#if defined(MBED_CPU_STATS_ENABLED) || defined(MBED_FLIGHT_RECORDER_ENABLED) || defined(MBED_STACK_GUARD_ENABLED)
+
+#include "cmsis.h"
+#include "platform/mbed_flight_recorder.h"
+#include "mbed_stack_guard.h"
+
+extern void mbed_stats_cpu_switch_hook(uint32_t thread_id, uint32_t cycles);
+
+// RTX hook which gets called on every thread switch, overriding the weak
+// event recorder stub; charges the cycles since the last switch to the
+// outgoing thread via the accounting table in mbed_stats.c, traces the
+// switch in the flight recorder and moves the MPU stack guard under the
+// incoming thread
+void EvrRtxThreadSwitch (osThreadId_t thread_id)
+{
+#if defined(MBED_CPU_STATS_ENABLED) && defined(DWT) && defined(DWT_CTRL_CYCCNTENA_Msk)
+    static uint8_t running = 0;
+    if (!running) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        running = 1;
+    }
+    mbed_stats_cpu_switch_hook((uint32_t)thread_id, DWT->CYCCNT);
+#endif
+    MBED_FLIGHT_EVENT(MBED_FLIGHT_TYPE_THREAD_SWITCH, thread_id);
+#ifdef MBED_STACK_GUARD_ENABLED
+    {
+        osRtxThread_t *thread = (osRtxThread_t *)thread_id;
+        mbed_stack_guard_switch_hook(thread_id, thread->stack_mem, thread->stack_size);
+    }
+#endif
+#if (!defined(EVR_RTX_DISABLE) && (OS_EVR_THREAD != 0) && !defined(EVR_RTX_THREAD_SWITCH_DISABLE) && defined(RTE_Compiler_EventRecorder))
+    EventRecord2(EvtRtxThreadSwitch, (uint32_t)thread_id, 0U);
+#endif
+}
+
+#endif
+
 // RTX hook which gets called when a thread terminates, using the event function to call hook
 void EvrRtxThreadExit (void)
 {
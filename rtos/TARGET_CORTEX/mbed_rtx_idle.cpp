@@ -27,6 +27,7 @@
 #include "core_cm.h"
 #include "mbed_critical.h"
 #include "mbed_assert.h"
+#include "mbed_toolchain.h"
 #include <new>
 #include "rtx_os.h"
 extern "C" {
@@ -183,9 +184,12 @@ static void default_idle_hook(void)
     if (ticks_to_sleep) {
         os_timer->schedule_tick(ticks_to_sleep);
 
-        sleep_manager_lock_deep_sleep();
+        // No deep sleep lock is taken here: the wakeup is programmed on the
+        // low power ticker, which keeps counting and can interrupt out of
+        // deep sleep. Drivers whose timing relies on the high frequency
+        // ticker hold their own lock, which makes sleep() fall back to
+        // shallow sleep whenever waking on time actually needs it.
         sleep();
-        sleep_manager_unlock_deep_sleep();
 
         os_timer->cancel_tick();
         // calculate how long we slept
@@ -209,14 +213,53 @@ static void default_idle_hook(void)
 {
     // critical section to complete sleep with locked deepsleep
     core_util_critical_section_enter();
-    sleep_manager_lock_deep_sleep();
+    sleep_manager_lock_deep_sleep_id(SLEEP_LOCK_OWNER_RTOS);
     sleep();
-    sleep_manager_unlock_deep_sleep();
+    sleep_manager_unlock_deep_sleep_id(SLEEP_LOCK_OWNER_RTOS);
     core_util_critical_section_exit();
 }
 
 #endif // MBED_TICKLESS
 
+extern "C" MBED_WEAK void mbed_idle_background_hook(void)
+{
+    // No background work by default
+}
+
+#if MBED_STACK_STATS_ENABLED
+#include "platform/mbed_stats.h"
+
+/** Advance the incremental stack watermark scan by one thread
+ *
+ * Round-robins over the live threads, handing one stack region per pass
+ * to mbed_stats_stack_scan_chunk, which inspects a bounded number of
+ * words at the paint boundary. The enumeration and the thread's stack
+ * fields are read under the critical section so a terminating thread
+ * cannot pull the stack out from under the scan.
+ */
+static void stack_scan_step(void)
+{
+    static osThreadId_t threads[MBED_CONF_PLATFORM_STACK_SCAN_MAX_THREADS];
+    static uint32_t scan_index;
+
+    core_util_critical_section_enter();
+    uint32_t count = svcRtxThreadEnumerate(threads, MBED_CONF_PLATFORM_STACK_SCAN_MAX_THREADS);
+    if (count > 0) {
+        if (scan_index >= count) {
+            scan_index = 0;
+        }
+        osRtxThread_t *thread = (osRtxThread_t *)threads[scan_index++];
+        if (thread->stack_mem != NULL) {
+            mbed_stats_stack_scan_chunk((uint32_t)thread,
+                                        (const uint32_t *)thread->stack_mem,
+                                        thread->stack_size,
+                                        osRtxStackFillPattern);
+        }
+    }
+    core_util_critical_section_exit();
+}
+#endif
+
 static void (*idle_hook_fptr)(void) = &default_idle_hook;
 
 void rtos_attach_idle_hook(void (*fptr)(void))
@@ -233,6 +276,10 @@ extern "C" void rtos_idle_loop(void)
 {
     //Continuously call the idle hook function pointer
     while (1) {
+        mbed_idle_background_hook();
+#if MBED_STACK_STATS_ENABLED
+        stack_scan_step();
+#endif
         idle_hook_fptr();
     }
 }
@@ -0,0 +1,143 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_stack_guard.h"
+
+#ifdef MBED_STACK_GUARD_ENABLED
+
+#include "cmsis.h"
+#include "mbed_critical.h"
+
+#include <stddef.h>
+
+#if defined(__MPU_PRESENT) && __MPU_PRESENT
+
+/* Highest region number so the guard wins over any larger background
+ * regions the target may have set up */
+#define GUARD_REGION_NUMBER 7U
+
+/* log2(MBED_STACK_GUARD_SIZE) - 1, as the MPU RASR SIZE field wants it.
+ * Worked out for the supported power-of-two sizes. */
+#if MBED_STACK_GUARD_SIZE == 32
+#define GUARD_REGION_SIZE_FIELD 4U
+#elif MBED_STACK_GUARD_SIZE == 64
+#define GUARD_REGION_SIZE_FIELD 5U
+#elif MBED_STACK_GUARD_SIZE == 128
+#define GUARD_REGION_SIZE_FIELD 6U
+#elif MBED_STACK_GUARD_SIZE == 256
+#define GUARD_REGION_SIZE_FIELD 7U
+#else
+#error "MBED_STACK_GUARD_SIZE must be 32, 64, 128 or 256"
+#endif
+
+/* AP = 0b101: privileged read-only, unprivileged no access. Writes fault
+ * at any privilege level - that is the overflow trap - while the kernel
+ * can still read the stack painting and magic word. XN because nothing
+ * should ever execute from a stack's bottom. */
+#define GUARD_REGION_ATTRS \
+    (MPU_RASR_ENABLE_Msk | (GUARD_REGION_SIZE_FIELD << MPU_RASR_SIZE_Pos) | \
+     (0x5U << MPU_RASR_AP_Pos) | MPU_RASR_XN_Msk)
+
+static void *guard_excluded[MBED_STACK_GUARD_EXCLUDE_MAX];
+
+static int guard_is_excluded(void *thread_id)
+{
+    unsigned i;
+    for (i = 0; i < MBED_STACK_GUARD_EXCLUDE_MAX; i++) {
+        if (guard_excluded[i] == thread_id) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void mbed_stack_guard_switch_hook(void *thread_id, void *stack_mem, uint32_t stack_size)
+{
+    uint32_t base = ((uint32_t)stack_mem + MBED_STACK_GUARD_SIZE - 1)
+            & ~(uint32_t)(MBED_STACK_GUARD_SIZE - 1);
+
+    /* Threads with no stack to spare, and excluded threads, run with the
+     * guard region parked disabled */
+    if (stack_mem == NULL || guard_is_excluded(thread_id) ||
+            (base + 2 * MBED_STACK_GUARD_SIZE > (uint32_t)stack_mem + stack_size)) {
+        MPU->RBAR = MPU_RBAR_VALID_Msk | GUARD_REGION_NUMBER;
+        MPU->RASR = 0;
+        __DSB();
+        __ISB();
+        return;
+    }
+
+    MPU->RBAR = base | MPU_RBAR_VALID_Msk | GUARD_REGION_NUMBER;
+    MPU->RASR = GUARD_REGION_ATTRS;
+    /* PRIVDEFENA keeps the default memory map for everything outside the
+     * guard, so no other regions need to be described */
+    MPU->CTRL = MPU_CTRL_ENABLE_Msk | MPU_CTRL_PRIVDEFENA_Msk;
+    __DSB();
+    __ISB();
+}
+
+int mbed_stack_guard_exclude(void *thread_id)
+{
+    unsigned i;
+    int ret = -1;
+
+    core_util_critical_section_enter();
+    for (i = 0; i < MBED_STACK_GUARD_EXCLUDE_MAX; i++) {
+        if (guard_excluded[i] == NULL || guard_excluded[i] == thread_id) {
+            guard_excluded[i] = thread_id;
+            ret = 0;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+    return ret;
+}
+
+void mbed_stack_guard_include(void *thread_id)
+{
+    unsigned i;
+
+    core_util_critical_section_enter();
+    for (i = 0; i < MBED_STACK_GUARD_EXCLUDE_MAX; i++) {
+        if (guard_excluded[i] == thread_id) {
+            guard_excluded[i] = NULL;
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+#else /* __MPU_PRESENT */
+
+void mbed_stack_guard_switch_hook(void *thread_id, void *stack_mem, uint32_t stack_size)
+{
+    (void)thread_id;
+    (void)stack_mem;
+    (void)stack_size;
+}
+
+int mbed_stack_guard_exclude(void *thread_id)
+{
+    (void)thread_id;
+    return -1;
+}
+
+void mbed_stack_guard_include(void *thread_id)
+{
+    (void)thread_id;
+}
+
+#endif /* __MPU_PRESENT */
+
+#endif /* MBED_STACK_GUARD_ENABLED */
@@ -0,0 +1,84 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_STACK_GUARD_H
+#define MBED_STACK_GUARD_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* MPU-backed stack overflow guard.
+ *
+ * When MBED_STACK_GUARD_ENABLED is set and the core has an MPU, every
+ * context switch repositions a no-write MPU region over the bottom
+ * MBED_STACK_GUARD_SIZE bytes of the incoming thread's stack. An
+ * overflow then faults on the offending store instead of corrupting
+ * whatever sits below the stack and surfacing hours later; the steady
+ * state costs nothing, and the switch path only three register writes.
+ *
+ * The guard is carved out of the stack itself (aligned up from the
+ * stack base), so it never covers neighbouring data; it is readable by
+ * privileged code, which keeps RTX's watermark and magic word checks
+ * working. Threads whose stack is too small to give up a guard page go
+ * unguarded.
+ */
+
+/** Size of the guard region in bytes. Must be a power of two the MPU
+ * supports; 32 is the architectural minimum and costs each stack the
+ * least. */
+#ifndef MBED_STACK_GUARD_SIZE
+#define MBED_STACK_GUARD_SIZE 32
+#endif
+
+/** Number of threads that can opt out of guarding at one time */
+#ifndef MBED_STACK_GUARD_EXCLUDE_MAX
+#define MBED_STACK_GUARD_EXCLUDE_MAX 4
+#endif
+
+/** Reposition the guard region for the thread being switched in.
+ *
+ * Called from the RTX thread switch hook in handler mode; not for
+ * application use.
+ *
+ * @param thread_id  osThreadId_t of the incoming thread
+ * @param stack_mem  Base (lowest address) of the thread's stack
+ * @param stack_size Size of the stack in bytes
+ */
+void mbed_stack_guard_switch_hook(void *thread_id, void *stack_mem, uint32_t stack_size);
+
+/** Exclude a thread from stack guarding
+ *
+ * For the rare thread that legitimately works at the very bottom of
+ * its stack. Takes effect at the thread's next switch-in.
+ *
+ * @param thread_id osThreadId_t of the thread
+ * @return 0 on success, -1 if the exclusion table is full
+ */
+int mbed_stack_guard_exclude(void *thread_id);
+
+/** Re-enable stack guarding for a previously excluded thread
+ *
+ * @param thread_id osThreadId_t of the thread
+ */
+void mbed_stack_guard_include(void *thread_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -371,6 +371,30 @@ private:
     bool                       _finished;
 };
 
+/** StaticThread is a Thread whose stack is a member of the object instead of
+ *  being allocated on the heap. Global or static instances place the stack in
+ *  BSS, so no-heap builds can create threads and the linker map accounts for
+ *  every stack byte at build time. The other control structures are already
+ *  contained in Thread itself.
+ *
+ *  @tparam  StackSize  stack size (in bytes) for the thread function.
+ */
+template <uint32_t StackSize = OS_STACK_SIZE>
+class StaticThread : public Thread {
+public:
+    /** Allocate a new thread without starting execution
+      @param   priority  initial priority of the thread function. (default: osPriorityNormal).
+      @param   name      name to be used for this thread. It has to stay allocated for the lifetime of the thread (default: NULL)
+    */
+    StaticThread(osPriority priority=osPriorityNormal, const char *name=NULL)
+        : Thread(priority, StackSize, (unsigned char *) _stack_mem, name) {
+    }
+
+private:
+    /* Stack storage, sized in uint64_t for worst-case alignment */
+    uint64_t _stack_mem[(StackSize + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+};
+
 }
 #endif
 
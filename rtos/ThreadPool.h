@@ -0,0 +1,114 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2017 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "rtos/Thread.h"
+#include "events/EventQueue.h"
+
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+
+/** The ThreadPool class dispatches an EventQueue across several threads.
+ One thread runs the queue's timing loop; the others run as helpers that
+ steal ready events from it, so CPU-bound jobs posted to the queue run in
+ parallel while delayed and periodic events keep their timing. Jobs that
+ must serialize with each other can be pinned to the timing thread with
+ equeue_event_affinity.
+
+ Work is submitted by posting to the wrapped EventQueue as usual; the
+ pool only provides the dispatch threads.
+
+  @tparam  pool_sz  number of dispatch threads, including the timing thread.
+*/
+template <uint32_t pool_sz>
+class ThreadPool : private mbed::NonCopyable<ThreadPool<pool_sz> > {
+public:
+    /** Create a ThreadPool for the given queue.
+      The threads are allocated but not started.
+      @param   queue       queue to dispatch.
+      @param   priority    priority of the dispatch threads. (default: osPriorityNormal)
+      @param   stack_size  stack size of each dispatch thread. (default: OS_STACK_SIZE)
+    */
+    ThreadPool(events::EventQueue *queue,
+               osPriority priority = osPriorityNormal,
+               uint32_t stack_size = OS_STACK_SIZE)
+        : _queue(queue), _started(false) {
+        for (uint32_t i = 0; i < pool_sz; i++) {
+            _threads[i] = new Thread(priority, stack_size);
+        }
+    }
+
+    ~ThreadPool() {
+        stop();
+        for (uint32_t i = 0; i < pool_sz; i++) {
+            delete _threads[i];
+        }
+    }
+
+    /** Start dispatching the queue on the pool's threads.
+      @return  status code that indicates the execution status of the function.
+    */
+    osStatus start() {
+        osStatus status = _threads[0]->start(
+                mbed::callback(_queue, &events::EventQueue::dispatch_forever));
+        for (uint32_t i = 1; i < pool_sz && status == osOK; i++) {
+            status = _threads[i]->start(
+                    mbed::callback(_queue, &events::EventQueue::dispatch_worker));
+        }
+        _started = (status == osOK);
+        return status;
+    }
+
+    /** Stop dispatching and wait for the pool's threads to exit.
+      Events already queued remain in the queue.
+    */
+    void stop() {
+        if (!_started) {
+            return;
+        }
+        /* each break terminates one dispatch loop: the timing thread
+           plus pool_sz - 1 helpers */
+        for (uint32_t i = 0; i < pool_sz; i++) {
+            _queue->break_dispatch();
+        }
+        for (uint32_t i = 0; i < pool_sz; i++) {
+            _threads[i]->join();
+        }
+        _started = false;
+    }
+
+private:
+    events::EventQueue *_queue;
+    Thread *_threads[pool_sz];
+    bool _started;
+};
+
+}
+
+#endif
+
+/** @}*/
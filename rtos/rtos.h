@@ -30,10 +30,13 @@
 #include "rtos/Mutex.h"
 #include "rtos/RtosTimer.h"
 #include "rtos/Semaphore.h"
+#include "rtos/ConditionVariable.h"
 #include "rtos/Mail.h"
+#include "rtos/MailBox.h"
 #include "rtos/MemoryPool.h"
 #include "rtos/Queue.h"
 #include "rtos/EventFlags.h"
+#include "rtos/ThreadPool.h"
 
 using namespace rtos;
 
@@ -33,6 +33,16 @@ extern "C" {
 
 void rtos_attach_idle_hook(void (*fptr)(void));
 
+/** Optional background work hook, run from the idle thread
+ *
+ *  The default definition is a weak no-op; a module may provide a strong
+ *  definition to get called on every pass of the idle loop, before the
+ *  idle hook puts the core to sleep. It runs at the lowest priority in
+ *  the system and outside any critical section, so it may take its time,
+ *  but it must eventually return so the core can sleep.
+ */
+void mbed_idle_background_hook(void);
+
 #ifdef __cplusplus
 }
 #endif
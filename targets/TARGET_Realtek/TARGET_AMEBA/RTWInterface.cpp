@@ -32,47 +32,61 @@ typedef struct _wifi_scan_hdl {
     nsapi_size_t ap_num;
     nsapi_size_t scan_num;
     WiFiAccessPoint *ap_details;
+    mbed::Callback<bool(const WiFiAccessPoint &)> *scan_cb;
+    bool scan_stop;
 } wifi_scan_hdl;
 
 #define MAX_SCAN_TIMEOUT (15000)
 
+static void scan_record_to_ap(rtw_scan_result_t *record, nsapi_wifi_ap_t *ap)
+{
+    record->SSID.val[record->SSID.len] = 0; /* Ensure the SSID is null terminated */
+    memset((void*)ap, 0x00, sizeof(nsapi_wifi_ap_t));
+    memcpy(ap->ssid, record->SSID.val, record->SSID.len);
+    memcpy(ap->bssid, record->BSSID.octet, 6);
+    switch (record->security){
+        case RTW_SECURITY_OPEN:
+            ap->security = NSAPI_SECURITY_NONE;
+            break;
+        case RTW_SECURITY_WEP_PSK:
+        case RTW_SECURITY_WEP_SHARED:
+            ap->security = NSAPI_SECURITY_WEP;
+            break;
+        case RTW_SECURITY_WPA_TKIP_PSK:
+        case RTW_SECURITY_WPA_AES_PSK:
+            ap->security = NSAPI_SECURITY_WPA;
+            break;
+        case RTW_SECURITY_WPA2_AES_PSK:
+        case RTW_SECURITY_WPA2_TKIP_PSK:
+        case RTW_SECURITY_WPA2_MIXED_PSK:
+            ap->security = NSAPI_SECURITY_WPA2;
+            break;
+        case RTW_SECURITY_WPA_WPA2_MIXED:
+            ap->security = NSAPI_SECURITY_WPA_WPA2;
+            break;
+        default:
+            ap->security = NSAPI_SECURITY_UNKNOWN;
+            break;
+    }
+    ap->rssi = record->signal_strength;
+    ap->channel = record->channel;
+}
+
 static rtw_result_t scan_result_handler( rtw_scan_handler_result_t* malloced_scan_result )
 {
     wifi_scan_hdl *scan_handler = (wifi_scan_hdl *)malloced_scan_result->user_data;
     if (malloced_scan_result->scan_complete != RTW_TRUE) {
-        if(scan_handler->ap_details && scan_handler->scan_num > scan_handler->ap_num){
-            nsapi_wifi_ap_t ap;    
-            rtw_scan_result_t* record = &malloced_scan_result->ap_details;
-            record->SSID.val[record->SSID.len] = 0; /* Ensure the SSID is null terminated */    
-            memset((void*)&ap, 0x00, sizeof(nsapi_wifi_ap_t));
-            memcpy(ap.ssid, record->SSID.val, record->SSID.len);
-            memcpy(ap.bssid, record->BSSID.octet, 6);
-            switch (record->security){
-                case RTW_SECURITY_OPEN:
-                    ap.security = NSAPI_SECURITY_NONE;
-                    break;
-                case RTW_SECURITY_WEP_PSK:
-                case RTW_SECURITY_WEP_SHARED:
-                    ap.security = NSAPI_SECURITY_WEP;
-                    break;
-                case RTW_SECURITY_WPA_TKIP_PSK:
-                case RTW_SECURITY_WPA_AES_PSK:
-                    ap.security = NSAPI_SECURITY_WPA;
-                    break;
-                case RTW_SECURITY_WPA2_AES_PSK:
-                case RTW_SECURITY_WPA2_TKIP_PSK:
-                case RTW_SECURITY_WPA2_MIXED_PSK:
-                    ap.security = NSAPI_SECURITY_WPA2;
-                    break;
-                case RTW_SECURITY_WPA_WPA2_MIXED:
-                    ap.security = NSAPI_SECURITY_WPA_WPA2;
-                    break;
-                default:
-                    ap.security = NSAPI_SECURITY_UNKNOWN;
-                    break;
+        if(scan_handler->scan_cb){
+            if(!scan_handler->scan_stop){
+                nsapi_wifi_ap_t ap;
+                scan_record_to_ap(&malloced_scan_result->ap_details, &ap);
+                if(!(*scan_handler->scan_cb)(WiFiAccessPoint(ap))){
+                    scan_handler->scan_stop = true;
+                }
             }
-            ap.rssi = record->signal_strength;
-            ap.channel = record->channel;
+        } else if(scan_handler->ap_details && scan_handler->scan_num > scan_handler->ap_num){
+            nsapi_wifi_ap_t ap;
+            scan_record_to_ap(&malloced_scan_result->ap_details, &ap);
             scan_handler->ap_details[scan_handler->ap_num] = WiFiAccessPoint(ap);
         }
         scan_handler->ap_num++;
@@ -189,6 +203,7 @@ nsapi_error_t RTWInterface::scan(WiFiAccessPoint *res, unsigned count)
         rtw_init_sema(&scan_handler.scan_sema, 0);
     scan_handler.scan_num = count;
     scan_handler.ap_details = res;
+    scan_handler.scan_cb = NULL;
     if(wifi_scan_networks(scan_result_handler, (void *)&scan_handler) != RTW_SUCCESS){
         printf("wifi scan failed\n\r");
         return NSAPI_ERROR_DEVICE_ERROR;
@@ -203,6 +218,30 @@ nsapi_error_t RTWInterface::scan(WiFiAccessPoint *res, unsigned count)
     return count;
 }
 
+nsapi_size_or_error_t RTWInterface::scan(mbed::Callback<bool(const WiFiAccessPoint &)> cb)
+{
+    static wifi_scan_hdl scan_handler;
+    scan_handler.ap_num = 0;
+    if(!scan_handler.scan_sema)
+        rtw_init_sema(&scan_handler.scan_sema, 0);
+    scan_handler.scan_num = 0;
+    scan_handler.ap_details = NULL;
+    scan_handler.scan_cb = &cb;
+    scan_handler.scan_stop = false;
+    if(wifi_scan_networks(scan_result_handler, (void *)&scan_handler) != RTW_SUCCESS){
+        printf("wifi scan failed\n\r");
+        scan_handler.scan_cb = NULL;
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+    if(rtw_down_timeout_sema( &scan_handler.scan_sema, MAX_SCAN_TIMEOUT ) == RTW_FALSE) {
+        printf("wifi scan timeout\r\n");
+        scan_handler.scan_cb = NULL;
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+    scan_handler.scan_cb = NULL;
+    return scan_handler.ap_num;
+}
+
 nsapi_error_t RTWInterface::set_channel(uint8_t channel)
 {
     _channel = channel;
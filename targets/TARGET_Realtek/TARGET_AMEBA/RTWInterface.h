@@ -108,6 +108,18 @@ public:
      */
      virtual nsapi_size_or_error_t scan(WiFiAccessPoint *res, unsigned count);
 
+    /** Scan for available networks, streaming each result
+     *
+     *  Each discovered AP is handed to the callback as the driver parses it,
+     *  so no result array is needed. The callback runs on the driver's scan
+     *  handler context and must not block; returning false stops reporting
+     *  further results.
+     *  @param  cb       Callback invoked per discovered access point
+     *  @return          Number of access points seen, negative on error
+     *  see @a nsapi_error
+     */
+     virtual nsapi_size_or_error_t scan(mbed::Callback<bool(const WiFiAccessPoint &)> cb);
+
      virtual nsapi_error_t set_channel(uint8_t channel);
      virtual int8_t get_rssi();
 
@@ -259,9 +259,12 @@ void i2c_init(i2c_t *obj, PinName sda, PinName scl) {
 
     struct i2c_s *obj_s = I2C_S(obj);
 
-    // Determine the I2C to use
-    I2CName i2c_sda = (I2CName)pinmap_peripheral(sda, PinMap_I2C_SDA);
-    I2CName i2c_scl = (I2CName)pinmap_peripheral(scl, PinMap_I2C_SCL);
+    // Determine the I2C to use - resolved entries are kept so the pin
+    // configuration below does not need to scan the tables again
+    const PinMap *map_sda = pinmap_entry(sda, PinMap_I2C_SDA);
+    const PinMap *map_scl = pinmap_entry(scl, PinMap_I2C_SCL);
+    I2CName i2c_sda = map_sda ? (I2CName)map_sda->peripheral : (I2CName)NC;
+    I2CName i2c_scl = map_scl ? (I2CName)map_scl->peripheral : (I2CName)NC;
     obj_s->sda = sda;
     obj_s->scl = scl;
 
@@ -316,8 +319,8 @@ void i2c_init(i2c_t *obj, PinName sda, PinName scl) {
 #endif
 
     // Configure I2C pins
-    pinmap_pinout(sda, PinMap_I2C_SDA);
-    pinmap_pinout(scl, PinMap_I2C_SCL);
+    pinmap_pinout_entry(map_sda);
+    pinmap_pinout_entry(map_scl);
     pin_mode(sda, OpenDrainNoPull);
     pin_mode(scl, OpenDrainNoPull);
 
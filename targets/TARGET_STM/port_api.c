@@ -43,6 +43,16 @@ PinName port_pin(PortName port, int pin_n)
     return (PinName)(pin_n + (port << 4));
 }
 
+int port_decode_pin(PinName pin, PortName *port, int *pin_n)
+{
+    if (pin == NC) {
+        return -1;
+    }
+    *port = (PortName)STM_PORT(pin);
+    *pin_n = STM_PIN(pin);
+    return 0;
+}
+
 void port_init(port_t *obj, PortName port, int mask, PinDirection dir)
 {
     uint32_t port_index = (uint32_t)port;